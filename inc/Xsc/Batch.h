@@ -0,0 +1,196 @@
+/*
+ * Batch.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_BATCH_H
+#define XSC_BATCH_H
+
+
+#include "Xsc.h"
+
+#include <string>
+#include <vector>
+#include <map>
+
+
+namespace Xsc
+{
+
+
+//! Batch compilation job descriptor.
+struct BatchJob
+{
+    /**
+    \brief Shader input descriptor.
+    \remarks If 'inputDesc.sourceCode' is null, the input is read from the file 'inputDesc.filename'.
+    If 'inputDesc.includeHandler' is not null, it must be safe to be used from multiple threads.
+    */
+    ShaderInput                 inputDesc;
+
+    /**
+    \brief Shader output descriptor.
+    \remarks If 'outputDesc.sourceCode' is null, the output is written to the file 'outputDesc.filename' (only on success).
+    */
+    ShaderOutput                outputDesc;
+
+    //! Optional pointer to an output log for this job. Each job must have its own log. By default null.
+    Log*                        log             = nullptr;
+
+    //! Optional pointer to a code reflection data structure for this job. By default null.
+    Reflection::ReflectionData* reflectionData  = nullptr;
+};
+
+//! Batch compilation job result.
+struct BatchJobResult
+{
+    //! True if the job has been compiled successfully.
+    bool        succeeded           = false;
+
+    //! True if the predicted duration was taken from the timing history. Otherwise it was estimated from the input size.
+    bool        predictedByHistory  = false;
+
+    //! Predicted duration (in milliseconds) the job was scheduled with.
+    double      predictedDuration   = 0.0;
+
+    //! Actual duration (in milliseconds) of the compilation.
+    double      actualDuration      = 0.0;
+
+    //! Index of the worker (thread or process) the job was executed on.
+    unsigned    worker              = 0;
+
+    //! Reason of the worker process crash (e.g. "signal 11 (Segmentation fault)"), or empty if the job did not crash the worker process.
+    std::string crash;
+};
+
+/**
+\brief Historical compile timings for the batch scheduler.
+\remarks The timings are keyed by the input filename, entry point, shader target, and a hash of all compiler options (see BatchJobKey).
+The database file is a simple text file with one entry per line.
+*/
+class XSC_EXPORT BatchTimings
+{
+
+    public:
+
+        //! Loads the timings from the specified database file. Returns false if the file could not be read.
+        bool Load(const std::string& filename);
+
+        //! Saves the timings to the specified database file. Returns false if the file could not be written.
+        bool Save(const std::string& filename) const;
+
+        //! Records the duration (in milliseconds) for the specified job key (blended with the previous duration).
+        void Record(const std::string& key, double duration);
+
+        //! Returns true and stores the duration (in milliseconds) for the specified job key in 'duration', if the key has an entry.
+        bool Find(const std::string& key, double& duration) const;
+
+        //! Returns the number of entries.
+        inline std::size_t Size() const
+        {
+            return durations_.size();
+        }
+
+    private:
+
+        std::map<std::string, double> durations_;
+
+};
+
+//! Batch compilation descriptor structure.
+struct BatchDescriptor
+{
+    //! Number of worker threads. If this is 0, the concurrency level of the task scheduler is used (by default the number of hardware threads). By default 0.
+    unsigned        numThreads          = 0;
+
+    //! Optional pointer to historical compile timings. The timings are updated with the actual durations of all successful jobs after compilation. By default null.
+    BatchTimings*   timings             = nullptr;
+
+    /**
+    \brief Optional filename of the timing database. By default empty.
+    \remarks If this is not empty, the timings are loaded from this file before compilation, and saved after compilation.
+    If 'timings' is null, a temporary timing table is used.
+    */
+    std::string     timingDatabase;
+
+    /**
+    \brief Specifies whether the jobs are compiled in crash-isolated worker processes instead of worker threads. By default false.
+    \remarks The worker processes are forked once before the first job and are kept alive across jobs.
+    If a worker process crashes, its job fails with the reason of the crash (see BatchJobResult::crash) and the worker process is restarted.
+    This is only supported on Unix-like platforms; otherwise the jobs are compiled in worker threads.
+    */
+    bool            isolateProcesses    = false;
+
+    /**
+    \brief Optional pointer to the task scheduler, which executes the jobs. By default null.
+    \remarks Each worker is a single task, which compiles one job after another. If 'numThreads' is 0, the concurrency level of the scheduler is used.
+    Jobs without their own task scheduler (see ShaderInput::taskScheduler) execute their internal parallelism on this scheduler as well.
+    If this is null, the shared default scheduler is used (see StdTaskScheduler::Default).
+    */
+    TaskScheduler*  taskScheduler       = nullptr;
+};
+
+//! Batch compilation report structure.
+struct BatchReport
+{
+    //! Results of all jobs (in the same order as the jobs were passed to the "CompileShaderBatch" function).
+    std::vector<BatchJobResult> results;
+
+    //! Number of worker threads (or worker processes) that were used.
+    unsigned                    numThreads                  = 0;
+
+    //! True if the jobs were compiled in crash-isolated worker processes.
+    bool                        isolateProcesses            = false;
+
+    //! Number of worker processes that were restarted after a crash.
+    std::size_t                 numWorkerRestarts           = 0;
+
+    //! Number of jobs that were predicted from the timing history.
+    std::size_t                 numPredictedByHistory       = 0;
+
+    //! Predicted makespan (in milliseconds) with longest-expected-first scheduling.
+    double                      predictedMakespan           = 0.0;
+
+    //! Predicted makespan (in milliseconds) with scheduling in submission order, for comparison.
+    double                      predictedMakespanInOrder    = 0.0;
+
+    //! Actual makespan (in milliseconds), i.e. the wall-clock time of the entire batch.
+    double                      actualMakespan              = 0.0;
+};
+
+/**
+\brief Returns the key of the specified job for the timing history.
+\remarks The key consists of the input filename, entry point, shader target, and a hash of all options that affect the compilation.
+*/
+XSC_EXPORT std::string BatchJobKey(const BatchJob& job);
+
+/**
+\brief Compiles all specified jobs in parallel.
+\remarks The jobs are scheduled longest-expected-first (with work stealing between the worker threads),
+whereas the expected duration is taken from the timing history, or estimated from the input size for unseen jobs.
+\param[in] jobs Specifies all compilation jobs.
+\param[in] batchDesc Specifies the batch compilation descriptor.
+\param[out] report Optional pointer to the batch report. By default null.
+\return True if all jobs have been compiled successfully.
+\see CompileShader
+*/
+XSC_EXPORT bool CompileShaderBatch(
+    const std::vector<BatchJob>&    jobs,
+    const BatchDescriptor&          batchDesc,
+    BatchReport*                    report      = nullptr
+);
+
+//! Prints the batch report (predicted versus actual makespan) to the specified output stream.
+XSC_EXPORT void PrintBatchReport(std::ostream& stream, const BatchReport& report);
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -14,6 +14,7 @@
 #include <istream>
 #include <memory>
 #include <vector>
+#include <cstddef>
 
 
 namespace Xsc
@@ -44,6 +45,46 @@ class XSC_EXPORT IncludeHandler
 
 };
 
+class IncludeMemo;
+
+/**
+\brief Memo of pre-processed include files, which can be shared between multiple compilations (e.g. all permutations of a shader).
+\remarks For each included file, the pre-processor records all macros the file (transitively) reads together with their values at entry,
+a content hash of every file it (transitively) includes, its expanded output, and its net effect on the macro table.
+Whenever the same file is included again, all of these macros have the same values, and all nested include files (as resolved by the current include handler) have the same content,
+the expanded output and the macro side effects are replayed from the memo instead of pre-processing the file again.
+Include files that submit any report (e.g. a warning or "#pragma message") or leave an "#if"-block open are never memoized.
+This class is thread-safe, i.e. it can be shared between all jobs of a batch compilation. Only HLSL input is memoized.
+\see ShaderInput::includeCache
+*/
+class XSC_EXPORT IncludeCache
+{
+
+    public:
+
+        IncludeCache();
+        ~IncludeCache();
+
+        IncludeCache(const IncludeCache&) = delete;
+        IncludeCache& operator = (const IncludeCache&) = delete;
+
+        //! Removes all recorded include files and resets the statistics.
+        void Clear();
+
+        //! Returns the number of includes whose expansion has been replayed from the memo.
+        std::size_t NumHits() const;
+
+        //! Returns the number of includes that have been pre-processed, because no recorded expansion matched.
+        std::size_t NumMisses() const;
+
+    private:
+
+        friend class PreProcessor;
+
+        IncludeMemo* memo_ = nullptr;
+
+};
+
 
 } // /namespace Xsc
 
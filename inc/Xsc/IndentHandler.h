@@ -35,6 +35,12 @@ class XSC_EXPORT IndentHandler
         //! Decrements the indentation.
         void DecIndent();
 
+        //! Returns the next indentation string.
+        inline const std::string& Indent() const
+        {
+            return indent_;
+        }
+
         //! Returns the current full indentation string.
         inline const std::string& FullIndent() const
         {
@@ -46,6 +46,12 @@ class XSC_EXPORT Log
             indentHandler_.DecIndent();
         }
 
+        //! Returns the next indentation string.
+        inline const std::string& Indent() const
+        {
+            return indentHandler_.Indent();
+        }
+
     protected:
 
         Log() = default;
@@ -0,0 +1,138 @@
+/*
+ * Pipeline.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_PIPELINE_H
+#define XSC_PIPELINE_H
+
+
+#include "Xsc.h"
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+
+
+namespace Xsc
+{
+
+namespace Reflection
+{
+
+
+//! Shader stage flags enumeration of a pipeline binding.
+struct StageFlags
+{
+    enum : unsigned int
+    {
+        Vertex                  = (1 << 0), //!< Vertex shader stage.
+        TessellationControl     = (1 << 1), //!< Tessellation-control (also Hull-) shader stage.
+        TessellationEvaluation  = (1 << 2), //!< Tessellation-evaluation (also Domain-) shader stage.
+        Geometry                = (1 << 3), //!< Geometry shader stage.
+        Fragment                = (1 << 4), //!< Fragment (also Pixel-) shader stage.
+        Compute                 = (1 << 5), //!< Compute shader stage.
+    };
+};
+
+//! Resource type enumeration of a pipeline binding.
+enum class BindingType
+{
+    Texture,        //!< Texture binding (see ReflectionData::textures).
+    StorageBuffer,  //!< Storage buffer binding (see ReflectionData::storageBuffers).
+    ConstantBuffer, //!< Constant buffer binding (see ReflectionData::constantBuffers).
+};
+
+//! Reflection data of a single shader stage of a pipeline.
+struct PipelineStage
+{
+    //! Shader target of this stage. Each target can only be used once per pipeline.
+    ShaderTarget            target          = ShaderTarget::Undefined;
+
+    //! Pointer to the reflection data of this stage. This must not be null.
+    const ReflectionData*   reflectionData  = nullptr;
+};
+
+//! Resource binding of a merged pipeline layout.
+struct PipelineBinding
+{
+    //! Resource type of the binding.
+    BindingType     type        = BindingType::Texture;
+
+    //! Identifier of the resource.
+    std::string     ident;
+
+    //! Zero based binding point. If this is -1, the location has not been set explicitly.
+    int             location    = -1;
+
+    //! Stages the resource is visible to. This is a bitwise OR combination of the entries of the StageFlags enumeration.
+    unsigned int    stages      = 0;
+};
+
+/**
+\brief Pipeline layout that has been merged from the reflection data of all shader stages of a pipeline.
+\remarks All hashes are 64-bit FNV-1a hashes of a canonical description of the respective reflection data.
+They neither depend on the order in which the stages are specified, nor on the order of entries within the reflection data,
+and they are equal on all platforms. Thus they can be computed when the shaders are built, and used as cache keys at runtime.
+*/
+struct PipelineLayout
+{
+    //! Union of all texture, storage buffer, and constant buffer bindings, ordered by type, location, and identifier.
+    std::vector<PipelineBinding>    bindings;
+
+    //! Hash of the vertex input interface (i.e. the input attributes of the vertex shader), or 0 if the pipeline has no vertex shader.
+    std::uint64_t                   vertexInputHash     = 0;
+
+    /**
+    \brief Hashes of the interfaces between each two consecutive stages in pipeline order (e.g. vertex to geometry, and geometry to fragment shader).
+    \remarks Each interface consists of the output attributes, packed outputs, and flat outputs of the previous stage, and the input attributes and packed inputs of the next stage.
+    */
+    std::vector<std::uint64_t>      stageInterfaceHashes;
+
+    //! Hash of the resource layout (i.e. all bindings with their stage flags).
+    std::uint64_t                   resourceLayoutHash  = 0;
+};
+
+
+} // /namespace Reflection
+
+
+//! Returns the string representation of the specified 'PipelineBinding::BindingType' type.
+XSC_EXPORT std::string ToString(const Reflection::BindingType t);
+
+//! Returns the stage flag (see Reflection::StageFlags) of the specified shader target, or 0 if the target is undefined.
+XSC_EXPORT unsigned int ShaderTargetToStageFlag(const ShaderTarget target);
+
+/**
+\brief Merges the reflection data of all shader stages of a pipeline into a single pipeline layout.
+\param[in] stages Specifies the reflection data of all stages in arbitrary order.
+\param[out] layout Receives the merged pipeline layout. The layout is filled even if conflicts have been found.
+\param[in] log Optional pointer to an output log for the diagnosed conflicts. By default null.
+\return True if the stages have no conflicts, i.e. no resource is bound to different locations in different stages,
+no location is bound to different resources of the same type in different stages, all inputs of each stage are written by the previous stage (except system values and the inputs of a tessellation-evaluation shader),
+and all packed inputs are read from the same slot components the previous stage has written them to (see Options::packVaryings).
+\throw std::invalid_argument If any stage has an undefined target or a null pointer to its reflection data.
+\see PipelineStage
+\see PipelineLayout
+*/
+XSC_EXPORT bool MergeReflection(
+    const std::vector<Reflection::PipelineStage>&   stages,
+    Reflection::PipelineLayout&                     layout,
+    Log*                                            log     = nullptr
+);
+
+//! Prints the pipeline layout into the output stream in a human readable format.
+XSC_EXPORT void PrintPipelineLayout(std::ostream& stream, const Reflection::PipelineLayout& layout);
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,220 @@
+/*
+ * ProgramBuilder.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_PROGRAM_BUILDER_H
+#define XSC_PROGRAM_BUILDER_H
+
+
+#include "Export.h"
+#include "Xsc.h"
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+class HLSLProgramBuilder;
+
+//! Opaque handle to an expression made by a program builder. Each handle can only be used once (declare a local variable to use a value several times).
+struct BuilderExpr
+{
+    //! Internal expression index. Zero for an invalid (or omitted) expression.
+    std::size_t id = 0;
+};
+
+/**
+\brief Builder to construct a shader program programmatically, i.e. without generating HLSL source code first.
+\remarks This is intended for hosts like node-graph material editors, which can emit declarations, functions, and expressions directly.
+All type names, operators, and semantics are specified with their HLSL spelling (e.g. "float4", "Texture2D<float4>", "+=", or "SV_Position").
+The builder has a current scope: declarations and statements are always appended to the innermost open structure, constant buffer, function, or control-flow block.
+All nodes are attached to the source identifier of the last call to "SetSource", so that diagnostics refer to the nodes of the host (e.g. "Node7:1:1").
+\code
+Xsc::ProgramBuilder b;
+b.BeginConstantBuffer("Material", 0);
+b.DeclareVariable("float4", "tint");
+b.EndConstantBuffer();
+b.BeginFunction("float4", "PS", "SV_Target");
+b.SetSource("Node3");
+b.Return(b.Binary(b.Var("tint"), "*", b.Literal(0.5f)));
+b.EndFunction();
+Xsc::CompileShader(b, inputDesc, outputDesc, &log);
+\endcode
+\see CompileShader(ProgramBuilder&, const ShaderInput&, const ShaderOutput&, Log*, Reflection::ReflectionData*)
+*/
+class XSC_EXPORT ProgramBuilder
+{
+
+    public:
+
+        //! Expression handle type.
+        using Expr = BuilderExpr;
+
+        ProgramBuilder();
+        ~ProgramBuilder();
+
+        ProgramBuilder(const ProgramBuilder&) = delete;
+        ProgramBuilder& operator = (const ProgramBuilder&) = delete;
+
+        //! Sets the source identifier and position for all subsequently made nodes. By default the identifier is empty and the position is (1:1).
+        void SetSource(const std::string& sourceIdent, unsigned int row = 1, unsigned int column = 1);
+
+        /* ----- Declarations ----- */
+
+        //! Begins a new structure declaration in the global scope.
+        void BeginStruct(const std::string& ident);
+
+        //! Ends the current structure declaration.
+        void EndStruct();
+
+        //! Begins a new constant buffer ("cbuffer") in the global scope. The slot is ignored if it is negative. By default -1.
+        void BeginConstantBuffer(const std::string& ident, int slot = -1);
+
+        //! Ends the current constant buffer.
+        void EndConstantBuffer();
+
+        /**
+        \brief Declares a variable in the current scope (i.e. a global, local, structure member, or constant buffer member variable).
+        \param[in] type Specifies the type name with optional modifiers and array dimensions (e.g. "nointerpolation float4" or "float3[4]").
+        \param[in] ident Specifies the variable identifier.
+        \param[in] semantic Specifies the optional semantic (e.g. "TEXCOORD0"). By default empty.
+        \param[in] initializer Specifies the optional initializer expression. By default invalid.
+        */
+        void DeclareVariable(const std::string& type, const std::string& ident, const std::string& semantic = "", Expr initializer = {});
+
+        //! Declares a texture, buffer, or sampler state in the global scope (e.g. "Texture2D<float4>" or "SamplerState"). The slot is ignored if it is negative. By default -1.
+        void DeclareResource(const std::string& type, const std::string& ident, int slot = -1);
+
+        //! Begins a new function declaration in the global scope (or within the current structure).
+        void BeginFunction(const std::string& returnType, const std::string& ident, const std::string& semantic = "");
+
+        //! Declares a parameter of the current function. The type can have input modifiers (e.g. "inout float3").
+        void DeclareParameter(const std::string& type, const std::string& ident, const std::string& semantic = "");
+
+        //! Ends the current function declaration.
+        void EndFunction();
+
+        /* ----- Statements ----- */
+
+        //! Appends an assignment (e.g. "=" or "+=") to the current block. The left hand side must be a variable access (see Var, Member, and Index).
+        void Assign(Expr lhs, Expr rhs, const std::string& op = "=");
+
+        //! Appends an expression statement (e.g. a call to a void function) to the current block.
+        void Evaluate(Expr expr);
+
+        //! Appends a return statement with an optional value to the current block.
+        void Return(Expr expr = {});
+
+        //! Appends a "discard" statement to the current block.
+        void Discard();
+
+        //! Appends a "break" statement to the current block.
+        void Break();
+
+        //! Appends a "continue" statement to the current block.
+        void Continue();
+
+        //! Begins an if-statement with the specified condition.
+        void BeginIf(Expr condition);
+
+        //! Begins the else-branch of the current if-statement.
+        void BeginElse();
+
+        //! Ends the current if-statement.
+        void EndIf();
+
+        //! Begins a for-loop with a loop variable (e.g. "for (int i = 0; i < n; ++i)"). The iteration expression is optional.
+        void BeginFor(const std::string& type, const std::string& ident, Expr initializer, Expr condition, Expr iteration = {});
+
+        //! Ends the current for-loop.
+        void EndFor();
+
+        /* ----- Expressions ----- */
+
+        //! Makes a boolean literal.
+        Expr Literal(bool value);
+
+        //! Makes an integer literal.
+        Expr Literal(int value);
+
+        //! Makes an unsigned integer literal.
+        Expr Literal(unsigned int value);
+
+        //! Makes a floating-point literal.
+        Expr Literal(float value);
+
+        //! Makes an access to the specified variable.
+        Expr Var(const std::string& ident);
+
+        //! Makes an access to a member of the specified object (e.g. a structure member or vector swizzle).
+        Expr Member(Expr object, const std::string& ident);
+
+        //! Makes an array access of the specified object.
+        Expr Index(Expr object, Expr index);
+
+        //! Makes a unary expression (e.g. "-", "!", "~", "++", or "--").
+        Expr Unary(const std::string& op, Expr expr);
+
+        //! Makes a binary expression (e.g. "+", "*", "<", or "&&").
+        Expr Binary(Expr lhs, const std::string& op, Expr rhs);
+
+        //! Makes a ternary expression (e.g. "c ? a : b").
+        Expr Ternary(Expr condition, Expr thenExpr, Expr elseExpr);
+
+        //! Makes a call to a function or intrinsic (e.g. "saturate").
+        Expr Call(const std::string& ident, const std::vector<Expr>& args);
+
+        //! Makes a call to a method of the specified object (e.g. "Sample" of a texture). The object must be a variable access.
+        Expr MethodCall(Expr object, const std::string& ident, const std::vector<Expr>& args);
+
+        //! Makes a type constructor (e.g. "float4(rgb, 1.0)").
+        Expr Construct(const std::string& type, const std::vector<Expr>& args);
+
+        //! Makes a type cast (e.g. "(int)x").
+        Expr Cast(const std::string& type, Expr expr);
+
+    private:
+
+        friend XSC_EXPORT bool CompileShader(
+            ProgramBuilder&, const ShaderInput&, const ShaderOutput&, Log*, Reflection::ReflectionData*
+        );
+
+        HLSLProgramBuilder* builder_ = nullptr;
+
+};
+
+/**
+\brief Compiles the shader program that has been constructed with the specified builder into the specified output shader code.
+\param[in,out] builder Specifies the program builder. The built program is consumed by this function, i.e. the builder is empty afterwards.
+\param[in] inputDesc Input shader descriptor. The input stream and filename are ignored, but the shader target, version, and entry point are used.
+\param[in] outputDesc Output shader code descriptor.
+\param[in] log Optional pointer to an output log. By default null.
+\param[out] reflectionData Optional pointer to a code reflection data structure. By default null.
+\return True if the code has been translated successfully.
+\throw std::invalid_argument If the output stream is null or if any builder scope has not been ended.
+\see CompileShader(const ShaderInput&, const ShaderOutput&, Log*, Reflection::ReflectionData*)
+*/
+XSC_EXPORT bool CompileShader(
+    ProgramBuilder&             builder,
+    const ShaderInput&          inputDesc,
+    const ShaderOutput&         outputDesc,
+    Log*                        log             = nullptr,
+    Reflection::ReflectionData* reflectionData  = nullptr
+);
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -132,6 +132,170 @@ struct NumThreads
     int z = 0;
 };
 
+//! Location of a shader input/output variable (also referred to as "varying") inside a packed slot.
+struct PackedVarying
+{
+    //! Semantic of the varying (e.g. "TEXCOORD0").
+    std::string     semantic;
+
+    //! Identifier of the packed slot variable (e.g. "xsv_pack0").
+    std::string     slotIdent;
+
+    //! Zero based index of the packed slot.
+    int             slot            = 0;
+
+    //! Zero based index of the first component inside the slot (0 for 'x', 1 for 'y', etc.).
+    unsigned int    firstComponent  = 0;
+
+    //! Number of components of the varying (1 to 4).
+    unsigned int    numComponents   = 0;
+};
+
+//! Access of a texture or storage buffer by the code that is reachable from the entry point.
+struct ResourceAccess
+{
+    //! Identifier of the texture or storage buffer.
+    std::string ident;
+
+    //! Specifies whether the resource is read (e.g. "Tex.Sample(...)" or "x = Buf[i]").
+    bool        read        = false;
+
+    //! Specifies whether the resource is written (e.g. "Buf[i] = x"). Only read/write resources (e.g. RWTexture2D) can be written.
+    bool        written     = false;
+
+    //! Specifies whether the resource is accessed with atomic operations (e.g. "InterlockedAdd(Buf[i], x)").
+    bool        atomic      = false;
+
+    /**
+    \brief Specifies whether the resource is accessed in divergent control flow.
+    \remarks This is true if any access depends on a condition that may differ between shader invocations (e.g. a texture value or a shader input).
+    Accesses that only depend on uniforms, literals, and loop counters with uniform bounds are considered to be in uniform control flow.
+    */
+    bool        divergent   = false;
+};
+
+//! Storage class of a constant buffer or structured buffer in the output code.
+enum class BufferStorage
+{
+    Uniform,        //!< Uniform buffer (i.e. "layout(std140) uniform").
+    Storage,        //!< Shader storage buffer (i.e. "layout(std430) buffer").
+    PushConstant,   //!< Member of the push constant block (i.e. "layout(push_constant) uniform").
+};
+
+/**
+\brief Storage class that has been chosen for a constant buffer or a read-only structured buffer (see Options::pushConstantBudget and Options::uniformStorageBufferSize).
+\remarks All constant buffers with BufferStorage::PushConstant share a single push constant block, in which each of them keeps its own "std140" layout.
+*/
+struct BufferClass
+{
+    //! Identifier of the constant buffer or structured buffer.
+    std::string     ident;
+
+    //! Storage class in the output code.
+    BufferStorage   storage     = BufferStorage::Uniform;
+
+    //! Offset (in bytes) of the constant buffer within the push constant block. Only used for BufferStorage::PushConstant.
+    unsigned int    offset      = 0;
+
+    //! Size (in bytes) of the buffer in the "std140" layout, or 0 if the size is unbounded or unknown.
+    unsigned int    size        = 0;
+
+    //! Number of elements of a structured buffer that is declared as uniform buffer, or 0 otherwise.
+    unsigned int    numElements = 0;
+};
+
+//! Code region enumeration of a profiling counter.
+enum class ProfileCounterType
+{
+    Function,   //!< Counts the calls of a function.
+    Branch,     //!< Counts the executions of an 'if'/'else' body or a 'switch' case.
+    Loop,       //!< Counts the iterations of a loop body.
+};
+
+//! Execution counter of the profiling instrumentation (see Options::profileCounters).
+struct ProfileCounter
+{
+    //! Zero based index of the counter within the profiling counter buffer.
+    unsigned int        index       = 0;
+
+    //! Code region that is counted.
+    ProfileCounterType  type        = ProfileCounterType::Function;
+
+    //! Identifier of the function that contains the counted code region.
+    std::string         function;
+
+    //! Source location of the counted code region (e.g. "Example.hlsl:12:5").
+    std::string         location;
+};
+
+//! Preshader instruction opcode enumeration.
+enum class PreshaderOpcode
+{
+    Load,       //!< Pushes the value of the uniform 'value' (e.g. "LightDir" or "Lights[2].Color").
+    Constant,   //!< Pushes the literal 'value' (e.g. "2.2").
+    Unary,      //!< Pops one operand and pushes the result of the unary operator 'value' (e.g. "-").
+    Binary,     //!< Pops two operands and pushes the result of the binary operator 'value' (e.g. "*").
+    Select,     //!< Pops the condition, then- and else-operand (in this order of pushing), and pushes the selected value (i.e. "cond ? a : b").
+    Swizzle,    //!< Pops one operand and pushes its vector or matrix subscript 'value' (e.g. "xyz").
+    Call,       //!< Pops 'numOperands' arguments and pushes the result of the intrinsic or type constructor 'value' (e.g. "pow" or "float4").
+    Cast,       //!< Pops one operand and pushes it casted to the type 'value' (e.g. "float3").
+};
+
+//! Preshader instruction of a stack based expression program.
+struct PreshaderInstruction
+{
+    //! Instruction opcode.
+    PreshaderOpcode opcode      = PreshaderOpcode::Load;
+
+    //! Instruction value (see PreshaderOpcode).
+    std::string     value;
+
+    //! Number of operands that are popped from the stack.
+    unsigned int    numOperands = 0;
+
+    //! Data type of the result in the input language (e.g. "float4x4").
+    std::string     type;
+};
+
+/**
+\brief Uniform-only expression that has been extracted from the shader into a constant buffer member.
+\remarks The instructions are in post-order, i.e. the result is the only value on the stack after all instructions have been executed.
+Operators and intrinsics have the semantics of the input language (e.g. "*" is a component-wise multiplication and "mul" is a matrix multiplication in HLSL).
+*/
+struct PreshaderExpression
+{
+    //! Identifier of the constant buffer member that receives the result.
+    std::string                         ident;
+
+    //! Data type of the result in the input language (e.g. "float4x4").
+    std::string                         type;
+
+    //! Instructions of the expression program.
+    std::vector<PreshaderInstruction>   instructions;
+};
+
+/**
+\brief Static constant array that has been moved into a member of the constant table buffer (see Options::constantTableThreshold).
+\remarks The initial values of all constant tables are stored in ReflectionData::constantTableData.
+*/
+struct ConstantTable
+{
+    //! Identifier of the constant buffer member.
+    std::string     ident;
+
+    //! Data type of the array elements in the input language (e.g. "float2").
+    std::string     type;
+
+    //! Number of array elements.
+    unsigned int    size    = 0;
+
+    //! Offset (in bytes) of the first array element within the constant table data.
+    unsigned int    offset  = 0;
+
+    //! Distance (in bytes) between two consecutive array elements.
+    unsigned int    stride  = 0;
+};
+
 //! Structure for shader output statistics (e.g. texture/buffer binding points).
 struct ReflectionData
 {
@@ -158,6 +322,48 @@ struct ReflectionData
 
     //! 'numthreads' attribute of a compute shader.
     NumThreads                          numThreads;
+
+    //! Identifier of the constant buffer that holds the results of all preshader expressions. Empty if no expression has been extracted.
+    std::string                         preshaderBuffer;
+
+    //! Uniform-only expressions that have been extracted from the shader (see Options::extractPreshaders).
+    std::vector<PreshaderExpression>    preshaders;
+
+    //! Identifier of the constant buffer that holds all constant tables. Empty if no constant array has been moved.
+    std::string                         constantTableBuffer;
+
+    //! Static constant arrays that have been moved into the constant table buffer (see Options::constantTableThreshold).
+    std::vector<ConstantTable>          constantTables;
+
+    /**
+    \brief Initial data of the constant table buffer in the "std140" layout, which must be uploaded once by the application.
+    \remarks All scalars are 32 bits wide in the byte order of the host (booleans are stored as integers).
+    */
+    std::vector<char>                   constantTableData;
+
+    //! Shader input varyings that have been packed into slots (see Options::packVaryings).
+    std::vector<PackedVarying>          packedInputs;
+
+    //! Shader output varyings that have been packed into slots (see Options::packVaryings).
+    std::vector<PackedVarying>          packedOutputs;
+
+    //! Semantics of the shader output varyings that are declared with 'flat' interpolation, because they are constant within each primitive (see Options::flatVaryings).
+    std::vector<std::string>            flatOutputs;
+
+    //! Accesses of all textures and storage buffers that are reachable from the entry point.
+    std::vector<ResourceAccess>         resourceAccesses;
+
+    //! Storage classes of all constant buffers and read-only structured buffers that are reachable from the entry point. Only filled for VKSL output with Options::pushConstantBudget or Options::uniformStorageBufferSize.
+    std::vector<BufferClass>            bufferClasses;
+
+    /**
+    \brief Binding slot of the synthesized buffer that holds all profiling counters (see Options::profileCounters). The identifier is empty if the output is not instrumented.
+    \remarks Each counter is a 32-bit unsigned integer, and the buffer must be cleared by the application before the instrumented shader is executed.
+    */
+    BindingSlot                         profileCounterBuffer    = { "", -1 };
+
+    //! Profiling counters in the order of their indices within the profiling counter buffer.
+    std::vector<ProfileCounter>         profileCounters;
 };
 
 
@@ -173,6 +379,12 @@ XSC_EXPORT std::string ToString(const Reflection::TextureAddressMode t);
 //! Returns the string representation of the specified 'SamplerState::ComparisonFunc' type.
 XSC_EXPORT std::string ToString(const Reflection::ComparisonFunc t);
 
+//! Returns the string representation of the specified 'BufferClass::BufferStorage' type.
+XSC_EXPORT std::string ToString(const Reflection::BufferStorage t);
+
+//! Returns the string representation of the specified 'ProfileCounter::ProfileCounterType' type.
+XSC_EXPORT std::string ToString(const Reflection::ProfileCounterType t);
+
 //! Prints the reflection data into the output stream in a human readable format.
 XSC_EXPORT void PrintReflection(std::ostream& stream, const Reflection::ReflectionData& reflectionData);
 
@@ -0,0 +1,107 @@
+/*
+ * TaskScheduler.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_TASK_SCHEDULER_H
+#define XSC_TASK_SCHEDULER_H
+
+
+#include "Export.h"
+#include <functional>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+//! Number of a group of tasks (see TaskScheduler::NewGroup).
+using TaskGroup = std::size_t;
+
+/**
+\brief Interface for the execution of the internal parallelism of the compiler (e.g. batch jobs and parallel parsing).
+\remarks Implement this interface to run the compiler tasks inside the worker pool of an existing job system, instead of additional threads.
+All functions of this interface must be thread-safe. Tasks may submit further tasks and wait for their groups (i.e. nested parallelism),
+so an implementation should execute the pending tasks of a group (or any other pending tasks) while waiting for it, instead of blocking a worker.
+The default implementation is StdTaskScheduler.
+*/
+class XSC_EXPORT TaskScheduler
+{
+
+    public:
+
+        //! Task function callback. Tasks never throw exceptions.
+        using Task = std::function<void()>;
+
+        virtual ~TaskScheduler();
+
+        /**
+        \brief Submits the specified task to the specified group.
+        \param[in] group Specifies the group number of the task. Each group number is only used until "Wait" returns for this group.
+        \param[in] task Specifies the task function. It may be executed on any thread, but must be executed before "Wait" returns for its group.
+        */
+        virtual void Submit(TaskGroup group, const Task& task) = 0;
+
+        //! Blocks until all tasks of the specified group have been executed.
+        virtual void Wait(TaskGroup group) = 0;
+
+        //! Returns the number of tasks that can be executed concurrently (at least 1).
+        virtual unsigned Concurrency() const = 0;
+
+        //! Returns a new unique group number.
+        static TaskGroup NewGroup();
+
+};
+
+/**
+\brief Default task scheduler with a pool of std::thread workers, which are started on the first submitted task.
+\remarks The thread that waits for a group executes the pending tasks of this group as well,
+so only "Concurrency() - 1" worker threads are started.
+*/
+class XSC_EXPORT StdTaskScheduler : public TaskScheduler
+{
+
+    public:
+
+        /**
+        \brief Initializes the scheduler with the specified concurrency level.
+        \param[in] concurrency Specifies the number of tasks that are executed concurrently. If this is 0, the number of hardware threads is used. By default 0.
+        */
+        StdTaskScheduler(unsigned concurrency = 0);
+        ~StdTaskScheduler();
+
+        StdTaskScheduler(const StdTaskScheduler&) = delete;
+        StdTaskScheduler& operator = (const StdTaskScheduler&) = delete;
+
+        //! Implements the base class interface.
+        void Submit(TaskGroup group, const Task& task) override;
+
+        //! Implements the base class interface.
+        void Wait(TaskGroup group) override;
+
+        //! Implements the base class interface.
+        unsigned Concurrency() const override;
+
+        //! Returns the shared default scheduler, which is used whenever no task scheduler has been specified.
+        static StdTaskScheduler& Default();
+
+    private:
+
+        class ThreadPool;
+
+        ThreadPool* pool_ = nullptr;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
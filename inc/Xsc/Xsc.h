@@ -12,6 +12,7 @@
 #include "Export.h"
 #include "Log.h"
 #include "IncludeHandler.h"
+#include "TaskScheduler.h"
 #include "Targets.h"
 #include "Version.h"
 #include "Reflection.h"
@@ -101,6 +102,21 @@ struct Formatting
     bool        lineSeparation      = true;
 };
 
+//! Fast-math substitution flags enumeration (see Options::fastMath).
+struct FastMathFlags
+{
+    enum
+    {
+        PowToMul    = (1 << 0), //!< Replaces 'pow' with a constant exponent of -0.5, 0.5, 1, 2, 3, or 4 by 'inversesqrt', 'sqrt', or multiplications.
+        Normalize   = (1 << 1), //!< Replaces 'normalize(x)' by 'x * inversesqrt(dot(x, x))'.
+        ExpLog      = (1 << 2), //!< Replaces 'exp', 'log', and 'log10' by scaled 'exp2' and 'log2'.
+        MulAdd      = (1 << 3), //!< Replaces 'a * b + c' by 'fma(a, b, c)'. This is only done for GLSL 4.00+, ESSL 3.20, and VKSL output.
+        Saturate    = (1 << 4), //!< Removes redundant nested 'saturate' and 'clamp(x, 0, 1)' calls.
+
+        All         = (PowToMul | Normalize | ExpLog | MulAdd | Saturate), //!< All fast-math substitutions.
+    };
+};
+
 //! Structure for additional translation options.
 struct Options
 {
@@ -110,12 +126,19 @@ struct Options
     //! If true, little code optimizations are performed. By default false.
     bool optimize                   = false;
 
-    //! If true, only the preprocessed source code will be written out. By default false.
+    /**
+    \brief If true, only the preprocessed source code will be written out. By default false.
+    \remarks The preprocessed source code is written into the output stream in chunks, so only a bounded amount of output is buffered.
+    If pre-processing fails, the output stream may already contain parts of the output.
+    */
     bool preprocessOnly             = false;
 
     //! If true, the source code is only validated, but no output code will be generated. By default false.
     bool validateOnly               = false;
 
+    //! If true, only diagnostics are reported: the parser recovers from syntax errors, the context analysis runs on erroneous code, and no output code is generated. By default false.
+    bool diagnosticsMode            = false;
+
     //! If true, the shader output may contain GLSL extensions, if the target shader version is too low. By default false.
     bool allowExtensions            = false;
 
@@ -137,11 +160,53 @@ struct Options
     //! If true, code obfuscation is performed. By default false.
     bool obfuscate                  = false;
 
+    //! If true, uniform-only expressions are extracted into a synthesized constant buffer and reported as preshaders in the reflection data. By default false.
+    bool extractPreshaders          = false;
+
+    //! Minimal number of elements of a static constant array to be moved into a synthesized constant buffer, whose data is reported in the reflection data. Smaller constant arrays are written with array constructors. Zero disables this conversion. By default 0.
+    unsigned int constantTableThreshold = 0;
+
+    //! Whitelist of fast-math substitutions, which trade precision for fewer ALU instructions. This can be a bitwise OR combination of the entries of the FastMathFlags enumeration. Each substitution is reported as info. By default 0.
+    unsigned int fastMath           = 0;
+
+    //! Size (in bytes) of the push constant block for VKSL output. Constant buffers that fit into this budget (e.g. small per-draw buffers) are merged into a single 'push_constant' block, and the choice is reported in the reflection data. Vulkan guarantees at least 128 bytes. Zero disables this conversion. Ignored for GLSL and ESSL. By default 0.
+    unsigned int pushConstantBudget = 0;
+
+    //! Size limit (in bytes) of uniform buffers for VKSL output. Read-only structured buffers with uniform indices, whose elements have the same layout in "std140" and "std430", are declared as uniform buffers with as many elements as fit into this limit (instead of storage buffers), and the choice is reported in the reflection data. Vulkan guarantees at least 16384 bytes. Zero disables this conversion. Ignored for GLSL and ESSL. By default 0.
+    unsigned int uniformStorageBufferSize = 0;
+
+    //! If true, compatible shader input/output variables (varyings) are packed into 4-component slots, which are declared with explicit locations if the output version supports them (see ShaderOutput::packedInputLayout). By default false.
+    bool packVaryings               = false;
+
+    //! If true, a position-only variant of a vertex or tessellation-evaluation shader is generated, whose only output is the position system value (e.g. for depth-only passes). By default false.
+    bool positionOnly               = false;
+
+    //! If true, vertex shader outputs that are not derived from per-vertex inputs are declared with 'flat' interpolation, and reported in the reflection data (see ShaderOutput::flatInputSemantics for the fragment shader side). By default false.
+    bool flatVaryings               = false;
+
+    //! If true, isomorphic scalar operations on the components of the same vector are merged into vector operations (e.g. "v.x = a.x * s; v.y = a.y * s;" -> "v.xy = a.xy * s;"). Each merge is reported as info. By default false.
+    bool vectorize                  = false;
+
+    //! If true, local arrays and structures whose elements are only accessed with constant indices are replaced by individual scalar or vector temporaries (scalar replacement of aggregates). Each replacement is reported as info. By default false.
+    bool scalarReplacement          = false;
+
+    //! If true, side effect free loop invariant expressions are hoisted out of loops into temporaries, and multiplications of integral induction variables are reduced to additions. Each transformation is reported as info. By default false.
+    bool optimizeLoops              = false;
+
+    //! If true, the output code is instrumented with execution counters for each function, branch, and loop body, which are incremented atomically in a synthesized storage buffer (or atomic counters for GLSL 4.20). The counters are mapped to their source locations in the reflection data. By default false.
+    bool profileCounters            = false;
+
+    //! If true, the global declarations of the HLSL input are parsed in parallel chunks, if the input is large enough. Falls back to serial parsing when a chunk depends on its context (the resulting AST and reports are always the same). Ignored in diagnostics mode. By default false.
+    bool parallelParsing            = false;
+
     //! If true, the AST (Abstract Syntax Tree) will be written to the log output. By default false.
     bool showAST                    = false;
 
     //! If true, the timings of the different compilation processes are written to the log output. By default false.
     bool showTimes                  = false;
+
+    //! If true, the peak memory during the different compilation processes (where supported), and the resident memory after each process (with its change during that process) are written to the log output. By default false.
+    bool showMemory                 = false;
 };
 
 //! Name mangling descriptor structure for shader input/output variables (also referred to as "varyings"), temporary variables, and reserved keywords.
@@ -204,6 +269,21 @@ struct ShaderInput
     \remarks If this is null, the default include handler will be used, which will include files with the STL input file streams.
     */
     IncludeHandler*                 includeHandler  = nullptr;
+
+    /**
+    \brief Optional pointer to a memo of pre-processed include files. By default null.
+    \remarks If this is not null, the expansions of all include files are recorded in (and replayed from) this memo.
+    Share the same memo between all compilations that include the same files, e.g. all permutations of a shader.
+    \see IncludeCache
+    */
+    IncludeCache*                   includeCache    = nullptr;
+
+    /**
+    \brief Optional pointer to the implementation of the "TaskScheduler" interface. By default null.
+    \remarks All internal parallelism of the compilation (e.g. parallel parsing) is executed as tasks of this scheduler.
+    If this is null, the shared default scheduler is used (see StdTaskScheduler::Default).
+    */
+    TaskScheduler*                  taskScheduler   = nullptr;
 };
 
 //! Vertex shader semantic (or rather attribute) layout structure.
@@ -216,6 +296,19 @@ struct VertexSemantic
     int         location;
 };
 
+/**
+\brief Measured execution count of a code region for profile-guided optimization.
+\remarks The execution counts can be gathered with an instrumented output (see Options::profileCounters and Reflection::ProfileCounter).
+*/
+struct ProfileCount
+{
+    //! Source location of the code region in the format "Filename:Row:Column" (e.g. "Example.hlsl:12:5"). The directory of the filename is ignored.
+    std::string         location;
+
+    //! Number of executions of the code region.
+    unsigned long long  count       = 0;
+};
+
 //! Shader output descriptor structure.
 struct ShaderOutput
 {
@@ -231,6 +324,27 @@ struct ShaderOutput
     //! Optional list of vertex semantic layouts, to bind a vertex attribute (semantic name) to a location index (only used when 'explicitBinding' is true).
     std::vector<VertexSemantic> vertexSemantics;
 
+    /**
+    \brief Optional list of fragment shader input semantics (e.g. "COLOR0"), which are declared with 'flat' interpolation.
+    \remarks This should be filled with the flat outputs of the respective vertex shader (see Reflection::ReflectionData::flatOutputs and Options::flatVaryings).
+    */
+    std::vector<std::string>    flatInputSemantics;
+
+    /**
+    \brief Optional packing map of the previous shader stage (see Reflection::ReflectionData::packedOutputs and Options::packVaryings).
+    \remarks If this is not empty, the input varyings are packed into the same slots and components as the outputs of the previous stage,
+    even if this stage only uses some of them. Otherwise, both stages only agree on the packing if they use exactly the same varyings.
+    */
+    std::vector<Reflection::PackedVarying> packedInputLayout;
+
+    /**
+    \brief Optional list of execution counts for profile-guided optimization.
+    \remarks Counts of 'if' and 'else' bodies, 'switch' cases, and loop bodies are used to reorder branches and to unroll hot loops.
+    Counts of the same location are accumulated, and locations that are not found in the program are ignored.
+    Each optimization is reported as info. This is ignored if Options::profileCounters is enabled.
+    */
+    std::vector<ProfileCount>   profileCounts;
+
     //! Additional options to configure the code generation.
     Options                     options;
 
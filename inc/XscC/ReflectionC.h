@@ -121,6 +121,119 @@ struct XscNumThreads
     int z;
 };
 
+//! Location of a shader input/output variable (also referred to as "varying") inside a packed slot.
+struct XscPackedVarying
+{
+    //! Semantic of the varying (e.g. "TEXCOORD0").
+    const char*         semantic;
+
+    //! Identifier of the packed slot variable (e.g. "xsv_pack0"). Ignored in XscShaderOutput::packedInputLayout.
+    const char*         slotIdent;
+
+    //! Zero based index of the packed slot.
+    int                 slot;
+
+    //! Zero based index of the first component inside the slot (0 for 'x', 1 for 'y', etc.).
+    unsigned int        firstComponent;
+
+    //! Number of components of the varying (1 to 4).
+    unsigned int        numComponents;
+};
+
+//! Code region enumeration of a profiling counter.
+enum XscProfileCounterType
+{
+    XscEProfileCounterFunction, //!< Counts the calls of a function.
+    XscEProfileCounterBranch,   //!< Counts the executions of an 'if'/'else' body or a 'switch' case.
+    XscEProfileCounterLoop,     //!< Counts the iterations of a loop body.
+};
+
+//! Execution counter of the profiling instrumentation (see XscOptions::profileCounters).
+struct XscProfileCounter
+{
+    //! Zero based index of the counter within the profiling counter buffer.
+    unsigned int                index;
+
+    //! Code region that is counted.
+    enum XscProfileCounterType  type;
+
+    //! Identifier of the function that contains the counted code region.
+    const char*                 function;
+
+    //! Source location of the counted code region (e.g. "Example.hlsl:12:5").
+    const char*                 location;
+};
+
+//! Preshader instruction opcode enumeration.
+enum XscPreshaderOpcode
+{
+    XscEPreshaderLoad,      //!< Pushes the value of the uniform 'value' (e.g. "LightDir" or "Lights[2].Color").
+    XscEPreshaderConstant,  //!< Pushes the literal 'value' (e.g. "2.2").
+    XscEPreshaderUnary,     //!< Pops one operand and pushes the result of the unary operator 'value' (e.g. "-").
+    XscEPreshaderBinary,    //!< Pops two operands and pushes the result of the binary operator 'value' (e.g. "*").
+    XscEPreshaderSelect,    //!< Pops the condition, then- and else-operand (in this order of pushing), and pushes the selected value (i.e. "cond ? a : b").
+    XscEPreshaderSwizzle,   //!< Pops one operand and pushes its vector or matrix subscript 'value' (e.g. "xyz").
+    XscEPreshaderCall,      //!< Pops 'numOperands' arguments and pushes the result of the intrinsic or type constructor 'value' (e.g. "pow" or "float4").
+    XscEPreshaderCast,      //!< Pops one operand and pushes it casted to the type 'value' (e.g. "float3").
+};
+
+//! Preshader instruction of a stack based expression program.
+struct XscPreshaderInstruction
+{
+    //! Instruction opcode.
+    enum XscPreshaderOpcode opcode;
+
+    //! Instruction value (see XscPreshaderOpcode).
+    const char*             value;
+
+    //! Number of operands that are popped from the stack.
+    unsigned int            numOperands;
+
+    //! Data type of the result in the input language (e.g. "float4x4").
+    const char*             type;
+};
+
+/**
+\brief Uniform-only expression that has been extracted from the shader into a constant buffer member (see XscOptions::extractPreshaders).
+\remarks The instructions are in post-order, i.e. the result is the only value on the stack after all instructions have been executed.
+*/
+struct XscPreshaderExpression
+{
+    //! Identifier of the constant buffer member that receives the result.
+    const char*                             ident;
+
+    //! Data type of the result in the input language (e.g. "float4x4").
+    const char*                             type;
+
+    //! Instructions of the expression program.
+    const struct XscPreshaderInstruction*   instructions;
+
+    //! Number of elements in 'instructions'.
+    size_t                                  instructionsCount;
+};
+
+/**
+\brief Static constant array that has been moved into a member of the constant table buffer (see XscOptions::constantTableThreshold).
+\remarks The initial values of all constant tables are stored in XscReflectionData::constantTableData.
+*/
+struct XscConstantTable
+{
+    //! Identifier of the constant buffer member.
+    const char*     ident;
+
+    //! Data type of the array elements in the input language (e.g. "float2").
+    const char*     type;
+
+    //! Number of array elements.
+    unsigned int    size;
+
+    //! Offset (in bytes) of the first array element within the constant table data.
+    unsigned int    offset;
+
+    //! Distance (in bytes) between two consecutive array elements.
+    unsigned int    stride;
+};
+
 //! Structure for shader output statistics (e.g. texture/buffer binding points).
 struct XscReflectionData
 {
@@ -168,6 +281,57 @@ struct XscReflectionData
 
     //! 'numthreads' attribute of a compute shader.
     struct XscNumThreads            numThreads;
+
+    //! Shader input varyings that have been packed into slots (see XscOptions::packVaryings).
+    const struct XscPackedVarying*  packedInputs;
+
+    //! Number of elements in 'packedInputs'.
+    size_t                          packedInputsCount;
+
+    //! Shader output varyings that have been packed into slots (see XscOptions::packVaryings). This can be passed as XscShaderOutput::packedInputLayout to the next shader stage.
+    const struct XscPackedVarying*  packedOutputs;
+
+    //! Number of elements in 'packedOutputs'.
+    size_t                          packedOutputsCount;
+
+    //! Identifier of the constant buffer that holds the results of all preshader expressions. Empty if no expression has been extracted.
+    const char*                     preshaderBuffer;
+
+    //! Uniform-only expressions that have been extracted from the shader (see XscOptions::extractPreshaders).
+    const struct XscPreshaderExpression* preshaders;
+
+    //! Number of elements in 'preshaders'.
+    size_t                          preshadersCount;
+
+    //! Identifier of the constant buffer that holds all constant tables. Empty if no constant array has been moved.
+    const char*                     constantTableBuffer;
+
+    //! Static constant arrays that have been moved into the constant table buffer (see XscOptions::constantTableThreshold).
+    const struct XscConstantTable*  constantTables;
+
+    //! Number of elements in 'constantTables'.
+    size_t                          constantTablesCount;
+
+    /**
+    \brief Initial data of the constant table buffer in the "std140" layout, which must be uploaded once by the application.
+    \remarks All scalars are 32 bits wide in the byte order of the host (booleans are stored as integers).
+    */
+    const void*                     constantTableData;
+
+    //! Size (in bytes) of the data 'constantTableData' points to.
+    size_t                          constantTableDataSize;
+
+    /**
+    \brief Binding slot of the synthesized buffer that holds all profiling counters (see XscOptions::profileCounters). The identifier is empty if the output is not instrumented.
+    \remarks Each counter is a 32-bit unsigned integer, and the buffer must be cleared by the application before the instrumented shader is executed.
+    */
+    struct XscBindingSlot           profileCounterBuffer;
+
+    //! Profiling counters in the order of their indices within the profiling counter buffer.
+    const struct XscProfileCounter* profileCounters;
+
+    //! Number of elements in 'profileCounters'.
+    size_t                          profileCountersCount;
 };
 
 
@@ -0,0 +1,80 @@
+/*
+ * TaskSchedulerC.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_TASK_SCHEDULER_C_H
+#define XSC_TASK_SCHEDULER_C_H
+
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+\brief Function interface of a compiler task.
+\param[in] taskData Specifies the data of the task, which has been passed to the submit callback. Each task must be executed exactly once.
+*/
+typedef void (*XSC_PFN_TASK)(void* taskData);
+
+/**
+\brief Function callback interface for submitting a task.
+\param[in] userData Specifies the user data of the task scheduler.
+\param[in] group Specifies the group number of the task. Each group number is only used until the wait callback returns for this group.
+\param[in] task Specifies the task function, which must be called with 'taskData' before the wait callback returns for this group.
+\param[in] taskData Specifies the data of the task.
+*/
+typedef void (*XSC_PFN_SUBMIT_TASK)(void* userData, size_t group, XSC_PFN_TASK task, void* taskData);
+
+/**
+\brief Function callback interface for waiting until all tasks of a group have been executed.
+\param[in] userData Specifies the user data of the task scheduler.
+\param[in] group Specifies the group number.
+*/
+typedef void (*XSC_PFN_WAIT_TASK_GROUP)(void* userData, size_t group);
+
+/**
+\brief Function callback interface for querying the concurrency level.
+\param[in] userData Specifies the user data of the task scheduler.
+\return Number of tasks that can be executed concurrently.
+*/
+typedef unsigned (*XSC_PFN_TASK_CONCURRENCY)(void* userData);
+
+
+/**
+\brief Task scheduler structure, which executes the internal parallelism of the compiler.
+\remarks If any of the function pointers is NULL, the default task scheduler is used.
+Tasks may submit further tasks and wait for their groups, so the wait callback should execute pending tasks instead of blocking a worker.
+*/
+struct XscTaskScheduler
+{
+    //! Function pointer to submit a task.
+    XSC_PFN_SUBMIT_TASK         submitTaskPfn;
+
+    //! Function pointer to wait for a task group.
+    XSC_PFN_WAIT_TASK_GROUP     waitTaskGroupPfn;
+
+    //! Function pointer to query the concurrency level.
+    XSC_PFN_TASK_CONCURRENCY    concurrencyPfn;
+
+    //! User data, which is passed to all callbacks.
+    void*                       userData;
+};
+
+
+#ifdef __cplusplus
+} // /extern "C"
+#endif
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
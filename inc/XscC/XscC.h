@@ -14,6 +14,7 @@
 #include "TargetsC.h"
 #include "LogC.h"
 #include "IncludeHandlerC.h"
+#include "TaskSchedulerC.h"
 #include "ReflectionC.h"
 #include <stdbool.h>
 
@@ -48,6 +49,18 @@ struct XscFormatting
     bool        lineSeparation;
 };
 
+//! Fast-math substitution flags enumeration (see XscOptions::fastMath).
+enum XscFastMathFlags
+{
+    XscFastMathPowToMul     = (1 << 0), //!< Replaces 'pow' with a constant exponent of -0.5, 0.5, 1, 2, 3, or 4 by 'inversesqrt', 'sqrt', or multiplications.
+    XscFastMathNormalize    = (1 << 1), //!< Replaces 'normalize(x)' by 'x * inversesqrt(dot(x, x))'.
+    XscFastMathExpLog       = (1 << 2), //!< Replaces 'exp', 'log', and 'log10' by scaled 'exp2' and 'log2'.
+    XscFastMathMulAdd       = (1 << 3), //!< Replaces 'a * b + c' by 'fma(a, b, c)'. This is only done for GLSL 4.00+, ESSL 3.20, and VKSL output.
+    XscFastMathSaturate     = (1 << 4), //!< Removes redundant nested 'saturate' and 'clamp(x, 0, 1)' calls.
+
+    XscFastMathAll          = (XscFastMathPowToMul | XscFastMathNormalize | XscFastMathExpLog | XscFastMathMulAdd | XscFastMathSaturate), //!< All fast-math substitutions.
+};
+
 //! Structure for additional translation options.
 struct XscOptions
 {
@@ -63,6 +76,9 @@ struct XscOptions
     //! If true, the source code is only validated, but no output code will be generated. By default false.
     bool validateOnly;
 
+    //! If true, only diagnostics are reported: the parser recovers from syntax errors, the context analysis runs on erroneous code, and no output code is generated. By default false.
+    bool diagnosticsMode;
+
     //! If true, the shader output may contain GLSL extensions, if the target shader version is too low. By default false.
     bool allowExtensions;
 
@@ -84,11 +100,53 @@ struct XscOptions
     //! If true, code obfuscation is performed. By default false.
     bool obfuscate;
 
+    //! If true, uniform-only expressions are extracted into a synthesized constant buffer and reported as preshaders in the reflection data. By default false.
+    bool extractPreshaders;
+
+    //! Minimal number of elements of a static constant array to be moved into a synthesized constant buffer, whose data is reported in the reflection data. Smaller constant arrays are written with array constructors. Zero disables this conversion. By default 0.
+    unsigned int constantTableThreshold;
+
+    //! Whitelist of fast-math substitutions, which trade precision for fewer ALU instructions. This can be a bitwise OR combination of the entries of the XscFastMathFlags enumeration. Each substitution is reported as info. By default 0.
+    unsigned int fastMath;
+
+    //! Size (in bytes) of the push constant block for VKSL output. Constant buffers that fit into this budget (e.g. small per-draw buffers) are merged into a single 'push_constant' block, and the choice is reported in the reflection data. Vulkan guarantees at least 128 bytes. Zero disables this conversion. Ignored for GLSL and ESSL. By default 0.
+    unsigned int pushConstantBudget;
+
+    //! Size limit (in bytes) of uniform buffers for VKSL output. Read-only structured buffers with uniform indices, whose elements have the same layout in "std140" and "std430", are declared as uniform buffers with as many elements as fit into this limit (instead of storage buffers), and the choice is reported in the reflection data. Vulkan guarantees at least 16384 bytes. Zero disables this conversion. Ignored for GLSL and ESSL. By default 0.
+    unsigned int uniformStorageBufferSize;
+
+    //! If true, compatible shader input/output variables (varyings) are packed into 4-component slots, which are declared with explicit locations if the output version supports them (see XscShaderOutput::packedInputLayout). By default false.
+    bool packVaryings;
+
+    //! If true, a position-only variant of a vertex or tessellation-evaluation shader is generated, whose only output is the position system value (e.g. for depth-only passes). By default false.
+    bool positionOnly;
+
+    //! If true, vertex shader outputs that are not derived from per-vertex inputs are declared with 'flat' interpolation, and reported in the reflection data (see ShaderOutput::flatInputSemantics for the fragment shader side). By default false.
+    bool flatVaryings;
+
+    //! If true, isomorphic scalar operations on the components of the same vector are merged into vector operations (e.g. "v.x = a.x * s; v.y = a.y * s;" -> "v.xy = a.xy * s;"). Each merge is reported as info. By default false.
+    bool vectorize;
+
+    //! If true, local arrays and structures whose elements are only accessed with constant indices are replaced by individual scalar or vector temporaries (scalar replacement of aggregates). Each replacement is reported as info. By default false.
+    bool scalarReplacement;
+
+    //! If true, side effect free loop invariant expressions are hoisted out of loops into temporaries, and multiplications of integral induction variables are reduced to additions. Each transformation is reported as info. By default false.
+    bool optimizeLoops;
+
+    //! If true, the output code is instrumented with execution counters for each function, branch, and loop body, which are incremented atomically in a synthesized storage buffer (or atomic counters for GLSL 4.20). The counters are mapped to their source locations in the reflection data. By default false.
+    bool profileCounters;
+
+    //! If true, the global declarations of the HLSL input are parsed in parallel chunks, if the input is large enough. Falls back to serial parsing when a chunk depends on its context (the resulting AST and reports are always the same). Ignored in diagnostics mode. By default false.
+    bool parallelParsing;
+
     //! If true, the AST (Abstract Syntax Tree) will be written to the log output. By default false.
     bool showAST;
 
     //! If true, the timings of the different compilation processes are written to the log output. By default false.
     bool showTimes;
+
+    //! If true, the peak memory during the different compilation processes (where supported), and the resident memory after each process (with its change during that process) are written to the log output. By default false.
+    bool showMemory;
 };
 
 //! Name mangling descriptor structure for shader input/output variables (also referred to as "varyings"), temporary variables, and reserved keywords.
@@ -148,6 +206,9 @@ struct XscShaderInput
 
     //! Include handler member which contains a function pointer to handle '#include'-directives.
     struct XscIncludeHandler        includeHandler;
+
+    //! Task scheduler member which contains the function pointers to execute the internal parallelism of the compiler. By default all NULL.
+    struct XscTaskScheduler         taskScheduler;
 };
 
 //! Vertex shader semantic (or rather attribute) layout structure.
@@ -160,6 +221,16 @@ struct XscVertexSemantic
     int         location;
 };
 
+//! Measured execution count of a code region for profile-guided optimization.
+struct XscProfileCount
+{
+    //! Source location of the code region in the format "Filename:Row:Column" (e.g. "Example.hlsl:12:5").
+    const char*         location;
+
+    //! Number of executions of the code region.
+    unsigned long long  count;
+};
+
 //! Shader output descriptor structure.
 struct XscShaderOutput
 {
@@ -178,6 +249,24 @@ struct XscShaderOutput
     //! Number of elements the 'vertexSemantics' member points to. By default 0.
     size_t                          vertexSemanticsCount;
 
+    //! Optional list of fragment shader input semantics (e.g. "COLOR0"), which are declared with 'flat' interpolation. By default NULL.
+    const char**                    flatInputSemantics;
+
+    //! Number of elements the 'flatInputSemantics' member points to. By default 0.
+    size_t                          flatInputSemanticsCount;
+
+    //! Optional packing map of the previous shader stage, to pack the input varyings into the same slots (see 'packVaryings'). By default NULL.
+    const struct XscPackedVarying*  packedInputLayout;
+
+    //! Number of elements the 'packedInputLayout' member points to. By default 0.
+    size_t                          packedInputLayoutCount;
+
+    //! Optional list of execution counts for profile-guided optimization. By default NULL.
+    const struct XscProfileCount*   profileCounts;
+
+    //! Number of elements the 'profileCounts' member points to. By default 0.
+    size_t                          profileCountsCount;
+
     //! Additional options to configure the code generation.
     struct XscOptions               options;
 
@@ -107,7 +107,7 @@ void Program::RegisterIntrinsicUsage(const Intrinsic intrinsic, const std::vecto
     usedIntrinsics[intrinsic].argLists.insert(argList);
 }
 
-void Program::RegisterIntrinsicUsage(const Intrinsic intrinsic, const std::vector<ExprPtr>& arguments)
+void Program::RegisterIntrinsicUsage(const Intrinsic intrinsic, const ExprList& arguments)
 {
     /* Insert argument types (only base types) into usage list */
     IntrinsicUsage::ArgumentList argList;
@@ -579,7 +579,7 @@ bool TypeSpecifier::IsOutput() const
 
 bool TypeSpecifier::IsConst() const
 {
-    return (typeModifiers.find(TypeModifier::Const) != typeModifiers.end());
+    return (typeModifiers.count(TypeModifier::Const) != 0);
 }
 
 bool TypeSpecifier::IsConstOrUniform() const
@@ -603,7 +603,7 @@ bool TypeSpecifier::HasAnyTypeModifierOf(const std::vector<TypeModifier>& modifi
 {
     for (auto mod : modifiers)
     {
-        if (typeModifiers.find(mod) != typeModifiers.end())
+        if (typeModifiers.count(mod) != 0)
             return true;
     }
     return false;
@@ -613,7 +613,7 @@ bool TypeSpecifier::HasAnyStorageClassesOf(const std::vector<StorageClass>& modi
 {
     for (auto mod : modifiers)
     {
-        if (storageClasses.find(mod) != storageClasses.end())
+        if (storageClasses.count(mod) != 0)
             return true;
     }
     return false;
@@ -720,13 +720,16 @@ VarDecl* StructDecl::Fetch(const std::string& ident, const StructDecl** owner) c
     return nullptr;
 }
 
-FunctionDecl* StructDecl::FetchFunctionDecl(const std::string& ident, const std::vector<TypeDenoterPtr>& argTypeDenoters, const StructDecl** owner) const
+FunctionDecl* StructDecl::FetchFunctionDecl(
+    const std::string& ident, const std::vector<TypeDenoterPtr>& argTypeDenoters, const StructDecl** owner, std::string* errorMsg) const
 {
     /* Fetch symbol from base struct first */
     if (baseStructRef)
     {
-        if (auto symbol = baseStructRef->FetchFunctionDecl(ident, argTypeDenoters, owner))
+        if (auto symbol = baseStructRef->FetchFunctionDecl(ident, argTypeDenoters, owner, errorMsg))
             return symbol;
+        if (errorMsg && !errorMsg->empty())
+            return nullptr;
     }
 
     /* Now fetch symbol from members */
@@ -745,7 +748,7 @@ FunctionDecl* StructDecl::FetchFunctionDecl(const std::string& ident, const std:
     if (owner)
         *owner = this;
 
-    return FunctionDecl::FetchFunctionDeclFromList(funcDeclList, ident, argTypeDenoters, false);
+    return FunctionDecl::FetchFunctionDeclFromList(funcDeclList, ident, argTypeDenoters, false, errorMsg);
 }
 
 std::string StructDecl::FetchSimilar(const std::string& ident)
@@ -1101,14 +1104,23 @@ static void ListAllFuncCandidates(const std::vector<FunctionDecl*>& candidates)
         ReportHandler::HintForNextReport("  '" + funcDecl->ToString(false) + "' (" + funcDecl->area.Pos().ToString() + ")");
 };
 
+// Throws the specified error message, or writes it to 'errorMsg' if it is not null.
+static FunctionDecl* FailFetchFunctionDecl(const std::string& msg, std::string* errorMsg)
+{
+    if (!errorMsg)
+        RuntimeErr(msg);
+    *errorMsg = msg;
+    return nullptr;
+}
+
 FunctionDecl* FunctionDecl::FetchFunctionDeclFromList(
     const std::vector<FunctionDecl*>& funcDeclList, const std::string& ident,
-    const std::vector<TypeDenoterPtr>& argTypeDenoters, bool throwErrorIfNoMatch)
+    const std::vector<TypeDenoterPtr>& argTypeDenoters, bool throwErrorIfNoMatch, std::string* errorMsg)
 {
     if (funcDeclList.empty())
     {
         if (throwErrorIfNoMatch)
-            RuntimeErr(R_UndefinedSymbol(ident));
+            return FailFetchFunctionDecl(R_UndefinedSymbol(ident), errorMsg);
         else
             return nullptr;
     }
@@ -1123,11 +1135,11 @@ FunctionDecl* FunctionDecl::FetchFunctionDeclFromList(
             /* Add candidate signatures to report hints */
             ListAllFuncCandidates(funcDeclList);
 
-            /* Throw runtime error */
+            /* Throw or return error */
             if (numArgs == 1)
-                RuntimeErr(R_FuncDoesntTake1Param(ident, numArgs));
+                return FailFetchFunctionDecl(R_FuncDoesntTake1Param(ident, numArgs), errorMsg);
             else
-                RuntimeErr(R_FuncDoesntTakeNParams(ident, numArgs));
+                return FailFetchFunctionDecl(R_FuncDoesntTakeNParams(ident, numArgs), errorMsg);
         }
         else
             return nullptr;
@@ -1179,8 +1191,8 @@ FunctionDecl* FunctionDecl::FetchFunctionDeclFromList(
         else
             ListAllFuncCandidates(funcDeclCandidates);
 
-        /* Throw runtime error */
-        RuntimeErr(R_AmbiguousFuncCall(ident, argTypeNames));
+        /* Throw or return error */
+        return FailFetchFunctionDecl(R_AmbiguousFuncCall(ident, argTypeNames), errorMsg);
     }
 
     return funcDeclCandidates.front();
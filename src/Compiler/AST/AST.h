@@ -13,6 +13,7 @@
 #include "Token.h"
 #include "Visitor.h"
 #include "Flags.h"
+#include "EnumSet.h"
 #include "ASTEnums.h"
 #include "SourceCode.h"
 #include "TypeDenoter.h"
@@ -286,7 +287,7 @@ struct Program : public AST
     void RegisterIntrinsicUsage(const Intrinsic intrinsic, const std::vector<DataType>& argumentDataTypes);
 
     // Registers a usage of an intrinsic with the specified arguments (only base types).
-    void RegisterIntrinsicUsage(const Intrinsic intrinsic, const std::vector<ExprPtr>& arguments);
+    void RegisterIntrinsicUsage(const Intrinsic intrinsic, const ExprList& arguments);
 
     // Returns a usage-container of the specified intrinsic or null if the specified intrinsic was not registered to be used.
     const IntrinsicUsage* FetchIntrinsicUsage(const Intrinsic intrinsic) const;
@@ -353,7 +354,7 @@ struct FunctionCall : public TypedAST
 
     VarIdentPtr             varIdent;                                   // Null, if the function call is a type constructor (e.g. "float2(0, 0)").
     TypeDenoterPtr          typeDenoter;                                // Null, if the function call is NOT a type constructor (e.g. "float2(0, 0)").
-    std::vector<ExprPtr>    arguments;
+    ExprList                arguments;
 
     FunctionDecl*           funcDeclRef         = nullptr;              // Reference to the function declaration; may be null
     Intrinsic               intrinsic           = Intrinsic::Undefined; // Intrinsic ID (if this is an intrinsic).
@@ -467,9 +468,9 @@ struct TypeSpecifier : public TypedAST
     bool                        isOutput        = false;                    // Input modifier 'out'
     bool                        isUniform       = false;                    // Input modifier 'uniform'
     
-    std::set<StorageClass>      storageClasses;                             // Storage classes, e.g. extern, precise, etc.
-    std::set<InterpModifier>    interpModifiers;                            // Interpolation modifiers, e.g. nointerpolation, linear, centroid etc.
-    std::set<TypeModifier>      typeModifiers;                              // Type modifiers, e.g. const, row_major, column_major (also 'snorm' and 'unorm' for floats)
+    EnumSet<StorageClass>       storageClasses;                             // Storage classes, e.g. extern, precise, etc.
+    EnumSet<InterpModifier>     interpModifiers;                            // Interpolation modifiers, e.g. nointerpolation, linear, centroid etc.
+    EnumSet<TypeModifier>       typeModifiers;                              // Type modifiers, e.g. const, row_major, column_major (also 'snorm' and 'unorm' for floats)
     PrimitiveType               primitiveType   = PrimitiveType::Undefined; // Primitive type for geometry entry pointer parameters
     StructDeclPtr               structDecl;                                 // Optional structure declaration
 
@@ -529,7 +530,7 @@ struct VarIdent : public TypedAST
     FunctionDecl* FetchFunctionDecl() const;
 
     std::string             ident;                      // Atomic identifier.
-    std::vector<ExprPtr>    arrayIndices;               // Optional array indices
+    ExprList                arrayIndices;               // Optional array indices
     bool                    nextIsStatic    = false;    // Specifies whether the next node is concatenated with the static double-colon token '::'.
     VarIdentPtr             next;                       // Next identifier; may be null.
 
@@ -631,8 +632,14 @@ struct StructDecl : public Decl
     // Returns the VarDecl AST node inside this struct decl for the specified identifier, or null if there is no such VarDecl.
     VarDecl* Fetch(const std::string& ident, const StructDecl** owner = nullptr) const;
 
-    // Returns the FunctionDecl AST node for the specified argument type denoter list (used to derive the overloaded function).
-    FunctionDecl* FetchFunctionDecl(const std::string& ident, const std::vector<TypeDenoterPtr>& argTypeDenoters, const StructDecl** owner = nullptr) const;
+    /*
+    Returns the FunctionDecl AST node for the specified argument type denoter list (used to derive the overloaded function).
+    If 'errorMsg' is not null, the error message of an ambiguous function call is written to it instead of throwing an exception.
+    */
+    FunctionDecl* FetchFunctionDecl(
+        const std::string& ident, const std::vector<TypeDenoterPtr>& argTypeDenoters,
+        const StructDecl** owner = nullptr, std::string* errorMsg = nullptr
+    ) const;
 
     // Returns an identifier that is similar to the specified identifier (for suggestions of typos)
     std::string FetchSimilar(const std::string& ident);
@@ -750,11 +757,14 @@ struct FunctionDecl : public Stmnt
     // Returns true if the specified type denoter matches the parameter.
     bool MatchParameterWithTypeDenoter(std::size_t paramIndex, const TypeDenoter& argType, bool implicitConversion) const;
 
-    // Fetches the function declaration from the list that matches the specified argument types.
+    /*
+    Fetches the function declaration from the list that matches the specified argument types.
+    If 'errorMsg' is not null, the error message is written to it and null is returned instead of throwing an exception.
+    */
     static FunctionDecl* FetchFunctionDeclFromList(
         const std::vector<FunctionDecl*>& funcDeclList,
         const std::string& ident, const std::vector<TypeDenoterPtr>& argTypeDenoters,
-        bool throwErrorIfNoMatch = true
+        bool throwErrorIfNoMatch = true, std::string* errorMsg = nullptr
     );
 
     TypeSpecifierPtr                returnType;
@@ -1125,7 +1135,7 @@ struct ArrayAccessExpr : public Expr
 
     //TODO: rename this "prefixExpr" to make the post-order traversal clear
     ExprPtr                 expr;           // Sub expression (left hand side)
-    std::vector<ExprPtr>    arrayIndices;   // Array indices (right hand side)
+    ExprList                arrayIndices;   // Array indices (right hand side)
 };
 
 // Cast expression.
@@ -327,6 +327,9 @@ enum class StorageClass
     Volatile,
 };
 
+// The last entry must be updated when new entries are added (used as bit index of "EnumSet<StorageClass>").
+static_assert(static_cast<int>(StorageClass::Volatile) < 32, "entries of StorageClass exceed the bit mask of EnumSet");
+
 
 /* ----- InterpModifier Enum ----- */
 
@@ -342,6 +345,9 @@ enum class InterpModifier
     Sample,
 };
 
+// The last entry must be updated when new entries are added (used as bit index of "EnumSet<InterpModifier>").
+static_assert(static_cast<int>(InterpModifier::Sample) < 32, "entries of InterpModifier exceed the bit mask of EnumSet");
+
 
 /* ----- StorageClass Enum ----- */
 
@@ -358,6 +364,9 @@ enum class TypeModifier
     UNorm,
 };
 
+// The last entry must be updated when new entries are added (used as bit index of "EnumSet<TypeModifier>").
+static_assert(static_cast<int>(TypeModifier::UNorm) < 32, "entries of TypeModifier exceed the bit mask of EnumSet");
+
 
 /* ----- UniformBufferType Enum ----- */
 
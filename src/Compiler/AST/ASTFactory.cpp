@@ -33,7 +33,7 @@ std::shared_ptr<T> MakeASTWithOrigin(Origin origin, Args&&... args)
 /* ----- Make functions ----- */
 
 FunctionCallExprPtr MakeIntrinsicCallExpr(
-    const Intrinsic intrinsic, const std::string& ident, const TypeDenoterPtr& typeDenoter, const std::vector<ExprPtr>& arguments)
+    const Intrinsic intrinsic, const std::string& ident, const TypeDenoterPtr& typeDenoter, const ExprList& arguments)
 {
     auto ast = MakeAST<FunctionCallExpr>();
     {
@@ -50,6 +50,20 @@ FunctionCallExprPtr MakeIntrinsicCallExpr(
     return ast;
 }
 
+FunctionCallExprPtr MakeTypeCtorCallExpr(const TypeDenoterPtr& typeDenoter, const std::vector<ExprPtr>& arguments)
+{
+    auto ast = MakeAST<FunctionCallExpr>();
+    {
+        auto funcCall = MakeAST<FunctionCall>();
+        {
+            funcCall->typeDenoter   = typeDenoter;
+            funcCall->arguments.assign(arguments.begin(), arguments.end());
+        }
+        ast->call = funcCall;
+    }
+    return ast;
+}
+
 static SamplerType TextureTypeToSamplerType(const BufferType t)
 {
     switch (t)
@@ -135,6 +149,16 @@ BinaryExprPtr MakeBinaryExpr(const ExprPtr& lhsExpr, const BinaryOp op, const Ex
     return ast;
 }
 
+UnaryExprPtr MakeUnaryExpr(const UnaryOp op, const ExprPtr& expr)
+{
+    auto ast = MakeASTWithOrigin<UnaryExpr>(expr);
+    {
+        ast->op     = op;
+        ast->expr   = expr;
+    }
+    return ast;
+}
+
 LiteralExprPtr MakeLiteralExpr(const DataType literalType, const std::string& literalValue)
 {
     auto ast = MakeAST<LiteralExpr>();
@@ -145,20 +169,88 @@ LiteralExprPtr MakeLiteralExpr(const DataType literalType, const std::string& li
     return ast;
 }
 
-LiteralExprPtr MakeLiteralExpr(const Variant& literalValue)
+LiteralExprPtr MakeLiteralExpr(const Variant& literalValue, bool doublePrecision)
 {
     switch (literalValue.Type())
     {
         case Variant::Types::Bool:
-            return MakeLiteralExpr(DataType::Bool, std::to_string(literalValue.Bool()));
+            return MakeLiteralExpr(DataType::Bool, literalValue.ToString());
         case Variant::Types::Int:
-            return MakeLiteralExpr(DataType::Int, std::to_string(literalValue.Int()));
+            return MakeLiteralExpr(DataType::Int, literalValue.ToString());
         case Variant::Types::Real:
-            return MakeLiteralExpr(DataType::Float, std::to_string(literalValue.Real()));
+            if (doublePrecision)
+                return MakeLiteralExpr(DataType::Double, literalValue.ToString() + "L");
+            else
+                return MakeLiteralExpr(DataType::Float, literalValue.ToString());
     }
     return MakeLiteralExpr(DataType::Int, "0");
 }
 
+static DataType VariantBaseDataType(const Variant& value, bool doublePrecision)
+{
+    switch (value.Type())
+    {
+        case Variant::Types::Bool:
+            return DataType::Bool;
+        case Variant::Types::Int:
+            return DataType::Int;
+        case Variant::Types::Real:
+            return (doublePrecision ? DataType::Double : DataType::Float);
+    }
+    return DataType::Undefined;
+}
+
+static bool HasEqualComponents(const Variant& value)
+{
+    for (std::size_t i = 1; i < value.NumComponents(); ++i)
+    {
+        if (value.Component(i).CompareWith(value.Component(0)) != 0)
+            return false;
+    }
+    return true;
+}
+
+ExprPtr MakeVariantExpr(const Variant& value, const DataType dataType, bool doublePrecision)
+{
+    if (!value.IsCompound())
+        return MakeLiteralExpr(value, doublePrecision);
+
+    /* Derive data type from variant if the specified type does not match */
+    auto ctorDataType = dataType;
+
+    if (value.Shape() == Variant::Shapes::Vector)
+    {
+        if (!IsVectorType(dataType) || VectorTypeDim(dataType) != value.Rows())
+            ctorDataType = VectorDataType(VariantBaseDataType(value, doublePrecision), value.Rows());
+    }
+    else
+    {
+        if (!IsMatrixType(dataType) || MatrixTypeDim(dataType) != std::make_pair(value.Rows(), value.Columns()))
+            ctorDataType = MatrixDataType(VariantBaseDataType(value, doublePrecision), value.Rows(), value.Columns());
+    }
+
+    auto typeDenoter = std::make_shared<BaseTypeDenoter>(ctorDataType);
+
+    /*
+    Make cast expression for vectors with equal components and zero matrices (e.g. "(float3)0.5").
+    Matrices with other equal components are excluded, since a scalar matrix constructor in GLSL only sets the diagonal.
+    */
+    if (HasEqualComponents(value))
+    {
+        const auto& component = value.Component(0);
+        if (value.Shape() == Variant::Shapes::Vector || component.CompareWith(Variant::IntType(0)) == 0)
+            return MakeCastExpr(typeDenoter, MakeLiteralExpr(component, doublePrecision));
+    }
+
+    /* Make type constructor with a literal for each component */
+    std::vector<ExprPtr> arguments;
+
+    for (std::size_t i = 0; i < value.NumComponents(); ++i)
+        arguments.push_back(MakeLiteralExpr(value.Component(i), doublePrecision));
+
+    return MakeTypeCtorCallExpr(typeDenoter, arguments);
+}
+
 AliasDeclStmntPtr MakeBaseTypeAlias(const DataType dataType, const std::string& ident)
 {
     auto ast = MakeAST<AliasDeclStmnt>();
@@ -283,6 +375,16 @@ VarAccessExprPtr MakeVarAccessExpr(const std::string& ident, AST* symbolRef)
     return MakeVarAccessExpr(MakeVarIdent(ident, symbolRef));
 }
 
+ListExprPtr MakeListExpr(const ExprPtr& firstExpr, const ExprPtr& nextExpr)
+{
+    auto ast = MakeASTWithOrigin<ListExpr>(firstExpr);
+    {
+        ast->firstExpr  = firstExpr;
+        ast->nextExpr   = nextExpr;
+    }
+    return ast;
+}
+
 BracketExprPtr MakeBracketExpr(const ExprPtr& expr)
 {
     auto ast = MakeASTWithOrigin<BracketExpr>(expr);
@@ -355,6 +457,40 @@ ExprPtr MakeConstructorListExpr(const LiteralExprPtr& literalExpr, const std::ve
 
 #endif
 
+ExprStmntPtr MakeVarAssignStmnt(VarDecl* varDecl, const ExprPtr& assignExpr)
+{
+    auto ast = MakeAST<ExprStmnt>();
+    {
+        auto expr = MakeAST<VarAccessExpr>();
+        {
+            expr->varIdent      = MakeVarIdent(varDecl->ident, varDecl);
+            expr->assignOp      = AssignOp::Set;
+            expr->assignExpr    = assignExpr;
+        }
+        ast->expr = expr;
+    }
+    return ast;
+}
+
+ExprStmntPtr MakeExprStmnt(const ExprPtr& expr)
+{
+    auto ast = MakeASTWithOrigin<ExprStmnt>(expr);
+    {
+        ast->expr = expr;
+    }
+    return ast;
+}
+
+CodeBlockStmntPtr MakeCodeBlockStmnt(const std::vector<StmntPtr>& stmnts)
+{
+    auto ast = MakeAST<CodeBlockStmnt>();
+    {
+        ast->codeBlock          = MakeAST<CodeBlock>();
+        ast->codeBlock->stmnts  = stmnts;
+    }
+    return ast;
+}
+
 ExprStmntPtr MakeArrayAssignStmnt(VarDecl* varDecl, const std::vector<int>& arrayIndices, const ExprPtr& assignExpr)
 {
     auto ast = MakeAST<ExprStmnt>();
@@ -391,9 +527,9 @@ ArrayDimensionPtr MakeArrayDimension(int arraySize)
 
 /* ----- Make list functions ----- */
 
-std::vector<ExprPtr> MakeArrayIndices(const std::vector<int>& arrayIndices)
+ExprList MakeArrayIndices(const std::vector<int>& arrayIndices)
 {
-    std::vector<ExprPtr> exprs;
+    ExprList exprs;
 
     for (auto index : arrayIndices)
         exprs.push_back(MakeLiteralExpr(DataType::Int, std::to_string(index)));
@@ -450,7 +586,7 @@ ArrayDimensionPtr ConvertExprToArrayDimension(const ExprPtr& expr)
     return ast;
 }
 
-std::vector<ArrayDimensionPtr> ConvertExprListToArrayDimensionList(const std::vector<ExprPtr>& exprs)
+std::vector<ArrayDimensionPtr> ConvertExprListToArrayDimensionList(const ExprList& exprs)
 {
     std::vector<ArrayDimensionPtr> arrayDims;
 
@@ -26,9 +26,12 @@ namespace ASTFactory
 
 FunctionCallExprPtr             MakeIntrinsicCallExpr(
     const Intrinsic intrinsic, const std::string& ident,
-    const TypeDenoterPtr& typeDenoter, const std::vector<ExprPtr>& arguments
+    const TypeDenoterPtr& typeDenoter, const ExprList& arguments
 );
 
+// Makes a new type constructor call expression (e.g. "float3(1, 2, 3)").
+FunctionCallExprPtr             MakeTypeCtorCallExpr(const TypeDenoterPtr& typeDenoter, const std::vector<ExprPtr>& arguments);
+
 FunctionCallExprPtr             MakeTextureSamplerBindingCallExpr(const ExprPtr& textureObjectExpr, const ExprPtr& samplerObjectExpr);
 
 CastExprPtr                     MakeCastExpr(const TypeDenoterPtr& typeDenoter, const ExprPtr& valueExpr);
@@ -40,8 +43,19 @@ ExprPtr                         MakeCastOrSuffixCastExpr(const TypeDenoterPtr& t
 
 BinaryExprPtr                   MakeBinaryExpr(const ExprPtr& lhsExpr, const BinaryOp op, const ExprPtr& rhsExpr);
 
+// Makes a new unary expression (e.g. "!a") with the specified operator and sub expression (source area is copied).
+UnaryExprPtr                    MakeUnaryExpr(const UnaryOp op, const ExprPtr& expr);
+
 LiteralExprPtr                  MakeLiteralExpr(const DataType literalType, const std::string& literalValue);
-LiteralExprPtr                  MakeLiteralExpr(const Variant& literalValue);
+// Makes a new literal expression from the specified variant. Real values with double precision get the 'L' suffix.
+LiteralExprPtr                  MakeLiteralExpr(const Variant& literalValue, bool doublePrecision = false);
+
+/*
+Makes a literal expression for scalar values, or a type constructor with literal arguments for vector and matrix values (e.g. "float3(1.0, 2.0, 3.0)").
+Vectors with equal components and zero matrices are made as cast expression (e.g. "(float3)0.0").
+The data type is only used for vector and matrix values; if it does not match the dimensions of the value, it is derived from the value.
+*/
+ExprPtr                         MakeVariantExpr(const Variant& value, const DataType dataType = DataType::Undefined, bool doublePrecision = false);
 
 AliasDeclStmntPtr               MakeBaseTypeAlias(const DataType dataType, const std::string& ident);
 
@@ -66,12 +80,24 @@ VarIdentPtr                     MakeVarIdentPushFront(const std::string& firstId
 VarAccessExprPtr                MakeVarAccessExpr(const VarIdentPtr& varIdent);
 VarAccessExprPtr                MakeVarAccessExpr(const std::string& ident, AST* symbolRef = nullptr);
 
+// Makes a new list expression (e.g. "a, b") with the specified sub expressions (source area is copied from the first expression).
+ListExprPtr                     MakeListExpr(const ExprPtr& firstExpr, const ExprPtr& nextExpr);
+
 // Makes a new bracket expression with the specified sub expression (source area is copied).
 BracketExprPtr                  MakeBracketExpr(const ExprPtr& expr);
 
 // Return a list expression (or only the input expression) for the specified literal expression, so it can be used as constructor for a struct.
 ExprPtr                         MakeConstructorListExpr(const LiteralExprPtr& literalExpr, const std::vector<TypeDenoterPtr>& listTypeDens);
 
+// Makes a statement with an assignment of the specified value expression to the specified variable.
+ExprStmntPtr                    MakeVarAssignStmnt(VarDecl* varDecl, const ExprPtr& assignExpr);
+
+// Makes a new expression statement with the specified expression (source area is copied).
+ExprStmntPtr                    MakeExprStmnt(const ExprPtr& expr);
+
+// Makes a new code block statement (e.g. "{ ... }") with the specified statements.
+CodeBlockStmntPtr               MakeCodeBlockStmnt(const std::vector<StmntPtr>& stmnts);
+
 // Makes an statement with an array element assignment for the specified variable identifier, array indices, and value expression.
 ExprStmntPtr                    MakeArrayAssignStmnt(VarDecl* varDecl, const std::vector<int>& arrayIndices, const ExprPtr& assignExpr);
 
@@ -79,7 +105,7 @@ ArrayDimensionPtr               MakeArrayDimension(int arraySize);
 
 /* ----- Make list functions ----- */
 
-std::vector<ExprPtr>            MakeArrayIndices(const std::vector<int>& arrayIndices);
+ExprList                        MakeArrayIndices(const std::vector<int>& arrayIndices);
 
 std::vector<ArrayDimensionPtr>  MakeArrayDimensionList(const std::vector<int>& arraySizes);
 
@@ -89,7 +115,7 @@ ExprPtr                         ConvertExprBaseType(const DataType dataType, con
 
 ArrayDimensionPtr               ConvertExprToArrayDimension(const ExprPtr& expr);
 
-std::vector<ArrayDimensionPtr>  ConvertExprListToArrayDimensionList(const std::vector<ExprPtr>& exprs);
+std::vector<ArrayDimensionPtr>  ConvertExprListToArrayDimensionList(const ExprList& exprs);
 
 
 } // /namespace ASTFactory
@@ -0,0 +1,61 @@
+/*
+ * CallGraphCollector.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CallGraphCollector.h"
+#include "AST.h"
+
+
+namespace Xsc
+{
+
+
+void CallGraphCollector::CollectReachableFunctions(FunctionDecl* funcDecl)
+{
+    if (!funcDecl)
+        return;
+
+    /* Don't use forward declarations */
+    if (funcDecl->funcImplRef)
+        funcDecl = funcDecl->funcImplRef;
+
+    if (!funcDecl->codeBlock || !visitedFuncs_.insert(funcDecl).second)
+        return;
+
+    /* Append function before its callees, then collect all functions that are called from this function */
+    funcDecls_.push_back(funcDecl);
+    Visit(funcDecl->codeBlock);
+}
+
+bool CallGraphCollector::IsReachable(const FunctionDecl* funcDecl) const
+{
+    return (visitedFuncs_.find(funcDecl) != visitedFuncs_.end());
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+/* ------- Visit functions ------- */
+
+#define IMPLEMENT_VISIT_PROC(AST_NAME) \
+    void CallGraphCollector::Visit##AST_NAME(AST_NAME* ast, void* args)
+
+IMPLEMENT_VISIT_PROC(FunctionCall)
+{
+    VISIT_DEFAULT(FunctionCall);
+    CollectReachableFunctions(ast->funcDeclRef);
+}
+
+#undef IMPLEMENT_VISIT_PROC
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
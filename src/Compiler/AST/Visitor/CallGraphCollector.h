@@ -0,0 +1,65 @@
+/*
+ * CallGraphCollector.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_CALL_GRAPH_COLLECTOR_H
+#define XSC_CALL_GRAPH_COLLECTOR_H
+
+
+#include "Visitor.h"
+#include <vector>
+#include <set>
+
+
+namespace Xsc
+{
+
+
+/*
+Call graph collector.
+This helper class collects all functions that are reachable from a set of root functions (e.g. the entry points).
+The functions are listed in the order they are reached, so the result does not depend on memory addresses.
+Forward declarations are replaced by their implementation, and functions without a body are ignored.
+*/
+class CallGraphCollector : private Visitor
+{
+    
+    public:
+        
+        // Adds the specified function and all functions that are called from it (directly or indirectly).
+        void CollectReachableFunctions(FunctionDecl* funcDecl);
+
+        // Returns the list of all reachable functions in the order they were reached.
+        inline const std::vector<FunctionDecl*>& GetReachableFunctions() const
+        {
+            return funcDecls_;
+        }
+
+        // Returns true if the specified function has been reached.
+        bool IsReachable(const FunctionDecl* funcDecl) const;
+
+    private:
+        
+        /* ----- Visitor implementation ----- */
+
+        DECL_VISIT_PROC( FunctionCall );
+
+        /* ----- Members ----- */
+
+        std::vector<FunctionDecl*>      funcDecls_;
+        std::set<const FunctionDecl*>   visitedFuncs_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -11,6 +11,9 @@
 #include "Exception.h"
 #include "ReportIdents.h"
 #include <sstream>
+#include <cmath>
+#include <algorithm>
+#include <limits>
 
 
 namespace Xsc
@@ -21,7 +24,7 @@ Variant ConstExprEvaluator::EvaluateExpr(Expr& ast, const OnVarAccessCallback& o
 {
     onVarAccessCallback_ = (onVarAccessCallback ? onVarAccessCallback : [](VarAccessExpr* ast) { return Variant(Variant::IntType(0)); });
     Visit(&ast);
-    return Pop();
+    return Pop(doublePrecision_);
 }
 
 
@@ -35,18 +38,502 @@ static void IllegalExpr(const std::string& exprName, const AST* ast = nullptr)
     RuntimeErr(R_IllegalExprInConstExpr(exprName), ast);
 }
 
-void ConstExprEvaluator::Push(const Variant& v)
+static bool IsFinite(const Variant& v)
 {
-    variantStack_.push(v);
+    if (v.Type() == Variant::Types::Real)
+    {
+        for (std::size_t i = 0; i < v.NumComponents(); ++i)
+        {
+            if (!std::isfinite(v.Component(i).Real()))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Rounds all real components to single precision (out of range values are rounded to infinity).
+static Variant RoundToSinglePrecision(const Variant& v)
+{
+    if (v.Type() != Variant::Types::Real)
+        return v;
+
+    if (v.IsCompound())
+    {
+        std::vector<Variant> components;
+        for (std::size_t i = 0; i < v.NumComponents(); ++i)
+            components.push_back(RoundToSinglePrecision(v.Component(i)));
+        return v.WithComponents(components);
+    }
+
+    const auto x = v.Real();
+    if (std::isfinite(x) && std::abs(x) <= static_cast<Variant::RealType>(std::numeric_limits<float>::max()))
+        return Variant(static_cast<Variant::RealType>(static_cast<float>(x)));
+    else
+        return Variant(std::numeric_limits<Variant::RealType>::infinity());
+}
+
+void ConstExprEvaluator::Push(const Variant& v, bool doublePrecision)
+{
+    /* Round result of each operation on 'float' and 'half' operands, as the GPU does */
+    auto value = (doublePrecision ? v : RoundToSinglePrecision(v));
+
+    /* Infinity and NaN can not be represented as literals, so they must not be folded */
+    if (!IsFinite(value))
+        IllegalExpr(R_NonFiniteValue);
+
+    variantStack_.push({ value, doublePrecision });
 }
 
 Variant ConstExprEvaluator::Pop()
+{
+    bool doublePrecision = false;
+    return Pop(doublePrecision);
+}
+
+Variant ConstExprEvaluator::Pop(bool& doublePrecision)
 {
     if (variantStack_.empty())
         throw std::runtime_error(R_StackUnderflow(R_ExprEvaluator));
-    auto v = variantStack_.top();
+    auto entry = variantStack_.top();
     variantStack_.pop();
-    return v;
+    doublePrecision = entry.doublePrecision;
+    return entry.value;
+}
+
+static Variant::RealType RealValue(Variant v)
+{
+    return v.ToReal();
+}
+
+static void PromoteTypes(Variant& lhs, Variant& rhs)
+{
+    if (lhs.Type() == Variant::Types::Real || rhs.Type() == Variant::Types::Real)
+    {
+        lhs.ToReal();
+        rhs.ToReal();
+    }
+    else if (lhs.Type() == Variant::Types::Int || rhs.Type() == Variant::Types::Int)
+    {
+        lhs.ToInt();
+        rhs.ToInt();
+    }
+}
+
+static bool HasIntZeroComponent(const Variant& v)
+{
+    for (std::size_t i = 0; i < v.NumComponents(); ++i)
+    {
+        if (v.Component(i).Type() == Variant::Types::Int && v.Component(i).Int() == 0)
+            return true;
+    }
+    return false;
+}
+
+static bool IsIntDivisionByZero(const Variant& lhs, const Variant& rhs)
+{
+    return (lhs.Type() != Variant::Types::Real && rhs.Type() != Variant::Types::Real && HasIntZeroComponent(rhs));
+}
+
+using ComponentFunctor = std::function<Variant(const std::vector<Variant>& args)>;
+
+/*
+Applies the specified function to each component of the arguments.
+Scalar arguments are broadcast, and vector arguments are truncated to the smallest dimension.
+*/
+static Variant ApplyComponentWise(const std::vector<Variant>& args, const ComponentFunctor& func, const AST* ast)
+{
+    const Variant* shape = nullptr;
+
+    for (const auto& arg : args)
+    {
+        if (arg.IsCompound())
+        {
+            if (!shape || (arg.Shape() == Variant::Shapes::Vector && arg.Rows() < shape->Rows()))
+                shape = &arg;
+            if (arg.Shape() != shape->Shape() || arg.Columns() != shape->Columns())
+                IllegalExpr(R_MismatchedDimensions, ast);
+        }
+    }
+
+    if (!shape)
+        return func(args);
+
+    std::vector<Variant> components, componentArgs(args.size());
+
+    for (std::size_t i = 0; i < shape->NumComponents(); ++i)
+    {
+        for (std::size_t j = 0; j < args.size(); ++j)
+            componentArgs[j] = args[j].Component(i);
+        components.push_back(func(componentArgs));
+    }
+
+    return shape->WithComponents(components);
+}
+
+static Variant ApplyRealFunc1(const std::vector<Variant>& args, Variant::RealType (*func)(Variant::RealType), const AST* ast)
+{
+    return ApplyComponentWise(
+        args,
+        [func](const std::vector<Variant>& c) -> Variant
+        {
+            return func(RealValue(c[0]));
+        },
+        ast
+    );
+}
+
+static Variant ApplyRealFunc2(const std::vector<Variant>& args, Variant::RealType (*func)(Variant::RealType, Variant::RealType), const AST* ast)
+{
+    return ApplyComponentWise(
+        args,
+        [func](const std::vector<Variant>& c) -> Variant
+        {
+            return func(RealValue(c[0]), RealValue(c[1]));
+        },
+        ast
+    );
+}
+
+static Variant Dot(const Variant& lhs, const Variant& rhs)
+{
+    auto result = lhs.Component(0) * rhs.Component(0);
+    for (std::size_t i = 1, n = std::min(lhs.NumComponents(), rhs.NumComponents()); i < n; ++i)
+        result += lhs.Component(i) * rhs.Component(i);
+    return result;
+}
+
+static Variant Length(const Variant& v)
+{
+    return Variant(std::sqrt(RealValue(Dot(v, v))));
+}
+
+// Matrix multiplication (vectors are interpreted as row vector on the left hand side, and column vector on the right hand side).
+static Variant Mul(const Variant& lhs, const Variant& rhs, const AST* ast)
+{
+    if (!lhs.IsCompound() || !rhs.IsCompound())
+        return lhs * rhs;
+
+    if (lhs.Shape() == Variant::Shapes::Vector && rhs.Shape() == Variant::Shapes::Vector)
+        return Dot(lhs, rhs);
+
+    const bool  lhsIsVector = (lhs.Shape() == Variant::Shapes::Vector);
+    const bool  rhsIsVector = (rhs.Shape() == Variant::Shapes::Vector);
+
+    const int   lhsRows     = (lhsIsVector ? 1 : lhs.Rows());
+    const int   lhsCols     = (lhsIsVector ? lhs.Rows() : lhs.Columns());
+    const int   rhsRows     = rhs.Rows();
+    const int   rhsCols     = (rhsIsVector ? 1 : rhs.Columns());
+
+    if (lhsCols != rhsRows)
+        IllegalExpr(R_MismatchedDimensions, ast);
+
+    std::vector<Variant> components;
+
+    for (int row = 0; row < lhsRows; ++row)
+    {
+        for (int col = 0; col < rhsCols; ++col)
+        {
+            auto result = lhs.Component(row * lhsCols) * rhs.Component(col);
+            for (int i = 1; i < lhsCols; ++i)
+                result += lhs.Component(row * lhsCols + i) * rhs.Component(i * rhsCols + col);
+            components.push_back(result);
+        }
+    }
+
+    if (lhsIsVector || rhsIsVector)
+        return Variant::MakeVector(components);
+    else
+        return Variant::MakeMatrix(components, lhsRows, rhsCols);
+}
+
+static Variant::RealType Frac(Variant::RealType x)
+{
+    return x - std::floor(x);
+}
+
+static Variant::RealType Rcp(Variant::RealType x)
+{
+    return 1.0 / x;
+}
+
+static Variant::RealType RSqrt(Variant::RealType x)
+{
+    return 1.0 / std::sqrt(x);
+}
+
+static Variant::RealType Saturate(Variant::RealType x)
+{
+    return std::max(0.0, std::min(x, 1.0));
+}
+
+static Variant::RealType Degrees(Variant::RealType x)
+{
+    return x * (180.0 / 3.14159265358979323846);
+}
+
+static Variant::RealType Radians(Variant::RealType x)
+{
+    return x * (3.14159265358979323846 / 180.0);
+}
+
+static Variant::RealType Step(Variant::RealType y, Variant::RealType x)
+{
+    return (x >= y ? 1.0 : 0.0);
+}
+
+// Wrappers for overloaded <cmath> functions
+static Variant::RealType Sqrt (Variant::RealType x) { return std::sqrt (x); }
+static Variant::RealType Sin  (Variant::RealType x) { return std::sin  (x); }
+static Variant::RealType Cos  (Variant::RealType x) { return std::cos  (x); }
+static Variant::RealType Tan  (Variant::RealType x) { return std::tan  (x); }
+static Variant::RealType ASin (Variant::RealType x) { return std::asin (x); }
+static Variant::RealType ACos (Variant::RealType x) { return std::acos (x); }
+static Variant::RealType ATan (Variant::RealType x) { return std::atan (x); }
+static Variant::RealType SinH (Variant::RealType x) { return std::sinh (x); }
+static Variant::RealType CosH (Variant::RealType x) { return std::cosh (x); }
+static Variant::RealType TanH (Variant::RealType x) { return std::tanh (x); }
+static Variant::RealType Exp  (Variant::RealType x) { return std::exp  (x); }
+static Variant::RealType Exp2 (Variant::RealType x) { return std::exp2 (x); }
+static Variant::RealType Log  (Variant::RealType x) { return std::log  (x); }
+static Variant::RealType Log2 (Variant::RealType x) { return std::log2 (x); }
+static Variant::RealType Log10(Variant::RealType x) { return std::log10(x); }
+static Variant::RealType Floor(Variant::RealType x) { return std::floor(x); }
+static Variant::RealType Ceil (Variant::RealType x) { return std::ceil (x); }
+static Variant::RealType Round(Variant::RealType x) { return std::nearbyint(x); }
+static Variant::RealType Trunc(Variant::RealType x) { return std::trunc(x); }
+
+static Variant::RealType ATan2(Variant::RealType y, Variant::RealType x) { return std::atan2(y, x); }
+static Variant::RealType Pow  (Variant::RealType x, Variant::RealType y) { return std::pow  (x, y); }
+static Variant::RealType FMod (Variant::RealType x, Variant::RealType y) { return std::fmod (x, y); }
+
+Variant ConstExprEvaluator::EvaluateTypeConstructor(const DataType dataType, const std::vector<Variant>& args, const AST* ast)
+{
+    /* Flatten all argument components (e.g. "float4(float2(1, 2), 3, 4)") */
+    std::vector<Variant> components;
+
+    for (const auto& arg : args)
+    {
+        for (std::size_t i = 0; i < arg.NumComponents(); ++i)
+            components.push_back(arg.Component(i));
+    }
+
+    const auto dim              = MatrixTypeDim(dataType);
+    const auto numComponents    = static_cast<std::size_t>(dim.first * dim.second);
+
+    /* Broadcast single scalar argument (e.g. "float3(0)") */
+    if (components.size() == 1 && numComponents > 1)
+        components.resize(numComponents, components.front());
+
+    if (components.size() != numComponents)
+        IllegalExpr(R_MismatchedDimensions, ast);
+
+    Variant result;
+
+    if (IsScalarType(dataType))
+        result = components.front();
+    else if (IsVectorType(dataType))
+        result = Variant::MakeVector(components);
+    else if (IsMatrixType(dataType))
+        result = Variant::MakeMatrix(components, dim.first, dim.second);
+    else
+        IllegalExpr(R_TypeCast(DataTypeToString(dataType)), ast);
+
+    /* Convert all components to the base type */
+    if (IsBooleanType(dataType))
+        result.ToBool();
+    else if (IsIntegralType(dataType))
+        result.ToInt();
+    else
+        result.ToReal();
+
+    return result;
+}
+
+Variant ConstExprEvaluator::EvaluateIntrinsic(const Intrinsic intrinsic, const std::vector<Variant>& args, const AST* ast)
+{
+    auto RequireArgs = [&](std::size_t numArgs)
+    {
+        if (args.size() != numArgs)
+            IllegalExpr(R_InvalidArgCount, ast);
+    };
+
+    switch (intrinsic)
+    {
+        /* --- Unary component-wise intrinsics --- */
+
+        case Intrinsic::Abs:
+            RequireArgs(1);
+            return ApplyComponentWise(
+                args,
+                [](const std::vector<Variant>& c) -> Variant
+                {
+                    auto x = c[0];
+                    return (x.CompareWith(Variant::IntType(0)) < 0 ? -x : x);
+                },
+                ast
+            );
+
+        case Intrinsic::Sign:
+            RequireArgs(1);
+            return ApplyComponentWise(
+                args,
+                [](const std::vector<Variant>& c) -> Variant
+                {
+                    return Variant::IntType(c[0].CompareWith(Variant::IntType(0)));
+                },
+                ast
+            );
+
+        case Intrinsic::Sqrt:       RequireArgs(1); return ApplyRealFunc1(args, Sqrt,      ast);
+        case Intrinsic::RSqrt:      RequireArgs(1); return ApplyRealFunc1(args, RSqrt,     ast);
+        case Intrinsic::Rcp:        RequireArgs(1); return ApplyRealFunc1(args, Rcp,       ast);
+        case Intrinsic::Sin:        RequireArgs(1); return ApplyRealFunc1(args, Sin,       ast);
+        case Intrinsic::Cos:        RequireArgs(1); return ApplyRealFunc1(args, Cos,       ast);
+        case Intrinsic::Tan:        RequireArgs(1); return ApplyRealFunc1(args, Tan,       ast);
+        case Intrinsic::ASin:       RequireArgs(1); return ApplyRealFunc1(args, ASin,      ast);
+        case Intrinsic::ACos:       RequireArgs(1); return ApplyRealFunc1(args, ACos,      ast);
+        case Intrinsic::ATan:       RequireArgs(1); return ApplyRealFunc1(args, ATan,      ast);
+        case Intrinsic::SinH:       RequireArgs(1); return ApplyRealFunc1(args, SinH,      ast);
+        case Intrinsic::CosH:       RequireArgs(1); return ApplyRealFunc1(args, CosH,      ast);
+        case Intrinsic::TanH:       RequireArgs(1); return ApplyRealFunc1(args, TanH,      ast);
+        case Intrinsic::Exp:        RequireArgs(1); return ApplyRealFunc1(args, Exp,       ast);
+        case Intrinsic::Exp2:       RequireArgs(1); return ApplyRealFunc1(args, Exp2,      ast);
+        case Intrinsic::Log:        RequireArgs(1); return ApplyRealFunc1(args, Log,       ast);
+        case Intrinsic::Log2:       RequireArgs(1); return ApplyRealFunc1(args, Log2,      ast);
+        case Intrinsic::Log10:      RequireArgs(1); return ApplyRealFunc1(args, Log10,     ast);
+        case Intrinsic::Floor:      RequireArgs(1); return ApplyRealFunc1(args, Floor,     ast);
+        case Intrinsic::Ceil:       RequireArgs(1); return ApplyRealFunc1(args, Ceil,      ast);
+        case Intrinsic::Round:      RequireArgs(1); return ApplyRealFunc1(args, Round,     ast);
+        case Intrinsic::Trunc:      RequireArgs(1); return ApplyRealFunc1(args, Trunc,     ast);
+        case Intrinsic::Frac:       RequireArgs(1); return ApplyRealFunc1(args, Frac,      ast);
+        case Intrinsic::Saturate:   RequireArgs(1); return ApplyRealFunc1(args, Saturate,  ast);
+        case Intrinsic::Degrees:    RequireArgs(1); return ApplyRealFunc1(args, Degrees,   ast);
+        case Intrinsic::Radians:    RequireArgs(1); return ApplyRealFunc1(args, Radians,   ast);
+
+        /* --- Binary component-wise intrinsics --- */
+
+        case Intrinsic::ATan2:      RequireArgs(2); return ApplyRealFunc2(args, ATan2,     ast);
+        case Intrinsic::Pow:        RequireArgs(2); return ApplyRealFunc2(args, Pow,       ast);
+        case Intrinsic::FMod:       RequireArgs(2); return ApplyRealFunc2(args, FMod,      ast);
+        case Intrinsic::Step:       RequireArgs(2); return ApplyRealFunc2(args, Step,      ast);
+
+        case Intrinsic::Min:
+            RequireArgs(2);
+            return ApplyComponentWise(
+                args,
+                [](const std::vector<Variant>& c) -> Variant
+                {
+                    auto x = c[0], y = c[1];
+                    PromoteTypes(x, y);
+                    return (y.CompareWith(x) < 0 ? y : x);
+                },
+                ast
+            );
+
+        case Intrinsic::Max:
+            RequireArgs(2);
+            return ApplyComponentWise(
+                args,
+                [](const std::vector<Variant>& c) -> Variant
+                {
+                    auto x = c[0], y = c[1];
+                    PromoteTypes(x, y);
+                    return (x.CompareWith(y) < 0 ? y : x);
+                },
+                ast
+            );
+
+        /* --- Ternary component-wise intrinsics --- */
+
+        case Intrinsic::Clamp:
+            RequireArgs(3);
+            return EvaluateIntrinsic(
+                Intrinsic::Min,
+                { EvaluateIntrinsic(Intrinsic::Max, { args[0], args[1] }, ast), args[2] },
+                ast
+            );
+
+        case Intrinsic::Lerp:
+            RequireArgs(3);
+            return ApplyComponentWise(
+                args,
+                [](const std::vector<Variant>& c) -> Variant
+                {
+                    auto x = RealValue(c[0]), y = RealValue(c[1]), s = RealValue(c[2]);
+                    return x + s*(y - x);
+                },
+                ast
+            );
+
+        case Intrinsic::MAD:
+            RequireArgs(3);
+            return ApplyComponentWise(
+                args,
+                [](const std::vector<Variant>& c) -> Variant
+                {
+                    return c[0] * c[1] + c[2];
+                },
+                ast
+            );
+
+        case Intrinsic::SmoothStep:
+            RequireArgs(3);
+            return ApplyComponentWise(
+                args,
+                [](const std::vector<Variant>& c) -> Variant
+                {
+                    auto edge0 = RealValue(c[0]), edge1 = RealValue(c[1]), x = RealValue(c[2]);
+                    auto t = Saturate((x - edge0) / (edge1 - edge0));
+                    return t*t*(3.0 - 2.0*t);
+                },
+                ast
+            );
+
+        /* --- Vector intrinsics --- */
+
+        case Intrinsic::Dot:
+            RequireArgs(2);
+            return Dot(args[0], args[1]);
+
+        case Intrinsic::Length:
+            RequireArgs(1);
+            return Length(args[0]);
+
+        case Intrinsic::Distance:
+            RequireArgs(2);
+            return Length(args[0] - args[1]);
+
+        case Intrinsic::Normalize:
+        {
+            RequireArgs(1);
+            auto v = args[0];
+            v.ToReal();
+            return v / Length(v);
+        }
+
+        case Intrinsic::Cross:
+        {
+            RequireArgs(2);
+            const auto& a = args[0];
+            const auto& b = args[1];
+            if (a.NumComponents() != 3 || b.NumComponents() != 3)
+                IllegalExpr(R_MismatchedDimensions, ast);
+            return Variant::MakeVector(
+                {
+                    a.Component(1)*b.Component(2) - a.Component(2)*b.Component(1),
+                    a.Component(2)*b.Component(0) - a.Component(0)*b.Component(2),
+                    a.Component(0)*b.Component(1) - a.Component(1)*b.Component(0),
+                }
+            );
+        }
+
+        case Intrinsic::Mul:
+            RequireArgs(2);
+            return Mul(args[0], args[1], ast);
+
+        default:
+            IllegalExpr(R_Intrinsic, ast);
+    }
 }
 
 /* --- Expressions --- */
@@ -95,12 +582,19 @@ IMPLEMENT_VISIT_PROC(LiteralExpr)
 
         case DataType::Half:
         case DataType::Float:
-        case DataType::Double:
         {
             Push(FromString<Variant::RealType>(ast->value));
         }
         break;
 
+        case DataType::Double:
+        {
+            /* Only literals with 'l' or 'L' suffix have double precision, unsuffixed literals are evaluated like 'float' */
+            const auto& s = ast->value;
+            Push(FromString<Variant::RealType>(s), (!s.empty() && (s.back() == 'l' || s.back() == 'L')));
+        }
+        break;
+
         default:
         {
             IllegalExpr(R_LiteralType(DataTypeToString(ast->dataType)), ast);
@@ -131,8 +625,13 @@ IMPLEMENT_VISIT_PROC(BinaryExpr)
     Visit(ast->lhsExpr);
     Visit(ast->rhsExpr);
 
-    auto rhs = Pop();
-    auto lhs = Pop();
+    bool rhsDouble = false, lhsDouble = false;
+
+    auto rhs = Pop(rhsDouble);
+    auto lhs = Pop(lhsDouble);
+
+    /* Operation has double precision if any operand has double precision */
+    const bool dbl = (lhsDouble || rhsDouble);
 
     switch (ast->op)
     {
@@ -140,62 +639,62 @@ IMPLEMENT_VISIT_PROC(BinaryExpr)
             IllegalExpr(R_BinaryOp, ast);
             break;
         case BinaryOp::LogicalAnd:
-            Push(lhs.ToBool() && rhs.ToBool());
+            Push(lhs.ToBool() && rhs.ToBool(), dbl);
             break;
         case BinaryOp::LogicalOr:
-            Push(lhs.ToBool() || rhs.ToBool());
+            Push(lhs.ToBool() || rhs.ToBool(), dbl);
             break;
         case BinaryOp::Or:
-            Push(lhs | rhs);
+            Push(lhs | rhs, dbl);
             break;
         case BinaryOp::Xor:
-            Push(lhs ^ rhs);
+            Push(lhs ^ rhs, dbl);
             break;
         case BinaryOp::And:
-            Push(lhs & rhs);
+            Push(lhs & rhs, dbl);
             break;
         case BinaryOp::LShift:
-            Push(lhs << rhs);
+            Push(lhs << rhs, dbl);
             break;
         case BinaryOp::RShift:
-            Push(lhs >> rhs);
+            Push(lhs >> rhs, dbl);
             break;
         case BinaryOp::Add:
-            Push(lhs + rhs);
+            Push(lhs + rhs, dbl);
             break;
         case BinaryOp::Sub:
-            Push(lhs - rhs);
+            Push(lhs - rhs, dbl);
             break;
         case BinaryOp::Mul:
-            Push(lhs * rhs);
+            Push(lhs * rhs, dbl);
             break;
         case BinaryOp::Div:
-            if (lhs.Type() == Variant::Types::Int && rhs.Int() == 0)
+            if (IsIntDivisionByZero(lhs, rhs))
                 IllegalExpr(R_DivisionByZero, ast);
-            Push(lhs / rhs);
+            Push(lhs / rhs, dbl);
             break;
         case BinaryOp::Mod:
-            if (lhs.Type() == Variant::Types::Int && rhs.Int() == 0)
+            if (IsIntDivisionByZero(lhs, rhs))
                 IllegalExpr(R_DivisionByZero, ast);
-            Push(lhs % rhs);
+            Push(lhs % rhs, dbl);
             break;
         case BinaryOp::Equal:
-            Push(lhs == rhs);
+            Push(lhs == rhs, dbl);
             break;
         case BinaryOp::NotEqual:
-            Push(lhs != rhs);
+            Push(lhs != rhs, dbl);
             break;
         case BinaryOp::Less:
-            Push(lhs < rhs);
+            Push(lhs < rhs, dbl);
             break;
         case BinaryOp::Greater:
-            Push(lhs > rhs);
+            Push(lhs > rhs, dbl);
             break;
         case BinaryOp::LessEqual:
-            Push(lhs <= rhs);
+            Push(lhs <= rhs, dbl);
             break;
         case BinaryOp::GreaterEqual:
-            Push(lhs >= rhs);
+            Push(lhs >= rhs, dbl);
             break;
     }
 }
@@ -205,7 +704,8 @@ IMPLEMENT_VISIT_PROC(UnaryExpr)
 {
     Visit(ast->expr);
 
-    auto rhs = Pop();
+    bool dbl = false;
+    auto rhs = Pop(dbl);
 
     switch (ast->op)
     {
@@ -213,22 +713,22 @@ IMPLEMENT_VISIT_PROC(UnaryExpr)
             IllegalExpr(R_UnaryOp, ast);
             break;
         case UnaryOp::LogicalNot:
-            Push(!rhs.ToBool());
+            Push(!rhs.ToBool(), dbl);
             break;
         case UnaryOp::Not:
-            Push(~rhs);
+            Push(~rhs, dbl);
             break;
         case UnaryOp::Nop:
-            Push(rhs);
+            Push(rhs, dbl);
             break;
         case UnaryOp::Negate:
-            Push(-rhs);
+            Push(-rhs, dbl);
             break;
         case UnaryOp::Inc:
-            Push(++rhs);
+            Push(++rhs, dbl);
             break;
         case UnaryOp::Dec:
-            Push(--rhs);
+            Push(--rhs, dbl);
             break;
     }
 }
@@ -238,14 +738,15 @@ IMPLEMENT_VISIT_PROC(PostUnaryExpr)
 {
     Visit(ast->expr);
 
-    auto lhs = Pop();
+    bool dbl = false;
+    auto lhs = Pop(dbl);
 
     switch (ast->op)
     {
         case UnaryOp::Inc:
         case UnaryOp::Dec:
             /* Only return original value (post inc/dec will return the value BEFORE the operation) */
-            Push(lhs);
+            Push(lhs, dbl);
             break;
         default:
             IllegalExpr(R_UnaryOp(UnaryOpToString(ast->op)), ast);
@@ -255,7 +756,37 @@ IMPLEMENT_VISIT_PROC(PostUnaryExpr)
 
 IMPLEMENT_VISIT_PROC(FunctionCallExpr)
 {
-    IllegalExpr("function call", ast);
+    auto funcCall = ast->call.get();
+
+    /* Only type constructors and pure intrinsics can be evaluated */
+    const BaseTypeDenoter* ctorTypeDen = nullptr;
+
+    if (funcCall->typeDenoter)
+    {
+        ctorTypeDen = funcCall->typeDenoter->Get()->As<BaseTypeDenoter>();
+        if (!ctorTypeDen)
+            IllegalExpr(R_TypeCast(funcCall->typeDenoter->ToString()), ast);
+    }
+    else if (funcCall->intrinsic == Intrinsic::Undefined)
+        IllegalExpr("function call", ast);
+
+    /* Evaluate arguments */
+    std::vector<Variant> argValues;
+    bool argsDouble = false;
+
+    for (auto arg : funcCall->GetArguments())
+    {
+        bool argDouble = false;
+        Visit(arg);
+        argValues.push_back(Pop(argDouble));
+        argsDouble = (argsDouble || argDouble);
+    }
+
+    /* Type constructors have the precision of their type, and intrinsics the precision of their arguments */
+    if (ctorTypeDen)
+        Push(EvaluateTypeConstructor(ctorTypeDen->dataType, argValues, ast), IsDoubleRealType(ctorTypeDen->dataType));
+    else
+        Push(EvaluateIntrinsic(funcCall->intrinsic, argValues, ast), argsDouble);
 }
 
 IMPLEMENT_VISIT_PROC(BracketExpr)
@@ -265,14 +796,60 @@ IMPLEMENT_VISIT_PROC(BracketExpr)
 
 IMPLEMENT_VISIT_PROC(SuffixExpr)
 {
-    //TODO: incomplete!
     Visit(ast->expr);
+
+    bool dbl = false;
+    auto value = Pop(dbl);
+
+    /* Only vector and matrix swizzles can be evaluated (e.g. "float3(1, 2, 3).zyx.x") */
+    for (auto varIdent = ast->varIdent.get(); varIdent != nullptr; varIdent = varIdent->next.get())
+    {
+        if (!varIdent->arrayIndices.empty() || varIdent->symbolRef)
+            IllegalExpr(R_IllegalExprInConstExpr(varIdent->ToString()), ast);
+
+        try
+        {
+            value = value.Swizzle(varIdent->ident);
+        }
+        catch (const std::invalid_argument& e)
+        {
+            RuntimeErr(e.what(), ast);
+        }
+    }
+
+    Push(value, dbl);
 }
 
 IMPLEMENT_VISIT_PROC(ArrayAccessExpr)
 {
-    //TODO: incomplete!
     Visit(ast->expr);
+
+    bool dbl = false;
+    auto value = Pop(dbl);
+
+    /* Only vector components and matrix rows can be accessed with constant indices (e.g. "float3(1, 2, 3)[1]") */
+    for (auto& indexExpr : ast->arrayIndices)
+    {
+        Visit(indexExpr);
+
+        auto index = Pop().ToInt();
+
+        if (!value.IsCompound() || index < 0 || index >= value.Rows())
+            IllegalExpr(R_ArrayAccess, ast);
+
+        if (value.Shape() == Variant::Shapes::Matrix)
+        {
+            /* Select matrix row */
+            std::vector<Variant> components;
+            for (int col = 0; col < value.Columns(); ++col)
+                components.push_back(value.Component(static_cast<std::size_t>(index * value.Columns() + col)));
+            value = Variant::MakeVector(components);
+        }
+        else
+            value = Variant(value.Component(static_cast<std::size_t>(index)));
+    }
+
+    Push(value, dbl);
 }
 
 IMPLEMENT_VISIT_PROC(CastExpr)
@@ -283,6 +860,23 @@ IMPLEMENT_VISIT_PROC(CastExpr)
 
     if (auto baseTypeDen = ast->typeSpecifier->GetTypeDenoter()->As<BaseTypeDenoter>())
     {
+        if (!baseTypeDen->IsScalar())
+        {
+            /* Cast to vector or matrix type (scalars are broadcast, and vectors are truncated) */
+            const auto dim              = MatrixTypeDim(baseTypeDen->dataType);
+            const auto numComponents    = static_cast<std::size_t>(dim.first * dim.second);
+
+            std::vector<Variant> components;
+            for (std::size_t i = 0; i < value.NumComponents() && i < numComponents; ++i)
+                components.push_back(value.Component(i));
+
+            if (value.IsCompound() && components.size() < numComponents)
+                IllegalExpr(R_TypeCast(DataTypeToString(baseTypeDen->dataType)), ast);
+
+            Push(EvaluateTypeConstructor(baseTypeDen->dataType, components, ast), IsDoubleRealType(baseTypeDen->dataType));
+            return;
+        }
+
         switch (baseTypeDen->dataType)
         {
             case DataType::Bool:
@@ -300,12 +894,17 @@ IMPLEMENT_VISIT_PROC(CastExpr)
 
             case DataType::Half:
             case DataType::Float:
-            case DataType::Double:
             {
                 Push(value.ToReal());
             }
             break;
 
+            case DataType::Double:
+            {
+                Push(value.ToReal(), true);
+            }
+            break;
+
             default:
             {
                 IllegalExpr(R_TypeCast(DataTypeToString(baseTypeDen->dataType)), ast);
@@ -319,7 +918,19 @@ IMPLEMENT_VISIT_PROC(CastExpr)
 
 IMPLEMENT_VISIT_PROC(VarAccessExpr)
 {
-    Push(onVarAccessCallback_(ast));
+    /* Values of 'double' variables keep double precision */
+    bool dbl = false;
+
+    if (auto varDecl = ast->varIdent->FetchVarDecl())
+    {
+        if (auto declStmnt = varDecl->declStmntRef)
+        {
+            if (auto baseTypeDen = declStmnt->typeSpecifier->GetTypeDenoter()->Get()->As<BaseTypeDenoter>())
+                dbl = IsDoubleRealType(baseTypeDen->dataType);
+        }
+    }
+
+    Push(onVarAccessCallback_(ast), dbl);
 }
 
 IMPLEMENT_VISIT_PROC(InitializerExpr)
@@ -11,6 +11,7 @@
 
 #include "Visitor.h"
 #include "Variant.h"
+#include "ASTEnums.h"
 #include <stack>
 #include <functional>
 
@@ -33,12 +34,27 @@ class ConstExprEvaluator : private Visitor
         */
         Variant EvaluateExpr(Expr& ast, const OnVarAccessCallback& onVarAccessCallback = nullptr);
 
+        // Returns true if the last evaluated expression has double precision, i.e. its real components were not rounded to single precision.
+        inline bool HasDoublePrecision() const
+        {
+            return doublePrecision_;
+        }
+
     private:
         
         /* === Functions === */
 
-        void Push(const Variant& v);
+        // Pushes the specified value. Real components are rounded to single precision, unless the value has double precision.
+        void Push(const Variant& v, bool doublePrecision = false);
+
         Variant Pop();
+        Variant Pop(bool& doublePrecision);
+
+        // Evaluates the type constructor (e.g. "float3(1, 2, 3)") of the specified data type.
+        Variant EvaluateTypeConstructor(const DataType dataType, const std::vector<Variant>& args, const AST* ast);
+
+        // Evaluates the specified intrinsic. Only pure intrinsics (e.g. "dot" or "normalize") are supported.
+        Variant EvaluateIntrinsic(const Intrinsic intrinsic, const std::vector<Variant>& args, const AST* ast);
 
         /* --- Visitor implementation --- */
 
@@ -60,7 +76,15 @@ class ConstExprEvaluator : private Visitor
 
         /* === Members === */
 
-        std::stack<Variant> variantStack_;
+        // Evaluated value with its floating-point precision (single precision for 'float' and 'half', and double precision for 'double').
+        struct StackEntry
+        {
+            Variant value;
+            bool    doublePrecision;
+        };
+
+        std::stack<StackEntry> variantStack_;
+        bool                   doublePrecision_ = false;
 
         OnVarAccessCallback onVarAccessCallback_;
 
@@ -0,0 +1,348 @@
+/*
+ * ConstantTableExtractor.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ConstantTableExtractor.h"
+#include "CallGraphCollector.h"
+#include "ConstExprEvaluator.h"
+#include "AST.h"
+#include "Helper.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+
+namespace Xsc
+{
+
+
+std::size_t ConstantTableExtractor::ExtractConstantTables(
+    Program& program, unsigned int threshold, const NameMangling& nameMangling, Reflection::ReflectionData* reflectionData)
+{
+    threshold_      = std::max(1u, threshold);
+    nameMangling_   = nameMangling;
+    reflectionData_ = reflectionData;
+
+    /* Collect all functions and variables that are reachable from the entry points */
+    CallGraphCollector callGraph;
+    callGraph.CollectReachableFunctions(program.entryPointRef);
+    callGraph.CollectReachableFunctions(program.layoutTessControl.patchConstFunctionRef);
+    reachableFuncs_ = callGraph.GetReachableFunctions();
+    CollectReachableVars();
+
+    /* Move global constant arrays into the constant table buffer */
+    for (auto it = program.globalStmnts.begin(); it != program.globalStmnts.end();)
+    {
+        if (ExtractConstantTable(*it, false))
+            it = program.globalStmnts.erase(it);
+        else
+            ++it;
+    }
+
+    /* Move local constant arrays of all reachable functions into the constant table buffer */
+    for (auto funcDecl : reachableFuncs_)
+        Visit(funcDecl->codeBlock);
+
+    /* Insert synthesized constant buffer into the program */
+    if (constantTableBuffer_)
+        InsertConstantTableBuffer(program);
+
+    return memberIdents_.size();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void ConstantTableExtractor::CollectReachableVars()
+{
+    struct VarCollector : public Visitor
+    {
+        std::set<VarDecl*>* varDecls;
+
+        void Collect(CodeBlock* codeBlock)
+        {
+            Visit(codeBlock);
+        }
+
+        void VisitVarIdent(VarIdent* ast, void* args) override
+        {
+            if (auto varDecl = ast->FetchVarDecl())
+                varDecls->insert(varDecl);
+            Visitor::VisitVarIdent(ast, args);
+        }
+    };
+
+    VarCollector collector;
+    collector.varDecls = &reachableVars_;
+
+    for (auto funcDecl : reachableFuncs_)
+        collector.Collect(funcDecl->codeBlock.get());
+}
+
+// Returns true if the specified data type can be stored in a constant table (doubles have a different "std140" layout).
+static bool IsConstantTableDataType(const DataType dataType)
+{
+    if (IsDoubleRealType(dataType))
+        return false;
+    if (IsMatrixType(dataType))
+        return IsRealType(dataType);
+    return (IsScalarType(dataType) || IsVectorType(dataType));
+}
+
+bool ConstantTableExtractor::ExtractConstantTable(const StmntPtr& stmnt, bool isLocal)
+{
+    /* Only consider static constant declarations of a single variable */
+    auto varDeclStmnt = stmnt->As<VarDeclStmnt>();
+    if (!varDeclStmnt || varDeclStmnt->varDecls.size() != 1)
+        return false;
+
+    auto varDecl = varDeclStmnt->varDecls.front().get();
+    if (!isLocal && reachableVars_.find(varDecl) == reachableVars_.end())
+        return false;
+
+    auto& typeSpecifier = varDeclStmnt->typeSpecifier;
+    if (!typeSpecifier->IsConst() || !typeSpecifier->HasAnyStorageClassesOf({ StorageClass::Static }))
+        return false;
+
+    auto baseTypeDen = typeSpecifier->GetTypeDenoter()->Get()->As<BaseTypeDenoter>();
+    if (!baseTypeDen || !IsConstantTableDataType(baseTypeDen->dataType))
+        return false;
+
+    /* Only consider one-dimensional arrays with at least 'threshold' elements */
+    auto arrayTypeDen = varDecl->GetTypeDenoter()->Get()->As<ArrayTypeDenoter>();
+    if (!arrayTypeDen)
+        return false;
+
+    auto dimSizes = arrayTypeDen->GetDimensionSizes();
+    if (dimSizes.size() != 1 || dimSizes.front() <= 0 || static_cast<unsigned int>(dimSizes.front()) < threshold_)
+        return false;
+
+    /* Evaluate all array elements */
+    auto initExpr = (varDecl->initializer ? varDecl->initializer->As<InitializerExpr>() : nullptr);
+    if (!initExpr || initExpr->exprs.size() != static_cast<std::size_t>(dimSizes.front()))
+        return false;
+
+    const auto dim = MatrixTypeDim(baseTypeDen->dataType);
+
+    std::vector<Variant> components;
+    if (!EvaluateElements(*initExpr, dim.first * dim.second, components))
+        return false;
+
+    /* Make synthesized constant buffer */
+    if (!constantTableBuffer_)
+    {
+        constantTableBuffer_ = MakeShared<UniformBufferDecl>(SourcePosition::ignore);
+        constantTableBuffer_->bufferType    = UniformBufferType::ConstantBuffer;
+        constantTableBuffer_->ident         = nameMangling_.temporaryPrefix + "ConstantTables";
+        constantTableBuffer_->flags << AST::isReachable;
+    }
+
+    /* Rename local variables, since they are moved into the global scope */
+    if (isLocal)
+    {
+        auto ident = nameMangling_.temporaryPrefix + varDecl->ident.Original();
+        for (int i = 1; memberIdents_.find(ident) != memberIdents_.end(); ++i)
+            ident = nameMangling_.temporaryPrefix + varDecl->ident.Original() + std::to_string(i);
+        varDecl->ident = ident;
+    }
+
+    memberIdents_.insert(varDecl->ident);
+
+    /* Append initial values to the constant table data */
+    const auto offset   = static_cast<unsigned int>(data_.size());
+    const auto rowMajor = typeSpecifier->HasAnyTypeModifierOf({ TypeModifier::RowMajor });
+    const auto stride   = EncodeElements(components, baseTypeDen->dataType, rowMajor);
+
+    if (reflectionData_)
+    {
+        Reflection::ConstantTable table;
+        {
+            table.ident     = varDecl->ident;
+            table.type      = DataTypeToString(baseTypeDen->dataType);
+            table.size      = static_cast<unsigned int>(dimSizes.front());
+            table.offset    = offset;
+            table.stride    = stride;
+        }
+        reflectionData_->constantTables.push_back(table);
+    }
+
+    /* Convert static constant into constant buffer member */
+    typeSpecifier->storageClasses.erase(StorageClass::Static);
+    typeSpecifier->typeModifiers.erase(TypeModifier::Const);
+
+    varDecl->initializer.reset();
+    varDecl->bufferDeclRef = constantTableBuffer_.get();
+
+    varDeclStmnt->flags << AST::isReachable;
+    varDecl->flags << AST::isReachable;
+
+    auto varDeclStmntPtr = std::static_pointer_cast<VarDeclStmnt>(stmnt);
+    constantTableBuffer_->localStmnts.push_back(varDeclStmntPtr);
+    constantTableBuffer_->varMembers.push_back(varDeclStmntPtr);
+
+    return true;
+}
+
+bool ConstantTableExtractor::EvaluateElements(const InitializerExpr& initExpr, int numComponents, std::vector<Variant>& components)
+{
+    ConstExprEvaluator exprEvaluator;
+
+    auto AppendComponents = [&](Expr& expr)
+    {
+        auto value = exprEvaluator.EvaluateExpr(expr, [](VarAccessExpr* ast) -> Variant { throw ast; });
+        for (std::size_t i = 0; i < value.NumComponents(); ++i)
+            components.push_back(value.Component(i));
+    };
+
+    try
+    {
+        for (const auto& expr : initExpr.exprs)
+        {
+            const auto numPrevComponents = components.size();
+
+            /* Flatten nested initializers of vectors and matrices (e.g. "{ { 1, 0 }, { 0, 1 } }") */
+            if (auto subInitExpr = expr->As<InitializerExpr>())
+            {
+                for (const auto& subExpr : subInitExpr->exprs)
+                    AppendComponents(*subExpr);
+            }
+            else
+                AppendComponents(*expr);
+
+            if (components.size() - numPrevComponents != static_cast<std::size_t>(numComponents))
+                return false;
+        }
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+    catch (const VarAccessExpr*)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+unsigned int ConstantTableExtractor::EncodeElements(const std::vector<Variant>& components, const DataType dataType, bool rowMajor)
+{
+    /*
+    Each array element occupies whole vec4 slots in the "std140" layout.
+    Matrices are stored as one slot per vector: the rows of an HLSL matrix are the columns of the respective GLSL matrix.
+    */
+    const auto dim          = MatrixTypeDim(dataType);
+    const auto isMatrix     = IsMatrixType(dataType);
+    const auto numVectors   = (isMatrix ? (rowMajor ? dim.second : dim.first) : 1);
+    const auto vectorSize   = (isMatrix ? (rowMajor ? dim.first : dim.second) : dim.first);
+    const auto stride       = static_cast<unsigned int>(numVectors * 16);
+    const auto baseType     = BaseDataType(dataType);
+
+    for (std::size_t first = 0; first < components.size(); first += static_cast<std::size_t>(dim.first * dim.second))
+    {
+        for (int vec = 0; vec < numVectors; ++vec)
+        {
+            char slot[16] = { 0 };
+
+            for (int i = 0; i < vectorSize; ++i)
+            {
+                /* Select component of the current vector (the components are in row-major order) */
+                auto index = (isMatrix ? (rowMajor ? i * dim.second + vec : vec * dim.second + i) : i);
+                auto value = components[first + static_cast<std::size_t>(index)];
+
+                if (IsRealType(baseType))
+                {
+                    auto scalar = static_cast<float>(value.ToReal());
+                    std::memcpy(slot + i*4, &scalar, 4);
+                }
+                else if (IsUIntType(baseType))
+                {
+                    auto scalar = static_cast<std::uint32_t>(value.ToInt());
+                    std::memcpy(slot + i*4, &scalar, 4);
+                }
+                else if (IsBooleanType(baseType))
+                {
+                    auto scalar = static_cast<std::uint32_t>(value.ToBool() ? 1 : 0);
+                    std::memcpy(slot + i*4, &scalar, 4);
+                }
+                else
+                {
+                    auto scalar = static_cast<std::int32_t>(value.ToInt());
+                    std::memcpy(slot + i*4, &scalar, 4);
+                }
+            }
+
+            data_.insert(data_.end(), slot, slot + 16);
+        }
+    }
+
+    return stride;
+}
+
+void ConstantTableExtractor::InsertConstantTableBuffer(Program& program)
+{
+    /* Use next free constant buffer slot, if the other constant buffers have explicit slots */
+    int nextSlot = -1;
+
+    for (const auto& stmnt : program.globalStmnts)
+    {
+        if (auto uniformBufferDecl = stmnt->As<UniformBufferDecl>())
+        {
+            for (const auto& slotRegister : uniformBufferDecl->slotRegisters)
+            {
+                if (slotRegister->registerType == RegisterType::ConstantBuffer)
+                    nextSlot = std::max(nextSlot, slotRegister->slot + 1);
+            }
+        }
+    }
+
+    if (nextSlot >= 0)
+    {
+        auto slotRegister = MakeShared<Register>(SourcePosition::ignore);
+        {
+            slotRegister->registerType  = RegisterType::ConstantBuffer;
+            slotRegister->slot          = nextSlot;
+        }
+        constantTableBuffer_->slotRegisters.push_back(slotRegister);
+    }
+
+    /* Insert constant buffer in front of all other global statements */
+    program.globalStmnts.insert(program.globalStmnts.begin(), constantTableBuffer_);
+
+    if (reflectionData_)
+    {
+        reflectionData_->constantTableBuffer = constantTableBuffer_->ident;
+        reflectionData_->constantTableData = data_;
+    }
+}
+
+/* ------- Visit functions ------- */
+
+#define IMPLEMENT_VISIT_PROC(AST_NAME) \
+    void ConstantTableExtractor::Visit##AST_NAME(AST_NAME* ast, void* args)
+
+IMPLEMENT_VISIT_PROC(CodeBlock)
+{
+    for (auto it = ast->stmnts.begin(); it != ast->stmnts.end();)
+    {
+        if (ExtractConstantTable(*it, true))
+            it = ast->stmnts.erase(it);
+        else
+            ++it;
+    }
+    VISIT_DEFAULT(CodeBlock);
+}
+
+#undef IMPLEMENT_VISIT_PROC
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
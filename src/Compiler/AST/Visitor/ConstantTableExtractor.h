@@ -0,0 +1,88 @@
+/*
+ * ConstantTableExtractor.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_CONSTANT_TABLE_EXTRACTOR_H
+#define XSC_CONSTANT_TABLE_EXTRACTOR_H
+
+
+#include "Visitor.h"
+#include "ASTEnums.h"
+#include "Variant.h"
+#include <Xsc/Xsc.h>
+#include <vector>
+#include <set>
+
+
+namespace Xsc
+{
+
+
+/*
+Constant table extractor.
+This AST modifier moves all large static constant arrays (e.g. look-up tables or Poisson disks) into a synthesized constant buffer,
+and stores their initial values in the "std140" layout in the reflection data, so that they can be uploaded once by the application.
+Only arrays with a single dimension of scalars, vectors, or matrices, which are declared in their own statement with a constant initializer, are considered.
+*/
+class ConstantTableExtractor : private Visitor
+{
+
+    public:
+
+        // Moves all static constant arrays with at least 'threshold' elements into the constant table buffer, and returns the number of moved arrays.
+        std::size_t ExtractConstantTables(
+            Program&                        program,
+            unsigned int                    threshold,
+            const NameMangling&             nameMangling,
+            Reflection::ReflectionData*     reflectionData
+        );
+
+    private:
+
+        /* === Functions === */
+
+        // Collects all global variables that are accessed from the reachable functions.
+        void CollectReachableVars();
+
+        // Moves the specified statement into the constant table buffer if it declares a constant table, and returns true in this case.
+        bool ExtractConstantTable(const StmntPtr& stmnt, bool isLocal);
+
+        // Evaluates the initializer of the specified constant array, and returns the components of all elements in row-major order.
+        bool EvaluateElements(const InitializerExpr& initExpr, int numComponents, std::vector<Variant>& components);
+
+        // Appends the specified components in the "std140" layout to the constant table data, and returns the array stride.
+        unsigned int EncodeElements(const std::vector<Variant>& components, const DataType dataType, bool rowMajor);
+
+        void InsertConstantTableBuffer(Program& program);
+
+        /* ----- Visitor implementation ----- */
+
+        DECL_VISIT_PROC( CodeBlock );
+
+        /* === Members === */
+
+        unsigned int                    threshold_          = 0;
+        NameMangling                    nameMangling_;
+        Reflection::ReflectionData*     reflectionData_     = nullptr;
+
+        std::vector<FunctionDecl*>      reachableFuncs_;
+        std::set<VarDecl*>              reachableVars_;
+
+        UniformBufferDeclPtr            constantTableBuffer_;
+        std::set<std::string>           memberIdents_;
+        std::vector<char>               data_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
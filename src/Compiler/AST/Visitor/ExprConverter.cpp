@@ -124,7 +124,7 @@ void ExprConverter::ConvertExpr(ExprPtr& expr, const Flags& flags)
         ConvertExprIntoBracket(expr);
 }
 
-void ExprConverter::ConvertExprList(std::vector<ExprPtr>& exprList, const Flags& flags)
+void ExprConverter::ConvertExprList(ExprList& exprList, const Flags& flags)
 {
     for (auto& expr : exprList)
         ConvertExpr(expr, flags);
@@ -73,7 +73,7 @@ class ExprConverter : public Visitor
         void ConvertExpr(ExprPtr& expr, const Flags& flags);
 
         // Converts the list of expressions (see ConvertExpr).
-        void ConvertExprList(std::vector<ExprPtr>& exprList, const Flags& flags);
+        void ConvertExprList(ExprList& exprList, const Flags& flags);
 
         // Converts the expression if a vector subscript is used on a scalar type expression.
         void ConvertExprVectorSubscript(ExprPtr& expr);
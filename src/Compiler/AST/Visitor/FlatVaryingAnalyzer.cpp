@@ -0,0 +1,591 @@
+/*
+ * FlatVaryingAnalyzer.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "FlatVaryingAnalyzer.h"
+#include "CallGraphCollector.h"
+#include "AST.h"
+#include "Helper.h"
+#include <algorithm>
+
+
+namespace Xsc
+{
+
+
+std::size_t FlatVaryingAnalyzer::DeclareFlatOutputs(Program& program, Reflection::ReflectionData* reflectionData)
+{
+    auto entryPoint = program.entryPointRef;
+    if (!entryPoint)
+        return 0;
+
+    CallGraphCollector callGraph;
+    callGraph.CollectReachableFunctions(entryPoint);
+    reachableFuncs_ = callGraph.GetReachableFunctions();
+
+    /* All inputs vary within a primitive, except the instance ID which is equal for all vertices of a primitive */
+    entryPoint->inputSemantics.ForEach(
+        [this](VarDecl* varDecl)
+        {
+            if (varDecl->semantic != Semantic::InstanceID)
+                MarkVarying(varDecl);
+        }
+    );
+
+    /* Propagate varying values through all reachable functions until no more variables are marked */
+    do
+    {
+        changed_ = false;
+
+        for (auto funcDecl : reachableFuncs_)
+        {
+            currentFunc_                = funcDecl;
+            varyingControlFlowDepth_    = (varyingControlFlowFuncs_.find(funcDecl) != varyingControlFlowFuncs_.end() ? 1 : 0);
+            Visit(funcDecl->codeBlock);
+        }
+    }
+    while (changed_);
+
+    currentFunc_ = nullptr;
+
+    /* Declare all user defined outputs that are constant within a primitive as flat */
+    std::vector<VarDecl*> flatOutputs;
+
+    for (auto varDecl : entryPoint->outputSemantics.varDeclRefs)
+    {
+        if (IsFlatOutput(varDecl))
+            flatOutputs.push_back(varDecl);
+    }
+
+    return DeclareFlatVarDecls(flatOutputs, reflectionData);
+}
+
+std::size_t FlatVaryingAnalyzer::DeclareFlatInputs(Program& program, const std::vector<std::string>& semantics)
+{
+    auto entryPoint = program.entryPointRef;
+    if (!entryPoint || semantics.empty())
+        return 0;
+
+    std::set<std::string> flatSemantics;
+    for (const auto& semantic : semantics)
+        flatSemantics.insert(ToUpper(semantic));
+
+    std::vector<VarDecl*> flatInputs;
+
+    for (auto varDecl : entryPoint->inputSemantics.varDeclRefs)
+    {
+        if (flatSemantics.find(ToUpper(varDecl->semantic.ToString())) != flatSemantics.end())
+            flatInputs.push_back(varDecl);
+    }
+
+    return DeclareFlatVarDecls(flatInputs, nullptr);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void FlatVaryingAnalyzer::MarkVarying(VarDecl* varDecl)
+{
+    if (varDecl && varyingVars_.insert(varDecl).second)
+    {
+        changed_ = true;
+
+        /* Mark all members of a structure, since the entire object is varying */
+        if (varDecl->declStmntRef)
+        {
+            if (auto structDecl = varDecl->declStmntRef->typeSpecifier->GetStructDeclRef())
+            {
+                structDecl->ForEachVarDecl(
+                    [this](VarDeclPtr& memberVarDecl)
+                    {
+                        MarkVarying(memberVarDecl.get());
+                    }
+                );
+            }
+        }
+    }
+}
+
+void FlatVaryingAnalyzer::MarkVaryingTarget(Expr* expr)
+{
+    if (expr)
+        MarkVaryingTarget(expr->FetchVarIdent());
+}
+
+void FlatVaryingAnalyzer::MarkVaryingTarget(VarIdent* varIdent)
+{
+    /* Mark the last variable of the identifier chain (e.g. "member" in "object.member.xy") */
+    VarDecl* lastVarDecl = nullptr;
+
+    for (; varIdent != nullptr; varIdent = varIdent->next.get())
+    {
+        if (auto varDecl = varIdent->FetchVarDecl())
+            lastVarDecl = varDecl;
+    }
+
+    MarkVarying(lastVarDecl);
+}
+
+void FlatVaryingAnalyzer::MarkVaryingReturn(FunctionDecl* funcDecl)
+{
+    if (funcDecl && varyingReturnFuncs_.insert(funcDecl).second)
+        changed_ = true;
+}
+
+void FlatVaryingAnalyzer::MarkVaryingControlFlow(FunctionDecl* funcDecl)
+{
+    if (funcDecl && varyingControlFlowFuncs_.insert(funcDecl).second)
+        changed_ = true;
+}
+
+bool FlatVaryingAnalyzer::IsVarying(VarDecl* varDecl) const
+{
+    return (varyingVars_.find(varDecl) != varyingVars_.end());
+}
+
+bool FlatVaryingAnalyzer::IsVaryingExpr(Expr* expr)
+{
+    if (!expr)
+        return false;
+
+    if (expr->Type() == AST::Types::NullExpr || expr->Type() == AST::Types::LiteralExpr || expr->Type() == AST::Types::TypeSpecifierExpr)
+        return false;
+
+    if (auto ast = expr->As<ListExpr>())
+        return (IsVaryingExpr(ast->firstExpr.get()) || IsVaryingExpr(ast->nextExpr.get()));
+
+    if (auto ast = expr->As<TernaryExpr>())
+        return (IsVaryingExpr(ast->condExpr.get()) || IsVaryingExpr(ast->thenExpr.get()) || IsVaryingExpr(ast->elseExpr.get()));
+
+    if (auto ast = expr->As<BinaryExpr>())
+        return (IsVaryingExpr(ast->lhsExpr.get()) || IsVaryingExpr(ast->rhsExpr.get()));
+
+    if (auto ast = expr->As<UnaryExpr>())
+        return IsVaryingExpr(ast->expr.get());
+
+    if (auto ast = expr->As<PostUnaryExpr>())
+        return IsVaryingExpr(ast->expr.get());
+
+    if (auto ast = expr->As<FunctionCallExpr>())
+        return IsVaryingFunctionCall(ast->call.get());
+
+    if (auto ast = expr->As<BracketExpr>())
+        return IsVaryingExpr(ast->expr.get());
+
+    if (auto ast = expr->As<SuffixExpr>())
+        return (IsVaryingExpr(ast->expr.get()) || IsVaryingVarIdent(ast->varIdent.get()));
+
+    if (auto ast = expr->As<ArrayAccessExpr>())
+    {
+        for (const auto& index : ast->arrayIndices)
+        {
+            if (IsVaryingExpr(index.get()))
+                return true;
+        }
+        return IsVaryingExpr(ast->expr.get());
+    }
+
+    if (auto ast = expr->As<CastExpr>())
+        return IsVaryingExpr(ast->expr.get());
+
+    if (auto ast = expr->As<VarAccessExpr>())
+        return (IsVaryingVarIdent(ast->varIdent.get()) || IsVaryingExpr(ast->assignExpr.get()));
+
+    if (auto ast = expr->As<InitializerExpr>())
+    {
+        for (const auto& subExpr : ast->exprs)
+        {
+            if (IsVaryingExpr(subExpr.get()))
+                return true;
+        }
+        return false;
+    }
+
+    /* Consider all unknown expressions as varying */
+    return true;
+}
+
+bool FlatVaryingAnalyzer::IsVaryingVarIdent(VarIdent* varIdent)
+{
+    for (; varIdent != nullptr; varIdent = varIdent->next.get())
+    {
+        /* Read-write buffers can be modified by other vertices */
+        if (auto bufferDecl = varIdent->FetchSymbol<BufferDecl>())
+        {
+            if (IsRWBufferType(bufferDecl->GetBufferType()))
+                return true;
+        }
+        else if (IsVarying(varIdent->FetchVarDecl()))
+            return true;
+
+        for (const auto& index : varIdent->arrayIndices)
+        {
+            if (IsVaryingExpr(index.get()))
+                return true;
+        }
+    }
+    return false;
+}
+
+bool FlatVaryingAnalyzer::IsVaryingFunctionCall(FunctionCall* funcCall)
+{
+    /* Check array indices of the object of a member function call */
+    if (IsVaryingArrayIndices(funcCall->varIdent.get()))
+        return true;
+
+    if (auto funcDecl = funcCall->GetFunctionImpl())
+    {
+        /* Arguments are propagated to the parameters of the function, so only its return value must be considered */
+        return (varyingReturnFuncs_.find(funcDecl) != varyingReturnFuncs_.end());
+    }
+
+    /* Atomic operations depend on other vertices */
+    if (funcCall->intrinsic >= Intrinsic::InterlockedAdd && funcCall->intrinsic <= Intrinsic::InterlockedXor)
+        return true;
+
+    /* Intrinsics and type constructors are varying if any argument is varying */
+    for (const auto& arg : funcCall->arguments)
+    {
+        if (IsVaryingExpr(arg.get()))
+            return true;
+    }
+
+    return false;
+}
+
+bool FlatVaryingAnalyzer::IsVaryingArrayIndices(VarIdent* varIdent)
+{
+    for (; varIdent != nullptr; varIdent = varIdent->next.get())
+    {
+        for (const auto& index : varIdent->arrayIndices)
+        {
+            if (IsVaryingExpr(index.get()))
+                return true;
+        }
+    }
+    return false;
+}
+
+bool FlatVaryingAnalyzer::IsVaryingValue(Expr* expr)
+{
+    if (!expr)
+        return false;
+
+    if (expr->GetTypeDenoter()->GetAliased().IsStruct())
+        return IsVaryingStructSelection(expr);
+    else
+        return IsVaryingExpr(expr);
+}
+
+bool FlatVaryingAnalyzer::IsVaryingStructSelection(Expr* expr)
+{
+    if (auto ast = expr->As<BracketExpr>())
+        return IsVaryingStructSelection(ast->expr.get());
+
+    if (auto ast = expr->As<TernaryExpr>())
+    {
+        return
+        (
+            IsVaryingExpr(ast->condExpr.get())             ||
+            IsVaryingStructSelection(ast->thenExpr.get())   ||
+            IsVaryingStructSelection(ast->elseExpr.get())
+        );
+    }
+
+    if (auto ast = expr->As<VarAccessExpr>())
+        return IsVaryingArrayIndices(ast->varIdent.get());
+
+    if (auto ast = expr->As<SuffixExpr>())
+        return (IsVaryingStructSelection(ast->expr.get()) || IsVaryingArrayIndices(ast->varIdent.get()));
+
+    if (auto ast = expr->As<ArrayAccessExpr>())
+    {
+        for (const auto& index : ast->arrayIndices)
+        {
+            if (IsVaryingExpr(index.get()))
+                return true;
+        }
+        return IsVaryingStructSelection(ast->expr.get());
+    }
+
+    if (auto ast = expr->As<FunctionCallExpr>())
+        return IsVaryingFunctionCall(ast->call.get());
+
+    if (auto ast = expr->As<CastExpr>())
+        return IsVaryingValue(ast->expr.get());
+
+    return IsVaryingExpr(expr);
+}
+
+bool FlatVaryingAnalyzer::IsFlatOutput(VarDecl* varDecl) const
+{
+    return (varDecl->declStmntRef != nullptr && !IsVarying(varDecl));
+}
+
+std::size_t FlatVaryingAnalyzer::DeclareFlatVarDecls(const std::vector<VarDecl*>& varDecls, Reflection::ReflectionData* reflectionData)
+{
+    std::size_t numFlatVarDecls = 0;
+
+    std::set<VarDecl*> flatVarDecls(varDecls.begin(), varDecls.end());
+    std::set<VarDeclStmnt*> visitedStmnts;
+
+    for (auto varDecl : varDecls)
+    {
+        auto varDeclStmnt = varDecl->declStmntRef;
+        if (!visitedStmnts.insert(varDeclStmnt).second)
+            continue;
+
+        /* Keep explicit interpolation modifiers */
+        auto& interpModifiers = varDeclStmnt->typeSpecifier->interpModifiers;
+        if (!interpModifiers.empty())
+            continue;
+
+        /* The modifier applies to the entire statement, so all of its variables must be flat */
+        auto allFlat = std::all_of(
+            varDeclStmnt->varDecls.begin(), varDeclStmnt->varDecls.end(),
+            [&flatVarDecls](const VarDeclPtr& stmntVarDecl)
+            {
+                return (flatVarDecls.find(stmntVarDecl.get()) != flatVarDecls.end());
+            }
+        );
+
+        if (!allFlat)
+            continue;
+
+        interpModifiers.insert(InterpModifier::NoInterpolation);
+
+        for (const auto& stmntVarDecl : varDeclStmnt->varDecls)
+        {
+            if (reflectionData)
+                reflectionData->flatOutputs.push_back(stmntVarDecl->semantic.ToString());
+            ++numFlatVarDecls;
+        }
+    }
+
+    return numFlatVarDecls;
+}
+
+void FlatVaryingAnalyzer::PushVaryingControlFlow(bool isVarying)
+{
+    if (isVarying)
+        ++varyingControlFlowDepth_;
+}
+
+void FlatVaryingAnalyzer::PopVaryingControlFlow(bool isVarying)
+{
+    if (isVarying)
+        --varyingControlFlowDepth_;
+}
+
+/* ------- Visit functions ------- */
+
+#define IMPLEMENT_VISIT_PROC(AST_NAME) \
+    void FlatVaryingAnalyzer::Visit##AST_NAME(AST_NAME* ast, void* args)
+
+IMPLEMENT_VISIT_PROC(FunctionCall)
+{
+    if (auto funcDecl = ast->GetFunctionImpl())
+    {
+        /* Propagate varying arguments to the parameters, and varying output parameters back to the arguments */
+        const auto& parameters = funcDecl->parameters;
+        for (std::size_t i = 0, n = std::min(ast->arguments.size(), parameters.size()); i < n; ++i)
+        {
+            auto param = parameters[i]->varDecls.front().get();
+
+            if (IsVaryingValue(ast->arguments[i].get()))
+                MarkVarying(param);
+
+            if (parameters[i]->IsOutput() && (varyingControlFlowDepth_ > 0 || IsVarying(param)))
+                MarkVaryingTarget(ast->arguments[i].get());
+        }
+
+        if (varyingControlFlowDepth_ > 0)
+            MarkVaryingControlFlow(funcDecl);
+    }
+    else if (ast->intrinsic != Intrinsic::Undefined)
+    {
+        if (varyingControlFlowDepth_ > 0 || IsVaryingFunctionCall(ast))
+        {
+            ast->ForEachOutputArgument(
+                [this](ExprPtr& arg)
+                {
+                    MarkVaryingTarget(arg.get());
+                }
+            );
+        }
+    }
+
+    VISIT_DEFAULT(FunctionCall);
+}
+
+IMPLEMENT_VISIT_PROC(VarDecl)
+{
+    if (ast->initializer && IsVaryingValue(ast->initializer.get()))
+        MarkVarying(ast);
+    VISIT_DEFAULT(VarDecl);
+}
+
+IMPLEMENT_VISIT_PROC(ForLoopStmnt)
+{
+    Visit(ast->initStmnt);
+    Visit(ast->condition);
+
+    auto isVarying = IsVaryingExpr(ast->condition.get());
+    PushVaryingControlFlow(isVarying);
+    {
+        Visit(ast->iteration);
+        Visit(ast->bodyStmnt);
+    }
+    PopVaryingControlFlow(isVarying);
+}
+
+IMPLEMENT_VISIT_PROC(WhileLoopStmnt)
+{
+    Visit(ast->condition);
+
+    auto isVarying = IsVaryingExpr(ast->condition.get());
+    PushVaryingControlFlow(isVarying);
+    {
+        Visit(ast->bodyStmnt);
+    }
+    PopVaryingControlFlow(isVarying);
+}
+
+IMPLEMENT_VISIT_PROC(DoWhileLoopStmnt)
+{
+    auto isVarying = IsVaryingExpr(ast->condition.get());
+    PushVaryingControlFlow(isVarying);
+    {
+        Visit(ast->bodyStmnt);
+    }
+    PopVaryingControlFlow(isVarying);
+
+    Visit(ast->condition);
+}
+
+IMPLEMENT_VISIT_PROC(IfStmnt)
+{
+    Visit(ast->condition);
+
+    auto isVarying = IsVaryingExpr(ast->condition.get());
+    PushVaryingControlFlow(isVarying);
+    {
+        Visit(ast->bodyStmnt);
+        Visit(ast->elseStmnt);
+    }
+    PopVaryingControlFlow(isVarying);
+}
+
+IMPLEMENT_VISIT_PROC(SwitchStmnt)
+{
+    Visit(ast->selector);
+
+    auto isVarying = IsVaryingExpr(ast->selector.get());
+    PushVaryingControlFlow(isVarying);
+    {
+        Visit(ast->cases);
+    }
+    PopVaryingControlFlow(isVarying);
+}
+
+IMPLEMENT_VISIT_PROC(ReturnStmnt)
+{
+    if (varyingControlFlowDepth_ > 0)
+    {
+        /* All statements after a varying return are executed under varying control flow */
+        MarkVaryingControlFlow(currentFunc_);
+        MarkVaryingReturn(currentFunc_);
+    }
+    else if (IsVaryingValue(ast->expr.get()))
+        MarkVaryingReturn(currentFunc_);
+
+    /* Mark all members of a returned structure, if the structure object itself is selected by a varying value */
+    if (ast->expr && varyingReturnFuncs_.find(currentFunc_) != varyingReturnFuncs_.end())
+    {
+        if (auto structTypeDen = ast->expr->GetTypeDenoter()->GetAliased().As<StructTypeDenoter>())
+        {
+            if (auto structDecl = structTypeDen->structDeclRef)
+            {
+                structDecl->ForEachVarDecl(
+                    [this](VarDeclPtr& memberVarDecl)
+                    {
+                        MarkVarying(memberVarDecl.get());
+                    }
+                );
+            }
+        }
+    }
+
+    VISIT_DEFAULT(ReturnStmnt);
+}
+
+IMPLEMENT_VISIT_PROC(CtrlTransferStmnt)
+{
+    /* All statements after a varying 'break' or 'continue' are executed under varying control flow */
+    if (varyingControlFlowDepth_ > 0)
+        MarkVaryingControlFlow(currentFunc_);
+}
+
+IMPLEMENT_VISIT_PROC(TernaryExpr)
+{
+    Visit(ast->condExpr);
+
+    auto isVarying = IsVaryingExpr(ast->condExpr.get());
+    PushVaryingControlFlow(isVarying);
+    {
+        Visit(ast->thenExpr);
+        Visit(ast->elseExpr);
+    }
+    PopVaryingControlFlow(isVarying);
+}
+
+IMPLEMENT_VISIT_PROC(BinaryExpr)
+{
+    Visit(ast->lhsExpr);
+
+    /* The right hand side of a logical operator is only evaluated depending on the left hand side */
+    auto isVarying = ((ast->op == BinaryOp::LogicalAnd || ast->op == BinaryOp::LogicalOr) && IsVaryingExpr(ast->lhsExpr.get()));
+    PushVaryingControlFlow(isVarying);
+    {
+        Visit(ast->rhsExpr);
+    }
+    PopVaryingControlFlow(isVarying);
+}
+
+IMPLEMENT_VISIT_PROC(UnaryExpr)
+{
+    if (IsLValueOp(ast->op) && varyingControlFlowDepth_ > 0)
+        MarkVaryingTarget(ast->expr.get());
+    VISIT_DEFAULT(UnaryExpr);
+}
+
+IMPLEMENT_VISIT_PROC(PostUnaryExpr)
+{
+    if (IsLValueOp(ast->op) && varyingControlFlowDepth_ > 0)
+        MarkVaryingTarget(ast->expr.get());
+    VISIT_DEFAULT(PostUnaryExpr);
+}
+
+IMPLEMENT_VISIT_PROC(VarAccessExpr)
+{
+    if (ast->assignExpr)
+    {
+        if (varyingControlFlowDepth_ > 0 || IsVaryingArrayIndices(ast->varIdent.get()) || IsVaryingValue(ast->assignExpr.get()))
+            MarkVaryingTarget(ast->varIdent.get());
+    }
+    VISIT_DEFAULT(VarAccessExpr);
+}
+
+#undef IMPLEMENT_VISIT_PROC
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
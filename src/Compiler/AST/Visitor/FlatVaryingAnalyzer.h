@@ -0,0 +1,124 @@
+/*
+ * FlatVaryingAnalyzer.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_FLAT_VARYING_ANALYZER_H
+#define XSC_FLAT_VARYING_ANALYZER_H
+
+
+#include "Visitor.h"
+#include <Xsc/Xsc.h>
+#include <string>
+#include <vector>
+#include <set>
+
+
+namespace Xsc
+{
+
+
+/*
+Flat varying analyzer.
+This AST modifier determines which outputs of a vertex shader are constant within each primitive,
+i.e. they are only derived from uniforms, constants, and the instance ID, but not from any per-vertex input.
+These outputs are declared with the "nointerpolation" modifier (written as 'flat' in GLSL), and their semantics are reported in the reflection data.
+For other shaders, the inputs with the specified semantics are declared with the "nointerpolation" modifier, to match the interface of the vertex shader.
+The analysis is conservative: all structure members are tracked per member declaration (i.e. for all instances of a structure at once),
+and every value that depends on a per-vertex input through data or control flow is considered to vary within a primitive.
+*/
+class FlatVaryingAnalyzer : private Visitor
+{
+
+    public:
+
+        // Declares the flat outputs of the vertex shader entry point, and returns the number of flat outputs.
+        std::size_t DeclareFlatOutputs(Program& program, Reflection::ReflectionData* reflectionData);
+
+        // Declares the inputs of the entry point with the specified semantics as flat inputs, and returns the number of flat inputs.
+        std::size_t DeclareFlatInputs(Program& program, const std::vector<std::string>& semantics);
+
+    private:
+
+        /* === Functions === */
+
+        // Marks the specified variable (and all members, if it is a structure) as varying within a primitive.
+        void MarkVarying(VarDecl* varDecl);
+
+        // Marks the variable that is referenced by the specified l-value expression as varying.
+        void MarkVaryingTarget(Expr* expr);
+        void MarkVaryingTarget(VarIdent* varIdent);
+
+        void MarkVaryingReturn(FunctionDecl* funcDecl);
+        void MarkVaryingControlFlow(FunctionDecl* funcDecl);
+
+        bool IsVarying(VarDecl* varDecl) const;
+
+        // Returns true if the specified expression may have different values within a primitive.
+        bool IsVaryingExpr(Expr* expr);
+        bool IsVaryingVarIdent(VarIdent* varIdent);
+        bool IsVaryingFunctionCall(FunctionCall* funcCall);
+        bool IsVaryingArrayIndices(VarIdent* varIdent);
+
+        /*
+        Returns true if the specified value may be different within a primitive.
+        For structures, only the selection of the value is considered (e.g. by a varying ternary condition),
+        because all members are tracked by their own declarations.
+        */
+        bool IsVaryingValue(Expr* expr);
+        bool IsVaryingStructSelection(Expr* expr);
+
+        // Returns true if the specified output variable can be declared with 'flat' interpolation.
+        bool IsFlatOutput(VarDecl* varDecl) const;
+
+        // Adds the "nointerpolation" modifier to the declaration statements of the specified variables, and returns the number of flat variables.
+        std::size_t DeclareFlatVarDecls(const std::vector<VarDecl*>& varDecls, Reflection::ReflectionData* reflectionData);
+
+        void PushVaryingControlFlow(bool isVarying);
+        void PopVaryingControlFlow(bool isVarying);
+
+        /* ----- Visitor implementation ----- */
+
+        DECL_VISIT_PROC( FunctionCall      );
+
+        DECL_VISIT_PROC( VarDecl           );
+
+        DECL_VISIT_PROC( ForLoopStmnt      );
+        DECL_VISIT_PROC( WhileLoopStmnt    );
+        DECL_VISIT_PROC( DoWhileLoopStmnt  );
+        DECL_VISIT_PROC( IfStmnt           );
+        DECL_VISIT_PROC( SwitchStmnt       );
+        DECL_VISIT_PROC( ReturnStmnt       );
+        DECL_VISIT_PROC( CtrlTransferStmnt );
+
+        DECL_VISIT_PROC( TernaryExpr       );
+        DECL_VISIT_PROC( BinaryExpr        );
+        DECL_VISIT_PROC( UnaryExpr         );
+        DECL_VISIT_PROC( PostUnaryExpr     );
+        DECL_VISIT_PROC( VarAccessExpr     );
+
+        /* === Members === */
+
+        std::vector<FunctionDecl*> reachableFuncs_;
+
+        std::set<VarDecl*>      varyingVars_;               // Variables that may vary within a primitive.
+        std::set<FunctionDecl*> varyingReturnFuncs_;        // Functions whose return value may vary within a primitive.
+        std::set<FunctionDecl*> varyingControlFlowFuncs_;   // Functions whose body is (partially) executed under varying control flow.
+
+        FunctionDecl*           currentFunc_                = nullptr;
+        int                     varyingControlFlowDepth_    = 0;
+        bool                    changed_                    = false;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -37,16 +37,65 @@ void Optimizer::OptimizeStmntList(std::vector<StmntPtr>& stmnts)
     }
 }
 
+// Returns true if the specified expression is a type constructor or cast with only literal arguments (e.g. "float2(1.0, 2.0)").
+static bool IsLiteralTypeCtor(const Expr& expr)
+{
+    if (auto castExpr = expr.As<CastExpr>())
+        return (castExpr->expr->Type() == AST::Types::LiteralExpr && !castExpr->typeSpecifier->GetTypeDenoter()->IsScalar());
+    if (auto funcCallExpr = expr.As<FunctionCallExpr>())
+    {
+        if (funcCallExpr->call->typeDenoter)
+        {
+            for (const auto& arg : funcCallExpr->call->arguments)
+            {
+                if (arg->Type() != AST::Types::LiteralExpr)
+                    return false;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns the data type of the specified expression, or DataType::Undefined if it has no base type.
+static DataType FetchExprDataType(Expr& expr)
+{
+    try
+    {
+        if (auto baseTypeDen = expr.GetTypeDenoter()->Get()->As<BaseTypeDenoter>())
+            return baseTypeDen->dataType;
+    }
+    catch (const std::exception&)
+    {
+        /* ignore this exception */
+    }
+    return DataType::Undefined;
+}
+
 void Optimizer::OptimizeExpr(ExprPtr& expr)
 {
-    if (expr)
+    /*
+    Don't fold list expressions, since the constant expression evaluator only considers the first sub expression,
+    and don't fold single literals, which would lose their type suffix (e.g. "1.0L")
+    */
+    if (expr && expr->Type() != AST::Types::ListExpr && expr->Type() != AST::Types::LiteralExpr && !IsLiteralTypeCtor(*expr))
     {
         try
         {
             /* Try to evaluate expression */
             ConstExprEvaluator exprEval;
-            auto exprValue = exprEval.EvaluateExpr(*expr, [](VarAccessExpr* ast) -> Variant { throw ast; });
-            expr = ASTFactory::MakeLiteralExpr(exprValue);
+            auto exprValue = exprEval.EvaluateExpr(
+                *expr,
+                [this](VarAccessExpr* ast) -> Variant
+                {
+                    return EvaluateConstVarAccessExpr(*ast);
+                }
+            );
+
+            /* Replace expression by literal, or by type constructor for vectors and matrices */
+            auto constExpr = ASTFactory::MakeVariantExpr(exprValue, FetchExprDataType(*expr), exprEval.HasDoublePrecision());
+            constExpr->area = expr->area;
+            expr = constExpr;
         }
         catch (const std::exception&)
         {
@@ -59,6 +108,54 @@ void Optimizer::OptimizeExpr(ExprPtr& expr)
     }
 }
 
+// Returns true if the specified identifier is a chain of swizzle operators (e.g. "xyz.x").
+static bool IsSwizzleVarIdent(const VarIdent* varIdent)
+{
+    for (; varIdent != nullptr; varIdent = varIdent->next.get())
+    {
+        if (varIdent->symbolRef || !varIdent->arrayIndices.empty())
+            return false;
+    }
+    return true;
+}
+
+Variant Optimizer::EvaluateConstVarAccessExpr(VarAccessExpr& ast)
+{
+    /* Only fold read access to constant variables (no uniforms, arrays, or structure members) */
+    auto varIdent = ast.varIdent.get();
+
+    if (!ast.assignExpr && varIdent->arrayIndices.empty() && IsSwizzleVarIdent(varIdent->next.get()))
+    {
+        if (auto varDecl = varIdent->FetchVarDecl())
+        {
+            if (auto varDeclStmnt = varDecl->declStmntRef)
+            {
+                if (varDeclStmnt->typeSpecifier->IsConst() && !varDeclStmnt->IsUniform() && varDecl->arrayDims.empty() && varDecl->initializer)
+                {
+                    /* Evaluate initializer of constant variable */
+                    ConstExprEvaluator exprEval;
+                    auto value = exprEval.EvaluateExpr(
+                        *varDecl->initializer,
+                        [this](VarAccessExpr* ast) -> Variant
+                        {
+                            return EvaluateConstVarAccessExpr(*ast);
+                        }
+                    );
+
+                    /* Apply swizzle operators (throws std::invalid_argument on failure) */
+                    for (auto swizzle = varIdent->next.get(); swizzle != nullptr; swizzle = swizzle->next.get())
+                        value = value.Swizzle(swizzle->ident);
+
+                    return value;
+                }
+            }
+        }
+    }
+
+    /* Throw expression due to non-constness */
+    throw (&ast);
+}
+
 bool Optimizer::CanRemoveStmnt(const Stmnt& ast) const
 {
     /* Remove if node is null-statement */
@@ -96,17 +193,28 @@ IMPLEMENT_VISIT_PROC(SwitchCase)
 
 IMPLEMENT_VISIT_PROC(ArrayDimension)
 {
+    VISIT_DEFAULT(ArrayDimension);
     OptimizeExpr(ast->expr);
 }
 
+IMPLEMENT_VISIT_PROC(FunctionCall)
+{
+    VISIT_DEFAULT(FunctionCall);
+    for (auto& arg : ast->arguments)
+        OptimizeExpr(arg);
+}
+
 IMPLEMENT_VISIT_PROC(VarDecl)
 {
+    VISIT_DEFAULT(VarDecl);
     OptimizeExpr(ast->initializer);
 }
 
 IMPLEMENT_VISIT_PROC(ForLoopStmnt)
 {
     Visit(ast->initStmnt);
+    Visit(ast->condition);
+    Visit(ast->iteration);
     OptimizeExpr(ast->condition);
     OptimizeExpr(ast->iteration);
     Visit(ast->bodyStmnt);
@@ -114,18 +222,21 @@ IMPLEMENT_VISIT_PROC(ForLoopStmnt)
 
 IMPLEMENT_VISIT_PROC(WhileLoopStmnt)
 {
+    Visit(ast->condition);
     OptimizeExpr(ast->condition);
     Visit(ast->bodyStmnt);
 }
 
 IMPLEMENT_VISIT_PROC(DoWhileLoopStmnt)
 {
+    Visit(ast->condition);
     OptimizeExpr(ast->condition);
     Visit(ast->bodyStmnt);
 }
 
 IMPLEMENT_VISIT_PROC(IfStmnt)
 {
+    Visit(ast->condition);
     OptimizeExpr(ast->condition);
     Visit(ast->bodyStmnt);
     Visit(ast->elseStmnt);
@@ -138,17 +249,20 @@ IMPLEMENT_VISIT_PROC(ElseStmnt)
 
 IMPLEMENT_VISIT_PROC(SwitchStmnt)
 {
+    Visit(ast->selector);
     OptimizeExpr(ast->selector);
     Visit(ast->cases);
 }
 
 IMPLEMENT_VISIT_PROC(ExprStmnt)
 {
+    VISIT_DEFAULT(ExprStmnt);
     OptimizeExpr(ast->expr);
 }
 
 IMPLEMENT_VISIT_PROC(ReturnStmnt)
 {
+    VISIT_DEFAULT(ReturnStmnt);
     OptimizeExpr(ast->expr);
 }
 
@@ -216,6 +330,12 @@ IMPLEMENT_VISIT_PROC(CastExpr)
     OptimizeExpr(ast->expr);
 }
 
+IMPLEMENT_VISIT_PROC(VarAccessExpr)
+{
+    VISIT_DEFAULT(VarAccessExpr);
+    OptimizeExpr(ast->assignExpr);
+}
+
 IMPLEMENT_VISIT_PROC(InitializerExpr)
 {
     VISIT_DEFAULT(InitializerExpr);
@@ -10,6 +10,7 @@
 
 
 #include "Visitor.h"
+#include "Variant.h"
 #include <vector>
 
 
@@ -17,7 +18,10 @@ namespace Xsc
 {
 
 
-// This AST optimizer supports only little optimizations such as null-statement removal.
+/*
+This AST optimizer supports only little optimizations such as null-statement removal,
+and constant folding of scalar, vector, and matrix expressions (including pure intrinsics).
+*/
 class Optimizer : private Visitor
 {
     
@@ -32,6 +36,9 @@ class Optimizer : private Visitor
 
         void OptimizeExpr(ExprPtr& expr);
 
+        // Returns the value of the specified constant variable or throws the expression if it is not constant.
+        Variant EvaluateConstVarAccessExpr(VarAccessExpr& ast);
+
         bool CanRemoveStmnt(const Stmnt& ast) const;
 
         /* ----- Visitor implementation ----- */
@@ -39,6 +46,7 @@ class Optimizer : private Visitor
         DECL_VISIT_PROC( CodeBlock         );
         DECL_VISIT_PROC( SwitchCase        );
         DECL_VISIT_PROC( ArrayDimension    );
+        DECL_VISIT_PROC( FunctionCall      );
 
         DECL_VISIT_PROC( VarDecl           );
 
@@ -60,6 +68,7 @@ class Optimizer : private Visitor
         DECL_VISIT_PROC( SuffixExpr        );
         DECL_VISIT_PROC( ArrayAccessExpr   );
         DECL_VISIT_PROC( CastExpr          );
+        DECL_VISIT_PROC( VarAccessExpr     );
         DECL_VISIT_PROC( InitializerExpr   );
 
 };
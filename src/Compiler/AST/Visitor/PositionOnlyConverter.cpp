@@ -0,0 +1,521 @@
+/*
+ * PositionOnlyConverter.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "PositionOnlyConverter.h"
+#include "CallGraphCollector.h"
+#include "AST.h"
+#include "Helper.h"
+#include <algorithm>
+#include <functional>
+
+
+namespace Xsc
+{
+
+
+/*
+ * Internal helper classes
+ */
+
+// Collects all variables that are declared within the visited code blocks (except static variables).
+class LocalVarCollector : public Visitor
+{
+
+    public:
+
+        LocalVarCollector(std::set<VarDecl*>& localVars) :
+            localVars_ { localVars }
+        {
+        }
+
+        void Collect(CodeBlock* codeBlock)
+        {
+            Visit(codeBlock);
+        }
+
+    private:
+
+        void VisitVarDeclStmnt(VarDeclStmnt* ast, void* args) override
+        {
+            const auto& storageClasses = ast->typeSpecifier->storageClasses;
+            if (storageClasses.count(StorageClass::Static) == 0)
+            {
+                for (const auto& varDecl : ast->varDecls)
+                    localVars_.insert(varDecl.get());
+            }
+            VISIT_DEFAULT(VarDeclStmnt);
+        }
+
+        std::set<VarDecl*>& localVars_;
+
+};
+
+// Collects all variables that are read within the visited code blocks.
+class ReadVarCollector : public Visitor
+{
+
+    public:
+
+        ReadVarCollector(std::set<VarDecl*>& readVars, const std::set<VarDecl*>& deadOutputs) :
+            readVars_       { readVars    },
+            deadOutputs_    { deadOutputs }
+        {
+        }
+
+        void Collect(CodeBlock* codeBlock)
+        {
+            Visit(codeBlock);
+        }
+
+    private:
+
+        void MarkAsRead(VarIdent* varIdent)
+        {
+            VarDecl* lastVarDecl = nullptr;
+
+            for (; varIdent != nullptr; varIdent = varIdent->next.get())
+            {
+                if (auto varDecl = varIdent->FetchVarDecl())
+                {
+                    readVars_.insert(varDecl);
+                    lastVarDecl = varDecl;
+                }
+                Visit(varIdent->arrayIndices);
+            }
+
+            /* Mark all members as read, if an entire structure is read (except the removed outputs) */
+            if (lastVarDecl && lastVarDecl->declStmntRef)
+            {
+                if (auto structDecl = lastVarDecl->declStmntRef->typeSpecifier->GetStructDeclRef())
+                {
+                    structDecl->ForEachVarDecl(
+                        [&](VarDeclPtr& varDecl)
+                        {
+                            if (deadOutputs_.find(varDecl.get()) == deadOutputs_.end())
+                                readVars_.insert(varDecl.get());
+                        }
+                    );
+                }
+            }
+        }
+
+        void VisitVarIdent(VarIdent* ast, void* args) override
+        {
+            MarkAsRead(ast);
+        }
+
+        void VisitVarAccessExpr(VarAccessExpr* ast, void* args) override
+        {
+            if (ast->assignExpr)
+            {
+                /* Only the array indices of the assigned variable are read (compound assignments only read the value for the same variable) */
+                for (auto varIdent = ast->varIdent.get(); varIdent != nullptr; varIdent = varIdent->next.get())
+                    Visit(varIdent->arrayIndices);
+            }
+            else
+                MarkAsRead(ast->varIdent.get());
+
+            Visit(ast->assignExpr);
+        }
+
+        std::set<VarDecl*>&         readVars_;
+        const std::set<VarDecl*>&   deadOutputs_;
+
+};
+
+// Returns true if the specified intrinsic has side effects.
+static bool IsImpureIntrinsic(const Intrinsic intrinsic)
+{
+    switch (intrinsic)
+    {
+        case Intrinsic::Abort:
+        case Intrinsic::AllMemoryBarrier:
+        case Intrinsic::AllMemoryBarrierWithGroupSync:
+        case Intrinsic::Clip:
+        case Intrinsic::DeviceMemoryBarrier:
+        case Intrinsic::DeviceMemoryBarrierWithGroupSync:
+        case Intrinsic::GroupMemoryBarrier:
+        case Intrinsic::GroupMemoryBarrierWithGroupSync:
+        case Intrinsic::InterlockedAdd:
+        case Intrinsic::InterlockedAnd:
+        case Intrinsic::InterlockedCompareExchange:
+        case Intrinsic::InterlockedCompareStore:
+        case Intrinsic::InterlockedExchange:
+        case Intrinsic::InterlockedMax:
+        case Intrinsic::InterlockedMin:
+        case Intrinsic::InterlockedOr:
+        case Intrinsic::InterlockedXor:
+        case Intrinsic::StreamOutput_Append:
+        case Intrinsic::StreamOutput_RestartStrip:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Determines whether the visited AST nodes write to non-local variables or call impure functions.
+class SideEffectAnalyzer : public Visitor
+{
+
+    public:
+
+        using PureFunctionPredicate = std::function<bool(FunctionDecl* funcDecl)>;
+
+        // If 'localVars' is null, every assignment is considered to be a side effect.
+        SideEffectAnalyzer(const std::set<VarDecl*>* localVars, const PureFunctionPredicate& isPureFunc) :
+            localVars_  { localVars  },
+            isPureFunc_ { isPureFunc }
+        {
+        }
+
+        bool HasSideEffects(AST* ast)
+        {
+            hasSideEffects_ = false;
+            Visit(ast);
+            return hasSideEffects_;
+        }
+
+    private:
+
+        bool IsLocalVar(Expr* expr) const
+        {
+            if (localVars_ && expr)
+            {
+                if (auto varIdent = expr->FetchVarIdent())
+                {
+                    if (auto varDecl = varIdent->FetchVarDecl())
+                        return (localVars_->find(varDecl) != localVars_->end());
+                }
+            }
+            return false;
+        }
+
+        void VisitFunctionCall(FunctionCall* ast, void* args) override
+        {
+            if (IsImpureIntrinsic(ast->intrinsic))
+                hasSideEffects_ = true;
+            else if (auto funcDecl = ast->GetFunctionImpl())
+            {
+                if (!isPureFunc_(funcDecl))
+                    hasSideEffects_ = true;
+            }
+
+            ast->ForEachOutputArgument(
+                [this](ExprPtr& arg)
+                {
+                    if (!IsLocalVar(arg.get()))
+                        hasSideEffects_ = true;
+                }
+            );
+
+            VISIT_DEFAULT(FunctionCall);
+        }
+
+        void VisitUnaryExpr(UnaryExpr* ast, void* args) override
+        {
+            if (IsLValueOp(ast->op) && !IsLocalVar(ast->expr.get()))
+                hasSideEffects_ = true;
+            VISIT_DEFAULT(UnaryExpr);
+        }
+
+        void VisitPostUnaryExpr(PostUnaryExpr* ast, void* args) override
+        {
+            if (IsLValueOp(ast->op) && !IsLocalVar(ast->expr.get()))
+                hasSideEffects_ = true;
+            VISIT_DEFAULT(PostUnaryExpr);
+        }
+
+        void VisitVarAccessExpr(VarAccessExpr* ast, void* args) override
+        {
+            if (ast->assignExpr && !IsLocalVar(ast))
+                hasSideEffects_ = true;
+            VISIT_DEFAULT(VarAccessExpr);
+        }
+
+        const std::set<VarDecl*>*   localVars_      = nullptr;
+        PureFunctionPredicate       isPureFunc_;
+        bool                        hasSideEffects_ = false;
+
+};
+
+
+/*
+ * PositionOnlyConverter class
+ */
+
+void PositionOnlyConverter::Convert(Program& program)
+{
+    auto entryPoint = program.entryPointRef;
+    if (!entryPoint)
+        return;
+
+    CallGraphCollector callGraph;
+    callGraph.CollectReachableFunctions(entryPoint);
+    reachableFuncs_ = callGraph.GetReachableFunctions();
+
+    /* All outputs except the position are candidates for removal */
+    entryPoint->outputSemantics.ForEach(
+        [this](VarDecl* varDecl)
+        {
+            if (varDecl->semantic != Semantic::VertexPosition)
+                deadOutputs_.insert(varDecl);
+        }
+    );
+
+    /* Remove dead statements until no more statements can be removed */
+    do
+    {
+        CollectVars();
+
+        stmntsRemoved_ = false;
+        for (auto funcDecl : reachableFuncs_)
+            Visit(funcDecl);
+    }
+    while (stmntsRemoved_);
+
+    /* Remove all outputs that are no longer written, and all inputs that are no longer read */
+    CollectVars();
+    RemoveOutputSemantics(*entryPoint);
+    RemoveInputSemantics(*entryPoint);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void PositionOnlyConverter::RemoveOutputSemantics(FunctionDecl& entryPoint)
+{
+    auto IsRemovedOutput = [this](VarDecl* varDecl)
+    {
+        return (deadOutputs_.find(varDecl) != deadOutputs_.end() && readVars_.find(varDecl) == readVars_.end());
+    };
+
+    auto& outputs = entryPoint.outputSemantics;
+    outputs.varDeclRefs.erase(std::remove_if(outputs.varDeclRefs.begin(), outputs.varDeclRefs.end(), IsRemovedOutput), outputs.varDeclRefs.end());
+    outputs.varDeclRefsSV.erase(std::remove_if(outputs.varDeclRefsSV.begin(), outputs.varDeclRefsSV.end(), IsRemovedOutput), outputs.varDeclRefsSV.end());
+}
+
+void PositionOnlyConverter::RemoveInputSemantics(FunctionDecl& entryPoint)
+{
+    auto IsUnusedInput = [this](VarDecl* varDecl)
+    {
+        return (readVars_.find(varDecl) == readVars_.end());
+    };
+
+    auto& inputs = entryPoint.inputSemantics;
+    inputs.varDeclRefs.erase(std::remove_if(inputs.varDeclRefs.begin(), inputs.varDeclRefs.end(), IsUnusedInput), inputs.varDeclRefs.end());
+    inputs.varDeclRefsSV.erase(std::remove_if(inputs.varDeclRefsSV.begin(), inputs.varDeclRefsSV.end(), IsUnusedInput), inputs.varDeclRefsSV.end());
+}
+
+void PositionOnlyConverter::CollectVars()
+{
+    localVars_.clear();
+    readVars_.clear();
+
+    LocalVarCollector localVarCollector(localVars_);
+    ReadVarCollector readVarCollector(readVars_, deadOutputs_);
+
+    for (auto funcDecl : reachableFuncs_)
+    {
+        localVarCollector.Collect(funcDecl->codeBlock.get());
+        readVarCollector.Collect(funcDecl->codeBlock.get());
+    }
+}
+
+void PositionOnlyConverter::RemoveDeadStmnts(std::vector<StmntPtr>& stmnts)
+{
+    /* Determine all dead statements before any of them is released (later statements may still refer to their declarations) */
+    std::vector<bool> deadStmnts(stmnts.size());
+
+    for (std::size_t i = 0; i < stmnts.size(); ++i)
+        deadStmnts[i] = IsDeadStmnt(*stmnts[i]);
+
+    std::vector<StmntPtr> liveStmnts;
+    liveStmnts.reserve(stmnts.size());
+
+    for (std::size_t i = 0; i < stmnts.size(); ++i)
+    {
+        if (!deadStmnts[i])
+            liveStmnts.push_back(stmnts[i]);
+    }
+
+    if (liveStmnts.size() < stmnts.size())
+    {
+        stmnts = std::move(liveStmnts);
+        stmntsRemoved_ = true;
+    }
+}
+
+void PositionOnlyConverter::RemoveDeadStmnt(StmntPtr& stmnt)
+{
+    if (stmnt && IsDeadStmnt(*stmnt))
+    {
+        stmnt = MakeShared<NullStmnt>(stmnt->area);
+        stmntsRemoved_ = true;
+    }
+}
+
+bool PositionOnlyConverter::IsDeadStmnt(const Stmnt& ast)
+{
+    if (auto exprStmnt = ast.As<ExprStmnt>())
+    {
+        /* Remove assignments to variables that are never read */
+        if (auto varAccessExpr = exprStmnt->expr->As<VarAccessExpr>())
+            return IsDeadAssignment(*varAccessExpr);
+    }
+    else if (auto varDeclStmnt = ast.As<VarDeclStmnt>())
+    {
+        /* Remove local variables that are never read */
+        for (const auto& varDecl : varDeclStmnt->varDecls)
+        {
+            if (!IsDeadVar(varDecl.get()) || HasSideEffects(varDecl->initializer.get()))
+                return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool PositionOnlyConverter::IsDeadAssignment(const VarAccessExpr& ast)
+{
+    if (!ast.assignExpr || HasSideEffects(ast.assignExpr.get()))
+        return false;
+
+    bool isDead = false;
+
+    for (auto varIdent = ast.varIdent.get(); varIdent != nullptr; varIdent = varIdent->next.get())
+    {
+        for (const auto& arrayIndex : varIdent->arrayIndices)
+        {
+            if (HasSideEffects(arrayIndex.get()))
+                return false;
+        }
+
+        /* Assignment is dead if any of the accessed variables is never read */
+        if (IsDeadVar(varIdent->FetchVarDecl()))
+            isDead = true;
+    }
+
+    return isDead;
+}
+
+bool PositionOnlyConverter::IsDeadVar(VarDecl* varDecl) const
+{
+    if (!varDecl || readVars_.find(varDecl) != readVars_.end())
+        return false;
+
+    return
+    (
+        localVars_.find(varDecl) != localVars_.end() ||
+        deadOutputs_.find(varDecl) != deadOutputs_.end() ||
+        varDecl->flags(VarDecl::isShaderInput)
+    );
+}
+
+bool PositionOnlyConverter::HasSideEffects(Expr* expr)
+{
+    if (!expr)
+        return false;
+
+    SideEffectAnalyzer analyzer(nullptr, [this](FunctionDecl* funcDecl) { return IsPureFunction(funcDecl); });
+    return analyzer.HasSideEffects(expr);
+}
+
+bool PositionOnlyConverter::IsPureFunction(FunctionDecl* funcDecl)
+{
+    auto it = pureFuncs_.find(funcDecl);
+    if (it != pureFuncs_.end())
+        return it->second;
+
+    /* Mark function as impure while it is analyzed (recursive calls are not allowed anyway) */
+    pureFuncs_[funcDecl] = false;
+
+    if (!funcDecl->codeBlock)
+        return false;
+
+    /* Collect parameters and local variables of this function */
+    std::set<VarDecl*> localVars;
+
+    for (const auto& param : funcDecl->parameters)
+    {
+        for (const auto& varDecl : param->varDecls)
+            localVars.insert(varDecl.get());
+    }
+
+    LocalVarCollector localVarCollector(localVars);
+    localVarCollector.Collect(funcDecl->codeBlock.get());
+
+    /* Analyze function body for side effects */
+    SideEffectAnalyzer analyzer(&localVars, [this](FunctionDecl* funcDecl) { return IsPureFunction(funcDecl); });
+    auto isPure = !analyzer.HasSideEffects(funcDecl->codeBlock.get());
+
+    pureFuncs_[funcDecl] = isPure;
+
+    return isPure;
+}
+
+/* ------- Visit functions ------- */
+
+#define IMPLEMENT_VISIT_PROC(AST_NAME) \
+    void PositionOnlyConverter::Visit##AST_NAME(AST_NAME* ast, void* args)
+
+IMPLEMENT_VISIT_PROC(CodeBlock)
+{
+    RemoveDeadStmnts(ast->stmnts);
+    VISIT_DEFAULT(CodeBlock);
+}
+
+IMPLEMENT_VISIT_PROC(SwitchCase)
+{
+    RemoveDeadStmnts(ast->stmnts);
+    VISIT_DEFAULT(SwitchCase);
+}
+
+IMPLEMENT_VISIT_PROC(FunctionDecl)
+{
+    Visit(ast->codeBlock);
+}
+
+IMPLEMENT_VISIT_PROC(ForLoopStmnt)
+{
+    RemoveDeadStmnt(ast->bodyStmnt);
+    VISIT_DEFAULT(ForLoopStmnt);
+}
+
+IMPLEMENT_VISIT_PROC(WhileLoopStmnt)
+{
+    RemoveDeadStmnt(ast->bodyStmnt);
+    VISIT_DEFAULT(WhileLoopStmnt);
+}
+
+IMPLEMENT_VISIT_PROC(DoWhileLoopStmnt)
+{
+    RemoveDeadStmnt(ast->bodyStmnt);
+    VISIT_DEFAULT(DoWhileLoopStmnt);
+}
+
+IMPLEMENT_VISIT_PROC(IfStmnt)
+{
+    RemoveDeadStmnt(ast->bodyStmnt);
+    VISIT_DEFAULT(IfStmnt);
+}
+
+IMPLEMENT_VISIT_PROC(ElseStmnt)
+{
+    RemoveDeadStmnt(ast->bodyStmnt);
+    VISIT_DEFAULT(ElseStmnt);
+}
+
+#undef IMPLEMENT_VISIT_PROC
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
@@ -0,0 +1,95 @@
+/*
+ * PositionOnlyConverter.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_POSITION_ONLY_CONVERTER_H
+#define XSC_POSITION_ONLY_CONVERTER_H
+
+
+#include "Visitor.h"
+#include <vector>
+#include <set>
+#include <map>
+
+
+namespace Xsc
+{
+
+
+/*
+Position-only converter.
+This AST converter turns the entry point of a vertex (or tessellation-evaluation) shader into a variant
+whose only output is the position system value (e.g. for depth pre-passes and shadow maps).
+All other outputs are removed, and all statements that only contribute to the removed outputs are eliminated.
+The input semantics are reduced to the inputs that are still consumed by the variant.
+*/
+class PositionOnlyConverter : public Visitor
+{
+
+    public:
+
+        // Converts the entry point of the specified program into a position-only variant.
+        void Convert(Program& program);
+
+    private:
+
+        /* === Functions === */
+
+        void RemoveOutputSemantics(FunctionDecl& entryPoint);
+        void RemoveInputSemantics(FunctionDecl& entryPoint);
+
+        // Collects all local variables and all variables that are read within the reachable functions.
+        void CollectVars();
+
+        void RemoveDeadStmnts(std::vector<StmntPtr>& stmnts);
+        void RemoveDeadStmnt(StmntPtr& stmnt);
+
+        bool IsDeadStmnt(const Stmnt& ast);
+        bool IsDeadAssignment(const VarAccessExpr& ast);
+        bool IsDeadVar(VarDecl* varDecl) const;
+
+        // Returns true if the specified expression has side effects (i.e. it writes to variables or calls impure functions).
+        bool HasSideEffects(Expr* expr);
+
+        // Returns true if the specified function does not write to any non-local variable and only calls pure functions.
+        bool IsPureFunction(FunctionDecl* funcDecl);
+
+        /* ----- Visitor implementation ----- */
+
+        DECL_VISIT_PROC( CodeBlock         );
+        DECL_VISIT_PROC( SwitchCase        );
+
+        DECL_VISIT_PROC( FunctionDecl      );
+
+        DECL_VISIT_PROC( ForLoopStmnt      );
+        DECL_VISIT_PROC( WhileLoopStmnt    );
+        DECL_VISIT_PROC( DoWhileLoopStmnt  );
+        DECL_VISIT_PROC( IfStmnt           );
+        DECL_VISIT_PROC( ElseStmnt         );
+
+        /* === Members === */
+
+        std::vector<FunctionDecl*>      reachableFuncs_;
+
+        std::set<VarDecl*>              deadOutputs_;       // Entry point outputs that have been removed.
+        std::set<VarDecl*>              localVars_;         // Local variables of all reachable functions.
+        std::set<VarDecl*>              readVars_;          // Variables that are read at least once.
+
+        std::map<FunctionDecl*, bool>   pureFuncs_;         // Memoized results of 'IsPureFunction'.
+
+        bool                            stmntsRemoved_      = false;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
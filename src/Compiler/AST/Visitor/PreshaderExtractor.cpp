@@ -0,0 +1,651 @@
+/*
+ * PreshaderExtractor.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "PreshaderExtractor.h"
+#include "CallGraphCollector.h"
+#include "ASTFactory.h"
+#include "AST.h"
+#include "Helper.h"
+#include <algorithm>
+
+
+namespace Xsc
+{
+
+
+std::size_t PreshaderExtractor::ExtractPreshaders(
+    Program& program, const NameMangling& nameMangling, Reflection::ReflectionData* reflectionData)
+{
+    nameMangling_   = nameMangling;
+    reflectionData_ = reflectionData;
+
+    /* Collect all functions that are reachable from the entry points */
+    CallGraphCollector callGraph;
+    callGraph.CollectReachableFunctions(program.entryPointRef);
+    callGraph.CollectReachableFunctions(program.layoutTessControl.patchConstFunctionRef);
+    reachableFuncs_ = callGraph.GetReachableFunctions();
+
+    /* Extract uniform-only expressions from all reachable functions */
+    for (auto funcDecl : reachableFuncs_)
+        Visit(funcDecl);
+
+    /* Insert synthesized constant buffer into the program */
+    if (preshaderBuffer_)
+        InsertPreshaderBuffer(program);
+
+    return preshaderMembers_.size();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+// Returns the base data type of the specified expression, or DataType::Undefined if it has no base type.
+static DataType FetchExprDataType(Expr& expr)
+{
+    try
+    {
+        if (auto baseTypeDen = expr.GetTypeDenoter()->Get()->As<BaseTypeDenoter>())
+            return baseTypeDen->dataType;
+    }
+    catch (const std::exception&)
+    {
+        /* ignore this exception */
+    }
+    return DataType::Undefined;
+}
+
+// Returns true if the specified identifier is a chain of swizzle operators (e.g. "xyz.x").
+static bool IsSwizzleVarIdent(const VarIdent* varIdent)
+{
+    for (; varIdent != nullptr; varIdent = varIdent->next.get())
+    {
+        if (varIdent->symbolRef || !varIdent->arrayIndices.empty())
+            return false;
+    }
+    return true;
+}
+
+// Returns true if the specified intrinsic has no side effects and can be evaluated on the CPU.
+static bool IsPreshaderIntrinsic(const Intrinsic intrinsic)
+{
+    switch (intrinsic)
+    {
+        case Intrinsic::Abs:
+        case Intrinsic::ACos:
+        case Intrinsic::All:
+        case Intrinsic::Any:
+        case Intrinsic::ASin:
+        case Intrinsic::ATan:
+        case Intrinsic::ATan2:
+        case Intrinsic::Ceil:
+        case Intrinsic::Clamp:
+        case Intrinsic::Cos:
+        case Intrinsic::CosH:
+        case Intrinsic::Cross:
+        case Intrinsic::Degrees:
+        case Intrinsic::Determinant:
+        case Intrinsic::Distance:
+        case Intrinsic::Dot:
+        case Intrinsic::Exp:
+        case Intrinsic::Exp2:
+        case Intrinsic::Floor:
+        case Intrinsic::FMod:
+        case Intrinsic::Frac:
+        case Intrinsic::Length:
+        case Intrinsic::Lerp:
+        case Intrinsic::Log:
+        case Intrinsic::Log10:
+        case Intrinsic::Log2:
+        case Intrinsic::MAD:
+        case Intrinsic::Max:
+        case Intrinsic::Min:
+        case Intrinsic::Mul:
+        case Intrinsic::Normalize:
+        case Intrinsic::Pow:
+        case Intrinsic::Radians:
+        case Intrinsic::Rcp:
+        case Intrinsic::Reflect:
+        case Intrinsic::Round:
+        case Intrinsic::RSqrt:
+        case Intrinsic::Saturate:
+        case Intrinsic::Sign:
+        case Intrinsic::Sin:
+        case Intrinsic::SinH:
+        case Intrinsic::SmoothStep:
+        case Intrinsic::Sqrt:
+        case Intrinsic::Step:
+        case Intrinsic::Tan:
+        case Intrinsic::TanH:
+        case Intrinsic::Transpose:
+        case Intrinsic::Trunc:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void PreshaderExtractor::ExtractExpr(ExprPtr& expr)
+{
+    if (!expr)
+        return;
+
+    bool hasLoad = false, hasComputation = false;
+
+    if (IsUniformExpr(*expr, hasLoad, hasComputation) && hasLoad && hasComputation)
+    {
+        /* Store expression program, and replace expression by access to the preshader member */
+        std::vector<Reflection::PreshaderInstruction> instrs;
+        EmitInstructions(*expr, instrs);
+
+        auto varDecl = MakePreshaderMember(FetchExprDataType(*expr), std::move(instrs));
+
+        auto varAccessExpr = ASTFactory::MakeVarAccessExpr(varDecl->ident, varDecl);
+        varAccessExpr->area = expr->area;
+
+        expr = varAccessExpr;
+    }
+    else
+        Visit(expr);
+}
+
+bool PreshaderExtractor::IsUniformExpr(Expr& expr, bool& hasLoad, bool& hasComputation)
+{
+    /* Only consider expressions of scalar, vector, and matrix types */
+    auto dataType = FetchExprDataType(expr);
+    if (dataType == DataType::Undefined || dataType == DataType::String)
+        return false;
+
+    switch (expr.Type())
+    {
+        case AST::Types::LiteralExpr:
+        {
+            return true;
+        }
+
+        case AST::Types::VarAccessExpr:
+        {
+            auto& ast = static_cast<VarAccessExpr&>(expr);
+            hasLoad = true;
+            return (!ast.assignExpr && IsUniformVarIdent(*ast.varIdent));
+        }
+
+        case AST::Types::BracketExpr:
+        {
+            return IsUniformExpr(*static_cast<BracketExpr&>(expr).expr, hasLoad, hasComputation);
+        }
+
+        case AST::Types::CastExpr:
+        {
+            return IsUniformExpr(*static_cast<CastExpr&>(expr).expr, hasLoad, hasComputation);
+        }
+
+        case AST::Types::UnaryExpr:
+        {
+            auto& ast = static_cast<UnaryExpr&>(expr);
+            if (IsLValueOp(ast.op))
+                return false;
+            hasComputation = true;
+            return IsUniformExpr(*ast.expr, hasLoad, hasComputation);
+        }
+
+        case AST::Types::BinaryExpr:
+        {
+            auto& ast = static_cast<BinaryExpr&>(expr);
+            hasComputation = true;
+            return (IsUniformExpr(*ast.lhsExpr, hasLoad, hasComputation) && IsUniformExpr(*ast.rhsExpr, hasLoad, hasComputation));
+        }
+
+        case AST::Types::TernaryExpr:
+        {
+            auto& ast = static_cast<TernaryExpr&>(expr);
+            hasComputation = true;
+            return
+            (
+                IsUniformExpr(*ast.condExpr, hasLoad, hasComputation) &&
+                IsUniformExpr(*ast.thenExpr, hasLoad, hasComputation) &&
+                IsUniformExpr(*ast.elseExpr, hasLoad, hasComputation)
+            );
+        }
+
+        case AST::Types::SuffixExpr:
+        {
+            auto& ast = static_cast<SuffixExpr&>(expr);
+            return (IsSwizzleVarIdent(ast.varIdent.get()) && IsUniformExpr(*ast.expr, hasLoad, hasComputation));
+        }
+
+        case AST::Types::FunctionCallExpr:
+        {
+            auto& call = *static_cast<FunctionCallExpr&>(expr).call;
+
+            /* Only consider type constructors and intrinsics without side effects */
+            if (!call.typeDenoter)
+            {
+                if (!IsPreshaderIntrinsic(call.intrinsic))
+                    return false;
+                hasComputation = true;
+            }
+
+            for (const auto& arg : call.arguments)
+            {
+                if (!IsUniformExpr(*arg, hasLoad, hasComputation))
+                    return false;
+            }
+
+            return true;
+        }
+
+        default:
+        {
+            return false;
+        }
+    }
+}
+
+bool PreshaderExtractor::IsUniformVarIdent(VarIdent& varIdent)
+{
+    /* Only consider constant buffer members and global uniforms (no parameters) */
+    auto varDecl = varIdent.FetchVarDecl();
+    if (!varDecl || !varDecl->declStmntRef)
+        return false;
+
+    if (!varDecl->bufferDeclRef)
+    {
+        auto varDeclStmnt = varDecl->declStmntRef;
+        if (!varDeclStmnt->IsUniform() || varDeclStmnt->flags(VarDeclStmnt::isParameter))
+            return false;
+    }
+
+    /* Only consider constant array indices and trailing swizzle operators */
+    VarDecl* lastVarDecl = nullptr;
+
+    for (auto ident = &varIdent; ident != nullptr; ident = ident->next.get())
+    {
+        if (!ident->symbolRef)
+        {
+            if (!IsSwizzleVarIdent(ident))
+                return false;
+            break;
+        }
+
+        lastVarDecl = ident->FetchVarDecl();
+        if (!lastVarDecl || !lastVarDecl->declStmntRef || ident->arrayIndices.size() != lastVarDecl->arrayDims.size())
+            return false;
+
+        for (const auto& arrayIndex : ident->arrayIndices)
+        {
+            if (arrayIndex->Type() != AST::Types::LiteralExpr)
+                return false;
+        }
+    }
+
+    /* Loaded uniform must have a base type */
+    return (lastVarDecl->declStmntRef->typeSpecifier->GetTypeDenoter()->Get()->As<BaseTypeDenoter>() != nullptr);
+}
+
+void PreshaderExtractor::EmitInstructions(Expr& expr, std::vector<Reflection::PreshaderInstruction>& instrs)
+{
+    auto AddInstr = [&](const Reflection::PreshaderOpcode opcode, const std::string& value, unsigned int numOperands)
+    {
+        Reflection::PreshaderInstruction instr;
+        {
+            instr.opcode        = opcode;
+            instr.value         = value;
+            instr.numOperands   = numOperands;
+            instr.type          = DataTypeToString(FetchExprDataType(expr));
+        }
+        instrs.push_back(instr);
+    };
+
+    switch (expr.Type())
+    {
+        case AST::Types::LiteralExpr:
+        {
+            AddInstr(Reflection::PreshaderOpcode::Constant, static_cast<LiteralExpr&>(expr).value, 0);
+        }
+        break;
+
+        case AST::Types::VarAccessExpr:
+        {
+            EmitLoadInstructions(*static_cast<VarAccessExpr&>(expr).varIdent, instrs);
+        }
+        break;
+
+        case AST::Types::BracketExpr:
+        {
+            EmitInstructions(*static_cast<BracketExpr&>(expr).expr, instrs);
+        }
+        break;
+
+        case AST::Types::CastExpr:
+        {
+            EmitInstructions(*static_cast<CastExpr&>(expr).expr, instrs);
+            AddInstr(Reflection::PreshaderOpcode::Cast, DataTypeToString(FetchExprDataType(expr)), 1);
+        }
+        break;
+
+        case AST::Types::UnaryExpr:
+        {
+            auto& ast = static_cast<UnaryExpr&>(expr);
+            EmitInstructions(*ast.expr, instrs);
+            AddInstr(Reflection::PreshaderOpcode::Unary, UnaryOpToString(ast.op), 1);
+        }
+        break;
+
+        case AST::Types::BinaryExpr:
+        {
+            auto& ast = static_cast<BinaryExpr&>(expr);
+            EmitInstructions(*ast.lhsExpr, instrs);
+            EmitInstructions(*ast.rhsExpr, instrs);
+            AddInstr(Reflection::PreshaderOpcode::Binary, BinaryOpToString(ast.op), 2);
+        }
+        break;
+
+        case AST::Types::TernaryExpr:
+        {
+            auto& ast = static_cast<TernaryExpr&>(expr);
+            EmitInstructions(*ast.condExpr, instrs);
+            EmitInstructions(*ast.thenExpr, instrs);
+            EmitInstructions(*ast.elseExpr, instrs);
+            AddInstr(Reflection::PreshaderOpcode::Select, "?:", 3);
+        }
+        break;
+
+        case AST::Types::SuffixExpr:
+        {
+            auto& ast = static_cast<SuffixExpr&>(expr);
+            EmitInstructions(*ast.expr, instrs);
+            EmitSwizzleInstructions(ast.varIdent.get(), ast.expr->GetTypeDenoter()->Get(), instrs);
+        }
+        break;
+
+        case AST::Types::FunctionCallExpr:
+        {
+            auto& call = *static_cast<FunctionCallExpr&>(expr).call;
+
+            for (const auto& arg : call.arguments)
+                EmitInstructions(*arg, instrs);
+
+            const auto& ident = (call.typeDenoter ? call.typeDenoter->ToString() : call.varIdent->ident);
+            AddInstr(Reflection::PreshaderOpcode::Call, ident, static_cast<unsigned int>(call.arguments.size()));
+        }
+        break;
+
+        default:
+        break;
+    }
+}
+
+void PreshaderExtractor::EmitLoadInstructions(VarIdent& varIdent, std::vector<Reflection::PreshaderInstruction>& instrs)
+{
+    /* Build uniform identifier with all structure members and constant array indices (e.g. "Lights[2].Color") */
+    std::string ident;
+    VarDecl* lastVarDecl = nullptr;
+
+    auto varIdentIt = &varIdent;
+
+    for (; varIdentIt != nullptr && varIdentIt->symbolRef != nullptr; varIdentIt = varIdentIt->next.get())
+    {
+        if (!ident.empty())
+            ident += '.';
+        ident += varIdentIt->ident;
+
+        for (const auto& arrayIndex : varIdentIt->arrayIndices)
+            ident += '[' + static_cast<LiteralExpr&>(*arrayIndex).value + ']';
+
+        lastVarDecl = varIdentIt->FetchVarDecl();
+    }
+
+    auto typeDen = lastVarDecl->declStmntRef->typeSpecifier->GetTypeDenoter()->Get();
+
+    Reflection::PreshaderInstruction instr;
+    {
+        instr.opcode    = Reflection::PreshaderOpcode::Load;
+        instr.value     = ident;
+        instr.type      = typeDen->ToString();
+    }
+    instrs.push_back(instr);
+
+    /* Emit remaining swizzle operators */
+    EmitSwizzleInstructions(varIdentIt, typeDen, instrs);
+}
+
+void PreshaderExtractor::EmitSwizzleInstructions(
+    VarIdent* varIdent, TypeDenoterPtr typeDenoter, std::vector<Reflection::PreshaderInstruction>& instrs)
+{
+    for (; varIdent != nullptr; varIdent = varIdent->next.get())
+    {
+        typeDenoter = varIdent->GetTypeDenoterFromSubscript(*typeDenoter);
+
+        Reflection::PreshaderInstruction instr;
+        {
+            instr.opcode        = Reflection::PreshaderOpcode::Swizzle;
+            instr.value         = varIdent->ident;
+            instr.numOperands   = 1;
+            instr.type          = typeDenoter->ToString();
+        }
+        instrs.push_back(instr);
+    }
+}
+
+VarDecl* PreshaderExtractor::MakePreshaderMember(const DataType dataType, std::vector<Reflection::PreshaderInstruction>&& instrs)
+{
+    /* Re-use member for equal expression programs */
+    std::string program;
+
+    for (const auto& instr : instrs)
+    {
+        program += std::to_string(static_cast<int>(instr.opcode)) + ':' + instr.value + ':';
+        program += std::to_string(instr.numOperands) + ':' + instr.type + ';';
+    }
+
+    auto it = preshaderMembers_.find(program);
+    if (it != preshaderMembers_.end())
+        return it->second;
+
+    /* Make synthesized constant buffer */
+    if (!preshaderBuffer_)
+    {
+        preshaderBuffer_ = MakeShared<UniformBufferDecl>(SourcePosition::ignore);
+        preshaderBuffer_->bufferType    = UniformBufferType::ConstantBuffer;
+        preshaderBuffer_->ident         = nameMangling_.temporaryPrefix + "Preshader";
+        preshaderBuffer_->flags << AST::isReachable;
+    }
+
+    /* Make new member for this expression program */
+    auto ident = nameMangling_.temporaryPrefix + "preshader" + std::to_string(preshaderMembers_.size());
+
+    auto varDeclStmnt = ASTFactory::MakeVarDeclStmnt(dataType, ident);
+    auto varDecl = varDeclStmnt->varDecls.front().get();
+    varDecl->bufferDeclRef = preshaderBuffer_.get();
+
+    varDeclStmnt->flags << AST::isReachable;
+    varDecl->flags << AST::isReachable;
+
+    preshaderBuffer_->localStmnts.push_back(varDeclStmnt);
+    preshaderBuffer_->varMembers.push_back(varDeclStmnt);
+
+    preshaderMembers_[program] = varDecl;
+
+    if (reflectionData_)
+        reflectionData_->preshaders.push_back({ ident, DataTypeToString(dataType), std::move(instrs) });
+
+    return varDecl;
+}
+
+void PreshaderExtractor::InsertPreshaderBuffer(Program& program)
+{
+    /* Use next free constant buffer slot, if the other constant buffers have explicit slots */
+    int nextSlot = -1;
+
+    for (const auto& stmnt : program.globalStmnts)
+    {
+        if (auto uniformBufferDecl = stmnt->As<UniformBufferDecl>())
+        {
+            for (const auto& slotRegister : uniformBufferDecl->slotRegisters)
+            {
+                if (slotRegister->registerType == RegisterType::ConstantBuffer)
+                    nextSlot = std::max(nextSlot, slotRegister->slot + 1);
+            }
+        }
+    }
+
+    if (nextSlot >= 0)
+    {
+        auto slotRegister = MakeShared<Register>(SourcePosition::ignore);
+        {
+            slotRegister->registerType  = RegisterType::ConstantBuffer;
+            slotRegister->slot          = nextSlot;
+        }
+        preshaderBuffer_->slotRegisters.push_back(slotRegister);
+    }
+
+    /* Insert constant buffer in front of all other global statements */
+    program.globalStmnts.insert(program.globalStmnts.begin(), preshaderBuffer_);
+
+    if (reflectionData_)
+        reflectionData_->preshaderBuffer = preshaderBuffer_->ident;
+}
+
+/* ------- Visit functions ------- */
+
+#define IMPLEMENT_VISIT_PROC(AST_NAME) \
+    void PreshaderExtractor::Visit##AST_NAME(AST_NAME* ast, void* args)
+
+IMPLEMENT_VISIT_PROC(FunctionCall)
+{
+    for (auto& arg : ast->arguments)
+        ExtractExpr(arg);
+}
+
+IMPLEMENT_VISIT_PROC(VarIdent)
+{
+    for (auto& arrayIndex : ast->arrayIndices)
+        ExtractExpr(arrayIndex);
+    Visit(ast->next);
+}
+
+IMPLEMENT_VISIT_PROC(VarDecl)
+{
+    ExtractExpr(ast->initializer);
+}
+
+IMPLEMENT_VISIT_PROC(FunctionDecl)
+{
+    Visit(ast->codeBlock);
+}
+
+IMPLEMENT_VISIT_PROC(ForLoopStmnt)
+{
+    Visit(ast->initStmnt);
+    ExtractExpr(ast->condition);
+    ExtractExpr(ast->iteration);
+    Visit(ast->bodyStmnt);
+}
+
+IMPLEMENT_VISIT_PROC(WhileLoopStmnt)
+{
+    ExtractExpr(ast->condition);
+    Visit(ast->bodyStmnt);
+}
+
+IMPLEMENT_VISIT_PROC(DoWhileLoopStmnt)
+{
+    Visit(ast->bodyStmnt);
+    ExtractExpr(ast->condition);
+}
+
+IMPLEMENT_VISIT_PROC(IfStmnt)
+{
+    ExtractExpr(ast->condition);
+    Visit(ast->bodyStmnt);
+    Visit(ast->elseStmnt);
+}
+
+IMPLEMENT_VISIT_PROC(SwitchStmnt)
+{
+    ExtractExpr(ast->selector);
+    Visit(ast->cases);
+}
+
+IMPLEMENT_VISIT_PROC(ExprStmnt)
+{
+    ExtractExpr(ast->expr);
+}
+
+IMPLEMENT_VISIT_PROC(ReturnStmnt)
+{
+    ExtractExpr(ast->expr);
+}
+
+IMPLEMENT_VISIT_PROC(ListExpr)
+{
+    ExtractExpr(ast->firstExpr);
+    ExtractExpr(ast->nextExpr);
+}
+
+IMPLEMENT_VISIT_PROC(TernaryExpr)
+{
+    ExtractExpr(ast->condExpr);
+    ExtractExpr(ast->thenExpr);
+    ExtractExpr(ast->elseExpr);
+}
+
+IMPLEMENT_VISIT_PROC(BinaryExpr)
+{
+    ExtractExpr(ast->lhsExpr);
+    ExtractExpr(ast->rhsExpr);
+}
+
+IMPLEMENT_VISIT_PROC(UnaryExpr)
+{
+    ExtractExpr(ast->expr);
+}
+
+IMPLEMENT_VISIT_PROC(BracketExpr)
+{
+    ExtractExpr(ast->expr);
+}
+
+IMPLEMENT_VISIT_PROC(SuffixExpr)
+{
+    ExtractExpr(ast->expr);
+}
+
+IMPLEMENT_VISIT_PROC(ArrayAccessExpr)
+{
+    ExtractExpr(ast->expr);
+    for (auto& arrayIndex : ast->arrayIndices)
+        ExtractExpr(arrayIndex);
+}
+
+IMPLEMENT_VISIT_PROC(CastExpr)
+{
+    ExtractExpr(ast->expr);
+}
+
+IMPLEMENT_VISIT_PROC(VarAccessExpr)
+{
+    Visit(ast->varIdent);
+    ExtractExpr(ast->assignExpr);
+}
+
+IMPLEMENT_VISIT_PROC(InitializerExpr)
+{
+    for (auto& subExpr : ast->exprs)
+        ExtractExpr(subExpr);
+}
+
+#undef IMPLEMENT_VISIT_PROC
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
@@ -0,0 +1,109 @@
+/*
+ * PreshaderExtractor.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_PRESHADER_EXTRACTOR_H
+#define XSC_PRESHADER_EXTRACTOR_H
+
+
+#include "Visitor.h"
+#include "TypeDenoter.h"
+#include <Xsc/Xsc.h>
+#include <vector>
+#include <map>
+#include <set>
+
+
+namespace Xsc
+{
+
+
+/*
+Preshader extractor.
+This AST modifier replaces all maximal sub expressions, which only depend on uniforms and literals,
+by members of a synthesized constant buffer, and stores the removed computations as preshader expressions.
+Only functions that are reachable from the entry points are considered.
+*/
+class PreshaderExtractor : private Visitor
+{
+
+    public:
+
+        // Extracts all uniform-only expressions of the specified program, and returns the number of extracted preshader expressions.
+        std::size_t ExtractPreshaders(
+            Program&                        program,
+            const NameMangling&             nameMangling,
+            Reflection::ReflectionData*     reflectionData
+        );
+
+    private:
+
+        /* === Functions === */
+
+        // Replaces the specified expression by a preshader member if it is a uniform-only expression, or visits its sub expressions otherwise.
+        void ExtractExpr(ExprPtr& expr);
+
+        // Returns true if the specified expression only depends on uniforms and literals, and sets 'hasLoad' and 'hasComputation' if it contains a uniform or an operation.
+        bool IsUniformExpr(Expr& expr, bool& hasLoad, bool& hasComputation);
+        bool IsUniformVarIdent(VarIdent& varIdent);
+
+        void EmitInstructions(Expr& expr, std::vector<Reflection::PreshaderInstruction>& instrs);
+        void EmitLoadInstructions(VarIdent& varIdent, std::vector<Reflection::PreshaderInstruction>& instrs);
+        void EmitSwizzleInstructions(VarIdent* varIdent, TypeDenoterPtr typeDenoter, std::vector<Reflection::PreshaderInstruction>& instrs);
+
+        VarDecl* MakePreshaderMember(const DataType dataType, std::vector<Reflection::PreshaderInstruction>&& instrs);
+
+        void InsertPreshaderBuffer(Program& program);
+
+        /* ----- Visitor implementation ----- */
+
+        DECL_VISIT_PROC( FunctionCall      );
+        DECL_VISIT_PROC( VarIdent          );
+
+        DECL_VISIT_PROC( VarDecl           );
+
+        DECL_VISIT_PROC( FunctionDecl      );
+
+        DECL_VISIT_PROC( ForLoopStmnt      );
+        DECL_VISIT_PROC( WhileLoopStmnt    );
+        DECL_VISIT_PROC( DoWhileLoopStmnt  );
+        DECL_VISIT_PROC( IfStmnt           );
+        DECL_VISIT_PROC( SwitchStmnt       );
+        DECL_VISIT_PROC( ExprStmnt         );
+        DECL_VISIT_PROC( ReturnStmnt       );
+
+        DECL_VISIT_PROC( ListExpr          );
+        DECL_VISIT_PROC( TernaryExpr       );
+        DECL_VISIT_PROC( BinaryExpr        );
+        DECL_VISIT_PROC( UnaryExpr         );
+        DECL_VISIT_PROC( BracketExpr       );
+        DECL_VISIT_PROC( SuffixExpr        );
+        DECL_VISIT_PROC( ArrayAccessExpr   );
+        DECL_VISIT_PROC( CastExpr          );
+        DECL_VISIT_PROC( VarAccessExpr     );
+        DECL_VISIT_PROC( InitializerExpr   );
+
+        /* === Members === */
+
+        NameMangling                                nameMangling_;
+        Reflection::ReflectionData*                 reflectionData_     = nullptr;
+
+        std::vector<FunctionDecl*>                  reachableFuncs_;
+
+        UniformBufferDeclPtr                        preshaderBuffer_;
+        std::map<std::string, VarDecl*>             preshaderMembers_;  // Preshader members by their serialized expression program.
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
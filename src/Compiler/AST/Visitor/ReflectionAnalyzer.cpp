@@ -27,6 +27,9 @@ void ReflectionAnalyzer::Reflect(Program& program, const ShaderTarget shaderTarg
     program_        = (&program);
     data_           = (&reflectionData);
 
+    /* Analyze resource accesses before the buffer declarations are reflected */
+    resourceAccessAnalyzer_.Analyze(program);
+
     Visit(program_);
 }
 
@@ -158,6 +161,15 @@ IMPLEMENT_VISIT_PROC(BufferDeclStmnt)
                     data_->textures.push_back(bindingSlot);
                 else
                     data_->storageBuffers.push_back(bindingSlot);
+
+                /* Reflect resource access */
+                Reflection::ResourceAccess resourceAccess;
+                {
+                    if (auto access = resourceAccessAnalyzer_.FetchAccess(bufferDecl.get()))
+                        resourceAccess = *access;
+                    resourceAccess.ident = bufferDecl->ident;
+                }
+                data_->resourceAccesses.push_back(resourceAccess);
             }
         }
     }
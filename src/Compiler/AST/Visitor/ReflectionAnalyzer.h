@@ -12,6 +12,7 @@
 #include <Xsc/Reflection.h>
 #include <Xsc/Targets.h>
 #include "ReportHandler.h"
+#include "ResourceAccessAnalyzer.h"
 #include "Visitor.h"
 #include "Token.h"
 #include "Variant.h"
@@ -74,6 +75,8 @@ class ReflectionAnalyzer : private Visitor
 
         Reflection::ReflectionData* data_           = nullptr;
 
+        ResourceAccessAnalyzer      resourceAccessAnalyzer_;
+
 };
 
 
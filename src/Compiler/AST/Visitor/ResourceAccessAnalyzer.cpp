@@ -0,0 +1,585 @@
+/*
+ * ResourceAccessAnalyzer.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ResourceAccessAnalyzer.h"
+#include "AST.h"
+
+
+namespace Xsc
+{
+
+
+/*
+ * Internal helper classes
+ */
+
+// Determines whether an expression may have different values between shader invocations.
+class NonUniformExprFinder : public Visitor
+{
+
+    public:
+
+        using UniformVarPredicate = std::function<bool(VarDecl* varDecl)>;
+
+        NonUniformExprFinder(const UniformVarPredicate& isUniformVar) :
+            isUniformVar_ { isUniformVar }
+        {
+        }
+
+        bool IsUniform(Expr* expr)
+        {
+            isUniform_ = true;
+            Visit(expr);
+            return isUniform_;
+        }
+
+    private:
+
+        void VisitFunctionCall(FunctionCall* ast, void* args) override
+        {
+            /* Results of user functions are conservatively considered to be non-uniform */
+            if (ast->GetFunctionImpl() != nullptr)
+                isUniform_ = false;
+            VISIT_DEFAULT(FunctionCall);
+        }
+
+        void VisitVarIdent(VarIdent* ast, void* args) override
+        {
+            /* Only the root identifier determines the variable, all subsequent identifiers are members or subscripts */
+            if (auto symbol = ast->symbolRef)
+            {
+                if (auto varDecl = symbol->As<VarDecl>())
+                {
+                    if (!isUniformVar_(varDecl))
+                        isUniform_ = false;
+                }
+                else if (symbol->Type() == AST::Types::BufferDecl)
+                {
+                    /* Contents of textures and storage buffers are non-uniform */
+                    isUniform_ = false;
+                }
+            }
+
+            for (auto varIdent = ast; varIdent != nullptr; varIdent = varIdent->next.get())
+                Visit(varIdent->arrayIndices);
+        }
+
+        UniformVarPredicate isUniformVar_;
+        bool                isUniform_      = true;
+
+};
+
+// Returns true if the specified intrinsic is an atomic operation on its first argument.
+static bool IsAtomicIntrinsic(const Intrinsic intrinsic)
+{
+    switch (intrinsic)
+    {
+        case Intrinsic::InterlockedAdd:
+        case Intrinsic::InterlockedAnd:
+        case Intrinsic::InterlockedCompareExchange:
+        case Intrinsic::InterlockedCompareStore:
+        case Intrinsic::InterlockedExchange:
+        case Intrinsic::InterlockedMax:
+        case Intrinsic::InterlockedMin:
+        case Intrinsic::InterlockedOr:
+        case Intrinsic::InterlockedXor:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Returns true if the specified intrinsic only queries the properties of a texture, but not its contents.
+static bool IsTextureQueryIntrinsic(const Intrinsic intrinsic)
+{
+    return (intrinsic == Intrinsic::Texture_GetDimensions);
+}
+
+// Returns the texture or storage buffer the specified identifier refers to, or null if there is no such buffer.
+static const BufferDecl* FetchBufferDecl(const VarIdent* varIdent)
+{
+    return (varIdent != nullptr ? varIdent->FetchSymbol<BufferDecl>() : nullptr);
+}
+
+
+/*
+ * ResourceAccessAnalyzer class
+ */
+
+void ResourceAccessAnalyzer::Analyze(Program& program)
+{
+    auto entryPoint = program.entryPointRef;
+    if (!entryPoint)
+        return;
+
+    /* Repeat analysis until no more variables are found to be non-uniform */
+    std::size_t numNonUniformVars = 0;
+
+    do
+    {
+        numNonUniformVars = nonUniformVars_.size();
+        visitedFuncs_.clear();
+        AnalyzeFunction(entryPoint);
+    }
+    while (nonUniformVars_.size() > numNonUniformVars);
+}
+
+const Reflection::ResourceAccess* ResourceAccessAnalyzer::FetchAccess(const BufferDecl* bufferDecl) const
+{
+    auto it = accesses_.find(bufferDecl);
+    return (it != accesses_.end() ? &(it->second) : nullptr);
+}
+
+bool ResourceAccessAnalyzer::IsUniformlyIndexed(const BufferDecl* bufferDecl) const
+{
+    return (nonUniformIndexedBuffers_.find(bufferDecl) == nonUniformIndexedBuffers_.end());
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void ResourceAccessAnalyzer::AnalyzeFunction(FunctionDecl* funcDecl)
+{
+    /* Don't use forward declarations */
+    if (funcDecl->funcImplRef)
+        funcDecl = funcDecl->funcImplRef;
+
+    if (!funcDecl->codeBlock || !visitedFuncs_.insert({ funcDecl, divergent_ }).second)
+        return;
+
+    /* Divergent return statements only affect the remaining function body */
+    auto divergent          = divergent_;
+    auto divergentReturn    = divergentReturn_;
+    auto divergentBreak     = divergentBreak_;
+
+    divergentReturn_    = false;
+    divergentBreak_     = false;
+
+    Visit(funcDecl->codeBlock);
+
+    divergent_          = divergent;
+    divergentReturn_    = divergentReturn;
+    divergentBreak_     = divergentBreak;
+}
+
+void ResourceAccessAnalyzer::AnalyzeStmntList(const std::vector<StmntPtr>& stmnts)
+{
+    auto divergent = divergent_;
+
+    for (const auto& stmnt : stmnts)
+    {
+        Visit(stmnt);
+
+        /* All statements after a divergent jump are executed in divergent control flow */
+        if (divergentReturn_ || divergentBreak_)
+            divergent_ = true;
+    }
+
+    divergent_ = divergent;
+}
+
+void ResourceAccessAnalyzer::AnalyzeLoop(Expr* condition, const std::function<void()>& visitLoop)
+{
+    auto divergent      = divergent_;
+    auto divergentBreak = divergentBreak_;
+
+    divergentBreak_ = false;
+
+    AnalyzeConditional(condition, visitLoop);
+
+    /* Loop iterations diverge if any invocation may leave the loop early */
+    if (!divergent_ && (divergentBreak_ || divergentReturn_) && (condition == nullptr || IsUniformExpr(condition)))
+    {
+        divergent_ = true;
+        visitLoop();
+    }
+
+    divergent_      = divergent;
+    divergentBreak_ = divergentBreak;
+}
+
+void ResourceAccessAnalyzer::AnalyzeConditional(Expr* condition, const std::function<void()>& visitBody)
+{
+    auto divergent = divergent_;
+
+    if (condition != nullptr && !IsUniformExpr(condition))
+        divergent_ = true;
+
+    visitBody();
+
+    divergent_ = divergent;
+}
+
+void ResourceAccessAnalyzer::AnalyzeWithAccessMode(const AccessMode accessMode, const std::function<void()>& visitAccess)
+{
+    auto prevAccessMode = accessMode_;
+    accessMode_ = accessMode;
+    {
+        visitAccess();
+    }
+    accessMode_ = prevAccessMode;
+}
+
+void ResourceAccessAnalyzer::RecordAccess(const BufferDecl* bufferDecl, const AccessMode accessMode)
+{
+    if (accessMode == AccessMode::None)
+        return;
+
+    auto& access = accesses_[bufferDecl];
+
+    switch (accessMode)
+    {
+        case AccessMode::Read:
+            access.read = true;
+            break;
+        case AccessMode::Write:
+            access.written = true;
+            break;
+        case AccessMode::ReadWrite:
+            access.read = true;
+            access.written = true;
+            break;
+        case AccessMode::Atomic:
+            access.atomic = true;
+            break;
+        default:
+            break;
+    }
+
+    if (divergent_)
+        access.divergent = true;
+}
+
+void ResourceAccessAnalyzer::RecordAssignment(VarIdent* varIdent, Expr* valueExpr)
+{
+    if (auto varDecl = varIdent->FetchVarDecl())
+    {
+        bool isUniform = (!divergent_ && valueExpr != nullptr && IsUniformExpr(valueExpr));
+
+        /* Array indices determine which element is assigned */
+        for (auto ident = varIdent; isUniform && ident != nullptr; ident = ident->next.get())
+        {
+            for (const auto& arrayIndex : ident->arrayIndices)
+            {
+                if (!IsUniformExpr(arrayIndex.get()))
+                    isUniform = false;
+            }
+        }
+
+        if (!isUniform)
+            nonUniformVars_.insert(varDecl);
+    }
+}
+
+bool ResourceAccessAnalyzer::IsUniformExpr(Expr* expr) const
+{
+    NonUniformExprFinder finder([this](VarDecl* varDecl) { return IsUniformVar(varDecl); });
+    return finder.IsUniform(expr);
+}
+
+bool ResourceAccessAnalyzer::IsUniformVar(VarDecl* varDecl) const
+{
+    /* Shader inputs are non-uniform */
+    if (varDecl->flags(VarDecl::isShaderInput) || varDecl->flags(VarDecl::isSystemValue))
+        return false;
+
+    /* Parameters are conservatively considered to be non-uniform */
+    if (varDecl->declStmntRef && varDecl->declStmntRef->flags(VarDeclStmnt::isParameter))
+        return false;
+
+    return (nonUniformVars_.find(varDecl) == nonUniformVars_.end());
+}
+
+/* ------- Visit functions ------- */
+
+#define IMPLEMENT_VISIT_PROC(AST_NAME) \
+    void ResourceAccessAnalyzer::Visit##AST_NAME(AST_NAME* ast, void* args)
+
+IMPLEMENT_VISIT_PROC(CodeBlock)
+{
+    AnalyzeStmntList(ast->stmnts);
+}
+
+IMPLEMENT_VISIT_PROC(FunctionCall)
+{
+    auto& arguments = ast->arguments;
+
+    if (IsAtomicIntrinsic(ast->intrinsic) && !arguments.empty())
+    {
+        /* First argument is accessed atomically */
+        AnalyzeWithAccessMode(AccessMode::Atomic, [&]() { Visit(arguments.front()); });
+        for (std::size_t i = 1; i < arguments.size(); ++i)
+            Visit(arguments[i]);
+    }
+    else if (ast->intrinsic == Intrinsic::Image_Store && !arguments.empty())
+    {
+        /* First argument is the image that is written */
+        AnalyzeWithAccessMode(AccessMode::Write, [&]() { Visit(arguments.front()); });
+        for (std::size_t i = 1; i < arguments.size(); ++i)
+            Visit(arguments[i]);
+    }
+    else if (IsTextureQueryIntrinsic(ast->intrinsic))
+    {
+        /* Texture queries don't access the texture contents */
+        AnalyzeWithAccessMode(AccessMode::None, [&]() { Visit(ast->varIdent); });
+        for (auto& arg : arguments)
+        {
+            if (FetchBufferDecl(arg->FetchVarIdent()) != nullptr)
+                AnalyzeWithAccessMode(AccessMode::None, [&]() { Visit(arg); });
+            else
+                Visit(arg);
+        }
+    }
+    else if (auto funcDecl = ast->GetFunctionImpl())
+    {
+        /* Read/write resources that are passed to a user function are conservatively considered to be read and written */
+        Visit(ast->varIdent);
+        for (auto& arg : arguments)
+        {
+            auto bufferDecl = FetchBufferDecl(arg->FetchVarIdent());
+            if (bufferDecl != nullptr && IsRWBufferType(bufferDecl->GetBufferType()))
+                AnalyzeWithAccessMode(AccessMode::ReadWrite, [&]() { Visit(arg); });
+            else
+                Visit(arg);
+        }
+
+        AnalyzeFunction(funcDecl);
+    }
+    else
+        VISIT_DEFAULT(FunctionCall);
+
+    /* Output arguments receive non-uniform values from user functions and from intrinsics with non-uniform arguments */
+    ast->ForEachOutputArgument(
+        [&](ExprPtr& arg)
+        {
+            if (auto varIdent = arg->FetchVarIdent())
+            {
+                if (ast->GetFunctionImpl() != nullptr)
+                    RecordAssignment(varIdent, nullptr);
+                else
+                {
+                    for (auto& inputArg : arguments)
+                    {
+                        if (inputArg != arg)
+                            RecordAssignment(varIdent, inputArg.get());
+                    }
+                }
+            }
+        }
+    );
+
+    /* Clipped invocations leave the shader */
+    if (ast->intrinsic == Intrinsic::Clip && !arguments.empty() && (divergent_ || !IsUniformExpr(arguments.front().get())))
+        divergentReturn_ = true;
+}
+
+IMPLEMENT_VISIT_PROC(SwitchCase)
+{
+    Visit(ast->expr);
+    AnalyzeStmntList(ast->stmnts);
+}
+
+IMPLEMENT_VISIT_PROC(VarIdent)
+{
+    if (auto bufferDecl = FetchBufferDecl(ast))
+    {
+        RecordAccess(bufferDecl, accessMode_);
+
+        /* Buffers without subscript (e.g. in queries or as arguments) are not uniformly indexed */
+        bool isUniformlyIndexed = !ast->arrayIndices.empty();
+        for (const auto& arrayIndex : ast->arrayIndices)
+        {
+            if (!IsUniformExpr(arrayIndex.get()))
+                isUniformlyIndexed = false;
+        }
+
+        if (!isUniformlyIndexed)
+            nonUniformIndexedBuffers_.insert(bufferDecl);
+    }
+
+    /* Array indices are always read */
+    AnalyzeWithAccessMode(
+        AccessMode::Read,
+        [&]()
+        {
+            Visit(ast->arrayIndices);
+            Visit(ast->next);
+        }
+    );
+}
+
+/* --- Declaration statements --- */
+
+IMPLEMENT_VISIT_PROC(VarDeclStmnt)
+{
+    for (auto& varDecl : ast->varDecls)
+    {
+        Visit(varDecl->initializer);
+
+        if (divergent_ || (varDecl->initializer && !IsUniformExpr(varDecl->initializer.get())))
+            nonUniformVars_.insert(varDecl.get());
+    }
+}
+
+/* --- Statements --- */
+
+IMPLEMENT_VISIT_PROC(ForLoopStmnt)
+{
+    Visit(ast->initStmnt);
+    AnalyzeLoop(
+        ast->condition.get(),
+        [&]()
+        {
+            Visit(ast->condition);
+            Visit(ast->bodyStmnt);
+            Visit(ast->iteration);
+        }
+    );
+}
+
+IMPLEMENT_VISIT_PROC(WhileLoopStmnt)
+{
+    AnalyzeLoop(
+        ast->condition.get(),
+        [&]()
+        {
+            Visit(ast->condition);
+            Visit(ast->bodyStmnt);
+        }
+    );
+}
+
+IMPLEMENT_VISIT_PROC(DoWhileLoopStmnt)
+{
+    AnalyzeLoop(
+        ast->condition.get(),
+        [&]()
+        {
+            Visit(ast->bodyStmnt);
+            Visit(ast->condition);
+        }
+    );
+}
+
+IMPLEMENT_VISIT_PROC(IfStmnt)
+{
+    Visit(ast->condition);
+    AnalyzeConditional(
+        ast->condition.get(),
+        [&]()
+        {
+            Visit(ast->bodyStmnt);
+            Visit(ast->elseStmnt);
+        }
+    );
+}
+
+IMPLEMENT_VISIT_PROC(SwitchStmnt)
+{
+    Visit(ast->selector);
+
+    /* 'break' statements only leave the switch statement */
+    auto divergentBreak = divergentBreak_;
+
+    AnalyzeConditional(ast->selector.get(), [&]() { Visit(ast->cases); });
+
+    divergentBreak_ = divergentBreak;
+}
+
+IMPLEMENT_VISIT_PROC(ReturnStmnt)
+{
+    Visit(ast->expr);
+    if (divergent_)
+        divergentReturn_ = true;
+}
+
+IMPLEMENT_VISIT_PROC(CtrlTransferStmnt)
+{
+    if (divergent_)
+    {
+        if (ast->transfer == CtrlTransfer::Discard)
+            divergentReturn_ = true;
+        else
+            divergentBreak_ = true;
+    }
+}
+
+/* --- Expressions --- */
+
+IMPLEMENT_VISIT_PROC(TernaryExpr)
+{
+    Visit(ast->condExpr);
+    AnalyzeConditional(
+        ast->condExpr.get(),
+        [&]()
+        {
+            Visit(ast->thenExpr);
+            Visit(ast->elseExpr);
+        }
+    );
+}
+
+IMPLEMENT_VISIT_PROC(BinaryExpr)
+{
+    Visit(ast->lhsExpr);
+
+    /* Right hand side of logical operators is only evaluated conditionally */
+    if (ast->op == BinaryOp::LogicalAnd || ast->op == BinaryOp::LogicalOr)
+        AnalyzeConditional(ast->lhsExpr.get(), [&]() { Visit(ast->rhsExpr); });
+    else
+        Visit(ast->rhsExpr);
+}
+
+IMPLEMENT_VISIT_PROC(UnaryExpr)
+{
+    if (IsLValueOp(ast->op))
+    {
+        AnalyzeWithAccessMode(AccessMode::ReadWrite, [&]() { Visit(ast->expr); });
+        if (auto varIdent = ast->expr->FetchVarIdent())
+            RecordAssignment(varIdent, ast->expr.get());
+    }
+    else
+        Visit(ast->expr);
+}
+
+IMPLEMENT_VISIT_PROC(PostUnaryExpr)
+{
+    if (IsLValueOp(ast->op))
+    {
+        AnalyzeWithAccessMode(AccessMode::ReadWrite, [&]() { Visit(ast->expr); });
+        if (auto varIdent = ast->expr->FetchVarIdent())
+            RecordAssignment(varIdent, ast->expr.get());
+    }
+    else
+        Visit(ast->expr);
+}
+
+IMPLEMENT_VISIT_PROC(VarAccessExpr)
+{
+    if (ast->assignExpr)
+    {
+        /* Compound assignments also read the assigned variable */
+        const auto accessMode = (ast->assignOp == AssignOp::Set ? AccessMode::Write : AccessMode::ReadWrite);
+        AnalyzeWithAccessMode(accessMode, [&]() { Visit(ast->varIdent); });
+
+        Visit(ast->assignExpr);
+        RecordAssignment(ast->varIdent.get(), ast->assignExpr.get());
+    }
+    else
+        Visit(ast->varIdent);
+}
+
+#undef IMPLEMENT_VISIT_PROC
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
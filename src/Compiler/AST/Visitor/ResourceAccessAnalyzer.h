@@ -0,0 +1,118 @@
+/*
+ * ResourceAccessAnalyzer.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_RESOURCE_ACCESS_ANALYZER_H
+#define XSC_RESOURCE_ACCESS_ANALYZER_H
+
+
+#include <Xsc/Reflection.h>
+#include "Visitor.h"
+#include <functional>
+#include <utility>
+#include <map>
+#include <set>
+
+
+namespace Xsc
+{
+
+
+/*
+Resource access analyzer.
+This class determines how all textures and storage buffers are accessed by the code that is reachable from the entry point
+(i.e. read, written, or with atomic operations), and whether any of these accesses happens in divergent control flow.
+A condition is considered to be uniform, if it only depends on uniforms, literals, and variables that are only assigned with uniform values in uniform control flow.
+*/
+class ResourceAccessAnalyzer : private Visitor
+{
+
+    public:
+
+        // Analyzes all resource accesses of the entry point of the specified program.
+        void Analyze(Program& program);
+
+        // Returns the access of the specified texture or storage buffer, or null if the resource is never accessed.
+        const Reflection::ResourceAccess* FetchAccess(const BufferDecl* bufferDecl) const;
+
+        // Returns true if the specified storage buffer is only accessed with uniform subscripts (e.g. "Buf[i]"), i.e. it is never queried or passed as a whole.
+        bool IsUniformlyIndexed(const BufferDecl* bufferDecl) const;
+
+    private:
+
+        enum class AccessMode
+        {
+            None,
+            Read,
+            Write,
+            ReadWrite,
+            Atomic,
+        };
+
+        /* === Functions === */
+
+        void AnalyzeFunction(FunctionDecl* funcDecl);
+        void AnalyzeStmntList(const std::vector<StmntPtr>& stmnts);
+        void AnalyzeLoop(Expr* condition, const std::function<void()>& visitLoop);
+        void AnalyzeConditional(Expr* condition, const std::function<void()>& visitBody);
+        void AnalyzeWithAccessMode(const AccessMode accessMode, const std::function<void()>& visitAccess);
+
+        void RecordAccess(const BufferDecl* bufferDecl, const AccessMode accessMode);
+
+        // Marks the root variable of the specified identifier as non-uniform, if the assigned value or the control flow is non-uniform.
+        void RecordAssignment(VarIdent* varIdent, Expr* valueExpr);
+
+        bool IsUniformExpr(Expr* expr) const;
+        bool IsUniformVar(VarDecl* varDecl) const;
+
+        /* ----- Visitor implementation ----- */
+
+        DECL_VISIT_PROC( CodeBlock         );
+        DECL_VISIT_PROC( FunctionCall      );
+        DECL_VISIT_PROC( SwitchCase        );
+        DECL_VISIT_PROC( VarIdent          );
+
+        DECL_VISIT_PROC( VarDeclStmnt      );
+
+        DECL_VISIT_PROC( ForLoopStmnt      );
+        DECL_VISIT_PROC( WhileLoopStmnt    );
+        DECL_VISIT_PROC( DoWhileLoopStmnt  );
+        DECL_VISIT_PROC( IfStmnt           );
+        DECL_VISIT_PROC( SwitchStmnt       );
+        DECL_VISIT_PROC( ReturnStmnt       );
+        DECL_VISIT_PROC( CtrlTransferStmnt );
+
+        DECL_VISIT_PROC( TernaryExpr       );
+        DECL_VISIT_PROC( BinaryExpr        );
+        DECL_VISIT_PROC( UnaryExpr         );
+        DECL_VISIT_PROC( PostUnaryExpr     );
+        DECL_VISIT_PROC( VarAccessExpr     );
+
+        /* === Members === */
+
+        std::map<const BufferDecl*, Reflection::ResourceAccess> accesses_;
+
+        std::set<VarDecl*>                          nonUniformVars_;
+        std::set<const BufferDecl*>                 nonUniformIndexedBuffers_;
+        std::set<std::pair<FunctionDecl*, bool>>    visitedFuncs_;      // Functions that have already been analyzed in uniform or divergent control flow.
+
+        AccessMode                                  accessMode_         = AccessMode::Read;
+
+        bool                                        divergent_          = false;    // Current control flow is divergent.
+        bool                                        divergentReturn_    = false;    // Divergent 'return' or 'discard' statement within the current function.
+        bool                                        divergentBreak_     = false;    // Divergent 'break' or 'continue' statement within the current loop or switch.
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -9,6 +9,7 @@
 #define XSC_VISITOR_H
 
 
+#include "SmallVector.h"
 #include <memory>
 #include <vector>
 #include <stack>
@@ -84,6 +85,9 @@ DECL_PTR( InitializerExpr   );
 
 #undef DECL_PTR
 
+// List of expression AST nodes (e.g. function arguments and array indices), with inline storage for a single element to keep the AST nodes small.
+using ExprList = SmallVector<ExprPtr, 1>;
+
 // Visitor interface
 
 #define VISITOR_VISIT_PROC(CLASS_NAME) \
@@ -172,6 +176,13 @@ class Visitor
                 Visit(ast, args);
         }
 
+        template <typename T, std::size_t N>
+        void Visit(const SmallVector<T, N>& astList, void* args = nullptr)
+        {
+            for (const auto& ast : astList)
+                Visit(ast, args);
+        }
+
         /* ----- Function declaration tracker ----- */
 
         void PushFunctionDecl(FunctionDecl* ast);
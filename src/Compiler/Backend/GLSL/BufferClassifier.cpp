@@ -0,0 +1,365 @@
+/*
+ * BufferClassifier.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "BufferClassifier.h"
+#include "ResourceAccessAnalyzer.h"
+#include "AST.h"
+#include <algorithm>
+
+
+namespace Xsc
+{
+
+
+// Base alignment (in bytes) of arrays and structures in the "std140" layout.
+static const unsigned int g_std140BaseAlignment = 16;
+
+// Size and base alignment of a type in the "std140" or "std430" layout.
+struct TypeLayout
+{
+    unsigned int size       = 0;
+    unsigned int alignment  = 0;
+};
+
+static unsigned int AlignUp(unsigned int offset, unsigned int alignment)
+{
+    return ((offset + alignment - 1) / alignment * alignment);
+}
+
+// Returns the layout of a scalar or vector with the specified number of components (3-component vectors are aligned like 4-component vectors).
+static TypeLayout VectorLayout(const DataType dataType, unsigned int numComponents)
+{
+    const unsigned int componentSize = (IsDoubleRealType(dataType) ? 8 : 4);
+    return { componentSize * numComponents, componentSize * (numComponents == 3 ? 4 : numComponents) };
+}
+
+static bool ComputeTypeLayout(
+    const TypeDenoter& typeDenoter, bool rowMajor, bool std140, unsigned int offset, TypeLayout& layout, std::vector<unsigned int>* offsets
+);
+
+// Computes the layout of an array of the specified element layout, and returns the array stride.
+static unsigned int ArrayLayout(const TypeLayout& elementLayout, unsigned int numElements, bool std140, TypeLayout& layout)
+{
+    layout.alignment = (std140 ? AlignUp(elementLayout.alignment, g_std140BaseAlignment) : elementLayout.alignment);
+
+    const auto stride = AlignUp(elementLayout.size, layout.alignment);
+    layout.size = stride * numElements;
+
+    return stride;
+}
+
+// Computes the layout of the members of the specified structure (including its base structures), starting at the specified offset.
+static bool ComputeStructMembersLayout(
+    const StructDecl& structDecl, bool std140, unsigned int& offset, unsigned int& alignment, std::vector<unsigned int>* offsets)
+{
+    if (structDecl.baseStructRef)
+    {
+        if (!ComputeStructMembersLayout(*structDecl.baseStructRef, std140, offset, alignment, offsets))
+            return false;
+    }
+
+    for (const auto& varDeclStmnt : structDecl.varMembers)
+    {
+        for (const auto& varDecl : varDeclStmnt->varDecls)
+        {
+            /* Row-major layout qualifiers are only written for the members of uniform buffers, not for structure members */
+            TypeLayout memberLayout;
+            if (!ComputeTypeLayout(*varDecl->GetTypeDenoter(), false, std140, 0, memberLayout, nullptr))
+                return false;
+
+            offset = AlignUp(offset, memberLayout.alignment);
+            if (offsets && !ComputeTypeLayout(*varDecl->GetTypeDenoter(), false, std140, offset, memberLayout, offsets))
+                return false;
+
+            offset += memberLayout.size;
+            alignment = std::max(alignment, memberLayout.alignment);
+        }
+    }
+
+    return true;
+}
+
+/*
+Computes the layout of the specified type at the specified offset, and appends the offsets of all its scalars and vectors,
+or returns false if the type has no fixed layout (e.g. dynamic arrays or samplers).
+*/
+static bool ComputeTypeLayout(
+    const TypeDenoter& typeDenoter, bool rowMajor, bool std140, unsigned int offset, TypeLayout& layout, std::vector<unsigned int>* offsets)
+{
+    const auto& typeDen = typeDenoter.GetAliased();
+
+    if (auto baseTypeDen = typeDen.As<BaseTypeDenoter>())
+    {
+        const auto dataType = baseTypeDen->dataType;
+
+        if (IsScalarType(dataType) || IsVectorType(dataType))
+        {
+            layout = VectorLayout(dataType, static_cast<unsigned int>(VectorTypeDim(dataType)));
+            if (offsets)
+                offsets->push_back(offset);
+            return true;
+        }
+
+        if (IsMatrixType(dataType))
+        {
+            /* Matrices are stored like arrays of column vectors (or row vectors for row-major layout) */
+            const auto dims         = MatrixTypeDim(dataType);
+            const auto numVectors   = static_cast<unsigned int>(rowMajor ? dims.second : dims.first);
+            const auto vectorDim    = static_cast<unsigned int>(rowMajor ? dims.first : dims.second);
+
+            const auto stride = ArrayLayout(VectorLayout(dataType, vectorDim), numVectors, std140, layout);
+            if (offsets)
+            {
+                for (unsigned int i = 0; i < numVectors; ++i)
+                    offsets->push_back(offset + i * stride);
+            }
+            return true;
+        }
+
+        return false;
+    }
+
+    if (auto arrayTypeDen = typeDen.As<ArrayTypeDenoter>())
+    {
+        unsigned int numElements = 1;
+        for (auto size : arrayTypeDen->GetDimensionSizes())
+        {
+            if (size <= 0)
+                return false;
+            numElements *= static_cast<unsigned int>(size);
+        }
+
+        TypeLayout elementLayout;
+        if (!ComputeTypeLayout(*arrayTypeDen->baseTypeDenoter, rowMajor, std140, 0, elementLayout, nullptr))
+            return false;
+
+        const auto stride = ArrayLayout(elementLayout, numElements, std140, layout);
+        if (offsets)
+        {
+            for (unsigned int i = 0; i < numElements; ++i)
+                ComputeTypeLayout(*arrayTypeDen->baseTypeDenoter, rowMajor, std140, offset + i * stride, elementLayout, offsets);
+        }
+        return true;
+    }
+
+    if (auto structTypeDen = typeDen.As<StructTypeDenoter>())
+    {
+        if (auto structDecl = structTypeDen->structDeclRef)
+        {
+            unsigned int size = offset, alignment = 4;
+            if (!ComputeStructMembersLayout(*structDecl, std140, size, alignment, offsets))
+                return false;
+
+            layout.alignment    = (std140 ? AlignUp(alignment, g_std140BaseAlignment) : alignment);
+            layout.size         = AlignUp(size - offset, layout.alignment);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Returns the size (in bytes) of the specified constant buffer in the "std140" layout, or 0 if it has no fixed layout.
+static unsigned int UniformBufferSize(const UniformBufferDecl& uniformBufferDecl)
+{
+    unsigned int offset = 0;
+
+    for (const auto& varDeclStmnt : uniformBufferDecl.varMembers)
+    {
+        const bool rowMajor = (varDeclStmnt->typeSpecifier->typeModifiers.count(TypeModifier::RowMajor) != 0);
+
+        for (const auto& varDecl : varDeclStmnt->varDecls)
+        {
+            TypeLayout memberLayout;
+            if (!ComputeTypeLayout(*varDecl->GetTypeDenoter(), rowMajor, true, 0, memberLayout, nullptr))
+                return 0;
+            offset = AlignUp(offset, memberLayout.alignment) + memberLayout.size;
+        }
+    }
+
+    return offset;
+}
+
+/*
+Returns the array stride (in bytes) of the specified element type in the "std140" layout,
+or 0 if the elements don't have the same layout in "std140" and "std430".
+*/
+static unsigned int UniformElementStride(const TypeDenoter& elementTypeDen)
+{
+    TypeLayout layout140, layout430;
+    std::vector<unsigned int> offsets140, offsets430;
+
+    if (!ComputeTypeLayout(elementTypeDen, false, true, 0, layout140, &offsets140) ||
+        !ComputeTypeLayout(elementTypeDen, false, false, 0, layout430, &offsets430))
+    {
+        return 0;
+    }
+
+    TypeLayout arrayLayout140, arrayLayout430;
+    const auto stride140 = ArrayLayout(layout140, 1, true, arrayLayout140);
+    const auto stride430 = ArrayLayout(layout430, 1, false, arrayLayout430);
+
+    return (stride140 == stride430 && offsets140 == offsets430 ? stride140 : 0);
+}
+
+void BufferClassifier::Classify(Program& program, unsigned int pushConstantBudget, unsigned int uniformBufferSize)
+{
+    std::vector<std::pair<UniformBufferDecl*, std::size_t>> pushConstantCandidates;
+
+    ResourceAccessAnalyzer accessAnalyzer;
+    if (uniformBufferSize > 0)
+        accessAnalyzer.Analyze(program);
+
+    /* Collect storage classes of all reachable buffers in order of their declaration */
+    for (const auto& stmnt : program.globalStmnts)
+    {
+        if (!stmnt->flags(AST::isReachable))
+            continue;
+
+        if (auto uniformBufferDecl = stmnt->As<UniformBufferDecl>())
+        {
+            Reflection::BufferClass bufferClass;
+            {
+                bufferClass.ident   = uniformBufferDecl->ident;
+                bufferClass.storage = Reflection::BufferStorage::Uniform;
+                bufferClass.size    = UniformBufferSize(*uniformBufferDecl);
+            }
+
+            if (bufferClass.size > 0 && bufferClass.size <= pushConstantBudget)
+                pushConstantCandidates.push_back({ uniformBufferDecl, bufferClasses_.size() });
+
+            bufferClassIndices_[uniformBufferDecl] = bufferClasses_.size();
+            bufferClasses_.push_back(bufferClass);
+        }
+        else if (auto bufferDeclStmnt = stmnt->As<BufferDeclStmnt>())
+        {
+            if (bufferDeclStmnt->typeDenoter->bufferType != BufferType::StructuredBuffer)
+                continue;
+
+            for (const auto& bufferDecl : bufferDeclStmnt->bufferDecls)
+            {
+                if (!bufferDecl->flags(AST::isReachable))
+                    continue;
+
+                Reflection::BufferClass bufferClass;
+                {
+                    bufferClass.ident   = bufferDecl->ident;
+                    bufferClass.storage = Reflection::BufferStorage::Storage;
+                }
+
+                /* Declare read-only structured buffer as uniform buffer with as many elements as fit into the size limit */
+                if (uniformBufferSize > 0 && bufferDecl->arrayDims.empty() && accessAnalyzer.IsUniformlyIndexed(bufferDecl.get()))
+                {
+                    if (auto elementTypeDen = bufferDeclStmnt->typeDenoter->GetGenericTypeDenoter())
+                    {
+                        if (auto stride = UniformElementStride(*elementTypeDen))
+                        {
+                            if (auto numElements = uniformBufferSize / stride)
+                            {
+                                bufferClass.storage     = Reflection::BufferStorage::Uniform;
+                                bufferClass.size        = numElements * stride;
+                                bufferClass.numElements = numElements;
+                            }
+                        }
+                    }
+                }
+
+                bufferClassIndices_[bufferDecl.get()] = bufferClasses_.size();
+                bufferClasses_.push_back(bufferClass);
+            }
+        }
+    }
+
+    /* Select the largest constant buffers that fit into the push constant budget (each one starts at a 16-byte boundary) */
+    std::stable_sort(
+        pushConstantCandidates.begin(), pushConstantCandidates.end(),
+        [this](const std::pair<UniformBufferDecl*, std::size_t>& lhs, const std::pair<UniformBufferDecl*, std::size_t>& rhs)
+        {
+            return (bufferClasses_[lhs.second].size > bufferClasses_[rhs.second].size);
+        }
+    );
+
+    std::vector<std::pair<UniformBufferDecl*, std::size_t>> pushConstants;
+    unsigned int pushConstantSize = 0;
+
+    for (const auto& candidate : pushConstantCandidates)
+    {
+        const auto size = AlignUp(bufferClasses_[candidate.second].size, g_std140BaseAlignment);
+        if (pushConstantSize + size <= pushConstantBudget)
+        {
+            pushConstants.push_back(candidate);
+            pushConstantSize += size;
+        }
+    }
+
+    /* Assign offsets within the push constant block in order of declaration */
+    std::sort(
+        pushConstants.begin(), pushConstants.end(),
+        [](const std::pair<UniformBufferDecl*, std::size_t>& lhs, const std::pair<UniformBufferDecl*, std::size_t>& rhs)
+        {
+            return (lhs.second < rhs.second);
+        }
+    );
+
+    unsigned int offset = 0;
+
+    for (const auto& entry : pushConstants)
+    {
+        auto& bufferClass = bufferClasses_[entry.second];
+        bufferClass.storage = Reflection::BufferStorage::PushConstant;
+        bufferClass.offset  = offset;
+        offset += AlignUp(bufferClass.size, g_std140BaseAlignment);
+        pushConstantBuffers_.push_back(entry.first);
+    }
+}
+
+bool BufferClassifier::IsPushConstant(const UniformBufferDecl* uniformBufferDecl) const
+{
+    if (auto bufferClass = FetchBufferClass(uniformBufferDecl))
+        return (bufferClass->storage == Reflection::BufferStorage::PushConstant);
+    else
+        return false;
+}
+
+unsigned int BufferClassifier::PushConstantOffset(const UniformBufferDecl* uniformBufferDecl) const
+{
+    if (auto bufferClass = FetchBufferClass(uniformBufferDecl))
+        return bufferClass->offset;
+    else
+        return 0;
+}
+
+unsigned int BufferClassifier::NumUniformElements(const BufferDecl* bufferDecl) const
+{
+    if (auto bufferClass = FetchBufferClass(bufferDecl))
+        return bufferClass->numElements;
+    else
+        return 0;
+}
+
+void BufferClassifier::Reflect(std::vector<Reflection::BufferClass>& bufferClasses) const
+{
+    bufferClasses.insert(bufferClasses.end(), bufferClasses_.begin(), bufferClasses_.end());
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+const Reflection::BufferClass* BufferClassifier::FetchBufferClass(const AST* ast) const
+{
+    auto it = bufferClassIndices_.find(ast);
+    return (it != bufferClassIndices_.end() ? &(bufferClasses_[it->second]) : nullptr);
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,78 @@
+/*
+ * BufferClassifier.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_BUFFER_CLASSIFIER_H
+#define XSC_BUFFER_CLASSIFIER_H
+
+
+#include <Xsc/Reflection.h>
+#include <vector>
+#include <map>
+
+
+namespace Xsc
+{
+
+
+struct AST;
+struct Program;
+struct UniformBufferDecl;
+struct BufferDecl;
+
+/*
+Buffer classifier.
+Chooses the storage class of all reachable constant buffers and read-only structured buffers for VKSL output:
+The largest constant buffers that fit into the push constant budget are merged into a single push constant block,
+and read-only structured buffers that are only accessed with uniform indices are declared as uniform buffers of bounded size,
+if their elements have the same layout in "std140" and "std430".
+*/
+class BufferClassifier
+{
+
+    public:
+
+        // Classifies all reachable buffers of the specified program. A budget or size of zero disables the respective conversion.
+        void Classify(Program& program, unsigned int pushConstantBudget, unsigned int uniformBufferSize);
+
+        // Returns true if the specified constant buffer has been moved into the push constant block.
+        bool IsPushConstant(const UniformBufferDecl* uniformBufferDecl) const;
+
+        // Returns the offset (in bytes) of the specified constant buffer within the push constant block.
+        unsigned int PushConstantOffset(const UniformBufferDecl* uniformBufferDecl) const;
+
+        // Returns the number of elements of the specified structured buffer if it is declared as uniform buffer, or 0 otherwise.
+        unsigned int NumUniformElements(const BufferDecl* bufferDecl) const;
+
+        // Appends the storage classes of all classified buffers to the specified reflection output.
+        void Reflect(std::vector<Reflection::BufferClass>& bufferClasses) const;
+
+        // Returns the list of all constant buffers in the push constant block (in order of their declaration).
+        inline const std::vector<UniformBufferDecl*>& GetPushConstantBuffers() const
+        {
+            return pushConstantBuffers_;
+        }
+
+    private:
+
+        const Reflection::BufferClass* FetchBufferClass(const AST* ast) const;
+
+        std::vector<Reflection::BufferClass>    bufferClasses_;         // Storage classes in order of declaration.
+        std::map<const AST*, std::size_t>       bufferClassIndices_;    // Indices into 'bufferClasses_' for each buffer.
+
+        std::vector<UniformBufferDecl*>         pushConstantBuffers_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
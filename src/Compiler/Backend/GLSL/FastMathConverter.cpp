@@ -0,0 +1,681 @@
+/*
+ * FastMathConverter.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "FastMathConverter.h"
+#include "ConstExprEvaluator.h"
+#include "ASTFactory.h"
+#include "AST.h"
+#include <Xsc/Xsc.h>
+
+
+namespace Xsc
+{
+
+
+std::vector<FastMathConverter::Substitution> FastMathConverter::Convert(
+    Program& program, unsigned int fastMathFlags, const OutputShaderVersion versionOut)
+{
+    /* Store parameters */
+    fastMathFlags_  = fastMathFlags;
+    substitutions_.clear();
+
+    /* The "fma" intrinsic is only available since GLSL 4.00 and ESSL 3.20 */
+    allowFMA_ =
+    (
+        IsLanguageVKSL(versionOut) ||
+        versionOut == OutputShaderVersion::ESSL320 ||
+        (versionOut >= OutputShaderVersion::GLSL400 && versionOut <= OutputShaderVersion::GLSL450)
+    );
+
+    /* Visit program AST */
+    if (fastMathFlags_ != 0)
+        Visit(&program);
+
+    return std::move(substitutions_);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void FastMathConverter::AddSubstitution(const ExprPtr& expr, const std::string& originalExpr, const std::string& substituteExpr)
+{
+    substitutions_.push_back({ expr, originalExpr, substituteExpr });
+}
+
+// Returns the data type of the specified expression, if it is a single precision scalar or vector type, or DataType::Undefined otherwise.
+static DataType FetchFastMathDataType(Expr& expr)
+{
+    try
+    {
+        if (auto baseTypeDen = expr.GetTypeDenoter()->Get()->As<BaseTypeDenoter>())
+        {
+            const auto dataType = baseTypeDen->dataType;
+            if (IsRealType(dataType) && !IsDoubleRealType(dataType) && !IsMatrixType(dataType))
+                return dataType;
+        }
+    }
+    catch (const std::exception&)
+    {
+        /* ignore this exception */
+    }
+    return DataType::Undefined;
+}
+
+// Evaluates the specified expression, and returns true if it is a constant, whose components are all equal.
+static bool EvaluateUniformConstExpr(Expr& expr, double& value)
+{
+    try
+    {
+        ConstExprEvaluator exprEval;
+        auto result = exprEval.EvaluateExpr(
+            expr,
+            [](VarAccessExpr* ast) -> Variant
+            {
+                throw ast;
+            }
+        );
+
+        if (result.IsCompound())
+        {
+            /* Only accept vectors with equal components (e.g. "float3(0, 0, 0)") */
+            value = Variant(result.Component(0)).ToReal();
+            for (std::size_t i = 1, n = result.NumComponents(); i < n; ++i)
+            {
+                if (Variant(result.Component(i)).ToReal() != value)
+                    return false;
+            }
+        }
+        else
+            value = result.ToReal();
+
+        return true;
+    }
+    catch (const std::exception&)
+    {
+        /* ignore this exception */
+    }
+    catch (VarAccessExpr*)
+    {
+        /* ignore this exception */
+    }
+    return false;
+}
+
+static ExprPtr CopySideEffectFreeExpr(const Expr& expr);
+
+// Returns a copy of the specified variable identifier, or null if any of its array indices can not be copied.
+static VarIdentPtr CopySideEffectFreeVarIdent(const VarIdent& varIdent)
+{
+    auto ast = ASTFactory::MakeVarIdent(varIdent.ident, varIdent.symbolRef);
+    {
+        ast->area           = varIdent.area;
+        ast->flags          = varIdent.flags;
+        ast->nextIsStatic   = varIdent.nextIsStatic;
+
+        for (const auto& index : varIdent.arrayIndices)
+        {
+            if (auto indexCopy = CopySideEffectFreeExpr(*index))
+                ast->arrayIndices.push_back(indexCopy);
+            else
+                return nullptr;
+        }
+
+        if (varIdent.next)
+        {
+            ast->next = CopySideEffectFreeVarIdent(*varIdent.next);
+            if (!ast->next)
+                return nullptr;
+        }
+    }
+    return ast;
+}
+
+/*
+Returns a copy of the specified expression, if it can be evaluated several times without side effects and at low cost,
+i.e. literals and plain variable accesses (e.g. "v.xyz" or "a[i]"), or null otherwise.
+*/
+static ExprPtr CopySideEffectFreeExpr(const Expr& expr)
+{
+    if (auto literalExpr = expr.As<LiteralExpr>())
+    {
+        auto ast = ASTFactory::MakeLiteralExpr(literalExpr->dataType, literalExpr->value);
+        ast->area = literalExpr->area;
+        return ast;
+    }
+    if (auto varAccessExpr = expr.As<VarAccessExpr>())
+    {
+        if (!varAccessExpr->assignExpr)
+        {
+            if (auto varIdent = CopySideEffectFreeVarIdent(*varAccessExpr->varIdent))
+            {
+                auto ast = ASTFactory::MakeVarAccessExpr(varIdent);
+                ast->flags = varAccessExpr->flags;
+                return ast;
+            }
+        }
+        return nullptr;
+    }
+    if (auto bracketExpr = expr.As<BracketExpr>())
+        return CopySideEffectFreeExpr(*bracketExpr->expr);
+    return nullptr;
+}
+
+// Returns the specified expression inside brackets, if it can not be used as operand of a multiplication as it is (e.g. "a + b" -> "(a + b)").
+static ExprPtr MakeMulOperand(const ExprPtr& expr)
+{
+    switch (expr->Type())
+    {
+        case AST::Types::ListExpr:
+        case AST::Types::TernaryExpr:
+        case AST::Types::BinaryExpr:
+            return ASTFactory::MakeBracketExpr(expr);
+        case AST::Types::VarAccessExpr:
+            if (static_cast<const VarAccessExpr&>(*expr).assignExpr)
+                return ASTFactory::MakeBracketExpr(expr);
+            break;
+        default:
+            break;
+    }
+    return expr;
+}
+
+// Returns the bracket expression of the specified substitute with the area of the original expression.
+static ExprPtr MakeSubstituteExpr(const Expr& originalExpr, const ExprPtr& substituteExpr)
+{
+    auto ast = ASTFactory::MakeBracketExpr(substituteExpr);
+    ast->area = originalExpr.area;
+    return ast;
+}
+
+// Returns the argument of the specified intrinsic call, if it is a saturation (i.e. "saturate(x)" or "clamp(x, 0, 1)"), or null otherwise.
+static ExprPtr FetchSaturateArgument(const Expr& expr)
+{
+    if (auto bracketExpr = expr.As<BracketExpr>())
+        return FetchSaturateArgument(*bracketExpr->expr);
+
+    if (auto funcCallExpr = expr.As<FunctionCallExpr>())
+    {
+        const auto& funcCall = *funcCallExpr->call;
+        const auto& args = funcCall.arguments;
+
+        if (funcCall.intrinsic == Intrinsic::Saturate && args.size() == 1)
+            return args[0];
+
+        if (funcCall.intrinsic == Intrinsic::Clamp && args.size() == 3)
+        {
+            double minValue = 0.0, maxValue = 0.0;
+            if (EvaluateUniformConstExpr(*args[1], minValue) && EvaluateUniformConstExpr(*args[2], maxValue))
+            {
+                if (minValue == 0.0 && maxValue == 1.0)
+                    return args[0];
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+static bool IsSaturatedExpr(Expr& expr);
+
+// Returns true if all of the specified expressions are provably in the range [0, 1].
+static bool AreSaturatedExprs(const ExprList& exprs)
+{
+    for (const auto& expr : exprs)
+    {
+        if (!IsSaturatedExpr(*expr))
+            return false;
+    }
+    return !exprs.empty();
+}
+
+/*
+Returns true if the specified expression is provably in the range [0, 1],
+e.g. "saturate(x)", "clamp(x, 0, 1)", "0.5", "saturate(a) * saturate(b)", "1 - saturate(x)", "frac(x)", or "step(a, b)".
+*/
+static bool IsSaturatedExpr(Expr& expr)
+{
+    if (FetchSaturateArgument(expr))
+        return true;
+
+    if (auto bracketExpr = expr.As<BracketExpr>())
+        return IsSaturatedExpr(*bracketExpr->expr);
+
+    if (auto binaryExpr = expr.As<BinaryExpr>())
+    {
+        if (binaryExpr->op == BinaryOp::Mul)
+            return (IsSaturatedExpr(*binaryExpr->lhsExpr) && IsSaturatedExpr(*binaryExpr->rhsExpr));
+
+        if (binaryExpr->op == BinaryOp::Sub)
+        {
+            double value = 0.0;
+            return (EvaluateUniformConstExpr(*binaryExpr->lhsExpr, value) && value == 1.0 && IsSaturatedExpr(*binaryExpr->rhsExpr));
+        }
+
+        return false;
+    }
+
+    if (auto ternaryExpr = expr.As<TernaryExpr>())
+        return (IsSaturatedExpr(*ternaryExpr->thenExpr) && IsSaturatedExpr(*ternaryExpr->elseExpr));
+
+    if (auto funcCallExpr = expr.As<FunctionCallExpr>())
+    {
+        const auto& funcCall = *funcCallExpr->call;
+        switch (funcCall.intrinsic)
+        {
+            case Intrinsic::Frac:
+            case Intrinsic::SmoothStep:
+            case Intrinsic::Step:
+                return true;
+            case Intrinsic::Min:
+            case Intrinsic::Max:
+            case Intrinsic::Lerp:
+                return AreSaturatedExprs(funcCall.arguments);
+            default:
+                return false;
+        }
+    }
+
+    /* Accept constants in the range [0, 1] (e.g. "0.5" or "float3(1, 1, 1)") */
+    double value = 0.0;
+    if (EvaluateUniformConstExpr(expr, value))
+        return (value >= 0.0 && value <= 1.0);
+
+    return false;
+}
+
+void FastMathConverter::ConvertExpr(ExprPtr& expr)
+{
+    if (expr)
+    {
+        if (auto funcCallExpr = expr->As<FunctionCallExpr>())
+        {
+            if (funcCallExpr->call->intrinsic != Intrinsic::Undefined)
+                ConvertIntrinsicCall(expr, *funcCallExpr->call);
+        }
+        else if (auto binaryExpr = expr->As<BinaryExpr>())
+        {
+            if ((fastMathFlags_ & FastMathFlags::MulAdd) != 0 && allowFMA_)
+                ConvertBinaryExprMulAdd(expr, *binaryExpr);
+        }
+    }
+}
+
+void FastMathConverter::ConvertExprList(std::vector<ExprPtr>& exprList)
+{
+    for (auto& expr : exprList)
+        ConvertExpr(expr);
+}
+
+void FastMathConverter::ConvertExprList(ExprList& exprList)
+{
+    for (auto& expr : exprList)
+        ConvertExpr(expr);
+}
+
+void FastMathConverter::ConvertIntrinsicCall(ExprPtr& expr, FunctionCall& funcCall)
+{
+    switch (funcCall.intrinsic)
+    {
+        case Intrinsic::Pow:
+            if ((fastMathFlags_ & FastMathFlags::PowToMul) != 0)
+                ConvertIntrinsicCallPow(expr, funcCall);
+            break;
+
+        case Intrinsic::Normalize:
+            if ((fastMathFlags_ & FastMathFlags::Normalize) != 0)
+                ConvertIntrinsicCallNormalize(expr, funcCall);
+            break;
+
+        case Intrinsic::Exp:
+        case Intrinsic::Log:
+        case Intrinsic::Log10:
+            if ((fastMathFlags_ & FastMathFlags::ExpLog) != 0)
+                ConvertIntrinsicCallExpLog(expr, funcCall);
+            break;
+
+        case Intrinsic::Saturate:
+        case Intrinsic::Clamp:
+            if ((fastMathFlags_ & FastMathFlags::Saturate) != 0)
+                ConvertIntrinsicCallSaturate(expr);
+            break;
+
+        default:
+            break;
+    }
+}
+
+void FastMathConverter::ConvertIntrinsicCallPow(ExprPtr& expr, FunctionCall& funcCall)
+{
+    if (funcCall.arguments.size() != 2 || FetchFastMathDataType(*expr) == DataType::Undefined)
+        return;
+
+    const auto& baseExpr = funcCall.arguments[0];
+
+    double exponent = 0.0;
+    if (!EvaluateUniformConstExpr(*funcCall.arguments[1], exponent))
+        return;
+
+    if (exponent == 0.5)
+    {
+        /* Convert "pow(x, 0.5)" to "sqrt(x)" */
+        auto ast = ASTFactory::MakeIntrinsicCallExpr(Intrinsic::Sqrt, "sqrt", nullptr, { baseExpr });
+        ast->area = expr->area;
+        AddSubstitution(expr, "pow(x, 0.5)", "sqrt(x)");
+        expr = ast;
+    }
+    else if (exponent == -0.5)
+    {
+        /* Convert "pow(x, -0.5)" to "inversesqrt(x)" */
+        auto ast = ASTFactory::MakeIntrinsicCallExpr(Intrinsic::RSqrt, "rsqrt", nullptr, { baseExpr });
+        ast->area = expr->area;
+        AddSubstitution(expr, "pow(x, -0.5)", "inversesqrt(x)");
+        expr = ast;
+    }
+    else if (exponent == 1.0)
+    {
+        /* Convert "pow(x, 1)" to "x" */
+        AddSubstitution(expr, "pow(x, 1)", "x");
+        expr = MakeSubstituteExpr(*expr, baseExpr);
+    }
+    else if (exponent == 2.0 || exponent == 3.0 || exponent == 4.0)
+    {
+        /* Convert "pow(x, n)" to "x * ... * x" (only if 'x' can be evaluated several times) */
+        ExprPtr mulExpr = MakeMulOperand(baseExpr);
+        std::string mulExprDesc = "x";
+
+        for (int i = 1; i < static_cast<int>(exponent); ++i)
+        {
+            auto baseExprCopy = CopySideEffectFreeExpr(*baseExpr);
+            if (!baseExprCopy)
+                return;
+            mulExpr = ASTFactory::MakeBinaryExpr(mulExpr, BinaryOp::Mul, baseExprCopy);
+            mulExprDesc += " * x";
+        }
+
+        AddSubstitution(expr, "pow(x, " + std::to_string(static_cast<int>(exponent)) + ")", mulExprDesc);
+        expr = MakeSubstituteExpr(*expr, mulExpr);
+    }
+}
+
+void FastMathConverter::ConvertIntrinsicCallNormalize(ExprPtr& expr, FunctionCall& funcCall)
+{
+    if (funcCall.arguments.size() != 1)
+        return;
+
+    /* Only convert vectors, whose expression can be evaluated several times */
+    const auto dataType = FetchFastMathDataType(*expr);
+    if (!IsVectorType(dataType))
+        return;
+
+    const auto& vecExpr = funcCall.arguments[0];
+
+    auto dotLhsExpr = CopySideEffectFreeExpr(*vecExpr);
+    auto dotRhsExpr = CopySideEffectFreeExpr(*vecExpr);
+
+    if (!dotLhsExpr || !dotRhsExpr)
+        return;
+
+    /* Convert "normalize(x)" to "x * inversesqrt(dot(x, x))" */
+    auto dotExpr        = ASTFactory::MakeIntrinsicCallExpr(Intrinsic::Dot, "dot", nullptr, { dotLhsExpr, dotRhsExpr });
+    auto rsqrtExpr      = ASTFactory::MakeIntrinsicCallExpr(Intrinsic::RSqrt, "rsqrt", nullptr, { dotExpr });
+    auto mulExpr        = ASTFactory::MakeBinaryExpr(MakeMulOperand(vecExpr), BinaryOp::Mul, rsqrtExpr);
+
+    AddSubstitution(expr, "normalize(x)", "x * inversesqrt(dot(x, x))");
+    expr = MakeSubstituteExpr(*expr, mulExpr);
+}
+
+void FastMathConverter::ConvertIntrinsicCallExpLog(ExprPtr& expr, FunctionCall& funcCall)
+{
+    if (funcCall.arguments.size() != 1 || FetchFastMathDataType(*expr) == DataType::Undefined)
+        return;
+
+    const auto& argExpr = funcCall.arguments[0];
+
+    if (funcCall.intrinsic == Intrinsic::Exp)
+    {
+        /* Convert "exp(x)" to "exp2(x * log2(e))" */
+        auto scaleExpr  = ASTFactory::MakeLiteralExpr(DataType::Float, "1.442695");
+        auto mulExpr    = ASTFactory::MakeBinaryExpr(MakeMulOperand(argExpr), BinaryOp::Mul, scaleExpr);
+        auto exp2Expr   = ASTFactory::MakeIntrinsicCallExpr(Intrinsic::Exp2, "exp2", nullptr, { mulExpr });
+        exp2Expr->area = expr->area;
+
+        AddSubstitution(expr, "exp(x)", "exp2(x * 1.442695)");
+        expr = exp2Expr;
+    }
+    else
+    {
+        /* Convert "log(x)" to "log2(x) * ln(2)", and "log10(x)" to "log2(x) * log10(2)" */
+        const auto isLog10 = (funcCall.intrinsic == Intrinsic::Log10);
+
+        auto log2Expr   = ASTFactory::MakeIntrinsicCallExpr(Intrinsic::Log2, "log2", nullptr, { argExpr });
+        auto scaleExpr  = ASTFactory::MakeLiteralExpr(DataType::Float, (isLog10 ? "0.30103" : "0.693147"));
+        auto mulExpr    = ASTFactory::MakeBinaryExpr(log2Expr, BinaryOp::Mul, scaleExpr);
+
+        if (isLog10)
+            AddSubstitution(expr, "log10(x)", "log2(x) * 0.30103");
+        else
+            AddSubstitution(expr, "log(x)", "log2(x) * 0.693147");
+
+        expr = MakeSubstituteExpr(*expr, mulExpr);
+    }
+}
+
+void FastMathConverter::ConvertIntrinsicCallSaturate(ExprPtr& expr)
+{
+    /* Remove outer saturation if its argument is already in the range [0, 1], e.g. "saturate(saturate(x))" -> "saturate(x)" */
+    if (auto argExpr = FetchSaturateArgument(*expr))
+    {
+        if (!IsSaturatedExpr(*argExpr))
+            return;
+
+        /* Argument must have the same type, since "clamp(x, float3(0), float3(1))" may also broadcast a scalar argument */
+        const auto dataType = FetchFastMathDataType(*expr);
+        if (dataType == DataType::Undefined || dataType != FetchFastMathDataType(*argExpr))
+            return;
+
+        if (FetchSaturateArgument(*argExpr))
+        {
+            AddSubstitution(expr, "saturate(saturate(x))", "saturate(x)");
+            expr = argExpr;
+        }
+        else
+        {
+            AddSubstitution(expr, "saturate(x)", "x, with x in [0, 1]");
+            expr = MakeSubstituteExpr(*expr, argExpr);
+        }
+    }
+}
+
+void FastMathConverter::ConvertBinaryExprMulAdd(ExprPtr& expr, BinaryExpr& binaryExpr)
+{
+    if (binaryExpr.op != BinaryOp::Add)
+        return;
+
+    /* Find multiplication on either side of the addition */
+    ExprPtr addendExpr;
+    auto mulExpr = binaryExpr.lhsExpr->As<BinaryExpr>();
+
+    if (mulExpr && mulExpr->op == BinaryOp::Mul)
+        addendExpr = binaryExpr.rhsExpr;
+    else
+    {
+        mulExpr = binaryExpr.rhsExpr->As<BinaryExpr>();
+        if (mulExpr && mulExpr->op == BinaryOp::Mul)
+            addendExpr = binaryExpr.lhsExpr;
+        else
+            return;
+    }
+
+    /* All operands must have the same type, since "fma" does not allow implicit conversions */
+    const auto dataType = FetchFastMathDataType(binaryExpr);
+    if (dataType == DataType::Undefined)
+        return;
+
+    for (auto operandExpr : { mulExpr->lhsExpr.get(), mulExpr->rhsExpr.get(), addendExpr.get() })
+    {
+        if (FetchFastMathDataType(*operandExpr) != dataType)
+            return;
+    }
+
+    /* Convert "a * b + c" to "fma(a, b, c)" */
+    auto ast = ASTFactory::MakeIntrinsicCallExpr(
+        Intrinsic::MAD, "mad", nullptr,
+        { mulExpr->lhsExpr, mulExpr->rhsExpr, addendExpr }
+    );
+    ast->area = expr->area;
+
+    AddSubstitution(expr, "a * b + c", "fma(a, b, c)");
+    expr = ast;
+}
+
+/* ------- Visit functions ------- */
+
+#define IMPLEMENT_VISIT_PROC(AST_NAME) \
+    void FastMathConverter::Visit##AST_NAME(AST_NAME* ast, void* args)
+
+IMPLEMENT_VISIT_PROC(FunctionCall)
+{
+    VISIT_DEFAULT(FunctionCall);
+    ConvertExprList(ast->arguments);
+}
+
+IMPLEMENT_VISIT_PROC(VarDecl)
+{
+    VISIT_DEFAULT(VarDecl);
+    ConvertExpr(ast->initializer);
+}
+
+IMPLEMENT_VISIT_PROC(FunctionDecl)
+{
+    /* Only convert reachable functions, since all substitutions are reported */
+    if (ast->flags(AST::isReachable))
+        VISIT_DEFAULT(FunctionDecl);
+}
+
+IMPLEMENT_VISIT_PROC(ForLoopStmnt)
+{
+    VISIT_DEFAULT(ForLoopStmnt);
+    ConvertExpr(ast->condition);
+    ConvertExpr(ast->iteration);
+}
+
+IMPLEMENT_VISIT_PROC(WhileLoopStmnt)
+{
+    VISIT_DEFAULT(WhileLoopStmnt);
+    ConvertExpr(ast->condition);
+}
+
+IMPLEMENT_VISIT_PROC(DoWhileLoopStmnt)
+{
+    VISIT_DEFAULT(DoWhileLoopStmnt);
+    ConvertExpr(ast->condition);
+}
+
+IMPLEMENT_VISIT_PROC(IfStmnt)
+{
+    VISIT_DEFAULT(IfStmnt);
+    ConvertExpr(ast->condition);
+}
+
+IMPLEMENT_VISIT_PROC(SwitchStmnt)
+{
+    VISIT_DEFAULT(SwitchStmnt);
+    ConvertExpr(ast->selector);
+}
+
+IMPLEMENT_VISIT_PROC(ExprStmnt)
+{
+    VISIT_DEFAULT(ExprStmnt);
+    ConvertExpr(ast->expr);
+}
+
+IMPLEMENT_VISIT_PROC(ReturnStmnt)
+{
+    VISIT_DEFAULT(ReturnStmnt);
+    ConvertExpr(ast->expr);
+}
+
+IMPLEMENT_VISIT_PROC(ListExpr)
+{
+    VISIT_DEFAULT(ListExpr);
+    ConvertExpr(ast->firstExpr);
+    ConvertExpr(ast->nextExpr);
+}
+
+IMPLEMENT_VISIT_PROC(TernaryExpr)
+{
+    VISIT_DEFAULT(TernaryExpr);
+    ConvertExpr(ast->condExpr);
+    ConvertExpr(ast->thenExpr);
+    ConvertExpr(ast->elseExpr);
+}
+
+IMPLEMENT_VISIT_PROC(BinaryExpr)
+{
+    VISIT_DEFAULT(BinaryExpr);
+    ConvertExpr(ast->lhsExpr);
+    ConvertExpr(ast->rhsExpr);
+}
+
+IMPLEMENT_VISIT_PROC(UnaryExpr)
+{
+    VISIT_DEFAULT(UnaryExpr);
+    ConvertExpr(ast->expr);
+}
+
+IMPLEMENT_VISIT_PROC(PostUnaryExpr)
+{
+    VISIT_DEFAULT(PostUnaryExpr);
+    ConvertExpr(ast->expr);
+}
+
+IMPLEMENT_VISIT_PROC(BracketExpr)
+{
+    VISIT_DEFAULT(BracketExpr);
+    ConvertExpr(ast->expr);
+}
+
+IMPLEMENT_VISIT_PROC(SuffixExpr)
+{
+    VISIT_DEFAULT(SuffixExpr);
+    ConvertExpr(ast->expr);
+}
+
+IMPLEMENT_VISIT_PROC(ArrayAccessExpr)
+{
+    VISIT_DEFAULT(ArrayAccessExpr);
+    ConvertExprList(ast->arrayIndices);
+}
+
+IMPLEMENT_VISIT_PROC(CastExpr)
+{
+    VISIT_DEFAULT(CastExpr);
+    ConvertExpr(ast->expr);
+}
+
+IMPLEMENT_VISIT_PROC(VarAccessExpr)
+{
+    VISIT_DEFAULT(VarAccessExpr);
+    ConvertExpr(ast->assignExpr);
+}
+
+IMPLEMENT_VISIT_PROC(InitializerExpr)
+{
+    VISIT_DEFAULT(InitializerExpr);
+    ConvertExprList(ast->exprs);
+}
+
+#undef IMPLEMENT_VISIT_PROC
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,117 @@
+/*
+ * FastMathConverter.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_FAST_MATH_CONVERTER_H
+#define XSC_FAST_MATH_CONVERTER_H
+
+
+#include "Visitor.h"
+#include <Xsc/Targets.h>
+#include <string>
+#include <vector>
+
+
+namespace Xsc
+{
+
+
+/*
+Fast-math converter.
+This AST modifier substitutes cheaper (but less precise) sequences for expensive intrinsics (see FastMathFlags),
+e.g. "pow(x, 2)" -> "x * x", or "normalize(x)" -> "x * inversesqrt(dot(x, x))".
+Only expressions of single precision scalar and vector types are converted, and only expressions without side effects are duplicated.
+This must be used after the reference analysis, since only reachable functions are converted.
+*/
+class FastMathConverter : private Visitor
+{
+
+    public:
+
+        // Substitution of an expression (e.g. "pow(x, 2)" by "x * x").
+        struct Substitution
+        {
+            ExprPtr     expr;           // Original expression (only used for its source area).
+            std::string originalExpr;
+            std::string substituteExpr;
+        };
+
+        // Converts all expressions in the specified program with the substitutions of the specified fast-math flags, and returns the list of all substitutions.
+        std::vector<Substitution> Convert(Program& program, unsigned int fastMathFlags, const OutputShaderVersion versionOut);
+
+    private:
+
+        /* === Functions === */
+
+        void AddSubstitution(const ExprPtr& expr, const std::string& originalExpr, const std::string& substituteExpr);
+
+        void ConvertExpr(ExprPtr& expr);
+        void ConvertExprList(std::vector<ExprPtr>& exprList);
+        void ConvertExprList(ExprList& exprList);
+
+        void ConvertIntrinsicCall(ExprPtr& expr, FunctionCall& funcCall);
+
+        // Converts "pow(x, e)" for the constant exponents -0.5, 0.5, 1, 2, 3, and 4.
+        void ConvertIntrinsicCallPow(ExprPtr& expr, FunctionCall& funcCall);
+
+        // Converts "normalize(x)" to "x * inversesqrt(dot(x, x))".
+        void ConvertIntrinsicCallNormalize(ExprPtr& expr, FunctionCall& funcCall);
+
+        // Converts "exp(x)", "log(x)", and "log10(x)" to "exp2(x * c)" and "log2(x) * c".
+        void ConvertIntrinsicCallExpLog(ExprPtr& expr, FunctionCall& funcCall);
+
+        // Removes redundant saturations, e.g. "saturate(saturate(x))", "clamp(saturate(x), 0, 1)", or "saturate(a * b)" with saturated 'a' and 'b'.
+        void ConvertIntrinsicCallSaturate(ExprPtr& expr);
+
+        // Converts "a * b + c" to "fma(a, b, c)".
+        void ConvertBinaryExprMulAdd(ExprPtr& expr, BinaryExpr& binaryExpr);
+
+        /* ----- Visitor implementation ----- */
+
+        DECL_VISIT_PROC( FunctionCall     );
+
+        DECL_VISIT_PROC( VarDecl          );
+
+        DECL_VISIT_PROC( FunctionDecl     );
+
+        DECL_VISIT_PROC( ForLoopStmnt     );
+        DECL_VISIT_PROC( WhileLoopStmnt   );
+        DECL_VISIT_PROC( DoWhileLoopStmnt );
+        DECL_VISIT_PROC( IfStmnt          );
+        DECL_VISIT_PROC( SwitchStmnt      );
+        DECL_VISIT_PROC( ExprStmnt        );
+        DECL_VISIT_PROC( ReturnStmnt      );
+
+        DECL_VISIT_PROC( ListExpr         );
+        DECL_VISIT_PROC( TernaryExpr      );
+        DECL_VISIT_PROC( BinaryExpr       );
+        DECL_VISIT_PROC( UnaryExpr        );
+        DECL_VISIT_PROC( PostUnaryExpr    );
+        DECL_VISIT_PROC( BracketExpr      );
+        DECL_VISIT_PROC( SuffixExpr       );
+        DECL_VISIT_PROC( ArrayAccessExpr  );
+        DECL_VISIT_PROC( CastExpr         );
+        DECL_VISIT_PROC( VarAccessExpr    );
+        DECL_VISIT_PROC( InitializerExpr  );
+
+        /* === Members === */
+
+        unsigned int                fastMathFlags_  = 0;
+        bool                        allowFMA_       = false;
+
+        std::vector<Substitution>   substitutions_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
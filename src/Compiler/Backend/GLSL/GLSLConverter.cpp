@@ -214,6 +214,10 @@ IMPLEMENT_VISIT_PROC(VarDecl)
 {
     RegisterDeclIdent(ast);
     VISIT_DEFAULT(VarDecl);
+
+    /* Convert array initializers into array constructors, which don't require GLSL 4.20 (for smaller constant tables) */
+    if (options_.constantTableThreshold > 0)
+        ConvertArrayInitializer(ast);
 }
 
 IMPLEMENT_VISIT_PROC(BufferDecl)
@@ -946,6 +950,63 @@ void GLSLConverter::ConvertFunctionCall(FunctionCall* ast)
     }
 }
 
+void GLSLConverter::ConvertArrayInitializer(VarDecl* ast)
+{
+    auto typeDen = ast->GetTypeDenoter()->Get();
+
+    auto arrayTypeDen = typeDen->As<ArrayTypeDenoter>();
+    if (!arrayTypeDen || !ast->initializer)
+        return;
+
+    /* Only convert initializers of one-dimensional arrays with one expression for each array element */
+    auto dimSizes = arrayTypeDen->GetDimensionSizes();
+    if (dimSizes.size() != 1)
+        return;
+
+    auto initExpr = ast->initializer->As<InitializerExpr>();
+    if (!initExpr || initExpr->exprs.size() != static_cast<std::size_t>(dimSizes.front()))
+        return;
+
+    auto elementTypeDen = arrayTypeDen->baseTypeDenoter->Get();
+
+    std::vector<ExprPtr> arguments;
+
+    for (const auto& expr : initExpr->exprs)
+    {
+        if (auto subInitExpr = expr->As<InitializerExpr>())
+        {
+            /* Convert nested initializer of a vector or matrix into a type constructor (e.g. "{ 1, 2 }" to "vec2(1, 2)") */
+            if (!elementTypeDen->IsBase())
+                return;
+            for (const auto& subExpr : subInitExpr->exprs)
+            {
+                if (subExpr->Type() == AST::Types::InitializerExpr)
+                    return;
+            }
+            arguments.push_back(ASTFactory::MakeTypeCtorCallExpr(elementTypeDen, subInitExpr->exprs));
+        }
+        else if (!expr->GetTypeDenoter()->Get()->Equals(*elementTypeDen) && elementTypeDen->IsBase())
+        {
+            /* Array constructors require arguments of the element type (e.g. "1.0" or "float(x)") */
+            auto literalExpr = expr->As<LiteralExpr>();
+            if (literalExpr && elementTypeDen->IsScalar())
+            {
+                literalExpr->ConvertDataType(elementTypeDen->As<BaseTypeDenoter>()->dataType);
+                arguments.push_back(expr);
+            }
+            else
+                arguments.push_back(ASTFactory::MakeTypeCtorCallExpr(elementTypeDen, { expr }));
+        }
+        else
+            arguments.push_back(expr);
+    }
+
+    /* Replace initializer by array constructor (e.g. "float[3](0.25, 0.5, 0.25)") */
+    auto ctorExpr = ASTFactory::MakeTypeCtorCallExpr(typeDen, arguments);
+    ctorExpr->area = ast->initializer->area;
+    ast->initializer = ctorExpr;
+}
+
 /* ----- Unrolling ----- */
 
 void GLSLConverter::UnrollStmnts(std::vector<StmntPtr>& stmnts)
@@ -957,7 +1018,8 @@ void GLSLConverter::UnrollStmnts(std::vector<StmntPtr>& stmnts)
         auto ast = it->get();
         if (auto varDeclStmnt = ast->As<VarDeclStmnt>())
         {
-            if (options_.unrollArrayInitializers)
+            /* Don't unroll constant arrays, which are written with array constructors instead */
+            if (options_.unrollArrayInitializers && !(options_.constantTableThreshold > 0 && varDeclStmnt->typeSpecifier->IsConst()))
                 UnrollStmntsVarDecl(unrolledStmnts, varDeclStmnt);
         }
 
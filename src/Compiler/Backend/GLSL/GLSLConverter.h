@@ -152,6 +152,8 @@ class GLSLConverter : public Visitor
 
         void ConvertFunctionCall(FunctionCall* ast);
 
+        void ConvertArrayInitializer(VarDecl* ast);
+
         /* ----- Unrolling ----- */
 
         void UnrollStmnts(std::vector<StmntPtr>& stmnts);
@@ -7,7 +7,13 @@
 
 #include "GLSLGenerator.h"
 #include "GLSLExtensionAgent.h"
+#include "GLSLExtensions.h"
 #include "GLSLConverter.h"
+#include "FastMathConverter.h"
+#include "SLPVectorizer.h"
+#include "ScalarReplacer.h"
+#include "LoopOptimizer.h"
+#include "ProfileGuidedOptimizer.h"
 #include "GLSLKeywords.h"
 #include "GLSLIntrinsics.h"
 #include "ReferenceAnalyzer.h"
@@ -51,6 +57,26 @@ GLSLGenerator::GLSLGenerator(Log* log) :
 {
 }
 
+void GLSLGenerator::ReflectPackedVaryings(Reflection::ReflectionData& reflectionData) const
+{
+    inputPacker_.Reflect(reflectionData.packedInputs);
+    outputPacker_.Reflect(reflectionData.packedOutputs);
+}
+
+void GLSLGenerator::ReflectBufferClasses(Reflection::ReflectionData& reflectionData) const
+{
+    bufferClassifier_.Reflect(reflectionData.bufferClasses);
+}
+
+void GLSLGenerator::ReflectProfileCounters(Reflection::ReflectionData& reflectionData) const
+{
+    if (profileCounterStorage_ != ProfileCounterStorage::None)
+    {
+        reflectionData.profileCounterBuffer = profileCounterBuffer_;
+        profileInstrumenter_.Reflect(reflectionData.profileCounters);
+    }
+}
+
 void GLSLGenerator::GenerateCodePrimary(
     Program& program, const ShaderInput& inputDesc, const ShaderOutput& outputDesc)
 {
@@ -63,6 +89,7 @@ void GLSLGenerator::GenerateCodePrimary(
     allowLineMarks_     = outputDesc.formatting.lineMarks;
     compactWrappers_    = outputDesc.formatting.compactWrappers;
     alwaysBracedScopes_ = outputDesc.formatting.alwaysBracedScopes;
+    packVaryings_       = outputDesc.options.packVaryings;
 
     for (const auto& s : outputDesc.vertexSemantics)
     {
@@ -92,6 +119,81 @@ void GLSLGenerator::GenerateCodePrimary(
                 refAnalyzer.MarkReferencesFromEntryPoint(program, inputDesc.shaderTarget);
             }
 
+            /* Split local aggregates into temporaries and report each replacement */
+            if (outputDesc.options.scalarReplacement)
+            {
+                ScalarReplacer scalarReplacer;
+                auto replacements = scalarReplacer.ReplaceAggregates(program, nameMangling_);
+                for (const auto& r : replacements)
+                    Info(R_ScalarReplacedAggregate(r.ident, r.numTemporaries), r.stmnt.get());
+            }
+
+            /* Hoist loop invariants, reduce induction variables, and report each transformation */
+            if (outputDesc.options.optimizeLoops)
+            {
+                LoopOptimizer loopOptimizer;
+                auto transformations = loopOptimizer.Optimize(program, nameMangling_);
+                for (const auto& t : transformations)
+                {
+                    if (t.inductionVar.empty())
+                        Info(R_HoistedLoopInvariant(t.temporary), t.expr.get());
+                    else
+                        Info(R_ReducedInductionVarMul(t.inductionVar, t.temporary), t.expr.get());
+                }
+            }
+
+            /* Substitute approximate intrinsics and report each substitution */
+            if (outputDesc.options.fastMath != 0)
+            {
+                FastMathConverter fastMathConverter;
+                auto substitutions = fastMathConverter.Convert(program, outputDesc.options.fastMath, versionOut_);
+                for (const auto& s : substitutions)
+                    Info(R_FastMathSubstitution(s.originalExpr, s.substituteExpr), s.expr.get());
+            }
+
+            /* Merge scalar operations into vector operations and report each merge */
+            if (outputDesc.options.vectorize)
+            {
+                SLPVectorizer vectorizer;
+                auto merges = vectorizer.Vectorize(program);
+                for (const auto& m : merges)
+                    Info(R_VectorizedScalarOps(m.numScalarOps, m.vectorExpr), m.stmnt.get());
+            }
+
+            /* Select storage classes of constant and structured buffers */
+            if (IsVKSL() && (outputDesc.options.pushConstantBudget > 0 || outputDesc.options.uniformStorageBufferSize > 0))
+                bufferClassifier_.Classify(program, outputDesc.options.pushConstantBudget, outputDesc.options.uniformStorageBufferSize);
+
+            /* Pack input and output varyings into slots */
+            if (packVaryings_)
+                PackVaryings(program.entryPointRef, outputDesc.packedInputLayout);
+
+            /* Reorder branches and unroll hot loops with the execution counts (instrumented code must keep the original control flow) */
+            if (!outputDesc.profileCounts.empty() && !outputDesc.options.profileCounters)
+            {
+                ProfileGuidedOptimizer profileGuidedOptimizer;
+                auto transformations = profileGuidedOptimizer.Optimize(program, outputDesc.profileCounts);
+                for (const auto& t : transformations)
+                {
+                    switch (t.type)
+                    {
+                        case ProfileGuidedOptimizer::Transformation::Types::ReorderedBranches:
+                            Info(R_PGOReorderedBranches(std::to_string(t.count), std::to_string(t.otherCount)), t.stmnt.get());
+                            break;
+                        case ProfileGuidedOptimizer::Transformation::Types::ReorderedSwitchCases:
+                            Info(R_PGOReorderedSwitchCases(t.numElements), t.stmnt.get());
+                            break;
+                        case ProfileGuidedOptimizer::Transformation::Types::UnrolledLoop:
+                            Info(R_PGOUnrolledLoop(t.numElements, std::to_string(t.count)), t.stmnt.get());
+                            break;
+                    }
+                }
+            }
+
+            /* Assign profiling counters to all code regions (the storage is selected with the final output version) */
+            if (outputDesc.options.profileCounters)
+                profileInstrumenter_.AssignCounters(program);
+
             /* Write header */
             if (inputDesc.entryPoint.empty())
                 WriteComment("GLSL " + ToString(GetShaderTarget()));
@@ -268,6 +370,10 @@ IMPLEMENT_VISIT_PROC(Program)
     /* Write global uniform declarations */
     WriteGlobalUniforms();
 
+    /* Write buffer of profiling counters */
+    if (profileCounterStorage_ != ProfileCounterStorage::None)
+        WriteProfileCounterBuffer();
+
     /* Write global input/output semantics */
     BeginSep();
     {
@@ -289,6 +395,7 @@ IMPLEMENT_VISIT_PROC(CodeBlock)
 {
     WriteScopeOpen();
     {
+        WriteProfileCounter(ast);
         WriteStmntList(ast->stmnts);
     }
     WriteScopeClose();
@@ -334,6 +441,7 @@ IMPLEMENT_VISIT_PROC(SwitchCase)
     /* Write statement list */
     IncIndent();
     {
+        WriteProfileCounter(ast);
         Visit(ast->stmnts);
     }
     DecIndent();
@@ -469,6 +577,14 @@ IMPLEMENT_VISIT_PROC(UniformBufferDecl)
     if (!ast->flags(AST::isReachable))
         return;
 
+    if (bufferClassifier_.IsPushConstant(ast))
+    {
+        /* Write all push constants at the position of the first constant buffer in the block */
+        if (ast == bufferClassifier_.GetPushConstantBuffers().front())
+            WritePushConstantBlock();
+        return;
+    }
+
     if (versionOut_ < OutputShaderVersion::GLSL140)
     {
         /* Write individual uniforms */
@@ -842,7 +958,17 @@ IMPLEMENT_VISIT_PROC(ListExpr)
 
 IMPLEMENT_VISIT_PROC(LiteralExpr)
 {
-    Write(ast->value);
+    const auto& s = ast->value;
+
+    if (IsRealType(ast->dataType) && !s.empty() && (s.back() == 'l' || s.back() == 'L'))
+    {
+        /* Replace 'l' and 'L' suffix with 'lf' suffix, or remove it if doubles are not supported */
+        Write(s.substr(0, s.size() - 1));
+        if (versionOut_ >= OutputShaderVersion::GLSL400)
+            Write("lf");
+    }
+    else
+        Write(s);
 }
 
 IMPLEMENT_VISIT_PROC(TypeSpecifierExpr)
@@ -997,11 +1123,21 @@ void GLSLGenerator::WriteProgramHeader()
     try
     {
         /* Determine all required GLSL extensions with the GLSL extension agent */
+        const auto requestedVersion = versionOut_;
+
         GLSLExtensionAgent extensionAgent;
         auto requiredExtensions = extensionAgent.DetermineRequiredExtensions(
             *GetProgram(), versionOut_, GetShaderTarget(), allowExtensions_, explicitBinding_
         );
 
+        /* Select storage of profiling counters, which might require a higher version */
+        if (profileInstrumenter_.NumCounters() > 0)
+            SelectProfileCounterStorage(requestedVersion, requiredExtensions);
+
+        /* Select explicit locations of packed varyings, which might require a higher version */
+        if (!inputPacker_.GetSlots().empty() || !outputPacker_.GetSlots().empty())
+            SelectPackedVaryingLocations(requestedVersion, requiredExtensions);
+
         /* Write GLSL version */
         WriteProgramHeaderVersion();
         Blank();
@@ -1032,6 +1168,117 @@ void GLSLGenerator::WriteProgramHeaderExtension(const std::string& extensionName
     WriteLn("#extension " + extensionName + " : enable");// "require" or "enable"
 }
 
+/* --- Profiling --- */
+
+void GLSLGenerator::SelectProfileCounterStorage(const OutputShaderVersion requestedVersion, std::set<std::string>& requiredExtensions)
+{
+    if ( IsVKSL() ||
+         ( IsESSL() && versionOut_ >= OutputShaderVersion::ESSL310 ) ||
+         ( IsLanguageGLSL(versionOut_) && versionOut_ >= OutputShaderVersion::GLSL430 ) )
+    {
+        /* Storage buffers are supported by the output version */
+        profileCounterStorage_ = ProfileCounterStorage::StorageBuffer;
+    }
+    else if (requestedVersion == OutputShaderVersion::GLSL || requestedVersion == OutputShaderVersion::ESSL)
+    {
+        /* Raise auto-detected version to the first version with storage buffers */
+        versionOut_ = (IsESSL() ? OutputShaderVersion::ESSL310 : OutputShaderVersion::GLSL430);
+        profileCounterStorage_ = ProfileCounterStorage::StorageBuffer;
+    }
+    else if (IsLanguageGLSL(versionOut_) && versionOut_ >= OutputShaderVersion::GLSL420)
+        profileCounterStorage_ = ProfileCounterStorage::AtomicCounters;
+    else if (IsLanguageGLSL(versionOut_) && allowExtensions_)
+    {
+        requiredExtensions.insert(E_GL_ARB_shader_atomic_counters);
+        profileCounterStorage_ = ProfileCounterStorage::AtomicCounters;
+    }
+    else
+    {
+        Warning(R_ProfileCountersNotSupported(ToString(versionOut_)));
+        return;
+    }
+
+    if (profileCounterStorage_ == ProfileCounterStorage::StorageBuffer)
+    {
+        /* Storage buffer shares the binding slots with all other resources */
+        profileCounterBuffer_.ident     = nameMangling_.temporaryPrefix + "ProfileCounters";
+        profileCounterBuffer_.location  = profileInstrumenter_.GetFreeSlot();
+        profileCounterArray_            = nameMangling_.temporaryPrefix + "profileCounters";
+    }
+    else
+    {
+        /* Atomic counter buffers have their own binding slots, which are not used otherwise */
+        profileCounterBuffer_.ident     = nameMangling_.temporaryPrefix + "profileCounters";
+        profileCounterBuffer_.location  = 0;
+        profileCounterArray_            = profileCounterBuffer_.ident;
+    }
+}
+
+bool GLSLGenerator::HasProfileCounter(const AST* region) const
+{
+    return (profileCounterStorage_ != ProfileCounterStorage::None && profileInstrumenter_.FindCounter(region) >= 0);
+}
+
+void GLSLGenerator::WriteProfileCounterBuffer()
+{
+    const auto binding = std::to_string(profileCounterBuffer_.location);
+
+    if (profileCounterStorage_ == ProfileCounterStorage::StorageBuffer)
+    {
+        /* Write storage buffer with an unsized array of counters */
+        BeginLn();
+        {
+            WriteLayout(
+                {
+                    [&]() { Write("std430"); },
+                    [&]() { Write("binding = " + binding); },
+                }
+            );
+            Write("buffer " + profileCounterBuffer_.ident);
+        }
+        EndLn();
+
+        WriteScopeOpen(false, true);
+        {
+            WriteLn("uint " + profileCounterArray_ + "[];");
+        }
+        WriteScopeClose();
+    }
+    else
+    {
+        /* Write array of atomic counters */
+        BeginLn();
+        {
+            WriteLayout(
+                {
+                    [&]() { Write("binding = " + binding); },
+                    [&]() { Write("offset = 0"); },
+                }
+            );
+            Write("uniform atomic_uint " + profileCounterArray_ + "[" + std::to_string(profileInstrumenter_.NumCounters()) + "];");
+        }
+        EndLn();
+    }
+
+    Blank();
+}
+
+void GLSLGenerator::WriteProfileCounter(const AST* region)
+{
+    if (profileCounterStorage_ != ProfileCounterStorage::None)
+    {
+        const auto index = profileInstrumenter_.FindCounter(region);
+        if (index >= 0)
+        {
+            const auto counter = profileCounterArray_ + "[" + std::to_string(index) + "]";
+            if (profileCounterStorage_ == ProfileCounterStorage::StorageBuffer)
+                WriteLn("atomicAdd(" + counter + ", 1u);");
+            else
+                WriteLn("atomicCounterIncrement(" + counter + ");");
+        }
+    }
+}
+
 /* --- Layouts --- */
 
 void GLSLGenerator::WriteGlobalLayouts()
@@ -1280,12 +1527,16 @@ void GLSLGenerator::WriteLocalInputSemanticsStructDeclParam(VarDeclStmnt* param,
         {
             /* Write global shader input to local variable assignments */
             auto paramVar = param->varDecls.front().get();
+            const auto& inputSemantics = GetProgram()->entryPointRef->inputSemantics;
         
             if (paramVar->arrayDims.empty())
             {
                 structDecl->ForEachVarDecl(
                     [&](VarDeclPtr& varDecl)
                     {
+                        if (!inputSemantics.Contains(varDecl.get()))
+                            return;
+
                         BeginLn();
                         {
                             Separator();
@@ -1310,6 +1561,9 @@ void GLSLGenerator::WriteLocalInputSemanticsStructDeclParam(VarDeclStmnt* param,
                     structDecl->ForEachVarDecl(
                         [&](VarDeclPtr& varDecl)
                         {
+                            if (!inputSemantics.Contains(varDecl.get()))
+                                return;
+
                             BeginLn();
                             {
                                 Separator();
@@ -1336,7 +1590,12 @@ void GLSLGenerator::WriteGlobalInputSemantics(FunctionDecl* entryPoint)
     auto& varDeclRefs = entryPoint->inputSemantics.varDeclRefs;
 
     for (auto varDecl : varDeclRefs)
-        WriteGlobalInputSemanticsVarDecl(varDecl);
+    {
+        if (!inputPacker_.IsPacked(varDecl))
+            WriteGlobalInputSemanticsVarDecl(varDecl);
+    }
+
+    WritePackedVaryingSlots(inputPacker_, (versionOut_ <= OutputShaderVersion::GLSL120 ? "varying" : "in"));
 
     if (!varDeclRefs.empty())
         Blank();
@@ -1451,7 +1710,12 @@ void GLSLGenerator::WriteGlobalOutputSemantics(FunctionDecl* entryPoint)
     bool paramsWritten = (!varDeclRefs.empty());
 
     for (auto varDecl : varDeclRefs)
-        WriteGlobalOutputSemanticsVarDecl(varDecl);
+    {
+        if (!outputPacker_.IsPacked(varDecl))
+            WriteGlobalOutputSemanticsVarDecl(varDecl);
+    }
+
+    WritePackedVaryingSlots(outputPacker_, (versionOut_ <= OutputShaderVersion::GLSL120 ? "varying" : "out"));
 
     /* Write 'SV_Target' system-value output semantics */
     if (IsFragmentShader() && versionOut_ > OutputShaderVersion::GLSL120)
@@ -1622,6 +1886,10 @@ void GLSLGenerator::WriteOutputSemanticsAssignment(Expr* expr, bool writeAsListe
                 WriteOutputSemanticsAssignmentStructDeclParam({ nullptr, nullptr, structDecl }, writeAsListedExpr, tempVarIdent);
         }
     }
+
+    /* Write assignments to packed output slots */
+    if (InsideEntryPoint())
+        WritePackOutputVaryings();
 }
 
 void GLSLGenerator::WriteOutputSemanticsAssignmentStructDeclParam(
@@ -1633,10 +1901,15 @@ void GLSLGenerator::WriteOutputSemanticsAssignmentStructDeclParam(
 
     if (structDecl && structDecl->flags(StructDecl::isNonEntryPointParam) && structDecl->flags(StructDecl::isShaderOutput))
     {
+        const auto& outputSemantics = GetProgram()->entryPointRef->outputSemantics;
+
         /* Write global shader input to local variable assignments */
         structDecl->ForEachVarDecl(
             [&](VarDeclPtr& varDecl)
             {
+                if (!outputSemantics.Contains(varDecl.get()))
+                    return;
+
                 auto openLine = IsOpenLine();
                 if (!writeAsListedExpr && !openLine)
                     BeginLn();
@@ -1668,6 +1941,139 @@ void GLSLGenerator::WriteOutputSemanticsAssignmentStructDeclParam(
     }
 }
 
+/* --- Packed varyings --- */
+
+void GLSLGenerator::PackVaryings(FunctionDecl* entryPoint, const std::vector<Reflection::PackedVarying>& inputLayout)
+{
+    /* Pack inputs of fragment shaders (with the packing map of the previous stage), and outputs of vertex and tessellation-evaluation shaders */
+    if (IsFragmentShader())
+        inputPacker_.Pack(entryPoint->inputSemantics.varDeclRefs, nameMangling_.inputPrefix + "pack", inputLayout);
+    else if (IsVertexShader() || IsTessEvaluationShader())
+        outputPacker_.Pack(entryPoint->outputSemantics.varDeclRefs, nameMangling_.outputPrefix + "pack");
+}
+
+void GLSLGenerator::SelectPackedVaryingLocations(const OutputShaderVersion requestedVersion, std::set<std::string>& requiredExtensions)
+{
+    if ( IsVKSL() ||
+         ( IsESSL() && versionOut_ >= OutputShaderVersion::ESSL310 ) ||
+         ( IsLanguageGLSL(versionOut_) && versionOut_ >= OutputShaderVersion::GLSL410 ) )
+    {
+        /* Locations of shader inputs and outputs are supported by the output version */
+        packedVaryingLocations_ = true;
+    }
+    else if (requestedVersion == OutputShaderVersion::GLSL || requestedVersion == OutputShaderVersion::ESSL)
+    {
+        /* Raise auto-detected version to the first version with locations of shader inputs and outputs */
+        versionOut_ = (IsESSL() ? OutputShaderVersion::ESSL310 : OutputShaderVersion::GLSL410);
+        packedVaryingLocations_ = true;
+    }
+    else if (IsLanguageGLSL(versionOut_) && versionOut_ > OutputShaderVersion::GLSL120 && allowExtensions_)
+    {
+        requiredExtensions.insert(E_GL_ARB_separate_shader_objects);
+        packedVaryingLocations_ = true;
+    }
+    else if (!explicitBinding_)
+        Warning(R_PackedLocationsNotSupported(ToString(versionOut_)));
+}
+
+void GLSLGenerator::WritePackedVaryingVarDecl(VarDecl* varDecl)
+{
+    BeginLn();
+    {
+        Visit(varDecl->declStmntRef->typeSpecifier);
+        Write(" " + varDecl->ident.Final() + ";");
+    }
+    EndLn();
+}
+
+void GLSLGenerator::WritePackedVaryingSlots(const VaryingPacker& packer, const std::string& modifier)
+{
+    const auto& slots = packer.GetSlots();
+
+    /* Write global slot variables */
+    for (const auto& slot : slots)
+    {
+        BeginLn();
+        {
+            if (versionOut_ > OutputShaderVersion::GLSL120)
+            {
+                WriteInterpModifiers(slot.interpModifiers);
+                Separator();
+
+                if (packedVaryingLocations_ || explicitBinding_)
+                {
+                    WriteLayout(
+                        {
+                            [&]() { Write("location = " + std::to_string(slot.slot)); }
+                        }
+                    );
+                }
+            }
+
+            Separator();
+            Write(modifier + " ");
+            Separator();
+
+            WriteDataType(slot.dataType, IsESSL());
+            Separator();
+
+            Write(" " + slot.ident + ";");
+        }
+        EndLn();
+    }
+
+    /* Write packed varyings as global variables */
+    for (const auto& slot : slots)
+    {
+        for (const auto& entry : slot.entries)
+            WritePackedVaryingVarDecl(entry.varDecl);
+    }
+}
+
+void GLSLGenerator::WriteUnpackInputVaryings()
+{
+    for (const auto& slot : inputPacker_.GetSlots())
+    {
+        for (const auto& entry : slot.entries)
+        {
+            const auto swizzle = slot.EntrySwizzle(entry);
+            WriteLn(entry.varDecl->ident.Final() + " = " + slot.ident + (swizzle.empty() ? "" : "." + swizzle) + ";");
+        }
+    }
+}
+
+void GLSLGenerator::WritePackOutputVaryings()
+{
+    for (const auto& slot : outputPacker_.GetSlots())
+    {
+        BeginLn();
+        {
+            Write(slot.ident + " = ");
+
+            if (slot.entries.size() == 1)
+                Write(slot.entries.front().varDecl->ident.Final());
+            else
+            {
+                /* Write type constructor of all packed varyings */
+                WriteDataType(slot.dataType);
+                Write("(");
+
+                for (std::size_t i = 0; i < slot.entries.size(); ++i)
+                {
+                    if (i > 0)
+                        Write(", ");
+                    Write(slot.entries[i].varDecl->ident.Final());
+                }
+
+                Write(")");
+            }
+
+            Write(";");
+        }
+        EndLn();
+    }
+}
+
 /* --- Uniforms --- */
 
 void GLSLGenerator::WriteGlobalUniforms()
@@ -1707,6 +2113,60 @@ void GLSLGenerator::WriteGlobalUniformsParameter(VarDeclStmnt* param)
     EndLn();
 }
 
+void GLSLGenerator::WritePushConstantBlock()
+{
+    const auto& uniformBufferDecls = bufferClassifier_.GetPushConstantBuffers();
+
+    /* Write push constant block header */
+    WriteLineMark(uniformBufferDecls.front());
+
+    BeginLn();
+
+    WriteLayout(
+        {
+            [&]() { Write("std140"); },
+            [&]() { Write("push_constant"); },
+        }
+    );
+
+    if (uniformBufferDecls.size() == 1)
+        Write("uniform " + uniformBufferDecls.front()->ident);
+    else
+        Write("uniform " + nameMangling_.temporaryPrefix + "PushConstants");
+
+    /* Write members of all constant buffers, each with its own "std140" layout at its offset within the block */
+    WriteScopeOpen(false, true);
+    BeginSep();
+    {
+        for (auto uniformBufferDecl : uniformBufferDecls)
+        {
+            const auto offset = bufferClassifier_.PushConstantOffset(uniformBufferDecl);
+
+            PushUniformBufferDecl(uniformBufferDecl);
+            {
+                for (std::size_t i = 0; i < uniformBufferDecl->varMembers.size(); ++i)
+                {
+                    if (i == 0 && offset > 0)
+                    {
+                        PushWritePrefix("layout(offset = " + std::to_string(offset) + ") ");
+                        {
+                            Visit(uniformBufferDecl->varMembers[i]);
+                        }
+                        PopWritePrefix();
+                    }
+                    else
+                        Visit(uniformBufferDecl->varMembers[i]);
+                }
+            }
+            PopUniformBufferDecl();
+        }
+    }
+    EndSep();
+    WriteScopeClose();
+
+    Blank();
+}
+
 /* --- VarIdent --- */
 
 /*
@@ -1835,7 +2295,7 @@ void GLSLGenerator::WriteVarDeclIdentOrSystemValue(VarDecl* varDecl, int arrayIn
 
 /* --- Type denoter --- */
 
-void GLSLGenerator::WriteStorageClasses(const std::set<StorageClass>& storageClasses, const AST* ast)
+void GLSLGenerator::WriteStorageClasses(const EnumSet<StorageClass>& storageClasses, const AST* ast)
 {
     for (auto storage : storageClasses)
     {
@@ -1846,7 +2306,7 @@ void GLSLGenerator::WriteStorageClasses(const std::set<StorageClass>& storageCla
     }
 }
 
-void GLSLGenerator::WriteInterpModifiers(const std::set<InterpModifier>& interpModifiers, const AST* ast)
+void GLSLGenerator::WriteInterpModifiers(const EnumSet<InterpModifier>& interpModifiers, const AST* ast)
 {
     for (auto modifier : interpModifiers)
     {
@@ -1857,18 +2317,18 @@ void GLSLGenerator::WriteInterpModifiers(const std::set<InterpModifier>& interpM
     }
 }
 
-void GLSLGenerator::WriteTypeModifiers(const std::set<TypeModifier>& typeModifiers, const TypeDenoterPtr& typeDenoter)
+void GLSLGenerator::WriteTypeModifiers(const EnumSet<TypeModifier>& typeModifiers, const TypeDenoterPtr& typeDenoter)
 {
     /* Matrix packing alignment can only be written for uniform buffers */
     if (InsideUniformBufferDecl() && typeDenoter && typeDenoter->IsMatrix())
     {
         /* Only write 'row_major' type modifier (column major is the default) */
-        if (typeModifiers.find(TypeModifier::RowMajor) != typeModifiers.end())
+        if (typeModifiers.count(TypeModifier::RowMajor) != 0)
             WriteLayout("row_major");
     }
 
     /* Write const type modifier */
-    if (typeModifiers.find(TypeModifier::Const) != typeModifiers.end())
+    if (typeModifiers.count(TypeModifier::Const) != 0)
         Write("const ");
 }
 
@@ -2061,6 +2521,12 @@ void GLSLGenerator::WriteFunctionEntryPoint(FunctionDecl* ast)
 
 void GLSLGenerator::WriteFunctionEntryPointBody(FunctionDecl* ast)
 {
+    /* Count entry point invocations (the code block is not written with its own scope) */
+    WriteProfileCounter(ast->codeBlock.get());
+
+    /* Write packed input slots to their global variables */
+    WriteUnpackInputVaryings();
+
     /* Write input/output parameters of system values as local variables */
     WriteLocalInputSemantics(ast);
     WriteLocalOutputSemantics(ast);
@@ -2584,16 +3050,22 @@ void GLSLGenerator::WriteBufferDeclStorageBuffer(BufferDecl* bufferDecl)
     if (!bufferTypeKeyword)
         return;
 
+    /* Read-only structured buffers might be declared as uniform buffers with a fixed number of elements */
+    const auto numUniformElements = bufferClassifier_.NumUniformElements(bufferDecl);
+
     /* Write buffer declaration */
     BeginLn();
     {
         WriteLayout(
             {
-                [&]() { Write("std430"); },
+                [&]() { Write(numUniformElements > 0 ? "std140" : "std430"); },
                 [&]() { WriteLayoutBinding(bufferDecl->slotRegisters); },
             }
         );
-        Write(*bufferTypeKeyword + " " + nameMangling_.temporaryPrefix + bufferDecl->ident);
+        if (numUniformElements > 0)
+            Write("uniform " + nameMangling_.temporaryPrefix + bufferDecl->ident);
+        else
+            Write(*bufferTypeKeyword + " " + nameMangling_.temporaryPrefix + bufferDecl->ident);
     }
     EndLn();
 
@@ -2602,14 +3074,18 @@ void GLSLGenerator::WriteBufferDeclStorageBuffer(BufferDecl* bufferDecl)
     {
         BeginLn();
         {
-            /* Write optional memory type qualifier */
-            if (!IsRWBufferType(bufferDecl->GetBufferType()))
+            /* Write optional memory type qualifier (not allowed for uniform buffers) */
+            if (numUniformElements == 0 && !IsRWBufferType(bufferDecl->GetBufferType()))
                 Write("readonly ");
 
             /* Write generic type denoterand identifier */
             auto genericTypeDen = bufferDecl->declStmntRef->typeDenoter->GetGenericTypeDenoter();
             WriteTypeDenoter(*genericTypeDen, IsESSL(), bufferDecl);
-            Write(" " + bufferDecl->ident + "[];");
+
+            if (numUniformElements > 0)
+                Write(" " + bufferDecl->ident + "[" + std::to_string(numUniformElements) + "];");
+            else
+                Write(" " + bufferDecl->ident + "[];");
         }
         EndLn();
     }
@@ -2686,8 +3162,13 @@ void GLSLGenerator::WriteScopedStmnt(Stmnt* ast)
     {
         if (ast->Type() != AST::Types::CodeBlockStmnt)
         {
-            WriteScopeOpen(false, false, alwaysBracedScopes_);
+            /* Single statements with a profiling counter require braces */
+            const bool hasCounter = HasProfileCounter(ast);
+
+            WriteScopeOpen(false, false, (alwaysBracedScopes_ || hasCounter));
             {
+                if (hasCounter)
+                    WriteProfileCounter(ast);
                 Visit(ast);
             }
             WriteScopeClose();
@@ -2697,7 +3178,7 @@ void GLSLGenerator::WriteScopedStmnt(Stmnt* ast)
     }
 }
 
-void GLSLGenerator::WriteArrayIndices(const std::vector<ExprPtr>& arrayDims)
+void GLSLGenerator::WriteArrayIndices(const ExprList& arrayDims)
 {
     for (auto& dim : arrayDims)
     {
@@ -16,6 +16,9 @@
 #include "Token.h"
 #include "ASTEnums.h"
 #include "CiString.h"
+#include "VaryingPacker.h"
+#include "BufferClassifier.h"
+#include "ProfileInstrumenter.h"
 #include <map>
 #include <set>
 #include <vector>
@@ -38,11 +41,28 @@ class GLSLGenerator : public Generator
         
         GLSLGenerator(Log* log);
 
+        // Appends the packing map of all packed input and output varyings to the specified reflection data.
+        void ReflectPackedVaryings(Reflection::ReflectionData& reflectionData) const;
+
+        // Appends the storage classes of all classified constant and structured buffers to the specified reflection data.
+        void ReflectBufferClasses(Reflection::ReflectionData& reflectionData) const;
+
+        // Appends the profiling counter buffer and all its counters to the specified reflection data.
+        void ReflectProfileCounters(Reflection::ReflectionData& reflectionData) const;
+
     private:
         
         // Function callback interface for entries in a layout qualifier.
         using LayoutEntryFunctor = std::function<void()>;
 
+        // Storage of the profiling counters in the output code.
+        enum class ProfileCounterStorage
+        {
+            None,           // Output code is not instrumented.
+            StorageBuffer,  // Counters are incremented with 'atomicAdd' in a storage buffer.
+            AtomicCounters, // Counters are incremented with 'atomicCounterIncrement' in an array of atomic counters.
+        };
+
         /* === Functions === */
 
         void GenerateCodePrimary(
@@ -147,6 +167,18 @@ class GLSLGenerator : public Generator
         void WriteProgramHeaderVersion();
         void WriteProgramHeaderExtension(const std::string& extensionName);
 
+        /* --- Profiling --- */
+
+        // Selects the storage of the profiling counters for the final output version, and may raise the version or add a required extension.
+        void SelectProfileCounterStorage(const OutputShaderVersion requestedVersion, std::set<std::string>& requiredExtensions);
+
+        bool HasProfileCounter(const AST* region) const;
+
+        void WriteProfileCounterBuffer();
+
+        // Writes the increment of the profiling counter of the specified code region, if the code region has a counter.
+        void WriteProfileCounter(const AST* region);
+
         /* --- Layouts --- */
 
         void WriteGlobalLayouts();
@@ -180,11 +212,28 @@ class GLSLGenerator : public Generator
             const FunctionDecl::ParameterStructure& paramStruct, bool writeAsListedExpr = false, const std::string& tempVarIdent = "output"
         );
 
+        /* --- Packed varyings --- */
+
+        void PackVaryings(FunctionDecl* entryPoint, const std::vector<Reflection::PackedVarying>& inputLayout);
+
+        // Selects whether packed slots are declared with explicit locations for the final output version, and may raise the version or add a required extension.
+        void SelectPackedVaryingLocations(const OutputShaderVersion requestedVersion, std::set<std::string>& requiredExtensions);
+
+        // Writes the specified packed varying as global variable without input/output qualifier.
+        void WritePackedVaryingVarDecl(VarDecl* varDecl);
+        void WritePackedVaryingSlots(const VaryingPacker& packer, const std::string& modifier);
+
+        void WriteUnpackInputVaryings();
+        void WritePackOutputVaryings();
+
         /* --- Uniforms --- */
 
         void WriteGlobalUniforms();
         void WriteGlobalUniformsParameter(VarDeclStmnt* param);
 
+        // Writes all constant buffers that have been moved into the push constant block as a single block.
+        void WritePushConstantBlock();
+
         /* --- VarIdent --- */
 
         // Returns the first VarIdent AST node which has a system value semantic, or null if no such AST node was found.
@@ -203,9 +252,9 @@ class GLSLGenerator : public Generator
 
         /* --- Type denoter --- */
 
-        void WriteStorageClasses(const std::set<StorageClass>& storageClasses, const AST* ast = nullptr);
-        void WriteInterpModifiers(const std::set<InterpModifier>& interpModifiers, const AST* ast = nullptr);
-        void WriteTypeModifiers(const std::set<TypeModifier>& typeModifiers, const TypeDenoterPtr& typeDenoter = nullptr);
+        void WriteStorageClasses(const EnumSet<StorageClass>& storageClasses, const AST* ast = nullptr);
+        void WriteInterpModifiers(const EnumSet<InterpModifier>& interpModifiers, const AST* ast = nullptr);
+        void WriteTypeModifiers(const EnumSet<TypeModifier>& typeModifiers, const TypeDenoterPtr& typeDenoter = nullptr);
         void WriteTypeModifiersFrom(const TypeSpecifierPtr& typeSpecifier);
 
         void WriteDataType(DataType dataType, bool writePrecisionSpecifier = false, const AST* ast = nullptr);
@@ -261,7 +310,7 @@ class GLSLGenerator : public Generator
         void WriteParameter(VarDeclStmnt* ast);
         void WriteScopedStmnt(Stmnt* ast);
 
-        void WriteArrayIndices(const std::vector<ExprPtr>& arrayDims);
+        void WriteArrayIndices(const ExprList& arrayDims);
 
         void WriteLiteral(const std::string& value, const BaseTypeDenoter& baseTypeDen, const AST* ast = nullptr);
 
@@ -291,6 +340,18 @@ class GLSLGenerator : public Generator
         bool                                    allowLineMarks_         = false;
         bool                                    compactWrappers_        = true;
         bool                                    alwaysBracedScopes_     = false;
+        bool                                    packVaryings_           = false;
+        bool                                    packedVaryingLocations_ = false;
+
+        VaryingPacker                           inputPacker_;
+        VaryingPacker                           outputPacker_;
+
+        BufferClassifier                        bufferClassifier_;
+
+        ProfileInstrumenter                     profileInstrumenter_;
+        ProfileCounterStorage                   profileCounterStorage_  = ProfileCounterStorage::None;
+        Reflection::BindingSlot                 profileCounterBuffer_   = { "", -1 };
+        std::string                             profileCounterArray_;
 
         bool                                    isInsideInterfaceBlock_ = false;
 };
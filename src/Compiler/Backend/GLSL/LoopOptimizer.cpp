@@ -0,0 +1,910 @@
+/*
+ * LoopOptimizer.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "LoopOptimizer.h"
+#include "ConstExprEvaluator.h"
+#include "ASTFactory.h"
+#include "AST.h"
+#include <algorithm>
+#include <functional>
+
+
+namespace Xsc
+{
+
+
+/*
+ * Internal functions and classes
+ */
+
+// Returns true if the specified intrinsic is free of side effects, and its result does not depend on control flow (e.g. no derivatives).
+static bool IsPureIntrinsic(const Intrinsic intrinsic)
+{
+    switch (intrinsic)
+    {
+        case Intrinsic::Abs:
+        case Intrinsic::ACos:
+        case Intrinsic::All:
+        case Intrinsic::Any:
+        case Intrinsic::AsFloat:
+        case Intrinsic::AsInt:
+        case Intrinsic::AsUInt_1:
+        case Intrinsic::ASin:
+        case Intrinsic::ATan:
+        case Intrinsic::ATan2:
+        case Intrinsic::Ceil:
+        case Intrinsic::Clamp:
+        case Intrinsic::Cos:
+        case Intrinsic::CosH:
+        case Intrinsic::CountBits:
+        case Intrinsic::Cross:
+        case Intrinsic::Degrees:
+        case Intrinsic::Determinant:
+        case Intrinsic::Distance:
+        case Intrinsic::Dot:
+        case Intrinsic::Equal:
+        case Intrinsic::Exp:
+        case Intrinsic::Exp2:
+        case Intrinsic::FaceForward:
+        case Intrinsic::FirstBitHigh:
+        case Intrinsic::FirstBitLow:
+        case Intrinsic::Floor:
+        case Intrinsic::FMA:
+        case Intrinsic::FMod:
+        case Intrinsic::Frac:
+        case Intrinsic::GreaterThan:
+        case Intrinsic::GreaterThanEqual:
+        case Intrinsic::IsFinite:
+        case Intrinsic::IsInf:
+        case Intrinsic::IsNaN:
+        case Intrinsic::LdExp:
+        case Intrinsic::Length:
+        case Intrinsic::Lerp:
+        case Intrinsic::LessThan:
+        case Intrinsic::LessThanEqual:
+        case Intrinsic::Log:
+        case Intrinsic::Log10:
+        case Intrinsic::Log2:
+        case Intrinsic::MAD:
+        case Intrinsic::Max:
+        case Intrinsic::Min:
+        case Intrinsic::Mul:
+        case Intrinsic::Normalize:
+        case Intrinsic::NotEqual:
+        case Intrinsic::Pow:
+        case Intrinsic::Radians:
+        case Intrinsic::Rcp:
+        case Intrinsic::Reflect:
+        case Intrinsic::Refract:
+        case Intrinsic::ReverseBits:
+        case Intrinsic::Round:
+        case Intrinsic::RSqrt:
+        case Intrinsic::Saturate:
+        case Intrinsic::Sign:
+        case Intrinsic::Sin:
+        case Intrinsic::SinH:
+        case Intrinsic::SmoothStep:
+        case Intrinsic::Sqrt:
+        case Intrinsic::Step:
+        case Intrinsic::Tan:
+        case Intrinsic::TanH:
+        case Intrinsic::Transpose:
+        case Intrinsic::Trunc:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Returns the base data type of the specified expression, or DataType::Undefined if the expression has no base type.
+static DataType FetchBaseDataType(Expr& expr)
+{
+    try
+    {
+        if (auto baseTypeDen = expr.GetTypeDenoter()->GetAliased().As<BaseTypeDenoter>())
+            return baseTypeDen->dataType;
+    }
+    catch (const std::exception&)
+    {
+        /* ignore this exception */
+    }
+    return DataType::Undefined;
+}
+
+// Returns true if the specified expression can be evaluated at compile time.
+static bool IsConstExpr(Expr& expr)
+{
+    try
+    {
+        ConstExprEvaluator exprEval;
+        exprEval.EvaluateExpr(
+            expr,
+            [](VarAccessExpr* ast) -> Variant
+            {
+                throw ast;
+            }
+        );
+        return true;
+    }
+    catch (const std::exception&)
+    {
+        /* ignore this exception */
+    }
+    catch (const VarAccessExpr*)
+    {
+        /* ignore variable access */
+    }
+    return false;
+}
+
+// Returns true if the specified expression is not worth to be stored in a temporary (i.e. literals and plain variable accesses).
+static bool IsTrivialExpr(Expr& expr)
+{
+    if (expr.Type() == AST::Types::LiteralExpr)
+        return true;
+
+    if (auto bracketExpr = expr.As<BracketExpr>())
+        return IsTrivialExpr(*bracketExpr->expr);
+
+    if (auto varAccessExpr = expr.As<VarAccessExpr>())
+    {
+        for (auto varIdent = varAccessExpr->varIdent.get(); varIdent != nullptr; varIdent = varIdent->next.get())
+        {
+            if (varIdent->arrayIndices.empty())
+                continue;
+
+            /* Dynamic array indices and matrix row extractions are not trivial */
+            for (const auto& index : varIdent->arrayIndices)
+            {
+                if (index->Type() != AST::Types::LiteralExpr)
+                    return false;
+            }
+
+            try
+            {
+                if (auto baseTypeDen = varIdent->GetExplicitTypeDenoter(false)->GetAliased().As<BaseTypeDenoter>())
+                {
+                    if (IsMatrixType(baseTypeDen->dataType))
+                        return false;
+                }
+            }
+            catch (const std::exception&)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    return false;
+}
+
+// Returns the plain variable (without array indices and members) the specified expression refers to, or null if there is no such variable.
+static VarDecl* FetchPlainVar(Expr& expr)
+{
+    if (auto varAccessExpr = expr.As<VarAccessExpr>())
+    {
+        const auto& varIdent = varAccessExpr->varIdent;
+        if (!varAccessExpr->assignExpr && varIdent->arrayIndices.empty() && !varIdent->next)
+            return varIdent->FetchVarDecl();
+    }
+    return nullptr;
+}
+
+// Returns a copy of the specified literal or plain variable access, or null if the expression is neither of both.
+static ExprPtr CopyOperandExpr(Expr& expr)
+{
+    if (auto literalExpr = expr.As<LiteralExpr>())
+        return ASTFactory::MakeLiteralExpr(literalExpr->dataType, literalExpr->value);
+    if (auto varDecl = FetchPlainVar(expr))
+        return ASTFactory::MakeVarAccessExpr(varDecl->ident, varDecl);
+    return nullptr;
+}
+
+// Collects the variables that are declared or written within the visited AST nodes.
+class LoopVarCollector : public Visitor
+{
+
+    public:
+
+        void Collect(AST* ast)
+        {
+            Visit(ast);
+        }
+
+        std::set<const VarDecl*>    declaredVars;
+        std::set<const VarDecl*>    writtenVars;
+        bool                        hasImpureCalls  = false;
+
+    private:
+
+        void MarkAsWritten(Expr* expr)
+        {
+            if (expr)
+            {
+                if (auto varIdent = expr->FetchVarIdent())
+                {
+                    if (auto varDecl = varIdent->FetchVarDecl())
+                        writtenVars.insert(varDecl);
+                }
+            }
+        }
+
+        void VisitVarDecl(VarDecl* ast, void* args) override
+        {
+            declaredVars.insert(ast);
+            Visitor::VisitVarDecl(ast, args);
+        }
+
+        void VisitVarAccessExpr(VarAccessExpr* ast, void* args) override
+        {
+            if (ast->assignExpr)
+                MarkAsWritten(ast);
+            Visitor::VisitVarAccessExpr(ast, args);
+        }
+
+        void VisitUnaryExpr(UnaryExpr* ast, void* args) override
+        {
+            if (IsLValueOp(ast->op))
+                MarkAsWritten(ast->expr.get());
+            Visitor::VisitUnaryExpr(ast, args);
+        }
+
+        void VisitPostUnaryExpr(PostUnaryExpr* ast, void* args) override
+        {
+            if (IsLValueOp(ast->op))
+                MarkAsWritten(ast->expr.get());
+            Visitor::VisitPostUnaryExpr(ast, args);
+        }
+
+        void VisitFunctionCall(FunctionCall* ast, void* args) override
+        {
+            if (!ast->typeDenoter && !IsPureIntrinsic(ast->intrinsic))
+            {
+                /* Any argument of an impure function might be written (e.g. by member functions) */
+                hasImpureCalls = true;
+                for (const auto& arg : ast->arguments)
+                    MarkAsWritten(arg.get());
+            }
+
+            ast->ForEachOutputArgument(
+                [this](ExprPtr& arg)
+                {
+                    MarkAsWritten(arg.get());
+                }
+            );
+
+            Visitor::VisitFunctionCall(ast, args);
+        }
+
+};
+
+// Calls a functor for each expression within the visited AST nodes (in post-order), which can replace the expression.
+class ExprReplacer : public Visitor
+{
+
+    public:
+
+        using ReplaceFunctor = std::function<void(ExprPtr& expr)>;
+
+        ExprReplacer(const ReplaceFunctor& replace) :
+            replace_ { replace }
+        {
+        }
+
+        void ReplaceExpr(ExprPtr& expr)
+        {
+            if (expr)
+            {
+                Visit(expr);
+                replace_(expr);
+            }
+        }
+
+        void ReplaceExprList(ExprList& exprList)
+        {
+            for (auto& expr : exprList)
+                ReplaceExpr(expr);
+        }
+
+        void ReplaceExprList(std::vector<ExprPtr>& exprList)
+        {
+            for (auto& expr : exprList)
+                ReplaceExpr(expr);
+        }
+
+        void ReplaceStmnt(Stmnt* stmnt)
+        {
+            Visit(stmnt);
+        }
+
+    private:
+
+        void VisitVarIdent(VarIdent* ast, void* args) override
+        {
+            ReplaceExprList(ast->arrayIndices);
+            Visit(ast->next);
+        }
+
+        void VisitFunctionCall(FunctionCall* ast, void* args) override
+        {
+            ReplaceExprList(ast->arguments);
+        }
+
+        void VisitVarDecl(VarDecl* ast, void* args) override
+        {
+            ReplaceExpr(ast->initializer);
+        }
+
+        void VisitForLoopStmnt(ForLoopStmnt* ast, void* args) override
+        {
+            Visit(ast->initStmnt);
+            ReplaceExpr(ast->condition);
+            ReplaceExpr(ast->iteration);
+            Visit(ast->bodyStmnt);
+        }
+
+        void VisitWhileLoopStmnt(WhileLoopStmnt* ast, void* args) override
+        {
+            ReplaceExpr(ast->condition);
+            Visit(ast->bodyStmnt);
+        }
+
+        void VisitDoWhileLoopStmnt(DoWhileLoopStmnt* ast, void* args) override
+        {
+            Visit(ast->bodyStmnt);
+            ReplaceExpr(ast->condition);
+        }
+
+        void VisitIfStmnt(IfStmnt* ast, void* args) override
+        {
+            ReplaceExpr(ast->condition);
+            Visit(ast->bodyStmnt);
+            Visit(ast->elseStmnt);
+        }
+
+        void VisitSwitchStmnt(SwitchStmnt* ast, void* args) override
+        {
+            ReplaceExpr(ast->selector);
+            Visit(ast->cases);
+        }
+
+        void VisitExprStmnt(ExprStmnt* ast, void* args) override
+        {
+            ReplaceExpr(ast->expr);
+        }
+
+        void VisitReturnStmnt(ReturnStmnt* ast, void* args) override
+        {
+            ReplaceExpr(ast->expr);
+        }
+
+        void VisitListExpr(ListExpr* ast, void* args) override
+        {
+            ReplaceExpr(ast->firstExpr);
+            ReplaceExpr(ast->nextExpr);
+        }
+
+        void VisitTernaryExpr(TernaryExpr* ast, void* args) override
+        {
+            ReplaceExpr(ast->condExpr);
+            ReplaceExpr(ast->thenExpr);
+            ReplaceExpr(ast->elseExpr);
+        }
+
+        void VisitBinaryExpr(BinaryExpr* ast, void* args) override
+        {
+            ReplaceExpr(ast->lhsExpr);
+            ReplaceExpr(ast->rhsExpr);
+        }
+
+        void VisitUnaryExpr(UnaryExpr* ast, void* args) override
+        {
+            ReplaceExpr(ast->expr);
+        }
+
+        void VisitPostUnaryExpr(PostUnaryExpr* ast, void* args) override
+        {
+            ReplaceExpr(ast->expr);
+        }
+
+        void VisitBracketExpr(BracketExpr* ast, void* args) override
+        {
+            ReplaceExpr(ast->expr);
+        }
+
+        void VisitSuffixExpr(SuffixExpr* ast, void* args) override
+        {
+            ReplaceExpr(ast->expr);
+        }
+
+        void VisitArrayAccessExpr(ArrayAccessExpr* ast, void* args) override
+        {
+            ReplaceExpr(ast->expr);
+            ReplaceExprList(ast->arrayIndices);
+        }
+
+        void VisitCastExpr(CastExpr* ast, void* args) override
+        {
+            ReplaceExpr(ast->expr);
+        }
+
+        void VisitVarAccessExpr(VarAccessExpr* ast, void* args) override
+        {
+            Visit(ast->varIdent);
+            ReplaceExpr(ast->assignExpr);
+        }
+
+        void VisitInitializerExpr(InitializerExpr* ast, void* args) override
+        {
+            ReplaceExprList(ast->exprs);
+        }
+
+        ReplaceFunctor replace_;
+
+};
+
+
+/*
+ * LoopOptimizer class
+ */
+
+std::vector<LoopOptimizer::Transformation> LoopOptimizer::Optimize(Program& program, const NameMangling& nameMangling)
+{
+    nameMangling_   = (&nameMangling);
+    numTemporaries_ = 0;
+    transformations_.clear();
+    Visit(&program);
+    return std::move(transformations_);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void LoopOptimizer::OptimizeStmntList(std::vector<StmntPtr>& stmnts)
+{
+    for (std::size_t i = 0; i < stmnts.size(); ++i)
+    {
+        switch (stmnts[i]->Type())
+        {
+            case AST::Types::ForLoopStmnt:
+            case AST::Types::WhileLoopStmnt:
+            case AST::Types::DoWhileLoopStmnt:
+            {
+                /* Insert declarations of all temporaries in front of the loop */
+                std::vector<StmntPtr> tempDeclStmnts;
+                OptimizeLoop(*stmnts[i], tempDeclStmnts);
+                stmnts.insert(stmnts.begin() + i, tempDeclStmnts.begin(), tempDeclStmnts.end());
+                i += tempDeclStmnts.size();
+            }
+            break;
+
+            default:
+            break;
+        }
+    }
+}
+
+void LoopOptimizer::OptimizeLoop(Stmnt& loopStmnt, std::vector<StmntPtr>& tempDeclStmnts)
+{
+    /* Collect all variables that are modified within the loop (including its header) */
+    LoopVarCollector collector;
+    collector.Collect(&loopStmnt);
+
+    loopVars_.declaredVars      = std::move(collector.declaredVars);
+    loopVars_.writtenVars       = std::move(collector.writtenVars);
+    loopVars_.hasImpureCalls    = collector.hasImpureCalls;
+
+    if (auto ast = loopStmnt.As<ForLoopStmnt>())
+    {
+        HoistInvariantExprs(ast->condition, tempDeclStmnts);
+        HoistInvariantExprs(ast->iteration, tempDeclStmnts);
+        HoistInvariantsFromStmnt(*ast->bodyStmnt, tempDeclStmnts);
+        ReduceInductionVar(*ast, tempDeclStmnts);
+    }
+    else if (auto ast = loopStmnt.As<WhileLoopStmnt>())
+    {
+        HoistInvariantExprs(ast->condition, tempDeclStmnts);
+        HoistInvariantsFromStmnt(*ast->bodyStmnt, tempDeclStmnts);
+    }
+    else if (auto ast = loopStmnt.As<DoWhileLoopStmnt>())
+    {
+        HoistInvariantsFromStmnt(*ast->bodyStmnt, tempDeclStmnts);
+        HoistInvariantExprs(ast->condition, tempDeclStmnts);
+    }
+}
+
+void LoopOptimizer::HoistInvariantsFromStmnt(Stmnt& stmnt, std::vector<StmntPtr>& tempDeclStmnts)
+{
+    /* Only hoist expressions that are evaluated in each iteration (i.e. no expressions inside of conditional statements) */
+    if (auto ast = stmnt.As<CodeBlockStmnt>())
+    {
+        for (const auto& subStmnt : ast->codeBlock->stmnts)
+            HoistInvariantsFromStmnt(*subStmnt, tempDeclStmnts);
+    }
+    else if (auto ast = stmnt.As<ExprStmnt>())
+        HoistInvariantExprs(ast->expr, tempDeclStmnts);
+    else if (auto ast = stmnt.As<VarDeclStmnt>())
+    {
+        for (const auto& varDecl : ast->varDecls)
+            HoistInvariantExprs(varDecl->initializer, tempDeclStmnts);
+    }
+    else if (auto ast = stmnt.As<IfStmnt>())
+        HoistInvariantExprs(ast->condition, tempDeclStmnts);
+    else if (auto ast = stmnt.As<SwitchStmnt>())
+        HoistInvariantExprs(ast->selector, tempDeclStmnts);
+}
+
+void LoopOptimizer::HoistInvariantExprs(ExprPtr& expr, std::vector<StmntPtr>& tempDeclStmnts)
+{
+    if (!expr)
+        return;
+
+    if (IsInvariantExpr(*expr) && !IsTrivialExpr(*expr) && !IsConstExpr(*expr))
+    {
+        /* Only expressions of scalar, vector, and matrix types can be stored in temporaries */
+        const auto dataType = FetchBaseDataType(*expr);
+        if (IsScalarType(dataType) || IsVectorType(dataType) || IsMatrixType(dataType))
+        {
+            HoistExpr(expr, dataType, tempDeclStmnts);
+            return;
+        }
+    }
+
+    /* Hoist sub expressions, which are evaluated unconditionally */
+    if (auto ast = expr->As<ListExpr>())
+    {
+        HoistInvariantExprs(ast->firstExpr, tempDeclStmnts);
+        HoistInvariantExprs(ast->nextExpr, tempDeclStmnts);
+    }
+    else if (auto ast = expr->As<TernaryExpr>())
+        HoistInvariantExprs(ast->condExpr, tempDeclStmnts);
+    else if (auto ast = expr->As<BinaryExpr>())
+    {
+        HoistInvariantExprs(ast->lhsExpr, tempDeclStmnts);
+        if (!IsLogicalOp(ast->op))
+            HoistInvariantExprs(ast->rhsExpr, tempDeclStmnts);
+    }
+    else if (auto ast = expr->As<UnaryExpr>())
+    {
+        if (!IsLValueOp(ast->op))
+            HoistInvariantExprs(ast->expr, tempDeclStmnts);
+    }
+    else if (auto ast = expr->As<FunctionCallExpr>())
+        HoistInvariantExprList(ast->call->arguments, tempDeclStmnts);
+    else if (auto ast = expr->As<BracketExpr>())
+        HoistInvariantExprs(ast->expr, tempDeclStmnts);
+    else if (auto ast = expr->As<SuffixExpr>())
+        HoistInvariantExprs(ast->expr, tempDeclStmnts);
+    else if (auto ast = expr->As<ArrayAccessExpr>())
+    {
+        HoistInvariantExprs(ast->expr, tempDeclStmnts);
+        HoistInvariantExprList(ast->arrayIndices, tempDeclStmnts);
+    }
+    else if (auto ast = expr->As<CastExpr>())
+        HoistInvariantExprs(ast->expr, tempDeclStmnts);
+    else if (auto ast = expr->As<VarAccessExpr>())
+    {
+        for (auto varIdent = ast->varIdent.get(); varIdent != nullptr; varIdent = varIdent->next.get())
+            HoistInvariantExprList(varIdent->arrayIndices, tempDeclStmnts);
+        HoistInvariantExprs(ast->assignExpr, tempDeclStmnts);
+    }
+    else if (auto ast = expr->As<InitializerExpr>())
+    {
+        for (auto& subExpr : ast->exprs)
+            HoistInvariantExprs(subExpr, tempDeclStmnts);
+    }
+}
+
+void LoopOptimizer::HoistInvariantExprList(ExprList& exprList, std::vector<StmntPtr>& tempDeclStmnts)
+{
+    for (auto& expr : exprList)
+        HoistInvariantExprs(expr, tempDeclStmnts);
+}
+
+void LoopOptimizer::HoistExpr(ExprPtr& expr, const DataType dataType, std::vector<StmntPtr>& tempDeclStmnts)
+{
+    /* Declare temporary with the invariant expression as initializer */
+    const auto ident = MakeTempIdent("inv");
+
+    auto declStmnt  = ASTFactory::MakeVarDeclStmnt(dataType, ident);
+    auto varDecl    = declStmnt->varDecls.front().get();
+    {
+        declStmnt->area         = expr->area;
+        varDecl->area           = expr->area;
+        varDecl->initializer    = expr;
+    }
+    tempDeclStmnts.push_back(declStmnt);
+    localVars_.insert(varDecl);
+
+    transformations_.push_back({ expr, "", ident });
+
+    /* Replace expression by the temporary */
+    expr = ASTFactory::MakeVarAccessExpr(ident, varDecl);
+}
+
+void LoopOptimizer::ReduceInductionVar(ForLoopStmnt& ast, std::vector<StmntPtr>& tempDeclStmnts)
+{
+    /* Loop must declare a single integral induction variable with a literal or variable as initial value */
+    auto initStmnt = (ast.initStmnt ? ast.initStmnt->As<VarDeclStmnt>() : nullptr);
+    if (!initStmnt || initStmnt->varDecls.size() != 1)
+        return;
+
+    auto inductionVar = initStmnt->varDecls.front().get();
+    if (!inductionVar->initializer || !CopyOperandExpr(*inductionVar->initializer))
+        return;
+
+    DataType dataType = DataType::Undefined;
+    if (auto baseTypeDen = inductionVar->GetTypeDenoter()->GetAliased().As<BaseTypeDenoter>())
+        dataType = baseTypeDen->dataType;
+
+    if (dataType != DataType::Int && dataType != DataType::UInt)
+        return;
+
+    /* Iteration must increment or decrement the induction variable by one (e.g. "++i") or by a literal (e.g. "i += 2") */
+    ExprPtr     stepExpr;
+    AssignOp    stepOp      = AssignOp::Undefined;
+
+    if (!ast.iteration)
+        return;
+    else if (auto unaryExpr = ast.iteration->As<UnaryExpr>())
+    {
+        if (FetchPlainVar(*unaryExpr->expr) == inductionVar && IsLValueOp(unaryExpr->op))
+            stepOp = (unaryExpr->op == UnaryOp::Inc ? AssignOp::Add : AssignOp::Sub);
+    }
+    else if (auto postUnaryExpr = ast.iteration->As<PostUnaryExpr>())
+    {
+        if (FetchPlainVar(*postUnaryExpr->expr) == inductionVar && IsLValueOp(postUnaryExpr->op))
+            stepOp = (postUnaryExpr->op == UnaryOp::Inc ? AssignOp::Add : AssignOp::Sub);
+    }
+    else if (auto assignExpr = ast.iteration->As<VarAccessExpr>())
+    {
+        const auto& varIdent = assignExpr->varIdent;
+        if ( varIdent->FetchVarDecl() == inductionVar && varIdent->arrayIndices.empty() && !varIdent->next &&
+             (assignExpr->assignOp == AssignOp::Add || assignExpr->assignOp == AssignOp::Sub) &&
+             assignExpr->assignExpr->Type() == AST::Types::LiteralExpr &&
+             FetchBaseDataType(*assignExpr->assignExpr) == dataType )
+        {
+            stepExpr    = assignExpr->assignExpr;
+            stepOp      = assignExpr->assignOp;
+        }
+    }
+
+    if (stepOp == AssignOp::Undefined)
+        return;
+
+    /* Induction variable must not be modified anywhere else */
+    LoopVarCollector collector;
+    collector.Collect(ast.condition.get());
+    collector.Collect(ast.bodyStmnt.get());
+
+    if (collector.writtenVars.find(inductionVar) != collector.writtenVars.end())
+        return;
+
+    /* Replace all multiplications of the induction variable with the same invariant factor by the same temporary */
+    std::vector<std::pair<std::string, VarDecl*>> reductions;
+
+    ExprReplacer replacer(
+        [&](ExprPtr& expr)
+        {
+            auto binaryExpr = expr->As<BinaryExpr>();
+            if (!binaryExpr || binaryExpr->op != BinaryOp::Mul)
+                return;
+
+            /* Find factor (literal or invariant variable) next to the induction variable */
+            Expr* factor = nullptr;
+            if (FetchPlainVar(*binaryExpr->lhsExpr) == inductionVar)
+                factor = binaryExpr->rhsExpr.get();
+            else if (FetchPlainVar(*binaryExpr->rhsExpr) == inductionVar)
+                factor = binaryExpr->lhsExpr.get();
+            else
+                return;
+
+            if (!CopyOperandExpr(*factor) || !IsInvariantExpr(*factor) || FetchBaseDataType(*factor) != dataType)
+                return;
+
+            auto factorVar = FetchPlainVar(*factor);
+            auto factorKey = (factorVar != nullptr ? factorVar->ident.Final() : factor->As<LiteralExpr>()->value);
+
+            auto it = std::find_if(
+                reductions.begin(), reductions.end(),
+                [&factorKey](const std::pair<std::string, VarDecl*>& entry)
+                {
+                    return (entry.first == factorKey);
+                }
+            );
+
+            VarDecl* tempVar = nullptr;
+
+            if (it == reductions.end())
+            {
+                /* Declare temporary with the initial product (e.g. "int xst_ind0 = 0 * 4;") */
+                const auto ident = MakeTempIdent("ind");
+
+                auto declStmnt = ASTFactory::MakeVarDeclStmnt(dataType, ident);
+                tempVar = declStmnt->varDecls.front().get();
+                {
+                    declStmnt->area         = ast.area;
+                    tempVar->area           = ast.area;
+                    tempVar->initializer    = ASTFactory::MakeBinaryExpr(
+                        CopyOperandExpr(*inductionVar->initializer), BinaryOp::Mul, CopyOperandExpr(*factor)
+                    );
+                }
+                tempDeclStmnts.push_back(declStmnt);
+                localVars_.insert(tempVar);
+
+                /* Append increment of the temporary to the iteration (e.g. "++i, xst_ind0 += 4") */
+                auto updateExpr = ASTFactory::MakeVarAccessExpr(ident, tempVar);
+                {
+                    updateExpr->assignOp = stepOp;
+                    if (stepExpr)
+                        updateExpr->assignExpr = ASTFactory::MakeBinaryExpr(CopyOperandExpr(*stepExpr), BinaryOp::Mul, CopyOperandExpr(*factor));
+                    else
+                        updateExpr->assignExpr = CopyOperandExpr(*factor);
+                }
+                ast.iteration = ASTFactory::MakeListExpr(ast.iteration, updateExpr);
+
+                reductions.push_back({ factorKey, tempVar });
+            }
+            else
+                tempVar = it->second;
+
+            transformations_.push_back({ expr, inductionVar->ident.Final(), tempVar->ident.Final() });
+
+            expr = ASTFactory::MakeVarAccessExpr(tempVar->ident, tempVar);
+        }
+    );
+
+    replacer.ReplaceExpr(ast.condition);
+    replacer.ReplaceStmnt(ast.bodyStmnt.get());
+}
+
+bool LoopOptimizer::IsInvariantExpr(Expr& expr) const
+{
+    if (auto ast = expr.As<VarAccessExpr>())
+        return (!ast->assignExpr && IsInvariantVarIdent(*ast->varIdent));
+
+    if (auto ast = expr.As<BinaryExpr>())
+    {
+        /* Integral divisions are never hoisted, since the divisor might be guarded by the loop condition */
+        if ((ast->op == BinaryOp::Div || ast->op == BinaryOp::Mod) && !IsRealType(FetchBaseDataType(expr)))
+            return false;
+        return (IsInvariantExpr(*ast->lhsExpr) && IsInvariantExpr(*ast->rhsExpr));
+    }
+
+    if (auto ast = expr.As<UnaryExpr>())
+        return (!IsLValueOp(ast->op) && IsInvariantExpr(*ast->expr));
+
+    if (auto ast = expr.As<TernaryExpr>())
+        return (IsInvariantExpr(*ast->condExpr) && IsInvariantExpr(*ast->thenExpr) && IsInvariantExpr(*ast->elseExpr));
+
+    if (auto ast = expr.As<BracketExpr>())
+        return IsInvariantExpr(*ast->expr);
+
+    if (auto ast = expr.As<CastExpr>())
+        return IsInvariantExpr(*ast->expr);
+
+    if (auto ast = expr.As<SuffixExpr>())
+        return IsInvariantExpr(*ast->expr);
+
+    if (auto ast = expr.As<ArrayAccessExpr>())
+    {
+        if (!IsInvariantExpr(*ast->expr))
+            return false;
+        for (const auto& index : ast->arrayIndices)
+        {
+            if (!IsInvariantExpr(*index))
+                return false;
+        }
+        return true;
+    }
+
+    if (auto ast = expr.As<FunctionCallExpr>())
+    {
+        /* Only type constructors and pure intrinsics are invariant */
+        const auto& call = ast->call;
+        if (!call->typeDenoter && !IsPureIntrinsic(call->intrinsic))
+            return false;
+        for (const auto& arg : call->arguments)
+        {
+            if (!IsInvariantExpr(*arg))
+                return false;
+        }
+        return true;
+    }
+
+    return (expr.Type() == AST::Types::LiteralExpr);
+}
+
+bool LoopOptimizer::IsInvariantVarIdent(const VarIdent& varIdent) const
+{
+    if (!IsInvariantVar(varIdent.symbolRef))
+        return false;
+
+    for (auto ident = &varIdent; ident != nullptr; ident = ident->next.get())
+    {
+        for (const auto& index : ident->arrayIndices)
+        {
+            if (!IsInvariantExpr(*index))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool LoopOptimizer::IsInvariantVar(const AST* symbol) const
+{
+    auto varDecl = (symbol != nullptr ? symbol->As<VarDecl>() : nullptr);
+    if (!varDecl)
+        return false;
+
+    /* Variables that are declared or written within the loop are variant */
+    if ( loopVars_.declaredVars.find(varDecl) != loopVars_.declaredVars.end() ||
+         loopVars_.writtenVars.find(varDecl) != loopVars_.writtenVars.end() )
+    {
+        return false;
+    }
+
+    if (localVars_.find(varDecl) != localVars_.end())
+        return true;
+
+    /* Global variables might be written by function calls, unless they are constant or uniform */
+    if (varDecl->bufferDeclRef || (varDecl->declStmntRef && varDecl->declStmntRef->IsConstOrUniform()))
+        return true;
+
+    return !loopVars_.hasImpureCalls;
+}
+
+std::string LoopOptimizer::MakeTempIdent(const std::string& name)
+{
+    return nameMangling_->temporaryPrefix + name + std::to_string(numTemporaries_++);
+}
+
+/* ------- Visit functions ------- */
+
+#define IMPLEMENT_VISIT_PROC(AST_NAME) \
+    void LoopOptimizer::Visit##AST_NAME(AST_NAME* ast, void* args)
+
+IMPLEMENT_VISIT_PROC(CodeBlock)
+{
+    /* Optimize inner loops first */
+    VISIT_DEFAULT(CodeBlock);
+    OptimizeStmntList(ast->stmnts);
+}
+
+IMPLEMENT_VISIT_PROC(SwitchCase)
+{
+    VISIT_DEFAULT(SwitchCase);
+    OptimizeStmntList(ast->stmnts);
+}
+
+IMPLEMENT_VISIT_PROC(FunctionDecl)
+{
+    /* Only optimize reachable functions, since all transformations are reported */
+    if (ast->flags(AST::isReachable))
+    {
+        LoopVarCollector collector;
+        collector.Collect(ast);
+        localVars_ = std::move(collector.declaredVars);
+
+        VISIT_DEFAULT(FunctionDecl);
+
+        localVars_.clear();
+    }
+}
+
+#undef IMPLEMENT_VISIT_PROC
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,112 @@
+/*
+ * LoopOptimizer.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_LOOP_OPTIMIZER_H
+#define XSC_LOOP_OPTIMIZER_H
+
+
+#include <Xsc/Xsc.h>
+#include "Visitor.h"
+#include "ASTEnums.h"
+#include <string>
+#include <vector>
+#include <set>
+
+
+namespace Xsc
+{
+
+
+/*
+Loop optimizer.
+This AST modifier hoists side effect free, loop invariant expressions out of 'for', 'while', and 'do-while' loops into temporaries,
+e.g. "for (...) { x += a * b; }" -> "float xst_inv0 = a * b; for (...) { x += xst_inv0; }",
+and reduces multiplications of integral induction variables with invariant factors to additions,
+e.g. "for (int i = 0; i < n; ++i) { f(i * 4); }" -> "int xst_ind0 = 0 * 4; for (int i = 0; i < n; ++i, xst_ind0 += 4) { f(xst_ind0); }".
+Only expressions that are evaluated in every iteration are hoisted (i.e. not inside of nested statements or conditional operands),
+and texture, derivative, and other intrinsics that depend on control flow or have side effects are never hoisted.
+This must be used after the reference analysis, since only reachable functions are converted.
+*/
+class LoopOptimizer : private Visitor
+{
+
+    public:
+
+        // Transformation of a loop expression.
+        struct Transformation
+        {
+            ExprPtr     expr;           // Original expression (only used for its source area).
+            std::string inductionVar;   // Identifier of the induction variable for strength reductions; empty for hoisted invariants.
+            std::string temporary;      // Identifier of the new temporary variable.
+        };
+
+        // Optimizes all loops in the reachable functions of the specified program, and returns the list of all transformations.
+        std::vector<Transformation> Optimize(Program& program, const NameMangling& nameMangling);
+
+    private:
+
+        // Variables that are declared or written within a loop.
+        struct LoopVars
+        {
+            std::set<const VarDecl*>    declaredVars;
+            std::set<const VarDecl*>    writtenVars;
+            bool                        hasImpureCalls  = false;    // Loop calls functions that may write global variables.
+        };
+
+        /* === Functions === */
+
+        void OptimizeStmntList(std::vector<StmntPtr>& stmnts);
+
+        // Optimizes the specified loop statement, and appends the declarations of all new temporaries.
+        void OptimizeLoop(Stmnt& loopStmnt, std::vector<StmntPtr>& tempDeclStmnts);
+
+        void HoistInvariantsFromStmnt(Stmnt& stmnt, std::vector<StmntPtr>& tempDeclStmnts);
+
+        // Hoists the largest invariant sub expressions of the specified expression, which are evaluated unconditionally.
+        void HoistInvariantExprs(ExprPtr& expr, std::vector<StmntPtr>& tempDeclStmnts);
+        void HoistInvariantExprList(ExprList& exprList, std::vector<StmntPtr>& tempDeclStmnts);
+
+        void HoistExpr(ExprPtr& expr, const DataType dataType, std::vector<StmntPtr>& tempDeclStmnts);
+
+        // Reduces multiplications of the induction variable of the specified 'for'-loop with invariant factors to additions.
+        void ReduceInductionVar(ForLoopStmnt& ast, std::vector<StmntPtr>& tempDeclStmnts);
+
+        bool IsInvariantExpr(Expr& expr) const;
+        bool IsInvariantVarIdent(const VarIdent& varIdent) const;
+        bool IsInvariantVar(const AST* symbol) const;
+
+        // Returns a new temporary identifier with the specified name (e.g. "xst_inv0").
+        std::string MakeTempIdent(const std::string& name);
+
+        /* ----- Visitor implementation ----- */
+
+        DECL_VISIT_PROC( CodeBlock    );
+        DECL_VISIT_PROC( SwitchCase   );
+
+        DECL_VISIT_PROC( FunctionDecl );
+
+        /* === Members === */
+
+        const NameMangling*             nameMangling_   = nullptr;
+        unsigned int                    numTemporaries_ = 0;
+
+        std::set<const VarDecl*>        localVars_;                 // Parameters and local variables of the current function (including temporaries).
+        LoopVars                        loopVars_;                  // Variables of the current loop.
+
+        std::vector<Transformation>     transformations_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,507 @@
+/*
+ * ProfileGuidedOptimizer.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ProfileGuidedOptimizer.h"
+#include "ConstExprEvaluator.h"
+#include "ASTFactory.h"
+#include "AST.h"
+#include <algorithm>
+
+
+namespace Xsc
+{
+
+
+/*
+ * Internal functions and classes
+ */
+
+// Maximal number of iterations of a loop that is unrolled.
+static const Variant::IntType g_maxUnrollIterations = 8;
+
+// Returns the specified source location without the directory of its filename (e.g. "Shaders/Example.hlsl:12:5" -> "Example.hlsl:12:5").
+static std::string NormalizeLocation(const std::string& location)
+{
+    auto pos = location.find_last_of("/\\");
+    return (pos != std::string::npos ? location.substr(pos + 1) : location);
+}
+
+// Returns the base data type of the specified typed AST node, or DataType::Undefined if it has no base type.
+static DataType FetchBaseDataType(TypedAST& ast)
+{
+    try
+    {
+        if (auto baseTypeDen = ast.GetTypeDenoter()->GetAliased().As<BaseTypeDenoter>())
+            return baseTypeDen->dataType;
+    }
+    catch (const std::exception&)
+    {
+        /* ignore this exception */
+    }
+    return DataType::Undefined;
+}
+
+// Evaluates the specified constant expression, and returns true on success.
+static bool EvaluateConstExpr(Expr& expr, Variant& value)
+{
+    try
+    {
+        ConstExprEvaluator exprEval;
+        value = exprEval.EvaluateExpr(
+            expr,
+            [](VarAccessExpr* ast) -> Variant
+            {
+                throw ast;
+            }
+        );
+        return true;
+    }
+    catch (const std::exception&)
+    {
+        /* ignore this exception */
+    }
+    catch (const VarAccessExpr*)
+    {
+        /* ignore variable access */
+    }
+    return false;
+}
+
+// Returns the plain variable (without array indices and members) the specified expression refers to, or null if there is no such variable.
+static VarDecl* FetchPlainVar(Expr& expr)
+{
+    if (auto varAccessExpr = expr.As<VarAccessExpr>())
+    {
+        const auto& varIdent = varAccessExpr->varIdent;
+        if (!varAccessExpr->assignExpr && varIdent->arrayIndices.empty() && !varIdent->next)
+            return varIdent->FetchVarDecl();
+    }
+    return nullptr;
+}
+
+// Returns true if the specified statement leaves the current 'switch' case.
+static bool IsCaseTerminator(const Stmnt& stmnt)
+{
+    if (stmnt.Type() == AST::Types::ReturnStmnt)
+        return true;
+    if (auto ctrlTransferStmnt = stmnt.As<CtrlTransferStmnt>())
+        return (ctrlTransferStmnt->transfer != CtrlTransfer::Undefined);
+    return false;
+}
+
+// Returns the negation of the specified boolean expression (e.g. "a < b" -> "!(a < b)", and "!a" -> "a").
+static ExprPtr MakeNegatedExpr(const ExprPtr& expr)
+{
+    if (auto unaryExpr = expr->As<UnaryExpr>())
+    {
+        if (unaryExpr->op == UnaryOp::LogicalNot)
+            return unaryExpr->expr;
+    }
+    if (expr->Type() == AST::Types::BracketExpr)
+        return ASTFactory::MakeUnaryExpr(UnaryOp::LogicalNot, expr);
+    return ASTFactory::MakeUnaryExpr(UnaryOp::LogicalNot, ASTFactory::MakeBracketExpr(expr));
+}
+
+// Checks whether the visited loop body can be unrolled, i.e. it neither leaves the loop iteration nor writes the induction variable.
+class LoopBodyChecker : public Visitor
+{
+
+    public:
+
+        LoopBodyChecker(const VarDecl* inductionVar) :
+            inductionVar_ { inductionVar }
+        {
+        }
+
+        bool CanUnroll(Stmnt* bodyStmnt)
+        {
+            /* A single variable declaration would be declared multiple times in the same scope */
+            if (bodyStmnt->Type() == AST::Types::VarDeclStmnt)
+                return false;
+
+            Visit(bodyStmnt);
+            return canUnroll_;
+        }
+
+    private:
+
+        void CheckWrite(Expr* expr)
+        {
+            if (expr)
+            {
+                if (auto varIdent = expr->FetchVarIdent())
+                {
+                    if (varIdent->FetchVarDecl() == inductionVar_)
+                        canUnroll_ = false;
+                }
+            }
+        }
+
+        void VisitCtrlTransferStmnt(CtrlTransferStmnt* ast, void* args) override
+        {
+            if (ast->transfer == CtrlTransfer::Break || ast->transfer == CtrlTransfer::Continue)
+                canUnroll_ = false;
+        }
+
+        void VisitVarAccessExpr(VarAccessExpr* ast, void* args) override
+        {
+            if (ast->assignExpr)
+                CheckWrite(ast);
+            Visitor::VisitVarAccessExpr(ast, args);
+        }
+
+        void VisitUnaryExpr(UnaryExpr* ast, void* args) override
+        {
+            if (IsLValueOp(ast->op))
+                CheckWrite(ast->expr.get());
+            Visitor::VisitUnaryExpr(ast, args);
+        }
+
+        void VisitPostUnaryExpr(PostUnaryExpr* ast, void* args) override
+        {
+            if (IsLValueOp(ast->op))
+                CheckWrite(ast->expr.get());
+            Visitor::VisitPostUnaryExpr(ast, args);
+        }
+
+        void VisitFunctionCall(FunctionCall* ast, void* args) override
+        {
+            ast->ForEachOutputArgument(
+                [this](ExprPtr& arg)
+                {
+                    CheckWrite(arg.get());
+                }
+            );
+            Visitor::VisitFunctionCall(ast, args);
+        }
+
+    private:
+
+        const VarDecl*  inductionVar_   = nullptr;
+        bool            canUnroll_      = true;
+
+};
+
+
+/*
+ * ProfileGuidedOptimizer class
+ */
+
+std::vector<ProfileGuidedOptimizer::Transformation> ProfileGuidedOptimizer::Optimize(Program& program, const std::vector<ProfileCount>& profileCounts)
+{
+    /* Accumulate execution counts of the same source location (e.g. from multiple profiling runs) */
+    counts_.clear();
+    maxCount_ = 0;
+
+    for (const auto& profileCount : profileCounts)
+    {
+        auto& count = counts_[NormalizeLocation(profileCount.location)];
+        count += profileCount.count;
+        maxCount_ = std::max(maxCount_, count);
+    }
+
+    transformations_.clear();
+
+    if (!counts_.empty())
+        Visit(&program);
+
+    return std::move(transformations_);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void ProfileGuidedOptimizer::OptimizeStmntList(std::vector<StmntPtr>& stmnts)
+{
+    for (auto& stmnt : stmnts)
+    {
+        switch (stmnt->Type())
+        {
+            case AST::Types::IfStmnt:
+                ReorderBranches(stmnt);
+                break;
+
+            case AST::Types::SwitchStmnt:
+                ReorderSwitchCases(stmnt);
+                break;
+
+            case AST::Types::ForLoopStmnt:
+                if (auto unrolledStmnt = UnrollLoop(stmnt))
+                    stmnt = unrolledStmnt;
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+void ProfileGuidedOptimizer::ReorderBranches(const StmntPtr& stmnt)
+{
+    /* Walk along the 'else if' chain, since only the last 'if' statement has a plain 'else' branch */
+    auto ifStmnt = stmnt->As<IfStmnt>();
+    while (ifStmnt && ifStmnt->elseStmnt)
+    {
+        auto elseStmnt = ifStmnt->elseStmnt.get();
+        if (auto nextIfStmnt = elseStmnt->bodyStmnt->As<IfStmnt>())
+        {
+            ifStmnt = nextIfStmnt;
+            continue;
+        }
+
+        /* Swap branches if the 'else' branch is executed more frequently, and the condition can be negated */
+        unsigned long long ifCount = 0, elseCount = 0;
+        if ( FindCount(ifStmnt, ifCount) && FindCount(elseStmnt, elseCount) && elseCount > ifCount &&
+             FetchBaseDataType(*ifStmnt->condition) == DataType::Bool )
+        {
+            ifStmnt->condition = MakeNegatedExpr(ifStmnt->condition);
+            std::swap(ifStmnt->bodyStmnt, elseStmnt->bodyStmnt);
+
+            Transformation transformation;
+            {
+                transformation.type         = Transformation::Types::ReorderedBranches;
+                transformation.stmnt        = stmnt;
+                transformation.count        = elseCount;
+                transformation.otherCount   = ifCount;
+            }
+            transformations_.push_back(transformation);
+        }
+
+        break;
+    }
+}
+
+void ProfileGuidedOptimizer::ReorderSwitchCases(const StmntPtr& stmnt)
+{
+    auto switchStmnt = stmnt->As<SwitchStmnt>();
+    if (!switchStmnt || switchStmnt->cases.size() < 2)
+        return;
+
+    /* Group cases into units, which consist of all empty cases followed by one case that must not fall through */
+    struct CaseUnit
+    {
+        std::vector<SwitchCasePtr>  cases;
+        unsigned long long          count   = 0;
+    };
+
+    std::vector<CaseUnit> units;
+    CaseUnit unit;
+
+    for (const auto& switchCase : switchStmnt->cases)
+    {
+        unit.cases.push_back(switchCase);
+        if (!switchCase->stmnts.empty())
+        {
+            if (!IsCaseTerminator(*switchCase->stmnts.back()) || !FindCount(switchCase.get(), unit.count))
+                return;
+            units.push_back(std::move(unit));
+            unit = CaseUnit();
+        }
+    }
+
+    if (!unit.cases.empty() || units.size() < 2)
+        return;
+
+    /* Order units by their execution count (the order of equally frequent units is kept) */
+    std::stable_sort(
+        units.begin(), units.end(),
+        [](const CaseUnit& lhs, const CaseUnit& rhs)
+        {
+            return (lhs.count > rhs.count);
+        }
+    );
+
+    std::vector<SwitchCasePtr> cases;
+    for (const auto& u : units)
+        cases.insert(cases.end(), u.cases.begin(), u.cases.end());
+
+    if (cases != switchStmnt->cases)
+    {
+        switchStmnt->cases = std::move(cases);
+
+        Transformation transformation;
+        {
+            transformation.type         = Transformation::Types::ReorderedSwitchCases;
+            transformation.stmnt        = stmnt;
+            transformation.numElements  = switchStmnt->cases.size();
+        }
+        transformations_.push_back(transformation);
+    }
+}
+
+StmntPtr ProfileGuidedOptimizer::UnrollLoop(const StmntPtr& stmnt)
+{
+    auto ast = stmnt->As<ForLoopStmnt>();
+    if (!ast || !ast->condition || !ast->iteration)
+        return nullptr;
+
+    /* Loop must be hot, and must not be marked with the [loop] attribute */
+    unsigned long long count = 0;
+    if (!FindCount(ast, count) || count == 0 || count * 10 < maxCount_)
+        return nullptr;
+
+    for (const auto& attrib : ast->attribs)
+    {
+        if (attrib->attributeType == AttributeType::Loop)
+            return nullptr;
+    }
+
+    /* Loop must declare a single integral induction variable with a constant initial value */
+    auto initStmnt = (ast->initStmnt ? ast->initStmnt->As<VarDeclStmnt>() : nullptr);
+    if (!initStmnt || initStmnt->varDecls.size() != 1)
+        return nullptr;
+
+    auto inductionVar = initStmnt->varDecls.front().get();
+
+    const auto dataType = FetchBaseDataType(*inductionVar);
+    if (dataType != DataType::Int && dataType != DataType::UInt)
+        return nullptr;
+
+    Variant initValue;
+    if (!inductionVar->initializer || !EvaluateConstExpr(*inductionVar->initializer, initValue))
+        return nullptr;
+
+    /* Condition must compare the induction variable with a constant (e.g. "i < 4") */
+    auto condExpr = ast->condition->As<BinaryExpr>();
+    if (!condExpr || FetchPlainVar(*condExpr->lhsExpr) != inductionVar)
+        return nullptr;
+
+    Variant limitValue;
+    if (!EvaluateConstExpr(*condExpr->rhsExpr, limitValue))
+        return nullptr;
+
+    /* Iteration must increment or decrement the induction variable by one (e.g. "++i") or by a literal (e.g. "i += 2") */
+    Variant::IntType step = 0;
+
+    if (auto unaryExpr = ast->iteration->As<UnaryExpr>())
+    {
+        if (FetchPlainVar(*unaryExpr->expr) == inductionVar && IsLValueOp(unaryExpr->op))
+            step = (unaryExpr->op == UnaryOp::Inc ? 1 : -1);
+    }
+    else if (auto postUnaryExpr = ast->iteration->As<PostUnaryExpr>())
+    {
+        if (FetchPlainVar(*postUnaryExpr->expr) == inductionVar && IsLValueOp(postUnaryExpr->op))
+            step = (postUnaryExpr->op == UnaryOp::Inc ? 1 : -1);
+    }
+    else if (auto assignExpr = ast->iteration->As<VarAccessExpr>())
+    {
+        const auto& varIdent = assignExpr->varIdent;
+        Variant stepValue;
+        if ( varIdent->FetchVarDecl() == inductionVar && varIdent->arrayIndices.empty() && !varIdent->next &&
+             (assignExpr->assignOp == AssignOp::Add || assignExpr->assignOp == AssignOp::Sub) &&
+             assignExpr->assignExpr->Type() == AST::Types::LiteralExpr &&
+             EvaluateConstExpr(*assignExpr->assignExpr, stepValue) )
+        {
+            step = (assignExpr->assignOp == AssignOp::Add ? stepValue.ToInt() : -stepValue.ToInt());
+        }
+    }
+
+    if (step == 0)
+        return nullptr;
+
+    /* Determine the number of iterations by simulating the loop */
+    const auto limit = limitValue.ToInt();
+    Variant::IntType numIterations = 0;
+
+    for (auto i = initValue.ToInt(); numIterations <= g_maxUnrollIterations; i += step, ++numIterations)
+    {
+        /* Stop simulation if an unsigned induction variable would wrap around */
+        if (dataType == DataType::UInt && i < 0)
+            return nullptr;
+
+        bool condition = false;
+        switch (condExpr->op)
+        {
+            case BinaryOp::Less:            condition = (i <  limit); break;
+            case BinaryOp::LessEqual:       condition = (i <= limit); break;
+            case BinaryOp::Greater:         condition = (i >  limit); break;
+            case BinaryOp::GreaterEqual:    condition = (i >= limit); break;
+            case BinaryOp::NotEqual:        condition = (i != limit); break;
+            default:                        return nullptr;
+        }
+
+        if (!condition)
+            break;
+    }
+
+    if (numIterations < 1 || numIterations > g_maxUnrollIterations)
+        return nullptr;
+
+    /* Loop body must not leave an iteration or write the induction variable */
+    LoopBodyChecker checker(inductionVar);
+    if (!checker.CanUnroll(ast->bodyStmnt.get()))
+        return nullptr;
+
+    /* Replace loop by a code block with the initialization, and each iteration followed by the increment of the induction variable */
+    std::vector<StmntPtr> stmnts;
+    stmnts.push_back(ast->initStmnt);
+
+    for (Variant::IntType i = 0; i < numIterations; ++i)
+    {
+        if (i > 0)
+            stmnts.push_back(ASTFactory::MakeExprStmnt(ast->iteration));
+        stmnts.push_back(ast->bodyStmnt);
+    }
+
+    Transformation transformation;
+    {
+        transformation.type         = Transformation::Types::UnrolledLoop;
+        transformation.stmnt        = stmnt;
+        transformation.numElements  = static_cast<std::size_t>(numIterations);
+        transformation.count        = count;
+    }
+    transformations_.push_back(transformation);
+
+    return ASTFactory::MakeCodeBlockStmnt(stmnts);
+}
+
+bool ProfileGuidedOptimizer::FindCount(const AST* ast, unsigned long long& count) const
+{
+    auto it = counts_.find(NormalizeLocation(ast->area.Pos().ToString()));
+    if (it != counts_.end())
+    {
+        count = it->second;
+        return true;
+    }
+    return false;
+}
+
+/* ------- Visit functions ------- */
+
+#define IMPLEMENT_VISIT_PROC(AST_NAME) \
+    void ProfileGuidedOptimizer::Visit##AST_NAME(AST_NAME* ast, void* args)
+
+IMPLEMENT_VISIT_PROC(CodeBlock)
+{
+    /* Optimize inner statements first */
+    VISIT_DEFAULT(CodeBlock);
+    OptimizeStmntList(ast->stmnts);
+}
+
+IMPLEMENT_VISIT_PROC(SwitchCase)
+{
+    VISIT_DEFAULT(SwitchCase);
+    OptimizeStmntList(ast->stmnts);
+}
+
+IMPLEMENT_VISIT_PROC(FunctionDecl)
+{
+    /* Only optimize reachable functions, since all transformations are reported */
+    if (ast->flags(AST::isReachable))
+        VISIT_DEFAULT(FunctionDecl);
+}
+
+#undef IMPLEMENT_VISIT_PROC
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
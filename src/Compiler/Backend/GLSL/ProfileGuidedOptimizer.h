@@ -0,0 +1,95 @@
+/*
+ * ProfileGuidedOptimizer.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_PROFILE_GUIDED_OPTIMIZER_H
+#define XSC_PROFILE_GUIDED_OPTIMIZER_H
+
+
+#include <Xsc/Xsc.h>
+#include "Visitor.h"
+#include <string>
+#include <vector>
+#include <map>
+
+
+namespace Xsc
+{
+
+
+/*
+Profile-guided optimizer.
+This AST modifier uses the execution counts of code regions (see ProfileInstrumenter) to move the more frequent 'else' branch in front of the 'if' branch,
+to order 'switch' cases by their execution frequency, and to unroll hot 'for'-loops with a small constant number of iterations.
+Execution counts are identified by the source location of the 'if', 'else', 'case', and loop statements (the directory of the filename is ignored),
+so a profile of one shader permutation can be applied to all permutations of the same source. Unknown locations are ignored.
+This must be used after the reference analysis, since only reachable functions are converted.
+*/
+class ProfileGuidedOptimizer : private Visitor
+{
+
+    public:
+
+        // Transformation of a statement.
+        struct Transformation
+        {
+            enum class Types
+            {
+                ReorderedBranches,      // 'else' branch moved in front of the 'if' branch.
+                ReorderedSwitchCases,   // 'switch' cases ordered by execution frequency.
+                UnrolledLoop,           // 'for'-loop unrolled.
+            };
+
+            Types               type;
+            StmntPtr            stmnt;              // Original statement (only used for its source area).
+            std::size_t         numElements = 0;    // Number of reordered cases, or number of unrolled iterations.
+            unsigned long long  count       = 0;    // Execution count of the moved 'else' branch, or of the unrolled loop body.
+            unsigned long long  otherCount  = 0;    // Execution count of the 'if' branch.
+        };
+
+        // Optimizes all reachable functions of the specified program with the specified execution counts, and returns the list of all transformations.
+        std::vector<Transformation> Optimize(Program& program, const std::vector<ProfileCount>& profileCounts);
+
+    private:
+
+        /* === Functions === */
+
+        void OptimizeStmntList(std::vector<StmntPtr>& stmnts);
+
+        void ReorderBranches(const StmntPtr& stmnt);
+        void ReorderSwitchCases(const StmntPtr& stmnt);
+
+        // Returns the unrolled statement of the specified 'for'-loop, or null if the loop is not unrolled.
+        StmntPtr UnrollLoop(const StmntPtr& stmnt);
+
+        // Returns true if an execution count for the source location of the specified AST node is available.
+        bool FindCount(const AST* ast, unsigned long long& count) const;
+
+        /* ----- Visitor implementation ----- */
+
+        DECL_VISIT_PROC( CodeBlock    );
+        DECL_VISIT_PROC( SwitchCase   );
+
+        DECL_VISIT_PROC( FunctionDecl );
+
+        /* === Members === */
+
+        std::map<std::string, unsigned long long>   counts_;            // Accumulated execution counts by source location.
+        unsigned long long                          maxCount_       = 0;
+
+        std::vector<Transformation>                 transformations_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,137 @@
+/*
+ * ProfileInstrumenter.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ProfileInstrumenter.h"
+#include "AST.h"
+#include <algorithm>
+
+
+namespace Xsc
+{
+
+
+void ProfileInstrumenter::AssignCounters(Program& program)
+{
+    counterIndices_.clear();
+    counters_.clear();
+    freeSlot_ = 0;
+    Visit(&program);
+}
+
+int ProfileInstrumenter::FindCounter(const AST* region) const
+{
+    auto it = counterIndices_.find(region);
+    return (it != counterIndices_.end() ? it->second : -1);
+}
+
+void ProfileInstrumenter::Reflect(std::vector<Reflection::ProfileCounter>& counters) const
+{
+    counters.insert(counters.end(), counters_.begin(), counters_.end());
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void ProfileInstrumenter::AddCounter(const Reflection::ProfileCounterType type, const AST* region, const AST* locationAST)
+{
+    Reflection::ProfileCounter counter;
+    {
+        counter.index       = static_cast<unsigned int>(counters_.size());
+        counter.type        = type;
+        counter.function    = (funcDecl_ != nullptr ? funcDecl_->ident.Original() : "");
+        counter.location    = locationAST->area.Pos().ToString();
+    }
+    counterIndices_[region] = static_cast<int>(counter.index);
+    counters_.push_back(counter);
+}
+
+void ProfileInstrumenter::AddBodyCounter(const Reflection::ProfileCounterType type, const Stmnt* bodyStmnt, const AST* locationAST)
+{
+    if (bodyStmnt)
+    {
+        /* Bodies in braces are identified by their code block, which is written with the scope */
+        if (auto codeBlockStmnt = bodyStmnt->As<CodeBlockStmnt>())
+            AddCounter(type, codeBlockStmnt->codeBlock.get(), locationAST);
+        else
+            AddCounter(type, bodyStmnt, locationAST);
+    }
+}
+
+/* ------- Visit functions ------- */
+
+#define IMPLEMENT_VISIT_PROC(AST_NAME) \
+    void ProfileInstrumenter::Visit##AST_NAME(AST_NAME* ast, void* args)
+
+IMPLEMENT_VISIT_PROC(SwitchCase)
+{
+    /* Empty cases fall through to the next case, which has its own counter */
+    if (!ast->stmnts.empty())
+        AddCounter(Reflection::ProfileCounterType::Branch, ast, ast);
+    VISIT_DEFAULT(SwitchCase);
+}
+
+IMPLEMENT_VISIT_PROC(Register)
+{
+    /* Keep track of all used slots, to select a slot for the counter buffer that does not collide with any other resource */
+    freeSlot_ = std::max(freeSlot_, ast->slot + 1);
+}
+
+IMPLEMENT_VISIT_PROC(FunctionDecl)
+{
+    if (ast->flags(AST::isReachable) && ast->codeBlock)
+    {
+        funcDecl_ = ast;
+        {
+            AddCounter(Reflection::ProfileCounterType::Function, ast->codeBlock.get(), ast);
+            VISIT_DEFAULT(FunctionDecl);
+        }
+        funcDecl_ = nullptr;
+    }
+}
+
+IMPLEMENT_VISIT_PROC(ForLoopStmnt)
+{
+    AddBodyCounter(Reflection::ProfileCounterType::Loop, ast->bodyStmnt.get(), ast);
+    VISIT_DEFAULT(ForLoopStmnt);
+}
+
+IMPLEMENT_VISIT_PROC(WhileLoopStmnt)
+{
+    AddBodyCounter(Reflection::ProfileCounterType::Loop, ast->bodyStmnt.get(), ast);
+    VISIT_DEFAULT(WhileLoopStmnt);
+}
+
+IMPLEMENT_VISIT_PROC(DoWhileLoopStmnt)
+{
+    AddBodyCounter(Reflection::ProfileCounterType::Loop, ast->bodyStmnt.get(), ast);
+    VISIT_DEFAULT(DoWhileLoopStmnt);
+}
+
+IMPLEMENT_VISIT_PROC(IfStmnt)
+{
+    AddBodyCounter(Reflection::ProfileCounterType::Branch, ast->bodyStmnt.get(), ast);
+    VISIT_DEFAULT(IfStmnt);
+}
+
+IMPLEMENT_VISIT_PROC(ElseStmnt)
+{
+    /* An 'else if' is counted by the body of the nested 'if' statement */
+    if (ast->bodyStmnt && ast->bodyStmnt->Type() != AST::Types::IfStmnt)
+        AddBodyCounter(Reflection::ProfileCounterType::Branch, ast->bodyStmnt.get(), ast);
+    VISIT_DEFAULT(ElseStmnt);
+}
+
+#undef IMPLEMENT_VISIT_PROC
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,96 @@
+/*
+ * ProfileInstrumenter.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_PROFILE_INSTRUMENTER_H
+#define XSC_PROFILE_INSTRUMENTER_H
+
+
+#include <Xsc/Xsc.h>
+#include "Visitor.h"
+#include <map>
+#include <vector>
+
+
+namespace Xsc
+{
+
+
+/*
+Profiling instrumenter.
+This AST visitor assigns an execution counter to the body of each reachable function, to each 'if'/'else' body and 'switch' case,
+and to each loop body. The AST is not modified: the GLSL generator writes the increment of a counter at the beginning of the respective code region.
+Code regions are identified by their code block (for bodies in braces and function bodies), or by their single body statement.
+This must be used after the reference analysis, since only reachable functions are instrumented.
+*/
+class ProfileInstrumenter : private Visitor
+{
+
+    public:
+
+        // Assigns the counters to all code regions in the reachable functions of the specified program.
+        void AssignCounters(Program& program);
+
+        // Returns the index of the counter of the specified code region, or -1 if the code region has no counter.
+        int FindCounter(const AST* region) const;
+
+        // Appends all counters to the specified reflection output.
+        void Reflect(std::vector<Reflection::ProfileCounter>& counters) const;
+
+        // Returns the number of assigned counters.
+        inline std::size_t NumCounters() const
+        {
+            return counters_.size();
+        }
+
+        // Returns the first register slot that is not used by any resource of the program.
+        inline int GetFreeSlot() const
+        {
+            return freeSlot_;
+        }
+
+    private:
+
+        /* === Functions === */
+
+        // Adds a counter for the specified code region, whose source location is taken from the specified statement or declaration.
+        void AddCounter(const Reflection::ProfileCounterType type, const AST* region, const AST* locationAST);
+
+        // Adds a counter for the specified body statement.
+        void AddBodyCounter(const Reflection::ProfileCounterType type, const Stmnt* bodyStmnt, const AST* locationAST);
+
+        /* ----- Visitor implementation ----- */
+
+        DECL_VISIT_PROC( SwitchCase       );
+        DECL_VISIT_PROC( Register         );
+
+        DECL_VISIT_PROC( FunctionDecl     );
+
+        DECL_VISIT_PROC( ForLoopStmnt     );
+        DECL_VISIT_PROC( WhileLoopStmnt   );
+        DECL_VISIT_PROC( DoWhileLoopStmnt );
+        DECL_VISIT_PROC( IfStmnt          );
+        DECL_VISIT_PROC( ElseStmnt        );
+
+        /* === Members === */
+
+        std::map<const AST*, int>               counterIndices_;
+        std::vector<Reflection::ProfileCounter> counters_;
+
+        const FunctionDecl*                     funcDecl_       = nullptr;  // Function of the current code region.
+        int                                     freeSlot_       = 0;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,556 @@
+/*
+ * SLPVectorizer.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "SLPVectorizer.h"
+#include "AST.h"
+#include <algorithm>
+#include <cstdint>
+
+
+namespace Xsc
+{
+
+
+std::vector<SLPVectorizer::Merge> SLPVectorizer::Vectorize(Program& program)
+{
+    merges_.clear();
+    Visit(&program);
+    return std::move(merges_);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+// Returns the index of the specified single vector component (e.g. 1 for "y" or "g"), or -1 if the identifier is not a single vector component.
+static int VectorComponentIndex(const VarIdent& varIdent)
+{
+    if (varIdent.symbolRef == nullptr && varIdent.ident.size() == 1 && varIdent.arrayIndices.empty() && !varIdent.next)
+    {
+        const std::string components[] = { "xyzw", "rgba" };
+        for (const auto& set : components)
+        {
+            auto pos = set.find(varIdent.ident.front());
+            if (pos != std::string::npos)
+                return static_cast<int>(pos);
+        }
+    }
+    return -1;
+}
+
+// Returns the data type of the specified expression, if it is a non-boolean scalar type, or DataType::Undefined otherwise.
+static DataType FetchScalarDataType(Expr& expr)
+{
+    try
+    {
+        if (auto baseTypeDen = expr.GetTypeDenoter()->GetAliased().As<BaseTypeDenoter>())
+        {
+            const auto dataType = baseTypeDen->dataType;
+            if (IsScalarType(dataType) && !IsBooleanType(dataType))
+                return dataType;
+        }
+    }
+    catch (const std::exception&)
+    {
+        /* ignore this exception */
+    }
+    return DataType::Undefined;
+}
+
+// Returns true if the specified identifier (without its successors) has a vector type.
+static bool IsVectorVarIdent(VarIdent& varIdent)
+{
+    try
+    {
+        if (auto baseTypeDen = varIdent.GetExplicitTypeDenoter(false)->GetAliased().As<BaseTypeDenoter>())
+            return IsVectorType(baseTypeDen->dataType);
+    }
+    catch (const std::exception&)
+    {
+        /* ignore this exception */
+    }
+    return false;
+}
+
+/*
+Appends the signature of the specified identifier chain up to (but excluding) the identifier 'last' to the shape,
+and returns false if any array index is not a literal (array indices must be equal and free of side effects for all lanes).
+*/
+static bool AppendVarIdentShape(const VarIdent* varIdent, const VarIdent* last, std::string& shape)
+{
+    for (; varIdent != nullptr && varIdent != last; varIdent = varIdent->next.get())
+    {
+        shape += varIdent->ident;
+        shape += '@';
+        shape += std::to_string(reinterpret_cast<std::uintptr_t>(varIdent->symbolRef));
+
+        for (const auto& index : varIdent->arrayIndices)
+        {
+            if (auto literalExpr = index->As<LiteralExpr>())
+                shape += '[' + literalExpr->value + ']';
+            else
+                return false;
+        }
+
+        shape += '.';
+    }
+    return true;
+}
+
+// Returns true if the specified intrinsic is applied to each vector component independently.
+static bool IsComponentWiseIntrinsic(const Intrinsic intrinsic, const DataType dataType)
+{
+    switch (intrinsic)
+    {
+        case Intrinsic::Abs:
+        case Intrinsic::Clamp:
+        case Intrinsic::Max:
+        case Intrinsic::Min:
+            return true;
+
+        case Intrinsic::Ceil:
+        case Intrinsic::Cos:
+        case Intrinsic::Exp:
+        case Intrinsic::Exp2:
+        case Intrinsic::Floor:
+        case Intrinsic::Frac:
+        case Intrinsic::Lerp:
+        case Intrinsic::Log:
+        case Intrinsic::Log2:
+        case Intrinsic::Pow:
+        case Intrinsic::Round:
+        case Intrinsic::RSqrt:
+        case Intrinsic::Saturate:
+        case Intrinsic::Sin:
+        case Intrinsic::SmoothStep:
+        case Intrinsic::Sqrt:
+        case Intrinsic::Step:
+        case Intrinsic::Tan:
+        case Intrinsic::Trunc:
+            return IsRealType(dataType);
+
+        default:
+            return false;
+    }
+}
+
+// Returns true if the specified argument of an intrinsic can be a scalar, while other arguments are vectors (e.g. "min(v, 0)").
+static bool IsScalarArgumentAllowed(const Intrinsic intrinsic, std::size_t argIndex)
+{
+    switch (intrinsic)
+    {
+        case Intrinsic::Clamp:
+            return (argIndex >= 1);
+        case Intrinsic::Lerp:
+            return (argIndex == 2);
+        case Intrinsic::Max:
+        case Intrinsic::Min:
+            return (argIndex == 1);
+        case Intrinsic::SmoothStep:
+            return (argIndex <= 1);
+        case Intrinsic::Step:
+            return (argIndex == 0);
+        default:
+            return false;
+    }
+}
+
+// Returns the swizzle of the specified vector components (e.g. "xz").
+static std::string MakeSwizzle(const std::vector<VarIdent*>& components)
+{
+    const std::string colorSet = "rgba";
+
+    std::string swizzle;
+    for (auto component : components)
+        swizzle += component->ident;
+
+    /* Components of the "xyzw" and "rgba" sets can not be mixed */
+    if (swizzle.find_first_not_of(colorSet) != std::string::npos)
+    {
+        for (auto& chr : swizzle)
+        {
+            auto pos = colorSet.find(chr);
+            if (pos != std::string::npos)
+                chr = "xyzw"[pos];
+        }
+    }
+
+    return swizzle;
+}
+
+// Resets the buffered type denoters of the specified (vectorized) expression tree.
+static void ResetTypeDenoters(VarIdent* varIdent);
+
+static void ResetTypeDenoters(Expr* expr)
+{
+    if (!expr)
+        return;
+
+    expr->ResetTypeDenoter();
+
+    if (auto ast = expr->As<BracketExpr>())
+        ResetTypeDenoters(ast->expr.get());
+    else if (auto ast = expr->As<UnaryExpr>())
+        ResetTypeDenoters(ast->expr.get());
+    else if (auto ast = expr->As<BinaryExpr>())
+    {
+        ResetTypeDenoters(ast->lhsExpr.get());
+        ResetTypeDenoters(ast->rhsExpr.get());
+    }
+    else if (auto ast = expr->As<FunctionCallExpr>())
+    {
+        ast->call->ResetTypeDenoter();
+        for (const auto& arg : ast->call->arguments)
+            ResetTypeDenoters(arg.get());
+    }
+    else if (auto ast = expr->As<VarAccessExpr>())
+    {
+        ResetTypeDenoters(ast->varIdent.get());
+        ResetTypeDenoters(ast->assignExpr.get());
+    }
+}
+
+static void ResetTypeDenoters(VarIdent* varIdent)
+{
+    for (; varIdent != nullptr; varIdent = varIdent->next.get())
+        varIdent->ResetTypeDenoter();
+}
+
+void SLPVectorizer::VectorizeStmntList(std::vector<StmntPtr>& stmnts)
+{
+    for (std::size_t i = 0; i + 1 < stmnts.size(); ++i)
+    {
+        std::vector<Lane> lanes(1);
+        if (!MakeLane(*stmnts[i], lanes.front()))
+            continue;
+
+        /* Append all subsequent lanes (up to 4 vector components) */
+        for (auto j = i + 1; j < stmnts.size() && lanes.size() < 4; ++j)
+        {
+            Lane lane;
+            if (MakeLane(*stmnts[j], lane) && CanAppendLane(lanes, lane))
+                lanes.push_back(lane);
+            else
+                break;
+        }
+
+        if (lanes.size() >= 2)
+            MergeLanes(stmnts, i, lanes);
+    }
+}
+
+bool SLPVectorizer::MakeLane(Stmnt& stmnt, Lane& lane)
+{
+    /* Statement must be an assignment to a single vector component (e.g. "v.x = ...;" or "v.x += ...;") */
+    auto exprStmnt = stmnt.As<ExprStmnt>();
+    if (!exprStmnt || !exprStmnt->expr)
+        return false;
+
+    auto assignExpr = exprStmnt->expr->As<VarAccessExpr>();
+    if (!assignExpr || !assignExpr->assignExpr)
+        return false;
+
+    switch (assignExpr->assignOp)
+    {
+        case AssignOp::Set:
+        case AssignOp::Add:
+        case AssignOp::Sub:
+        case AssignOp::Mul:
+        case AssignOp::Div:
+            break;
+        default:
+            return false;
+    }
+
+    auto varIdent = assignExpr->varIdent.get();
+    if (!varIdent->next)
+        return false;
+
+    lane.assignExpr = assignExpr;
+    lane.component  = varIdent->Last();
+    lane.destSymbol = varIdent->symbolRef;
+
+    if (!lane.destSymbol || VectorComponentIndex(*lane.component) < 0)
+        return false;
+
+    /* Find the vector identifier right before the component */
+    auto vectorIdent = varIdent;
+    while (vectorIdent->next.get() != lane.component)
+        vectorIdent = vectorIdent->next.get();
+
+    if (!IsVectorVarIdent(*vectorIdent))
+        return false;
+
+    lane.dataType = FetchScalarDataType(*assignExpr);
+    if (lane.dataType == DataType::Undefined)
+        return false;
+
+    if (!AppendVarIdentShape(varIdent, lane.component, lane.destShape))
+        return false;
+
+    /* Right hand side must refer to different vector components for each lane (pure broadcasts would require a type constructor) */
+    return (AppendOperandShape(*assignExpr->assignExpr, lane) == OperandKind::Vector);
+}
+
+bool SLPVectorizer::CanAppendLane(const std::vector<Lane>& lanes, const Lane& lane) const
+{
+    const auto& first = lanes.front();
+
+    if (lane.assignExpr->assignOp != first.assignExpr->assignOp || lane.dataType != first.dataType)
+        return false;
+
+    if (lane.destShape != first.destShape || lane.shape != first.shape)
+        return false;
+
+    /* Each vector component can only be assigned once */
+    for (const auto& prevLane : lanes)
+    {
+        if (VectorComponentIndex(*prevLane.component) == VectorComponentIndex(*lane.component))
+            return false;
+    }
+
+    return true;
+}
+
+void SLPVectorizer::MergeLanes(std::vector<StmntPtr>& stmnts, std::size_t firstStmnt, const std::vector<Lane>& lanes)
+{
+    const auto& first = lanes.front();
+
+    /* Merge destination components */
+    std::vector<VarIdent*> components;
+    for (const auto& lane : lanes)
+        components.push_back(lane.component);
+
+    first.component->ident = MakeSwizzle(components);
+
+    /* Merge operand components */
+    for (std::size_t i = 0; i < first.leafComponents.size(); ++i)
+    {
+        components.clear();
+        for (const auto& lane : lanes)
+            components.push_back(lane.leafComponents[i]);
+
+        first.leafComponents[i]->ident = MakeSwizzle(components);
+    }
+
+    ResetTypeDenoters(first.assignExpr);
+
+    /* Remove all other assignments */
+    stmnts.erase(stmnts.begin() + firstStmnt + 1, stmnts.begin() + firstStmnt + lanes.size());
+
+    merges_.push_back({ stmnts[firstStmnt], lanes.size(), first.assignExpr->varIdent->ToString() });
+}
+
+SLPVectorizer::OperandKind SLPVectorizer::AppendOperandShape(Expr& expr, Lane& lane)
+{
+    if (auto ast = expr.As<LiteralExpr>())
+    {
+        if (ast->dataType != lane.dataType)
+            return OperandKind::Invalid;
+        lane.shape += "L:" + ast->value + ';';
+        return OperandKind::Scalar;
+    }
+
+    if (auto ast = expr.As<BracketExpr>())
+    {
+        lane.shape += '(';
+        auto kind = AppendOperandShape(*ast->expr, lane);
+        lane.shape += ')';
+        return kind;
+    }
+
+    if (auto ast = expr.As<VarAccessExpr>())
+        return AppendVarAccessShape(*ast, lane);
+
+    if (auto ast = expr.As<CastExpr>())
+    {
+        /* Scalar casts of literals are broadcast to all components (e.g. "float(0)" from a converted "saturate" intrinsic) */
+        if (FetchScalarDataType(expr) == lane.dataType)
+        {
+            if (auto literalExpr = ast->expr->As<LiteralExpr>())
+            {
+                lane.shape += "C:" + literalExpr->value + ';';
+                return OperandKind::Scalar;
+            }
+        }
+        return OperandKind::Invalid;
+    }
+
+    if (auto ast = expr.As<UnaryExpr>())
+    {
+        if (ast->op != UnaryOp::Negate)
+            return OperandKind::Invalid;
+        lane.shape += '-';
+        return AppendOperandShape(*ast->expr, lane);
+    }
+
+    if (auto ast = expr.As<BinaryExpr>())
+    {
+        switch (ast->op)
+        {
+            case BinaryOp::Add:
+            case BinaryOp::Sub:
+            case BinaryOp::Mul:
+            case BinaryOp::Div:
+                break;
+            default:
+                return OperandKind::Invalid;
+        }
+
+        lane.shape += "B:" + BinaryOpToString(ast->op) + '(';
+        auto lhsKind = AppendOperandShape(*ast->lhsExpr, lane);
+        lane.shape += ',';
+        auto rhsKind = AppendOperandShape(*ast->rhsExpr, lane);
+        lane.shape += ')';
+
+        if (lhsKind == OperandKind::Invalid || rhsKind == OperandKind::Invalid)
+            return OperandKind::Invalid;
+        if (lhsKind == OperandKind::Vector || rhsKind == OperandKind::Vector)
+            return OperandKind::Vector;
+        return OperandKind::Scalar;
+    }
+
+    if (auto ast = expr.As<FunctionCallExpr>())
+    {
+        const auto& funcCall = *ast->call;
+        if (funcCall.typeDenoter)
+        {
+            /* Scalar type constructors of literals are broadcast to all components (e.g. "float(0)") */
+            if (funcCall.arguments.size() == 1 && FetchScalarDataType(expr) == lane.dataType)
+            {
+                if (auto literalExpr = funcCall.arguments.front()->As<LiteralExpr>())
+                {
+                    lane.shape += "T:" + literalExpr->value + ';';
+                    return OperandKind::Scalar;
+                }
+            }
+            return OperandKind::Invalid;
+        }
+        return AppendIntrinsicCallShape(*ast->call, lane);
+    }
+
+    return OperandKind::Invalid;
+}
+
+SLPVectorizer::OperandKind SLPVectorizer::AppendVarAccessShape(VarAccessExpr& expr, Lane& lane)
+{
+    if (expr.assignExpr || FetchScalarDataType(expr) != lane.dataType)
+        return OperandKind::Invalid;
+
+    auto varIdent = expr.varIdent.get();
+    auto last = varIdent->Last();
+
+    if (varIdent != last && VectorComponentIndex(*last) >= 0)
+    {
+        /* Find the vector identifier right before the component */
+        auto vectorIdent = varIdent;
+        while (vectorIdent->next.get() != last)
+            vectorIdent = vectorIdent->next.get();
+
+        if (IsVectorVarIdent(*vectorIdent))
+        {
+            std::string vectorShape;
+            if (!AppendVarIdentShape(varIdent, last, vectorShape))
+                return OperandKind::Invalid;
+
+            /*
+            The destination variable can only be read at the component that is assigned by the same lane,
+            since all operands of the vector operation are read before any component is written
+            */
+            if (varIdent->symbolRef == lane.destSymbol)
+            {
+                if (vectorShape != lane.destShape || VectorComponentIndex(*last) != VectorComponentIndex(*lane.component))
+                    return OperandKind::Invalid;
+            }
+
+            lane.shape += "S:" + vectorShape + ';';
+            lane.leafComponents.push_back(last);
+
+            return OperandKind::Vector;
+        }
+    }
+
+    /* Scalar variables are broadcast to all components, but must not refer to the destination variable */
+    if (varIdent->symbolRef == lane.destSymbol)
+        return OperandKind::Invalid;
+
+    lane.shape += "V:";
+    if (!AppendVarIdentShape(varIdent, nullptr, lane.shape))
+        return OperandKind::Invalid;
+    lane.shape += ';';
+
+    return OperandKind::Scalar;
+}
+
+SLPVectorizer::OperandKind SLPVectorizer::AppendIntrinsicCallShape(FunctionCall& funcCall, Lane& lane)
+{
+    if (funcCall.funcDeclRef || !funcCall.defaultArgumentRefs.empty() || funcCall.arguments.empty())
+        return OperandKind::Invalid;
+
+    /* Intrinsic must be called as global function (e.g. "max(a, b)"), and must be applied to each component independently */
+    if (!funcCall.varIdent || funcCall.varIdent->next || !IsComponentWiseIntrinsic(funcCall.intrinsic, lane.dataType))
+        return OperandKind::Invalid;
+
+    lane.shape += "I:" + funcCall.varIdent->ident + '(';
+
+    std::vector<OperandKind> argKinds;
+    for (const auto& arg : funcCall.arguments)
+    {
+        argKinds.push_back(AppendOperandShape(*arg, lane));
+        if (argKinds.back() == OperandKind::Invalid)
+            return OperandKind::Invalid;
+        lane.shape += ',';
+    }
+
+    lane.shape += ')';
+
+    if (std::find(argKinds.begin(), argKinds.end(), OperandKind::Vector) == argKinds.end())
+        return OperandKind::Scalar;
+
+    /* Only certain arguments can be scalars for vector operations (e.g. "clamp(v, 0, 1)") */
+    for (std::size_t i = 0; i < argKinds.size(); ++i)
+    {
+        if (argKinds[i] == OperandKind::Scalar && !IsScalarArgumentAllowed(funcCall.intrinsic, i))
+            return OperandKind::Invalid;
+    }
+
+    return OperandKind::Vector;
+}
+
+/* ------- Visit functions ------- */
+
+#define IMPLEMENT_VISIT_PROC(AST_NAME) \
+    void SLPVectorizer::Visit##AST_NAME(AST_NAME* ast, void* args)
+
+IMPLEMENT_VISIT_PROC(CodeBlock)
+{
+    VectorizeStmntList(ast->stmnts);
+    VISIT_DEFAULT(CodeBlock);
+}
+
+IMPLEMENT_VISIT_PROC(SwitchCase)
+{
+    VectorizeStmntList(ast->stmnts);
+    VISIT_DEFAULT(SwitchCase);
+}
+
+IMPLEMENT_VISIT_PROC(FunctionDecl)
+{
+    /* Only vectorize reachable functions, since all merges are reported */
+    if (ast->flags(AST::isReachable))
+        VISIT_DEFAULT(FunctionDecl);
+}
+
+#undef IMPLEMENT_VISIT_PROC
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,106 @@
+/*
+ * SLPVectorizer.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_SLP_VECTORIZER_H
+#define XSC_SLP_VECTORIZER_H
+
+
+#include "Visitor.h"
+#include "ASTEnums.h"
+#include <string>
+#include <vector>
+
+
+namespace Xsc
+{
+
+
+/*
+SLP (Superword-Level Parallelism) vectorizer.
+This AST modifier merges consecutive scalar assignments to different components of the same vector,
+whose right hand sides are isomorphic operations on the components of other vectors, into a single vector assignment,
+e.g. "v.x = a.x * s + b.x; v.y = a.y * s + b.y;" -> "v.xy = a.xy * s + b.xy;".
+Only side effect free arithmetic and component-wise intrinsics on operands of the same scalar type are merged.
+This must be used after the reference analysis, since only reachable functions are converted.
+*/
+class SLPVectorizer : private Visitor
+{
+
+    public:
+
+        // Group of scalar assignments that has been merged into a single vector assignment.
+        struct Merge
+        {
+            StmntPtr    stmnt;          // Merged statement (only used for its source area).
+            std::size_t numScalarOps;   // Number of scalar assignments that have been merged.
+            std::string vectorExpr;     // Assigned vector components (e.g. "v.xyz").
+        };
+
+        // Vectorizes all reachable functions in the specified program, and returns the list of all merges.
+        std::vector<Merge> Vectorize(Program& program);
+
+    private:
+
+        // Kind of an operand expression.
+        enum class OperandKind
+        {
+            Invalid,    // Operand can not be vectorized.
+            Scalar,     // Operand is equal for all lanes, and is broadcast to all vector components (e.g. a literal).
+            Vector,     // Operand refers to a different vector component for each lane.
+        };
+
+        // Scalar assignment to a single vector component (e.g. "v.x = a.x * s;").
+        struct Lane
+        {
+            VarAccessExpr*          assignExpr      = nullptr;
+            VarIdent*               component       = nullptr;              // Destination vector component (e.g. "x" in "v.x").
+            AST*                    destSymbol      = nullptr;              // Symbol of the destination variable (e.g. "v").
+            std::string             destShape;                              // Signature of the destination vector (e.g. "v" in "v.x").
+            DataType                dataType        = DataType::Undefined;  // Scalar data type of all operands.
+            std::string             shape;                                  // Signature of the operation without the vector components of its operands.
+            std::vector<VarIdent*>  leafComponents;                         // Vector components of all operands (e.g. "x" in "a.x").
+        };
+
+        /* === Functions === */
+
+        void VectorizeStmntList(std::vector<StmntPtr>& stmnts);
+
+        // Returns true if the specified statement is a scalar assignment to a single vector component, which can be vectorized.
+        bool MakeLane(Stmnt& stmnt, Lane& lane);
+
+        // Returns true if the specified lane can be merged with the previous lanes.
+        bool CanAppendLane(const std::vector<Lane>& lanes, const Lane& lane) const;
+
+        void MergeLanes(std::vector<StmntPtr>& stmnts, std::size_t firstStmnt, const std::vector<Lane>& lanes);
+
+        // Appends the signature of the specified operand expression to the lane, and returns the kind of the operand.
+        OperandKind AppendOperandShape(Expr& expr, Lane& lane);
+        OperandKind AppendVarAccessShape(VarAccessExpr& expr, Lane& lane);
+        OperandKind AppendIntrinsicCallShape(FunctionCall& funcCall, Lane& lane);
+
+        /* ----- Visitor implementation ----- */
+
+        DECL_VISIT_PROC( CodeBlock    );
+        DECL_VISIT_PROC( SwitchCase   );
+
+        DECL_VISIT_PROC( FunctionDecl );
+
+        /* === Members === */
+
+        std::vector<Merge> merges_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
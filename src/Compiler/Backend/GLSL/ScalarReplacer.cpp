@@ -0,0 +1,805 @@
+/*
+ * ScalarReplacer.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ScalarReplacer.h"
+#include "ConstExprEvaluator.h"
+#include "ASTFactory.h"
+#include "AST.h"
+#include <algorithm>
+
+
+namespace Xsc
+{
+
+
+// Maximal number of temporary variables an aggregate is replaced by.
+static const std::size_t g_maxNumTemporaries = 32;
+
+std::vector<ScalarReplacer::Replacement> ScalarReplacer::ReplaceAggregates(Program& program, const NameMangling& nameMangling)
+{
+    nameMangling_ = (&nameMangling);
+    replacements_.clear();
+    Visit(&program);
+    return std::move(replacements_);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+// Evaluates the specified array index, and returns true if it is a constant.
+static bool EvaluateConstIndex(Expr& expr, int& index)
+{
+    try
+    {
+        ConstExprEvaluator exprEval;
+        auto result = exprEval.EvaluateExpr(
+            expr,
+            [](VarAccessExpr* ast) -> Variant
+            {
+                throw ast;
+            }
+        );
+        index = static_cast<int>(result.ToInt());
+        return true;
+    }
+    catch (const std::exception&)
+    {
+        /* ignore this exception */
+    }
+    catch (const VarAccessExpr*)
+    {
+        /* ignore variable access */
+    }
+    return false;
+}
+
+// Returns true if all array indices of the specified identifier (including its successors) are constants.
+static bool HasConstIndicesOnly(const VarIdent* varIdent)
+{
+    for (; varIdent != nullptr; varIdent = varIdent->next.get())
+    {
+        for (const auto& index : varIdent->arrayIndices)
+        {
+            int value = 0;
+            if (!EvaluateConstIndex(*index, value))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Returns a copy of the specified identifier with literal array indices, followed by the specified access path.
+static VarIdentPtr MakeVarIdentWithPath(const VarIdent& varIdent, const std::vector<std::pair<VarDecl*, int>>& path)
+{
+    VarIdentPtr first;
+    VarIdent* last = nullptr;
+
+    auto append = [&](const VarIdentPtr& ast)
+    {
+        if (last)
+            last->next = ast;
+        else
+            first = ast;
+        last = ast.get();
+    };
+
+    for (auto ident = &varIdent; ident != nullptr; ident = ident->next.get())
+    {
+        auto ast = ASTFactory::MakeVarIdent(ident->ident, ident->symbolRef);
+        {
+            ast->nextIsStatic = ident->nextIsStatic;
+            for (const auto& index : ident->arrayIndices)
+            {
+                int value = 0;
+                EvaluateConstIndex(*index, value);
+                ast->arrayIndices.push_back(ASTFactory::MakeLiteralExpr(DataType::Int, std::to_string(value)));
+            }
+        }
+        append(ast);
+    }
+
+    for (const auto& step : path)
+    {
+        if (step.first)
+            append(ASTFactory::MakeVarIdent(step.first->ident, step.first));
+        else
+            last->arrayIndices.push_back(ASTFactory::MakeLiteralExpr(DataType::Int, std::to_string(step.second)));
+    }
+
+    return first;
+}
+
+// Collects all member variables of the specified structure (including the members of its base structures).
+static void CollectMemberVarDecls(const StructDecl& structDecl, std::vector<VarDecl*>& members)
+{
+    if (structDecl.baseStructRef)
+        CollectMemberVarDecls(*structDecl.baseStructRef, members);
+
+    for (const auto& varDeclStmnt : structDecl.varMembers)
+    {
+        for (const auto& varDecl : varDeclStmnt->varDecls)
+            members.push_back(varDecl.get());
+    }
+}
+
+void ScalarReplacer::ReplaceAggregatesInFunction(FunctionDecl& funcDecl)
+{
+    aggregates_.clear();
+    copies_.clear();
+
+    /* Find all candidates and analyze their accesses */
+    isRewriting_ = false;
+    Visit(funcDecl.codeBlock);
+
+    PropagateValidity();
+    PropagateLiveness();
+
+    bool anySplit = false;
+    for (auto& it : aggregates_)
+    {
+        if (IsSplit(&(it.second)))
+        {
+            DeclareTemporaries(it.second);
+            anySplit = true;
+        }
+    }
+
+    /* Replace all split aggregates by their temporaries */
+    if (anySplit)
+    {
+        isRewriting_ = true;
+        Visit(funcDecl.codeBlock);
+        isRewriting_ = false;
+    }
+
+    aggregates_.clear();
+    copies_.clear();
+}
+
+bool ScalarReplacer::MakeAggregate(const StmntPtr& stmnt, Aggregate& aggr)
+{
+    /* Only accept single local variables without storage classes and interface semantics */
+    auto varDeclStmnt = stmnt->As<VarDeclStmnt>();
+    if (!varDeclStmnt || varDeclStmnt->varDecls.size() != 1)
+        return false;
+
+    if ( varDeclStmnt->flags(VarDeclStmnt::isShaderInput)  ||
+         varDeclStmnt->flags(VarDeclStmnt::isShaderOutput) ||
+         varDeclStmnt->flags(VarDeclStmnt::isParameter) )
+    {
+        return false;
+    }
+
+    const auto& typeSpecifier = varDeclStmnt->typeSpecifier;
+    if (typeSpecifier->isInput || typeSpecifier->isOutput || typeSpecifier->isUniform || !typeSpecifier->storageClasses.empty())
+        return false;
+
+    auto varDecl = varDeclStmnt->varDecls.front().get();
+    if ( varDecl->flags(VarDecl::isShaderInput)      ||
+         varDecl->flags(VarDecl::isShaderOutput)     ||
+         varDecl->flags(VarDecl::isSystemValue)      ||
+         varDecl->flags(VarDecl::isDynamicArray)     ||
+         varDecl->flags(VarDecl::isEntryPointOutput) ||
+         varDecl->flags(VarDecl::isEntryPointLocal)  ||
+         varDecl->semantic.IsValid() )
+    {
+        return false;
+    }
+
+    aggr.declStmnt  = stmnt;
+    aggr.varDecl    = varDecl;
+
+    /* Only accept arrays and structures (scalar and vector types are no aggregates) */
+    auto typeDenoter = varDecl->GetTypeDenoter();
+    if (typeDenoter->GetAliased().IsBase())
+        return false;
+
+    std::vector<PathStep> path;
+    return BuildElement(aggr, aggr.root, typeDenoter, path);
+}
+
+bool ScalarReplacer::BuildElement(Aggregate& aggr, Element& element, const TypeDenoterPtr& typeDenoter, std::vector<PathStep>& path)
+{
+    element.typeDenoter = typeDenoter;
+    element.firstLeaf   = aggr.leaves.size();
+    element.depth       = path.size();
+
+    const auto& typeDen = typeDenoter->GetAliased();
+
+    if (auto baseTypeDen = typeDen.As<BaseTypeDenoter>())
+    {
+        /* Only scalar, vector, and matrix types can be replaced by temporaries */
+        const auto dataType = baseTypeDen->dataType;
+        if (!IsScalarType(dataType) && !IsVectorType(dataType) && !IsMatrixType(dataType))
+            return false;
+
+        if (aggr.leaves.size() >= g_maxNumTemporaries)
+            return false;
+
+        Leaf leaf;
+        {
+            leaf.typeDenoter    = typeDenoter;
+            leaf.path           = path;
+        }
+        aggr.leaves.push_back(leaf);
+    }
+    else if (auto arrayTypeDen = typeDen.As<ArrayTypeDenoter>())
+    {
+        /* Split the first array dimension only (sub arrays are split recursively) */
+        const auto dimSizes = arrayTypeDen->GetDimensionSizes();
+        if (dimSizes.empty() || dimSizes.front() <= 0)
+            return false;
+
+        TypeDenoterPtr subTypeDen;
+        if (arrayTypeDen->arrayDims.size() > 1)
+        {
+            std::vector<ArrayDimensionPtr> subArrayDims(arrayTypeDen->arrayDims.begin() + 1, arrayTypeDen->arrayDims.end());
+            subTypeDen = std::make_shared<ArrayTypeDenoter>(arrayTypeDen->baseTypeDenoter, subArrayDims);
+        }
+        else
+            subTypeDen = arrayTypeDen->baseTypeDenoter;
+
+        element.isArray = true;
+        element.children.resize(static_cast<std::size_t>(dimSizes.front()));
+
+        for (std::size_t i = 0; i < element.children.size(); ++i)
+        {
+            auto& child = element.children[i];
+            child.step.index = static_cast<int>(i);
+
+            path.push_back(child.step);
+            auto result = BuildElement(aggr, child, subTypeDen, path);
+            path.pop_back();
+
+            if (!result)
+                return false;
+        }
+    }
+    else if (auto structTypeDen = typeDen.As<StructTypeDenoter>())
+    {
+        if (!structTypeDen->structDeclRef || !BuildStructElement(aggr, element, *structTypeDen->structDeclRef, path))
+            return false;
+    }
+    else
+        return false;
+
+    element.numLeaves = aggr.leaves.size() - element.firstLeaf;
+
+    return true;
+}
+
+bool ScalarReplacer::BuildStructElement(Aggregate& aggr, Element& element, StructDecl& structDecl, std::vector<PathStep>& path)
+{
+    /* Shader interface structures and structures with member functions are never split */
+    if (structDecl.flags(StructDecl::isShaderInput) || structDecl.flags(StructDecl::isShaderOutput) || !structDecl.funcMembers.empty())
+        return false;
+
+    std::vector<VarDecl*> members;
+    CollectMemberVarDecls(structDecl, members);
+
+    if (members.empty())
+        return false;
+
+    element.children.resize(members.size());
+
+    for (std::size_t i = 0; i < members.size(); ++i)
+    {
+        if (members[i]->semantic.IsSystemValue())
+            return false;
+
+        auto& child = element.children[i];
+        child.step.member = members[i];
+
+        path.push_back(child.step);
+        auto result = BuildElement(aggr, child, members[i]->GetTypeDenoter(), path);
+        path.pop_back();
+
+        if (!result)
+            return false;
+    }
+
+    return true;
+}
+
+bool ScalarReplacer::MatchInitializer(Aggregate& aggr, const Element& element, const ExprPtr& expr)
+{
+    auto initExpr = expr->As<InitializerExpr>();
+
+    if (element.children.empty())
+    {
+        /* Store initializer of this leaf */
+        if (initExpr)
+            return false;
+        aggr.leaves[element.firstLeaf].initializer = expr;
+        return true;
+    }
+
+    /* Initializer list must have exactly one entry for each sub element */
+    if (!initExpr || initExpr->exprs.size() != element.children.size())
+        return false;
+
+    for (std::size_t i = 0; i < element.children.size(); ++i)
+    {
+        if (!MatchInitializer(aggr, element.children[i], initExpr->exprs[i]))
+            return false;
+    }
+
+    return true;
+}
+
+ScalarReplacer::Aggregate* ScalarReplacer::FetchAggregate(const VarIdent& varIdent)
+{
+    if (auto varDecl = (varIdent.symbolRef != nullptr ? varIdent.symbolRef->As<VarDecl>() : nullptr))
+    {
+        auto it = aggregates_.find(varDecl);
+        if (it != aggregates_.end())
+            return &(it->second);
+    }
+    return nullptr;
+}
+
+const ScalarReplacer::Element* ScalarReplacer::ResolveElement(const Aggregate& aggr, VarIdent& varIdent, VarIdent*& tail, std::size_t& numIndices) const
+{
+    const Element* element = &(aggr.root);
+
+    tail        = (&varIdent);
+    numIndices  = 0;
+
+    while (!element->children.empty())
+    {
+        if (element->isArray)
+        {
+            /* Step into array element with constant index */
+            if (numIndices == tail->arrayIndices.size())
+                break;
+
+            int index = 0;
+            if (!EvaluateConstIndex(*tail->arrayIndices[numIndices], index))
+                return nullptr;
+
+            if (index < 0 || static_cast<std::size_t>(index) >= element->children.size())
+                return nullptr;
+
+            element = &(element->children[static_cast<std::size_t>(index)]);
+            ++numIndices;
+        }
+        else
+        {
+            /* Step into structure member */
+            if (numIndices < tail->arrayIndices.size() || !tail->next || tail->nextIsStatic)
+                break;
+
+            auto member = tail->next->symbolRef;
+
+            auto it = std::find_if(
+                element->children.begin(), element->children.end(),
+                [member](const Element& child)
+                {
+                    return (child.step.member == member);
+                }
+            );
+
+            if (it == element->children.end())
+                break;
+
+            element     = &(*it);
+            tail        = tail->next.get();
+            numIndices  = 0;
+        }
+    }
+
+    return element;
+}
+
+bool ScalarReplacer::ResolveWholeElement(VarIdent& varIdent, Aggregate*& aggr, const Element*& element)
+{
+    if (!HasConstIndicesOnly(&varIdent))
+        return false;
+
+    aggr    = FetchAggregate(varIdent);
+    element = nullptr;
+
+    if (aggr)
+    {
+        /* Identifier must end with an entire (non-leaf) element */
+        VarIdent*   tail        = nullptr;
+        std::size_t numIndices  = 0;
+
+        element = ResolveElement(*aggr, varIdent, tail, numIndices);
+
+        if (!element || element->children.empty() || numIndices < tail->arrayIndices.size() || tail->next)
+            return false;
+    }
+
+    return true;
+}
+
+void ScalarReplacer::AnalyzeStmntList(std::vector<StmntPtr>& stmnts)
+{
+    for (const auto& stmnt : stmnts)
+    {
+        if (stmnt->Type() == AST::Types::VarDeclStmnt)
+        {
+            AnalyzeVarDeclStmnt(stmnt);
+            continue;
+        }
+
+        /* Record copies of entire aggregate elements (e.g. "s2 = s1;") */
+        if (auto exprStmnt = stmnt->As<ExprStmnt>())
+        {
+            if (auto assignExpr = exprStmnt->expr->As<VarAccessExpr>())
+            {
+                if (assignExpr->assignOp == AssignOp::Set && assignExpr->assignExpr)
+                {
+                    Aggregate*      destAggr    = nullptr;
+                    const Element*  destElement = nullptr;
+                    Copy            copy;
+
+                    if ( ResolveWholeElement(*assignExpr->varIdent, destAggr, destElement) &&
+                         destAggr != nullptr &&
+                         AnalyzeCopy(*destAggr, *destElement, *assignExpr->assignExpr, copy) )
+                    {
+                        copies_[stmnt.get()] = copy;
+                        continue;
+                    }
+                }
+            }
+        }
+
+        Visit(stmnt);
+    }
+}
+
+void ScalarReplacer::AnalyzeVarDeclStmnt(const StmntPtr& stmnt)
+{
+    auto varDecl = static_cast<VarDeclStmnt*>(stmnt.get())->varDecls.front().get();
+
+    /* Register aggregate in place, since copies refer to its elements */
+    auto& aggr = aggregates_[varDecl];
+
+    if (!MakeAggregate(stmnt, aggr))
+    {
+        aggregates_.erase(varDecl);
+        Visit(stmnt);
+        return;
+    }
+
+    if (auto initializer = varDecl->initializer.get())
+    {
+        /* Initializer must either be a structurally equal initializer list, or a copy of another aggregate */
+        if (initializer->Type() == AST::Types::InitializerExpr)
+        {
+            if (!MatchInitializer(aggr, aggr.root, varDecl->initializer))
+                aggr.isValid = false;
+            Visit(varDecl->initializer);
+        }
+        else
+        {
+            Copy copy;
+            if (AnalyzeCopy(aggr, aggr.root, *initializer, copy))
+                copies_[stmnt.get()] = copy;
+            else
+            {
+                aggr.isValid = false;
+                Visit(varDecl->initializer);
+            }
+        }
+    }
+}
+
+bool ScalarReplacer::AnalyzeCopy(Aggregate& destAggr, const Element& destElement, Expr& srcExpr, Copy& copy)
+{
+    auto srcAccessExpr = srcExpr.As<VarAccessExpr>();
+    if (!srcAccessExpr || srcAccessExpr->assignExpr)
+        return false;
+
+    Aggregate*      srcAggr     = nullptr;
+    const Element*  srcElement  = nullptr;
+
+    if (!ResolveWholeElement(*srcAccessExpr->varIdent, srcAggr, srcElement))
+        return false;
+
+    /* Source must have the same type as the destination */
+    const auto srcTypeDen = (srcElement != nullptr ? srcElement->typeDenoter : srcExpr.GetTypeDenoter());
+    if (srcTypeDen->ToString() != destElement.typeDenoter->ToString())
+        return false;
+
+    if (srcElement != nullptr && srcElement->numLeaves != destElement.numLeaves)
+        return false;
+
+    copy.dest           = (&destAggr);
+    copy.destElement    = (&destElement);
+    copy.source         = srcAccessExpr->varIdent.get();
+    copy.srcAggr        = srcAggr;
+    copy.srcElement     = srcElement;
+
+    destAggr.isAccessed = true;
+    if (srcAggr)
+        srcAggr->isAccessed = true;
+
+    return true;
+}
+
+void ScalarReplacer::PropagateValidity()
+{
+    /* Source of a copy must not be split, if the destination is not split */
+    for (bool changed = true; changed;)
+    {
+        changed = false;
+        for (const auto& it : copies_)
+        {
+            const auto& copy = it.second;
+            if (copy.srcAggr && copy.srcAggr->isValid && !copy.dest->isValid)
+            {
+                copy.srcAggr->isValid = false;
+                changed = true;
+            }
+        }
+    }
+}
+
+void ScalarReplacer::PropagateLiveness()
+{
+    /* Elements are live, if they are copied into live elements */
+    for (bool changed = true; changed;)
+    {
+        changed = false;
+        for (const auto& it : copies_)
+        {
+            const auto& copy = it.second;
+            if (IsSplit(copy.dest) && IsSplit(copy.srcAggr))
+            {
+                for (std::size_t i = 0; i < copy.destElement->numLeaves; ++i)
+                {
+                    const auto& destLeaf    = copy.dest->leaves[copy.destElement->firstLeaf + i];
+                    auto&       srcLeaf     = copy.srcAggr->leaves[copy.srcElement->firstLeaf + i];
+
+                    if (destLeaf.isLive && !srcLeaf.isLive)
+                    {
+                        srcLeaf.isLive = true;
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ScalarReplacer::DeclareTemporaries(Aggregate& aggr)
+{
+    std::size_t numTemporaries = 0;
+
+    for (auto& leaf : aggr.leaves)
+    {
+        /* Elements that are only written by aggregate copies are never declared */
+        if (!leaf.isAccessed && !leaf.isLive && !leaf.initializer)
+            continue;
+
+        std::string ident = nameMangling_->temporaryPrefix + aggr.varDecl->ident.Final();
+        for (const auto& step : leaf.path)
+        {
+            if (step.member)
+                ident += "_" + step.member->ident.Final();
+            else
+                ident += "_" + std::to_string(step.index);
+        }
+
+        leaf.declStmnt = ASTFactory::MakeVarDeclStmnt(ASTFactory::MakeTypeSpecifier(leaf.typeDenoter), ident);
+        {
+            auto aggrDeclStmnt = static_cast<VarDeclStmnt*>(aggr.declStmnt.get());
+            leaf.declStmnt->area                        = aggrDeclStmnt->area;
+            leaf.declStmnt->typeSpecifier->typeModifiers = aggrDeclStmnt->typeSpecifier->typeModifiers;
+            leaf.declStmnt->varDecls.front()->area      = aggr.varDecl->area;
+            leaf.declStmnt->varDecls.front()->initializer = leaf.initializer;
+        }
+
+        ++numTemporaries;
+    }
+
+    replacements_.push_back({ aggr.declStmnt, aggr.varDecl->ident.Final(), numTemporaries });
+}
+
+void ScalarReplacer::RewriteStmntList(std::vector<StmntPtr>& stmnts)
+{
+    std::vector<StmntPtr> rewrittenStmnts;
+    rewrittenStmnts.reserve(stmnts.size());
+
+    for (auto& stmnt : stmnts)
+    {
+        auto copyIt = copies_.find(stmnt.get());
+        auto copy   = (copyIt != copies_.end() ? &(copyIt->second) : nullptr);
+
+        if (auto varDeclStmnt = stmnt->As<VarDeclStmnt>())
+        {
+            auto aggrIt = aggregates_.find(varDeclStmnt->varDecls.front().get());
+            if (aggrIt != aggregates_.end() && IsSplit(&(aggrIt->second)))
+            {
+                /* Replace aggregate declaration by temporaries (and initialize them with the copied elements) */
+                const auto& aggr = aggrIt->second;
+                for (std::size_t i = 0; i < aggr.leaves.size(); ++i)
+                {
+                    const auto& leaf = aggr.leaves[i];
+                    if (leaf.declStmnt)
+                    {
+                        if (copy && leaf.isLive)
+                            leaf.declStmnt->varDecls.front()->initializer = MakeCopySource(*copy, i);
+                        rewrittenStmnts.push_back(leaf.declStmnt);
+                    }
+                }
+                continue;
+            }
+        }
+        else if (copy && IsSplit(copy->dest))
+        {
+            /* Replace aggregate copy by element-wise copies */
+            AppendCopyStmnts(*copy, rewrittenStmnts);
+            continue;
+        }
+
+        rewrittenStmnts.push_back(stmnt);
+    }
+
+    stmnts = std::move(rewrittenStmnts);
+}
+
+void ScalarReplacer::AppendCopyStmnts(const Copy& copy, std::vector<StmntPtr>& stmnts)
+{
+    for (std::size_t i = 0; i < copy.destElement->numLeaves; ++i)
+    {
+        const auto  leafIndex   = copy.destElement->firstLeaf + i;
+        const auto& leaf        = copy.dest->leaves[leafIndex];
+
+        /* Drop copies into elements that are never read */
+        if (leaf.isLive)
+        {
+            auto varDecl    = leaf.declStmnt->varDecls.front().get();
+            auto exprStmnt  = ASTFactory::MakeVarAssignStmnt(varDecl, MakeCopySource(copy, leafIndex));
+            exprStmnt->area = copy.source->area;
+            stmnts.push_back(exprStmnt);
+        }
+    }
+}
+
+ExprPtr ScalarReplacer::MakeCopySource(const Copy& copy, std::size_t leafIndex)
+{
+    const auto leafOffset = leafIndex - copy.destElement->firstLeaf;
+
+    if (IsSplit(copy.srcAggr))
+    {
+        /* Refer to the temporary of the source element */
+        auto varDecl = copy.srcAggr->leaves[copy.srcElement->firstLeaf + leafOffset].declStmnt->varDecls.front().get();
+        return ASTFactory::MakeVarAccessExpr(varDecl->ident, varDecl);
+    }
+
+    /* Append remaining access path to the source identifier */
+    const auto& leaf = copy.dest->leaves[leafIndex];
+
+    std::vector<std::pair<VarDecl*, int>> path;
+    for (auto i = copy.destElement->depth; i < leaf.path.size(); ++i)
+        path.push_back({ leaf.path[i].member, leaf.path[i].index });
+
+    return ASTFactory::MakeVarAccessExpr(MakeVarIdentWithPath(*copy.source, path));
+}
+
+bool ScalarReplacer::IsSplit(const Aggregate* aggr) const
+{
+    return (aggr != nullptr && aggr->isValid && aggr->isAccessed);
+}
+
+/* ------- Visit functions ------- */
+
+#define IMPLEMENT_VISIT_PROC(AST_NAME) \
+    void ScalarReplacer::Visit##AST_NAME(AST_NAME* ast, void* args)
+
+IMPLEMENT_VISIT_PROC(CodeBlock)
+{
+    if (isRewriting_)
+    {
+        RewriteStmntList(ast->stmnts);
+        VISIT_DEFAULT(CodeBlock);
+    }
+    else
+        AnalyzeStmntList(ast->stmnts);
+}
+
+IMPLEMENT_VISIT_PROC(SwitchCase)
+{
+    if (isRewriting_)
+    {
+        RewriteStmntList(ast->stmnts);
+        VISIT_DEFAULT(SwitchCase);
+    }
+    else
+    {
+        Visit(ast->expr);
+        AnalyzeStmntList(ast->stmnts);
+    }
+}
+
+IMPLEMENT_VISIT_PROC(VarIdent)
+{
+    if (auto aggr = FetchAggregate(*ast))
+    {
+        VarIdent*   tail        = nullptr;
+        std::size_t numIndices  = 0;
+
+        auto element = ResolveElement(*aggr, *ast, tail, numIndices);
+
+        if (isRewriting_)
+        {
+            if (IsSplit(aggr) && element != nullptr && element->children.empty())
+            {
+                /* Replace access path by the temporary of the leaf (e.g. "s.a[1].x" -> "xst_s_a_1.x") */
+                auto varDecl = aggr->leaves[element->firstLeaf].declStmnt->varDecls.front().get();
+
+                ExprList    arrayIndices(tail->arrayIndices.begin() + numIndices, tail->arrayIndices.end());
+                auto        nextIsStatic    = tail->nextIsStatic;
+                auto        next            = tail->next;
+
+                ast->ident          = varDecl->ident;
+                ast->symbolRef      = varDecl;
+                ast->arrayIndices   = std::move(arrayIndices);
+                ast->nextIsStatic   = nextIsStatic;
+                ast->next           = next;
+
+                ast->ResetTypeDenoter();
+            }
+        }
+        else
+        {
+            aggr->isAccessed = true;
+
+            if (element && element->children.empty())
+            {
+                /* Mark leaf as accessed, and as live if it is not only assigned */
+                auto& leaf = aggr->leaves[element->firstLeaf];
+                leaf.isAccessed = true;
+                if (ast != assignedIdent_)
+                    leaf.isLive = true;
+            }
+            else
+            {
+                /* Dynamic index or use of the entire aggregate */
+                aggr->isValid = false;
+            }
+        }
+    }
+
+    VISIT_DEFAULT(VarIdent);
+}
+
+IMPLEMENT_VISIT_PROC(FunctionDecl)
+{
+    /* Only convert reachable functions, since all replacements are reported */
+    if (ast->flags(AST::isReachable) && ast->codeBlock)
+        ReplaceAggregatesInFunction(*ast);
+}
+
+IMPLEMENT_VISIT_PROC(VarAccessExpr)
+{
+    if (!isRewriting_ && ast->assignOp == AssignOp::Set && ast->assignExpr)
+    {
+        /* Plain assignments do not read the destination */
+        assignedIdent_ = ast->varIdent.get();
+        Visit(ast->varIdent);
+        assignedIdent_ = nullptr;
+        Visit(ast->assignExpr);
+    }
+    else
+        VISIT_DEFAULT(VarAccessExpr);
+}
+
+#undef IMPLEMENT_VISIT_PROC
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,178 @@
+/*
+ * ScalarReplacer.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_SCALAR_REPLACER_H
+#define XSC_SCALAR_REPLACER_H
+
+
+#include <Xsc/Xsc.h>
+#include "Visitor.h"
+#include "TypeDenoter.h"
+#include <string>
+#include <vector>
+#include <map>
+
+
+namespace Xsc
+{
+
+
+/*
+Scalar replacement of aggregates (SROA).
+This AST modifier splits local arrays and structures, whose elements are only accessed with constant indices,
+into one temporary variable per element, e.g. "float w[2]; w[0] = a; w[1] = b;" -> "float xst_w_0; float xst_w_1; xst_w_0 = a; xst_w_1 = b;".
+Whole aggregate copies (e.g. "S s2 = s1;") are split into element-wise copies, and copies into elements that are never read are dropped.
+Aggregates with any dynamic index or any other use of the whole aggregate (e.g. as function argument) are left unchanged.
+This must be used after the reference analysis, since only reachable functions are converted.
+*/
+class ScalarReplacer : private Visitor
+{
+
+    public:
+
+        // Aggregate variable that has been replaced by temporary variables.
+        struct Replacement
+        {
+            StmntPtr    stmnt;          // Declaration statement of the aggregate (only used for its source area).
+            std::string ident;          // Identifier of the aggregate variable.
+            std::size_t numTemporaries; // Number of declared temporary variables.
+        };
+
+        // Replaces the aggregates in all reachable functions in the specified program, and returns the list of all replacements.
+        std::vector<Replacement> ReplaceAggregates(Program& program, const NameMangling& nameMangling);
+
+    private:
+
+        // Single step of an access path from an aggregate to one of its elements.
+        struct PathStep
+        {
+            VarDecl*    member  = nullptr;  // Structure member, or null for an array element.
+            int         index   = 0;        // Array element index.
+        };
+
+        // Element of an aggregate. The leaves of each element are enumerated consecutively.
+        struct Element
+        {
+            TypeDenoterPtr          typeDenoter;
+            PathStep                step;               // Access step from the parent element.
+            bool                    isArray     = false;
+            std::vector<Element>    children;           // Sub elements; empty for leaves.
+            std::size_t             firstLeaf   = 0;
+            std::size_t             numLeaves   = 0;
+            std::size_t             depth       = 0;    // Length of the access path from the aggregate.
+        };
+
+        // Scalar, vector, or matrix element of an aggregate, which is replaced by a temporary variable.
+        struct Leaf
+        {
+            TypeDenoterPtr          typeDenoter;
+            std::vector<PathStep>   path;                   // Access path from the aggregate.
+            ExprPtr                 initializer;            // Initializer from an initializer list; may be null.
+            bool                    isAccessed  = false;    // Element is accessed directly (not only by aggregate copies).
+            bool                    isLive      = false;    // Element is read directly or by a copy into a live element.
+            VarDeclStmntPtr         declStmnt;              // Declaration of the temporary variable; null if the element is never used.
+        };
+
+        // Local aggregate variable, which is a candidate for scalar replacement.
+        struct Aggregate
+        {
+            StmntPtr                declStmnt;
+            VarDecl*                varDecl     = nullptr;
+            Element                 root;
+            std::vector<Leaf>       leaves;
+            bool                    isValid     = true;     // All accesses refer to leaves or are whole aggregate copies.
+            bool                    isAccessed  = false;
+        };
+
+        // Copy of a whole aggregate element (e.g. "s2 = s1;" or "S s2 = s1;").
+        struct Copy
+        {
+            Aggregate*              dest        = nullptr;
+            const Element*          destElement = nullptr;
+            VarIdent*               source      = nullptr;  // Source identifier (all array indices are constant).
+            Aggregate*              srcAggr     = nullptr;  // Source aggregate; may be null.
+            const Element*          srcElement  = nullptr;
+        };
+
+        /* === Functions === */
+
+        void ReplaceAggregatesInFunction(FunctionDecl& funcDecl);
+
+        // Returns true if the specified declaration statement is a local aggregate, which is a candidate for scalar replacement.
+        bool MakeAggregate(const StmntPtr& stmnt, Aggregate& aggr);
+
+        bool BuildElement(Aggregate& aggr, Element& element, const TypeDenoterPtr& typeDenoter, std::vector<PathStep>& path);
+        bool BuildStructElement(Aggregate& aggr, Element& element, StructDecl& structDecl, std::vector<PathStep>& path);
+
+        // Returns true if the specified initializer list has exactly the same structure as the element.
+        bool MatchInitializer(Aggregate& aggr, const Element& element, const ExprPtr& expr);
+
+        // Returns the aggregate the specified identifier refers to, or null if there is no such aggregate.
+        Aggregate* FetchAggregate(const VarIdent& varIdent);
+
+        /*
+        Resolves the element of the aggregate, the specified identifier refers to. Returns null if any index is not constant.
+        The remaining identifier (and the number of its already consumed array indices) is written to 'tail' (and 'numIndices').
+        */
+        const Element* ResolveElement(const Aggregate& aggr, VarIdent& varIdent, VarIdent*& tail, std::size_t& numIndices) const;
+
+        // Returns true if the specified identifier refers to an entire aggregate element with constant indices only.
+        bool ResolveWholeElement(VarIdent& varIdent, Aggregate*& aggr, const Element*& element);
+
+        void AnalyzeStmntList(std::vector<StmntPtr>& stmnts);
+        void AnalyzeVarDeclStmnt(const StmntPtr& stmnt);
+
+        // Returns true if the specified expression is a copy of an entire aggregate element into the destination.
+        bool AnalyzeCopy(Aggregate& destAggr, const Element& destElement, Expr& srcExpr, Copy& copy);
+
+        void PropagateValidity();
+        void PropagateLiveness();
+        void DeclareTemporaries(Aggregate& aggr);
+
+        void RewriteStmntList(std::vector<StmntPtr>& stmnts);
+
+        // Appends the element-wise copies of the specified aggregate copy as assignments.
+        void AppendCopyStmnts(const Copy& copy, std::vector<StmntPtr>& stmnts);
+
+        // Returns the source expression of the specified leaf of an aggregate copy.
+        ExprPtr MakeCopySource(const Copy& copy, std::size_t leafIndex);
+
+        bool IsSplit(const Aggregate* aggr) const;
+
+        /* ----- Visitor implementation ----- */
+
+        DECL_VISIT_PROC( CodeBlock     );
+        DECL_VISIT_PROC( SwitchCase    );
+        DECL_VISIT_PROC( VarIdent      );
+
+        DECL_VISIT_PROC( FunctionDecl  );
+
+        DECL_VISIT_PROC( VarAccessExpr );
+
+        /* === Members === */
+
+        const NameMangling*                 nameMangling_   = nullptr;
+
+        std::map<const VarDecl*, Aggregate> aggregates_;                // Aggregates of the current function.
+        std::map<const Stmnt*, Copy>        copies_;                    // Aggregate copies of the current function.
+
+        bool                                isRewriting_    = false;
+        const VarIdent*                     assignedIdent_  = nullptr;  // Destination of the current assignment.
+
+        std::vector<Replacement>            replacements_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,288 @@
+/*
+ * VaryingPacker.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VaryingPacker.h"
+#include "AST.h"
+#include "Helper.h"
+#include <algorithm>
+#include <tuple>
+
+
+namespace Xsc
+{
+
+
+static const unsigned int g_numSlotComponents = 4;
+
+std::string VaryingSlot::EntrySwizzle(const Entry& entry) const
+{
+    if (entry.numComponents == static_cast<unsigned int>(VectorTypeDim(dataType)))
+        return "";
+    else
+        return std::string("xyzw").substr(entry.firstComponent, entry.numComponents);
+}
+
+// Candidate for varying packing.
+struct VaryingPacker::PackingCandidate
+{
+    VarDecl*                    varDecl;
+    DataType                    baseDataType;
+    unsigned int                numComponents;
+    EnumSet<InterpModifier>     interpModifiers;
+    std::string                 semantic;
+};
+
+// Returns true if the specified variable can be packed, and stores its scalar type class and number of components.
+static bool IsPackableVarying(VarDecl* varDecl, DataType& baseDataType, unsigned int& numComponents)
+{
+    if (!varDecl->declStmntRef || !varDecl->arrayDims.empty() || !varDecl->semantic.IsUserDefined())
+        return false;
+
+    auto baseTypeDen = varDecl->declStmntRef->typeSpecifier->GetTypeDenoter()->Get()->As<BaseTypeDenoter>();
+    if (!baseTypeDen)
+        return false;
+
+    const auto dataType = baseTypeDen->dataType;
+    if (!IsScalarType(dataType) && !IsVectorType(dataType))
+        return false;
+
+    /* Only pack types that occupy one component per element (i.e. no double or boolean types) */
+    switch (BaseDataType(dataType))
+    {
+        case DataType::Half:
+        case DataType::Float:
+            baseDataType = DataType::Float;
+            break;
+        case DataType::Int:
+            baseDataType = DataType::Int;
+            break;
+        case DataType::UInt:
+            baseDataType = DataType::UInt;
+            break;
+        default:
+            return false;
+    }
+
+    numComponents = static_cast<unsigned int>(VectorTypeDim(dataType));
+
+    return true;
+}
+
+void VaryingPacker::Pack(
+    const std::vector<VarDecl*>&                    varDecls,
+    const std::string&                              identPrefix,
+    const std::vector<Reflection::PackedVarying>&   layout)
+{
+    /* Collect all packable varyings */
+    std::vector<PackingCandidate> candidates;
+
+    for (auto varDecl : varDecls)
+    {
+        PackingCandidate candidate;
+        if (IsPackableVarying(varDecl, candidate.baseDataType, candidate.numComponents))
+        {
+            candidate.varDecl           = varDecl;
+            candidate.interpModifiers   = varDecl->declStmntRef->typeSpecifier->interpModifiers;
+            candidate.semantic          = varDecl->semantic.ToString();
+            candidates.push_back(candidate);
+        }
+    }
+
+    if (!layout.empty())
+        PackWithLayout(candidates, identPrefix, layout);
+
+    PackFirstFit(candidates, identPrefix);
+}
+
+bool VaryingPacker::IsPacked(const VarDecl* varDecl) const
+{
+    return (packedVarDecls_.find(varDecl) != packedVarDecls_.end());
+}
+
+void VaryingPacker::Reflect(std::vector<Reflection::PackedVarying>& packedVaryings) const
+{
+    for (const auto& slot : slots_)
+    {
+        for (const auto& entry : slot.entries)
+        {
+            Reflection::PackedVarying packedVarying;
+            {
+                packedVarying.semantic          = entry.varDecl->semantic.ToString();
+                packedVarying.slotIdent         = slot.ident;
+                packedVarying.slot              = slot.slot;
+                packedVarying.firstComponent    = entry.firstComponent;
+                packedVarying.numComponents     = entry.numComponents;
+            }
+            packedVaryings.push_back(packedVarying);
+        }
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VaryingPacker::PackWithLayout(
+    std::vector<PackingCandidate>& candidates, const std::string& identPrefix, const std::vector<Reflection::PackedVarying>& layout)
+{
+    /* Place all candidates at the slot and components of the layout entry with the same semantic */
+    for (auto it = candidates.begin(); it != candidates.end();)
+    {
+        const auto semantic = ToUpper(it->semantic);
+
+        auto entryIt = std::find_if(
+            layout.begin(), layout.end(),
+            [&semantic](const Reflection::PackedVarying& entry)
+            {
+                return (ToUpper(entry.semantic) == semantic);
+            }
+        );
+
+        if (entryIt == layout.end() || entryIt->slot < 0 || it->numComponents > entryIt->numComponents)
+        {
+            ++it;
+            continue;
+        }
+
+        /* Find or create slot of the layout entry */
+        auto slotIt = std::find_if(
+            slots_.begin(), slots_.end(),
+            [entryIt](const VaryingSlot& slot)
+            {
+                return (slot.slot == entryIt->slot);
+            }
+        );
+
+        if (slotIt == slots_.end())
+        {
+            /* Slot keeps the size of the previous stage, even if this stage does not use all of its components */
+            unsigned int numComponents = 0;
+            for (const auto& entry : layout)
+            {
+                if (entry.slot == entryIt->slot)
+                    numComponents = std::max(numComponents, entry.firstComponent + entry.numComponents);
+            }
+
+            VaryingSlot slot;
+            {
+                slot.ident              = identPrefix + std::to_string(entryIt->slot);
+                slot.slot               = entryIt->slot;
+                slot.dataType           = VectorDataType(it->baseDataType, static_cast<int>(std::min(numComponents, g_numSlotComponents)));
+                slot.interpModifiers    = it->interpModifiers;
+            }
+            slotIt = slots_.insert(slots_.end(), slot);
+        }
+        else if (BaseDataType(slotIt->dataType) != it->baseDataType)
+        {
+            /* Scalar type class does not match the other varyings of this slot */
+            ++it;
+            continue;
+        }
+
+        /* Insert varying into slot, ordered by its first component */
+        VaryingSlot::Entry slotEntry { it->varDecl, entryIt->firstComponent, it->numComponents };
+
+        slotIt->entries.insert(
+            std::upper_bound(
+                slotIt->entries.begin(), slotIt->entries.end(), slotEntry,
+                [](const VaryingSlot::Entry& lhs, const VaryingSlot::Entry& rhs)
+                {
+                    return (lhs.firstComponent < rhs.firstComponent);
+                }
+            ),
+            slotEntry
+        );
+
+        packedVarDecls_.insert(it->varDecl);
+        it = candidates.erase(it);
+    }
+
+    std::sort(
+        slots_.begin(), slots_.end(),
+        [](const VaryingSlot& lhs, const VaryingSlot& rhs)
+        {
+            return (lhs.slot < rhs.slot);
+        }
+    );
+}
+
+void VaryingPacker::PackFirstFit(std::vector<PackingCandidate>& candidates, const std::string& identPrefix)
+{
+    /* Sort by packing group, then by decreasing size, then by semantic (independent of the declaration order) */
+    std::sort(
+        candidates.begin(), candidates.end(),
+        [](const PackingCandidate& lhs, const PackingCandidate& rhs)
+        {
+            return
+            (
+                std::make_tuple(lhs.interpModifiers, lhs.baseDataType, rhs.numComponents, lhs.semantic) <
+                std::make_tuple(rhs.interpModifiers, rhs.baseDataType, lhs.numComponents, rhs.semantic)
+            );
+        }
+    );
+
+    /* New slots are numbered after all previous slots, which may not be contiguous if they have been taken from a layout */
+    const auto firstSlot = slots_.size();
+    const auto firstSlotNumber = (slots_.empty() ? 0 : slots_.back().slot + 1);
+
+    /* Distribute varyings with first-fit over the slots of their packing group */
+    std::vector<unsigned int> slotSizes;
+    std::size_t firstGroupSlot = 0;
+
+    for (std::size_t i = 0; i < candidates.size(); ++i)
+    {
+        const auto& candidate = candidates[i];
+
+        /* Start new packing group? */
+        if (i > 0)
+        {
+            const auto& prev = candidates[i - 1];
+            if (prev.interpModifiers != candidate.interpModifiers || prev.baseDataType != candidate.baseDataType)
+                firstGroupSlot = slotSizes.size();
+        }
+
+        /* Find first slot with enough free components */
+        auto slotIndex = firstGroupSlot;
+        while (slotIndex < slotSizes.size() && slotSizes[slotIndex] + candidate.numComponents > g_numSlotComponents)
+            ++slotIndex;
+
+        if (slotIndex == slotSizes.size())
+        {
+            const auto slotNumber = firstSlotNumber + static_cast<int>(slotIndex);
+
+            VaryingSlot slot;
+            {
+                slot.ident              = identPrefix + std::to_string(slotNumber);
+                slot.slot               = slotNumber;
+                slot.dataType           = candidate.baseDataType;
+                slot.interpModifiers    = candidate.interpModifiers;
+            }
+            slots_.push_back(slot);
+            slotSizes.push_back(0);
+        }
+
+        /* Append varying to slot */
+        auto& slot = slots_[firstSlot + slotIndex];
+
+        slot.entries.push_back({ candidate.varDecl, slotSizes[slotIndex], candidate.numComponents });
+        slotSizes[slotIndex] += candidate.numComponents;
+
+        packedVarDecls_.insert(candidate.varDecl);
+    }
+
+    /* Determine final types of the new slots */
+    for (std::size_t i = 0; i < slotSizes.size(); ++i)
+        slots_[firstSlot + i].dataType = VectorDataType(slots_[firstSlot + i].dataType, static_cast<int>(slotSizes[i]));
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
@@ -0,0 +1,104 @@
+/*
+ * VaryingPacker.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_VARYING_PACKER_H
+#define XSC_VARYING_PACKER_H
+
+
+#include <Xsc/Reflection.h>
+#include "ASTEnums.h"
+#include "EnumSet.h"
+#include <string>
+#include <vector>
+#include <set>
+
+
+namespace Xsc
+{
+
+
+struct VarDecl;
+
+// Packed slot of several shader input/output variables (also referred to as "varyings").
+struct VaryingSlot
+{
+    // Varying inside a packed slot.
+    struct Entry
+    {
+        VarDecl*        varDecl;
+        unsigned int    firstComponent;
+        unsigned int    numComponents;
+    };
+
+    // Returns the swizzle operator for the specified entry (e.g. "yz"), or an empty string if the entry covers the entire slot.
+    std::string EntrySwizzle(const Entry& entry) const;
+
+    std::string                 ident;
+    int                         slot            = 0;
+    DataType                    dataType        = DataType::Undefined;  // Scalar or vector type of the entire slot.
+    EnumSet<InterpModifier>     interpModifiers;
+    std::vector<Entry>          entries;
+};
+
+/*
+Varying packer.
+Packs all user-defined scalar and vector varyings with equal interpolation modifiers and scalar type class (i.e. float, int, or uint)
+into 4-component slots. The order only depends on the semantics, so separately compiled shader stages with equal varyings agree on the packing.
+If a stage only uses some of the varyings of the previous stage, it must be packed with the packing map of the previous stage instead.
+*/
+class VaryingPacker
+{
+
+    public:
+
+        /*
+        Packs the specified varyings into slots with the specified identifier prefix (e.g. "xsv_pack").
+        Varyings that are found in the specified layout (i.e. the packing map of the previous stage) are placed at the same slot and components,
+        and all slots of the layout keep their size. All other varyings are packed into the slots after the layout.
+        */
+        void Pack(
+            const std::vector<VarDecl*>&                    varDecls,
+            const std::string&                              identPrefix,
+            const std::vector<Reflection::PackedVarying>&   layout          = {}
+        );
+
+        // Returns true if the specified variable has been packed into a slot.
+        bool IsPacked(const VarDecl* varDecl) const;
+
+        // Appends the packing map to the specified reflection output.
+        void Reflect(std::vector<Reflection::PackedVarying>& packedVaryings) const;
+
+        // Returns the list of all packed slots.
+        inline const std::vector<VaryingSlot>& GetSlots() const
+        {
+            return slots_;
+        }
+
+    private:
+
+        struct PackingCandidate;
+
+        // Places the candidates that are found in the layout, and removes them from the list.
+        void PackWithLayout(std::vector<PackingCandidate>& candidates, const std::string& identPrefix, const std::vector<Reflection::PackedVarying>& layout);
+
+        // Distributes the candidates with first-fit over new slots after all previous slots.
+        void PackFirstFit(std::vector<PackingCandidate>& candidates, const std::string& identPrefix);
+
+        std::vector<VaryingSlot>    slots_;
+        std::set<const VarDecl*>    packedVarDecls_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -65,6 +65,11 @@ void Generator::Warning(const std::string& msg, const AST* ast)
     reportHandler_.Warning(false, msg, program_->sourceCode.get(), (ast ? ast->area : SourceArea::ignore));
 }
 
+void Generator::Info(const std::string& msg, const AST* ast)
+{
+    reportHandler_.SubmitReport(false, Report::Types::Info, R_Message, msg, program_->sourceCode.get(), (ast ? ast->area : SourceArea::ignore));
+}
+
 void Generator::BeginLn()
 {
     writer_.BeginLine();
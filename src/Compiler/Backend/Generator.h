@@ -44,6 +44,7 @@ class Generator : protected Visitor
 
         void Error(const std::string& msg, const AST* ast = nullptr);
         void Warning(const std::string& msg, const AST* ast = nullptr);
+        void Info(const std::string& msg, const AST* ast = nullptr);
 
         void BeginLn();
         void EndLn();
@@ -0,0 +1,836 @@
+/*
+ * Batch.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <Xsc/Batch.h>
+#include "BatchScheduler.h"
+#include "BatchProcessPool.h"
+#include "ReportIdents.h"
+#include "Helper.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+
+namespace Xsc
+{
+
+
+/*
+ * Internal functions
+ */
+
+using BatchClock = std::chrono::steady_clock;
+
+// Weight of the previous duration when a new duration is recorded.
+static const double g_historyWeight = 0.5;
+
+// Default compile rate (in milliseconds per byte) for jobs without any timing history.
+static const double g_defaultMillisecondsPerByte = 0.005;
+
+static double ElapsedMilliseconds(const BatchClock::time_point& startTime, const BatchClock::time_point& endTime)
+{
+    return std::chrono::duration<double, std::milli>(endTime - startTime).count();
+}
+
+/* Returns a string with all options (except the filename, entry point, and shader target) that affect the compilation */
+static std::string OptionsFingerprint(const ShaderInput& inputDesc, const ShaderOutput& outputDesc)
+{
+    std::stringstream s;
+
+    const auto& opt = outputDesc.options;
+    const auto& fmt = outputDesc.formatting;
+    const auto& mng = outputDesc.nameMangling;
+
+    s << ToString(inputDesc.shaderVersion) << ';' << ToString(outputDesc.shaderVersion) << ';' << inputDesc.secondaryEntryPoint << ';';
+
+    for (auto flag : { opt.warnings, opt.optimize, opt.preprocessOnly, opt.validateOnly, opt.allowExtensions, opt.explicitBinding,
+                       opt.preserveComments, opt.preferWrappers, opt.unrollArrayInitializers, opt.rowMajorAlignment, opt.obfuscate,
+                       opt.showAST, opt.showTimes, opt.profileCounters, opt.optimizeLoops, opt.scalarReplacement, opt.parallelParsing, opt.vectorize, opt.flatVaryings, opt.positionOnly, opt.packVaryings, opt.extractPreshaders, opt.showMemory, opt.diagnosticsMode })
+    {
+        s << (flag ? '1' : '0');
+    }
+
+    s << ';' << opt.constantTableThreshold << ';' << opt.fastMath << ';' << opt.pushConstantBudget << ';' << opt.uniformStorageBufferSize << ';' << fmt.indent << ';';
+
+    for (auto flag : { fmt.blanks, fmt.lineMarks, fmt.compactWrappers, fmt.alwaysBracedScopes, fmt.newLineOpenScope, fmt.lineSeparation })
+        s << (flag ? '1' : '0');
+
+    s << ';' << mng.inputPrefix << ';' << mng.outputPrefix << ';' << mng.reservedWordPrefix << ';' << mng.temporaryPrefix << ';' << mng.useAlwaysSemantics;
+
+    for (const auto& vertexSemantic : outputDesc.vertexSemantics)
+        s << ';' << vertexSemantic.semantic << '=' << vertexSemantic.location;
+
+    for (const auto& semantic : outputDesc.flatInputSemantics)
+        s << ";flat=" << semantic;
+
+    for (const auto& packedVarying : outputDesc.packedInputLayout)
+        s << ";packed=" << packedVarying.semantic << '@' << packedVarying.slot << '.' << packedVarying.firstComponent << '.' << packedVarying.numComponents;
+
+    for (const auto& profileCount : outputDesc.profileCounts)
+        s << ";pgo=" << profileCount.location << '=' << profileCount.count;
+
+    return s.str();
+}
+
+/* Returns the size (in bytes) of the specified stream, and restores its reading position */
+static std::size_t StreamSize(std::istream& stream)
+{
+    auto pos = stream.tellg();
+    if (pos == std::istream::pos_type(-1))
+        return 0;
+
+    stream.seekg(0, std::ios::end);
+    auto end = stream.tellg();
+    stream.seekg(pos);
+
+    return (end > pos ? static_cast<std::size_t>(end - pos) : 0);
+}
+
+/* Returns the size (in bytes) of the input of the specified job, or 0 if the size is unknown */
+static std::size_t InputSize(const BatchJob& job)
+{
+    if (job.inputDesc.sourceCode)
+        return StreamSize(*job.inputDesc.sourceCode);
+
+    std::ifstream file(job.inputDesc.filename, std::ios::binary);
+    return (file.good() ? StreamSize(file) : 0);
+}
+
+static bool SubmitJobError(Log* log, const std::string& msg)
+{
+    if (log)
+        log->SumitReport(Report(Report::Types::Error, msg));
+    return false;
+}
+
+/* Compiles the specified job, and opens the input and output files if no streams are specified */
+static bool CompileBatchJob(const BatchJob& job, TaskScheduler& taskScheduler)
+{
+    try
+    {
+        auto inputDesc = job.inputDesc;
+
+        /* Execute the internal parallelism of the job on the scheduler of the batch, unless the job has its own */
+        if (!inputDesc.taskScheduler)
+            inputDesc.taskScheduler = &taskScheduler;
+
+        if (!inputDesc.sourceCode)
+        {
+            auto inputFile = std::make_shared<std::ifstream>(inputDesc.filename);
+            if (!inputFile->good())
+                return SubmitJobError(job.log, R_FailedToReadFile(inputDesc.filename));
+            inputDesc.sourceCode = inputFile;
+        }
+
+        if (job.outputDesc.sourceCode)
+            return CompileShader(inputDesc, job.outputDesc, job.log, job.reflectionData);
+
+        /* Compile into temporary stream, and write the output file only on success */
+        auto outputDesc = job.outputDesc;
+
+        std::stringstream outputStream;
+        outputDesc.sourceCode = &outputStream;
+
+        if (!CompileShader(inputDesc, outputDesc, job.log, job.reflectionData))
+            return false;
+
+        if (!outputDesc.options.validateOnly)
+        {
+            std::ofstream outputFile(outputDesc.filename);
+            if (!outputFile.good())
+                return SubmitJobError(job.log, R_FailedToWriteFile(outputDesc.filename));
+            outputFile << outputStream.rdbuf();
+        }
+
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        return SubmitJobError(job.log, R_BatchJobFailed(e.what()));
+    }
+}
+
+
+/* ----- Serialization of job results from worker processes ----- */
+
+// Log that records all reports of a job inside a worker process.
+class BatchRecordLog : public Log
+{
+
+    public:
+
+        struct IndentReport
+        {
+            std::string indent;
+            Report      report;
+        };
+
+        void SumitReport(const Report& report) override
+        {
+            reports.push_back({ FullIndent(), report });
+        }
+
+        std::vector<IndentReport> reports;
+
+};
+
+template <typename T>
+static void WritePOD(std::string& s, const T& value)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "WritePOD requires a trivially copyable type");
+    s.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void WriteString(std::string& s, const std::string& str)
+{
+    WritePOD(s, static_cast<std::uint64_t>(str.size()));
+    s.append(str);
+}
+
+static void WriteStringList(std::string& s, const std::vector<std::string>& list)
+{
+    WritePOD(s, static_cast<std::uint64_t>(list.size()));
+    for (const auto& str : list)
+        WriteString(s, str);
+}
+
+static void WriteBindingSlots(std::string& s, const std::vector<Reflection::BindingSlot>& slots)
+{
+    WritePOD(s, static_cast<std::uint64_t>(slots.size()));
+    for (const auto& slot : slots)
+    {
+        WriteString(s, slot.ident);
+        WritePOD(s, slot.location);
+    }
+}
+
+static void WritePackedVaryings(std::string& s, const std::vector<Reflection::PackedVarying>& packedVaryings)
+{
+    WritePOD(s, static_cast<std::uint64_t>(packedVaryings.size()));
+    for (const auto& packedVarying : packedVaryings)
+    {
+        WriteString(s, packedVarying.semantic);
+        WriteString(s, packedVarying.slotIdent);
+        WritePOD(s, packedVarying.slot);
+        WritePOD(s, packedVarying.firstComponent);
+        WritePOD(s, packedVarying.numComponents);
+    }
+}
+
+static void WriteReflection(std::string& s, const Reflection::ReflectionData& data)
+{
+    WriteStringList(s, data.macros);
+    WriteBindingSlots(s, data.textures);
+    WriteBindingSlots(s, data.storageBuffers);
+    WriteBindingSlots(s, data.constantBuffers);
+    WriteBindingSlots(s, data.inputAttributes);
+    WriteBindingSlots(s, data.outputAttributes);
+
+    WritePOD(s, static_cast<std::uint64_t>(data.samplerStates.size()));
+    for (const auto& samplerState : data.samplerStates)
+    {
+        WriteString(s, samplerState.first);
+        WritePOD(s, samplerState.second);
+    }
+
+    WritePOD(s, data.numThreads);
+
+    WriteString(s, data.preshaderBuffer);
+    WritePOD(s, static_cast<std::uint64_t>(data.preshaders.size()));
+    for (const auto& preshader : data.preshaders)
+    {
+        WriteString(s, preshader.ident);
+        WriteString(s, preshader.type);
+        WritePOD(s, static_cast<std::uint64_t>(preshader.instructions.size()));
+        for (const auto& instr : preshader.instructions)
+        {
+            WritePOD(s, instr.opcode);
+            WriteString(s, instr.value);
+            WritePOD(s, instr.numOperands);
+            WriteString(s, instr.type);
+        }
+    }
+
+    WriteString(s, data.constantTableBuffer);
+    WritePOD(s, static_cast<std::uint64_t>(data.constantTables.size()));
+    for (const auto& table : data.constantTables)
+    {
+        WriteString(s, table.ident);
+        WriteString(s, table.type);
+        WritePOD(s, table.size);
+        WritePOD(s, table.offset);
+        WritePOD(s, table.stride);
+    }
+    WriteString(s, std::string(data.constantTableData.begin(), data.constantTableData.end()));
+
+    WritePackedVaryings(s, data.packedInputs);
+    WritePackedVaryings(s, data.packedOutputs);
+    WriteStringList(s, data.flatOutputs);
+
+    WritePOD(s, static_cast<std::uint64_t>(data.resourceAccesses.size()));
+    for (const auto& access : data.resourceAccesses)
+    {
+        WriteString(s, access.ident);
+        WritePOD(s, access.read);
+        WritePOD(s, access.written);
+        WritePOD(s, access.atomic);
+        WritePOD(s, access.divergent);
+    }
+
+    WritePOD(s, static_cast<std::uint64_t>(data.bufferClasses.size()));
+    for (const auto& bufferClass : data.bufferClasses)
+    {
+        WriteString(s, bufferClass.ident);
+        WritePOD(s, bufferClass.storage);
+        WritePOD(s, bufferClass.offset);
+        WritePOD(s, bufferClass.size);
+        WritePOD(s, bufferClass.numElements);
+    }
+
+    WriteString(s, data.profileCounterBuffer.ident);
+    WritePOD(s, data.profileCounterBuffer.location);
+
+    WritePOD(s, static_cast<std::uint64_t>(data.profileCounters.size()));
+    for (const auto& counter : data.profileCounters)
+    {
+        WritePOD(s, counter.index);
+        WritePOD(s, counter.type);
+        WriteString(s, counter.function);
+        WriteString(s, counter.location);
+    }
+}
+
+// Reader for a serialized job result (throws std::runtime_error on corrupted data).
+class BatchResultReader
+{
+
+    public:
+
+        BatchResultReader(const std::string& data) :
+            data_ { data }
+        {
+        }
+
+        template <typename T>
+        void ReadPOD(T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "ReadPOD requires a trivially copyable type");
+            std::memcpy(&value, Advance(sizeof(value)), sizeof(value));
+        }
+
+        std::size_t ReadSize()
+        {
+            std::uint64_t size = 0;
+            ReadPOD(size);
+            if (size > data_.size())
+                throw std::runtime_error("corrupted batch job result");
+            return static_cast<std::size_t>(size);
+        }
+
+        std::string ReadString()
+        {
+            auto size = ReadSize();
+            return std::string(Advance(size), size);
+        }
+
+        void ReadStringList(std::vector<std::string>& list)
+        {
+            list.resize(ReadSize());
+            for (auto& str : list)
+                str = ReadString();
+        }
+
+        void ReadBindingSlots(std::vector<Reflection::BindingSlot>& slots)
+        {
+            slots.resize(ReadSize());
+            for (auto& slot : slots)
+            {
+                slot.ident = ReadString();
+                ReadPOD(slot.location);
+            }
+        }
+
+        void ReadPackedVaryings(std::vector<Reflection::PackedVarying>& packedVaryings)
+        {
+            packedVaryings.resize(ReadSize());
+            for (auto& packedVarying : packedVaryings)
+            {
+                packedVarying.semantic  = ReadString();
+                packedVarying.slotIdent = ReadString();
+                ReadPOD(packedVarying.slot);
+                ReadPOD(packedVarying.firstComponent);
+                ReadPOD(packedVarying.numComponents);
+            }
+        }
+
+        void ReadReflection(Reflection::ReflectionData& data)
+        {
+            ReadStringList(data.macros);
+            ReadBindingSlots(data.textures);
+            ReadBindingSlots(data.storageBuffers);
+            ReadBindingSlots(data.constantBuffers);
+            ReadBindingSlots(data.inputAttributes);
+            ReadBindingSlots(data.outputAttributes);
+
+            data.samplerStates.clear();
+            for (auto n = ReadSize(); n > 0; --n)
+            {
+                auto ident = ReadString();
+                ReadPOD(data.samplerStates[ident]);
+            }
+
+            ReadPOD(data.numThreads);
+
+            data.preshaderBuffer = ReadString();
+            data.preshaders.resize(ReadSize());
+            for (auto& preshader : data.preshaders)
+            {
+                preshader.ident = ReadString();
+                preshader.type  = ReadString();
+                preshader.instructions.resize(ReadSize());
+                for (auto& instr : preshader.instructions)
+                {
+                    ReadPOD(instr.opcode);
+                    instr.value = ReadString();
+                    ReadPOD(instr.numOperands);
+                    instr.type  = ReadString();
+                }
+            }
+
+            data.constantTableBuffer = ReadString();
+            data.constantTables.resize(ReadSize());
+            for (auto& table : data.constantTables)
+            {
+                table.ident = ReadString();
+                table.type  = ReadString();
+                ReadPOD(table.size);
+                ReadPOD(table.offset);
+                ReadPOD(table.stride);
+            }
+            auto tableData = ReadString();
+            data.constantTableData.assign(tableData.begin(), tableData.end());
+
+            ReadPackedVaryings(data.packedInputs);
+            ReadPackedVaryings(data.packedOutputs);
+            ReadStringList(data.flatOutputs);
+
+            data.resourceAccesses.resize(ReadSize());
+            for (auto& access : data.resourceAccesses)
+            {
+                access.ident = ReadString();
+                ReadPOD(access.read);
+                ReadPOD(access.written);
+                ReadPOD(access.atomic);
+                ReadPOD(access.divergent);
+            }
+
+            data.bufferClasses.resize(ReadSize());
+            for (auto& bufferClass : data.bufferClasses)
+            {
+                bufferClass.ident = ReadString();
+                ReadPOD(bufferClass.storage);
+                ReadPOD(bufferClass.offset);
+                ReadPOD(bufferClass.size);
+                ReadPOD(bufferClass.numElements);
+            }
+
+            data.profileCounterBuffer.ident = ReadString();
+            ReadPOD(data.profileCounterBuffer.location);
+
+            data.profileCounters.resize(ReadSize());
+            for (auto& counter : data.profileCounters)
+            {
+                ReadPOD(counter.index);
+                ReadPOD(counter.type);
+                counter.function = ReadString();
+                counter.location = ReadString();
+            }
+        }
+
+    private:
+
+        const char* Advance(std::size_t size)
+        {
+            if (size > data_.size() - pos_)
+                throw std::runtime_error("corrupted batch job result");
+            auto ptr = data_.data() + pos_;
+            pos_ += size;
+            return ptr;
+        }
+
+        const std::string&  data_;
+        std::size_t         pos_    = 0;
+
+};
+
+/* Compiles the specified job inside a worker process, and returns the serialized result */
+static std::string CompileBatchJobInWorker(const BatchJob& job)
+{
+    BatchRecordLog              log;
+    Reflection::ReflectionData  reflectionData;
+    std::stringstream           outputStream;
+
+    /* The threads of the host's task scheduler do not exist in the worker process, so all tasks of the job are executed serially */
+    StdTaskScheduler serialScheduler(1);
+
+    auto workerJob = job;
+    {
+        workerJob.inputDesc.taskScheduler = nullptr;
+        workerJob.log = &log;
+        if (job.reflectionData)
+            workerJob.reflectionData = &reflectionData;
+        if (job.outputDesc.sourceCode)
+            workerJob.outputDesc.sourceCode = &outputStream;
+    }
+
+    const auto startTime = BatchClock::now();
+    const bool succeeded = CompileBatchJob(workerJob, serialScheduler);
+    const auto duration = ElapsedMilliseconds(startTime, BatchClock::now());
+
+    std::string s;
+
+    WritePOD(s, duration);
+    WritePOD(s, succeeded);
+    WriteString(s, outputStream.str());
+
+    WritePOD(s, static_cast<std::uint64_t>(log.reports.size()));
+    for (const auto& entry : log.reports)
+    {
+        const auto& r = entry.report;
+        WriteString(s, entry.indent);
+        WritePOD(s, r.Type());
+        WriteString(s, r.Message());
+        WriteString(s, r.Line());
+        WriteString(s, r.Marker());
+        WriteString(s, r.Context());
+        WriteStringList(s, r.GetHints());
+    }
+
+    if (job.reflectionData)
+        WriteReflection(s, reflectionData);
+
+    return s;
+}
+
+/* Stores the serialized result of a worker process in the specified job and job result */
+static void ReadBatchJobResult(const BatchJob& job, BatchJobResult& result, const std::string& data)
+{
+    BatchResultReader reader(data);
+
+    reader.ReadPOD(result.actualDuration);
+    reader.ReadPOD(result.succeeded);
+
+    auto output = reader.ReadString();
+    if (job.outputDesc.sourceCode)
+        *job.outputDesc.sourceCode << output;
+
+    /* Submit recorded reports to the job log */
+    for (auto n = reader.ReadSize(); n > 0; --n)
+    {
+        auto        indent  = reader.ReadString();
+        auto        type    = Report::Types::Info;
+        reader.ReadPOD(type);
+        auto        message = reader.ReadString();
+        auto        line    = reader.ReadString();
+        auto        marker  = reader.ReadString();
+        auto        context = reader.ReadString();
+
+        std::vector<std::string> hints;
+        reader.ReadStringList(hints);
+
+        if (job.log)
+        {
+            Report report(type, message, line, marker, context);
+            report.TakeHints(std::move(hints));
+
+            if (indent.empty())
+                job.log->SumitReport(report);
+            else
+            {
+                /* Append indentation of the worker to the current indentation, and restore the caller's next indentation string */
+                const auto prevIndent = job.log->Indent();
+                job.log->SetIndent(indent);
+                job.log->IncIndent();
+                job.log->SumitReport(report);
+                job.log->DecIndent();
+                job.log->SetIndent(prevIndent);
+            }
+        }
+    }
+
+    if (job.reflectionData)
+        reader.ReadReflection(*job.reflectionData);
+}
+
+/*
+ * BatchTimings class
+ */
+
+bool BatchTimings::Load(const std::string& filename)
+{
+    std::ifstream file(filename);
+    if (!file.good())
+        return false;
+
+    /* Read one entry per line: "<duration> <TAB> <key>" */
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line.front() == '#')
+            continue;
+
+        auto pos = line.find('\t');
+        if (pos == std::string::npos)
+            continue;
+
+        try
+        {
+            durations_[line.substr(pos + 1)] = std::stod(line.substr(0, pos));
+        }
+        catch (const std::exception&)
+        {
+            /* Ignore malformed entries */
+        }
+    }
+
+    return true;
+}
+
+bool BatchTimings::Save(const std::string& filename) const
+{
+    std::ofstream file(filename);
+    if (!file.good())
+        return false;
+
+    file << "# XShaderCompiler batch timings (milliseconds, filename, entry point, target, options hash)" << std::endl;
+    file << std::fixed << std::setprecision(3);
+
+    for (const auto& entry : durations_)
+        file << entry.second << '\t' << entry.first << std::endl;
+
+    return file.good();
+}
+
+void BatchTimings::Record(const std::string& key, double duration)
+{
+    auto it = durations_.find(key);
+    if (it != durations_.end())
+        it->second = it->second * g_historyWeight + duration * (1.0 - g_historyWeight);
+    else
+        durations_[key] = duration;
+}
+
+bool BatchTimings::Find(const std::string& key, double& duration) const
+{
+    auto it = durations_.find(key);
+    if (it != durations_.end())
+    {
+        duration = it->second;
+        return true;
+    }
+    return false;
+}
+
+
+/*
+ * Global functions
+ */
+
+XSC_EXPORT std::string BatchJobKey(const BatchJob& job)
+{
+    std::stringstream s;
+
+    s << job.inputDesc.filename << '\t' << job.inputDesc.entryPoint << '\t' << ToString(job.inputDesc.shaderTarget) << '\t';
+    s << std::hex << std::setw(16) << std::setfill('0') << HashString(OptionsFingerprint(job.inputDesc, job.outputDesc));
+
+    return s.str();
+}
+
+XSC_EXPORT bool CompileShaderBatch(const std::vector<BatchJob>& jobs, const BatchDescriptor& batchDesc, BatchReport* report)
+{
+    /* Initialize timing history */
+    BatchTimings tempTimings;
+    auto timings = (batchDesc.timings != nullptr ? batchDesc.timings : &tempTimings);
+
+    if (!batchDesc.timingDatabase.empty())
+        timings->Load(batchDesc.timingDatabase);
+
+    /* Predict duration of each job from the timing history */
+    const auto numJobs = jobs.size();
+
+    std::vector<BatchJobResult> results(numJobs);
+    std::vector<std::string>    keys(numJobs);
+    std::vector<std::size_t>    inputSizes(numJobs, 0);
+
+    double historyDuration  = 0.0;
+    double historySize      = 0.0;
+
+    for (std::size_t i = 0; i < numJobs; ++i)
+    {
+        keys[i]         = BatchJobKey(jobs[i]);
+        inputSizes[i]   = InputSize(jobs[i]);
+
+        if (timings->Find(keys[i], results[i].predictedDuration))
+        {
+            results[i].predictedByHistory = true;
+            historyDuration += results[i].predictedDuration;
+            historySize     += static_cast<double>(inputSizes[i]);
+        }
+    }
+
+    /* Estimate duration of unseen jobs from their input size, calibrated by the jobs with timing history */
+    const auto millisecondsPerByte = (historyDuration > 0.0 && historySize > 0.0 ? historyDuration / historySize : g_defaultMillisecondsPerByte);
+
+    std::vector<double> costs(numJobs);
+
+    for (std::size_t i = 0; i < numJobs; ++i)
+    {
+        if (!results[i].predictedByHistory)
+            results[i].predictedDuration = std::max(1.0, static_cast<double>(inputSizes[i])) * millisecondsPerByte;
+        costs[i] = results[i].predictedDuration;
+    }
+
+    /* Determine number of worker threads */
+    auto& taskScheduler = (batchDesc.taskScheduler != nullptr ? *batchDesc.taskScheduler : StdTaskScheduler::Default());
+
+    auto numThreads = batchDesc.numThreads;
+    if (numThreads == 0)
+        numThreads = taskScheduler.Concurrency();
+    numThreads = std::max(1u, std::min(numThreads, static_cast<unsigned>(numJobs)));
+
+    /* Compile all jobs longest-expected-first */
+    BatchScheduler scheduler(costs, numThreads);
+
+    const auto isolateProcesses = (batchDesc.isolateProcesses && IsBatchProcessPoolSupported());
+    std::size_t numWorkerRestarts = 0;
+
+    const auto batchStartTime = BatchClock::now();
+
+    if (isolateProcesses)
+    {
+        numWorkerRestarts = RunBatchProcessPool(
+            scheduler,
+            [&](std::size_t jobIndex)
+            {
+                return CompileBatchJobInWorker(jobs[jobIndex]);
+            },
+            [&](unsigned worker, std::size_t jobIndex, const std::string& data, const std::string& crash)
+            {
+                auto& result = results[jobIndex];
+                result.worker = worker;
+                result.crash  = crash;
+
+                if (crash.empty())
+                {
+                    try
+                    {
+                        ReadBatchJobResult(jobs[jobIndex], result, data);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        result.succeeded = SubmitJobError(jobs[jobIndex].log, R_BatchJobFailed(e.what()));
+                    }
+                }
+                else
+                    result.succeeded = SubmitJobError(jobs[jobIndex].log, R_WorkerProcessCrashed(crash));
+            }
+        );
+    }
+    else
+    {
+        scheduler.Run(
+            [&](unsigned worker, std::size_t jobIndex)
+            {
+                auto& result = results[jobIndex];
+                const auto startTime = BatchClock::now();
+                {
+                    result.succeeded = CompileBatchJob(jobs[jobIndex], taskScheduler);
+                }
+                result.actualDuration   = ElapsedMilliseconds(startTime, BatchClock::now());
+                result.worker           = worker;
+            },
+            taskScheduler
+        );
+    }
+
+    const auto batchEndTime = BatchClock::now();
+
+    /* Update timing history with successful jobs only, since failed and crashed jobs stop early and would skew the predicted durations */
+    for (std::size_t i = 0; i < numJobs; ++i)
+    {
+        if (results[i].succeeded)
+            timings->Record(keys[i], results[i].actualDuration);
+    }
+
+    if (!batchDesc.timingDatabase.empty())
+        timings->Save(batchDesc.timingDatabase);
+
+    /* Fill batch report */
+    const auto allSucceeded = std::all_of(
+        results.begin(), results.end(),
+        [](const BatchJobResult& result)
+        {
+            return result.succeeded;
+        }
+    );
+
+    if (report)
+    {
+        std::vector<std::size_t> submissionOrder(numJobs);
+        std::iota(submissionOrder.begin(), submissionOrder.end(), 0);
+
+        report->numThreads                  = numThreads;
+        report->isolateProcesses            = isolateProcesses;
+        report->numWorkerRestarts           = numWorkerRestarts;
+        report->numPredictedByHistory       = static_cast<std::size_t>(std::count_if(
+            results.begin(), results.end(),
+            [](const BatchJobResult& result)
+            {
+                return result.predictedByHistory;
+            }
+        ));
+        report->predictedMakespan           = scheduler.PredictedMakespan();
+        report->predictedMakespanInOrder    = BatchScheduler::PredictMakespan(costs, submissionOrder, numThreads);
+        report->actualMakespan              = ElapsedMilliseconds(batchStartTime, batchEndTime);
+        report->results                     = std::move(results);
+    }
+
+    return allSucceeded;
+}
+
+XSC_EXPORT void PrintBatchReport(std::ostream& stream, const BatchReport& report)
+{
+    stream << "batch compilation:" << std::endl;
+    stream << "  jobs:                          " << report.results.size() << " (" << report.numPredictedByHistory << " predicted by history)" << std::endl;
+    if (report.isolateProcesses)
+    {
+        stream << "  worker processes:              " << report.numThreads << std::endl;
+        stream << "  worker process restarts:       " << report.numWorkerRestarts << std::endl;
+    }
+    else
+        stream << "  threads:                       " << report.numThreads << std::endl;
+
+    stream << std::fixed << std::setprecision(1);
+    stream << "  predicted makespan:            " << report.predictedMakespan << " ms" << std::endl;
+    stream << "  predicted makespan (in order): " << report.predictedMakespanInOrder << " ms" << std::endl;
+    stream << "  actual makespan:               " << report.actualMakespan << " ms" << std::endl;
+    stream.unsetf(std::ios::floatfield);
+    stream << std::setprecision(6);
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
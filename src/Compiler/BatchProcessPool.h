@@ -0,0 +1,55 @@
+/*
+ * BatchProcessPool.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_BATCH_PROCESS_POOL_H
+#define XSC_BATCH_PROCESS_POOL_H
+
+
+#include "BatchScheduler.h"
+#include <string>
+#include <functional>
+
+
+namespace Xsc
+{
+
+
+/*
+Job function callback for the worker processes.
+This is called inside a worker process and returns the serialized result of the job.
+*/
+using BatchProcessJobFunction = std::function<std::string(std::size_t jobIndex)>;
+
+/*
+Result function callback for the parent process.
+If the worker process crashed, 'crash' describes the reason (e.g. the signal) and 'result' is empty.
+*/
+using BatchProcessResultFunction = std::function<void(unsigned worker, std::size_t jobIndex, const std::string& result, const std::string& crash)>;
+
+// Returns true if crash-isolated worker processes are supported on this platform.
+bool IsBatchProcessPoolSupported();
+
+/*
+Runs all jobs of the specified scheduler on a pool of pre-forked worker processes (one per scheduler worker).
+The worker processes are kept alive across jobs, and a crashed worker process is restarted.
+Returns the number of worker processes that have been restarted.
+*/
+std::size_t RunBatchProcessPool(
+    BatchScheduler&                     scheduler,
+    const BatchProcessJobFunction&      jobFunc,
+    const BatchProcessResultFunction&   resultFunc
+);
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,147 @@
+/*
+ * BatchScheduler.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "BatchScheduler.h"
+#include <algorithm>
+#include <numeric>
+
+
+namespace Xsc
+{
+
+
+/* Returns the job indices sorted by descending cost (stable, to keep the submission order for equal costs) */
+static std::vector<std::size_t> LongestFirstOrder(const std::vector<double>& costs)
+{
+    std::vector<std::size_t> order(costs.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    std::stable_sort(
+        order.begin(), order.end(),
+        [&costs](std::size_t lhs, std::size_t rhs)
+        {
+            return (costs[lhs] > costs[rhs]);
+        }
+    );
+
+    return order;
+}
+
+BatchScheduler::BatchScheduler(const std::vector<double>& costs, unsigned numWorkers) :
+    costs_  ( costs                    ),
+    queues_ ( std::max(1u, numWorkers) )
+{
+    /* Assign each job (longest first) to the queue with the least load */
+    for (auto jobIndex : LongestFirstOrder(costs_))
+    {
+        auto queue = std::min_element(
+            queues_.begin(), queues_.end(),
+            [](const WorkerQueue& lhs, const WorkerQueue& rhs)
+            {
+                return (lhs.pendingCost < rhs.pendingCost);
+            }
+        );
+        queue->jobs.push_back(jobIndex);
+        queue->pendingCost += costs_[jobIndex];
+    }
+
+    for (const auto& queue : queues_)
+        predictedMakespan_ = std::max(predictedMakespan_, queue.pendingCost);
+}
+
+bool BatchScheduler::NextJob(unsigned worker, std::size_t& jobIndex)
+{
+    std::lock_guard<std::mutex> guard { queueMutex_ };
+
+    /* Take next job from own queue */
+    if (worker < queues_.size() && PopJob(queues_[worker], jobIndex))
+        return true;
+
+    /* Steal largest pending job from the queue with the most pending work */
+    auto victim = std::max_element(
+        queues_.begin(), queues_.end(),
+        [](const WorkerQueue& lhs, const WorkerQueue& rhs)
+        {
+            if (lhs.jobs.empty() != rhs.jobs.empty())
+                return lhs.jobs.empty();
+            return (lhs.pendingCost < rhs.pendingCost);
+        }
+    );
+
+    return PopJob(*victim, jobIndex);
+}
+
+void BatchScheduler::RequeueJob(unsigned worker, std::size_t jobIndex)
+{
+    std::lock_guard<std::mutex> guard { queueMutex_ };
+
+    auto& queue = queues_[std::min(worker, NumWorkers() - 1u)];
+    queue.jobs.push_front(jobIndex);
+    queue.pendingCost += costs_[jobIndex];
+}
+
+void BatchScheduler::Run(const JobFunction& jobFunc, TaskScheduler& taskScheduler)
+{
+    auto WorkerProc = [this, &jobFunc](unsigned worker)
+    {
+        std::size_t jobIndex = 0;
+        while (NextJob(worker, jobIndex))
+            jobFunc(worker, jobIndex);
+    };
+
+    if (queues_.size() == 1)
+    {
+        /* Run single worker on the calling thread */
+        WorkerProc(0);
+    }
+    else
+    {
+        const auto group = TaskScheduler::NewGroup();
+
+        for (unsigned worker = 0; worker < queues_.size(); ++worker)
+            taskScheduler.Submit(group, std::bind(WorkerProc, worker));
+
+        taskScheduler.Wait(group);
+    }
+}
+
+double BatchScheduler::PredictMakespan(const std::vector<double>& costs, const std::vector<std::size_t>& order, unsigned numWorkers)
+{
+    std::vector<double> loads(std::max(1u, numWorkers), 0.0);
+
+    for (auto jobIndex : order)
+    {
+        auto load = std::min_element(loads.begin(), loads.end());
+        *load += costs[jobIndex];
+    }
+
+    return *std::max_element(loads.begin(), loads.end());
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool BatchScheduler::PopJob(WorkerQueue& queue, std::size_t& jobIndex)
+{
+    if (queue.jobs.empty())
+        return false;
+
+    jobIndex = queue.jobs.front();
+    queue.jobs.pop_front();
+    queue.pendingCost -= costs_[jobIndex];
+
+    return true;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
@@ -0,0 +1,92 @@
+/*
+ * BatchScheduler.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_BATCH_SCHEDULER_H
+#define XSC_BATCH_SCHEDULER_H
+
+
+#include <Xsc/TaskScheduler.h>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <functional>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+/*
+Job scheduler for batch compilation:
+All jobs are distributed longest-expected-first onto the worker queues (LPT scheduling),
+and idle workers steal pending jobs from the other worker queues.
+*/
+class BatchScheduler
+{
+
+    public:
+
+        // Job function callback with worker index and job index.
+        using JobFunction = std::function<void(unsigned worker, std::size_t jobIndex)>;
+
+        // Distributes the jobs with the specified expected costs onto the specified number of worker queues.
+        BatchScheduler(const std::vector<double>& costs, unsigned numWorkers);
+
+        /*
+        Stores the next job for the specified worker in 'jobIndex': the front of its own queue,
+        or otherwise the largest pending job stolen from the most loaded queue. Returns false if no job is left.
+        */
+        bool NextJob(unsigned worker, std::size_t& jobIndex);
+
+        // Puts the specified job back in front of the queue of the specified worker, e.g. if it could not be sent to a worker process.
+        void RequeueJob(unsigned worker, std::size_t jobIndex);
+
+        // Runs all jobs with one task per worker on the specified task scheduler, and returns when all jobs are done.
+        void Run(const JobFunction& jobFunc, TaskScheduler& taskScheduler);
+
+        // Returns the predicted makespan of greedy list scheduling in the specified job order.
+        static double PredictMakespan(const std::vector<double>& costs, const std::vector<std::size_t>& order, unsigned numWorkers);
+
+        // Returns the number of workers.
+        inline unsigned NumWorkers() const
+        {
+            return static_cast<unsigned>(queues_.size());
+        }
+
+        // Returns the predicted makespan of the initial distribution.
+        inline double PredictedMakespan() const
+        {
+            return predictedMakespan_;
+        }
+
+    private:
+
+        struct WorkerQueue
+        {
+            std::deque<std::size_t> jobs;
+            double                  pendingCost = 0.0;
+        };
+
+        bool PopJob(WorkerQueue& queue, std::size_t& jobIndex);
+
+        std::vector<double>         costs_;
+        std::vector<WorkerQueue>    queues_;
+        std::mutex                  queueMutex_;
+        double                      predictedMakespan_  = 0.0;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
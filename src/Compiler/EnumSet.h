@@ -0,0 +1,211 @@
+/*
+ * EnumSet.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_ENUM_SET_H
+#define XSC_ENUM_SET_H
+
+
+#include <initializer_list>
+#include <iterator>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <stdexcept>
+#include <string>
+
+
+namespace Xsc
+{
+
+
+/*
+Set of enumeration entries, which is stored as bit mask instead of a tree of heap allocated nodes.
+The enumeration entries must be in the range [0, 32), which is checked on every conversion into a bit.
+The iteration order is the same as for 'std::set' (i.e. ascending).
+*/
+template <typename T>
+class EnumSet
+{
+
+    public:
+
+        static_assert(std::is_enum<T>::value, "EnumSet requires an enumeration type");
+
+        // Number of bits of the storage word, i.e. the upper bound of the enumeration entries.
+        static const std::uint32_t maxEntries = 32u;
+
+        // Forward iterator over all entries in ascending order.
+        class const_iterator
+        {
+
+            public:
+
+                using iterator_category = std::forward_iterator_tag;
+                using value_type        = T;
+                using difference_type   = std::ptrdiff_t;
+                using pointer           = const T*;
+                using reference         = T;
+
+                const_iterator() = default;
+
+                inline explicit const_iterator(std::uint32_t bitMask) :
+                    bitMask_ { bitMask }
+                {
+                }
+
+                inline T operator * () const
+                {
+                    return static_cast<T>(LowestBit(bitMask_));
+                }
+
+                inline const_iterator& operator ++ ()
+                {
+                    /* Remove lowest bit */
+                    bitMask_ &= (bitMask_ - 1u);
+                    return *this;
+                }
+
+                inline const_iterator operator ++ (int)
+                {
+                    auto prev = *this;
+                    ++(*this);
+                    return prev;
+                }
+
+                inline bool operator == (const const_iterator& rhs) const
+                {
+                    return (bitMask_ == rhs.bitMask_);
+                }
+
+                inline bool operator != (const const_iterator& rhs) const
+                {
+                    return (bitMask_ != rhs.bitMask_);
+                }
+
+            private:
+
+                std::uint32_t bitMask_ = 0;
+
+        };
+
+        using iterator      = const_iterator;
+        using value_type    = T;
+        using size_type     = std::size_t;
+
+        EnumSet() = default;
+        EnumSet(const EnumSet&) = default;
+        EnumSet& operator = (const EnumSet&) = default;
+
+        inline EnumSet(std::initializer_list<T> values)
+        {
+            for (auto value : values)
+                insert(value);
+        }
+
+        // Inserts the specified entry and returns true if the entry has not already been contained.
+        inline bool insert(const T value)
+        {
+            const auto bit = Bit(value);
+            const bool inserted = ((bitMask_ & bit) == 0);
+            bitMask_ |= bit;
+            return inserted;
+        }
+
+        // Removes the specified entry and returns the number of removed entries (0 or 1).
+        inline size_type erase(const T value)
+        {
+            const auto bit = Bit(value);
+            const bool contained = ((bitMask_ & bit) != 0);
+            bitMask_ &= ~bit;
+            return (contained ? 1u : 0u);
+        }
+
+        // Returns the number of specified entries that are contained (0 or 1).
+        inline size_type count(const T value) const
+        {
+            return ((bitMask_ & Bit(value)) != 0 ? 1u : 0u);
+        }
+
+        inline void clear()
+        {
+            bitMask_ = 0;
+        }
+
+        inline bool empty() const
+        {
+            return (bitMask_ == 0);
+        }
+
+        inline size_type size() const
+        {
+            size_type n = 0;
+            for (auto bitMask = bitMask_; bitMask != 0; bitMask &= (bitMask - 1u))
+                ++n;
+            return n;
+        }
+
+        inline const_iterator begin() const
+        {
+            return const_iterator { bitMask_ };
+        }
+
+        inline const_iterator end() const
+        {
+            return const_iterator {};
+        }
+
+        inline bool operator == (const EnumSet& rhs) const
+        {
+            return (bitMask_ == rhs.bitMask_);
+        }
+
+        inline bool operator != (const EnumSet& rhs) const
+        {
+            return (bitMask_ != rhs.bitMask_);
+        }
+
+        // Compares the entries lexicographically (the same as 'std::set').
+        inline bool operator < (const EnumSet& rhs) const
+        {
+            return std::lexicographical_compare(begin(), end(), rhs.begin(), rhs.end());
+        }
+
+    private:
+
+        static inline std::uint32_t Bit(const T value)
+        {
+            const auto index = static_cast<std::uint32_t>(value);
+            if (index >= maxEntries)
+                throw std::out_of_range("enumeration entry out of range for EnumSet: " + std::to_string(index));
+            return (1u << index);
+        }
+
+        static inline std::uint32_t LowestBit(std::uint32_t bitMask)
+        {
+            std::uint32_t index = 0;
+            while ((bitMask & 1u) == 0)
+            {
+                bitMask >>= 1;
+                ++index;
+            }
+            return index;
+        }
+
+        std::uint32_t bitMask_ = 0;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -26,7 +26,8 @@ bool Analyzer::DecorateAST(
     Program& program, const ShaderInput& inputDesc, const ShaderOutput& outputDesc)
 {
     /* Decorate program AST */
-    sourceCode_ = program.sourceCode.get();
+    sourceCode_         = program.sourceCode.get();
+    diagnosticsMode_    = outputDesc.options.diagnosticsMode;
 
     try
     {
@@ -147,7 +148,14 @@ AST* Analyzer::Fetch(const std::string& ident, const AST* ast)
 
         /* Fetch symbol from global symbol table */
         if (auto symbol = symTable_.Fetch(ident))
-            return symbol->Fetch();
+        {
+            if (!diagnosticsMode_)
+                return symbol->Fetch();
+            if (auto ref = symbol->Fetch(false))
+                return ref;
+            Error(R_AmbiguousSymbol(ident), ast);
+            return nullptr;
+        }
         
         /* Report undefined identifier error */
         ErrorUndeclaredIdent(ident, "", FetchSimilarIdent(ident, structDecl), ast);
@@ -173,7 +181,13 @@ AST* Analyzer::FetchType(const std::string& ident, const AST* ast)
     try
     {
         if (auto symbol = symTable_.Fetch(ident))
-            return symbol->FetchType();
+        {
+            if (!diagnosticsMode_)
+                return symbol->FetchType();
+            if (auto ref = symbol->FetchType(false))
+                return ref;
+            Error((symbol->Fetch(false) ? R_IdentIsNotType(ident) : R_AmbiguousSymbol(ident)), ast);
+        }
         else
             ErrorUndeclaredIdent(ident, "", FetchSimilarIdent(ident), ast);
     }
@@ -189,7 +203,13 @@ VarDecl* Analyzer::FetchVarDecl(const std::string& ident, const AST* ast)
     try
     {
         if (auto symbol = symTable_.Fetch(ident))
-            return symbol->FetchVarDecl();
+        {
+            if (!diagnosticsMode_)
+                return symbol->FetchVarDecl();
+            if (auto varDecl = symbol->FetchVarDecl(false))
+                return varDecl;
+            Error((symbol->Fetch(false) ? R_IdentIsNotVar(ident) : R_AmbiguousSymbol(ident)), ast);
+        }
         else
             ErrorUndeclaredIdent(ident, "", FetchSimilarIdent(ident), ast);
     }
@@ -200,7 +220,7 @@ VarDecl* Analyzer::FetchVarDecl(const std::string& ident, const AST* ast)
     return nullptr;
 }
 
-FunctionDecl* Analyzer::FetchFunctionDecl(const std::string& ident, const std::vector<ExprPtr>& args, const AST* ast)
+FunctionDecl* Analyzer::FetchFunctionDecl(const std::string& ident, const ExprList& args, const AST* ast)
 {
     try
     {
@@ -209,16 +229,32 @@ FunctionDecl* Analyzer::FetchFunctionDecl(const std::string& ident, const std::v
         if (!CollectArgumentTypeDenoters(args, argTypeDens))
             return nullptr;
 
+        /* In diagnostics mode, overload resolution failures are returned as error message instead of being thrown */
+        std::string errorMsg;
+        auto errorMsgOut = (diagnosticsMode_ ? &errorMsg : nullptr);
+
         if (auto structDecl = ActiveFunctionStructDecl())
         {
             /* Fetch function with argument type denoters form structure */
-            if (auto funcDecl = structDecl->FetchFunctionDecl(ident, argTypeDens))
+            if (auto funcDecl = structDecl->FetchFunctionDecl(ident, argTypeDens, nullptr, errorMsgOut))
                 return funcDecl;
         }
 
-        /* Fetch function with argument type denoters from global symbol table */
-        if (auto symbol = symTable_.Fetch(ident))
-            return symbol->FetchFunctionDecl(argTypeDens);
+        if (errorMsg.empty())
+        {
+            /* Fetch function with argument type denoters from global symbol table */
+            if (auto symbol = symTable_.Fetch(ident))
+            {
+                if (auto funcDecl = symbol->FetchFunctionDecl(argTypeDens, errorMsgOut))
+                    return funcDecl;
+            }
+        }
+
+        if (!errorMsg.empty())
+        {
+            Error(errorMsg, ast);
+            return nullptr;
+        }
         
         /* Check if identifier exists but does not name a function */
         if (Fetch(ident, ast) != nullptr)
@@ -241,7 +277,13 @@ FunctionDecl* Analyzer::FetchFunctionDecl(const std::string& ident, const AST* a
     try
     {
         if (auto symbol = symTable_.Fetch(ident))
-            return symbol->FetchFunctionDecl();
+        {
+            if (!diagnosticsMode_)
+                return symbol->FetchFunctionDecl();
+            if (auto funcDecl = symbol->FetchFunctionDecl(false))
+                return funcDecl;
+            Error((symbol->Fetch(false) ? R_IdentIsNotFunc(ident) : R_AmbiguousSymbol(ident)), ast);
+        }
         else
             ErrorUndeclaredIdent(ident, "", FetchSimilarIdent(ident), ast);
     }
@@ -268,7 +310,7 @@ VarDecl* Analyzer::FetchFromStruct(const StructTypeDenoter& structTypeDenoter, c
 
 FunctionDecl* Analyzer::FetchFunctionDeclFromStruct(
     const StructTypeDenoter& structTypeDenoter, const std::string& ident,
-    const std::vector<ExprPtr>& args, const AST* ast)
+    const ExprList& args, const AST* ast)
 {
     if (auto structDecl = structTypeDenoter.structDeclRef)
     {
@@ -276,8 +318,11 @@ FunctionDecl* Analyzer::FetchFunctionDeclFromStruct(
         std::vector<TypeDenoterPtr> argTypeDens;
         if (CollectArgumentTypeDenoters(args, argTypeDens))
         {
-            if (auto symbol = structDecl->FetchFunctionDecl(ident, argTypeDens))
+            std::string errorMsg;
+            if (auto symbol = structDecl->FetchFunctionDecl(ident, argTypeDens, nullptr, (diagnosticsMode_ ? &errorMsg : nullptr)))
                 return symbol;
+            else if (!errorMsg.empty())
+                Error(errorMsg, ast);
             else
                 ErrorUndeclaredIdent(ident, structDecl->ToString(), structDecl->FetchSimilar(ident), ast);
         }
@@ -524,7 +569,7 @@ float Analyzer::EvaluateConstExprFloat(Expr& expr)
  * ======= Private: =======
  */
 
-bool Analyzer::CollectArgumentTypeDenoters(const std::vector<ExprPtr>& args, std::vector<TypeDenoterPtr>& argTypeDens)
+bool Analyzer::CollectArgumentTypeDenoters(const ExprList& args, std::vector<TypeDenoterPtr>& argTypeDens)
 {
     for (const auto& arg : args)
     {
@@ -93,7 +93,7 @@ class Analyzer : protected Visitor
         VarDecl* FetchVarDecl(const std::string& ident, const AST* ast = nullptr);
 
         // Tries to fetch a 'FunctionDecl' with the specified identifier and arguments from the symbol table and reports an error on failure.
-        FunctionDecl* FetchFunctionDecl(const std::string& ident, const std::vector<ExprPtr>& args, const AST* ast = nullptr);
+        FunctionDecl* FetchFunctionDecl(const std::string& ident, const ExprList& args, const AST* ast = nullptr);
 
         // Tries to fetch a 'FunctionDecl' with the specified identifier from the symbol table and reports an error on failure (used for patch-constant-function).
         FunctionDecl* FetchFunctionDecl(const std::string& ident, const AST* ast = nullptr);
@@ -103,7 +103,7 @@ class Analyzer : protected Visitor
 
         FunctionDecl* FetchFunctionDeclFromStruct(
             const StructTypeDenoter& structTypeDenoter, const std::string& ident,
-            const std::vector<ExprPtr>& args, const AST* ast = nullptr
+            const ExprList& args, const AST* ast = nullptr
         );
 
         StructDecl* FetchStructDeclFromIdent(const std::string& ident, const AST* ast = nullptr);
@@ -150,7 +150,7 @@ class Analyzer : protected Visitor
 
         /* === Functions === */
 
-        bool CollectArgumentTypeDenoters(const std::vector<ExprPtr>& args, std::vector<TypeDenoterPtr>& argTypeDens);
+        bool CollectArgumentTypeDenoters(const ExprList& args, std::vector<TypeDenoterPtr>& argTypeDens);
 
         //! Tries to find a similar identifier in the following order: symbol table, structure (if enabled).
         std::string FetchSimilarIdent(const std::string& ident, StructDecl* structDecl = nullptr) const;
@@ -160,6 +160,9 @@ class Analyzer : protected Visitor
         ReportHandler           reportHandler_;
         SourceCode*             sourceCode_     = nullptr;
 
+        // Specifies whether symbol lookups report their failures directly instead of throwing exceptions.
+        bool                    diagnosticsMode_    = false;
+
         ASTSymbolOverloadTable  symTable_;
 
 };
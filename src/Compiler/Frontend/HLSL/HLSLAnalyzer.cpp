@@ -629,18 +629,29 @@ IMPLEMENT_VISIT_PROC(SuffixExpr)
 {
     Visit(ast->expr);
 
-    /* Left-hand-side of the suffix expression must be either from type structure or base (for vector subscript) */
-    auto typeDenoter = ast->expr->GetTypeDenoter()->Get();
-
-    if (auto structTypeDen = typeDenoter->As<StructTypeDenoter>())
+    try
     {
-        /* Fetch struct member variable declaration from next identifier */
-        if (auto memberVarDecl = FetchFromStruct(*structTypeDen, ast->varIdent->ident, ast->varIdent.get()))
+        /* Left-hand-side of the suffix expression must be either from type structure or base (for vector subscript) */
+        auto typeDenoter = ast->expr->GetTypeDenoter()->Get();
+
+        if (auto structTypeDen = typeDenoter->As<StructTypeDenoter>())
         {
-            /* Analyzer next identifier with fetched symbol */
-            AnalyzeVarIdentWithSymbol(ast->varIdent.get(), memberVarDecl);
+            /* Fetch struct member variable declaration from next identifier */
+            if (auto memberVarDecl = FetchFromStruct(*structTypeDen, ast->varIdent->ident, ast->varIdent.get()))
+            {
+                /* Analyzer next identifier with fetched symbol */
+                AnalyzeVarIdentWithSymbol(ast->varIdent.get(), memberVarDecl);
+            }
         }
     }
+    catch (const ASTRuntimeError& e)
+    {
+        Error(e.what(), e.GetAST());
+    }
+    catch (const std::exception& e)
+    {
+        Error(e.what(), ast);
+    }
 }
 
 IMPLEMENT_VISIT_PROC(VarAccessExpr)
@@ -902,7 +913,7 @@ void HLSLAnalyzer::AnalyzeVarIdentWithSymbolVarDecl(VarIdent* varIdent, VarDecl*
     }
 }
 
-void HLSLAnalyzer::AnalyzeFunctionVarIdent(VarIdent* varIdent, const std::vector<ExprPtr>& args)
+void HLSLAnalyzer::AnalyzeFunctionVarIdent(VarIdent* varIdent, const ExprList& args)
 {
     /* Analyze variable identifier itself */
     if (varIdent)
@@ -934,7 +945,7 @@ void HLSLAnalyzer::AnalyzeFunctionVarIdent(VarIdent* varIdent, const std::vector
     AnalyzeVarIdentArrayIndices(varIdent);
 }
 
-void HLSLAnalyzer::AnalyzeFunctionVarIdentWithSymbol(VarIdent* varIdent, const std::vector<ExprPtr>& args, AST* symbol)
+void HLSLAnalyzer::AnalyzeFunctionVarIdentWithSymbol(VarIdent* varIdent, const ExprList& args, AST* symbol)
 {
     /* Decorate variable identifier with this symbol */
     varIdent->symbolRef = symbol;
@@ -956,7 +967,7 @@ void HLSLAnalyzer::AnalyzeFunctionVarIdentWithSymbol(VarIdent* varIdent, const s
     }
 }
 
-void HLSLAnalyzer::AnalyzeFunctionVarIdentWithSymbolVarDecl(VarIdent* varIdent, const std::vector<ExprPtr>& args, VarDecl* varDecl)
+void HLSLAnalyzer::AnalyzeFunctionVarIdentWithSymbolVarDecl(VarIdent* varIdent, const ExprList& args, VarDecl* varDecl)
 {
     /* Decorate next identifier */
     if (varIdent->next)
@@ -94,9 +94,9 @@ class HLSLAnalyzer : public Analyzer
         void AnalyzeVarIdentWithSymbol(VarIdent* varIdent, AST* symbol);
         void AnalyzeVarIdentWithSymbolVarDecl(VarIdent* varIdent, VarDecl* varDecl);
 
-        void AnalyzeFunctionVarIdent(VarIdent* varIdent, const std::vector<ExprPtr>& args);
-        void AnalyzeFunctionVarIdentWithSymbol(VarIdent* varIdent, const std::vector<ExprPtr>& args, AST* symbol);
-        void AnalyzeFunctionVarIdentWithSymbolVarDecl(VarIdent* varIdent, const std::vector<ExprPtr>& args, VarDecl* varDecl);
+        void AnalyzeFunctionVarIdent(VarIdent* varIdent, const ExprList& args);
+        void AnalyzeFunctionVarIdentWithSymbol(VarIdent* varIdent, const ExprList& args, AST* symbol);
+        void AnalyzeFunctionVarIdentWithSymbolVarDecl(VarIdent* varIdent, const ExprList& args, VarDecl* varDecl);
 
         void AnalyzeVarIdentArrayIndices(VarIdent* varIdent);
 
@@ -241,7 +241,7 @@ static std::size_t IntrinsicReturnTypeToArgIndex(const IntrinsicReturnType t)
     }
 }
 
-static TypeDenoterPtr DeriveCommonTypeDenoter(std::size_t majorArgIndex, const std::vector<ExprPtr>& args)
+static TypeDenoterPtr DeriveCommonTypeDenoter(std::size_t majorArgIndex, const ExprList& args)
 {
     if (majorArgIndex < args.size())
     {
@@ -270,7 +270,7 @@ struct IntrinsicSignature
     IntrinsicSignature(int numArgsMin, int numArgsMax);
     IntrinsicSignature(IntrinsicReturnType returnType, int numArgs = 0);
 
-    TypeDenoterPtr GetTypeDenoterWithArgs(const std::vector<ExprPtr>& args) const;
+    TypeDenoterPtr GetTypeDenoterWithArgs(const ExprList& args) const;
 
     IntrinsicReturnType returnType = IntrinsicReturnType::Void;
     int                 numArgsMin = 0;
@@ -296,7 +296,7 @@ IntrinsicSignature::IntrinsicSignature(IntrinsicReturnType returnType, int numAr
 {
 }
 
-TypeDenoterPtr IntrinsicSignature::GetTypeDenoterWithArgs(const std::vector<ExprPtr>& args) const
+TypeDenoterPtr IntrinsicSignature::GetTypeDenoterWithArgs(const ExprList& args) const
 {
     /* Validate number of arguments */
     if (numArgsMin >= 0)
@@ -535,7 +535,7 @@ HLSLIntrinsicAdept::HLSLIntrinsicAdept()
     FillOverloadedIntrinsicIdents();
 }
 
-TypeDenoterPtr HLSLIntrinsicAdept::GetIntrinsicReturnType(const Intrinsic intrinsic, const std::vector<ExprPtr>& args) const
+TypeDenoterPtr HLSLIntrinsicAdept::GetIntrinsicReturnType(const Intrinsic intrinsic, const ExprList& args) const
 {
     switch (intrinsic)
     {
@@ -555,7 +555,7 @@ TypeDenoterPtr HLSLIntrinsicAdept::GetIntrinsicReturnType(const Intrinsic intrin
     }
 }
 
-std::vector<TypeDenoterPtr> HLSLIntrinsicAdept::GetIntrinsicParameterTypes(const Intrinsic intrinsic, const std::vector<ExprPtr>& args) const
+std::vector<TypeDenoterPtr> HLSLIntrinsicAdept::GetIntrinsicParameterTypes(const Intrinsic intrinsic, const ExprList& args) const
 {
     std::vector<TypeDenoterPtr> paramTypeDenoters;
 
@@ -614,7 +614,7 @@ const HLSLIntrinsicsMap& HLSLIntrinsicAdept::GetIntrinsicMap()
  * ======= Private: =======
  */
 
-TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnType(const Intrinsic intrinsic, const std::vector<ExprPtr>& args) const
+TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnType(const Intrinsic intrinsic, const ExprList& args) const
 {
     /* Get type denoter from intrinsic signature map */
     auto it = g_intrinsicSignatureMap.find(intrinsic);
@@ -624,7 +624,7 @@ TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnType(const Intrinsic intrinsic, c
         RuntimeErr(R_FailedToDeriveIntrinsicType(GetIntrinsicIdent(intrinsic)));
 }
 
-TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeMul(const std::vector<ExprPtr>& args) const
+TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeMul(const ExprList& args) const
 {
     /* Validate number of arguments */
     if (args.size() != 2)
@@ -683,7 +683,7 @@ TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeMul(const std::vector<ExprPtr
     RuntimeErr(R_InvalidIntrinsicArgs("mul"));
 }
 
-TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeTranspose(const std::vector<ExprPtr>& args) const
+TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeTranspose(const ExprList& args) const
 {
     /* Validate number of arguments */
     if (args.size() != 1)
@@ -703,7 +703,7 @@ TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeTranspose(const std::vector<E
     RuntimeErr(R_InvalidIntrinsicArgs("transpose"));
 }
 
-TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeVectorCompare(const std::vector<ExprPtr>& args) const
+TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeVectorCompare(const ExprList& args) const
 {
     /* Validate number of arguments */
     if (args.size() != 2)
@@ -725,7 +725,7 @@ TODO:
 This is a temporary solution to derive parameter types of intrinsic.
 Currently all global intrinsics use a common type denoter for all parameters.
 */
-void HLSLIntrinsicAdept::DeriveParameterTypes(std::vector<TypeDenoterPtr>& paramTypeDenoters, const Intrinsic intrinsic, const std::vector<ExprPtr>& args) const
+void HLSLIntrinsicAdept::DeriveParameterTypes(std::vector<TypeDenoterPtr>& paramTypeDenoters, const Intrinsic intrinsic, const ExprList& args) const
 {
     /* Get type denoter from intrinsic signature map */
     auto it = g_intrinsicSignatureMap.find(intrinsic);
@@ -746,12 +746,12 @@ void HLSLIntrinsicAdept::DeriveParameterTypes(std::vector<TypeDenoterPtr>& param
         RuntimeErr(R_FailedToDeriveIntrinsicParamType(GetIntrinsicIdent(intrinsic)));
 }
 
-void HLSLIntrinsicAdept::DeriveParameterTypesMul(std::vector<TypeDenoterPtr>& paramTypeDenoters, const std::vector<ExprPtr>& args) const
+void HLSLIntrinsicAdept::DeriveParameterTypesMul(std::vector<TypeDenoterPtr>& paramTypeDenoters, const ExprList& args) const
 {
     //TODO...
 }
 
-void HLSLIntrinsicAdept::DeriveParameterTypesTranspose(std::vector<TypeDenoterPtr>& paramTypeDenoters, const std::vector<ExprPtr>& args) const
+void HLSLIntrinsicAdept::DeriveParameterTypesTranspose(std::vector<TypeDenoterPtr>& paramTypeDenoters, const ExprList& args) const
 {
     //TODO...
 }
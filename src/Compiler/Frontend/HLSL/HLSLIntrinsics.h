@@ -43,9 +43,9 @@ class HLSLIntrinsicAdept : public IntrinsicAdept
 
         HLSLIntrinsicAdept();
 
-        TypeDenoterPtr GetIntrinsicReturnType(const Intrinsic intrinsic, const std::vector<ExprPtr>& args) const override;
+        TypeDenoterPtr GetIntrinsicReturnType(const Intrinsic intrinsic, const ExprList& args) const override;
 
-        std::vector<TypeDenoterPtr> GetIntrinsicParameterTypes(const Intrinsic intrinsic, const std::vector<ExprPtr>& args) const override;
+        std::vector<TypeDenoterPtr> GetIntrinsicParameterTypes(const Intrinsic intrinsic, const ExprList& args) const override;
 
         std::vector<std::size_t> GetIntrinsicOutputParameterIndices(const Intrinsic intrinsic) const override;
 
@@ -54,14 +54,14 @@ class HLSLIntrinsicAdept : public IntrinsicAdept
 
     private:
 
-        TypeDenoterPtr DeriveReturnType(const Intrinsic intrinsic, const std::vector<ExprPtr>& args) const;
-        TypeDenoterPtr DeriveReturnTypeMul(const std::vector<ExprPtr>& args) const;
-        TypeDenoterPtr DeriveReturnTypeTranspose(const std::vector<ExprPtr>& args) const;
-        TypeDenoterPtr DeriveReturnTypeVectorCompare(const std::vector<ExprPtr>& args) const;
+        TypeDenoterPtr DeriveReturnType(const Intrinsic intrinsic, const ExprList& args) const;
+        TypeDenoterPtr DeriveReturnTypeMul(const ExprList& args) const;
+        TypeDenoterPtr DeriveReturnTypeTranspose(const ExprList& args) const;
+        TypeDenoterPtr DeriveReturnTypeVectorCompare(const ExprList& args) const;
 
-        void DeriveParameterTypes(std::vector<TypeDenoterPtr>& paramTypeDenoters, const Intrinsic intrinsic, const std::vector<ExprPtr>& args) const;
-        void DeriveParameterTypesMul(std::vector<TypeDenoterPtr>& paramTypeDenoters, const std::vector<ExprPtr>& args) const;
-        void DeriveParameterTypesTranspose(std::vector<TypeDenoterPtr>& paramTypeDenoters, const std::vector<ExprPtr>& args) const;
+        void DeriveParameterTypes(std::vector<TypeDenoterPtr>& paramTypeDenoters, const Intrinsic intrinsic, const ExprList& args) const;
+        void DeriveParameterTypesMul(std::vector<TypeDenoterPtr>& paramTypeDenoters, const ExprList& args) const;
+        void DeriveParameterTypesTranspose(std::vector<TypeDenoterPtr>& paramTypeDenoters, const ExprList& args) const;
 
 };
 
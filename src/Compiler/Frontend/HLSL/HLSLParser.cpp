@@ -12,6 +12,8 @@
 #include "AST.h"
 #include "ASTFactory.h"
 #include "ReportIdents.h"
+#include "BatchScheduler.h"
+#include <algorithm>
 
 
 namespace Xsc
@@ -35,25 +37,53 @@ Here "-(1)" is an unary expression. Thus, cast expression can only be parsed, if
 types, which are valid in the respective scope.
 */
 
+// Minimal number of tokens per chunk for parallel parsing.
+static const std::size_t g_minTokensPerChunk = 2048;
+
 HLSLParser::HLSLParser(Log* log) :
     Parser{ log }
 {
 }
 
 ProgramPtr HLSLParser::ParseSource(
-    const SourceCodePtr& source, const NameMangling& nameMangling, bool useD3D10Semantics, bool rowMajorAlignment)
+    const SourceCodePtr& source, const NameMangling& nameMangling, bool useD3D10Semantics, bool rowMajorAlignment,
+    bool preserveComments, bool errorRecovery, bool parallelParsing, TaskScheduler* taskScheduler)
 {
     useD3D10Semantics_  = useD3D10Semantics;
     rowMajorAlignment_  = rowMajorAlignment;
+    preserveComments_   = preserveComments;
 
     GetNameMangling() = nameMangling;
 
-    PushScannerSource(source);
+    EnableErrorRecovery(errorRecovery);
+
+    #ifdef XSC_ENABLE_MEMORY_POOL
+    /* AST nodes must not outlive the thread local memory pool of the worker threads, so parsing is always serial with the memory pool */
+    parallelParsing = false;
+    #endif
+
+    /*
+    Scan all tokens in advance for parallel parsing, which only pays off with concurrent tasks
+    (error recovery depends on the previous statements, so it's only supported serially)
+    */
+    auto& scheduler = (taskScheduler != nullptr ? *taskScheduler : StdTaskScheduler::Default());
+
+    ScannedTokenList tokens;
+    std::vector<TokenChunk> chunks;
+
+    if (parallelParsing && !errorRecovery && scheduler.Concurrency() > 1)
+    {
+        ScanTokenChunks(source, tokens, chunks);
+        PushReplayingScannerSource(source, tokens.data(), tokens.data() + tokens.size());
+    }
+    else
+        PushScannerSource(source);
 
     try
     {
-        auto ast = ParseProgram(source);
-        return (GetReportHandler().HasErros() ? nullptr : ast);
+        /* Keep erroneous program in error recovery mode, to continue with the context analysis */
+        auto ast = (chunks.size() > 1 ? ParseProgramParallel(source, tokens, chunks, scheduler) : ParseProgram(source));
+        return (GetReportHandler().HasErros() && !errorRecovery ? nullptr : ast);
     }
     catch (const Report& err)
     {
@@ -108,6 +138,11 @@ bool HLSLParser::IsModifier() const
     return (Is(Tokens::InputModifier) || Is(Tokens::InterpModifier) || Is(Tokens::TypeModifier) || Is(Tokens::StorageClass));
 }
 
+bool HLSLParser::IsRecoveryEndOfStream() const
+{
+    return (IsErrorRecovery() && Is(Tokens::EndOfStream));
+}
+
 TypeSpecifierPtr HLSLParser::MakeTypeSpecifierIfLhsOfCastExpr(const ExprPtr& expr)
 {
     /* Type specifier expression (float, int3 etc.) is always allowed for a cast expression */
@@ -173,9 +208,12 @@ void HLSLParser::ProcessDirectiveLine()
     else
         ErrorUnexpected(Tokens::StringLiteral);
 
-    /* Set new line number and filename */
-    auto currentLine = static_cast<int>(GetScanner().PreviousToken()->Pos().Row());
-    GetScanner().Source()->NextSourceOrigin(filename, (lineNo - currentLine - 1));
+    /* Set new line number and filename (recorded tokens already have their source origin) */
+    if (!GetScanner().IsReplaying())
+    {
+        auto currentLine = static_cast<int>(GetScanner().PreviousToken()->Pos().Row());
+        GetScanner().Source()->NextSourceOrigin(filename, (lineNo - currentLine - 1));
+    }
 }
 
 void HLSLParser::ProcessDirectivePragma()
@@ -224,6 +262,9 @@ void HLSLParser::CloseScope()
 void HLSLParser::RegisterTypeName(const std::string& ident)
 {
     typeNameSymbolTable_.Register(ident, true, nullptr, false);
+
+    if (globalTypeNames_ && typeNameSymbolTable_.ScopeLevel() == globalScopeLevel_)
+        globalTypeNames_->push_back(ident);
 }
 
 bool HLSLParser::IsRegisteredTypeName(const std::string& ident) const
@@ -388,7 +429,7 @@ SwitchCasePtr HLSLParser::ParseSwitchCase()
     Accept(Tokens::Colon);
 
     /* Parse switch case statement list */
-    while (!Is(Tokens::Case) && !Is(Tokens::Default) && !Is(Tokens::RCurly))
+    while (!Is(Tokens::Case) && !Is(Tokens::Default) && !Is(Tokens::RCurly) && !IsRecoveryEndOfStream())
         ParseStmntWithOptionalComment(ast->stmnts, std::bind(&HLSLParser::ParseStmnt, this, true));
 
     return ast;
@@ -1794,15 +1835,15 @@ std::vector<StmntPtr> HLSLParser::ParseStmntList()
 {
     std::vector<StmntPtr> stmnts;
 
-    while (!Is(Tokens::RCurly))
+    while (!Is(Tokens::RCurly) && !IsRecoveryEndOfStream())
         ParseStmntWithOptionalComment(stmnts, std::bind(&HLSLParser::ParseStmnt, this, true));
 
     return stmnts;
 }
 
-std::vector<ExprPtr> HLSLParser::ParseExprList(const Tokens listTerminatorToken, bool allowLastComma)
+ExprList HLSLParser::ParseExprList(const Tokens listTerminatorToken, bool allowLastComma)
 {
-    std::vector<ExprPtr> exprs;
+    ExprList exprs;
 
     /* Parse all argument expressions */
     if (!Is(listTerminatorToken))
@@ -1834,9 +1875,9 @@ std::vector<ArrayDimensionPtr> HLSLParser::ParseArrayDimensionList(bool allowDyn
     return arrayDims;
 }
 
-std::vector<ExprPtr> HLSLParser::ParseArrayIndexList()
+ExprList HLSLParser::ParseArrayIndexList()
 {
-    std::vector<ExprPtr> exprs;
+    ExprList exprs;
 
     while (Is(Tokens::LParen))
         exprs.push_back(ParseArrayIndex());
@@ -1844,7 +1885,7 @@ std::vector<ExprPtr> HLSLParser::ParseArrayIndexList()
     return exprs;
 }
 
-std::vector<ExprPtr> HLSLParser::ParseArgumentList()
+ExprList HLSLParser::ParseArgumentList()
 {
     Accept(Tokens::LBracket);
     auto exprs = ParseExprList(Tokens::RBracket);
@@ -1857,7 +1898,7 @@ std::vector<ExprPtr> HLSLParser::ParseInitializerList()
     Accept(Tokens::LCurly);
     auto exprs = ParseExprList(Tokens::RCurly, true);
     Accept(Tokens::RCurly);
-    return exprs;
+    return std::vector<ExprPtr>(std::make_move_iterator(exprs.begin()), std::make_move_iterator(exprs.end()));
 }
 
 std::vector<RegisterPtr> HLSLParser::ParseRegisterList(bool parseFirstColon)
@@ -2536,12 +2577,36 @@ std::string HLSLParser::ParseSamplerStateTextureIdent()
 void HLSLParser::ParseStmntWithOptionalComment(std::vector<StmntPtr>& stmnts, const std::function<StmntPtr()>& parseFunction)
 {
     /* Parse next statement with optional commentary */
-    auto comment = GetScanner().GetComment();
+    std::string comment;
+    if (preserveComments_)
+        comment = GetScanner().GetComment();
+
+    if (IsErrorRecovery())
+    {
+        /* Recover from syntax errors at this statement boundary */
+        const auto scopeLevel       = typeNameSymbolTable_.ScopeLevel();
+        const auto recoveryState    = SaveRecoveryState();
 
-    auto ast = parseFunction();
-    stmnts.push_back(ast);
+        try
+        {
+            auto ast = parseFunction();
+            stmnts.push_back(ast);
+            ast->comment = std::move(comment);
+        }
+        catch (const std::exception& e)
+        {
+            while (typeNameSymbolTable_.ScopeLevel() > scopeLevel)
+                CloseScope();
+            RecoverFromSyntaxError(e, recoveryState);
+        }
+    }
+    else
+    {
+        auto ast = parseFunction();
+        stmnts.push_back(ast);
 
-    ast->comment = std::move(comment);
+        ast->comment = std::move(comment);
+    }
 }
 
 bool HLSLParser::ParseModifiers(TypeSpecifier* typeSpecifier, bool allowPrimitiveType)
@@ -2599,6 +2664,232 @@ bool HLSLParser::ParseModifiers(TypeSpecifier* typeSpecifier, bool allowPrimitiv
     return true;
 }
 
+/* ----- Parallel parsing ----- */
+
+void HLSLParser::ScanTokenChunks(const SourceCodePtr& source, ScannedTokenList& tokens, std::vector<TokenChunk>& chunks)
+{
+    /* Scan all tokens with a separate parser, which processes the directives the same way as this parser */
+    HLSLParser scanParser;
+
+    scanParser.rowMajorAlignment_ = rowMajorAlignment_;
+    scanParser.PushRecordingScannerSource(source, tokens);
+
+    auto BeginChunk = [&](std::size_t begin)
+    {
+        TokenChunk chunk;
+        {
+            chunk.begin             = begin;
+            chunk.rowMajorAlignment = scanParser.rowMajorAlignment_;
+        }
+        chunks.push_back(chunk);
+    };
+
+    /* First chunk starts after the leading directives */
+    BeginChunk(tokens.size() - 1);
+
+    int         depth           = 0;
+    bool        insideTypedef   = false;
+    Tokens      prevType        = Tokens::Semicolon;
+    Tokens      prevPrevType    = Tokens::Semicolon;
+    TokenPtr    prevTkn;
+
+    auto IsChunkBoundary = [&](const Tokens type) -> bool
+    {
+        /* Split chunks only in front of a global declaration, i.e. after ';' or after '}' that does not continue the declaration */
+        if (depth != 0 || type == Tokens::Semicolon || type == Tokens::Technique)
+            return false;
+        if (prevType == Tokens::Semicolon)
+            return true;
+        if (prevType == Tokens::RCurly)
+            return (type != Tokens::Ident && type != Tokens::Colon && type != Tokens::Comma);
+        return false;
+    };
+
+    try
+    {
+        while (!scanParser.Is(Tokens::EndOfStream))
+        {
+            const auto type     = scanParser.TknType();
+            const auto index    = tokens.size() - 1;
+
+            if (index - chunks.back().begin >= g_minTokensPerChunk && IsChunkBoundary(type))
+            {
+                chunks.back().end = index;
+                BeginChunk(index);
+            }
+
+            if (depth == 0)
+            {
+                /* Predict global type names of structures (e.g. "struct S {") and aliases (e.g. "typedef float2 A, B[2];") */
+                if ((type == Tokens::LCurly || type == Tokens::Colon) && prevType == Tokens::Ident && prevPrevType == Tokens::Struct)
+                    chunks.back().typeNames.push_back(prevTkn->Spell());
+                else if (insideTypedef && prevType == Tokens::Ident && (type == Tokens::Comma || type == Tokens::Semicolon || type == Tokens::LParen))
+                    chunks.back().typeNames.push_back(prevTkn->Spell());
+
+                if (type == Tokens::Typedef)
+                    insideTypedef = true;
+                else if (type == Tokens::Semicolon)
+                    insideTypedef = false;
+            }
+
+            /* Track nesting depth of brackets, parentheses, and braces */
+            switch (type)
+            {
+                case Tokens::LBracket:
+                case Tokens::LParen:
+                case Tokens::LCurly:
+                    ++depth;
+                    break;
+                case Tokens::RBracket:
+                case Tokens::RParen:
+                case Tokens::RCurly:
+                    --depth;
+                    break;
+                default:
+                    break;
+            }
+
+            prevPrevType    = prevType;
+            prevType        = type;
+            prevTkn         = scanParser.Accept(type);
+        }
+    }
+    catch (const std::exception&)
+    {
+        /* Scan remaining tokens without directives (the serial parser stops at the same invalid directive) */
+        while (tokens.back().token->Type() != Tokens::EndOfStream)
+            scanParser.GetScanner().Next();
+        chunks.clear();
+        return;
+    }
+
+    chunks.back().end = tokens.size() - 1;
+
+    /* Reports of invalid directives and lexical errors must be submitted in the same order as the syntax errors */
+    if (scanParser.GetReportHandler().NumReports() > 0 || depth != 0)
+    {
+        chunks.clear();
+        return;
+    }
+
+    for (const auto& tkn : tokens)
+    {
+        if (!tkn.reports.empty())
+        {
+            chunks.clear();
+            return;
+        }
+    }
+}
+
+ProgramPtr HLSLParser::ParseProgramParallel(
+    const SourceCodePtr& source, const ScannedTokenList& tokens, const std::vector<TokenChunk>& chunks, TaskScheduler& taskScheduler)
+{
+    /* Accumulate predicted type names of all chunks, since each chunk requires all type names of its previous chunks */
+    std::vector<std::string> typeNames;
+    std::vector<std::size_t> typeNameOffsets;
+    std::vector<double> costs;
+
+    for (const auto& chunk : chunks)
+    {
+        typeNameOffsets.push_back(typeNames.size());
+        typeNames.insert(typeNames.end(), chunk.typeNames.begin(), chunk.typeNames.end());
+        costs.push_back(static_cast<double>(chunk.end - chunk.begin));
+    }
+
+    /* Parse all chunks in parallel */
+    std::vector<std::vector<StmntPtr>> chunkStmnts(chunks.size());
+    std::vector<char> chunkSucceeded(chunks.size(), 0);
+
+    const auto numWorkers = std::max(1u, std::min(taskScheduler.Concurrency(), static_cast<unsigned>(chunks.size())));
+
+    BatchScheduler scheduler(costs, numWorkers);
+
+    scheduler.Run(
+        [&](unsigned /*worker*/, std::size_t jobIndex)
+        {
+            std::vector<std::string> prevTypeNames(typeNames.begin(), typeNames.begin() + typeNameOffsets[jobIndex]);
+            chunkSucceeded[jobIndex] = ParseTokenChunk(tokens, chunks[jobIndex], prevTypeNames, chunkStmnts[jobIndex]);
+        },
+        taskScheduler
+    );
+
+    /* Parse all recorded tokens serially, if any chunk failed (this reproduces all reports of the serial parser) */
+    if (std::find(chunkSucceeded.begin(), chunkSucceeded.end(), 0) != chunkSucceeded.end())
+        return ParseProgram(source);
+
+    /* Stitch global statements of all chunks together */
+    auto ast = Make<Program>();
+
+    OpenScope();
+    {
+        GeneratePreDefinedTypeAliases(*ast);
+    }
+    CloseScope();
+
+    ast->sourceCode = source;
+
+    for (auto& stmnts : chunkStmnts)
+        ast->globalStmnts.insert(ast->globalStmnts.end(), stmnts.begin(), stmnts.end());
+
+    return ast;
+}
+
+bool HLSLParser::ParseTokenChunk(
+    const ScannedTokenList&         tokens,
+    const TokenChunk&               chunk,
+    const std::vector<std::string>& prevTypeNames,
+    std::vector<StmntPtr>&          stmnts)
+{
+    /* Parse chunk with a separate parser without log and without source (reports are only counted) */
+    HLSLParser parser;
+
+    parser.useD3D10Semantics_   = useD3D10Semantics_;
+    parser.rowMajorAlignment_   = chunk.rowMajorAlignment;
+    parser.preserveComments_    = preserveComments_;
+
+    parser.GetNameMangling() = GetNameMangling();
+
+    try
+    {
+        /* Replay tokens of this chunk, including the first token of the next chunk as look-ahead */
+        const auto& endTkn = tokens[chunk.end].token;
+
+        parser.PushReplayingScannerSource(nullptr, tokens.data() + chunk.begin, tokens.data() + chunk.end + 1);
+
+        /* Register pre-defined type aliases and all global type names of the previous chunks */
+        auto program = parser.Make<Program>();
+
+        parser.OpenScope();
+        parser.GeneratePreDefinedTypeAliases(*program);
+
+        for (const auto& ident : prevTypeNames)
+            parser.RegisterTypeName(ident);
+
+        /* Parse global statements until the next chunk begins (see "ParseProgram") */
+        std::vector<std::string> typeNames;
+        parser.globalTypeNames_     = (&typeNames);
+        parser.globalScopeLevel_    = parser.typeNameSymbolTable_.ScopeLevel();
+
+        while (true)
+        {
+            parser.ParseAndIgnoreTechniquesAndNullStmnts();
+
+            if (parser.Tkn() == endTkn || parser.Is(Tokens::EndOfStream))
+                break;
+
+            parser.ParseStmntWithOptionalComment(stmnts, std::bind(&HLSLParser::ParseGlobalStmnt, &parser));
+        }
+
+        /* Chunk is only valid if it ends with the next chunk, and all type names have been predicted correctly */
+        return (parser.Tkn() == endTkn && parser.GetReportHandler().NumReports() == 0 && typeNames == chunk.typeNames);
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
 
 } // /namespace Xsc
 
@@ -10,6 +10,7 @@
 
 
 #include <Xsc/Log.h>
+#include <Xsc/TaskScheduler.h>
 #include "HLSLScanner.h"
 #include "ReferenceAnalyzer.h"
 #include "Parser.h"
@@ -38,10 +39,25 @@ class HLSLParser : public Parser
             const SourceCodePtr& source,
             const NameMangling& nameMangling,
             bool useD3D10Semantics = true,
-            bool rowMajorAlignment = false
+            bool rowMajorAlignment = false,
+            bool preserveComments = true,
+            bool errorRecovery = false,
+            bool parallelParsing = false,
+            TaskScheduler* taskScheduler = nullptr
         );
 
     private:
+
+        /* === Structures === */
+
+        // Range of recorded tokens with global declarations, which is parsed independently of the other chunks.
+        struct TokenChunk
+        {
+            std::size_t                 begin               = 0;        // Index of the first token.
+            std::size_t                 end                 = 0;        // Index of the first token of the next chunk (or of the end-of-stream token).
+            bool                        rowMajorAlignment   = false;    // Matrix pack alignment in front of the first token.
+            std::vector<std::string>    typeNames;                      // Predicted type names, which are registered in the global scope of this chunk.
+        };
         
         /* === Functions === */
 
@@ -65,6 +81,9 @@ class HLSLParser : public Parser
         // Returns true if the current token is a modifier of a type specifier.
         bool IsModifier() const;
 
+        // Returns true if the end of stream has been reached in error recovery mode (to stop parsing a statement list).
+        bool IsRecoveryEndOfStream() const;
+
         // Converts the specified expression to a type name expression if it is a left-hand-side of a cast expression.
         TypeSpecifierPtr MakeTypeSpecifierIfLhsOfCastExpr(const ExprPtr& expr);
 
@@ -171,10 +190,10 @@ class HLSLParser : public Parser
         std::vector<VarDeclStmntPtr>    ParseParameterList();
         std::vector<VarDeclStmntPtr>    ParseAnnotationList();
         std::vector<StmntPtr>           ParseStmntList();
-        std::vector<ExprPtr>            ParseExprList(const Tokens listTerminatorToken, bool allowLastComma = false);
+        ExprList                        ParseExprList(const Tokens listTerminatorToken, bool allowLastComma = false);
         std::vector<ArrayDimensionPtr>  ParseArrayDimensionList(bool allowDynamicDimension = false);
-        std::vector<ExprPtr>            ParseArrayIndexList();
-        std::vector<ExprPtr>            ParseArgumentList();
+        ExprList                        ParseArrayIndexList();
+        ExprList                        ParseArgumentList();
         std::vector<ExprPtr>            ParseInitializerList();
         std::vector<RegisterPtr>        ParseRegisterList(bool parseFirstColon = true);
         std::vector<AttributePtr>       ParseAttributeList();
@@ -225,6 +244,33 @@ class HLSLParser : public Parser
 
         bool                            ParseModifiers(TypeSpecifier* typeSpecifier, bool allowPrimitiveType = false);
 
+        /* ----- Parallel parsing ----- */
+
+        /*
+        Scans all tokens of the specified source in advance, and splits them into chunks of global declarations.
+        The list of chunks is empty, if the tokens can not be parsed in parallel (e.g. due to lexical errors).
+        */
+        void ScanTokenChunks(const SourceCodePtr& source, ScannedTokenList& tokens, std::vector<TokenChunk>& chunks);
+
+        /*
+        Parses all chunks as tasks of the specified scheduler and stitches their global statements together.
+        Falls back to parsing all recorded tokens serially, if any chunk can not be parsed independently.
+        */
+        ProgramPtr ParseProgramParallel(
+            const SourceCodePtr&            source,
+            const ScannedTokenList&         tokens,
+            const std::vector<TokenChunk>&  chunks,
+            TaskScheduler&                  taskScheduler
+        );
+
+        // Parses the specified chunk with a separate parser, and returns true on success (i.e. without any reports).
+        bool ParseTokenChunk(
+            const ScannedTokenList&         tokens,
+            const TokenChunk&               chunk,
+            const std::vector<std::string>& prevTypeNames,
+            std::vector<StmntPtr>&          stmnts
+        );
+
         /* === Members === */
 
         using TypeNameSymbolTable = SymbolTable<bool>;
@@ -241,6 +287,13 @@ class HLSLParser : public Parser
         // True, if matrix packing is globally set to row major.
         bool                rowMajorAlignment_      = false;
 
+        // True, if commentaries are stored in the statements (otherwise they are discarded).
+        bool                preserveComments_       = true;
+
+        // Optional list of all type names, which are registered in the global scope of the program (only used for parallel parsing).
+        std::vector<std::string>*   globalTypeNames_    = nullptr;
+        std::size_t                 globalScopeLevel_   = 0;
+
 };
 
 
@@ -0,0 +1,843 @@
+/*
+ * HLSLProgramBuilder.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "HLSLProgramBuilder.h"
+#include "HLSLKeywords.h"
+#include "ASTFactory.h"
+#include "Exception.h"
+#include "Helper.h"
+#include "ReportIdents.h"
+#include <functional>
+#include <cctype>
+
+
+namespace Xsc
+{
+
+
+HLSLProgramBuilder::HLSLProgramBuilder()
+{
+    ResetProgram();
+}
+
+void HLSLProgramBuilder::SetSource(const std::string& sourceIdent, unsigned int row, unsigned int column)
+{
+    auto origin = std::make_shared<SourceOrigin>();
+    {
+        origin->filename    = sourceIdent;
+        origin->lineOffset  = 0;
+    }
+    pos_ = SourcePosition(row, column, origin);
+}
+
+/* --- Declarations --- */
+
+void HLSLProgramBuilder::BeginStruct(const std::string& ident)
+{
+    if (!scopes_.empty())
+        InvalidArg(R_BuilderDeclOnlyInGlobalScope("structures"));
+
+    auto ast = Make<StructDeclStmnt>();
+    {
+        ast->structDecl                 = Make<StructDecl>();
+        ast->structDecl->ident          = ident;
+        ast->structDecl->declStmntRef   = ast.get();
+    }
+    AppendStmnt(ast);
+
+    PushScope(ScopeTypes::Struct, ast->structDecl, ast->structDecl->localStmnts);
+}
+
+void HLSLProgramBuilder::EndStruct()
+{
+    PopScope(ScopeTypes::Struct);
+}
+
+void HLSLProgramBuilder::BeginConstantBuffer(const std::string& ident, int slot)
+{
+    if (!scopes_.empty())
+        InvalidArg(R_BuilderDeclOnlyInGlobalScope("constant buffers"));
+
+    auto ast = Make<UniformBufferDecl>();
+    {
+        ast->bufferType = UniformBufferType::ConstantBuffer;
+        ast->ident      = ident;
+
+        if (slot >= 0)
+            ast->slotRegisters.push_back(MakeRegister(CharToRegisterType('b'), slot));
+    }
+    AppendStmnt(ast);
+
+    PushScope(ScopeTypes::UniformBuffer, ast, ast->localStmnts);
+}
+
+void HLSLProgramBuilder::EndConstantBuffer()
+{
+    PopScope(ScopeTypes::UniformBuffer);
+}
+
+void HLSLProgramBuilder::DeclareVariable(
+    const std::string& type, const std::string& ident, const std::string& semantic, const ExprHandle& initializer)
+{
+    auto ast = MakeVarDeclStmnt(type, ident, semantic, TakeExpr(initializer, true));
+
+    if (scopes_.empty())
+        AppendStmnt(ast);
+    else
+    {
+        auto& scope = scopes_.back();
+        switch (scope.type)
+        {
+            case ScopeTypes::Struct:
+            {
+                /* Append structure member and decorate it with a reference to the structure declaration */
+                auto structDecl = std::static_pointer_cast<StructDecl>(scope.ast);
+                structDecl->varMembers.push_back(ast);
+                for (auto& varDecl : ast->varDecls)
+                    varDecl->structDeclRef = structDecl.get();
+            }
+            break;
+
+            case ScopeTypes::UniformBuffer:
+            {
+                /* Append buffer member and decorate it with a reference to the buffer declaration */
+                auto uniformBufferDecl = std::static_pointer_cast<UniformBufferDecl>(scope.ast);
+                uniformBufferDecl->varMembers.push_back(ast);
+                for (auto& varDecl : ast->varDecls)
+                    varDecl->bufferDeclRef = uniformBufferDecl.get();
+            }
+            break;
+
+            default:
+            break;
+        }
+
+        AppendStmnt(ast);
+    }
+}
+
+void HLSLProgramBuilder::DeclareResource(const std::string& type, const std::string& ident, int slot)
+{
+    if (!scopes_.empty())
+        InvalidArg(R_BuilderDeclOnlyInGlobalScope("resources"));
+
+    std::vector<ArrayDimensionPtr> arrayDims;
+    auto typeSpecifier = ParseTypeSpecifier(type, &arrayDims);
+
+    if (auto bufferTypeDen = std::dynamic_pointer_cast<BufferTypeDenoter>(typeSpecifier->typeDenoter))
+    {
+        /* Make buffer declaration statement (e.g. textures and storage buffers) */
+        auto ast = Make<BufferDeclStmnt>();
+        {
+            ast->typeDenoter = bufferTypeDen;
+
+            auto bufferDecl = Make<BufferDecl>();
+            {
+                bufferDecl->declStmntRef    = ast.get();
+                bufferDecl->ident           = ident;
+                bufferDecl->arrayDims       = arrayDims;
+
+                if (slot >= 0)
+                {
+                    const auto registerChar = (IsRWBufferType(bufferTypeDen->bufferType) ? 'u' : 't');
+                    bufferDecl->slotRegisters.push_back(MakeRegister(CharToRegisterType(registerChar), slot));
+                }
+            }
+            ast->bufferDecls.push_back(bufferDecl);
+        }
+        AppendStmnt(ast);
+    }
+    else if (auto samplerTypeDen = std::dynamic_pointer_cast<SamplerTypeDenoter>(typeSpecifier->typeDenoter))
+    {
+        /* Make sampler declaration statement */
+        auto ast = Make<SamplerDeclStmnt>();
+        {
+            ast->typeDenoter = samplerTypeDen;
+
+            auto samplerDecl = Make<SamplerDecl>();
+            {
+                samplerDecl->declStmntRef   = ast.get();
+                samplerDecl->ident          = ident;
+                samplerDecl->arrayDims      = arrayDims;
+
+                if (slot >= 0)
+                    samplerDecl->slotRegisters.push_back(MakeRegister(CharToRegisterType('s'), slot));
+            }
+            ast->samplerDecls.push_back(samplerDecl);
+        }
+        AppendStmnt(ast);
+    }
+    else
+        InvalidArg(R_InvalidBuilderTypeName(type));
+}
+
+void HLSLProgramBuilder::BeginFunction(const std::string& returnType, const std::string& ident, const std::string& semantic)
+{
+    if (!scopes_.empty() && scopes_.back().type != ScopeTypes::Struct)
+        InvalidArg(R_BuilderDeclOnlyInGlobalScope("functions"));
+
+    auto ast = Make<FunctionDecl>();
+    {
+        ast->returnType = ParseTypeSpecifier(returnType, nullptr, true);
+        ast->ident      = ident;
+        ast->codeBlock  = Make<CodeBlock>();
+
+        if (!semantic.empty())
+            ast->semantic = HLSLKeywordToSemantic(semantic);
+    }
+
+    /* Append member function and decorate it with a reference to the structure declaration */
+    if (!scopes_.empty())
+    {
+        auto structDecl = std::static_pointer_cast<StructDecl>(scopes_.back().ast);
+        structDecl->funcMembers.push_back(ast);
+        ast->structDeclRef = structDecl.get();
+    }
+
+    AppendStmnt(ast);
+
+    PushScope(ScopeTypes::Function, ast, ast->codeBlock->stmnts);
+}
+
+void HLSLProgramBuilder::DeclareParameter(const std::string& type, const std::string& ident, const std::string& semantic)
+{
+    if (scopes_.empty() || scopes_.back().type != ScopeTypes::Function)
+        InvalidArg(R_BuilderParamOutsideOfFunction);
+
+    auto funcDecl = std::static_pointer_cast<FunctionDecl>(scopes_.back().ast);
+
+    /* Make parameter as single variable declaration with 'parameter' flag */
+    auto ast = MakeVarDeclStmnt(type, ident, semantic, nullptr);
+    ast->flags << VarDeclStmnt::isParameter;
+
+    funcDecl->parameters.push_back(ast);
+}
+
+void HLSLProgramBuilder::EndFunction()
+{
+    PopScope(ScopeTypes::Function);
+}
+
+/* --- Statements --- */
+
+void HLSLProgramBuilder::Assign(const ExprHandle& lhs, const ExprHandle& rhs, const std::string& op)
+{
+    auto varAccessExpr = TakeVarAccessExpr(lhs);
+    {
+        varAccessExpr->assignOp     = StringToAssignOp(op);
+        varAccessExpr->assignExpr   = TakeExpr(rhs);
+    }
+
+    auto ast = Make<ExprStmnt>();
+    ast->expr = varAccessExpr;
+    AppendLocalStmnt(ast);
+}
+
+void HLSLProgramBuilder::Evaluate(const ExprHandle& expr)
+{
+    auto ast = Make<ExprStmnt>();
+    ast->expr = TakeExpr(expr);
+    AppendLocalStmnt(ast);
+}
+
+void HLSLProgramBuilder::Return(const ExprHandle& expr)
+{
+    auto ast = Make<ReturnStmnt>();
+    ast->expr = TakeExpr(expr, true);
+    AppendLocalStmnt(ast);
+}
+
+void HLSLProgramBuilder::CtrlTransfer(const std::string& transfer)
+{
+    auto ast = Make<CtrlTransferStmnt>();
+    ast->transfer = StringToCtrlTransfer(transfer);
+    AppendLocalStmnt(ast);
+}
+
+void HLSLProgramBuilder::BeginIf(const ExprHandle& condition)
+{
+    auto bodyStmnt = MakeCodeBlockStmnt();
+
+    auto ast = Make<IfStmnt>();
+    {
+        ast->condition  = TakeExpr(condition);
+        ast->bodyStmnt  = bodyStmnt;
+    }
+    AppendLocalStmnt(ast);
+
+    PushScope(ScopeTypes::If, ast, bodyStmnt->codeBlock->stmnts);
+}
+
+void HLSLProgramBuilder::BeginElse()
+{
+    auto scope = PopScope(ScopeTypes::If);
+
+    auto bodyStmnt = MakeCodeBlockStmnt();
+
+    auto ast = Make<ElseStmnt>();
+    ast->bodyStmnt = bodyStmnt;
+
+    std::static_pointer_cast<IfStmnt>(scope.ast)->elseStmnt = ast;
+
+    PushScope(ScopeTypes::Else, scope.ast, bodyStmnt->codeBlock->stmnts);
+}
+
+void HLSLProgramBuilder::EndIf()
+{
+    if (!scopes_.empty() && scopes_.back().type == ScopeTypes::Else)
+        PopScope(ScopeTypes::Else);
+    else
+        PopScope(ScopeTypes::If);
+}
+
+void HLSLProgramBuilder::BeginFor(
+    const std::string& type, const std::string& ident, const ExprHandle& initializer, const ExprHandle& condition, const ExprHandle& iteration)
+{
+    if (!InLocalScope())
+        InvalidArg(R_BuilderStmntOutsideOfFunction);
+
+    auto bodyStmnt = MakeCodeBlockStmnt();
+
+    auto ast = Make<ForLoopStmnt>();
+    {
+        ast->initStmnt  = MakeVarDeclStmnt(type, ident, "", TakeExpr(initializer));
+        ast->condition  = TakeExpr(condition);
+        ast->iteration  = TakeExpr(iteration, true);
+        ast->bodyStmnt  = bodyStmnt;
+    }
+    AppendLocalStmnt(ast);
+
+    PushScope(ScopeTypes::ForLoop, ast, bodyStmnt->codeBlock->stmnts);
+}
+
+void HLSLProgramBuilder::EndFor()
+{
+    PopScope(ScopeTypes::ForLoop);
+}
+
+/* --- Expressions --- */
+
+HLSLProgramBuilder::ExprHandle HLSLProgramBuilder::Literal(const DataType dataType, const std::string& value)
+{
+    auto ast = Make<LiteralExpr>();
+    {
+        ast->dataType   = dataType;
+        ast->value      = value;
+    }
+    return MakeHandle(ast);
+}
+
+HLSLProgramBuilder::ExprHandle HLSLProgramBuilder::Var(const std::string& ident)
+{
+    auto ast = Make<VarAccessExpr>();
+    {
+        ast->varIdent           = Make<VarIdent>();
+        ast->varIdent->ident    = ident;
+    }
+    return MakeHandle(ast);
+}
+
+HLSLProgramBuilder::ExprHandle HLSLProgramBuilder::Member(const ExprHandle& object, const std::string& ident)
+{
+    auto expr = TakeExpr(object);
+
+    auto varIdent = Make<VarIdent>();
+    varIdent->ident = ident;
+
+    if (auto varAccessExpr = expr->As<VarAccessExpr>())
+    {
+        if (!varAccessExpr->assignExpr)
+        {
+            /* Append identifier to the variable identifier chain (e.g. "a.b" -> "a.b.c") */
+            varAccessExpr->varIdent->Last()->next = varIdent;
+            return MakeHandle(expr);
+        }
+    }
+
+    /* Make suffix expression for all other objects (e.g. "(a + b).x" or "f().x") */
+    auto ast = Make<SuffixExpr>();
+    {
+        ast->expr       = (expr->Type() == AST::Types::FunctionCallExpr ? expr : ASTFactory::MakeBracketExpr(expr));
+        ast->varIdent   = varIdent;
+    }
+    return MakeHandle(ast);
+}
+
+HLSLProgramBuilder::ExprHandle HLSLProgramBuilder::Index(const ExprHandle& object, const ExprHandle& index)
+{
+    auto expr = TakeExpr(object);
+    auto indexExpr = TakeExpr(index);
+
+    if (auto varAccessExpr = expr->As<VarAccessExpr>())
+    {
+        if (!varAccessExpr->assignExpr)
+        {
+            /* Append array index to the last variable identifier (e.g. "a.b" -> "a.b[i]") */
+            varAccessExpr->varIdent->Last()->arrayIndices.push_back(indexExpr);
+            return MakeHandle(expr);
+        }
+    }
+
+    /* Make array access expression for all other objects */
+    auto ast = Make<ArrayAccessExpr>();
+    {
+        ast->expr = (expr->Type() == AST::Types::FunctionCallExpr ? expr : ASTFactory::MakeBracketExpr(expr));
+        ast->arrayIndices.push_back(indexExpr);
+    }
+    return MakeHandle(ast);
+}
+
+HLSLProgramBuilder::ExprHandle HLSLProgramBuilder::Unary(const std::string& op, const ExprHandle& expr)
+{
+    auto ast = Make<UnaryExpr>();
+    {
+        ast->op     = StringToUnaryOp(op);
+        ast->expr   = TakeOperand(expr);
+    }
+    return MakeHandle(ast);
+}
+
+HLSLProgramBuilder::ExprHandle HLSLProgramBuilder::Binary(const ExprHandle& lhs, const std::string& op, const ExprHandle& rhs)
+{
+    auto ast = Make<BinaryExpr>();
+    {
+        ast->lhsExpr    = TakeOperand(lhs);
+        ast->op         = StringToBinaryOp(op);
+        ast->rhsExpr    = TakeOperand(rhs);
+    }
+    return MakeHandle(ast);
+}
+
+HLSLProgramBuilder::ExprHandle HLSLProgramBuilder::Ternary(const ExprHandle& condition, const ExprHandle& thenExpr, const ExprHandle& elseExpr)
+{
+    auto ast = Make<TernaryExpr>();
+    {
+        ast->condExpr   = TakeOperand(condition);
+        ast->thenExpr   = TakeOperand(thenExpr);
+        ast->elseExpr   = TakeOperand(elseExpr);
+    }
+    return MakeHandle(ast);
+}
+
+HLSLProgramBuilder::ExprHandle HLSLProgramBuilder::Call(const std::string& ident, const std::vector<ExprHandle>& args)
+{
+    auto ast = Make<FunctionCallExpr>();
+    {
+        ast->call                   = Make<FunctionCall>();
+        ast->call->varIdent         = Make<VarIdent>();
+        ast->call->varIdent->ident  = ident;
+        ast->call->arguments        = TakeExprList(args);
+    }
+    return MakeHandle(ast);
+}
+
+HLSLProgramBuilder::ExprHandle HLSLProgramBuilder::MethodCall(const ExprHandle& object, const std::string& ident, const std::vector<ExprHandle>& args)
+{
+    /* Append method name to the variable identifier chain of the object (e.g. "tex.Sample") */
+    auto varAccessExpr = TakeVarAccessExpr(object);
+
+    auto varIdent = Make<VarIdent>();
+    varIdent->ident = ident;
+    varAccessExpr->varIdent->Last()->next = varIdent;
+
+    auto ast = Make<FunctionCallExpr>();
+    {
+        ast->call               = Make<FunctionCall>();
+        ast->call->varIdent     = varAccessExpr->varIdent;
+        ast->call->arguments    = TakeExprList(args);
+    }
+    return MakeHandle(ast);
+}
+
+HLSLProgramBuilder::ExprHandle HLSLProgramBuilder::Construct(const std::string& type, const std::vector<ExprHandle>& args)
+{
+    auto ast = Make<FunctionCallExpr>();
+    {
+        ast->call               = Make<FunctionCall>();
+        ast->call->typeDenoter  = ParseTypeSpecifier(type)->typeDenoter;
+        ast->call->arguments    = TakeExprList(args);
+    }
+    return MakeHandle(ast);
+}
+
+HLSLProgramBuilder::ExprHandle HLSLProgramBuilder::Cast(const std::string& type, const ExprHandle& expr)
+{
+    auto ast = Make<CastExpr>();
+    {
+        ast->typeSpecifier  = ParseTypeSpecifier(type);
+        ast->expr           = TakeOperand(expr);
+    }
+    return MakeHandle(ast);
+}
+
+ProgramPtr HLSLProgramBuilder::TakeProgram()
+{
+    if (!scopes_.empty())
+        InvalidArg(R_UnfinishedBuilderScope(ScopeTypeToString(scopes_.back().type)));
+
+    auto program = program_;
+    ResetProgram();
+    return program;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+const char* HLSLProgramBuilder::ScopeTypeToString(const ScopeTypes t)
+{
+    using T = ScopeTypes;
+    switch (t)
+    {
+        case T::Struct:         return "structure";
+        case T::UniformBuffer:  return "constant buffer";
+        case T::Function:       return "function";
+        case T::If:             return "if-statement";
+        case T::Else:           return "else-statement";
+        case T::ForLoop:        return "for-loop";
+    }
+    return "";
+}
+
+template <typename T, typename... Args>
+std::shared_ptr<T> HLSLProgramBuilder::Make(Args&&... args)
+{
+    return MakeShared<T>(pos_, std::forward<Args>(args)...);
+}
+
+void HLSLProgramBuilder::ResetProgram()
+{
+    program_ = Make<Program>();
+    scopes_.clear();
+    exprs_.clear();
+}
+
+void HLSLProgramBuilder::PushScope(const ScopeTypes type, const ASTPtr& ast, std::vector<StmntPtr>& stmnts)
+{
+    scopes_.push_back({ type, ast, &stmnts });
+}
+
+HLSLProgramBuilder::Scope HLSLProgramBuilder::PopScope(const ScopeTypes type)
+{
+    if (scopes_.empty() || scopes_.back().type != type)
+        InvalidArg(R_MismatchedBuilderScopeEnd(ScopeTypeToString(type)));
+
+    auto scope = scopes_.back();
+    scopes_.pop_back();
+    return scope;
+}
+
+void HLSLProgramBuilder::AppendStmnt(const StmntPtr& stmnt)
+{
+    if (scopes_.empty())
+        program_->globalStmnts.push_back(stmnt);
+    else
+        scopes_.back().stmnts->push_back(stmnt);
+}
+
+void HLSLProgramBuilder::AppendLocalStmnt(const StmntPtr& stmnt)
+{
+    if (!InLocalScope())
+        InvalidArg(R_BuilderStmntOutsideOfFunction);
+    AppendStmnt(stmnt);
+}
+
+bool HLSLProgramBuilder::InLocalScope() const
+{
+    if (!scopes_.empty())
+    {
+        switch (scopes_.back().type)
+        {
+            case ScopeTypes::Function:
+            case ScopeTypes::If:
+            case ScopeTypes::Else:
+            case ScopeTypes::ForLoop:
+                return true;
+            default:
+                break;
+        }
+    }
+    return false;
+}
+
+HLSLProgramBuilder::ExprHandle HLSLProgramBuilder::MakeHandle(const ExprPtr& expr)
+{
+    exprs_.push_back(expr);
+
+    ExprHandle handle;
+    handle.id = exprs_.size();
+    return handle;
+}
+
+ExprPtr HLSLProgramBuilder::TakeExpr(const ExprHandle& handle, bool optional)
+{
+    if (handle.id == 0 && optional)
+        return nullptr;
+
+    if (handle.id == 0 || handle.id > exprs_.size() || !exprs_[handle.id - 1])
+        InvalidArg(R_InvalidBuilderExprHandle);
+
+    /* Invalidate handle, so that no node is shared between several parents in the AST */
+    auto expr = exprs_[handle.id - 1];
+    exprs_[handle.id - 1].reset();
+    return expr;
+}
+
+ExprList HLSLProgramBuilder::TakeExprList(const std::vector<ExprHandle>& handles)
+{
+    ExprList exprs;
+    exprs.reserve(handles.size());
+
+    for (const auto& handle : handles)
+        exprs.push_back(TakeExpr(handle));
+
+    return exprs;
+}
+
+ExprPtr HLSLProgramBuilder::TakeOperand(const ExprHandle& handle)
+{
+    auto expr = TakeExpr(handle);
+
+    /* Enclose compound expressions in brackets, since the operator precedence is already determined by the AST structure */
+    switch (expr->Type())
+    {
+        case AST::Types::TernaryExpr:
+        case AST::Types::BinaryExpr:
+        case AST::Types::UnaryExpr:
+        case AST::Types::CastExpr:
+            return ASTFactory::MakeBracketExpr(expr);
+        default:
+            return expr;
+    }
+}
+
+VarAccessExprPtr HLSLProgramBuilder::TakeVarAccessExpr(const ExprHandle& handle)
+{
+    auto expr = TakeExpr(handle);
+
+    if (expr->Type() != AST::Types::VarAccessExpr)
+        InvalidArg(R_ExpectedBuilderVarAccessExpr);
+
+    auto varAccessExpr = std::static_pointer_cast<VarAccessExpr>(expr);
+    if (varAccessExpr->assignExpr)
+        InvalidArg(R_ExpectedBuilderVarAccessExpr);
+
+    return varAccessExpr;
+}
+
+VarDeclStmntPtr HLSLProgramBuilder::MakeVarDeclStmnt(
+    const std::string& type, const std::string& ident, const std::string& semantic, const ExprPtr& initializer)
+{
+    auto ast = Make<VarDeclStmnt>();
+    {
+        auto varDecl = Make<VarDecl>();
+        {
+            varDecl->declStmntRef   = ast.get();
+            varDecl->ident          = ident;
+            varDecl->initializer    = initializer;
+
+            if (!semantic.empty())
+                varDecl->semantic = HLSLKeywordToSemantic(semantic);
+        }
+        ast->typeSpecifier = ParseTypeSpecifier(type, &(varDecl->arrayDims));
+        ast->varDecls.push_back(varDecl);
+    }
+    return ast;
+}
+
+RegisterPtr HLSLProgramBuilder::MakeRegister(const RegisterType registerType, int slot)
+{
+    auto ast = Make<Register>();
+    {
+        ast->registerType   = registerType;
+        ast->slot           = slot;
+    }
+    return ast;
+}
+
+CodeBlockStmntPtr HLSLProgramBuilder::MakeCodeBlockStmnt()
+{
+    auto ast = Make<CodeBlockStmnt>();
+    ast->codeBlock = Make<CodeBlock>();
+    return ast;
+}
+
+// Splits the specified type name into identifiers, numbers, and the punctuation characters '<', '>', ',', '[', and ']'.
+static std::vector<std::string> SplitTypeName(const std::string& type)
+{
+    std::vector<std::string> tokens;
+
+    for (std::size_t i = 0; i < type.size();)
+    {
+        const auto c = type[i];
+        if (std::isalnum(static_cast<unsigned char>(c)) || c == '_')
+        {
+            auto start = i;
+            while (i < type.size() && (std::isalnum(static_cast<unsigned char>(type[i])) || type[i] == '_'))
+                ++i;
+            tokens.push_back(type.substr(start, i - start));
+        }
+        else
+        {
+            if (!std::isspace(static_cast<unsigned char>(c)))
+                tokens.push_back(std::string(1, c));
+            ++i;
+        }
+    }
+
+    return tokens;
+}
+
+// Returns the keyword token type of the specified identifier, or Token::Types::Ident if it is not a keyword.
+static Token::Types KeywordTokenType(const std::string& s)
+{
+    const auto& keywords = HLSLKeywords();
+    auto it = keywords.find(s);
+    return (it != keywords.end() ? it->second : Token::Types::Ident);
+}
+
+TypeSpecifierPtr HLSLProgramBuilder::ParseTypeSpecifier(const std::string& type, std::vector<ArrayDimensionPtr>* arrayDims, bool allowVoidType)
+{
+    const auto tokens = SplitTypeName(type);
+    std::size_t tokenIndex = 0;
+
+    auto Tkn = [&]() -> std::string
+    {
+        return (tokenIndex < tokens.size() ? tokens[tokenIndex] : "");
+    };
+
+    auto Accept = [&](const std::string& spell) -> std::string
+    {
+        if (tokenIndex >= tokens.size() || (!spell.empty() && tokens[tokenIndex] != spell))
+            InvalidArg(R_InvalidBuilderTypeName(type));
+        return tokens[tokenIndex++];
+    };
+
+    auto AcceptInt = [&]() -> int
+    {
+        auto spell = Accept("");
+        if (!std::isdigit(static_cast<unsigned char>(spell.front())))
+            InvalidArg(R_InvalidBuilderTypeName(type));
+        return std::stoi(spell);
+    };
+
+    std::function<TypeDenoterPtr(bool)> ParseTypeDenoter;
+
+    ParseTypeDenoter = [&](bool allowVoid) -> TypeDenoterPtr
+    {
+        auto keyword = Accept("");
+
+        switch (KeywordTokenType(keyword))
+        {
+            case Token::Types::Void:
+                if (allowVoid)
+                    return std::make_shared<VoidTypeDenoter>();
+                break;
+
+            case Token::Types::ScalarType:
+            case Token::Types::VectorType:
+            case Token::Types::MatrixType:
+            case Token::Types::StringType:
+                return std::make_shared<BaseTypeDenoter>(HLSLKeywordToDataType(keyword));
+
+            case Token::Types::Buffer:
+            {
+                /* Make buffer type denoter with optional generic type and size (e.g. "Texture2DMS<float4, 4>") */
+                auto typeDenoter = std::make_shared<BufferTypeDenoter>(HLSLKeywordToBufferType(keyword));
+
+                if (Tkn() == "<")
+                {
+                    Accept("<");
+                    typeDenoter->genericTypeDenoter = ParseTypeDenoter(false);
+                    if (Tkn() == ",")
+                    {
+                        Accept(",");
+                        typeDenoter->genericSize = AcceptInt();
+                    }
+                    Accept(">");
+                }
+
+                return typeDenoter;
+            }
+
+            case Token::Types::Sampler:
+            case Token::Types::SamplerState:
+                return std::make_shared<SamplerTypeDenoter>(HLSLKeywordToSamplerType(keyword));
+
+            case Token::Types::Ident:
+                /* Make alias type denoter per default (the analyzer resolves it to a structure or type alias) */
+                if (!std::isdigit(static_cast<unsigned char>(keyword.front())))
+                    return std::make_shared<AliasTypeDenoter>(keyword);
+                break;
+
+            default:
+                break;
+        }
+
+        InvalidArg(R_InvalidBuilderTypeName(type));
+        return nullptr;
+    };
+
+    auto ast = Make<TypeSpecifier>();
+
+    /* Parse type modifiers */
+    for (auto modifier = Tkn(); !modifier.empty(); modifier = Tkn())
+    {
+        const auto tokenType = KeywordTokenType(modifier);
+
+        if (tokenType == Token::Types::InputModifier)
+        {
+            if (modifier == "in")
+                ast->isInput = true;
+            else if (modifier == "out")
+                ast->isOutput = true;
+            else if (modifier == "inout")
+            {
+                ast->isInput = true;
+                ast->isOutput = true;
+            }
+            else if (modifier == "uniform")
+                ast->isUniform = true;
+        }
+        else if (tokenType == Token::Types::InterpModifier)
+            ast->interpModifiers.insert(HLSLKeywordToInterpModifier(modifier));
+        else if (tokenType == Token::Types::TypeModifier)
+            ast->SetTypeModifier(HLSLKeywordToTypeModifier(modifier));
+        else if (tokenType == Token::Types::StorageClass)
+            ast->storageClasses.insert(HLSLKeywordToStorageClass(modifier));
+        else if (tokenType == Token::Types::PrimitiveType)
+            ast->primitiveType = HLSLKeywordToPrimitiveType(modifier);
+        else
+            break;
+
+        ++tokenIndex;
+    }
+
+    /* Parse type denoter */
+    ast->typeDenoter = ParseTypeDenoter(allowVoidType);
+
+    /* Parse optional array dimensions (e.g. "float4[2][3]"), which are moved to the variable declaration */
+    while (arrayDims != nullptr && Tkn() == "[")
+    {
+        Accept("[");
+        arrayDims->push_back(ASTFactory::MakeArrayDimension(AcceptInt()));
+        Accept("]");
+    }
+
+    if (tokenIndex < tokens.size())
+        InvalidArg(R_InvalidBuilderTypeName(type));
+
+    return ast;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
@@ -0,0 +1,156 @@
+/*
+ * HLSLProgramBuilder.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_HLSL_PROGRAM_BUILDER_H
+#define XSC_HLSL_PROGRAM_BUILDER_H
+
+
+#include <Xsc/ProgramBuilder.h>
+#include "AST.h"
+#include <vector>
+#include <string>
+
+
+namespace Xsc
+{
+
+
+/*
+Builder for an HLSL program AST (back-end of the public "ProgramBuilder" class).
+All nodes are made with the same structure as the HLSLParser would make them for the equivalent source code,
+so the program can be passed to the HLSLAnalyzer as if it was parsed.
+*/
+class HLSLProgramBuilder
+{
+
+    public:
+
+        using ExprHandle = ProgramBuilder::Expr;
+
+        HLSLProgramBuilder();
+
+        void SetSource(const std::string& sourceIdent, unsigned int row, unsigned int column);
+
+        /* --- Declarations --- */
+
+        void BeginStruct(const std::string& ident);
+        void EndStruct();
+
+        void BeginConstantBuffer(const std::string& ident, int slot);
+        void EndConstantBuffer();
+
+        void DeclareVariable(const std::string& type, const std::string& ident, const std::string& semantic, const ExprHandle& initializer);
+        void DeclareResource(const std::string& type, const std::string& ident, int slot);
+
+        void BeginFunction(const std::string& returnType, const std::string& ident, const std::string& semantic);
+        void DeclareParameter(const std::string& type, const std::string& ident, const std::string& semantic);
+        void EndFunction();
+
+        /* --- Statements --- */
+
+        void Assign(const ExprHandle& lhs, const ExprHandle& rhs, const std::string& op);
+        void Evaluate(const ExprHandle& expr);
+        void Return(const ExprHandle& expr);
+        void CtrlTransfer(const std::string& transfer);
+
+        void BeginIf(const ExprHandle& condition);
+        void BeginElse();
+        void EndIf();
+
+        void BeginFor(const std::string& type, const std::string& ident, const ExprHandle& initializer, const ExprHandle& condition, const ExprHandle& iteration);
+        void EndFor();
+
+        /* --- Expressions --- */
+
+        ExprHandle Literal(const DataType dataType, const std::string& value);
+        ExprHandle Var(const std::string& ident);
+        ExprHandle Member(const ExprHandle& object, const std::string& ident);
+        ExprHandle Index(const ExprHandle& object, const ExprHandle& index);
+        ExprHandle Unary(const std::string& op, const ExprHandle& expr);
+        ExprHandle Binary(const ExprHandle& lhs, const std::string& op, const ExprHandle& rhs);
+        ExprHandle Ternary(const ExprHandle& condition, const ExprHandle& thenExpr, const ExprHandle& elseExpr);
+        ExprHandle Call(const std::string& ident, const std::vector<ExprHandle>& args);
+        ExprHandle MethodCall(const ExprHandle& object, const std::string& ident, const std::vector<ExprHandle>& args);
+        ExprHandle Construct(const std::string& type, const std::vector<ExprHandle>& args);
+        ExprHandle Cast(const std::string& type, const ExprHandle& expr);
+
+        // Returns the built program and resets the builder. Throws std::invalid_argument if any scope has not been ended.
+        ProgramPtr TakeProgram();
+
+    private:
+
+        enum class ScopeTypes
+        {
+            Struct,
+            UniformBuffer,
+            Function,
+            If,
+            Else,
+            ForLoop,
+        };
+
+        // Builder scope with the statement list new statements are appended to.
+        struct Scope
+        {
+            ScopeTypes              type;
+            ASTPtr                  ast;
+            std::vector<StmntPtr>*  stmnts;
+        };
+
+        static const char* ScopeTypeToString(const ScopeTypes t);
+
+        template <typename T, typename... Args>
+        std::shared_ptr<T> Make(Args&&... args);
+
+        void ResetProgram();
+
+        void PushScope(const ScopeTypes type, const ASTPtr& ast, std::vector<StmntPtr>& stmnts);
+        Scope PopScope(const ScopeTypes type);
+
+        // Appends the statement to the current scope (or to the global scope if there is no current scope).
+        void AppendStmnt(const StmntPtr& stmnt);
+        void AppendLocalStmnt(const StmntPtr& stmnt);
+
+        // Returns true if the current scope is a function or control-flow block.
+        bool InLocalScope() const;
+
+        ExprHandle MakeHandle(const ExprPtr& expr);
+
+        // Returns the expression of the specified handle and invalidates the handle, or null if the handle is invalid and 'optional' is true.
+        ExprPtr TakeExpr(const ExprHandle& handle, bool optional = false);
+
+        ExprList TakeExprList(const std::vector<ExprHandle>& handles);
+
+        // Returns the expression of the specified handle within brackets, if it is a compound expression.
+        ExprPtr TakeOperand(const ExprHandle& handle);
+
+        VarAccessExprPtr TakeVarAccessExpr(const ExprHandle& handle);
+
+        VarDeclStmntPtr MakeVarDeclStmnt(const std::string& type, const std::string& ident, const std::string& semantic, const ExprPtr& initializer);
+        RegisterPtr MakeRegister(const RegisterType registerType, int slot);
+        CodeBlockStmntPtr MakeCodeBlockStmnt();
+
+        // Parses the specified HLSL type name, e.g. "nointerpolation float4", "Texture2D<float4>", or "float3x3[2]".
+        TypeSpecifierPtr ParseTypeSpecifier(const std::string& type, std::vector<ArrayDimensionPtr>* arrayDims = nullptr, bool allowVoidType = false);
+
+        ProgramPtr              program_;
+        std::vector<Scope>      scopes_;
+        std::vector<ExprPtr>    exprs_;
+
+        SourcePosition          pos_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,89 @@
+/*
+ * IncludeMemo.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "IncludeMemo.h"
+
+
+namespace Xsc
+{
+
+
+const std::size_t IncludeMemo::maxExpansionsPerFile;
+
+std::vector<IncludeMemo::ExpansionPtr> IncludeMemo::Find(const std::string& filename, const std::string& sourceText) const
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    auto it = files_.find(filename);
+    if (it != files_.end() && it->second.sourceText == sourceText)
+        return it->second.expansions;
+
+    return {};
+}
+
+void IncludeMemo::Record(const std::string& filename, const std::string& sourceText, const ExpansionPtr& expansion)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    auto& file = files_[filename];
+
+    /* Discard all previous expansions if the include file has been changed */
+    if (file.sourceText != sourceText)
+    {
+        file.sourceText = sourceText;
+        file.expansions.clear();
+    }
+
+    if (file.expansions.size() < IncludeMemo::maxExpansionsPerFile)
+        file.expansions.push_back(expansion);
+}
+
+void IncludeMemo::Clear()
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    files_.clear();
+    numHits_    = 0;
+    numMisses_  = 0;
+}
+
+
+/*
+ * IncludeCache class
+ */
+
+IncludeCache::IncludeCache() :
+    memo_ { new IncludeMemo() }
+{
+}
+
+IncludeCache::~IncludeCache()
+{
+    delete memo_;
+}
+
+void IncludeCache::Clear()
+{
+    memo_->Clear();
+}
+
+std::size_t IncludeCache::NumHits() const
+{
+    return memo_->NumHits();
+}
+
+std::size_t IncludeCache::NumMisses() const
+{
+    return memo_->NumMisses();
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,94 @@
+/*
+ * IncludeMemo.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_INCLUDE_MEMO_H
+#define XSC_INCLUDE_MEMO_H
+
+
+#include "PreProcessor.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+/*
+Thread-safe store of recorded include file expansions (see IncludeCache).
+The expansions are keyed by the include filename and the source text of the include file,
+i.e. all expansions of a file are discarded as soon as the file is read with a different source text.
+Files that are included by an include file are validated by the pre-processor before an expansion is replayed (see IncludeExpansion::includeReads).
+*/
+class IncludeMemo
+{
+
+    public:
+
+        using ExpansionPtr = std::shared_ptr<const PreProcessor::IncludeExpansion>;
+
+        // Maximum number of expansions that are recorded per include file.
+        static const std::size_t maxExpansionsPerFile = 64;
+
+        // Returns all recorded expansions of the specified include file with the specified source text.
+        std::vector<ExpansionPtr> Find(const std::string& filename, const std::string& sourceText) const;
+
+        // Records the specified expansion of the include file with the specified source text.
+        void Record(const std::string& filename, const std::string& sourceText, const ExpansionPtr& expansion);
+
+        // Removes all recorded include files and resets the statistics.
+        void Clear();
+
+        inline void CountHit()
+        {
+            ++numHits_;
+        }
+
+        inline void CountMiss()
+        {
+            ++numMisses_;
+        }
+
+        inline std::size_t NumHits() const
+        {
+            return numHits_;
+        }
+
+        inline std::size_t NumMisses() const
+        {
+            return numMisses_;
+        }
+
+    private:
+
+        struct IncludeFile
+        {
+            std::string                 sourceText;
+            std::vector<ExpansionPtr>   expansions;
+        };
+
+        mutable std::mutex                  mutex_;
+        std::map<std::string, IncludeFile>  files_;
+
+        std::atomic<std::size_t>            numHits_    { 0 };
+        std::atomic<std::size_t>            numMisses_  { 0 };
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
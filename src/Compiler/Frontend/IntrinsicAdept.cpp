@@ -15,7 +15,7 @@ namespace Xsc
 {
 
 
-static IntrinsicAdept* g_intrinsicAdeptInstance = nullptr;
+static thread_local IntrinsicAdept* g_intrinsicAdeptInstance = nullptr;
 
 IntrinsicAdept::IntrinsicAdept()
 {
@@ -68,7 +68,7 @@ void IntrinsicAdept::FillOverloadedIntrinsicIdents()
 }
 
 [[noreturn]]
-void IntrinsicAdept::ThrowAmbiguousIntrinsicCall(const Intrinsic intrinsic, const std::vector<ExprPtr>& args)
+void IntrinsicAdept::ThrowAmbiguousIntrinsicCall(const Intrinsic intrinsic, const ExprList& args)
 {
     std::string s;
 
@@ -41,10 +41,10 @@ class IntrinsicAdept
         const std::string& GetIntrinsicIdent(const Intrinsic intrinsic) const;
 
         // Returns the return type denoter of the specified intrinsic with its arguments or throws an error if the call is ambiguous.
-        virtual TypeDenoterPtr GetIntrinsicReturnType(const Intrinsic intrinsic, const std::vector<ExprPtr>& args) const = 0;
+        virtual TypeDenoterPtr GetIntrinsicReturnType(const Intrinsic intrinsic, const ExprList& args) const = 0;
 
         // Returns a list of all parameter types of the specified intrinsic with its arguments or throws an error if the call is ambiguous.
-        virtual std::vector<TypeDenoterPtr> GetIntrinsicParameterTypes(const Intrinsic intrinsic, const std::vector<ExprPtr>& args) const = 0;
+        virtual std::vector<TypeDenoterPtr> GetIntrinsicParameterTypes(const Intrinsic intrinsic, const ExprList& args) const = 0;
 
         // Returns a list of indices that refer to all output parameters of the specified intrinsic.
         virtual std::vector<std::size_t> GetIntrinsicOutputParameterIndices(const Intrinsic intrinsic) const = 0;
@@ -60,7 +60,7 @@ class IntrinsicAdept
         void FillOverloadedIntrinsicIdents();
 
         [[noreturn]]
-        void ThrowAmbiguousIntrinsicCall(const Intrinsic intrinsic, const std::vector<ExprPtr>& args);
+        void ThrowAmbiguousIntrinsicCall(const Intrinsic intrinsic, const ExprList& args);
 
     private:
 
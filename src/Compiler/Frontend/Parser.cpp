@@ -104,27 +104,106 @@ void Parser::Warning(const std::string& msg, bool prevToken)
     Warning(msg, prevToken ? GetScanner().PreviousToken().get() : GetScanner().ActiveToken().get());
 }
 
-/* ----- Scanner ----- */
+/* ----- Error recovery ----- */
 
-void Parser::PushScannerSource(const SourceCodePtr& source, const std::string& filename)
+void Parser::EnableErrorRecovery(bool enable)
 {
-    /* Add current token to previous scanner */
-    if (!scannerStack_.empty())
-        scannerStack_.top().nextToken = tkn_;
+    errorRecovery_ = enable;
+}
 
-    /* Make a new token scanner */
-    auto scanner = MakeScanner();
-    if (!scanner)
-        throw std::runtime_error(R_FailedToCreateScanner);
+Parser::RecoveryState Parser::SaveRecoveryState() const
+{
+    return { tkn_, parsingStateStack_.size(), preParsedASTStack_.size() };
+}
 
-    scannerStack_.push({ scanner, filename, nullptr });
+void Parser::RecoverFromSyntaxError(const std::exception& err, const RecoveryState& state)
+{
+    /* Submit syntax error (reports have already been marked as errors before they were thrown) */
+    if (auto report = dynamic_cast<const Report*>(&err))
+    {
+        if (log_)
+            log_->SumitReport(*report);
+    }
+    else
+        reportHandler_.Error(false, err.what(), GetScanner().Source(), GetTokenArea(tkn_.get()));
+
+    /* Restore parser state */
+    while (parsingStateStack_.size() > state.parsingStateStackSize)
+        parsingStateStack_.pop();
+
+    while (preParsedASTStack_.size() > state.preParsedASTStackSize)
+        preParsedASTStack_.pop();
+
+    unexpectedTokenCounter_ = 0;
+
+    /* Skip all tokens until the end of the current statement or code block */
+    int blockDepth = 0;
+
+    while (!Is(Tokens::EndOfStream))
+    {
+        if (Is(Tokens::LCurly))
+            ++blockDepth;
+        else if (Is(Tokens::RCurly))
+        {
+            /* Keep closing brace of the enclosing code block */
+            if (blockDepth == 0)
+                break;
+            if (--blockDepth == 0)
+            {
+                AcceptIt();
+                break;
+            }
+        }
+        else if (Is(Tokens::Semicolon) && blockDepth == 0)
+        {
+            AcceptIt();
+            break;
+        }
+        AcceptIt();
+    }
+
+    /* Always make progress to avoid an endless loop on a token that can not start a statement */
+    if (tkn_ == state.token && !Is(Tokens::EndOfStream))
+        AcceptIt();
+}
+
+/* ----- Scanner ----- */
+
+void Parser::PushScannerSource(const SourceCodePtr& source, const std::string& filename)
+{
+    auto& scanner = PushScanner(filename);
 
     /* Start scanning */
-    if (!scanner->ScanSource(source))
+    if (!scanner.ScanSource(source))
         throw std::runtime_error(R_FailedToScanSource);
 
     /* Set initial source origin for scanner */
-    scanner->Source()->NextSourceOrigin(filename, 0);
+    scanner.Source()->NextSourceOrigin(filename, 0);
+
+    /* Accept first token */
+    AcceptIt();
+}
+
+void Parser::PushRecordingScannerSource(const SourceCodePtr& source, ScannedTokenList& tokens)
+{
+    auto& scanner = PushScanner("");
+
+    /* Start scanning and record all tokens, including the first one */
+    if (!scanner.ScanSource(source))
+        throw std::runtime_error(R_FailedToScanSource);
+
+    scanner.Source()->NextSourceOrigin("", 0);
+    scanner.RecordTokens(&tokens);
+
+    /* Accept first token */
+    AcceptIt();
+}
+
+void Parser::PushReplayingScannerSource(const SourceCodePtr& source, const ScannedToken* first, const ScannedToken* last)
+{
+    /* Replay recorded tokens (their source origins have already been set while scanning) */
+    auto& scanner = PushScanner("");
+    scanner.ReplayTokens(source, first, last);
 
     /* Accept first token */
     AcceptIt();
@@ -161,6 +240,14 @@ std::string Parser::GetCurrentFilename() const
 
 TokenPtr Parser::Accept(const Tokens type)
 {
+    /* Report and insert missing token (only in error recovery mode) */
+    if (errorRecovery_ && tkn_->Type() != type && IsInsertableToken(type))
+    {
+        IncUnexpectedTokenCounter();
+        Error(R_UnexpectedToken(Token::TypeToString(tkn_->Type()), R_Expected + ": " + Token::TypeToString(type)), tkn_.get(), false);
+        return std::make_shared<Token>(tkn_->Pos(), type);
+    }
+
     /* Check if token is unexpected, otherwise reset counter */
     AssertTokenType(type);
     unexpectedTokenCounter_ = 0;
@@ -416,6 +503,22 @@ const std::string* Parser::FindNameManglingPrefix(const std::string& ident) cons
  * ======= Private: =======
  */
 
+Scanner& Parser::PushScanner(const std::string& filename)
+{
+    /* Add current token to previous scanner */
+    if (!scannerStack_.empty())
+        scannerStack_.top().nextToken = tkn_;
+
+    /* Make a new token scanner */
+    auto scanner = MakeScanner();
+    if (!scanner)
+        throw std::runtime_error(R_FailedToCreateScanner);
+
+    scannerStack_.push({ scanner, filename, nullptr });
+
+    return *scanner;
+}
+
 ExprPtr Parser::BuildBinaryExprTree(
     std::vector<ExprPtr>& exprs, std::vector<BinaryOp>& ops, std::vector<SourcePosition>& opsPos)
 {
@@ -463,8 +566,27 @@ void Parser::IncUnexpectedTokenCounter()
         reportHandler_.SubmitReport(true, Report::Types::Error, R_Error, R_TooManySyntaxErrors);
 }
 
+bool Parser::IsInsertableToken(const Tokens type) const
+{
+    switch (type)
+    {
+        case Tokens::Semicolon:
+        case Tokens::RBracket:
+        case Tokens::RParen:
+            return true;
+        case Tokens::RCurly:
+            return Is(Tokens::EndOfStream);
+        default:
+            return false;
+    }
+}
+
 void Parser::AssertTokenType(const Tokens type)
 {
+    /* Break with exception to recover at the next statement boundary (in error recovery mode) */
+    if (errorRecovery_ && tkn_->Type() != type)
+        ErrorUnexpected(type, nullptr, true);
+
     /* Check if token type is unexpected */
     while (tkn_->Type() != type)
     {
@@ -36,6 +36,12 @@ class Parser
         
         virtual ~Parser();
 
+        // Returns true if any syntax errors have been reported.
+        inline bool HasErrors() const
+        {
+            return reportHandler_.HasErros();
+        }
+
     protected:
         
         using Tokens        = Token::Types;
@@ -46,6 +52,14 @@ class Parser
             bool activeTemplate; // If true, '<' and '>' will not be parsed as a binary operator.
         };
 
+        // Parser state to restore when recovering from a syntax error.
+        struct RecoveryState
+        {
+            TokenPtr    token;
+            std::size_t parsingStateStackSize;
+            std::size_t preParsedASTStackSize;
+        };
+
         /* === Functions === */
 
         Parser(Log* log);
@@ -65,6 +79,26 @@ class Parser
         void Warning(const std::string& msg, const Token* tkn);
         void Warning(const std::string& msg, bool prevToken = true);
 
+        /* ----- Error recovery ----- */
+
+        /*
+        Enables or disables error recovery. If enabled, missing ';', ')', and ']' tokens (and '}' at the end of stream) are reported and inserted,
+        and any other syntax error must be recovered at the next statement boundary with "RecoverFromSyntaxError".
+        */
+        void EnableErrorRecovery(bool enable);
+
+        // Returns true if error recovery is enabled.
+        inline bool IsErrorRecovery() const
+        {
+            return errorRecovery_;
+        }
+
+        // Returns the current parser state for error recovery.
+        RecoveryState SaveRecoveryState() const;
+
+        // Submits the specified syntax error, restores the specified parser state, and skips all tokens until the next statement boundary.
+        void RecoverFromSyntaxError(const std::exception& err, const RecoveryState& state);
+
         /* ----- Scanner ----- */
 
         virtual ScannerPtr MakeScanner() = 0;
@@ -72,6 +106,12 @@ class Parser
         virtual void PushScannerSource(const SourceCodePtr& source, const std::string& filename = "");
         virtual bool PopScannerSource();
 
+        // Pushes the specified source like "PushScannerSource", but records all scanned tokens into the specified list.
+        void PushRecordingScannerSource(const SourceCodePtr& source, ScannedTokenList& tokens);
+
+        // Pushes a scanner that replays the range [first, last) of recorded tokens (see Scanner::ReplayTokens).
+        void PushReplayingScannerSource(const SourceCodePtr& source, const ScannedToken* first, const ScannedToken* last);
+
         ParsingState ActiveParsingState() const;
 
         // Returns the current token scanner.
@@ -222,6 +262,9 @@ class Parser
 
         /* === Functions === */
 
+        // Makes a new scanner and pushes it onto the scanner stack.
+        Scanner& PushScanner(const std::string& filename);
+
         // Builds a left-to-right binary-expression tree hierarchy for the specified list of expressions.
         ExprPtr BuildBinaryExprTree(
             std::vector<ExprPtr>& exprs,
@@ -231,6 +274,9 @@ class Parser
 
         void IncUnexpectedTokenCounter();
 
+        // Returns true if the specified token type can be inserted when it is missing (in error recovery mode).
+        bool IsInsertableToken(const Tokens type) const;
+
         void AssertTokenType(const Tokens type);
         void AssertTokenSpell(const std::string& spell);
 
@@ -249,6 +295,8 @@ class Parser
         unsigned int                    unexpectedTokenCounter_ = 0;
         const unsigned int              unexpectedTokenLimit_   = 3; //< this should never be less than 1
 
+        bool                            errorRecovery_          = false;
+
 };
 
 
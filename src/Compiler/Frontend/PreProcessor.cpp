@@ -6,45 +6,51 @@
  */
 
 #include "PreProcessor.h"
+#include "IncludeMemo.h"
 #include "AST.h"
 #include "ConstExprEvaluator.h"
 #include "Helper.h"
 #include "ReportIdents.h"
 #include <sstream>
+#include <iterator>
+#include <algorithm>
 
 
 namespace Xsc
 {
 
 
-PreProcessor::PreProcessor(IncludeHandler& includeHandler, Log* log) :
+// Number of buffered output characters, after which the output is flushed to the output stream (only for streamed output).
+static const std::streamoff g_outputChunkSize       = 64 * 1024;
+
+// Maximum number of buffered output characters of an include file that is recorded for the include memo (only for streamed output).
+static const std::streamoff g_maxRecordedOutputSize = 1024 * 1024;
+
+PreProcessor::PreProcessor(IncludeHandler& includeHandler, Log* log, IncludeCache* includeCache) :
     Parser          { log            },
     includeHandler_ { includeHandler }
 {
+    #ifndef XSC_ENABLE_MEMORY_POOL
+    /* Recorded macros must not outlive the thread local memory pool of their tokens, so the memo is only used without the memory pool */
+    if (includeCache)
+        includeMemo_ = includeCache->memo_;
+    #endif
 }
 
 std::unique_ptr<std::iostream> PreProcessor::Process(
     const SourceCodePtr& input, const std::string& filename, bool writeLineMarks)
 {
-    output_         = MakeUnique<std::stringstream>();
-    writeLineMarks_ = writeLineMarks;
-
-    PushScannerSource(input, filename);
-
-    try
-    {
-        ParseProgram();
-        return (GetReportHandler().HasErros() ? nullptr : std::move(output_));
-    }
-    catch (const Report& err)
-    {
-        if (GetLog())
-            GetLog()->SumitReport(err);
-    }
-
+    if (ProcessSource(input, filename, writeLineMarks, nullptr))
+        return std::move(output_);
     return nullptr;
 }
 
+bool PreProcessor::Process(
+    const SourceCodePtr& input, std::ostream& output, const std::string& filename, bool writeLineMarks)
+{
+    return ProcessSource(input, filename, writeLineMarks, &output);
+}
+
 std::vector<std::string> PreProcessor::ListDefinedMacroIdents() const
 {
     std::vector<std::string> idents;
@@ -107,6 +113,8 @@ void PreProcessor::DefineMacro(const Macro& macro)
         /* Check if identifier is already defined */
         const auto& ident = macro.identTkn->Spell();
 
+        NoteMacroWrite(ident);
+
         auto previousMacroIt = macros_.find(ident);
         if (previousMacroIt != macros_.end())
         {
@@ -133,6 +141,8 @@ void PreProcessor::DefineStandardMacro(const std::string& ident, int intValue)
 void PreProcessor::UndefineMacro(const std::string& ident, const Token* tkn)
 {
     /* Remove macro */
+    NoteMacroWrite(ident);
+
     auto it = macros_.find(ident);
     if (it != macros_.end())
     {
@@ -143,8 +153,9 @@ void PreProcessor::UndefineMacro(const std::string& ident, const Token* tkn)
         Warning(R_FailedToUndefMacro(ident), tkn);
 }
 
-bool PreProcessor::IsDefined(const std::string& ident) const
+bool PreProcessor::IsDefined(const std::string& ident)
 {
+    NoteMacroRead(ident);
     return (macros_.find(ident) != macros_.end());
 }
 
@@ -199,11 +210,19 @@ void PreProcessor::PushScannerSource(const SourceCodePtr& source, const std::str
 {
     Parser::PushScannerSource(source, filename);
     GetScanner().Source()->NextSourceOrigin(filename, 0);
+    ++sourceDepth_;
     WritePosToLineDirective();
 }
 
 bool PreProcessor::PopScannerSource()
 {
+    /* Finish the record of the include file that is left now (before the line mark of the parent file is written) */
+    if (!includeRecords_.empty() && includeRecords_.back().sourceDepth == sourceDepth_)
+        EndIncludeRecord();
+
+    if (sourceDepth_ > 0)
+        --sourceDepth_;
+
     if (Parser::PopScannerSource())
     {
         WritePosToLineDirective();
@@ -361,6 +380,304 @@ void PreProcessor::WritePosToLineDirective()
     }
 }
 
+bool PreProcessor::ProcessSource(
+    const SourceCodePtr& input, const std::string& filename, bool writeLineMarks, std::ostream* outputStream)
+{
+    output_         = MakeUnique<std::stringstream>();
+    outputStream_   = outputStream;
+    outputOffset_   = 0;
+    writeLineMarks_ = writeLineMarks;
+
+    PushScannerSource(input, filename);
+
+    try
+    {
+        ParseProgram();
+        if (!GetReportHandler().HasErros())
+        {
+            FlushOutput(true);
+            return true;
+        }
+    }
+    catch (const Report& err)
+    {
+        if (GetLog())
+            GetLog()->SumitReport(err);
+    }
+
+    return false;
+}
+
+void PreProcessor::FlushOutput(bool flushAll)
+{
+    if (!outputStream_)
+        return;
+
+    const std::streamoff bufferSize = output_->tellp();
+    std::streamoff flushSize = bufferSize;
+
+    if (!flushAll)
+    {
+        /* Keep the output of all recorded include files, unless it exceeds the limit (see EndIncludeRecord) */
+        for (auto& record : includeRecords_)
+        {
+            if (!record.outputFlushed)
+            {
+                const auto recordBegin = record.outputBegin - outputOffset_;
+                if (bufferSize - recordBegin > g_maxRecordedOutputSize)
+                    record.outputFlushed = true;
+                else
+                    flushSize = std::min(flushSize, recordBegin);
+            }
+        }
+
+        if (flushSize < g_outputChunkSize)
+            return;
+    }
+
+    if (flushSize > 0)
+    {
+        /* Write flushed output into the output stream and keep the remaining output in the buffer */
+        const auto text = output_->str();
+        outputStream_->write(text.data(), flushSize);
+
+        output_->str(text.substr(static_cast<std::size_t>(flushSize)));
+        output_->seekp(0, std::ios_base::end);
+
+        outputOffset_ += flushSize;
+    }
+}
+
+std::streamoff PreProcessor::OutputPos()
+{
+    return (outputOffset_ + static_cast<std::streamoff>(Out().tellp()));
+}
+
+/* ----- Include memo ----- */
+
+std::string PreProcessor::MacroSignature(const std::string& ident) const
+{
+    auto it = macros_.find(ident);
+    if (it == macros_.end())
+        return "";
+
+    /* Append parameters and all tokens (including white spaces) with their type and length to the signature */
+    const auto& macro = *it->second;
+
+    std::string signature = (macro.stdMacro ? "S(" : "D(");
+
+    for (const auto& param : macro.parameters)
+        signature += param + ',';
+
+    signature += (macro.varArgs ? "...)" : ")");
+
+    for (const auto& tkn : macro.tokenString.GetTokens())
+    {
+        signature += std::to_string(static_cast<int>(tkn->Type()));
+        signature += ':';
+        signature += std::to_string(tkn->Spell().size());
+        signature += ':';
+        signature += tkn->Spell();
+    }
+
+    return signature;
+}
+
+void PreProcessor::NoteMacroRead(const std::string& ident)
+{
+    if (!includeRecords_.empty())
+    {
+        /* Only the first access determines the value at entry of the include file */
+        auto& macroReads = includeRecords_.back().expansion->macroReads;
+        if (macroReads.find(ident) == macroReads.end())
+            macroReads[ident] = MacroSignature(ident);
+    }
+}
+
+void PreProcessor::NoteMacroWrite(const std::string& ident)
+{
+    if (!includeRecords_.empty())
+    {
+        /* Writes depend on the previous definition as well (e.g. for redefinition warnings) */
+        NoteMacroRead(ident);
+        includeRecords_.back().macroWrites.insert(ident);
+    }
+}
+
+void PreProcessor::NoteOnceRead(const std::string& filename)
+{
+    if (!includeRecords_.empty())
+    {
+        auto& onceReads = includeRecords_.back().expansion->onceReads;
+        if (onceReads.find(filename) == onceReads.end())
+            onceReads[filename] = (onceIncluded_.find(filename) != onceIncluded_.end());
+    }
+}
+
+void PreProcessor::NoteIncludeRead(const IncludeKey& key, const std::string& sourceText)
+{
+    auto hash = HashString(sourceText);
+
+    includeHashes_[key] = hash;
+
+    if (!includeRecords_.empty())
+        includeRecords_.back().expansion->includeReads.insert({ key, hash });
+}
+
+bool PreProcessor::FindIncludeHash(const IncludeKey& key, std::uint64_t& hash)
+{
+    auto it = includeHashes_.find(key);
+    if (it == includeHashes_.end())
+    {
+        /* Read include file with the current include handler, since it might resolve to another file than for the recorded expansion */
+        std::unique_ptr<std::istream> includeStream;
+
+        try
+        {
+            includeStream = includeHandler_.Include(key.first, key.second);
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+
+        if (!includeStream)
+            return false;
+
+        std::string sourceText { std::istreambuf_iterator<char>(*includeStream), std::istreambuf_iterator<char>() };
+        it = includeHashes_.insert({ key, HashString(sourceText) }).first;
+    }
+
+    hash = it->second;
+    return true;
+}
+
+bool PreProcessor::ReplayIncludeExpansion(const std::string& filename, const std::string& sourceText)
+{
+    for (const auto& expansion : includeMemo_->Find(filename, sourceText))
+    {
+        if (MatchIncludeExpansion(*expansion))
+        {
+            /* Replay expanded output and macro side effects */
+            Out() << expansion->output;
+
+            for (const auto& macro : expansion->macroWrites)
+            {
+                if (macro.second)
+                    macros_[macro.first] = macro.second;
+                else
+                    macros_.erase(macro.first);
+            }
+
+            onceIncluded_.insert(expansion->onceIncludes.begin(), expansion->onceIncludes.end());
+
+            MergeIncludeExpansion(*expansion);
+            includeMemo_->CountHit();
+
+            return true;
+        }
+    }
+
+    includeMemo_->CountMiss();
+
+    return false;
+}
+
+bool PreProcessor::MatchIncludeExpansion(const IncludeExpansion& expansion)
+{
+    if (expansion.lineMarks != writeLineMarks_)
+        return false;
+
+    for (const auto& read : expansion.macroReads)
+    {
+        if (MacroSignature(read.first) != read.second)
+            return false;
+    }
+
+    for (const auto& read : expansion.onceReads)
+    {
+        if ((onceIncluded_.find(read.first) != onceIncluded_.end()) != read.second)
+            return false;
+    }
+
+    /* Compare nested include files last, since they might have to be read first */
+    for (const auto& read : expansion.includeReads)
+    {
+        std::uint64_t hash = 0;
+        if (!FindIncludeHash(read.first, hash) || hash != read.second)
+            return false;
+    }
+
+    return true;
+}
+
+void PreProcessor::MergeIncludeExpansion(const IncludeExpansion& expansion)
+{
+    if (!includeRecords_.empty())
+    {
+        /* Merge reads (only where the enclosing include file has not accessed the same macro before) and writes */
+        auto& record = includeRecords_.back();
+
+        record.expansion->macroReads.insert(expansion.macroReads.begin(), expansion.macroReads.end());
+        record.expansion->onceReads.insert(expansion.onceReads.begin(), expansion.onceReads.end());
+        record.expansion->includeReads.insert(expansion.includeReads.begin(), expansion.includeReads.end());
+        record.expansion->onceIncludes.insert(expansion.onceIncludes.begin(), expansion.onceIncludes.end());
+
+        for (const auto& macro : expansion.macroWrites)
+            record.macroWrites.insert(macro.first);
+    }
+}
+
+void PreProcessor::BeginIncludeRecord(const std::string& filename, const std::string& sourceText)
+{
+    IncludeRecord record;
+    {
+        record.filename     = filename;
+        record.sourceText   = sourceText;
+        record.sourceDepth  = sourceDepth_ + 1;
+        record.outputBegin  = OutputPos();
+        record.ifBlockDepth = ifBlockStack_.size();
+        record.numReports   = GetReportHandler().NumReports();
+        record.expansion    = std::make_shared<IncludeExpansion>();
+        record.expansion->lineMarks = writeLineMarks_;
+    }
+    includeRecords_.push_back(std::move(record));
+}
+
+void PreProcessor::EndIncludeRecord()
+{
+    auto record = std::move(includeRecords_.back());
+    includeRecords_.pop_back();
+
+    auto& expansion = *record.expansion;
+
+    /* Store final definitions of all written macros */
+    for (const auto& ident : record.macroWrites)
+    {
+        auto it = macros_.find(ident);
+        expansion.macroWrites[ident] = (it != macros_.end() ? it->second : nullptr);
+    }
+
+    MergeIncludeExpansion(expansion);
+
+    /* Only memoize self-contained include files, which have not submitted any reports, and whose output is still buffered */
+    if (ifBlockStack_.size() == record.ifBlockDepth && GetReportHandler().NumReports() == record.numReports && !record.outputFlushed)
+    {
+        /* Copy expanded output of the include file, and restore read position of the output stream */
+        auto& out = Out();
+        const std::streamoff outputBegin    = record.outputBegin - outputOffset_;
+        const std::streamoff outputEnd      = out.tellp();
+
+        expansion.output.resize(static_cast<std::size_t>(outputEnd - outputBegin));
+
+        out.seekg(outputBegin);
+        out.read(&expansion.output[0], static_cast<std::streamsize>(expansion.output.size()));
+        out.seekg(0);
+
+        includeMemo_->Record(record.filename, record.sourceText, record.expansion);
+    }
+}
+
 /* === Parse functions === */
 
 void PreProcessor::ParseProgram()
@@ -370,6 +687,8 @@ void PreProcessor::ParseProgram()
     {
         while (!Is(Tokens::EndOfStream))
         {
+            FlushOutput();
+
             if (TopIfBlock().active)
             {
                 /* Parse active block */
@@ -447,6 +766,7 @@ TokenPtrString PreProcessor::ParseIdentAsTokenString()
     else
     {
         /* Search for defined macro */
+        NoteMacroRead(ident);
         auto it = macros_.find(ident);
         if (it != macros_.end())
         {
@@ -661,6 +981,8 @@ void PreProcessor::ParseDirectiveInclude()
     }
 
     /* Check if filename has already been marked as 'once included' */
+    NoteOnceRead(filename);
+
     if (onceIncluded_.find(filename) == onceIncluded_.end())
     {
         /* Open source code */
@@ -675,6 +997,23 @@ void PreProcessor::ParseDirectiveInclude()
             Error(e.what());
         }
 
+        if (includeMemo_ && includeStream)
+        {
+            /* Read entire include file to look up its recorded expansions */
+            std::string sourceText { std::istreambuf_iterator<char>(*includeStream), std::istreambuf_iterator<char>() };
+
+            NoteIncludeRead({ filename, useSearchPaths }, sourceText);
+
+            if (ReplayIncludeExpansion(filename, sourceText))
+            {
+                WritePosToLineDirective();
+                return;
+            }
+
+            includeStream = std::unique_ptr<std::istream>(new std::istringstream(sourceText));
+            BeginIncludeRecord(filename, sourceText);
+        }
+
         /* Push scanner soruce for include file */
         auto sourceCode = std::make_shared<SourceCode>(std::move(includeStream));
         PushScannerSource(sourceCode, filename);
@@ -838,7 +1177,14 @@ void PreProcessor::ParseDirectivePragma()
                 /* Mark current filename as 'once included' (but not for the main file) */
                 auto filename = GetCurrentFilename();
                 if (!filename.empty())
+                {
+                    if (!includeRecords_.empty())
+                    {
+                        NoteOnceRead(filename);
+                        includeRecords_.back().expansion->onceIncludes.insert(filename);
+                    }
                     onceIncluded_.insert(std::move(filename));
+                }
             }
             else if (command == "message")
             {
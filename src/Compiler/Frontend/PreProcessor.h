@@ -22,12 +22,17 @@
 #include <stack>
 #include <map>
 #include <set>
+#include <vector>
+#include <utility>
+#include <cstdint>
 
 
 namespace Xsc
 {
 
 
+class IncludeMemo;
+
 /*
 Pre-processor to substitute macros and include directives.
 The preprocessor works on something similar to a Concrete Syntax Tree (CST) rather than an Abstract Syntax Tree (AST).
@@ -40,7 +45,7 @@ class PreProcessor : public Parser
     
     public:
         
-        PreProcessor(IncludeHandler& includeHandler, Log* log = nullptr);
+        PreProcessor(IncludeHandler& includeHandler, Log* log = nullptr, IncludeCache* includeCache = nullptr);
 
         std::unique_ptr<std::iostream> Process(
             const SourceCodePtr& input,
@@ -48,6 +53,17 @@ class PreProcessor : public Parser
             bool writeLineMarks = true
         );
 
+        /*
+        Pre-processes the input and writes the output in chunks into the specified stream, so only a bounded amount of output is buffered.
+        Returns false on failure, in which case the output stream may already contain parts of the output.
+        */
+        bool Process(
+            const SourceCodePtr& input,
+            std::ostream& output,
+            const std::string& filename = "",
+            bool writeLineMarks = true
+        );
+
         // Returns a list of all defined macro identifiers after pre-processing.
         std::vector<std::string> ListDefinedMacroIdents() const;
 
@@ -71,6 +87,24 @@ class PreProcessor : public Parser
             bool                        stdMacro    = false;    // Specifies whether the macro is a standard macro (i.e. part of the language) or not
         };
 
+        // Include filename and whether the search paths are used first (i.e. "#include <...>").
+        using IncludeKey = std::pair<std::string, bool>;
+
+        /*
+        Recorded expansion of an include file, which is replayed whenever all macros it reads have the same values,
+        and all files it includes (transitively) have the same content (see IncludeCache).
+        */
+        struct IncludeExpansion
+        {
+            bool                                            lineMarks   = true;
+            std::map<std::string, std::string>              macroReads;     // Signatures of all macros that are read, at entry of the include file.
+            std::map<std::string, bool>                     onceReads;      // 'Once included' states of all filenames that are read, at entry of the include file.
+            std::map<IncludeKey, std::uint64_t>             includeReads;   // Content hashes of all files that are included (transitively).
+            std::string                                     output;         // Expanded output (including all line marks).
+            std::map<std::string, std::shared_ptr<Macro>>   macroWrites;    // Final definitions of all macros that are written (null if undefined).
+            std::set<std::string>                           onceIncludes;   // Filenames that are marked as 'once included'.
+        };
+
         // Parses the specified directive, that is not part of the standard pre-processor directive (e.g. "version" or "extension" for GLSL).
         virtual void ParseDirective(const std::string& directive, bool ignoreUnknown);
 
@@ -84,7 +118,7 @@ class PreProcessor : public Parser
         void UndefineMacro(const std::string& ident, const Token* tkn = nullptr);
 
         // Returns true if the specified macro identifier is defined.
-        bool IsDefined(const std::string& ident) const;
+        bool IsDefined(const std::string& ident);
 
         // Callback function when a macro is about to be defined
         virtual bool OnDefineMacro(const Macro& macro);
@@ -103,6 +137,8 @@ class PreProcessor : public Parser
 
     private:
         
+        friend class IncludeMemo;
+
         /* === Structures === */
 
         struct IfBlock
@@ -117,12 +153,34 @@ class PreProcessor : public Parser
             bool            elseAllowed     = true;     // Is an else-block allowed?
         };
 
+        // Recording state of an include file that is currently pre-processed.
+        struct IncludeRecord
+        {
+            std::string                         filename;
+            std::string                         sourceText;
+            std::size_t                         sourceDepth     = 0;
+            std::streamoff                      outputBegin     = 0;
+            std::size_t                         ifBlockDepth    = 0;
+            std::size_t                         numReports      = 0;
+            bool                                outputFlushed   = false;    // Output has been flushed to the output stream before it could be recorded.
+            std::set<std::string>               macroWrites;
+            std::shared_ptr<IncludeExpansion>   expansion;
+        };
+
         using MacroPtr = std::shared_ptr<Macro>;
 
         /* === Functions === */
 
         ScannerPtr MakeScanner() override;
 
+        bool ProcessSource(const SourceCodePtr& input, const std::string& filename, bool writeLineMarks, std::ostream* outputStream);
+
+        // Writes the buffered output into the output stream (if specified), except the output of include files that are still recorded.
+        void FlushOutput(bool flushAll = false);
+
+        // Returns the current output position, including the output that has already been flushed.
+        std::streamoff OutputPos();
+
         void PushScannerSource(const SourceCodePtr& source, const std::string& filename = "") override;
         bool PopScannerSource() override;
 
@@ -142,6 +200,32 @@ class PreProcessor : public Parser
         // Writes a '#line'-directive to the output with the current source position and filename.
         void WritePosToLineDirective();
 
+        /* ----- Include memo ----- */
+
+        // Returns the signature of the specified macro, or an empty string if the macro is undefined.
+        std::string MacroSignature(const std::string& ident) const;
+
+        // Records that the specified macro (or 'once included' state of the specified filename) is read or written by the current include file.
+        void NoteMacroRead(const std::string& ident);
+        void NoteMacroWrite(const std::string& ident);
+        void NoteOnceRead(const std::string& filename);
+
+        // Records the content hash of the specified include file for the current include file.
+        void NoteIncludeRead(const IncludeKey& key, const std::string& sourceText);
+
+        // Stores the content hash of the specified include file in 'hash'. Returns false if the file can not be included.
+        bool FindIncludeHash(const IncludeKey& key, std::uint64_t& hash);
+
+        // Replays a matching recorded expansion of the specified include file. Returns false if there is no match.
+        bool ReplayIncludeExpansion(const std::string& filename, const std::string& sourceText);
+        bool MatchIncludeExpansion(const IncludeExpansion& expansion);
+
+        // Merges the reads and writes of the specified include expansion into the enclosing include record.
+        void MergeIncludeExpansion(const IncludeExpansion& expansion);
+
+        void BeginIncludeRecord(const std::string& filename, const std::string& sourceText);
+        void EndIncludeRecord();
+
         /* ----- Parsing ----- */
 
         void            ParseProgram();
@@ -179,8 +263,11 @@ class PreProcessor : public Parser
         /* === Members === */
 
         IncludeHandler&                     includeHandler_;
+        IncludeMemo*                        includeMemo_            = nullptr;
 
         std::unique_ptr<std::stringstream>  output_;
+        std::ostream*                       outputStream_           = nullptr;  // Output stream for the streamed output (see FlushOutput).
+        std::streamoff                      outputOffset_           = 0;        // Number of characters that have already been flushed.
 
         std::map<std::string, MacroPtr>     macros_;
         std::set<std::string>               onceIncluded_;
@@ -191,6 +278,10 @@ class PreProcessor : public Parser
         */
         std::stack<IfBlock>                 ifBlockStack_;
 
+        std::vector<IncludeRecord>          includeRecords_;
+        std::map<IncludeKey, std::uint64_t> includeHashes_;                     // Content hashes of all include files that have been read so far.
+        std::size_t                         sourceDepth_            = 0;
+
         bool                                writeLineMarks_         = true;
 
 };
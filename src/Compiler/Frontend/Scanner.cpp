@@ -51,6 +51,18 @@ TokenPtrString::ConstIterator Scanner::TopTokenStringIterator() const
     return (!tokenStringItStack_.empty() ? tokenStringItStack_.top() : TokenPtrString::ConstIterator());
 }
 
+void Scanner::RecordTokens(ScannedTokenList* tokens)
+{
+    recordTokens_ = tokens;
+}
+
+void Scanner::ReplayTokens(const SourceCodePtr& source, const ScannedToken* first, const ScannedToken* last)
+{
+    source_         = source;
+    replayToken_    = first;
+    replayEnd_      = last;
+}
+
 TokenPtr Scanner::ActiveToken() const
 {
     return activeToken_;
@@ -80,10 +92,22 @@ TokenPtr Scanner::NextToken(bool scanComments, bool scanWhiteSpaces)
         auto& tokenStringIt = tokenStringItStack_.top();
         tkn = *(tokenStringIt++);
     }
+    else if (replayToken_)
+    {
+        /* Replay next recorded token */
+        tkn = NextTokenReplay();
+    }
     else
     {
         /* Scan next token from token sub-scanner */
         tkn = NextTokenScan(scanComments, scanWhiteSpaces);
+
+        /* Record token with current scanner state */
+        if (recordTokens_)
+        {
+            recordTokens_->push_back({ tkn, nextStartPos_, comment_, std::move(recordReports_) });
+            recordReports_.clear();
+        }
     }
 
     /* Store new active token */
@@ -168,7 +192,9 @@ TokenPtr Scanner::NextTokenScan(bool scanComments, bool scanWhiteSpaces)
         catch (const Report& err)
         {
             /* Add to error and scan next token */
-            if (log_)
+            if (recordTokens_)
+                recordReports_.push_back(err);
+            else if (log_)
                 log_->SumitReport(err);
         }
     }
@@ -176,6 +202,31 @@ TokenPtr Scanner::NextTokenScan(bool scanComments, bool scanWhiteSpaces)
     return nullptr;
 }
 
+//private
+TokenPtr Scanner::NextTokenReplay()
+{
+    if (replayToken_ == replayEnd_)
+    {
+        /* Return end-of-stream token after the last recorded token */
+        return MakeShared<Token>(nextStartPos_, Tokens::EndOfStream);
+    }
+
+    /* Restore scanner state of the recorded token */
+    const auto& scannedTkn = *(replayToken_++);
+
+    nextStartPos_   = scannedTkn.startPos;
+    comment_        = scannedTkn.comment;
+
+    /* Submit lexical errors in the same order they would have been reported during scanning */
+    if (log_)
+    {
+        for (const auto& err : scannedTkn.reports)
+            log_->SumitReport(err);
+    }
+
+    return scannedTkn.token;
+}
+
 //private
 void Scanner::StoreStartPos()
 {
@@ -17,6 +17,7 @@
 #include "TokenString.h"
 
 #include <string>
+#include <vector>
 #include <functional>
 
 
@@ -24,6 +25,17 @@ namespace Xsc
 {
 
 
+// Recorded token together with the scanner state after the token has been scanned (see Scanner::RecordTokens).
+struct ScannedToken
+{
+    TokenPtr            token;
+    SourcePosition      startPos;   // Start position of the token (see Scanner::Pos).
+    std::string         comment;    // Active commentary string in front of the token (see Scanner::GetComment).
+    std::vector<Report> reports;    // Lexical errors that occurred in front of the token.
+};
+
+using ScannedTokenList = std::vector<ScannedToken>;
+
 // Scanner base class.
 class Scanner
 {
@@ -43,6 +55,18 @@ class Scanner
         // Returns the iterator of the top most token string on the stack.
         TokenPtrString::ConstIterator TopTokenStringIterator() const;
 
+        /*
+        Records all tokens that are scanned from now on into the specified list (or stops recording if this is null).
+        Lexical errors are not submitted to the log while recording, but stored in the recorded tokens.
+        */
+        void RecordTokens(ScannedTokenList* tokens);
+
+        /*
+        Replays the specified range [first, last) of recorded tokens instead of scanning a source code.
+        The specified source code is only used for reports. After the last token, only end-of-stream tokens are returned.
+        */
+        void ReplayTokens(const SourceCodePtr& source, const ScannedToken* first, const ScannedToken* last);
+
         // Scanes the source code for the next token
         virtual TokenPtr Next() = 0;
 
@@ -76,6 +100,12 @@ class Scanner
             return comment_;
         }
 
+        // Returns true if this scanner replays recorded tokens (see "ReplayTokens").
+        inline bool IsReplaying() const
+        {
+            return (replayToken_ != nullptr);
+        }
+
     protected:
         
         using Tokens = Token::Types;
@@ -161,6 +191,7 @@ class Scanner
         /* === Functions === */
 
         TokenPtr NextTokenScan(bool scanComments, bool scanWhiteSpaces);
+        TokenPtr NextTokenReplay();
 
         void AppendComment(const std::string& s);
         void AppendMultiLineComment(const std::string& s);
@@ -178,6 +209,12 @@ class Scanner
 
         std::stack<TokenPtrString::ConstIterator>   tokenStringItStack_;
 
+        // Token recording and replaying.
+        ScannedTokenList*                           recordTokens_       = nullptr;
+        std::vector<Report>                         recordReports_;
+        const ScannedToken*                         replayToken_        = nullptr;
+        const ScannedToken*                         replayEnd_          = nullptr;
+
         // Active commentary string (in front of the next token).
         std::string                                 comment_;
         unsigned int                                commentStartPos_    = 0;
@@ -35,6 +35,19 @@ void Replace(std::string& s, const std::string& from, const std::string& to)
         s.replace(pos, from.size(), to);
 }
 
+std::uint64_t HashString(const std::string& s)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+
+    for (auto c : s)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
 
 } // /namespace Xsc
 
@@ -16,6 +16,7 @@
 #include <memory>
 #include <algorithm>
 #include <iterator>
+#include <cstdint>
 
 
 namespace Xsc
@@ -103,6 +104,9 @@ std::string ToUpper(const std::string& s);
 // Replaces all occurances of 'from' in the string 's' by 'to'.
 void Replace(std::string& s, const std::string& from, const std::string& to);
 
+// Returns the 64-bit FNV-1a hash of the specified string, which is equal on all platforms.
+std::uint64_t HashString(const std::string& s);
+
 
 } // /namespace Xsc
 
@@ -20,7 +20,7 @@ namespace Xsc
 
 MemoryPool& MemoryPool::Instance()
 {
-    static MemoryPool instance;
+    static thread_local MemoryPool instance;
     return instance;
 }
 
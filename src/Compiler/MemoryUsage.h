@@ -0,0 +1,41 @@
+/*
+ * MemoryUsage.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_MEMORY_USAGE_H
+#define XSC_MEMORY_USAGE_H
+
+
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+// Memory usage of the current process (in bytes).
+struct MemoryUsage
+{
+    std::size_t residentBytes   = 0;        // Currently resident memory.
+    std::size_t peakBytes       = 0;        // High-water mark of the resident memory since the last reset, or since the process has been started.
+    bool        peakReset       = false;    // Specifies whether the high-water mark has been reset right after this query (see ResetPeakMemoryUsage).
+};
+
+// Queries the memory usage of the current process, or returns zeros if this is not supported on this platform.
+MemoryUsage QueryMemoryUsage();
+
+// Resets the high-water mark of the resident memory to the currently resident memory, or returns false if this is not supported on this platform.
+bool ResetPeakMemoryUsage();
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,363 @@
+/*
+ * Pipeline.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <Xsc/Pipeline.h>
+#include "ReflectionPrinter.h"
+#include "ReportIdents.h"
+#include "Helper.h"
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace Xsc
+{
+
+
+/*
+ * Internal functions
+ */
+
+using namespace Reflection;
+
+static void SubmitConflict(Log* log, const std::string& msg)
+{
+    if (log)
+        log->SumitReport(Report(Report::Types::Error, msg));
+}
+
+// Returns true if the specified attribute identifier denotes a system value (e.g. "SV_Position"), which is not written by the previous stage.
+static bool IsSystemValueAttribute(const std::string& ident)
+{
+    return (ident.compare(0, 3, "SV_") == 0);
+}
+
+/* Appends the canonical description of all binding slots (independent of their order) */
+static void AppendBindingSlots(std::string& s, const std::string& title, std::vector<BindingSlot> slots)
+{
+    std::sort(
+        slots.begin(), slots.end(),
+        [](const BindingSlot& lhs, const BindingSlot& rhs)
+        {
+            return (lhs.location < rhs.location || (lhs.location == rhs.location && lhs.ident < rhs.ident));
+        }
+    );
+
+    s += title + '{';
+    for (const auto& slot : slots)
+        s += slot.ident + '@' + std::to_string(slot.location) + ';';
+    s += '}';
+}
+
+/* Appends the canonical description of all packed varyings (independent of their order) */
+static void AppendPackedVaryings(std::string& s, const std::string& title, std::vector<PackedVarying> varyings)
+{
+    std::sort(
+        varyings.begin(), varyings.end(),
+        [](const PackedVarying& lhs, const PackedVarying& rhs)
+        {
+            return (lhs.semantic < rhs.semantic);
+        }
+    );
+
+    s += title + '{';
+    for (const auto& v : varyings)
+    {
+        s += v.semantic + '@' + v.slotIdent + ':' + std::to_string(v.slot) + '.';
+        s += std::to_string(v.firstComponent) + '.' + std::to_string(v.numComponents) + ';';
+    }
+    s += '}';
+}
+
+/* Appends the canonical description of all identifiers (independent of their order) */
+static void AppendIdents(std::string& s, const std::string& title, std::vector<std::string> idents)
+{
+    std::sort(idents.begin(), idents.end());
+
+    s += title + '{';
+    for (const auto& ident : idents)
+        s += ident + ';';
+    s += '}';
+}
+
+static std::uint64_t HashVertexInput(const ReflectionData& vertexStage)
+{
+    std::string s;
+    AppendBindingSlots(s, "in", vertexStage.inputAttributes);
+    return HashString(s);
+}
+
+static std::uint64_t HashStageInterface(const ReflectionData& prevStage, const ReflectionData& nextStage)
+{
+    std::string s;
+    AppendBindingSlots(s, "out", prevStage.outputAttributes);
+    AppendPackedVaryings(s, "packed_out", prevStage.packedOutputs);
+    AppendIdents(s, "flat_out", prevStage.flatOutputs);
+    AppendBindingSlots(s, "in", nextStage.inputAttributes);
+    AppendPackedVaryings(s, "packed_in", nextStage.packedInputs);
+    return HashString(s);
+}
+
+static std::uint64_t HashResourceLayout(const std::vector<PipelineBinding>& bindings)
+{
+    /* Bindings are already ordered by type, location, and identifier */
+    std::string s;
+    for (const auto& binding : bindings)
+        s += ToString(binding.type) + ':' + binding.ident + '@' + std::to_string(binding.location) + '/' + std::to_string(binding.stages) + ';';
+    return HashString(s);
+}
+
+
+/*
+ * Global functions
+ */
+
+XSC_EXPORT std::string ToString(const Reflection::BindingType t)
+{
+    switch (t)
+    {
+        case Reflection::BindingType::Texture:          return "texture";
+        case Reflection::BindingType::StorageBuffer:    return "storage buffer";
+        case Reflection::BindingType::ConstantBuffer:   return "constant buffer";
+    }
+    return "";
+}
+
+XSC_EXPORT unsigned int ShaderTargetToStageFlag(const ShaderTarget target)
+{
+    switch (target)
+    {
+        case ShaderTarget::Undefined:                       return 0;
+        case ShaderTarget::VertexShader:                    return StageFlags::Vertex;
+        case ShaderTarget::TessellationControlShader:       return StageFlags::TessellationControl;
+        case ShaderTarget::TessellationEvaluationShader:    return StageFlags::TessellationEvaluation;
+        case ShaderTarget::GeometryShader:                  return StageFlags::Geometry;
+        case ShaderTarget::FragmentShader:                  return StageFlags::Fragment;
+        case ShaderTarget::ComputeShader:                   return StageFlags::Compute;
+    }
+    return 0;
+}
+
+XSC_EXPORT bool MergeReflection(const std::vector<PipelineStage>& stages, PipelineLayout& layout, Log* log)
+{
+    /* Validate arguments */
+    for (const auto& stage : stages)
+    {
+        if (stage.target == ShaderTarget::Undefined)
+            throw std::invalid_argument(R_PipelineStageCantBeUndefined);
+        if (!stage.reflectionData)
+            throw std::invalid_argument(R_PipelineReflectionCantBeNull);
+    }
+
+    /* Sort stages in pipeline order, so the result is independent of the order they have been specified */
+    auto sortedStages = stages;
+
+    std::stable_sort(
+        sortedStages.begin(), sortedStages.end(),
+        [](const PipelineStage& lhs, const PipelineStage& rhs)
+        {
+            return (lhs.target < rhs.target);
+        }
+    );
+
+    layout = PipelineLayout();
+
+    bool result = true;
+
+    for (std::size_t i = 1; i < sortedStages.size(); ++i)
+    {
+        if (sortedStages[i].target == sortedStages[i - 1].target)
+        {
+            SubmitConflict(log, R_DuplicatePipelineStage(ToString(sortedStages[i].target)));
+            result = false;
+        }
+    }
+
+    if (sortedStages.size() > 1 && sortedStages.back().target == ShaderTarget::ComputeShader)
+    {
+        SubmitConflict(log, R_ComputeStageWithOtherStages);
+        result = false;
+    }
+
+    /* Gather bindings of all stages */
+    struct StageBinding
+    {
+        BindingType         type;
+        const BindingSlot*  slot;
+        ShaderTarget        target;
+    };
+
+    std::vector<StageBinding> stageBindings;
+
+    for (const auto& stage : sortedStages)
+    {
+        for (const auto& slot : stage.reflectionData->textures)
+            stageBindings.push_back({ BindingType::Texture, &slot, stage.target });
+        for (const auto& slot : stage.reflectionData->storageBuffers)
+            stageBindings.push_back({ BindingType::StorageBuffer, &slot, stage.target });
+        for (const auto& slot : stage.reflectionData->constantBuffers)
+            stageBindings.push_back({ BindingType::ConstantBuffer, &slot, stage.target });
+    }
+
+    /* Diagnose conflicting bindings of the same type between different stages */
+    for (std::size_t i = 0; i < stageBindings.size(); ++i)
+    {
+        const auto& lhs = stageBindings[i];
+        for (std::size_t j = i + 1; j < stageBindings.size(); ++j)
+        {
+            const auto& rhs = stageBindings[j];
+            if (lhs.type != rhs.type || lhs.target == rhs.target)
+                continue;
+
+            if (lhs.slot->ident == rhs.slot->ident && lhs.slot->location != rhs.slot->location)
+            {
+                SubmitConflict(
+                    log,
+                    R_ConflictingBindingLocations(
+                        ToString(lhs.type), lhs.slot->ident,
+                        lhs.slot->location, ToString(lhs.target),
+                        rhs.slot->location, ToString(rhs.target)
+                    )
+                );
+                result = false;
+            }
+            else if (lhs.slot->ident != rhs.slot->ident && lhs.slot->location == rhs.slot->location && lhs.slot->location >= 0)
+            {
+                SubmitConflict(
+                    log,
+                    R_OverlappingBindingLocations(
+                        lhs.slot->location, ToString(lhs.type),
+                        lhs.slot->ident, ToString(lhs.target),
+                        rhs.slot->ident, ToString(rhs.target)
+                    )
+                );
+                result = false;
+            }
+        }
+    }
+
+    /* Merge bindings with equal type, identifier, and location into a single binding that is visible to all of their stages */
+    for (const auto& stageBinding : stageBindings)
+    {
+        auto it = std::find_if(
+            layout.bindings.begin(), layout.bindings.end(),
+            [&stageBinding](const PipelineBinding& binding)
+            {
+                return
+                (
+                    binding.type        == stageBinding.type        &&
+                    binding.ident       == stageBinding.slot->ident &&
+                    binding.location    == stageBinding.slot->location
+                );
+            }
+        );
+
+        if (it == layout.bindings.end())
+        {
+            PipelineBinding binding;
+            {
+                binding.type        = stageBinding.type;
+                binding.ident       = stageBinding.slot->ident;
+                binding.location    = stageBinding.slot->location;
+            }
+            it = layout.bindings.insert(layout.bindings.end(), binding);
+        }
+
+        it->stages |= ShaderTargetToStageFlag(stageBinding.target);
+    }
+
+    std::sort(
+        layout.bindings.begin(), layout.bindings.end(),
+        [](const PipelineBinding& lhs, const PipelineBinding& rhs)
+        {
+            if (lhs.type != rhs.type)
+                return (lhs.type < rhs.type);
+            if (lhs.location != rhs.location)
+                return (lhs.location < rhs.location);
+            return (lhs.ident < rhs.ident);
+        }
+    );
+
+    /* Diagnose inputs that are not written by the previous stage, and hash each stage-to-stage interface */
+    for (std::size_t i = 1; i < sortedStages.size(); ++i)
+    {
+        const auto& prevStage = sortedStages[i - 1];
+        const auto& nextStage = sortedStages[i];
+
+        /* Inputs of tessellation-evaluation shaders also include the patch constants, which are not reflected as outputs */
+        if (nextStage.target != ShaderTarget::TessellationEvaluationShader)
+        {
+            const auto& outputs = prevStage.reflectionData->outputAttributes;
+            for (const auto& input : nextStage.reflectionData->inputAttributes)
+            {
+                if (IsSystemValueAttribute(input.ident))
+                    continue;
+
+                auto it = std::find_if(
+                    outputs.begin(), outputs.end(),
+                    [&input](const BindingSlot& output)
+                    {
+                        return (output.ident == input.ident);
+                    }
+                );
+
+                if (it == outputs.end())
+                {
+                    SubmitConflict(log, R_UnmatchedStageInput(input.ident, ToString(nextStage.target), ToString(prevStage.target)));
+                    result = false;
+                }
+            }
+        }
+
+        /* Packed inputs must be read from the same slot components the previous stage has written them to */
+        const auto& packedOutputs = prevStage.reflectionData->packedOutputs;
+        for (const auto& input : nextStage.reflectionData->packedInputs)
+        {
+            auto it = std::find_if(
+                packedOutputs.begin(), packedOutputs.end(),
+                [&input](const PackedVarying& output)
+                {
+                    return
+                    (
+                        ToUpper(output.semantic) == ToUpper(input.semantic) &&
+                        output.slot == input.slot &&
+                        output.firstComponent == input.firstComponent &&
+                        output.numComponents >= input.numComponents
+                    );
+                }
+            );
+
+            if (it == packedOutputs.end())
+            {
+                SubmitConflict(log, R_UnmatchedPackedInput(input.semantic, ToString(nextStage.target), ToString(prevStage.target)));
+                result = false;
+            }
+        }
+
+        layout.stageInterfaceHashes.push_back(HashStageInterface(*prevStage.reflectionData, *nextStage.reflectionData));
+    }
+
+    /* Hash vertex input interface and resource layout */
+    if (!sortedStages.empty() && sortedStages.front().target == ShaderTarget::VertexShader)
+        layout.vertexInputHash = HashVertexInput(*sortedStages.front().reflectionData);
+
+    layout.resourceLayoutHash = HashResourceLayout(layout.bindings);
+
+    return result;
+}
+
+XSC_EXPORT void PrintPipelineLayout(std::ostream& stream, const Reflection::PipelineLayout& layout)
+{
+    ReflectionPrinter printer(stream);
+    printer.PrintPipelineLayout(layout);
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
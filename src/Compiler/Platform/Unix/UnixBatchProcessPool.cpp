@@ -0,0 +1,417 @@
+/*
+ * UnixBatchProcessPool.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "BatchProcessPool.h"
+#include <vector>
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+
+namespace Xsc
+{
+
+
+/*
+ * Internal members
+ */
+
+// Maximum number of attempts to send a job to a (restarted) worker process.
+static const int g_maxDispatchAttempts = 3;
+
+struct WorkerProcess
+{
+    pid_t       pid         = -1;
+    int         jobPipe     = -1;   // Write end of the job pipe (parent -> worker)
+    int         resultPipe  = -1;   // Read end of the result pipe (worker -> parent)
+    bool        busy        = false;
+    std::size_t jobIndex    = 0;
+    std::string buffer;
+};
+
+/*
+Blocks SIGPIPE for the calling thread only, so writing to a crashed worker fails with EPIPE instead of terminating this process.
+The process-wide signal disposition is not changed, since other threads of the host application may rely on it.
+*/
+class ScopedSigPipeBlock
+{
+
+    public:
+
+        ScopedSigPipeBlock()
+        {
+            ::sigemptyset(&sigPipeSet_);
+            ::sigaddset(&sigPipeSet_, SIGPIPE);
+
+            /* Don't drain a SIGPIPE that was pending before */
+            sigset_t pendingSet;
+            ::sigemptyset(&pendingSet);
+            ::sigpending(&pendingSet);
+            wasPending_ = (::sigismember(&pendingSet, SIGPIPE) == 1);
+
+            ::pthread_sigmask(SIG_BLOCK, &sigPipeSet_, &prevSet_);
+        }
+
+        ~ScopedSigPipeBlock()
+        {
+            /* Drain the SIGPIPE that has been generated by writing to a crashed worker, before it is unblocked again */
+            if (!wasPending_)
+            {
+                const struct timespec timeout = { 0, 0 };
+                while (::sigtimedwait(&sigPipeSet_, nullptr, &timeout) < 0 && errno == EINTR);
+            }
+
+            ::pthread_sigmask(SIG_SETMASK, &prevSet_, nullptr);
+        }
+
+    private:
+
+        sigset_t    sigPipeSet_;
+        sigset_t    prevSet_;
+        bool        wasPending_ = false;
+
+};
+
+static void ClosePipe(int& fd)
+{
+    if (fd != -1)
+    {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+static bool WriteAll(int fd, const void* data, std::size_t size)
+{
+    auto bytes = reinterpret_cast<const char*>(data);
+    while (size > 0)
+    {
+        auto written = ::write(fd, bytes, size);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+static bool ReadAll(int fd, void* data, std::size_t size)
+{
+    auto bytes = reinterpret_cast<char*>(data);
+    while (size > 0)
+    {
+        auto received = ::read(fd, bytes, size);
+        if (received < 0 && errno == EINTR)
+            continue;
+        if (received <= 0)
+            return false;
+        bytes += received;
+        size -= static_cast<std::size_t>(received);
+    }
+    return true;
+}
+
+/* Main loop of a worker process: receives job indices and sends back the serialized results until the job pipe is closed */
+[[noreturn]]
+static void WorkerProcessMain(int jobPipe, int resultPipe, const BatchProcessJobFunction& jobFunc)
+{
+    std::uint64_t jobIndex = 0;
+
+    while (ReadAll(jobPipe, &jobIndex, sizeof(jobIndex)))
+    {
+        auto result = jobFunc(static_cast<std::size_t>(jobIndex));
+        auto size   = static_cast<std::uint64_t>(result.size());
+
+        if (!WriteAll(resultPipe, &size, sizeof(size)) || !WriteAll(resultPipe, result.data(), result.size()))
+            break;
+    }
+
+    /* Leave without any cleanup of the parent process state (e.g. flushing the copied standard output buffers) */
+    ::_exit(0);
+}
+
+static void SpawnWorkerProcess(WorkerProcess& worker, std::vector<WorkerProcess>& workers, const BatchProcessJobFunction& jobFunc)
+{
+    int jobFds[2], resultFds[2];
+
+    if (::pipe(jobFds) != 0)
+        throw std::runtime_error("failed to create pipe for batch worker process");
+
+    if (::pipe(resultFds) != 0)
+    {
+        ::close(jobFds[0]);
+        ::close(jobFds[1]);
+        throw std::runtime_error("failed to create pipe for batch worker process");
+    }
+
+    auto pid = ::fork();
+
+    if (pid == 0)
+    {
+        /* Close all pipes of the other workers, otherwise the parent can not detect when they crash */
+        for (auto& other : workers)
+        {
+            ClosePipe(other.jobPipe);
+            ClosePipe(other.resultPipe);
+        }
+
+        ::close(jobFds[1]);
+        ::close(resultFds[0]);
+
+        WorkerProcessMain(jobFds[0], resultFds[1], jobFunc);
+    }
+
+    ::close(jobFds[0]);
+    ::close(resultFds[1]);
+
+    if (pid < 0)
+    {
+        ::close(jobFds[1]);
+        ::close(resultFds[0]);
+        throw std::runtime_error("failed to fork batch worker process");
+    }
+
+    worker.pid          = pid;
+    worker.jobPipe      = jobFds[1];
+    worker.resultPipe   = resultFds[0];
+    worker.busy         = false;
+    worker.buffer.clear();
+}
+
+/* Closes the pipes of the specified worker process and waits until it has terminated; returns the termination reason */
+static std::string TerminateWorkerProcess(WorkerProcess& worker)
+{
+    ClosePipe(worker.jobPipe);
+    ClosePipe(worker.resultPipe);
+
+    std::string reason;
+
+    if (worker.pid > 0)
+    {
+        int status = 0;
+        while (::waitpid(worker.pid, &status, 0) < 0 && errno == EINTR);
+
+        if (WIFSIGNALED(status))
+        {
+            auto sig = WTERMSIG(status);
+            reason = "signal " + std::to_string(sig);
+            if (auto sigName = ::strsignal(sig))
+                reason += " (" + std::string(sigName) + ")";
+        }
+        else if (WIFEXITED(status))
+            reason = "exit code " + std::to_string(WEXITSTATUS(status));
+
+        worker.pid = -1;
+    }
+
+    return reason;
+}
+
+/* Sends the next job to the specified worker, or closes its job pipe if there are no more jobs. Returns false if sending failed */
+static bool DispatchNextJob(BatchScheduler& scheduler, unsigned workerIndex, WorkerProcess& worker)
+{
+    std::size_t jobIndex = 0;
+
+    if (scheduler.NextJob(workerIndex, jobIndex))
+    {
+        worker.busy     = true;
+        worker.jobIndex = jobIndex;
+        worker.buffer.clear();
+
+        auto index = static_cast<std::uint64_t>(jobIndex);
+        return WriteAll(worker.jobPipe, &index, sizeof(index));
+    }
+
+    /* Let worker process leave its main loop */
+    worker.busy = false;
+    ClosePipe(worker.jobPipe);
+
+    return true;
+}
+
+/* Returns true if the buffer of the specified worker contains a complete result */
+static bool ExtractResult(WorkerProcess& worker, std::string& result)
+{
+    std::uint64_t size = 0;
+
+    if (worker.buffer.size() < sizeof(size))
+        return false;
+
+    std::memcpy(&size, worker.buffer.data(), sizeof(size));
+
+    if (worker.buffer.size() < sizeof(size) + size)
+        return false;
+
+    result = worker.buffer.substr(sizeof(size), static_cast<std::size_t>(size));
+    worker.buffer.clear();
+
+    return true;
+}
+
+
+/*
+ * Global functions
+ */
+
+bool IsBatchProcessPoolSupported()
+{
+    return true;
+}
+
+std::size_t RunBatchProcessPool(
+    BatchScheduler& scheduler, const BatchProcessJobFunction& jobFunc, const BatchProcessResultFunction& resultFunc)
+{
+    const auto numWorkers = scheduler.NumWorkers();
+
+    std::vector<WorkerProcess> workers(numWorkers);
+    std::size_t numRestarts = 0;
+
+    /* Block SIGPIPE while dispatching jobs, so writing to a crashed worker does not terminate this process */
+    ScopedSigPipeBlock sigPipeBlock;
+
+    auto RestartWorker = [&](WorkerProcess& worker)
+    {
+        auto reason = TerminateWorkerProcess(worker);
+        SpawnWorkerProcess(worker, workers, jobFunc);
+        ++numRestarts;
+        return reason;
+    };
+
+    /*
+    Dispatches the next job to the specified worker. If the job could not be sent, the worker process has left before it received the job,
+    so the job is not reported as crashed, but scheduled again on the restarted worker process
+    */
+    auto Dispatch = [&](unsigned workerIndex)
+    {
+        auto& worker = workers[workerIndex];
+
+        for (int attempt = 0; !DispatchNextJob(scheduler, workerIndex, worker); ++attempt)
+        {
+            if (attempt + 1 >= g_maxDispatchAttempts)
+                throw std::runtime_error("failed to send job to batch worker process");
+
+            scheduler.RequeueJob(workerIndex, worker.jobIndex);
+            RestartWorker(worker);
+        }
+    };
+
+    auto HandleCrash = [&](unsigned workerIndex)
+    {
+        auto& worker = workers[workerIndex];
+        auto jobIndex = worker.jobIndex;
+        auto crash = RestartWorker(worker);
+
+        resultFunc(workerIndex, jobIndex, "", (crash.empty() ? "unknown" : crash));
+
+        Dispatch(workerIndex);
+    };
+
+    try
+    {
+        /* Pre-fork all worker processes before any job is dispatched */
+        for (auto& worker : workers)
+            SpawnWorkerProcess(worker, workers, jobFunc);
+
+        for (unsigned i = 0; i < numWorkers; ++i)
+            Dispatch(i);
+
+        std::vector<pollfd>     pollFds;
+        std::vector<unsigned>   pollWorkers;
+        std::vector<char>       readBuffer(1 << 16);
+
+        while (true)
+        {
+            /* Wait for results of all busy workers */
+            pollFds.clear();
+            pollWorkers.clear();
+
+            for (unsigned i = 0; i < numWorkers; ++i)
+            {
+                if (workers[i].busy)
+                {
+                    pollFds.push_back({ workers[i].resultPipe, POLLIN, 0 });
+                    pollWorkers.push_back(i);
+                }
+            }
+
+            if (pollFds.empty())
+                break;
+
+            if (::poll(pollFds.data(), static_cast<nfds_t>(pollFds.size()), -1) < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                throw std::runtime_error("failed to poll batch worker processes");
+            }
+
+            for (std::size_t i = 0; i < pollFds.size(); ++i)
+            {
+                if (pollFds[i].revents == 0)
+                    continue;
+
+                auto  workerIndex   = pollWorkers[i];
+                auto& worker        = workers[workerIndex];
+
+                auto received = ::read(worker.resultPipe, readBuffer.data(), readBuffer.size());
+                if (received < 0 && errno == EINTR)
+                    continue;
+
+                if (received <= 0)
+                {
+                    /* Worker process crashed (or left) before its result was complete */
+                    HandleCrash(workerIndex);
+                }
+                else
+                {
+                    worker.buffer.append(readBuffer.data(), static_cast<std::size_t>(received));
+
+                    std::string result;
+                    if (ExtractResult(worker, result))
+                    {
+                        resultFunc(workerIndex, worker.jobIndex, result, "");
+                        Dispatch(workerIndex);
+                    }
+                }
+            }
+        }
+    }
+    catch (...)
+    {
+        for (auto& worker : workers)
+        {
+            if (worker.pid > 0)
+                ::kill(worker.pid, SIGKILL);
+            TerminateWorkerProcess(worker);
+        }
+        throw;
+    }
+
+    /* Wait until all worker processes have terminated */
+    for (auto& worker : workers)
+        TerminateWorkerProcess(worker);
+
+    return numRestarts;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
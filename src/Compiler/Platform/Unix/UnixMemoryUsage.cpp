@@ -0,0 +1,107 @@
+/*
+ * UnixMemoryUsage.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MemoryUsage.h"
+#include <fstream>
+#include <string>
+#include <algorithm>
+#include <limits>
+#include <unistd.h>
+#include <sys/resource.h>
+
+
+namespace Xsc
+{
+
+
+// Reads the "VmHWM" and "VmRSS" entries (in kilobytes) from "/proc/self/status", and returns false if they are not available.
+static bool QueryProcStatus(MemoryUsage& usage)
+{
+    std::ifstream status("/proc/self/status");
+    if (!status.good())
+        return false;
+
+    bool hasPeak = false, hasResident = false;
+
+    std::string key;
+    std::size_t value = 0;
+
+    while (status >> key)
+    {
+        if (key == "VmHWM:" && status >> value)
+        {
+            usage.peakBytes = value * 1024;
+            hasPeak = true;
+        }
+        else if (key == "VmRSS:" && status >> value)
+        {
+            usage.residentBytes = value * 1024;
+            hasResident = true;
+        }
+        status.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+
+    return (hasPeak && hasResident);
+}
+
+MemoryUsage QueryMemoryUsage()
+{
+    MemoryUsage usage;
+
+    /* Prefer the process status, since its high-water mark can be reset (see ResetPeakMemoryUsage) */
+    if (QueryProcStatus(usage))
+        return usage;
+
+    /* Query high-water mark of resident memory ('ru_maxrss' is in bytes on macOS, but in kilobytes otherwise) */
+    struct rusage resUsage;
+    if (::getrusage(RUSAGE_SELF, &resUsage) == 0)
+    {
+        #ifdef __APPLE__
+        usage.peakBytes = static_cast<std::size_t>(resUsage.ru_maxrss);
+        #else
+        usage.peakBytes = static_cast<std::size_t>(resUsage.ru_maxrss) * 1024;
+        #endif
+    }
+
+    /* Query current resident memory (second value of "statm" in pages) */
+    std::ifstream statm("/proc/self/statm");
+    std::size_t totalPages = 0, residentPages = 0;
+    if (statm >> totalPages >> residentPages)
+        usage.residentBytes = residentPages * static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    else
+        usage.residentBytes = usage.peakBytes;
+
+    /* High-water mark might not have been updated yet */
+    usage.peakBytes = std::max(usage.peakBytes, usage.residentBytes);
+
+    return usage;
+}
+
+bool ResetPeakMemoryUsage()
+{
+    #ifdef __linux__
+
+    /* Writing "5" to "clear_refs" resets the high-water mark "VmHWM" to the current resident memory (since Linux 4.0) */
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    if (clearRefs.good())
+    {
+        clearRefs << "5";
+        clearRefs.flush();
+        return clearRefs.good();
+    }
+
+    #endif
+
+    return false;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,32 @@
+/*
+ * Win32BatchProcessPool.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "BatchProcessPool.h"
+#include <stdexcept>
+
+
+namespace Xsc
+{
+
+
+bool IsBatchProcessPoolSupported()
+{
+    return false;
+}
+
+std::size_t RunBatchProcessPool(
+    BatchScheduler& scheduler, const BatchProcessJobFunction& jobFunc, const BatchProcessResultFunction& resultFunc)
+{
+    throw std::runtime_error("crash-isolated worker processes are not supported on this platform");
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
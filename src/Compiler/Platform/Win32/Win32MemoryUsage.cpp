@@ -0,0 +1,42 @@
+/*
+ * Win32MemoryUsage.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MemoryUsage.h"
+#include <Windows.h>
+#include <Psapi.h>
+
+
+namespace Xsc
+{
+
+
+MemoryUsage QueryMemoryUsage()
+{
+    MemoryUsage usage;
+
+    PROCESS_MEMORY_COUNTERS counters;
+    if (::GetProcessMemoryInfo(::GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        usage.residentBytes = static_cast<std::size_t>(counters.WorkingSetSize);
+        usage.peakBytes     = static_cast<std::size_t>(counters.PeakWorkingSetSize);
+    }
+
+    return usage;
+}
+
+bool ResetPeakMemoryUsage()
+{
+    /* The peak working set size can not be reset on Windows */
+    return false;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
@@ -0,0 +1,237 @@
+/*
+ * ProgramBuilder.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <Xsc/ProgramBuilder.h>
+#include "HLSLProgramBuilder.h"
+#include <sstream>
+#include <limits>
+#include <cstdlib>
+
+
+namespace Xsc
+{
+
+
+// Returns the shortest string of the specified value that is parsed again to the same single-precision value (e.g. "0.3" instead of "0.300000011920929").
+static std::string FloatToString(float value)
+{
+    std::string s;
+
+    for (int precision = std::numeric_limits<float>::digits10; precision <= std::numeric_limits<float>::max_digits10; ++precision)
+    {
+        std::ostringstream stream;
+        stream.precision(precision);
+        stream << value;
+        s = stream.str();
+        if (std::strtof(s.c_str(), nullptr) == value)
+            break;
+    }
+
+    /* Always append fractional part, so the literal is not interpreted as integer */
+    if (s.find_first_of(".eE") == std::string::npos)
+        s += ".0";
+
+    return s;
+}
+
+ProgramBuilder::ProgramBuilder() :
+    builder_ { new HLSLProgramBuilder() }
+{
+}
+
+ProgramBuilder::~ProgramBuilder()
+{
+    delete builder_;
+}
+
+void ProgramBuilder::SetSource(const std::string& sourceIdent, unsigned int row, unsigned int column)
+{
+    builder_->SetSource(sourceIdent, row, column);
+}
+
+/* ----- Declarations ----- */
+
+void ProgramBuilder::BeginStruct(const std::string& ident)
+{
+    builder_->BeginStruct(ident);
+}
+
+void ProgramBuilder::EndStruct()
+{
+    builder_->EndStruct();
+}
+
+void ProgramBuilder::BeginConstantBuffer(const std::string& ident, int slot)
+{
+    builder_->BeginConstantBuffer(ident, slot);
+}
+
+void ProgramBuilder::EndConstantBuffer()
+{
+    builder_->EndConstantBuffer();
+}
+
+void ProgramBuilder::DeclareVariable(const std::string& type, const std::string& ident, const std::string& semantic, Expr initializer)
+{
+    builder_->DeclareVariable(type, ident, semantic, initializer);
+}
+
+void ProgramBuilder::DeclareResource(const std::string& type, const std::string& ident, int slot)
+{
+    builder_->DeclareResource(type, ident, slot);
+}
+
+void ProgramBuilder::BeginFunction(const std::string& returnType, const std::string& ident, const std::string& semantic)
+{
+    builder_->BeginFunction(returnType, ident, semantic);
+}
+
+void ProgramBuilder::DeclareParameter(const std::string& type, const std::string& ident, const std::string& semantic)
+{
+    builder_->DeclareParameter(type, ident, semantic);
+}
+
+void ProgramBuilder::EndFunction()
+{
+    builder_->EndFunction();
+}
+
+/* ----- Statements ----- */
+
+void ProgramBuilder::Assign(Expr lhs, Expr rhs, const std::string& op)
+{
+    builder_->Assign(lhs, rhs, op);
+}
+
+void ProgramBuilder::Evaluate(Expr expr)
+{
+    builder_->Evaluate(expr);
+}
+
+void ProgramBuilder::Return(Expr expr)
+{
+    builder_->Return(expr);
+}
+
+void ProgramBuilder::Discard()
+{
+    builder_->CtrlTransfer("discard");
+}
+
+void ProgramBuilder::Break()
+{
+    builder_->CtrlTransfer("break");
+}
+
+void ProgramBuilder::Continue()
+{
+    builder_->CtrlTransfer("continue");
+}
+
+void ProgramBuilder::BeginIf(Expr condition)
+{
+    builder_->BeginIf(condition);
+}
+
+void ProgramBuilder::BeginElse()
+{
+    builder_->BeginElse();
+}
+
+void ProgramBuilder::EndIf()
+{
+    builder_->EndIf();
+}
+
+void ProgramBuilder::BeginFor(const std::string& type, const std::string& ident, Expr initializer, Expr condition, Expr iteration)
+{
+    builder_->BeginFor(type, ident, initializer, condition, iteration);
+}
+
+void ProgramBuilder::EndFor()
+{
+    builder_->EndFor();
+}
+
+/* ----- Expressions ----- */
+
+ProgramBuilder::Expr ProgramBuilder::Literal(bool value)
+{
+    return builder_->Literal(DataType::Bool, (value ? "true" : "false"));
+}
+
+ProgramBuilder::Expr ProgramBuilder::Literal(int value)
+{
+    return builder_->Literal(DataType::Int, std::to_string(value));
+}
+
+ProgramBuilder::Expr ProgramBuilder::Literal(unsigned int value)
+{
+    return builder_->Literal(DataType::UInt, std::to_string(value) + "u");
+}
+
+ProgramBuilder::Expr ProgramBuilder::Literal(float value)
+{
+    return builder_->Literal(DataType::Float, FloatToString(value));
+}
+
+ProgramBuilder::Expr ProgramBuilder::Var(const std::string& ident)
+{
+    return builder_->Var(ident);
+}
+
+ProgramBuilder::Expr ProgramBuilder::Member(Expr object, const std::string& ident)
+{
+    return builder_->Member(object, ident);
+}
+
+ProgramBuilder::Expr ProgramBuilder::Index(Expr object, Expr index)
+{
+    return builder_->Index(object, index);
+}
+
+ProgramBuilder::Expr ProgramBuilder::Unary(const std::string& op, Expr expr)
+{
+    return builder_->Unary(op, expr);
+}
+
+ProgramBuilder::Expr ProgramBuilder::Binary(Expr lhs, const std::string& op, Expr rhs)
+{
+    return builder_->Binary(lhs, op, rhs);
+}
+
+ProgramBuilder::Expr ProgramBuilder::Ternary(Expr condition, Expr thenExpr, Expr elseExpr)
+{
+    return builder_->Ternary(condition, thenExpr, elseExpr);
+}
+
+ProgramBuilder::Expr ProgramBuilder::Call(const std::string& ident, const std::vector<Expr>& args)
+{
+    return builder_->Call(ident, args);
+}
+
+ProgramBuilder::Expr ProgramBuilder::MethodCall(Expr object, const std::string& ident, const std::vector<Expr>& args)
+{
+    return builder_->MethodCall(object, ident, args);
+}
+
+ProgramBuilder::Expr ProgramBuilder::Construct(const std::string& type, const std::vector<Expr>& args)
+{
+    return builder_->Construct(type, args);
+}
+
+ProgramBuilder::Expr ProgramBuilder::Cast(const std::string& type, Expr expr)
+{
+    return builder_->Cast(type, expr);
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
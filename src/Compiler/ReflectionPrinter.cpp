@@ -8,6 +8,7 @@
 #include "ReflectionPrinter.h"
 #include "ReportIdents.h"
 #include <algorithm>
+#include <iomanip>
 
 
 namespace Xsc
@@ -32,10 +33,81 @@ void ReflectionPrinter::PrintReflection(const Reflection::ReflectionData& reflec
         PrintReflectionObjects  ( reflectionData.outputAttributes, "Output Attributes" );
         PrintReflectionObjects  ( reflectionData.samplerStates,    "Sampler States"    );
         PrintReflectionAttribute( reflectionData.numThreads,       "Number of Threads" );
+
+        if (!reflectionData.packedInputs.empty())
+            PrintReflectionObjects(reflectionData.packedInputs, "Packed Inputs");
+        if (!reflectionData.packedOutputs.empty())
+            PrintReflectionObjects(reflectionData.packedOutputs, "Packed Outputs");
+        if (!reflectionData.flatOutputs.empty())
+            PrintReflectionObjects(reflectionData.flatOutputs, "Flat Outputs");
+
+        if (!reflectionData.resourceAccesses.empty())
+            PrintReflectionObjects(reflectionData.resourceAccesses, "Resource Accesses");
+
+        if (!reflectionData.bufferClasses.empty())
+            PrintReflectionObjects(reflectionData.bufferClasses, "Buffer Classes");
+
+        if (!reflectionData.preshaderBuffer.empty())
+            PrintReflectionPreshaders(reflectionData, "Preshaders");
+
+        if (!reflectionData.constantTableBuffer.empty())
+            PrintReflectionConstantTables(reflectionData, "Constant Tables");
+
+        if (!reflectionData.profileCounterBuffer.ident.empty())
+            PrintReflectionProfileCounters(reflectionData, "Profile Counters");
     }
     indentHandler_.DecIndent();
 }
 
+void ReflectionPrinter::PrintPipelineLayout(const Reflection::PipelineLayout& layout)
+{
+    output_ << R_PipelineLayout() << ':' << std::endl;
+    ScopedIndent indent(indentHandler_);
+
+    IndentOut() << "Bindings:" << std::endl;
+    {
+        ScopedIndent indent(indentHandler_);
+        if (!layout.bindings.empty())
+        {
+            for (const auto& binding : layout.bindings)
+            {
+                IndentOut() << ToString(binding.type) << ' ' << binding.ident;
+                if (binding.location >= 0)
+                    output_ << " @ " << binding.location;
+
+                /* Print stage visibility in pipeline order */
+                output_ << " (";
+                auto stages = binding.stages;
+                for (const auto& stage : { "vert", "tesc", "tese", "geom", "frag", "comp" })
+                {
+                    if ((stages & 1u) != 0)
+                        output_ << stage << ((stages >> 1) != 0 ? ", " : "");
+                    stages >>= 1;
+                }
+                output_ << ')' << std::endl;
+            }
+        }
+        else
+            IndentOut() << "< none >" << std::endl;
+    }
+
+    IndentOut() << "Hashes:" << std::endl;
+    {
+        ScopedIndent indent(indentHandler_);
+
+        auto PrintHash = [this](const std::string& title, std::uint64_t hash)
+        {
+            IndentOut() << std::left << std::setw(17) << title << std::right << " = ";
+            output_ << std::hex << std::setw(16) << std::setfill('0') << hash << std::dec << std::setfill(' ') << std::endl;
+        };
+
+        PrintHash("Vertex Input", layout.vertexInputHash);
+        for (std::size_t i = 0; i < layout.stageInterfaceHashes.size(); ++i)
+            PrintHash("Stage Interface " + std::to_string(i), layout.stageInterfaceHashes[i]);
+        PrintHash("Resource Layout", layout.resourceLayoutHash);
+    }
+}
+
 
 /*
  * ======= Private: =======
@@ -125,6 +197,69 @@ void ReflectionPrinter::PrintReflectionObjects(const std::map<std::string, Refle
         IndentOut() << "< none >" << std::endl;
 }
 
+void ReflectionPrinter::PrintReflectionObjects(const std::vector<Reflection::PackedVarying>& packedVaryings, const std::string& title)
+{
+    IndentOut() << title << ':' << std::endl;
+    ScopedIndent indent(indentHandler_);
+
+    for (const auto& packedVarying : packedVaryings)
+    {
+        IndentOut() << packedVarying.slot << ": " << packedVarying.slotIdent;
+        output_ << '.' << std::string("xyzw").substr(packedVarying.firstComponent, packedVarying.numComponents);
+        output_ << " = " << packedVarying.semantic << std::endl;
+    }
+}
+
+void ReflectionPrinter::PrintReflectionObjects(const std::vector<Reflection::ResourceAccess>& resourceAccesses, const std::string& title)
+{
+    IndentOut() << title << ':' << std::endl;
+    ScopedIndent indent(indentHandler_);
+
+    for (const auto& access : resourceAccesses)
+    {
+        std::vector<std::string> modes;
+        {
+            if (access.read)
+                modes.push_back("read");
+            if (access.written)
+                modes.push_back("write");
+            if (access.atomic)
+                modes.push_back("atomic");
+            if (modes.empty())
+                modes.push_back("unused");
+        }
+
+        IndentOut() << access.ident << ": ";
+        for (std::size_t i = 0; i < modes.size(); ++i)
+            output_ << (i > 0 ? ", " : "") << modes[i];
+
+        if (access.divergent)
+            output_ << " (divergent)";
+
+        output_ << std::endl;
+    }
+}
+
+void ReflectionPrinter::PrintReflectionObjects(const std::vector<Reflection::BufferClass>& bufferClasses, const std::string& title)
+{
+    IndentOut() << title << ':' << std::endl;
+    ScopedIndent indent(indentHandler_);
+
+    for (const auto& bufferClass : bufferClasses)
+    {
+        IndentOut() << bufferClass.ident << ": " << ToString(bufferClass.storage);
+
+        if (bufferClass.storage == Reflection::BufferStorage::PushConstant)
+            output_ << " @ " << bufferClass.offset;
+        if (bufferClass.numElements > 0)
+            output_ << " [" << bufferClass.numElements << ']';
+        if (bufferClass.size > 0)
+            output_ << " (" << bufferClass.size << " bytes)";
+
+        output_ << std::endl;
+    }
+}
+
 void ReflectionPrinter::PrintReflectionAttribute(const Reflection::NumThreads& numThreads, const std::string& title)
 {
     IndentOut() << title << ':' << std::endl;
@@ -135,6 +270,107 @@ void ReflectionPrinter::PrintReflectionAttribute(const Reflection::NumThreads& n
     IndentOut() << "Z = " << numThreads.z << std::endl;
 }
 
+// Returns the infix notation of the specified preshader expression program.
+static std::string PreshaderToString(const std::vector<Reflection::PreshaderInstruction>& instrs)
+{
+    std::vector<std::string> stack;
+
+    auto PopOperands = [&stack](unsigned int numOperands)
+    {
+        numOperands = std::min(numOperands, static_cast<unsigned int>(stack.size()));
+        std::vector<std::string> operands(stack.end() - numOperands, stack.end());
+        stack.resize(stack.size() - numOperands);
+        return operands;
+    };
+
+    for (const auto& instr : instrs)
+    {
+        auto operands = PopOperands(instr.numOperands);
+
+        switch (instr.opcode)
+        {
+            case Reflection::PreshaderOpcode::Load:
+            case Reflection::PreshaderOpcode::Constant:
+                stack.push_back(instr.value);
+                break;
+
+            case Reflection::PreshaderOpcode::Unary:
+                stack.push_back(instr.value + (operands.empty() ? "" : operands[0]));
+                break;
+
+            case Reflection::PreshaderOpcode::Binary:
+                if (operands.size() == 2)
+                    stack.push_back('(' + operands[0] + ' ' + instr.value + ' ' + operands[1] + ')');
+                break;
+
+            case Reflection::PreshaderOpcode::Select:
+                if (operands.size() == 3)
+                    stack.push_back('(' + operands[0] + " ? " + operands[1] + " : " + operands[2] + ')');
+                break;
+
+            case Reflection::PreshaderOpcode::Swizzle:
+                stack.push_back((operands.empty() ? "" : operands[0]) + '.' + instr.value);
+                break;
+
+            case Reflection::PreshaderOpcode::Call:
+            case Reflection::PreshaderOpcode::Cast:
+            {
+                std::string s = instr.value + '(';
+                for (std::size_t i = 0; i < operands.size(); ++i)
+                    s += (i > 0 ? ", " : "") + operands[i];
+                stack.push_back(s + ')');
+            }
+            break;
+        }
+    }
+
+    return (stack.empty() ? "" : stack.back());
+}
+
+void ReflectionPrinter::PrintReflectionPreshaders(const Reflection::ReflectionData& reflectionData, const std::string& title)
+{
+    IndentOut() << title << " (" << reflectionData.preshaderBuffer << "):" << std::endl;
+    ScopedIndent indent(indentHandler_);
+
+    if (!reflectionData.preshaders.empty())
+    {
+        for (const auto& preshader : reflectionData.preshaders)
+            IndentOut() << preshader.type << ' ' << preshader.ident << " = " << PreshaderToString(preshader.instructions) << std::endl;
+    }
+    else
+        IndentOut() << "< none >" << std::endl;
+}
+
+void ReflectionPrinter::PrintReflectionConstantTables(const Reflection::ReflectionData& reflectionData, const std::string& title)
+{
+    IndentOut() << title << " (" << reflectionData.constantTableBuffer << ", " << reflectionData.constantTableData.size() << " bytes):" << std::endl;
+    ScopedIndent indent(indentHandler_);
+
+    for (const auto& table : reflectionData.constantTables)
+    {
+        IndentOut() << table.type << ' ' << table.ident << '[' << table.size << "] : offset = " << table.offset;
+        output_ << ", stride = " << table.stride << std::endl;
+    }
+}
+
+void ReflectionPrinter::PrintReflectionProfileCounters(const Reflection::ReflectionData& reflectionData, const std::string& title)
+{
+    const auto& buffer = reflectionData.profileCounterBuffer;
+
+    IndentOut() << title << " (" << buffer.ident;
+    if (buffer.location >= 0)
+        output_ << " @ " << buffer.location;
+    output_ << "):" << std::endl;
+
+    ScopedIndent indent(indentHandler_);
+
+    for (const auto& counter : reflectionData.profileCounters)
+    {
+        IndentOut() << '[' << counter.index << "] " << ToString(counter.type) << " in " << counter.function;
+        output_ << " (" << counter.location << ')' << std::endl;
+    }
+}
+
 
 } // /namespace Xsc
 
@@ -11,6 +11,7 @@
 
 #include <Xsc/IndentHandler.h>
 #include <Xsc/Reflection.h>
+#include <Xsc/Pipeline.h>
 #include <ostream>
 
 
@@ -27,6 +28,8 @@ class ReflectionPrinter
 
         void PrintReflection(const Reflection::ReflectionData& reflectionData);
 
+        void PrintPipelineLayout(const Reflection::PipelineLayout& layout);
+
     private:
 
         std::ostream& IndentOut();
@@ -35,6 +38,12 @@ class ReflectionPrinter
         void PrintReflectionObjects(const std::vector<std::string>& idents, const std::string& title);
         void PrintReflectionObjects(const std::map<std::string, Reflection::SamplerState>& samplerStates, const std::string& title);
         void PrintReflectionAttribute(const Reflection::NumThreads& numThreads, const std::string& title);
+        void PrintReflectionObjects(const std::vector<Reflection::PackedVarying>& packedVaryings, const std::string& title);
+        void PrintReflectionObjects(const std::vector<Reflection::ResourceAccess>& resourceAccesses, const std::string& title);
+        void PrintReflectionObjects(const std::vector<Reflection::BufferClass>& bufferClasses, const std::string& title);
+        void PrintReflectionPreshaders(const Reflection::ReflectionData& reflectionData, const std::string& title);
+        void PrintReflectionConstantTables(const Reflection::ReflectionData& reflectionData, const std::string& title);
+        void PrintReflectionProfileCounters(const Reflection::ReflectionData& reflectionData, const std::string& title);
 
         std::ostream&   output_;
         IndentHandler   indentHandler_;
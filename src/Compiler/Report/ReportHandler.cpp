@@ -15,7 +15,7 @@ namespace Xsc
 {
 
 
-static std::vector<std::string> g_hintQueue;
+static thread_local std::vector<std::string> g_hintQueue;
 
 ReportHandler::ReportHandler(const std::string& reportTypeName, Log* log) :
     reportTypeName_ { reportTypeName },
@@ -39,8 +39,8 @@ void ReportHandler::SubmitReport(
     bool breakWithExpection, const Report::Types type, const std::string& typeName,
     const std::string& msg, SourceCode* sourceCode, const SourceArea& area)
 {
-    /* Check if error location has already been reported */
-    if (!breakWithExpection && area.Pos().IsValid())
+    /* Check if error location has already been reported (infos may share their location with other reports) */
+    if (!breakWithExpection && type != Report::Types::Info && area.Pos().IsValid())
     {
         if (errorPositions_.find(area.Pos()) == errorPositions_.end())
             errorPositions_.insert(area.Pos());
@@ -50,7 +50,9 @@ void ReportHandler::SubmitReport(
 
     /* Initialize output message */
     auto outputMsg = typeName;
-    
+
+    ++numReports_;
+
     if (type == Report::Types::Error)
         hasErrors_ = true;
 
@@ -60,6 +60,12 @@ class ReportHandler
             return hasErrors_;
         }
 
+        // Returns the number of reports that have been submitted (including the reports that have been thrown).
+        inline std::size_t NumReports() const
+        {
+            return numReports_;
+        }
+
         // Pushes the specified context description string onto the stack. The top most description will be added to the next report message.
         void PushContextDesc(const std::string& contextDesc);
         void PopContextDesc();
@@ -83,6 +89,7 @@ class ReportHandler
 
         Log*                        log_                = nullptr;
         bool                        hasErrors_          = false;
+        std::size_t                 numReports_         = 0;
 
         std::stack<std::string>     contextDescStack_;
 
@@ -19,6 +19,7 @@ DECL_REPORT( Context,                           "context"
 DECL_REPORT( Reflection,                        "reflection"                                                                                                    );
 DECL_REPORT( CodeGeneration,                    "code generation"                                                                                               );
 DECL_REPORT( CodeReflection,                    "core reflection"                                                                                               );
+DECL_REPORT( PipelineLayout,                    "pipeline layout"                                                                                               );
 DECL_REPORT( ContextError,                      "context error"                                                                                                 );
 DECL_REPORT( InternalError,                     "internal error"                                                                                                );
 DECL_REPORT( In,                                "in"                                                                                                            ); // e.g. "error in 'context'"
@@ -250,6 +251,9 @@ DECL_REPORT( TypeSpecifier,                     "type specifier"
 DECL_REPORT( DivisionByZero,                    "division by zero"                                                                                              );
 DECL_REPORT( TypeCast,                          "type cast '{0}'"                                                                                               );
 DECL_REPORT( InitializerList,                   "initializer list"                                                                                              );
+DECL_REPORT( MismatchedDimensions,              "mismatched vector or matrix dimensions"                                                                        );
+DECL_REPORT( NonFiniteValue,                    "non-finite value"                                                                                              );
+DECL_REPORT( ArrayAccess,                       "array access"                                                                                                  );
 
 /* ----- ExprConverter ----- */
 
@@ -302,6 +306,16 @@ DECL_REPORT( InvalidParamVarCount,              "invalid number of variables in
 DECL_REPORT( NotAllStorageClassesMappedToGLSL,  "not all storage classes can be mapped to GLSL keywords"                                                        );
 DECL_REPORT( NotAllInterpModMappedToGLSL,       "not all interpolation modifiers can be mapped to GLSL keywords"                                                );
 DECL_REPORT( CantTranslateSamplerToGLSL,        "can not translate sampler state object to GLSL sampler"                                                        );
+DECL_REPORT( FastMathSubstitution,              "fast-math substitution: {0} -> {1}"                                                                            );
+DECL_REPORT( VectorizedScalarOps,               "vectorized {0} scalar operations into '{1}'"                                                                   );
+DECL_REPORT( ScalarReplacedAggregate,           "replaced aggregate '{0}' by {1} temporaries"                                                                   );
+DECL_REPORT( HoistedLoopInvariant,              "hoisted loop invariant expression into '{0}'"                                                                  );
+DECL_REPORT( ReducedInductionVarMul,            "reduced multiplication of induction variable '{0}' to addition of '{1}'"                                       );
+DECL_REPORT( PackedLocationsNotSupported,       "explicit locations of packed varyings not supported for version '{0}' (GLSL 410, ESSL 310, or VKSL required)"  );
+DECL_REPORT( ProfileCountersNotSupported,       "profiling counters not supported for shader output version '{0}' (GLSL 420, ESSL 310, or VKSL required)"       );
+DECL_REPORT( PGOReorderedBranches,              "moved 'else' branch in front of 'if' branch ({0} vs. {1} executions)"                                          );
+DECL_REPORT( PGOReorderedSwitchCases,           "reordered {0} switch cases by execution frequency"                                                             );
+DECL_REPORT( PGOUnrolledLoop,                   "unrolled hot loop with {0} iterations ({1} executions)"                                                        );
 
 /* ----- GLSLPreProcessor ----- */
 
@@ -408,6 +422,17 @@ DECL_REPORT( NumThreadsMustBeGreaterZero,       "number of threads must be great
 DECL_REPORT( SecondaryArrayDimMustBeExplicit,   "secondary array dimensions must be explicit"                                                                   );
 DECL_REPORT( StructsCantBeDefinedInParam,       "structures can not be defined in a parameter type[: '{0}']"                                                    );
 
+/* ----- HLSLProgramBuilder ----- */
+
+DECL_REPORT( InvalidBuilderExprHandle,          "invalid expression handle (each expression handle can only be used once)"                                      );
+DECL_REPORT( InvalidBuilderTypeName,            "invalid type name[: '{0}']"                                                                                    );
+DECL_REPORT( ExpectedBuilderVarAccessExpr,      "expected variable access expression"                                                                           );
+DECL_REPORT( BuilderStmntOutsideOfFunction,     "statements are only allowed inside of a function"                                                              );
+DECL_REPORT( BuilderDeclOnlyInGlobalScope,      "{0} can only be declared in the global scope"                                                                  );
+DECL_REPORT( BuilderParamOutsideOfFunction,     "parameters can only be declared directly inside of a function"                                                 );
+DECL_REPORT( MismatchedBuilderScopeEnd,         "mismatched end of builder scope[: expected end of {0}]"                                                        );
+DECL_REPORT( UnfinishedBuilderScope,            "builder scope has not been ended[: {0}]"                                                                       );
+
 /* ----- Xsc ----- */
 
 DECL_REPORT( InputStreamCantBeNull,             "input stream must not be null"                                                                                 );
@@ -420,6 +445,24 @@ DECL_REPORT( ParsingSourceFailed,               "parsing input code failed"
 DECL_REPORT( AnalyzingSourceFailed,             "analyzing input code failed"                                                                                   );
 DECL_REPORT( GeneratingOutputCodeFailed,        "generating output code failed"                                                                                 );
 
+/* ----- Batch ----- */
+
+DECL_REPORT( FailedToReadFile,                  "failed to read file[: \"{0}\"]"                                                                                );
+DECL_REPORT( FailedToWriteFile,                 "failed to write file[: \"{0}\"]"                                                                               );
+DECL_REPORT( BatchJobFailed,                    "batch job failed[: {0}]"                                                                                       );
+DECL_REPORT( WorkerProcessCrashed,              "batch worker process crashed[: {0}]"                                                                           );
+
+/* ----- Pipeline ----- */
+
+DECL_REPORT( PipelineStageCantBeUndefined,      "shader target of pipeline stage must not be undefined"                                                         );
+DECL_REPORT( PipelineReflectionCantBeNull,      "reflection data of pipeline stage must not be null"                                                            );
+DECL_REPORT( DuplicatePipelineStage,            "duplicate pipeline stage[: {0}]"                                                                               );
+DECL_REPORT( ComputeStageWithOtherStages,       "compute shader can not be combined with other shader stages in a pipeline"                                     );
+DECL_REPORT( ConflictingBindingLocations,       "conflicting binding locations of {0} '{1}' ({2} in {3}, {4} in {5})"                                           );
+DECL_REPORT( OverlappingBindingLocations,       "binding location {0} is used by {1} '{2}' in {3} and '{4}' in {5}"                                             );
+DECL_REPORT( UnmatchedStageInput,               "input attribute '{0}' of {1} is not written by {2}"                                                            );
+DECL_REPORT( UnmatchedPackedInput,              "packed input '{0}' of {1} is not written to the same slot components by {2}"                                   );
+
 
 #endif
 
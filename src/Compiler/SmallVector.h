@@ -0,0 +1,451 @@
+/*
+ * SmallVector.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_SMALL_VECTOR_H
+#define XSC_SMALL_VECTOR_H
+
+
+#include <initializer_list>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace Xsc
+{
+
+
+/*
+Vector container with inline storage for up to N elements, i.e. heap memory is only allocated for more than N elements.
+The interface is a subset of 'std::vector', and iterators are plain pointers.
+Size and capacity are stored as 32-bit integers, so the container header is only 8 bytes larger than a 'std::vector'.
+*/
+template <typename T, std::size_t N>
+class SmallVector
+{
+
+    public:
+
+        static_assert(N > 0, "inline capacity of SmallVector must not be zero");
+
+        using value_type        = T;
+        using size_type         = std::size_t;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = T&;
+        using const_reference   = const T&;
+        using pointer           = T*;
+        using const_pointer     = const T*;
+        using iterator          = T*;
+        using const_iterator    = const T*;
+
+        SmallVector() = default;
+
+        SmallVector(const SmallVector& rhs)
+        {
+            assign(rhs.begin(), rhs.end());
+        }
+
+        SmallVector(SmallVector&& rhs)
+        {
+            MoveFrom(rhs);
+        }
+
+        SmallVector(std::initializer_list<T> values)
+        {
+            assign(values.begin(), values.end());
+        }
+
+        template <typename InputIt>
+        SmallVector(InputIt first, InputIt last)
+        {
+            assign(first, last);
+        }
+
+        ~SmallVector()
+        {
+            clear();
+            Deallocate();
+        }
+
+        SmallVector& operator = (const SmallVector& rhs)
+        {
+            if (this != &rhs)
+                assign(rhs.begin(), rhs.end());
+            return *this;
+        }
+
+        SmallVector& operator = (SmallVector&& rhs)
+        {
+            if (this != &rhs)
+            {
+                clear();
+                Deallocate();
+                MoveFrom(rhs);
+            }
+            return *this;
+        }
+
+        SmallVector& operator = (std::initializer_list<T> values)
+        {
+            assign(values.begin(), values.end());
+            return *this;
+        }
+
+        template <typename InputIt>
+        void assign(InputIt first, InputIt last)
+        {
+            clear();
+            for (; first != last; ++first)
+                push_back(*first);
+        }
+
+        /* ----- Element access ----- */
+
+        inline T* data()
+        {
+            return data_;
+        }
+
+        inline const T* data() const
+        {
+            return data_;
+        }
+
+        inline T& operator [] (size_type pos)
+        {
+            return data_[pos];
+        }
+
+        inline const T& operator [] (size_type pos) const
+        {
+            return data_[pos];
+        }
+
+        inline T& front()
+        {
+            return data_[0];
+        }
+
+        inline const T& front() const
+        {
+            return data_[0];
+        }
+
+        inline T& back()
+        {
+            return data_[size_ - 1];
+        }
+
+        inline const T& back() const
+        {
+            return data_[size_ - 1];
+        }
+
+        /* ----- Iterators ----- */
+
+        inline iterator begin()
+        {
+            return data_;
+        }
+
+        inline const_iterator begin() const
+        {
+            return data_;
+        }
+
+        inline const_iterator cbegin() const
+        {
+            return data_;
+        }
+
+        inline iterator end()
+        {
+            return data_ + size_;
+        }
+
+        inline const_iterator end() const
+        {
+            return data_ + size_;
+        }
+
+        inline const_iterator cend() const
+        {
+            return data_ + size_;
+        }
+
+        inline std::reverse_iterator<iterator> rbegin()
+        {
+            return std::reverse_iterator<iterator>(end());
+        }
+
+        inline std::reverse_iterator<const_iterator> rbegin() const
+        {
+            return std::reverse_iterator<const_iterator>(end());
+        }
+
+        inline std::reverse_iterator<iterator> rend()
+        {
+            return std::reverse_iterator<iterator>(begin());
+        }
+
+        inline std::reverse_iterator<const_iterator> rend() const
+        {
+            return std::reverse_iterator<const_iterator>(begin());
+        }
+
+        /* ----- Capacity ----- */
+
+        inline bool empty() const
+        {
+            return (size_ == 0);
+        }
+
+        inline size_type size() const
+        {
+            return size_;
+        }
+
+        inline size_type capacity() const
+        {
+            return capacity_;
+        }
+
+        void reserve(size_type newCapacity)
+        {
+            if (newCapacity > capacity_)
+                Reallocate(newCapacity);
+        }
+
+        /* ----- Modifiers ----- */
+
+        void clear()
+        {
+            DestroyRange(data_, data_ + size_);
+            size_ = 0;
+        }
+
+        void push_back(const T& value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(T&& value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        template <typename... Args>
+        void emplace_back(Args&&... args)
+        {
+            /* Construct element first, since the arguments may refer to elements of this container */
+            T value(std::forward<Args>(args)...);
+            if (size_ == capacity_)
+                Grow(size_ + 1u);
+            new (data_ + size_) T(std::move(value));
+            ++size_;
+        }
+
+        void pop_back()
+        {
+            --size_;
+            data_[size_].~T();
+        }
+
+        void resize(size_type count)
+        {
+            if (count < size_)
+            {
+                DestroyRange(data_ + count, data_ + size_);
+                size_ = static_cast<std::uint32_t>(count);
+            }
+            else
+            {
+                reserve(count);
+                while (size_ < count)
+                {
+                    new (data_ + size_) T();
+                    ++size_;
+                }
+            }
+        }
+
+        iterator insert(const_iterator pos, const T& value)
+        {
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, T&& value)
+        {
+            return emplace(pos, std::move(value));
+        }
+
+        template <typename InputIt>
+        iterator insert(const_iterator pos, InputIt first, InputIt last)
+        {
+            /* Append new elements, then rotate them into place */
+            const auto index    = static_cast<size_type>(pos - data_);
+            const auto oldSize  = size_;
+
+            for (; first != last; ++first)
+                push_back(*first);
+
+            std::rotate(data_ + index, data_ + oldSize, data_ + size_);
+            return (data_ + index);
+        }
+
+        iterator insert(const_iterator pos, std::initializer_list<T> values)
+        {
+            return insert(pos, values.begin(), values.end());
+        }
+
+        template <typename... Args>
+        iterator emplace(const_iterator pos, Args&&... args)
+        {
+            const auto index = static_cast<size_type>(pos - data_);
+
+            emplace_back(std::forward<Args>(args)...);
+            std::rotate(data_ + index, data_ + size_ - 1, data_ + size_);
+
+            return (data_ + index);
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            auto dst = const_cast<T*>(first);
+            auto src = const_cast<T*>(last);
+
+            if (dst != src)
+            {
+                auto newEnd = std::move(src, data_ + size_, dst);
+                DestroyRange(newEnd, data_ + size_);
+                size_ = static_cast<std::uint32_t>(newEnd - data_);
+            }
+
+            return dst;
+        }
+
+        void swap(SmallVector& rhs)
+        {
+            std::swap(*this, rhs);
+        }
+
+    private:
+
+        // Returns true if the elements are stored in the inline buffer.
+        inline bool IsInline() const
+        {
+            return (data_ == InlineData());
+        }
+
+        inline T* InlineData()
+        {
+            return reinterpret_cast<T*>(&buffer_);
+        }
+
+        inline const T* InlineData() const
+        {
+            return reinterpret_cast<const T*>(&buffer_);
+        }
+
+        static void DestroyRange(T* first, T* last)
+        {
+            for (; first != last; ++first)
+                first->~T();
+        }
+
+        void Grow(size_type minCapacity)
+        {
+            Reallocate(std::max<size_type>(minCapacity, capacity_ * 2u));
+        }
+
+        // Moves all elements into a new heap buffer with the specified capacity.
+        void Reallocate(size_type newCapacity)
+        {
+            auto newData = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+
+            for (size_type i = 0; i < size_; ++i)
+            {
+                new (newData + i) T(std::move(data_[i]));
+                data_[i].~T();
+            }
+
+            Deallocate();
+
+            data_       = newData;
+            capacity_   = static_cast<std::uint32_t>(newCapacity);
+        }
+
+        // Releases the heap buffer (if used). All elements must already be destroyed.
+        void Deallocate()
+        {
+            if (!IsInline())
+            {
+                ::operator delete(data_);
+                data_       = InlineData();
+                capacity_   = N;
+            }
+        }
+
+        // Takes the elements from the specified container, which must be empty. The other container will be empty afterwards.
+        void MoveFrom(SmallVector& rhs)
+        {
+            if (rhs.IsInline())
+            {
+                for (auto& value : rhs)
+                    new (data_ + size_++) T(std::move(value));
+                rhs.clear();
+            }
+            else
+            {
+                /* Take heap buffer from other container */
+                data_           = rhs.data_;
+                size_           = rhs.size_;
+                capacity_       = rhs.capacity_;
+                rhs.data_       = rhs.InlineData();
+                rhs.size_       = 0;
+                rhs.capacity_   = N;
+            }
+        }
+
+        T*              data_       = InlineData();
+        std::uint32_t   size_       = 0;
+        std::uint32_t   capacity_   = N;
+
+        typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type buffer_;
+
+};
+
+template <typename T, std::size_t N>
+bool operator == (const SmallVector<T, N>& lhs, const SmallVector<T, N>& rhs)
+{
+    return (lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <typename T, std::size_t N>
+bool operator != (const SmallVector<T, N>& lhs, const SmallVector<T, N>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -97,7 +97,7 @@ bool SourceCode::FetchLineMarker(const SourceArea& area, std::string& line, std:
     if (area.Length() > 0)
     {
         auto row = area.Pos().Row();
-        if (row == pos_.Row())
+        if (row == pos_.Row() && packedLineOffsets_.empty())
             return FinalizeMarker(area, Line(), line, marker);
         else if (row > 0)
             return FinalizeMarker(area, GetLine(static_cast<std::size_t>(row - 1)), line, marker);
@@ -115,6 +115,33 @@ void SourceCode::NextSourceOrigin(const std::string& filename, int lineOffset)
     pos_.SetOrigin(origin);
 }
 
+void SourceCode::Compact()
+{
+    /* Release input stream (the source is not read any further) */
+    stream_.reset();
+    currentLine_.clear();
+    currentLine_.shrink_to_fit();
+
+    /* Pack all lines into a single buffer */
+    std::size_t size = 0;
+    for (const auto& line : lines_)
+        size += line.size();
+
+    packedLines_.reserve(packedLines_.size() + size);
+    packedLineOffsets_.reserve(packedLineOffsets_.size() + lines_.size() + 1);
+
+    if (packedLineOffsets_.empty())
+        packedLineOffsets_.push_back(0);
+
+    for (const auto& line : lines_)
+    {
+        packedLines_ += line;
+        packedLineOffsets_.push_back(packedLines_.size());
+    }
+
+    std::vector<std::string>().swap(lines_);
+}
+
 
 /*
  * ======= Private: =======
@@ -122,6 +149,16 @@ void SourceCode::NextSourceOrigin(const std::string& filename, int lineOffset)
 
 std::string SourceCode::GetLine(std::size_t lineIndex) const
 {
+    if (!packedLineOffsets_.empty())
+    {
+        /* Get line from packed buffer */
+        if (lineIndex + 1 < packedLineOffsets_.size())
+        {
+            auto offset = packedLineOffsets_[lineIndex];
+            return packedLines_.substr(offset, packedLineOffsets_[lineIndex + 1] - offset);
+        }
+        return "";
+    }
     return (lineIndex < lines_.size() ? lines_[lineIndex] : "");
 }
 
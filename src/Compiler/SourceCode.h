@@ -41,6 +41,12 @@ class SourceCode
         // Sets the new source origin for the current source position (see "Pos()").
         void NextSourceOrigin(const std::string& filename, int lineOffset);
 
+        /*
+        Releases the input stream and packs all lines that have been read into a single buffer.
+        Afterwards, only the line markers for reports are available (see "FetchLineMarker").
+        */
+        void Compact();
+
         // Ignores the current character.
         inline void Ignore()
         {
@@ -71,6 +77,10 @@ class SourceCode
         std::vector<std::string>        lines_;
         SourcePosition                  pos_;
 
+        // Packed lines after the source code has been compacted (see "Compact").
+        std::string                     packedLines_;
+        std::vector<std::size_t>        packedLineOffsets_;
+
 };
 
 using SourceCodePtr = std::shared_ptr<SourceCode>;
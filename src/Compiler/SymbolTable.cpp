@@ -232,20 +232,31 @@ AST* ASTSymbolOverload::FetchType(bool throwOnFailure) const
 
 FunctionDecl* ASTSymbolOverload::FetchFunctionDecl(bool throwOnFailure) const
 {
-    auto ref = Fetch(throwOnFailure);
-    if (auto funcDecl = ref->As<FunctionDecl>())
-        return funcDecl;
-    else if (throwOnFailure)
-        RuntimeErr(R_IdentIsNotFunc(ident_));
+    if (auto ref = Fetch(throwOnFailure))
+    {
+        if (auto funcDecl = ref->As<FunctionDecl>())
+            return funcDecl;
+        if (throwOnFailure)
+            RuntimeErr(R_IdentIsNotFunc(ident_));
+    }
     return nullptr;
 }
 
-FunctionDecl* ASTSymbolOverload::FetchFunctionDecl(const std::vector<TypeDenoterPtr>& argTypeDenoters) const
+// Throws the specified error message, or writes it to 'errorMsg' if it is not null.
+static FunctionDecl* FailFetchFunctionDecl(const std::string& msg, std::string* errorMsg)
+{
+    if (!errorMsg)
+        RuntimeErr(msg);
+    *errorMsg = msg;
+    return nullptr;
+}
+
+FunctionDecl* ASTSymbolOverload::FetchFunctionDecl(const std::vector<TypeDenoterPtr>& argTypeDenoters, std::string* errorMsg) const
 {
     if (refs_.empty())
-        RuntimeErr(R_UndefinedSymbol(ident_));
+        return FailFetchFunctionDecl(R_UndefinedSymbol(ident_), errorMsg);
     if (refs_.front()->Type() != AST::Types::FunctionDecl)
-        RuntimeErr(R_IdentIsNotFunc(ident_));
+        return FailFetchFunctionDecl(R_IdentIsNotFunc(ident_), errorMsg);
 
     /* Convert symbol references to function declaration pointers */
     std::vector<FunctionDecl*> funcDeclList;
@@ -256,11 +267,11 @@ FunctionDecl* ASTSymbolOverload::FetchFunctionDecl(const std::vector<TypeDenoter
         if (auto funcDecl = ref->As<FunctionDecl>())
             funcDeclList.push_back(funcDecl);
         else
-            RuntimeErr(R_AmbiguousSymbol(ident_));
+            return FailFetchFunctionDecl(R_AmbiguousSymbol(ident_), errorMsg);
     }
 
     /* Fetch function declaration from list */
-    return FunctionDecl::FetchFunctionDeclFromList(funcDeclList, ident_, argTypeDenoters);
+    return FunctionDecl::FetchFunctionDeclFromList(funcDeclList, ident_, argTypeDenoters, true, errorMsg);
 }
 
 
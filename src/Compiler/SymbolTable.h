@@ -245,8 +245,11 @@ class ASTSymbolOverload
         // Returns the FunctionDecl AST node (if the function is not overloaded).
         FunctionDecl* FetchFunctionDecl(bool throwOnFailure = true) const;
 
-        // Returns the FunctionDecl AST node for the specified argument type denoter list (used to derive the overloaded function).
-        FunctionDecl* FetchFunctionDecl(const std::vector<TypeDenoterPtr>& argTypeDenoters) const;
+        /*
+        Returns the FunctionDecl AST node for the specified argument type denoter list (used to derive the overloaded function).
+        If 'errorMsg' is not null, the error message is written to it and null is returned instead of throwing an exception.
+        */
+        FunctionDecl* FetchFunctionDecl(const std::vector<TypeDenoterPtr>& argTypeDenoters, std::string* errorMsg = nullptr) const;
 
     private:
 
@@ -0,0 +1,245 @@
+/*
+ * TaskScheduler.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2017 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <Xsc/TaskScheduler.h>
+#include <vector>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+
+namespace Xsc
+{
+
+
+/*
+ * TaskScheduler class
+ */
+
+TaskScheduler::~TaskScheduler()
+{
+}
+
+TaskGroup TaskScheduler::NewGroup()
+{
+    static std::atomic<TaskGroup> nextGroup { 1 };
+    return nextGroup++;
+}
+
+
+/*
+ * ThreadPool class
+ */
+
+class StdTaskScheduler::ThreadPool
+{
+
+    public:
+
+        ThreadPool(unsigned concurrency);
+        ~ThreadPool();
+
+        void Submit(TaskGroup group, const Task& task);
+        void Wait(TaskGroup group);
+
+        inline unsigned Concurrency() const
+        {
+            return concurrency_;
+        }
+
+    private:
+
+        struct PendingTask
+        {
+            TaskGroup   group;
+            Task        task;
+        };
+
+        // Starts the worker threads (if not already done). The mutex must be locked.
+        void StartWorkers();
+
+        void WorkerProc();
+
+        // Executes the specified task, and marks it as done. The mutex must be unlocked.
+        void RunTask(const PendingTask& pendingTask);
+
+        unsigned                            concurrency_    = 1;
+
+        std::mutex                          mutex_;
+        std::condition_variable             taskSubmitted_;
+        std::condition_variable             taskDone_;
+
+        std::deque<PendingTask>             tasks_;
+        std::map<TaskGroup, std::size_t>    numUnfinishedTasks_;    // Number of pending and running tasks per group.
+
+        std::vector<std::thread>            workers_;
+        bool                                quit_           = false;
+
+};
+
+StdTaskScheduler::ThreadPool::ThreadPool(unsigned concurrency) :
+    concurrency_ { concurrency }
+{
+}
+
+StdTaskScheduler::ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> guard { mutex_ };
+        quit_ = true;
+    }
+    taskSubmitted_.notify_all();
+
+    for (auto& worker : workers_)
+        worker.join();
+}
+
+void StdTaskScheduler::ThreadPool::Submit(TaskGroup group, const Task& task)
+{
+    {
+        std::lock_guard<std::mutex> guard { mutex_ };
+        StartWorkers();
+        tasks_.push_back({ group, task });
+        ++numUnfinishedTasks_[group];
+    }
+    taskSubmitted_.notify_one();
+}
+
+void StdTaskScheduler::ThreadPool::Wait(TaskGroup group)
+{
+    std::unique_lock<std::mutex> lock { mutex_ };
+
+    while (true)
+    {
+        /* Execute pending task of this group on the waiting thread */
+        auto it = std::find_if(
+            tasks_.begin(), tasks_.end(),
+            [group](const PendingTask& pendingTask)
+            {
+                return (pendingTask.group == group);
+            }
+        );
+
+        if (it != tasks_.end())
+        {
+            auto pendingTask = std::move(*it);
+            tasks_.erase(it);
+
+            lock.unlock();
+            {
+                RunTask(pendingTask);
+            }
+            lock.lock();
+            continue;
+        }
+
+        /* Wait for the tasks of this group, which are still running on other threads */
+        auto groupIt = numUnfinishedTasks_.find(group);
+        if (groupIt == numUnfinishedTasks_.end())
+            return;
+
+        if (groupIt->second == 0)
+        {
+            numUnfinishedTasks_.erase(groupIt);
+            return;
+        }
+
+        taskDone_.wait(lock);
+    }
+}
+
+void StdTaskScheduler::ThreadPool::StartWorkers()
+{
+    if (workers_.empty())
+    {
+        /* The waiting thread executes tasks as well, so one thread less is required */
+        for (unsigned i = 1; i < concurrency_; ++i)
+            workers_.emplace_back(&ThreadPool::WorkerProc, this);
+    }
+}
+
+void StdTaskScheduler::ThreadPool::WorkerProc()
+{
+    std::unique_lock<std::mutex> lock { mutex_ };
+
+    while (true)
+    {
+        taskSubmitted_.wait(lock, [this]() { return (quit_ || !tasks_.empty()); });
+
+        if (quit_)
+            return;
+
+        auto pendingTask = std::move(tasks_.front());
+        tasks_.pop_front();
+
+        lock.unlock();
+        {
+            RunTask(pendingTask);
+        }
+        lock.lock();
+    }
+}
+
+void StdTaskScheduler::ThreadPool::RunTask(const PendingTask& pendingTask)
+{
+    pendingTask.task();
+
+    {
+        std::lock_guard<std::mutex> guard { mutex_ };
+        --numUnfinishedTasks_[pendingTask.group];
+    }
+    taskDone_.notify_all();
+}
+
+
+/*
+ * StdTaskScheduler class
+ */
+
+StdTaskScheduler::StdTaskScheduler(unsigned concurrency)
+{
+    if (concurrency == 0)
+        concurrency = std::max(1u, std::thread::hardware_concurrency());
+    pool_ = new ThreadPool(concurrency);
+}
+
+StdTaskScheduler::~StdTaskScheduler()
+{
+    delete pool_;
+}
+
+void StdTaskScheduler::Submit(TaskGroup group, const Task& task)
+{
+    pool_->Submit(group, task);
+}
+
+void StdTaskScheduler::Wait(TaskGroup group)
+{
+    pool_->Wait(group);
+}
+
+unsigned StdTaskScheduler::Concurrency() const
+{
+    return pool_->Concurrency();
+}
+
+StdTaskScheduler& StdTaskScheduler::Default()
+{
+    static StdTaskScheduler scheduler;
+    return scheduler;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
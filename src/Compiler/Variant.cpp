@@ -7,7 +7,11 @@
 
 #include "Variant.h"
 #include "Helper.h"
+#include "ReportIdents.h"
 #include <sstream>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
 
 
 namespace Xsc
@@ -36,32 +40,40 @@ Variant::Variant(RealType value) :
 {
 }
 
-#define IMPLEMENT_VARIANT_OP(OP)    \
-    switch (type_)                  \
-    {                               \
-        case Types::Bool:           \
-            /* dummy case block */; \
-            break;                  \
-        case Types::Int:            \
-            int_ OP rhs.int_;       \
-            break;                  \
-        case Types::Real:           \
-            real_ OP rhs.real_;     \
-            break;                  \
-    }                               \
-    return *this                    \
-
-#define IMPLEMENT_VARIANT_BITWISE_OP(OP)    \
-    switch (type_)                          \
-    {                                       \
-        case Types::Int:                    \
-            int_ OP rhs.int_;               \
-            break;                          \
-        default:                            \
-            /* dummy case block */          \
-            break;                          \
-    }                                       \
-    return *this                            \
+#define IMPLEMENT_VARIANT_OP(OP)                                                        \
+    if (IsCompound() || rhs.IsCompound())                                               \
+        return ApplyComponentWise(rhs, [](Variant& a, const Variant& b) { a OP b; });   \
+    auto rhsValue = PromoteOperand(rhs);                                                \
+    switch (type_)                                                                      \
+    {                                                                                   \
+        case Types::Bool:                                                               \
+            /* dummy case block */;                                                     \
+            break;                                                                      \
+        case Types::Int:                                                                \
+            int_ OP rhsValue.int_;                                                      \
+            break;                                                                      \
+        case Types::Real:                                                               \
+            real_ OP rhsValue.real_;                                                    \
+            break;                                                                      \
+    }                                                                                   \
+    return *this                                                                        \
+
+#define IMPLEMENT_VARIANT_BITWISE_OP(OP)                                                \
+    if (IsCompound() || rhs.IsCompound())                                               \
+        return ApplyComponentWise(rhs, [](Variant& a, const Variant& b) { a OP b; });   \
+    switch (type_)                                                                      \
+    {                                                                                   \
+        case Types::Int:                                                                \
+        {                                                                               \
+            auto rhsValue = rhs;                                                        \
+            int_ OP rhsValue.ToInt();                                                   \
+        }                                                                               \
+        break;                                                                          \
+        default:                                                                        \
+            /* dummy case block */                                                      \
+            break;                                                                      \
+    }                                                                                   \
+    return *this                                                                        \
 
 Variant& Variant::operator += (const Variant& rhs)
 {
@@ -118,6 +130,9 @@ Variant& Variant::operator >>= (const Variant& rhs)
 
 Variant& Variant::operator ++ ()
 {
+    for (auto& component : components_)
+        ++component;
+
     switch (type_)
     {
         case Types::Bool:
@@ -135,6 +150,9 @@ Variant& Variant::operator ++ ()
 
 Variant& Variant::operator -- ()
 {
+    for (auto& component : components_)
+        --component;
+
     switch (type_)
     {
         case Types::Bool:
@@ -154,6 +172,9 @@ Variant Variant::operator - ()
 {
     Variant result = *this;
 
+    for (auto& component : result.components_)
+        component = -component;
+
     switch (type_)
     {
         case Types::Bool:
@@ -174,6 +195,9 @@ Variant Variant::operator ~ ()
 {
     Variant result = *this;
 
+    for (auto& component : result.components_)
+        component = ~component;
+
     switch (type_)
     {
         case Types::Int:
@@ -191,6 +215,9 @@ Variant Variant::operator ! ()
 {
     Variant result = *this;
 
+    for (auto& component : result.components_)
+        component = !component;
+
     switch (type_)
     {
         case Types::Bool:
@@ -209,6 +236,13 @@ Variant Variant::operator ! ()
 
 Variant::BoolType Variant::ToBool()
 {
+    if (IsCompound())
+    {
+        /* Convert all components, and return the value of the first one */
+        ConvertTo(Types::Bool);
+        return components_.front().bool_;
+    }
+
     switch (type_)
     {
         case Types::Bool:
@@ -228,6 +262,13 @@ Variant::BoolType Variant::ToBool()
 
 Variant::IntType Variant::ToInt()
 {
+    if (IsCompound())
+    {
+        /* Convert all components, and return the value of the first one */
+        ConvertTo(Types::Int);
+        return components_.front().int_;
+    }
+
     switch (type_)
     {
         case Types::Bool:
@@ -247,6 +288,13 @@ Variant::IntType Variant::ToInt()
 
 Variant::RealType Variant::ToReal()
 {
+    if (IsCompound())
+    {
+        /* Convert all components, and return the value of the first one */
+        ConvertTo(Types::Real);
+        return components_.front().real_;
+    }
+
     switch (type_)
     {
         case Types::Bool:
@@ -266,6 +314,22 @@ Variant::RealType Variant::ToReal()
 
 int Variant::CompareWith(const Variant& rhs) const
 {
+    if (IsCompound() || rhs.IsCompound())
+    {
+        /* Compare vectors and matrices lexicographically */
+        const auto n = std::min(NumComponents(), rhs.NumComponents());
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (auto result = Component(i).CompareWith(rhs.Component(i)))
+                return result;
+        }
+        if (NumComponents() < rhs.NumComponents())
+            return -1;
+        if (NumComponents() > rhs.NumComponents())
+            return 1;
+        return 0;
+    }
+
     auto cmp = rhs;
 
     switch (type_)
@@ -304,6 +368,137 @@ int Variant::CompareWith(const Variant& rhs) const
     return 0;
 }
 
+Variant Variant::MakeVector(const std::vector<Variant>& components)
+{
+    Variant result;
+
+    if (!components.empty())
+    {
+        /* Determine highest type of all components */
+        auto type = Types::Bool;
+        for (const auto& component : components)
+            type = std::max(type, component.Type());
+
+        result.shape_       = Shapes::Vector;
+        result.rows_        = static_cast<int>(components.size());
+        result.components_  = components;
+        result.ConvertTo(type);
+    }
+
+    return result;
+}
+
+Variant Variant::MakeMatrix(const std::vector<Variant>& components, int rows, int columns)
+{
+    if (rows < 1 || columns < 1 || components.size() != static_cast<std::size_t>(rows * columns))
+        throw std::invalid_argument(R_MismatchedDimensions);
+
+    auto result = MakeVector(components);
+    {
+        result.shape_   = Shapes::Matrix;
+        result.rows_    = rows;
+        result.columns_ = columns;
+    }
+    return result;
+}
+
+std::size_t Variant::NumComponents() const
+{
+    return (IsCompound() ? components_.size() : 1u);
+}
+
+const Variant& Variant::Component(std::size_t index) const
+{
+    if (IsCompound())
+        return components_[index];
+    else
+        return *this;
+}
+
+Variant Variant::WithComponents(const std::vector<Variant>& components) const
+{
+    if (components.size() != NumComponents())
+        throw std::invalid_argument(R_MismatchedDimensions);
+
+    if (IsCompound())
+    {
+        auto result = MakeVector(components);
+        {
+            result.shape_   = shape_;
+            result.rows_    = rows_;
+            result.columns_ = columns_;
+        }
+        return result;
+    }
+
+    return components.front();
+}
+
+static std::size_t VectorSubscriptIndex(char chr, const std::string& subscript, int vectorSize)
+{
+    static const std::string subscriptsXYZW = "xyzw";
+    static const std::string subscriptsRGBA = "rgba";
+
+    auto pos = subscriptsXYZW.find(chr);
+    if (pos == std::string::npos)
+        pos = subscriptsRGBA.find(chr);
+
+    if (pos == std::string::npos || pos >= static_cast<std::size_t>(vectorSize))
+        throw std::invalid_argument(R_InvalidVectorSubscript(subscript, "vector" + std::to_string(vectorSize)));
+
+    return pos;
+}
+
+static std::size_t MatrixSubscriptIndex(const std::string& subscript, std::size_t& i, int rows, int columns)
+{
+    /* Parse matrix subscript (e.g. zero-based "_m00", or one-based "_11") */
+    if (i + 3 > subscript.size() || subscript[i] != '_')
+        throw std::invalid_argument(R_IncompleteMatrixSubscript(subscript));
+    ++i;
+
+    int zeroBase = 1;
+    if (subscript[i] == 'm')
+    {
+        zeroBase = 0;
+        ++i;
+        if (i + 2 > subscript.size())
+            throw std::invalid_argument(R_IncompleteMatrixSubscript(subscript));
+    }
+
+    int row = subscript[i++] - '0' - zeroBase;
+    int col = subscript[i++] - '0' - zeroBase;
+
+    if (row < 0 || row >= rows || col < 0 || col >= columns)
+        throw std::invalid_argument(R_InvalidCharInMatrixSubscript(std::string(1, subscript[i - 1]), subscript));
+
+    return static_cast<std::size_t>(row * columns + col);
+}
+
+Variant Variant::Swizzle(const std::string& subscript) const
+{
+    std::vector<Variant> components;
+
+    if (shape_ == Shapes::Matrix)
+    {
+        for (std::size_t i = 0; i < subscript.size();)
+            components.push_back(Component(MatrixSubscriptIndex(subscript, i, rows_, columns_)));
+    }
+    else
+    {
+        for (auto chr : subscript)
+            components.push_back(Component(VectorSubscriptIndex(chr, subscript, rows_)));
+    }
+
+    if (components.empty() || components.size() > 4)
+        throw std::invalid_argument(R_VectorSubscriptCantHaveNComps(components.size()));
+
+    /* Single component swizzles result in a scalar */
+    if (components.size() == 1)
+        return components.front();
+
+    return MakeVector(components);
+}
+
 Variant Variant::ParseFrom(const std::string& s)
 {
     if (s == "true")
@@ -316,32 +511,56 @@ Variant Variant::ParseFrom(const std::string& s)
         return Variant(FromString<Variant::IntType>(s));
 }
 
-static void CropStringRight(std::string& s, std::size_t pos)
+static std::string RealToString(Variant::RealType v, int precision)
 {
-    if (pos < s.size())
-        s.erase(pos, std::string::npos);
+    std::ostringstream stream;
+    stream.precision(precision);
+    stream << v;
+    return stream.str();
 }
 
 static std::string RealToString(Variant::RealType v)
 {
-    auto s = std::to_string(v);
-    auto posFract = s.find('.');
-    if (posFract != std::string::npos)
+    std::string s;
+
+    if (static_cast<Variant::RealType>(static_cast<float>(v)) == v)
     {
-        auto pos = s.find_last_not_of('0');
-        if (pos != std::string::npos)
+        /* Use the fewest significant digits that are parsed again as the same single-precision value (e.g. "0.3" instead of "0.300000011920929") */
+        for (int precision = 1; precision <= std::numeric_limits<float>::max_digits10; ++precision)
         {
-            if (pos == posFract)
-                CropStringRight(s, pos + 2);
-            else
-                CropStringRight(s, pos + 1);
+            s = RealToString(v, precision);
+            if (static_cast<float>(FromString<Variant::RealType>(s)) == static_cast<float>(v))
+                break;
         }
     }
+    else
+    {
+        /* Use enough significant digits for values with double precision (e.g. "0.707106781186548") */
+        s = RealToString(v, std::numeric_limits<Variant::RealType>::digits10);
+    }
+
+    /* Always append fractional part, so the literal is not interpreted as integer */
+    if (s.find_first_of(".eE") == std::string::npos)
+        s += ".0";
+
     return s;
 }
 
 std::string Variant::ToString() const
 {
+    if (IsCompound())
+    {
+        /* Return string of all components (e.g. "{ 1.0, 2.0, 3.0 }") */
+        std::string s = "{ ";
+        for (std::size_t i = 0; i < components_.size(); ++i)
+        {
+            s += components_[i].ToString();
+            if (i + 1 < components_.size())
+                s += ", ";
+        }
+        return s + " }";
+    }
+
     switch (Type())
     {
         case Types::Bool:
@@ -355,38 +574,130 @@ std::string Variant::ToString() const
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+void Variant::ConvertTo(const Types type)
+{
+    if (IsCompound())
+    {
+        for (auto& component : components_)
+            component.ConvertTo(type);
+        type_ = type;
+    }
+    else
+    {
+        switch (type)
+        {
+            case Types::Bool:
+                ToBool();
+                break;
+            case Types::Int:
+                ToInt();
+                break;
+            case Types::Real:
+                ToReal();
+                break;
+        }
+    }
+}
+
+Variant Variant::PromoteOperand(const Variant& rhs)
+{
+    /* Promote both operands to the highest type (i.e. Bool < Int < Real) */
+    const auto type = std::max(type_, rhs.type_);
+
+    auto result = rhs;
+    result.ConvertTo(type);
+    ConvertTo(type);
+
+    return result;
+}
+
+Variant& Variant::ApplyComponentWise(const Variant& rhs, const ComponentOperator& op)
+{
+    if (IsCompound() && rhs.IsCompound())
+    {
+        if (shape_ == Shapes::Matrix || rhs.shape_ == Shapes::Matrix)
+        {
+            /* Matrices must have the same dimensions */
+            if (shape_ != rhs.shape_ || rows_ != rhs.rows_ || columns_ != rhs.columns_)
+                throw std::invalid_argument(R_MismatchedDimensions);
+        }
+        else if (rows_ > rhs.rows_)
+        {
+            /* Truncate vector to the smaller dimension (like implicit vector truncation in HLSL) */
+            rows_ = rhs.rows_;
+            components_.resize(static_cast<std::size_t>(rows_));
+        }
+    }
+    else if (!IsCompound())
+    {
+        /* Broadcast scalar to the shape of the right hand side */
+        *this = rhs.WithComponents(std::vector<Variant>(rhs.NumComponents(), *this));
+    }
+
+    for (std::size_t i = 0; i < components_.size(); ++i)
+        op(components_[i], rhs.Component(i));
+
+    /* Update type of compound by the type of its components */
+    type_ = components_.front().Type();
+
+    return *this;
+}
+
+
 /*
  * Global functions
  */
 
+// Compares the variants component-wise and returns a boolean scalar, vector, or matrix.
+static Variant CompareComponentWise(const Variant& lhs, const Variant& rhs, bool (*pred)(int))
+{
+    if (lhs.IsCompound() || rhs.IsCompound())
+    {
+        /* Determine resulting shape by applying a dummy operator (vectors are truncated, scalars are broadcast) */
+        auto result = lhs;
+        result -= rhs;
+
+        std::vector<Variant> components;
+        for (std::size_t i = 0; i < result.NumComponents(); ++i)
+            components.push_back(pred(lhs.Component(i).CompareWith(rhs.Component(i))));
+
+        return result.WithComponents(components);
+    }
+    return pred(lhs.CompareWith(rhs));
+}
+
 Variant operator == (const Variant& lhs, const Variant& rhs)
 {
-    return (lhs.CompareWith(rhs) == 0);
+    return CompareComponentWise(lhs, rhs, [](int cmp) { return (cmp == 0); });
 }
 
 Variant operator != (const Variant& lhs, const Variant& rhs)
 {
-    return (lhs.CompareWith(rhs) != 0);
+    return CompareComponentWise(lhs, rhs, [](int cmp) { return (cmp != 0); });
 }
 
 Variant operator < (const Variant& lhs, const Variant& rhs)
 {
-    return (lhs.CompareWith(rhs) < 0);
+    return CompareComponentWise(lhs, rhs, [](int cmp) { return (cmp < 0); });
 }
 
 Variant operator <= (const Variant& lhs, const Variant& rhs)
 {
-    return (lhs.CompareWith(rhs) <= 0);
+    return CompareComponentWise(lhs, rhs, [](int cmp) { return (cmp <= 0); });
 }
 
 Variant operator > (const Variant& lhs, const Variant& rhs)
 {
-    return (lhs.CompareWith(rhs) > 0);
+    return CompareComponentWise(lhs, rhs, [](int cmp) { return (cmp > 0); });
 }
 
 Variant operator >= (const Variant& lhs, const Variant& rhs)
 {
-    return (lhs.CompareWith(rhs) >= 0);
+    return CompareComponentWise(lhs, rhs, [](int cmp) { return (cmp >= 0); });
 }
 
 Variant operator + (const Variant& lhs, const Variant& rhs)
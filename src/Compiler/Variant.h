@@ -10,13 +10,17 @@
 
 
 #include "Visitor.h"
+#include <vector>
 
 
 namespace Xsc
 {
 
 
-// Helper class to simply cast expressions between boolean, float, and integral types.
+/*
+Helper class to simply cast expressions between boolean, float, and integral types.
+A variant can also hold a vector or matrix value, in which case all operators are applied component-wise.
+*/
 class Variant
 {
 
@@ -33,6 +37,14 @@ class Variant
             Real,
         };
 
+        // Shape enumeration of a variant (scalar, vector, or matrix).
+        enum class Shapes
+        {
+            Scalar,
+            Vector,
+            Matrix,
+        };
+
         Variant() = default;
         Variant(const Variant&) = default;
         Variant(BoolType value);
@@ -61,6 +73,30 @@ class Variant
         IntType ToInt();
         RealType ToReal();
 
+        /*
+        Returns a vector with the specified components. All components must be scalars.
+        The type of the vector is the highest type of all components (i.e. Bool < Int < Real).
+        */
+        static Variant MakeVector(const std::vector<Variant>& components);
+
+        // Returns a matrix with the specified components in row-major order. The number of components must be rows*columns.
+        static Variant MakeMatrix(const std::vector<Variant>& components, int rows, int columns);
+
+        // Returns the number of components (i.e. 1 for scalars, N for vectors, and NxM for matrices).
+        std::size_t NumComponents() const;
+
+        // Returns the component with the specified index (row-major order for matrices), or this variant if it is a scalar.
+        const Variant& Component(std::size_t index) const;
+
+        // Returns a copy of this variant where all components are replaced by the specified ones (must have the same number of components).
+        Variant WithComponents(const std::vector<Variant>& components) const;
+
+        /*
+        Returns the result of the specified swizzle operator (e.g. "xyz", "rgba", "_m00_m11", or "_11_22").
+        Throws std::invalid_argument on failure.
+        */
+        Variant Swizzle(const std::string& subscript) const;
+
         // Returns -1 if this variant is less than 'rhs', 0 if they are equal, and 1 if this variant is greater than 'rhs'.
         int CompareWith(const Variant& rhs) const;
 
@@ -79,22 +115,62 @@ class Variant
             return real_;
         }
 
-        // Returns the current internal type of this variant.
+        // Returns the current internal type of this variant (for vectors and matrices, this is the type of all components).
         inline Types Type() const
         {
             return type_;
         }
 
+        // Returns the shape of this variant.
+        inline Shapes Shape() const
+        {
+            return shape_;
+        }
+
+        // Returns true if this variant is a vector or a matrix.
+        inline bool IsCompound() const
+        {
+            return (shape_ != Shapes::Scalar);
+        }
+
+        // Returns the number of rows (or vector components). This is 1 for scalars.
+        inline int Rows() const
+        {
+            return rows_;
+        }
+
+        // Returns the number of columns. This is 1 for scalars and vectors.
+        inline int Columns() const
+        {
+            return columns_;
+        }
+
         static Variant ParseFrom(const std::string& s);
 
         std::string ToString() const;
 
     private:
 
-        Types       type_   = Types::Int;
-        BoolType    bool_   = false;
-        IntType     int_    = 0;
-        RealType    real_   = 0.0;
+        using ComponentOperator = void (*)(Variant& lhs, const Variant& rhs);
+
+        // Converts this variant into the specified type.
+        void ConvertTo(const Types type);
+
+        // Returns the specified operand, converted to the type this variant will have after type promotion.
+        Variant PromoteOperand(const Variant& rhs);
+
+        // Applies the specified operator to each component of this variant and the right hand side (scalars are broadcast).
+        Variant& ApplyComponentWise(const Variant& rhs, const ComponentOperator& op);
+
+        Types                   type_       = Types::Int;
+        BoolType                bool_       = false;
+        IntType                 int_        = 0;
+        RealType                real_       = 0.0;
+
+        Shapes                  shape_      = Shapes::Scalar;
+        int                     rows_       = 1;
+        int                     columns_    = 1;
+        std::vector<Variant>    components_;            // Components of a vector or matrix (row-major order); empty for scalars.
     
 };
 
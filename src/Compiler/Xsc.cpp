@@ -6,23 +6,31 @@
  */
 
 #include <Xsc/Xsc.h>
+#include <Xsc/ProgramBuilder.h>
 #include "PreProcessor.h"
 #include "GLSLPreProcessor.h"
 #include "GLSLExtensions.h"
 #include "GLSLGenerator.h"
 #include "HLSLParser.h"
+#include "HLSLProgramBuilder.h"
 #include "HLSLAnalyzer.h"
 #include "HLSLIntrinsics.h"
 #include "Optimizer.h"
+#include "PreshaderExtractor.h"
+#include "ConstantTableExtractor.h"
+#include "FlatVaryingAnalyzer.h"
+#include "PositionOnlyConverter.h"
 #include "ReflectionAnalyzer.h"
 #include "ReflectionPrinter.h"
 #include "ASTPrinter.h"
 #include "ASTEnums.h"
 #include "ReportIdents.h"
+#include "MemoryUsage.h"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <chrono>
+#include <functional>
 #include <array>
 
 
@@ -37,22 +45,29 @@ namespace Xsc
 using Time      = std::chrono::system_clock;
 using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
 
-static bool CompileShaderPrimary(
-    const ShaderInput& inputDesc, const ShaderOutput& outputDesc,
-    Log* log, Reflection::ReflectionData* reflectionData,
-    std::array<TimePoint, 6>& timePoints)
+// Stores the time point and memory usage at the beginning of the specified compilation process.
+static void StartProcess(
+    std::size_t i, const ShaderOutput& outputDesc,
+    std::array<TimePoint, 6>& timePoints, std::array<MemoryUsage, 6>& memoryPoints)
 {
-    auto SubmitError = [log](const std::string& msg)
+    timePoints[i] = Time::now();
+    if (outputDesc.options.showMemory)
     {
-        if (log)
-            log->SumitReport(Report(Report::Types::Error, msg));
-        return false;
-    };
+        /* Query memory usage of the previous process, then reset the high-water mark for the next process */
+        memoryPoints[i] = QueryMemoryUsage();
+        memoryPoints[i].peakReset = ResetPeakMemoryUsage();
+    }
+}
 
-    /* Validate arguments */
-    if (!inputDesc.sourceCode)
-        throw std::invalid_argument(R_InputStreamCantBeNull);
-    
+static bool SubmitError(Log* log, const std::string& msg)
+{
+    if (log)
+        log->SumitReport(Report(Report::Types::Error, msg));
+    return false;
+}
+
+static void ValidateOutputDesc(const ShaderOutput& outputDesc)
+{
     if (!outputDesc.sourceCode)
         throw std::invalid_argument(R_OutputStreamCantBeNull);
 
@@ -72,69 +87,18 @@ static bool CompileShaderPrimary(
     {
         throw std::invalid_argument(R_NameManglingPrefixOverlap);
     }
+}
 
-    /* ----- Pre-processing ----- */
-
-    timePoints[0] = Time::now();
-
-    std::unique_ptr<IncludeHandler> stdIncludeHandler;
-    if (!inputDesc.includeHandler)
-        stdIncludeHandler = std::unique_ptr<IncludeHandler>(new IncludeHandler());
-
-    auto includeHandler = (inputDesc.includeHandler != nullptr ? inputDesc.includeHandler : stdIncludeHandler.get());
-
-    std::unique_ptr<PreProcessor> preProcessor;
-
-    if (IsLanguageHLSL(inputDesc.shaderVersion))
-        preProcessor = MakeUnique<PreProcessor>(*includeHandler, log);
-    else if (IsLanguageGLSL(inputDesc.shaderVersion))
-        preProcessor = MakeUnique<GLSLPreProcessor>(*includeHandler, log);
-
-    auto processedInput = preProcessor->Process(
-        std::make_shared<SourceCode>(inputDesc.sourceCode),
-        inputDesc.filename
-    );
-
-    if (reflectionData)
-        reflectionData->macros = preProcessor->ListDefinedMacroIdents();
-
-    if (!processedInput)
-        return SubmitError(R_PreProcessingSourceFailed);
-
-    if (outputDesc.options.preprocessOnly)
-    {
-        (*outputDesc.sourceCode) << processedInput->rdbuf();
-        return true;
-    }
-
-    /* ----- Parsing ----- */
-
-    timePoints[1] = Time::now();
-
-    std::unique_ptr<IntrinsicAdept> intrinsicAdpet;
-    ProgramPtr program;
-
-    if (IsLanguageHLSL(inputDesc.shaderVersion))
-    {
-        /* Establish intrinsic adept */
-        intrinsicAdpet = MakeUnique<HLSLIntrinsicAdept>();
-
-        /* Parse HLSL input code */
-        HLSLParser parser(log);
-        program = parser.ParseSource(
-            std::make_shared<SourceCode>(std::move(processedInput)),
-            outputDesc.nameMangling,
-            (inputDesc.shaderVersion >= InputShaderVersion::HLSL4),
-            outputDesc.options.rowMajorAlignment
-        );
-    }
-
-    if (!program)
-        return SubmitError(R_ParsingSourceFailed);
-
+// Analyzes, optimizes, and generates the output code of the specified program (i.e. all compilation processes after parsing).
+static bool CompileProgramPrimary(
+    const ProgramPtr& program, bool syntaxErrors,
+    const ShaderInput& inputDesc, const ShaderOutput& outputDesc,
+    Log* log, Reflection::ReflectionData* reflectionData,
+    std::array<TimePoint, 6>& timePoints, std::array<MemoryUsage, 6>& memoryPoints)
+{
     /* ----- Context analysis ----- */
 
-    timePoints[2] = Time::now();
+    StartProcess(2, outputDesc, timePoints, memoryPoints);
 
     bool analyzerResult = false;
 
@@ -152,11 +116,15 @@ static bool CompileShaderPrimary(
         printer.PrintAST(program.get(), *log);
     }
 
+    /* Only report diagnostics (the AST may be incomplete due to syntax errors) */
+    if (outputDesc.options.diagnosticsMode)
+        return (!syntaxErrors && analyzerResult);
+
     if (!analyzerResult)
-        return SubmitError(R_AnalyzingSourceFailed);
+        return SubmitError(log, R_AnalyzingSourceFailed);
 
     /* Optimize AST */
-    timePoints[3] = Time::now();
+    StartProcess(3, outputDesc, timePoints, memoryPoints);
 
     if (outputDesc.options.optimize)
     {
@@ -164,9 +132,45 @@ static bool CompileShaderPrimary(
         optimizer.Optimize(*program);
     }
 
+    if (outputDesc.options.positionOnly)
+    {
+        if (inputDesc.shaderTarget == ShaderTarget::VertexShader || inputDesc.shaderTarget == ShaderTarget::TessellationEvaluationShader)
+        {
+            PositionOnlyConverter positionOnlyConverter;
+            positionOnlyConverter.Convert(*program);
+        }
+    }
+
+    if (outputDesc.options.extractPreshaders)
+    {
+        PreshaderExtractor preshaderExtractor;
+        preshaderExtractor.ExtractPreshaders(*program, outputDesc.nameMangling, reflectionData);
+    }
+
+    if (outputDesc.options.constantTableThreshold > 0)
+    {
+        ConstantTableExtractor constantTableExtractor;
+        constantTableExtractor.ExtractConstantTables(*program, outputDesc.options.constantTableThreshold, outputDesc.nameMangling, reflectionData);
+    }
+
+    /* Declare flat varyings ('flat' interpolation is not supported for GLSL 1.20 and ESSL 1.00) */
+    if (outputDesc.shaderVersion != OutputShaderVersion::GLSL110 &&
+        outputDesc.shaderVersion != OutputShaderVersion::GLSL120 &&
+        outputDesc.shaderVersion != OutputShaderVersion::ESSL100)
+    {
+        FlatVaryingAnalyzer flatVaryingAnalyzer;
+        if (inputDesc.shaderTarget == ShaderTarget::VertexShader)
+        {
+            if (outputDesc.options.flatVaryings)
+                flatVaryingAnalyzer.DeclareFlatOutputs(*program, reflectionData);
+        }
+        else if (inputDesc.shaderTarget == ShaderTarget::FragmentShader)
+            flatVaryingAnalyzer.DeclareFlatInputs(*program, outputDesc.flatInputSemantics);
+    }
+
     /* ----- Code generation ----- */
 
-    timePoints[4] = Time::now();
+    StartProcess(4, outputDesc, timePoints, memoryPoints);
 
     bool generatorResult = false;
 
@@ -175,14 +179,21 @@ static bool CompileShaderPrimary(
         /* Generate GLSL output code */
         GLSLGenerator generator(log);
         generatorResult = generator.GenerateCode(*program, inputDesc, outputDesc, log);
+
+        if (generatorResult && reflectionData)
+        {
+            generator.ReflectPackedVaryings(*reflectionData);
+            generator.ReflectBufferClasses(*reflectionData);
+            generator.ReflectProfileCounters(*reflectionData);
+        }
     }
 
     if (!generatorResult)
-        return SubmitError(R_GeneratingOutputCodeFailed);
+        return SubmitError(log, R_GeneratingOutputCodeFailed);
 
     /* ----- Code reflection ----- */
 
-    timePoints[5] = Time::now();
+    StartProcess(5, outputDesc, timePoints, memoryPoints);
 
     if (reflectionData)
     {
@@ -193,35 +204,125 @@ static bool CompileShaderPrimary(
     return true;
 }
 
-
-/*
- * Public functions
- */
-
-XSC_EXPORT bool CompileShader(
+static bool CompileShaderPrimary(
     const ShaderInput& inputDesc, const ShaderOutput& outputDesc,
-    Log* log, Reflection::ReflectionData* reflectionData)
+    Log* log, Reflection::ReflectionData* reflectionData,
+    std::array<TimePoint, 6>& timePoints, std::array<MemoryUsage, 6>& memoryPoints)
 {
-    std::array<TimePoint, 6> timePoints;
+    /* Validate arguments */
+    if (!inputDesc.sourceCode)
+        throw std::invalid_argument(R_InputStreamCantBeNull);
+    
+    ValidateOutputDesc(outputDesc);
 
-    /* Check for supported feature */
-    if (!IsLanguageHLSL(inputDesc.shaderVersion) && !outputDesc.options.preprocessOnly)
+    /* ----- Pre-processing ----- */
+
+    StartProcess(0, outputDesc, timePoints, memoryPoints);
+
+    std::unique_ptr<IncludeHandler> stdIncludeHandler;
+    if (!inputDesc.includeHandler)
+        stdIncludeHandler = std::unique_ptr<IncludeHandler>(new IncludeHandler());
+
+    auto includeHandler = (inputDesc.includeHandler != nullptr ? inputDesc.includeHandler : stdIncludeHandler.get());
+
+    std::unique_ptr<PreProcessor> preProcessor;
+
+    if (IsLanguageHLSL(inputDesc.shaderVersion))
+        preProcessor = MakeUnique<PreProcessor>(*includeHandler, log, inputDesc.includeCache);
+    else if (IsLanguageGLSL(inputDesc.shaderVersion))
+        preProcessor = MakeUnique<GLSLPreProcessor>(*includeHandler, log);
+
+    if (outputDesc.options.preprocessOnly)
     {
-        if (log)
-            log->SumitReport(Report(Report::Types::Error, "only pre-processing supported for shaders other than HLSL"));
-        return false;
+        /* Write pre-processed output directly into the output stream */
+        const bool result = preProcessor->Process(
+            std::make_shared<SourceCode>(inputDesc.sourceCode),
+            *outputDesc.sourceCode,
+            inputDesc.filename
+        );
+
+        if (reflectionData)
+            reflectionData->macros = preProcessor->ListDefinedMacroIdents();
+
+        if (!result)
+            return SubmitError(log, R_PreProcessingSourceFailed);
+
+        return true;
     }
 
+    auto processedInput = preProcessor->Process(
+        std::make_shared<SourceCode>(inputDesc.sourceCode),
+        inputDesc.filename
+    );
+
+    if (reflectionData)
+        reflectionData->macros = preProcessor->ListDefinedMacroIdents();
+
+    if (!processedInput)
+        return SubmitError(log, R_PreProcessingSourceFailed);
+
+    /* Release pre-processor state (i.e. macros and include sources), only the processed input is required from here on */
+    preProcessor.reset();
+    stdIncludeHandler.reset();
+
+    /* ----- Parsing ----- */
+
+    StartProcess(1, outputDesc, timePoints, memoryPoints);
+
+    std::unique_ptr<IntrinsicAdept> intrinsicAdpet;
+    ProgramPtr program;
+    bool syntaxErrors = false;
+
+    if (IsLanguageHLSL(inputDesc.shaderVersion))
+    {
+        /* Establish intrinsic adept */
+        intrinsicAdpet = MakeUnique<HLSLIntrinsicAdept>();
+
+        /* Parse HLSL input code */
+        HLSLParser parser(log);
+        program = parser.ParseSource(
+            std::make_shared<SourceCode>(std::move(processedInput)),
+            outputDesc.nameMangling,
+            (inputDesc.shaderVersion >= InputShaderVersion::HLSL4),
+            outputDesc.options.rowMajorAlignment,
+            outputDesc.options.preserveComments,
+            outputDesc.options.diagnosticsMode,
+            outputDesc.options.parallelParsing,
+            inputDesc.taskScheduler
+        );
+        syntaxErrors = parser.HasErrors();
+    }
+
+    if (!program)
+        return SubmitError(log, R_ParsingSourceFailed);
+
+    /* Release processed input stream, only the source lines for reports are required from here on */
+    if (program->sourceCode)
+        program->sourceCode->Compact();
+
+    return CompileProgramPrimary(program, syntaxErrors, inputDesc, outputDesc, log, reflectionData, timePoints, memoryPoints);
+}
+
+using PrimaryCompileFunction = std::function<bool(const ShaderOutput&, std::array<TimePoint, 6>&, std::array<MemoryUsage, 6>&)>;
+
+// Compiles the shader with the specified primary function, then sorts the reflection data and shows the timings and memory usage.
+static bool CompileShaderWithPrimaryFunction(
+    const ShaderOutput& outputDesc, Log* log, Reflection::ReflectionData* reflectionData,
+    const PrimaryCompileFunction& primaryFunc)
+{
+    std::array<TimePoint, 6> timePoints;
+    std::array<MemoryUsage, 6> memoryPoints;
+
     /* Make copy of output descriptor to support validation without output stream */
     std::stringstream dummyOutputStream;
 
     auto outputDescCopy = outputDesc;
 
-    if (outputDescCopy.options.validateOnly)
+    if (outputDescCopy.options.validateOnly || outputDescCopy.options.diagnosticsMode)
         outputDescCopy.sourceCode = &dummyOutputStream;
 
     /* Compile shader with primary function */
-    auto result = CompileShaderPrimary(inputDesc, outputDescCopy, log, reflectionData, timePoints);
+    auto result = primaryFunc(outputDescCopy, timePoints, memoryPoints);
 
     if (reflectionData)
     {
@@ -259,9 +360,110 @@ XSC_EXPORT bool CompileShader(
         PrintTimePoint("code generation:  ", timePoints[4], timePoints[5]);
     }
 
+    /* Show memory usage */
+    if (outputDescCopy.options.showMemory && log)
+    {
+        /*
+        Print peak memory during each process (if the high-water mark could be reset at the start of that process),
+        and the resident memory after each process with its change during that process
+        */
+        std::size_t overallPeakBytes = 0;
+        bool allPeaksReset = true;
+
+        auto PrintMemoryPoint = [&](const std::string& processName, const MemoryUsage& startUsage, const MemoryUsage& endUsage)
+        {
+            const auto startKB  = static_cast<long long>(startUsage.residentBytes / 1024);
+            const auto endKB    = static_cast<long long>(endUsage.residentBytes / 1024);
+            const auto deltaKB  = endKB - startKB;
+
+            std::string s = "memory " + processName;
+
+            if (startUsage.peakReset)
+            {
+                s += "peak " + std::to_string(endUsage.peakBytes / 1024) + " KB, ";
+                overallPeakBytes = std::max(overallPeakBytes, endUsage.peakBytes);
+            }
+            else
+                allPeaksReset = false;
+
+            s += "resident " + std::to_string(endKB) + " KB (" + (deltaKB >= 0 ? "+" : "") + std::to_string(deltaKB) + " KB)";
+
+            log->SumitReport(Report(Report::Types::Info, s));
+        };
+
+        PrintMemoryPoint("pre-processing:   ", memoryPoints[0], memoryPoints[1]);
+        PrintMemoryPoint("parsing:          ", memoryPoints[1], memoryPoints[2]);
+        PrintMemoryPoint("context analysis: ", memoryPoints[2], memoryPoints[3]);
+        PrintMemoryPoint("optimization:     ", memoryPoints[3], memoryPoints[4]);
+        PrintMemoryPoint("code generation:  ", memoryPoints[4], memoryPoints[5]);
+
+        /* Without per-process resets, the high-water mark is cumulative since the process has been started */
+        if (allPeaksReset)
+            log->SumitReport(Report(Report::Types::Info, "memory overall peak:     " + std::to_string(overallPeakBytes / 1024) + " KB"));
+        else
+            log->SumitReport(Report(Report::Types::Info, "memory cumulative peak:  " + std::to_string(memoryPoints[5].peakBytes / 1024) + " KB"));
+    }
+
     return result;
 }
 
+
+/*
+ * Public functions
+ */
+
+XSC_EXPORT bool CompileShader(
+    const ShaderInput& inputDesc, const ShaderOutput& outputDesc,
+    Log* log, Reflection::ReflectionData* reflectionData)
+{
+    /* Check for supported feature */
+    if (!IsLanguageHLSL(inputDesc.shaderVersion) && !outputDesc.options.preprocessOnly)
+    {
+        if (log)
+            log->SumitReport(Report(Report::Types::Error, "only pre-processing supported for shaders other than HLSL"));
+        return false;
+    }
+
+    return CompileShaderWithPrimaryFunction(
+        outputDesc, log, reflectionData,
+        [&](const ShaderOutput& outputDescCopy, std::array<TimePoint, 6>& timePoints, std::array<MemoryUsage, 6>& memoryPoints)
+        {
+            return CompileShaderPrimary(inputDesc, outputDescCopy, log, reflectionData, timePoints, memoryPoints);
+        }
+    );
+}
+
+XSC_EXPORT bool CompileShader(
+    ProgramBuilder& builder, const ShaderInput& inputDesc, const ShaderOutput& outputDesc,
+    Log* log, Reflection::ReflectionData* reflectionData)
+{
+    /* Take built program (this also validates that all builder scopes have been ended) */
+    auto program = builder.builder_->TakeProgram();
+
+    /* Check for supported feature */
+    if (!IsLanguageHLSL(inputDesc.shaderVersion))
+    {
+        if (log)
+            log->SumitReport(Report(Report::Types::Error, "only HLSL supported as input shader version for programs from a builder"));
+        return false;
+    }
+
+    return CompileShaderWithPrimaryFunction(
+        outputDesc, log, reflectionData,
+        [&](const ShaderOutput& outputDescCopy, std::array<TimePoint, 6>& timePoints, std::array<MemoryUsage, 6>& memoryPoints)
+        {
+            ValidateOutputDesc(outputDescCopy);
+
+            /* There is neither a pre-processing nor parsing process for programs from a builder */
+            StartProcess(0, outputDescCopy, timePoints, memoryPoints);
+            StartProcess(1, outputDescCopy, timePoints, memoryPoints);
+
+            HLSLIntrinsicAdept intrinsicAdept;
+            return CompileProgramPrimary(program, false, inputDesc, outputDescCopy, log, reflectionData, timePoints, memoryPoints);
+        }
+    );
+}
+
 XSC_EXPORT std::string ToString(const ShaderTarget target)
 {
     switch (target)
@@ -337,6 +539,28 @@ XSC_EXPORT std::string ToString(const Reflection::ComparisonFunc t)
     return CompareFuncToString(t);
 }
 
+XSC_EXPORT std::string ToString(const Reflection::BufferStorage t)
+{
+    switch (t)
+    {
+        case Reflection::BufferStorage::Uniform:        return "uniform";
+        case Reflection::BufferStorage::Storage:        return "storage";
+        case Reflection::BufferStorage::PushConstant:   return "push_constant";
+    }
+    return "";
+}
+
+XSC_EXPORT std::string ToString(const Reflection::ProfileCounterType t)
+{
+    switch (t)
+    {
+        case Reflection::ProfileCounterType::Function:  return "function";
+        case Reflection::ProfileCounterType::Branch:    return "branch";
+        case Reflection::ProfileCounterType::Loop:      return "loop";
+    }
+    return "";
+}
+
 XSC_EXPORT void PrintReflection(std::ostream& stream, const Reflection::ReflectionData& reflectionData)
 {
     ReflectionPrinter printer(stream);
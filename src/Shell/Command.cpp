@@ -352,6 +352,30 @@ void ShowTimesCommand::Run(CommandLine& cmdLine, ShellState& state)
 }
 
 
+/*
+ * ShowMemoryCommand class
+ */
+
+std::vector<Command::Identifier> ShowMemoryCommand::Idents() const
+{
+    return { { "--show-memory" } };
+}
+
+HelpDescriptor ShowMemoryCommand::Help() const
+{
+    return
+    {
+        "--show-memory [" + CommandLine::GetBooleanOption() + "]",
+        "Enables/disables debug output for peak and resident memory of each compilation step; default=" + CommandLine::GetBooleanFalse()
+    };
+}
+
+void ShowMemoryCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.outputDesc.options.showMemory = cmdLine.AcceptBoolean(true);
+}
+
+
 /*
  * ReflectCommand class
  */
@@ -376,6 +400,30 @@ void ReflectCommand::Run(CommandLine& cmdLine, ShellState& state)
 }
 
 
+/*
+ * PipelineCommand class
+ */
+
+std::vector<Command::Identifier> PipelineCommand::Idents() const
+{
+    return { { "--pipeline" } };
+}
+
+HelpDescriptor PipelineCommand::Help() const
+{
+    return
+    {
+        "--pipeline [" + CommandLine::GetBooleanOption() + "]",
+        "Enables/disables merging of the code reflection of all shaders of the same command line into a pipeline layout with interface and layout hashes; default=" + CommandLine::GetBooleanFalse()
+    };
+}
+
+void PipelineCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.mergePipeline = cmdLine.AcceptBoolean(true);
+}
+
+
 /*
  * PPOnlyCommand class
  */
@@ -822,6 +870,30 @@ void ValidateCommand::Run(CommandLine& cmdLine, ShellState& state)
 }
 
 
+/*
+ * DiagnosticsCommand class
+ */
+
+std::vector<Command::Identifier> DiagnosticsCommand::Idents() const
+{
+    return { { "-diag" }, { "--diagnostics" } };
+}
+
+HelpDescriptor DiagnosticsCommand::Help() const
+{
+    return
+    {
+        "-diag, --diagnostics [" + CommandLine::GetBooleanOption() + "]",
+        "Enables/disables to only report diagnostics (with recovery from syntax errors); default=" + CommandLine::GetBooleanFalse()
+    };
+}
+
+void DiagnosticsCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.outputDesc.options.diagnosticsMode = cmdLine.AcceptBoolean(true);
+}
+
+
 /*
  * BindingCommand class
  */
@@ -942,6 +1014,404 @@ void ObfuscateCommand::Run(CommandLine& cmdLine, ShellState& state)
 }
 
 
+/*
+ * PreshaderCommand class
+ */
+
+std::vector<Command::Identifier> PreshaderCommand::Idents() const
+{
+    return { { "--preshaders" } };
+}
+
+HelpDescriptor PreshaderCommand::Help() const
+{
+    return
+    {
+        "--preshaders [" + CommandLine::GetBooleanOption() + "]",
+        "Enables/disables extraction of uniform-only expressions into a constant buffer; default=" + CommandLine::GetBooleanFalse()
+    };
+}
+
+void PreshaderCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.outputDesc.options.extractPreshaders = cmdLine.AcceptBoolean(true);
+}
+
+
+/*
+ * ConstantTablesCommand class
+ */
+
+std::vector<Command::Identifier> ConstantTablesCommand::Idents() const
+{
+    return { { "--constant-tables" } };
+}
+
+HelpDescriptor ConstantTablesCommand::Help() const
+{
+    return
+    {
+        "--constant-tables N",
+        "Moves static constant arrays with at least N elements into a constant buffer; 0 to disable; default=0"
+    };
+}
+
+void ConstantTablesCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    auto value = cmdLine.Accept();
+    try
+    {
+        state.outputDesc.options.constantTableThreshold = static_cast<unsigned int>(std::stoul(value));
+    }
+    catch (const std::exception&)
+    {
+        throw std::invalid_argument("invalid constant table threshold: \"" + value + "\"");
+    }
+}
+
+
+/*
+ * FastMathCommand class
+ */
+
+std::vector<Command::Identifier> FastMathCommand::Idents() const
+{
+    return { { "--fast-math" } };
+}
+
+HelpDescriptor FastMathCommand::Help() const
+{
+    return
+    {
+        "--fast-math LIST", "Enables approximate intrinsic substitutions; comma separated list of:",
+        "pow, normalize, explog, mad, saturate, all, none"
+    };
+}
+
+void FastMathCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    const std::map<std::string, unsigned int> flagsMap
+    {
+        { "pow",        FastMathFlags::PowToMul  },
+        { "normalize",  FastMathFlags::Normalize },
+        { "explog",     FastMathFlags::ExpLog    },
+        { "mad",        FastMathFlags::MulAdd    },
+        { "saturate",   FastMathFlags::Saturate  },
+        { "all",        FastMathFlags::All       },
+        { "none",       0                        },
+    };
+
+    unsigned int flags = 0;
+
+    std::stringstream list(cmdLine.Accept());
+    for (std::string name; std::getline(list, name, ',');)
+        flags |= MapStringToType<unsigned int>(name, flagsMap, "invalid fast-math substitution");
+
+    state.outputDesc.options.fastMath = flags;
+}
+
+
+/*
+ * PushConstantsCommand class
+ */
+
+std::vector<Command::Identifier> PushConstantsCommand::Idents() const
+{
+    return { { "--push-constants" } };
+}
+
+HelpDescriptor PushConstantsCommand::Help() const
+{
+    return
+    {
+        "--push-constants N",
+        "Merges constant buffers into a push constant block of at most N bytes (VKSL only); 0 to disable; default=0"
+    };
+}
+
+void PushConstantsCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    auto value = cmdLine.Accept();
+    try
+    {
+        state.outputDesc.options.pushConstantBudget = static_cast<unsigned int>(std::stoul(value));
+    }
+    catch (const std::exception&)
+    {
+        throw std::invalid_argument("invalid push constant budget: \"" + value + "\"");
+    }
+}
+
+
+/*
+ * UniformStorageBuffersCommand class
+ */
+
+std::vector<Command::Identifier> UniformStorageBuffersCommand::Idents() const
+{
+    return { { "--uniform-storage-buffers" } };
+}
+
+HelpDescriptor UniformStorageBuffersCommand::Help() const
+{
+    return
+    {
+        "--uniform-storage-buffers N",
+        "Declares read-only structured buffers as uniform buffers of N bytes where possible (VKSL only); 0 to disable; default=0"
+    };
+}
+
+void UniformStorageBuffersCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    auto value = cmdLine.Accept();
+    try
+    {
+        state.outputDesc.options.uniformStorageBufferSize = static_cast<unsigned int>(std::stoul(value));
+    }
+    catch (const std::exception&)
+    {
+        throw std::invalid_argument("invalid uniform storage buffer size: \"" + value + "\"");
+    }
+}
+
+
+/*
+ * PackVaryingsCommand class
+ */
+
+std::vector<Command::Identifier> PackVaryingsCommand::Idents() const
+{
+    return { { "--pack-varyings" } };
+}
+
+HelpDescriptor PackVaryingsCommand::Help() const
+{
+    return
+    {
+        "--pack-varyings [" + CommandLine::GetBooleanOption() + "]",
+        "Enables/disables packing of shader input/output variables into 4-component slots; fragment shaders are packed "
+        "with the slots of the previous vertex or domain shader of the same command line (not in batch mode); default=" + CommandLine::GetBooleanFalse()
+    };
+}
+
+void PackVaryingsCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.outputDesc.options.packVaryings = cmdLine.AcceptBoolean(true);
+}
+
+
+/*
+ * PositionOnlyCommand class
+ */
+
+std::vector<Command::Identifier> PositionOnlyCommand::Idents() const
+{
+    return { { "--position-only" } };
+}
+
+HelpDescriptor PositionOnlyCommand::Help() const
+{
+    return
+    {
+        "--position-only [" + CommandLine::GetBooleanOption() + "]",
+        "Enables/disables generation of a position-only variant of a vertex or domain shader; default=" + CommandLine::GetBooleanFalse()
+    };
+}
+
+void PositionOnlyCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.outputDesc.options.positionOnly = cmdLine.AcceptBoolean(true);
+}
+
+
+/*
+ * FlatVaryingsCommand class
+ */
+
+std::vector<Command::Identifier> FlatVaryingsCommand::Idents() const
+{
+    return { { "--flat-varyings" } };
+}
+
+HelpDescriptor FlatVaryingsCommand::Help() const
+{
+    return
+    {
+        "--flat-varyings [" + CommandLine::GetBooleanOption() + "]",
+        "Enables/disables 'flat' interpolation for vertex outputs that are constant within each primitive; default=" + CommandLine::GetBooleanFalse()
+    };
+}
+
+void FlatVaryingsCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.outputDesc.options.flatVaryings = cmdLine.AcceptBoolean(true);
+}
+
+
+/*
+ * FlatInputCommand class
+ */
+
+std::vector<Command::Identifier> FlatInputCommand::Idents() const
+{
+    return { { "--flat-input" } };
+}
+
+HelpDescriptor FlatInputCommand::Help() const
+{
+    return
+    {
+        "--flat-input SEMANTIC",
+        "Declares the fragment shader input SEMANTIC (e.g. COLOR0) with 'flat' interpolation"
+    };
+}
+
+void FlatInputCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.outputDesc.flatInputSemantics.push_back(cmdLine.Accept());
+}
+
+
+/*
+ * VectorizeCommand class
+ */
+
+std::vector<Command::Identifier> VectorizeCommand::Idents() const
+{
+    return { { "--vectorize" } };
+}
+
+HelpDescriptor VectorizeCommand::Help() const
+{
+    return
+    {
+        "--vectorize [" + CommandLine::GetBooleanOption() + "]",
+        "Enables/disables merging of scalar operations on vector components into vector operations; default=" + CommandLine::GetBooleanFalse()
+    };
+}
+
+void VectorizeCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.outputDesc.options.vectorize = cmdLine.AcceptBoolean(true);
+}
+
+
+/*
+ * ScalarReplacementCommand class
+ */
+
+std::vector<Command::Identifier> ScalarReplacementCommand::Idents() const
+{
+    return { { "--sroa" } };
+}
+
+HelpDescriptor ScalarReplacementCommand::Help() const
+{
+    return
+    {
+        "--sroa [" + CommandLine::GetBooleanOption() + "]",
+        "Enables/disables replacement of local arrays and structures with constant indices by temporaries; default=" + CommandLine::GetBooleanFalse()
+    };
+}
+
+void ScalarReplacementCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.outputDesc.options.scalarReplacement = cmdLine.AcceptBoolean(true);
+}
+
+
+/*
+ * LoopOptimizationCommand class
+ */
+
+std::vector<Command::Identifier> LoopOptimizationCommand::Idents() const
+{
+    return { { "--opt-loops" } };
+}
+
+HelpDescriptor LoopOptimizationCommand::Help() const
+{
+    return
+    {
+        "--opt-loops [" + CommandLine::GetBooleanOption() + "]",
+        "Enables/disables hoisting of loop invariants and strength reduction of induction variables; default=" + CommandLine::GetBooleanFalse()
+    };
+}
+
+void LoopOptimizationCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.outputDesc.options.optimizeLoops = cmdLine.AcceptBoolean(true);
+}
+
+
+/*
+ * ProfileCountersCommand class
+ */
+
+std::vector<Command::Identifier> ProfileCountersCommand::Idents() const
+{
+    return { { "--profile" } };
+}
+
+HelpDescriptor ProfileCountersCommand::Help() const
+{
+    return
+    {
+        "--profile [" + CommandLine::GetBooleanOption() + "]",
+        "Enables/disables instrumentation with execution counters for functions, branches, and loops; default=" + CommandLine::GetBooleanFalse()
+    };
+}
+
+void ProfileCountersCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.outputDesc.options.profileCounters = cmdLine.AcceptBoolean(true);
+}
+
+
+/*
+ * ProfileGuidedCommand class
+ */
+
+std::vector<Command::Identifier> ProfileGuidedCommand::Idents() const
+{
+    return { { "--pgo" } };
+}
+
+HelpDescriptor ProfileGuidedCommand::Help() const
+{
+    return
+    {
+        "--pgo FILE",
+        "Reads execution counts (lines of \"FILE:ROW:COLUMN COUNT\") from FILE for profile-guided optimization"
+    };
+}
+
+void ProfileGuidedCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    auto filename = cmdLine.Accept();
+
+    std::ifstream file(filename);
+    if (!file.good())
+        throw std::runtime_error("failed to read file: \"" + filename + "\"");
+
+    /* Read one location with its execution count per line, and ignore empty lines and comments */
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream lineStream(line);
+
+        ProfileCount profileCount;
+        if (!(lineStream >> profileCount.location) || profileCount.location[0] == '#')
+            continue;
+
+        if (!(lineStream >> profileCount.count))
+            throw std::runtime_error("missing execution count for location \"" + profileCount.location + "\" in file: \"" + filename + "\"");
+
+        state.outputDesc.profileCounts.push_back(profileCount);
+    }
+}
+
+
 /*
  * RowMajorAlignmentCommand class
  */
@@ -966,6 +1436,135 @@ void RowMajorAlignmentCommand::Run(CommandLine& cmdLine, ShellState& state)
 }
 
 
+/*
+ * JobsCommand class
+ */
+
+std::vector<Command::Identifier> JobsCommand::Idents() const
+{
+    return { { "-j" }, { "--jobs" } };
+}
+
+HelpDescriptor JobsCommand::Help() const
+{
+    return
+    {
+        "-j, --jobs N",
+        "Compiles all files as one batch with N threads (longest-expected-first); 0 for number of hardware threads"
+    };
+}
+
+void JobsCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    auto value = cmdLine.Accept();
+    try
+    {
+        state.batchThreads = static_cast<unsigned>(std::stoul(value));
+    }
+    catch (const std::exception&)
+    {
+        throw std::invalid_argument("invalid number of jobs: \"" + value + "\"");
+    }
+    state.batchCompile = true;
+}
+
+
+/*
+ * TimingDatabaseCommand class
+ */
+
+std::vector<Command::Identifier> TimingDatabaseCommand::Idents() const
+{
+    return { { "--timing-db" } };
+}
+
+HelpDescriptor TimingDatabaseCommand::Help() const
+{
+    return
+    {
+        "--timing-db FILE",
+        "Loads and updates the compile timings for batch scheduling from FILE"
+    };
+}
+
+void TimingDatabaseCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.timingDatabase = cmdLine.Accept();
+}
+
+
+/*
+ * IsolateCommand class
+ */
+
+std::vector<Command::Identifier> IsolateCommand::Idents() const
+{
+    return { { "--isolate" } };
+}
+
+HelpDescriptor IsolateCommand::Help() const
+{
+    return
+    {
+        "--isolate [" + CommandLine::GetBooleanOption() + "]",
+        "Enables/disables crash-isolated worker processes for batch compilation (see -j); default=" + CommandLine::GetBooleanFalse()
+    };
+}
+
+void IsolateCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.batchIsolation = cmdLine.AcceptBoolean(true);
+}
+
+
+/*
+ * IncludeCacheCommand class
+ */
+
+std::vector<Command::Identifier> IncludeCacheCommand::Idents() const
+{
+    return { { "--include-cache" } };
+}
+
+HelpDescriptor IncludeCacheCommand::Help() const
+{
+    return
+    {
+        "--include-cache [" + CommandLine::GetBooleanOption() + "]",
+        "Enables/disables memoized expansion of include files, shared between all compiled files; default=" + CommandLine::GetBooleanFalse()
+    };
+}
+
+void IncludeCacheCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.includeCache = cmdLine.AcceptBoolean(true);
+}
+
+
+/*
+ * ParallelParseCommand class
+ */
+
+std::vector<Command::Identifier> ParallelParseCommand::Idents() const
+{
+    return { { "--parallel-parse" } };
+}
+
+HelpDescriptor ParallelParseCommand::Help() const
+{
+    return
+    {
+        "--parallel-parse [" + CommandLine::GetBooleanOption() + "]",
+        "Enables/disables parsing of global declarations in parallel chunks for large input files; default=" + CommandLine::GetBooleanFalse()
+    };
+}
+
+void ParallelParseCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.outputDesc.options.parallelParsing = cmdLine.AcceptBoolean(true);
+}
+
+
 /*
  * FormatBlanksCommand class
  */
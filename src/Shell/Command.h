@@ -79,7 +79,9 @@ DECL_SHELL_COMMAND( IncludePathCommand           );
 DECL_SHELL_COMMAND( WarnCommand                  );
 DECL_SHELL_COMMAND( ShowASTCommand               );
 DECL_SHELL_COMMAND( ShowTimesCommand             );
+DECL_SHELL_COMMAND( ShowMemoryCommand            );
 DECL_SHELL_COMMAND( ReflectCommand               );
+DECL_SHELL_COMMAND( PipelineCommand              );
 DECL_SHELL_COMMAND( PPOnlyCommand                );
 DECL_SHELL_COMMAND( MacroCommand                 );
 DECL_SHELL_COMMAND( SemanticCommand              );
@@ -92,12 +94,32 @@ DECL_SHELL_COMMAND( OptimizeCommand              );
 DECL_SHELL_COMMAND( ExtensionCommand             );
 DECL_SHELL_COMMAND( EnumExtensionCommand         );
 DECL_SHELL_COMMAND( ValidateCommand              );
+DECL_SHELL_COMMAND( DiagnosticsCommand           );
 DECL_SHELL_COMMAND( BindingCommand               );
 DECL_SHELL_COMMAND( CommentCommand               );
 DECL_SHELL_COMMAND( WrapperCommand               );
 DECL_SHELL_COMMAND( UnrollInitializerCommand     );
 DECL_SHELL_COMMAND( ObfuscateCommand             );
+DECL_SHELL_COMMAND( PreshaderCommand             );
+DECL_SHELL_COMMAND( ConstantTablesCommand        );
+DECL_SHELL_COMMAND( FastMathCommand              );
+DECL_SHELL_COMMAND( PushConstantsCommand         );
+DECL_SHELL_COMMAND( UniformStorageBuffersCommand );
+DECL_SHELL_COMMAND( PackVaryingsCommand          );
+DECL_SHELL_COMMAND( PositionOnlyCommand          );
+DECL_SHELL_COMMAND( FlatVaryingsCommand          );
+DECL_SHELL_COMMAND( FlatInputCommand             );
+DECL_SHELL_COMMAND( VectorizeCommand             );
+DECL_SHELL_COMMAND( ScalarReplacementCommand     );
+DECL_SHELL_COMMAND( LoopOptimizationCommand      );
+DECL_SHELL_COMMAND( ProfileCountersCommand       );
+DECL_SHELL_COMMAND( ProfileGuidedCommand         );
 DECL_SHELL_COMMAND( RowMajorAlignmentCommand     );
+DECL_SHELL_COMMAND( JobsCommand                  );
+DECL_SHELL_COMMAND( TimingDatabaseCommand        );
+DECL_SHELL_COMMAND( IsolateCommand               );
+DECL_SHELL_COMMAND( IncludeCacheCommand          );
+DECL_SHELL_COMMAND( ParallelParseCommand         );
 
 DECL_SHELL_COMMAND( FormatBlanksCommand          );
 DECL_SHELL_COMMAND( FormatLineMarksCommand       );
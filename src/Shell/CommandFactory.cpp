@@ -61,7 +61,9 @@ CommandFactory::CommandFactory()
         WarnCommand,
         ShowASTCommand,
         ShowTimesCommand,
+        ShowMemoryCommand,
         ReflectCommand,
+        PipelineCommand,
         PPOnlyCommand,
         MacroCommand,
         SemanticCommand,
@@ -74,12 +76,32 @@ CommandFactory::CommandFactory()
         ExtensionCommand,
         EnumExtensionCommand,
         ValidateCommand,
+        DiagnosticsCommand,
         BindingCommand,
         CommentCommand,
         WrapperCommand,
         UnrollInitializerCommand,
         ObfuscateCommand,
+        PreshaderCommand,
+        ConstantTablesCommand,
+        FastMathCommand,
+        PushConstantsCommand,
+        UniformStorageBuffersCommand,
+        PackVaryingsCommand,
+        PositionOnlyCommand,
+        FlatVaryingsCommand,
+        FlatInputCommand,
+        VectorizeCommand,
+        ScalarReplacementCommand,
+        LoopOptimizationCommand,
+        ProfileCountersCommand,
+        ProfileGuidedCommand,
         RowMajorAlignmentCommand,
+        JobsCommand,
+        TimingDatabaseCommand,
+        IsolateCommand,
+        IncludeCacheCommand,
+        ParallelParseCommand,
 
         FormatBlanksCommand,
         FormatLineMarksCommand,
@@ -8,11 +8,13 @@
 #include "Shell.h"
 #include "CommandFactory.h"
 #include "Helper.h"
+#include <Xsc/Batch.h>
 #include <iostream>
 #include <sstream>
 #include <fstream>
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 
 #ifdef _WIN32
 #include <conio.h>
@@ -42,6 +44,12 @@ static void PrintBackdoorEasterEgg(std::ostream& output)
 
 #endif
 
+// Returns true if no output code is generated with the specified options.
+static bool IsValidationOnly(const Options& options)
+{
+    return (options.validateOnly || options.diagnosticsMode);
+}
+
 Shell* Shell::instance_ = nullptr;
 
 Shell::Shell(std::ostream& output) :
@@ -69,6 +77,10 @@ void Shell::ExecuteCommandLine(CommandLine& cmdLine)
         return;
     }
 
+    ++executionDepth_;
+
+    const bool batchCompileEnabled = state_.batchCompile;
+
     try
     {
         /* Pares all arguments from command line */
@@ -125,6 +137,28 @@ void Shell::ExecuteCommandLine(CommandLine& cmdLine)
         /* Print error message */
         output << e.what() << std::endl;
     }
+
+    /* Packing map of the previous stage is only passed on within the same command line */
+    packedOutputs_.clear();
+
+    /* Compile collected files separately for each command line that enabled the batch compilation (e.g. for each presetting) */
+    if (state_.batchCompile && !batchCompileEnabled && executionDepth_ > 1)
+        CompileBatch();
+
+    /* Merge pipeline stages of each command line separately (e.g. for each presetting), unless they are still compiled in a batch */
+    if (batchJobs_.empty())
+        MergePipeline();
+
+    /* Compile all collected files when the outermost command line has been parsed */
+    if (--executionDepth_ == 0)
+    {
+        CompileBatch();
+        MergePipeline();
+
+        /* Show statistics of the include memo */
+        if (state_.verbose && includeCache_.NumHits() + includeCache_.NumMisses() > 0)
+            output << "include cache: " << includeCache_.NumHits() << " hit(s), " << includeCache_.NumMisses() << " miss(es)" << std::endl;
+    }
 }
 
 void Shell::WaitForUser()
@@ -186,102 +220,264 @@ void Shell::Compile(const std::string& filename)
 {
     lastOutputFilename_.clear();
 
-    const auto  defaultOutputFilename   = GetDefaultOutputFilename(filename);
-    auto        outputFilename          = state_.outputFilename;
-
-    if (outputFilename.empty())
-        outputFilename = defaultOutputFilename;
-    else
-        Replace(outputFilename, "*", defaultOutputFilename);
-
     try
     {
-        /* Add pre-defined macros at the top of the input stream */
-        auto inputStream = std::make_shared<std::stringstream>();
-        
-        for (const auto& macro : state_.predefinedMacros)
+        auto job = MakeCompileJob(filename);
+
+        if (state_.batchCompile)
         {
-            *inputStream << "#define " << macro.ident;
-            if (!macro.value.empty())
-                *inputStream << ' ' << macro.value;
-            *inputStream << std::endl;
+            /* Defer compilation until all files have been collected */
+            batchJobs_.push_back(std::move(job));
+            return;
         }
 
-        /* Open input stream */
-        state_.inputDesc.filename = filename;
+        /* Show compilation/validation status */
+        PrintCompileStatus(*job);
+
+        /* Compile shader file */
+        job->result = CompileShader(
+            job->state.inputDesc,
+            job->state.outputDesc,
+            &(job->log),
+            (job->state.showReflection || job->state.mergePipeline || job->state.outputDesc.options.packVaryings ? &(job->reflectionData) : nullptr)
+        );
 
-        std::ifstream inputFile(filename);
-        if (!inputFile.good())
-            throw std::runtime_error("failed to read file: \"" + filename + "\"");
+        FinishCompileJob(*job);
+    }
+    catch (const std::exception& err)
+    {
+        /* Print error message */
+        output << err.what() << std::endl;
+    }
+}
+
+Shell::CompileJobPtr Shell::MakeCompileJob(const std::string& filename)
+{
+    auto job = MakeUnique<CompileJob>();
 
-        *inputStream << inputFile.rdbuf();
+    job->state      = state_;
+    job->filename   = filename;
 
-        std::stringstream outputStream;
+    const auto defaultOutputFilename = GetDefaultOutputFilename(filename);
 
-        /* Initialize input and output descriptors */
-        state_.inputDesc.sourceCode  = inputStream;
-        state_.outputDesc.sourceCode = &outputStream;
+    job->outputFilename = state_.outputFilename;
 
-        /* Final setup before compilation */
-        StdLog                      log;
-        IncludeHandler              includeHandler;
-        Reflection::ReflectionData  reflectionData;
+    if (job->outputFilename.empty())
+        job->outputFilename = defaultOutputFilename;
+    else
+        Replace(job->outputFilename, "*", defaultOutputFilename);
+
+    /* Add pre-defined macros at the top of the input stream */
+    auto inputStream = std::make_shared<std::stringstream>();
         
-        includeHandler.searchPaths = state_.searchPaths;
-        state_.inputDesc.includeHandler = &includeHandler;
+    for (const auto& macro : state_.predefinedMacros)
+    {
+        *inputStream << "#define " << macro.ident;
+        if (!macro.value.empty())
+            *inputStream << ' ' << macro.value;
+        *inputStream << std::endl;
+    }
 
-        /* Show compilation/validation status */
-        if (state_.verbose)
+    /* Open input stream */
+    std::ifstream inputFile(filename);
+    if (!inputFile.good())
+        throw std::runtime_error("failed to read file: \"" + filename + "\"");
+
+    *inputStream << inputFile.rdbuf();
+
+    /* Initialize input and output descriptors */
+    job->state.inputDesc.filename       = filename;
+    job->state.inputDesc.sourceCode     = inputStream;
+    job->state.outputDesc.sourceCode    = &(job->outputStream);
+
+    if (state_.outputDesc.options.preprocessOnly && !IsValidationOnly(state_.outputDesc.options))
+    {
+        /* Write pre-processed code directly into the output file, to avoid buffering the entire output */
+        job->outputFile.open(job->outputFilename);
+        if (!job->outputFile.good())
+            throw std::runtime_error("failed to write file: \"" + job->outputFilename + "\"");
+        job->state.outputDesc.sourceCode = &(job->outputFile);
+    }
+
+    /* Final setup before compilation */
+    job->includeHandler.searchPaths     = state_.searchPaths;
+    job->state.inputDesc.includeHandler = &(job->includeHandler);
+
+    if (state_.includeCache)
+        job->state.inputDesc.includeCache = &includeCache_;
+
+    /* Pack fragment shader inputs with the packing map of the previous stage */
+    if (state_.outputDesc.options.packVaryings &&
+        state_.inputDesc.shaderTarget == ShaderTarget::FragmentShader &&
+        job->state.outputDesc.packedInputLayout.empty())
+    {
+        job->state.outputDesc.packedInputLayout = packedOutputs_;
+    }
+
+    return job;
+}
+
+void Shell::PrintCompileStatus(const CompileJob& job)
+{
+    if (job.state.verbose)
+    {
+        if (IsValidationOnly(job.state.outputDesc.options))
+            output << "validate \"" << job.filename << '\"' << std::endl;
+        else
+            output << "compile \"" << job.filename << "\" to \"" << job.outputFilename << '\"' << std::endl;
+    }
+}
+
+void Shell::FinishCompileJob(CompileJob& job)
+{
+    const auto& state = job.state;
+
+    /* Print all reports to the log output */
+    job.log.PrintAll(state.verbose, state.outputDesc.options.warnings);
+
+    if (job.result)
+    {
+        if (!IsValidationOnly(state.outputDesc.options))
         {
-            if (state_.outputDesc.options.validateOnly)
-                output << "validate \"" << filename << '\"' << std::endl;
+            if (state.verbose)
+                output << "compilation successful" << std::endl;
+
+            /* Write result to output stream only on success */
+            if (job.outputFile.is_open())
+                job.outputFile.close();
             else
-                output << "compile \"" << filename << "\" to \"" << outputFilename << '\"' << std::endl;
+            {
+                std::ofstream outputFile(job.outputFilename);
+                if (outputFile.good())
+                    outputFile << job.outputStream.rdbuf();
+                else
+                    throw std::runtime_error("failed to write file: \"" + job.outputFilename + "\"");
+            }
+
+            /* Store output filename after successful compilation */
+            lastOutputFilename_ = job.outputFilename;
+        }
+        else if (state.verbose)
+            output << "validation successful" << std::endl;
+    }
+    else
+    {
+        /* Remove incomplete output file */
+        if (job.outputFile.is_open())
+        {
+            job.outputFile.close();
+            std::remove(job.outputFilename.c_str());
         }
 
-        /* Compile shader file */
-        auto result = CompileShader(
-            state_.inputDesc,
-            state_.outputDesc,
-            &log,
-            (state_.showReflection ? &reflectionData : nullptr)
-        );
+        /* Always print message on failure */
+        if (IsValidationOnly(state.outputDesc.options))
+            output << "validation failed" << std::endl;
+        else
+            output << "compilation failed" << std::endl;
+    }
 
-        /* Print all reports to the log output */
-        log.PrintAll(state_.verbose, state_.outputDesc.options.warnings);
+    /* Show output statistics (if enabled) */
+    if (state.showReflection)
+        PrintReflection(output, job.reflectionData);
 
-        if (result)
+    /* Store packing map of successfully compiled vertex and domain shaders for the next fragment shader */
+    if (state.outputDesc.options.packVaryings && job.result &&
+        (state.inputDesc.shaderTarget == ShaderTarget::VertexShader || state.inputDesc.shaderTarget == ShaderTarget::TessellationEvaluationShader))
+    {
+        packedOutputs_ = job.reflectionData.packedOutputs;
+    }
+
+    /* Collect pipeline stage of successfully compiled shaders */
+    if (state.mergePipeline && job.result)
+        pipelineStages_.push_back({ state.inputDesc.shaderTarget, job.reflectionData });
+}
+
+void Shell::CompileBatch()
+{
+    if (batchJobs_.empty())
+        return;
+
+    auto jobs = std::move(batchJobs_);
+    batchJobs_.clear();
+
+    try
+    {
+        /* Compile all jobs in parallel */
+        std::vector<BatchJob> batchJobs(jobs.size());
+
+        for (std::size_t i = 0; i < jobs.size(); ++i)
         {
-            if (!state_.outputDesc.options.validateOnly)
-            {
-                if (state_.verbose)
-                    output << "compilation successful" << std::endl;
+            auto& job = *jobs[i];
+            batchJobs[i].inputDesc      = job.state.inputDesc;
+            batchJobs[i].outputDesc     = job.state.outputDesc;
+            batchJobs[i].log            = &(job.log);
+            batchJobs[i].reflectionData = (job.state.showReflection || job.state.mergePipeline ? &(job.reflectionData) : nullptr);
+        }
 
-                /* Write result to output stream only on success */
-                std::ofstream outputFile(outputFilename);
-                if (outputFile.good())
-                    outputFile << outputStream.rdbuf();
-                else
-                    throw std::runtime_error("failed to write file: \"" + outputFilename + "\"");
+        const auto& batchState = jobs.front()->state;
+
+        BatchDescriptor batchDesc;
+        {
+            batchDesc.numThreads        = batchState.batchThreads;
+            batchDesc.timingDatabase    = batchState.timingDatabase;
+            batchDesc.isolateProcesses  = batchState.batchIsolation;
+        }
+        BatchReport batchReport;
 
-                /* Store output filename after successful compilation */
-                lastOutputFilename_ = outputFilename;
+        CompileShaderBatch(batchJobs, batchDesc, &batchReport);
+
+        /* Print reports and write output files in the order the files were specified */
+        for (std::size_t i = 0; i < jobs.size(); ++i)
+        {
+            auto& job = *jobs[i];
+            job.result = batchReport.results[i].succeeded;
+
+            try
+            {
+                PrintCompileStatus(job);
+                FinishCompileJob(job);
+            }
+            catch (const std::exception& err)
+            {
+                output << err.what() << std::endl;
             }
-            else if (state_.verbose)
-                output << "validation successful" << std::endl;
         }
-        else
+
+        if (batchState.verbose)
+            PrintBatchReport(output, batchReport);
+    }
+    catch (const std::exception& err)
+    {
+        /* Print error message */
+        output << err.what() << std::endl;
+    }
+}
+
+void Shell::MergePipeline()
+{
+    if (pipelineStages_.empty())
+        return;
+
+    auto pipelineStages = std::move(pipelineStages_);
+    pipelineStages_.clear();
+
+    try
+    {
+        std::vector<Reflection::PipelineStage> stages;
+        for (const auto& stage : pipelineStages)
+            stages.push_back({ stage.first, &(stage.second) });
+
+        /* Merge reflection of all stages, and print the diagnosed conflicts before the layout */
+        Reflection::PipelineLayout layout;
+        StdLog log;
+
+        if (!MergeReflection(stages, layout, &log))
         {
-            /* Always print message on failure */
-            if (state_.outputDesc.options.validateOnly)
-                output << "validation failed" << std::endl;
-            else
-                output << "compilation failed" << std::endl;
+            log.PrintAll(state_.verbose);
+            output << "pipeline merge failed" << std::endl;
         }
 
-        /* Show output statistics (if enabled) */
-        if (state_.showReflection)
-            PrintReflection(output, reflectionData);
+        PrintPipelineLayout(output, layout);
     }
     catch (const std::exception& err)
     {
@@ -11,10 +11,15 @@
 
 #include <Xsc/IndentHandler.h>
 #include <Xsc/Reflection.h>
+#include <Xsc/Pipeline.h>
 #include "ShellState.h"
 #include "CommandLine.h"
 #include <ostream>
+#include <sstream>
+#include <fstream>
 #include <stack>
+#include <vector>
+#include <memory>
 
 
 namespace Xsc
@@ -58,14 +63,53 @@ class Shell
 
     private:
 
+        // Compilation job for a single shader file with a snapshot of the shell state.
+        struct CompileJob
+        {
+            ShellState                  state;
+            std::string                 filename;
+            std::string                 outputFilename;
+            std::stringstream           outputStream;
+            std::ofstream               outputFile;     // Output file for pre-processed code, which is written directly (see Options::preprocessOnly).
+            StdLog                      log;
+            IncludeHandler              includeHandler;
+            Reflection::ReflectionData  reflectionData;
+            bool                        result          = false;
+        };
+
+        using CompileJobPtr = std::unique_ptr<CompileJob>;
+
         std::string GetDefaultOutputFilename(const std::string& filename) const;
 
         void Compile(const std::string& filename);
 
-        ShellState              state_;
-        std::stack<ShellState>  stateStack_;
+        CompileJobPtr MakeCompileJob(const std::string& filename);
+
+        void PrintCompileStatus(const CompileJob& job);
+        void FinishCompileJob(CompileJob& job);
+
+        // Compiles all collected batch jobs in parallel.
+        void CompileBatch();
+
+        // Merges the code reflection of all collected pipeline stages, and prints the pipeline layout.
+        void MergePipeline();
+
+        ShellState                  state_;
+        std::stack<ShellState>      stateStack_;
+
+        std::string                 lastOutputFilename_;
+
+        std::vector<CompileJobPtr>  batchJobs_;
+
+        // Shader targets and code reflection of all successfully compiled shaders (see ShellState::mergePipeline).
+        std::vector<std::pair<ShaderTarget, Reflection::ReflectionData>> pipelineStages_;
+
+        // Packing map of the last successfully compiled vertex or domain shader (see Options::packVaryings).
+        std::vector<Reflection::PackedVarying> packedOutputs_;
+
+        int                         executionDepth_     = 0;
 
-        std::string             lastOutputFilename_;
+        IncludeCache                includeCache_;
 
         static Shell*           instance_;
 
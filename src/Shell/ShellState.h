@@ -51,6 +51,24 @@ struct ShellState
     // Show code reflection output after compilation.
     bool                            showReflection      = false;
 
+    // Merge the code reflection of all compiled shaders into a pipeline layout (after all arguments have been parsed).
+    bool                            mergePipeline       = false;
+
+    // Compile all files as one batch with parallel worker threads (after all arguments have been parsed).
+    bool                            batchCompile        = false;
+
+    // Number of worker threads for batch compilation (0 for the number of hardware threads).
+    unsigned                        batchThreads        = 0;
+
+    // Filename of the timing database for batch compilation.
+    std::string                     timingDatabase;
+
+    // Compile batch jobs in crash-isolated worker processes.
+    bool                            batchIsolation      = false;
+
+    // Share the expansions of include files between all compiled files.
+    bool                            includeCache        = false;
+
     // True, if any meaningful action has been performed (e.g. printed version or compiled any files).
     bool                            actionPerformed     = false;
 };
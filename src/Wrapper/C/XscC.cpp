@@ -9,6 +9,8 @@
 #include <XscC/XscC.h>
 #include <string.h>
 #include <sstream>
+#include <algorithm>
+#include <memory>
 #include "Helper.h"
 
 
@@ -44,17 +46,24 @@ extern "C" {
 
 struct CompilerContext
 {
-    std::string                     outputCode;
+    std::string                                         outputCode;
 
-    Xsc::Reflection::ReflectionData reflection;
+    Xsc::Reflection::ReflectionData                     reflection;
 
-    std::vector<const char*>        macros;
-    std::vector<XscBindingSlot>     textures;
-    std::vector<XscBindingSlot>     storageBuffers;
-    std::vector<XscBindingSlot>     constantBuffers;
-    std::vector<XscBindingSlot>     inputAttributes;
-    std::vector<XscBindingSlot>     outputAttributes;
-    std::vector<XscSamplerState>    samplerStates;
+    std::vector<const char*>                            macros;
+    std::vector<XscBindingSlot>                         textures;
+    std::vector<XscBindingSlot>                         storageBuffers;
+    std::vector<XscBindingSlot>                         constantBuffers;
+    std::vector<XscBindingSlot>                         inputAttributes;
+    std::vector<XscBindingSlot>                         outputAttributes;
+    std::vector<XscSamplerState>                        samplerStates;
+    std::vector<XscConstantTable>                       constantTables;
+    std::vector<XscPackedVarying>                       packedInputs;
+    std::vector<XscPackedVarying>                       packedOutputs;
+    std::vector<XscProfileCounter>                      profileCounters;
+
+    std::vector<XscPreshaderExpression>                 preshaders;
+    std::vector<std::vector<XscPreshaderInstruction>>   preshaderInstructions;
 };
 
 static struct CompilerContext g_compilerContext;
@@ -81,6 +90,7 @@ static void InitializeOptions(struct XscOptions* s)
     s->optimize                 = false;
     s->preprocessOnly           = false;
     s->validateOnly             = false;
+    s->diagnosticsMode          = false;
     s->allowExtensions          = false;
     s->explicitBinding          = false;
     s->preserveComments         = false;
@@ -88,8 +98,22 @@ static void InitializeOptions(struct XscOptions* s)
     s->unrollArrayInitializers  = false;
     s->rowMajorAlignment        = false;
     s->obfuscate                = false;
+    s->extractPreshaders        = false;
+    s->constantTableThreshold   = 0;
+    s->fastMath                 = 0;
+    s->pushConstantBudget       = 0;
+    s->uniformStorageBufferSize = 0;
+    s->packVaryings             = false;
+    s->positionOnly             = false;
+    s->flatVaryings             = false;
+    s->vectorize                = false;
+    s->scalarReplacement        = false;
+    s->optimizeLoops            = false;
+    s->profileCounters          = false;
+    s->parallelParsing          = false;
     s->showAST                  = false;
     s->showTimes                = false;
+    s->showMemory               = false;
 }
 
 static void InitializeNameMangling(struct XscNameMangling* s)
@@ -107,6 +131,14 @@ static void InitializeIncludeHandler(struct XscIncludeHandler* s)
     s->searchPaths      = NULL;
 }
 
+static void InitializeTaskScheduler(struct XscTaskScheduler* s)
+{
+    s->submitTaskPfn    = NULL;
+    s->waitTaskGroupPfn = NULL;
+    s->concurrencyPfn   = NULL;
+    s->userData         = NULL;
+}
+
 static void InitializeShaderInput(struct XscShaderInput* s)
 {
     s->filename             = NULL;
@@ -117,6 +149,7 @@ static void InitializeShaderInput(struct XscShaderInput* s)
     s->secondaryEntryPoint  = NULL;
 
     InitializeIncludeHandler(&(s->includeHandler));
+    InitializeTaskScheduler(&(s->taskScheduler));
 }
 
 static void InitializeShaderOutput(struct XscShaderOutput* s)
@@ -126,6 +159,12 @@ static void InitializeShaderOutput(struct XscShaderOutput* s)
     s->shaderVersion        = XscEOutputGLSL;
     s->vertexSemantics      = NULL;
     s->vertexSemanticsCount = 0;
+    s->flatInputSemantics       = NULL;
+    s->flatInputSemanticsCount  = 0;
+    s->packedInputLayout        = NULL;
+    s->packedInputLayoutCount   = 0;
+    s->profileCounts            = NULL;
+    s->profileCountsCount       = 0;
 
     InitializeOptions(&(s->options));
     InitializeFormatting(&(s->formatting));
@@ -147,11 +186,33 @@ static bool ValidateShaderInput(const struct XscShaderInput* s)
 
 static bool ValidateShaderOutput(const struct XscShaderOutput* s)
 {
-    return (s != NULL && s->sourceCode != NULL && (s->vertexSemanticsCount == 0 || s->vertexSemantics != NULL));
+    return
+    (
+        s != NULL && s->sourceCode != NULL &&
+        (s->vertexSemanticsCount == 0 || s->vertexSemantics != NULL) &&
+        (s->flatInputSemanticsCount == 0 || s->flatInputSemantics != NULL) &&
+        (s->packedInputLayoutCount == 0 || s->packedInputLayout != NULL) &&
+        (s->profileCountsCount == 0 || s->profileCounts != NULL)
+    );
 }
 
 static void CopyReflection(const Xsc::Reflection::ReflectionData& src, struct XscReflectionData* dst)
 {
+    /* Clear context buffers of previous compilation */
+    g_compilerContext.macros.clear();
+    g_compilerContext.textures.clear();
+    g_compilerContext.storageBuffers.clear();
+    g_compilerContext.constantBuffers.clear();
+    g_compilerContext.inputAttributes.clear();
+    g_compilerContext.outputAttributes.clear();
+    g_compilerContext.samplerStates.clear();
+    g_compilerContext.constantTables.clear();
+    g_compilerContext.packedInputs.clear();
+    g_compilerContext.packedOutputs.clear();
+    g_compilerContext.profileCounters.clear();
+    g_compilerContext.preshaders.clear();
+    g_compilerContext.preshaderInstructions.clear();
+
     /* Fill context buffers */
     for (const auto& s : src.macros)
         g_compilerContext.macros.push_back(s.c_str());
@@ -159,16 +220,16 @@ static void CopyReflection(const Xsc::Reflection::ReflectionData& src, struct Xs
     for (const auto& s : src.textures)
         g_compilerContext.textures.push_back({ s.ident.c_str(), s.location });
 
-    for (const auto& s : src.textures)
+    for (const auto& s : src.storageBuffers)
         g_compilerContext.storageBuffers.push_back({ s.ident.c_str(), s.location });
 
-    for (const auto& s : src.textures)
+    for (const auto& s : src.constantBuffers)
         g_compilerContext.constantBuffers.push_back({ s.ident.c_str(), s.location });
 
-    for (const auto& s : src.textures)
+    for (const auto& s : src.inputAttributes)
         g_compilerContext.inputAttributes.push_back({ s.ident.c_str(), s.location });
 
-    for (const auto& s : src.textures)
+    for (const auto& s : src.outputAttributes)
         g_compilerContext.outputAttributes.push_back({ s.ident.c_str(), s.location });
 
     for (const auto& s : src.samplerStates)
@@ -195,6 +256,49 @@ static void CopyReflection(const Xsc::Reflection::ReflectionData& src, struct Xs
         );
     }
 
+    for (const auto& s : src.packedInputs)
+        g_compilerContext.packedInputs.push_back({ s.semantic.c_str(), s.slotIdent.c_str(), s.slot, s.firstComponent, s.numComponents });
+
+    for (const auto& s : src.packedOutputs)
+        g_compilerContext.packedOutputs.push_back({ s.semantic.c_str(), s.slotIdent.c_str(), s.slot, s.firstComponent, s.numComponents });
+
+    for (const auto& s : src.profileCounters)
+        g_compilerContext.profileCounters.push_back({ s.index, static_cast<XscProfileCounterType>(s.type), s.function.c_str(), s.location.c_str() });
+
+    /* Fill instruction lists first, since the expressions refer to them */
+    for (const auto& s : src.preshaders)
+    {
+        std::vector<XscPreshaderInstruction> instructions;
+        for (const auto& instr : s.instructions)
+        {
+            instructions.push_back(
+                {
+                    static_cast<XscPreshaderOpcode>(instr.opcode),
+                    instr.value.c_str(),
+                    instr.numOperands,
+                    instr.type.c_str()
+                }
+            );
+        }
+        g_compilerContext.preshaderInstructions.push_back(std::move(instructions));
+    }
+
+    for (std::size_t i = 0; i < src.preshaders.size(); ++i)
+    {
+        const auto& instructions = g_compilerContext.preshaderInstructions[i];
+        g_compilerContext.preshaders.push_back(
+            {
+                src.preshaders[i].ident.c_str(),
+                src.preshaders[i].type.c_str(),
+                instructions.data(),
+                instructions.size()
+            }
+        );
+    }
+
+    for (const auto& s : src.constantTables)
+        g_compilerContext.constantTables.push_back({ s.ident.c_str(), s.type.c_str(), s.size, s.offset, s.stride });
+
     /* Set references to output buffers */
     dst->macros                 = g_compilerContext.macros.data();
     dst->macrosCount            = g_compilerContext.macros.size();
@@ -221,6 +325,26 @@ static void CopyReflection(const Xsc::Reflection::ReflectionData& src, struct Xs
     dst->numThreads.x = src.numThreads.x;
     dst->numThreads.y = src.numThreads.y;
     dst->numThreads.z = src.numThreads.z;
+
+    dst->packedInputs           = g_compilerContext.packedInputs.data();
+    dst->packedInputsCount      = g_compilerContext.packedInputs.size();
+    dst->packedOutputs          = g_compilerContext.packedOutputs.data();
+    dst->packedOutputsCount     = g_compilerContext.packedOutputs.size();
+
+    dst->preshaderBuffer        = src.preshaderBuffer.c_str();
+    dst->preshaders             = g_compilerContext.preshaders.data();
+    dst->preshadersCount        = g_compilerContext.preshaders.size();
+
+    dst->constantTableBuffer    = src.constantTableBuffer.c_str();
+    dst->constantTables         = g_compilerContext.constantTables.data();
+    dst->constantTablesCount    = g_compilerContext.constantTables.size();
+    dst->constantTableData      = src.constantTableData.data();
+    dst->constantTableDataSize  = src.constantTableData.size();
+
+    dst->profileCounterBuffer.ident     = src.profileCounterBuffer.ident.c_str();
+    dst->profileCounterBuffer.location  = src.profileCounterBuffer.location;
+    dst->profileCounters                = g_compilerContext.profileCounters.data();
+    dst->profileCountersCount           = g_compilerContext.profileCounters.size();
 }
 
 
@@ -264,6 +388,68 @@ std::unique_ptr<std::istream> IncludeHandlerC::Include(const std::string& filena
 }
 
 
+/*
+ * TaskSchedulerC class
+ */
+
+class TaskSchedulerC : public Xsc::TaskScheduler
+{
+
+    public:
+
+        TaskSchedulerC(const XscTaskScheduler& scheduler);
+
+        void Submit(Xsc::TaskGroup group, const Task& task) override;
+        void Wait(Xsc::TaskGroup group) override;
+        unsigned Concurrency() const override;
+
+        // Returns true if all callbacks are specified.
+        bool IsValid() const;
+
+    private:
+
+        static void RunTask(void* taskData);
+
+        XscTaskScheduler scheduler_;
+
+};
+
+TaskSchedulerC::TaskSchedulerC(const XscTaskScheduler& scheduler)
+{
+    scheduler_.submitTaskPfn    = scheduler.submitTaskPfn;
+    scheduler_.waitTaskGroupPfn = scheduler.waitTaskGroupPfn;
+    scheduler_.concurrencyPfn   = scheduler.concurrencyPfn;
+    scheduler_.userData         = scheduler.userData;
+}
+
+void TaskSchedulerC::Submit(Xsc::TaskGroup group, const Task& task)
+{
+    /* Pass copy of the task function to the callback, which is deleted after its execution */
+    scheduler_.submitTaskPfn(scheduler_.userData, group, TaskSchedulerC::RunTask, new Task(task));
+}
+
+void TaskSchedulerC::Wait(Xsc::TaskGroup group)
+{
+    scheduler_.waitTaskGroupPfn(scheduler_.userData, group);
+}
+
+unsigned TaskSchedulerC::Concurrency() const
+{
+    return std::max(1u, scheduler_.concurrencyPfn(scheduler_.userData));
+}
+
+bool TaskSchedulerC::IsValid() const
+{
+    return (scheduler_.submitTaskPfn != NULL && scheduler_.waitTaskGroupPfn != NULL && scheduler_.concurrencyPfn != NULL);
+}
+
+void TaskSchedulerC::RunTask(void* taskData)
+{
+    std::unique_ptr<Task> task(reinterpret_cast<Task*>(taskData));
+    (*task)();
+}
+
+
 /*
  * LogC class
  */
@@ -333,6 +519,7 @@ XSC_EXPORT bool XscCompileShader(
     Xsc::ShaderInput in;
 
     IncludeHandlerC includeHandler(inputDesc->includeHandler);
+    TaskSchedulerC taskScheduler(inputDesc->taskScheduler);
 
     auto inputStream = std::make_shared<std::stringstream>();
     *inputStream << inputDesc->sourceCode;
@@ -344,6 +531,7 @@ XSC_EXPORT bool XscCompileShader(
     in.entryPoint           = ReadStringC(inputDesc->entryPoint);
     in.secondaryEntryPoint  = ReadStringC(inputDesc->secondaryEntryPoint);
     in.includeHandler       = (&includeHandler);
+    in.taskScheduler        = (taskScheduler.IsValid() ? &taskScheduler : nullptr);
 
     /* Copy output descriptor */
     Xsc::ShaderOutput out;
@@ -361,11 +549,33 @@ XSC_EXPORT bool XscCompileShader(
         out.vertexSemantics[i].location = outputDesc->vertexSemantics[i].location;
     }
 
+    out.flatInputSemantics.resize(outputDesc->flatInputSemanticsCount);
+    for (size_t i = 0; i < outputDesc->flatInputSemanticsCount; ++i)
+        out.flatInputSemantics[i] = ReadStringC(outputDesc->flatInputSemantics[i]);
+
+    out.packedInputLayout.resize(outputDesc->packedInputLayoutCount);
+    for (size_t i = 0; i < outputDesc->packedInputLayoutCount; ++i)
+    {
+        out.packedInputLayout[i].semantic       = ReadStringC(outputDesc->packedInputLayout[i].semantic);
+        out.packedInputLayout[i].slotIdent      = ReadStringC(outputDesc->packedInputLayout[i].slotIdent);
+        out.packedInputLayout[i].slot           = outputDesc->packedInputLayout[i].slot;
+        out.packedInputLayout[i].firstComponent = outputDesc->packedInputLayout[i].firstComponent;
+        out.packedInputLayout[i].numComponents  = outputDesc->packedInputLayout[i].numComponents;
+    }
+
+    out.profileCounts.resize(outputDesc->profileCountsCount);
+    for (size_t i = 0; i < outputDesc->profileCountsCount; ++i)
+    {
+        out.profileCounts[i].location   = ReadStringC(outputDesc->profileCounts[i].location);
+        out.profileCounts[i].count      = outputDesc->profileCounts[i].count;
+    }
+
     /* Copy output options descriptor */
     out.options.warnings                = outputDesc->options.warnings;
     out.options.optimize                = outputDesc->options.optimize;
     out.options.preprocessOnly          = outputDesc->options.preprocessOnly;
     out.options.validateOnly            = outputDesc->options.validateOnly;
+    out.options.diagnosticsMode         = outputDesc->options.diagnosticsMode;
     out.options.allowExtensions         = outputDesc->options.allowExtensions;
     out.options.explicitBinding         = outputDesc->options.explicitBinding;
     out.options.preserveComments        = outputDesc->options.preserveComments;
@@ -373,8 +583,22 @@ XSC_EXPORT bool XscCompileShader(
     out.options.unrollArrayInitializers = outputDesc->options.unrollArrayInitializers;
     out.options.rowMajorAlignment       = outputDesc->options.rowMajorAlignment;
     out.options.obfuscate               = outputDesc->options.obfuscate;
+    out.options.extractPreshaders       = outputDesc->options.extractPreshaders;
+    out.options.constantTableThreshold  = outputDesc->options.constantTableThreshold;
+    out.options.fastMath                = outputDesc->options.fastMath;
+    out.options.pushConstantBudget      = outputDesc->options.pushConstantBudget;
+    out.options.uniformStorageBufferSize = outputDesc->options.uniformStorageBufferSize;
+    out.options.packVaryings            = outputDesc->options.packVaryings;
+    out.options.positionOnly            = outputDesc->options.positionOnly;
+    out.options.flatVaryings            = outputDesc->options.flatVaryings;
+    out.options.vectorize               = outputDesc->options.vectorize;
+    out.options.scalarReplacement       = outputDesc->options.scalarReplacement;
+    out.options.optimizeLoops           = outputDesc->options.optimizeLoops;
+    out.options.profileCounters         = outputDesc->options.profileCounters;
+    out.options.parallelParsing         = outputDesc->options.parallelParsing;
     out.options.showAST                 = outputDesc->options.showAST;
     out.options.showTimes               = outputDesc->options.showTimes;
+    out.options.showMemory              = outputDesc->options.showMemory;
 
     /* Copy output formatting descriptor */
     out.formatting.indent               = ReadStringC(outputDesc->formatting.indent);
@@ -402,9 +626,11 @@ XSC_EXPORT bool XscCompileShader(
     else
         logPrimaryRef = (&logPrimary);
 
-    /* Compile shader with C++ API */
+    /* Compile shader with C++ API (reset reflection of previous compilation) */
     bool result = false;
-    
+
+    g_compilerContext.reflection = Xsc::Reflection::ReflectionData();
+
     try
     {
         result = Xsc::CompileShader(
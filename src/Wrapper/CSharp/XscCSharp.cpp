@@ -250,6 +250,177 @@ public ref class XscCompiler
 
         };
 
+        //! Location of a shader input/output variable (also referred to as "varying") inside a packed slot.
+        ref class PackedVarying
+        {
+
+            public:
+
+                PackedVarying()
+                {
+                    Semantic        = nullptr;
+                    SlotIdent       = nullptr;
+                    Slot            = 0;
+                    FirstComponent  = 0;
+                    NumComponents   = 0;
+                }
+
+                //! Specifies the semantic of the varying (e.g. "TEXCOORD0").
+                property String^        Semantic;
+
+                //! Specifies the identifier of the packed slot variable (e.g. "xsv_pack0"). Ignored in ShaderOutput::PackedInputLayout.
+                property String^        SlotIdent;
+
+                //! Specifies the zero based index of the packed slot.
+                property int            Slot;
+
+                //! Specifies the zero based index of the first component inside the slot.
+                property unsigned int   FirstComponent;
+
+                //! Specifies the number of components of the varying (1 to 4).
+                property unsigned int   NumComponents;
+
+        };
+
+        //! Code region enumeration of a profiling counter.
+        enum class ProfileCounterType
+        {
+            Function,   //!< Counts the calls of a function.
+            Branch,     //!< Counts the executions of an 'if'/'else' body or a 'switch' case.
+            Loop,       //!< Counts the iterations of a loop body.
+        };
+
+        //! Execution counter of the profiling instrumentation (see OutputOptions::ProfileCounters).
+        ref class ProfileCounter
+        {
+
+            public:
+
+                ProfileCounter()
+                {
+                    Index       = 0;
+                    Type        = ProfileCounterType::Function;
+                    Function    = nullptr;
+                    Location    = nullptr;
+                }
+
+                //! Zero based index of the counter within the profiling counter buffer.
+                property unsigned int       Index;
+
+                //! Code region that is counted.
+                property ProfileCounterType Type;
+
+                //! Identifier of the function that contains the counted code region.
+                property String^            Function;
+
+                //! Source location of the counted code region (e.g. "Example.hlsl:12:5").
+                property String^            Location;
+
+        };
+
+        //! Preshader instruction opcode enumeration.
+        enum class PreshaderOpcode
+        {
+            Load,       //!< Pushes the value of the uniform 'Value' (e.g. "LightDir" or "Lights[2].Color").
+            Constant,   //!< Pushes the literal 'Value' (e.g. "2.2").
+            Unary,      //!< Pops one operand and pushes the result of the unary operator 'Value' (e.g. "-").
+            Binary,     //!< Pops two operands and pushes the result of the binary operator 'Value' (e.g. "*").
+            Select,     //!< Pops the condition, then- and else-operand (in this order of pushing), and pushes the selected value (i.e. "cond ? a : b").
+            Swizzle,    //!< Pops one operand and pushes its vector or matrix subscript 'Value' (e.g. "xyz").
+            Call,       //!< Pops 'NumOperands' arguments and pushes the result of the intrinsic or type constructor 'Value' (e.g. "pow" or "float4").
+            Cast,       //!< Pops one operand and pushes it casted to the type 'Value' (e.g. "float3").
+        };
+
+        //! Preshader instruction of a stack based expression program.
+        ref class PreshaderInstruction
+        {
+
+            public:
+
+                PreshaderInstruction()
+                {
+                    Opcode      = PreshaderOpcode::Load;
+                    Value       = nullptr;
+                    NumOperands = 0;
+                    Type        = nullptr;
+                }
+
+                //! Instruction opcode.
+                property PreshaderOpcode    Opcode;
+
+                //! Instruction value (see PreshaderOpcode).
+                property String^            Value;
+
+                //! Number of operands that are popped from the stack.
+                property unsigned int       NumOperands;
+
+                //! Data type of the result in the input language (e.g. "float4x4").
+                property String^            Type;
+
+        };
+
+        /**
+        \brief Uniform-only expression that has been extracted from the shader into a constant buffer member (see OutputOptions::ExtractPreshaders).
+        \remarks The instructions are in post-order, i.e. the result is the only value on the stack after all instructions have been executed.
+        */
+        ref class PreshaderExpression
+        {
+
+            public:
+
+                PreshaderExpression()
+                {
+                    Ident           = nullptr;
+                    Type            = nullptr;
+                    Instructions    = gcnew Collections::Generic::List<PreshaderInstruction^>();
+                }
+
+                //! Identifier of the constant buffer member that receives the result.
+                property String^                                            Ident;
+
+                //! Data type of the result in the input language (e.g. "float4x4").
+                property String^                                            Type;
+
+                //! Instructions of the expression program.
+                property Collections::Generic::List<PreshaderInstruction^>^ Instructions;
+
+        };
+
+        /**
+        \brief Static constant array that has been moved into a member of the constant table buffer (see OutputOptions::ConstantTableThreshold).
+        \remarks The initial values of all constant tables are stored in ReflectionData::ConstantTableData.
+        */
+        ref class ConstantTable
+        {
+
+            public:
+
+                ConstantTable()
+                {
+                    Ident   = nullptr;
+                    Type    = nullptr;
+                    Size    = 0;
+                    Offset  = 0;
+                    Stride  = 0;
+                }
+
+                //! Identifier of the constant buffer member.
+                property String^        Ident;
+
+                //! Data type of the array elements in the input language (e.g. "float2").
+                property String^        Type;
+
+                //! Number of array elements.
+                property unsigned int   Size;
+
+                //! Offset (in bytes) of the first array element within the constant table data.
+                property unsigned int   Offset;
+
+                //! Distance (in bytes) between two consecutive array elements.
+                property unsigned int   Stride;
+
+        };
+
         //! Structure for shader output statistics (e.g. texture/buffer binding points).
         ref class ReflectionData
         {
@@ -280,6 +451,36 @@ public ref class XscCompiler
                 //! 'numthreads' attribute of a compute shader.
                 property ComputeThreads^                                            NumThreads;
 
+                //! Shader input varyings that have been packed into slots (see OutputOptions::PackVaryings).
+                property Collections::Generic::List<PackedVarying^>^                PackedInputs;
+
+                //! Shader output varyings that have been packed into slots (see OutputOptions::PackVaryings). This can be passed as ShaderOutput::PackedInputLayout to the next shader stage.
+                property Collections::Generic::List<PackedVarying^>^                PackedOutputs;
+
+                //! Identifier of the constant buffer that holds the results of all preshader expressions. Empty if no expression has been extracted.
+                property String^                                                    PreshaderBuffer;
+
+                //! Uniform-only expressions that have been extracted from the shader (see OutputOptions::ExtractPreshaders).
+                property Collections::Generic::List<PreshaderExpression^>^          Preshaders;
+
+                //! Identifier of the constant buffer that holds all constant tables. Empty if no constant array has been moved.
+                property String^                                                    ConstantTableBuffer;
+
+                //! Static constant arrays that have been moved into the constant table buffer (see OutputOptions::ConstantTableThreshold).
+                property Collections::Generic::List<ConstantTable^>^                ConstantTables;
+
+                //! Initial data of the constant table buffer in the "std140" layout, which must be uploaded once by the application.
+                property array<System::Byte>^                                       ConstantTableData;
+
+                /**
+                \brief Binding slot of the synthesized buffer that holds all profiling counters (see OutputOptions::ProfileCounters). The identifier is empty if the output is not instrumented.
+                \remarks Each counter is a 32-bit unsigned integer, and the buffer must be cleared by the application before the instrumented shader is executed.
+                */
+                property BindingSlot^                                               ProfileCounterBuffer;
+
+                //! Profiling counters in the order of their indices within the profiling counter buffer.
+                property Collections::Generic::List<ProfileCounter^>^               ProfileCounters;
+
         };
 
         //! Formatting descriptor structure for the output shader.
@@ -322,6 +523,20 @@ public ref class XscCompiler
 
         };
 
+        //! Fast-math substitution flags enumeration (see OutputOptions::FastMath).
+        [System::Flags]
+        enum class FastMathFlags : unsigned int
+        {
+            None        = 0,        //!< No fast-math substitutions.
+            PowToMul    = (1 << 0), //!< Replaces 'pow' with a constant exponent of -0.5, 0.5, 1, 2, 3, or 4 by 'inversesqrt', 'sqrt', or multiplications.
+            Normalize   = (1 << 1), //!< Replaces 'normalize(x)' by 'x * inversesqrt(dot(x, x))'.
+            ExpLog      = (1 << 2), //!< Replaces 'exp', 'log', and 'log10' by scaled 'exp2' and 'log2'.
+            MulAdd      = (1 << 3), //!< Replaces 'a * b + c' by 'fma(a, b, c)'. This is only done for GLSL 4.00+, ESSL 3.20, and VKSL output.
+            Saturate    = (1 << 4), //!< Removes redundant nested 'saturate' and 'clamp(x, 0, 1)' calls.
+
+            All         = (PowToMul | Normalize | ExpLog | MulAdd | Saturate), //!< All fast-math substitutions.
+        };
+
         //! Structure for additional translation options.
         ref class OutputOptions
         {
@@ -334,6 +549,7 @@ public ref class XscCompiler
                     Optimize                = false;
                     PreprocessOnly          = false;
                     ValidateOnly            = false;
+                    DiagnosticsMode         = false;
                     AllowExtensions         = false;
                     ExplicitBinding         = false;
                     PreserveComments        = false;
@@ -341,8 +557,22 @@ public ref class XscCompiler
                     UnrollArrayInitializers = false;
                     RowMajorAlignment       = false;
                     Obfuscate               = false;
+                    ExtractPreshaders       = false;
+                    ConstantTableThreshold  = 0;
+                    FastMath                = FastMathFlags::None;
+                    PushConstantBudget      = 0;
+                    UniformStorageBufferSize = 0;
+                    PackVaryings            = false;
+                    PositionOnly            = false;
+                    FlatVaryings            = false;
+                    Vectorize               = false;
+                    ScalarReplacement       = false;
+                    OptimizeLoops           = false;
+                    ProfileCounters         = false;
+                    ParallelParsing         = false;
                     ShowAST                 = false;
                     ShowTimes               = false;
+                    ShowMemory              = false;
                 }
 
                 //! True if warnings are allowed. By default false.
@@ -357,6 +587,9 @@ public ref class XscCompiler
                 //! If true, the source code is only validated, but no output code will be generated. By default false.
                 property bool ValidateOnly;
 
+                //! If true, only diagnostics are reported: the parser recovers from syntax errors, the context analysis runs on erroneous code, and no output code is generated. By default false.
+                property bool DiagnosticsMode;
+
                 //! If true, the shader output may contain GLSL extensions, if the target shader version is too low. By default false.
                 property bool AllowExtensions;
 
@@ -378,12 +611,54 @@ public ref class XscCompiler
                 //! If true, code obfuscation is performed. By default false.
                 property bool Obfuscate;
 
+                //! If true, uniform-only expressions are extracted into a synthesized constant buffer and reported as preshaders in the reflection data. By default false.
+                property bool ExtractPreshaders;
+
+                //! Minimal number of elements of a static constant array to be moved into a synthesized constant buffer, whose data is reported in the reflection data. Smaller constant arrays are written with array constructors. Zero disables this conversion. By default 0.
+                property unsigned int ConstantTableThreshold;
+
+                //! Whitelist of fast-math substitutions, which trade precision for fewer ALU instructions. Each substitution is reported as info. By default FastMathFlags::None.
+                property FastMathFlags FastMath;
+
+                //! Size (in bytes) of the push constant block for VKSL output. Constant buffers that fit into this budget (e.g. small per-draw buffers) are merged into a single 'push_constant' block, and the choice is reported in the reflection data. Vulkan guarantees at least 128 bytes. Zero disables this conversion. Ignored for GLSL and ESSL. By default 0.
+                property unsigned int PushConstantBudget;
+
+                //! Size limit (in bytes) of uniform buffers for VKSL output. Read-only structured buffers with uniform indices, whose elements have the same layout in "std140" and "std430", are declared as uniform buffers with as many elements as fit into this limit (instead of storage buffers), and the choice is reported in the reflection data. Vulkan guarantees at least 16384 bytes. Zero disables this conversion. Ignored for GLSL and ESSL. By default 0.
+                property unsigned int UniformStorageBufferSize;
+
+                //! If true, compatible shader input/output variables (varyings) are packed into 4-component slots. By default false.
+                property bool PackVaryings;
+
+                //! If true, a position-only variant of a vertex or tessellation-evaluation shader is generated, whose only output is the position system value (e.g. for depth-only passes). By default false.
+                property bool PositionOnly;
+
+                //! If true, vertex shader outputs that are not derived from per-vertex inputs are declared with 'flat' interpolation, and reported in the reflection data (see ShaderOutput::flatInputSemantics for the fragment shader side). By default false.
+                property bool FlatVaryings;
+
+                //! If true, isomorphic scalar operations on the components of the same vector are merged into vector operations (e.g. "v.x = a.x * s; v.y = a.y * s;" -> "v.xy = a.xy * s;"). Each merge is reported as info. By default false.
+                property bool Vectorize;
+
+                //! If true, local arrays and structures whose elements are only accessed with constant indices are replaced by individual scalar or vector temporaries (scalar replacement of aggregates). Each replacement is reported as info. By default false.
+                property bool ScalarReplacement;
+
+                //! If true, side effect free loop invariant expressions are hoisted out of loops into temporaries, and multiplications of integral induction variables are reduced to additions. Each transformation is reported as info. By default false.
+                property bool OptimizeLoops;
+
+                //! If true, the output code is instrumented with execution counters for each function, branch, and loop body, which are incremented atomically in a synthesized storage buffer (or atomic counters for GLSL 4.20). The counters are mapped to their source locations in the reflection data. By default false.
+                property bool ProfileCounters;
+
+                //! If true, the global declarations of the HLSL input are parsed in parallel chunks, if the input is large enough. Falls back to serial parsing when a chunk depends on its context (the resulting AST and reports are always the same). Ignored in diagnostics mode. By default false.
+                property bool ParallelParsing;
+
                 //! If true, the AST (Abstract Syntax Tree) will be written to the log output. By default false.
                 property bool ShowAST;
 
                 //! If true, the timings of the different compilation processes are written to the log output. By default false.
                 property bool ShowTimes;
 
+                //! If true, the peak memory during the different compilation processes (where supported), and the resident memory after each process are written to the log output. By default false.
+                property bool ShowMemory;
+
         };
 
         //! Name mangling descriptor structure for shader input/output variables (also referred to as "varyings"), temporary variables, and reserved keywords.
@@ -512,6 +787,26 @@ public ref class XscCompiler
 
         };
 
+        //! Measured execution count of a code region for profile-guided optimization.
+        ref class ProfileCount
+        {
+
+            public:
+
+                ProfileCount()
+                {
+                    Location    = nullptr;
+                    Count       = 0;
+                }
+
+                //! Specifies the source location of the code region in the format "Filename:Row:Column".
+                property String^            Location;
+
+                //! Specifies the number of executions of the code region.
+                property unsigned long long Count;
+
+        };
+
         //! Shader output descriptor structure.
         ref class ShaderOutput
         {
@@ -524,6 +819,9 @@ public ref class XscCompiler
                     SourceCode      = gcnew String("");
                     ShaderVersion   = OutputShaderVersion::GLSL;
                     VertexSemantics = gcnew Collections::Generic::List<VertexSemantic^>();
+                    FlatInputSemantics = gcnew Collections::Generic::List<String^>();
+                    PackedInputLayout = gcnew Collections::Generic::List<PackedVarying^>();
+                    ProfileCounts   = gcnew Collections::Generic::List<ProfileCount^>();
                     Options         = gcnew OutputOptions();
                     Formatting      = gcnew OutputFormatting();
                     NameMangling    = gcnew OutputNameMangling();
@@ -541,6 +839,15 @@ public ref class XscCompiler
                 //! Optional list of vertex semantic layouts, to bind a vertex attribute (semantic name) to a location index (only used when 'explicitBinding' is true).
                 property Collections::Generic::List<VertexSemantic^>^   VertexSemantics;
 
+                //! Optional list of fragment shader input semantics (e.g. "COLOR0"), which are declared with 'flat' interpolation.
+                property Collections::Generic::List<String^>^           FlatInputSemantics;
+
+                //! Optional packing map of the previous shader stage, to pack the input varyings into the same slots (see OutputOptions::PackVaryings).
+                property Collections::Generic::List<PackedVarying^>^    PackedInputLayout;
+
+                //! Optional list of execution counts for profile-guided optimization.
+                property Collections::Generic::List<ProfileCount^>^     ProfileCounts;
+
                 //! Additional options to configure the code generation.
                 property OutputOptions^                                 Options;
 
@@ -886,6 +1193,26 @@ class LogCSharp : public Xsc::Log
  * XscCompiler class implementation
  */
 
+static Collections::Generic::List<XscCompiler::PackedVarying^>^ ToManagedList(const std::vector<Xsc::Reflection::PackedVarying>& src)
+{
+    auto dst = gcnew Collections::Generic::List<XscCompiler::PackedVarying^>();
+
+    for (const auto& s : src)
+    {
+        auto varying = gcnew XscCompiler::PackedVarying();
+        {
+            varying->Semantic       = gcnew String(s.semantic.c_str());
+            varying->SlotIdent      = gcnew String(s.slotIdent.c_str());
+            varying->Slot           = s.slot;
+            varying->FirstComponent = s.firstComponent;
+            varying->NumComponents  = s.numComponents;
+        }
+        dst->Add(varying);
+    }
+
+    return dst;
+}
+
 static Collections::Generic::List<XscCompiler::BindingSlot^>^ ToManagedList(const std::vector<Xsc::Reflection::BindingSlot>& src)
 {
     auto dst = gcnew Collections::Generic::List<XscCompiler::BindingSlot^>();
@@ -948,11 +1275,41 @@ bool XscCompiler::CompileShader(ShaderInput^ inputDesc, ShaderOutput^ outputDesc
         }
     }
 
+    if (outputDesc->FlatInputSemantics != nullptr)
+    {
+        for (int i = 0; i < outputDesc->FlatInputSemantics->Count; ++i)
+            out.flatInputSemantics.push_back(ToStdString(outputDesc->FlatInputSemantics[i]));
+    }
+
+    if (outputDesc->PackedInputLayout != nullptr)
+    {
+        out.packedInputLayout.resize(outputDesc->PackedInputLayout->Count);
+        for (int i = 0; i < outputDesc->PackedInputLayout->Count; ++i)
+        {
+            out.packedInputLayout[i].semantic       = ToStdString(outputDesc->PackedInputLayout[i]->Semantic);
+            out.packedInputLayout[i].slotIdent      = ToStdString(outputDesc->PackedInputLayout[i]->SlotIdent);
+            out.packedInputLayout[i].slot           = outputDesc->PackedInputLayout[i]->Slot;
+            out.packedInputLayout[i].firstComponent = outputDesc->PackedInputLayout[i]->FirstComponent;
+            out.packedInputLayout[i].numComponents  = outputDesc->PackedInputLayout[i]->NumComponents;
+        }
+    }
+
+    if (outputDesc->ProfileCounts != nullptr)
+    {
+        out.profileCounts.resize(outputDesc->ProfileCounts->Count);
+        for (int i = 0; i < outputDesc->ProfileCounts->Count; ++i)
+        {
+            out.profileCounts[i].location   = ToStdString(outputDesc->ProfileCounts[i]->Location);
+            out.profileCounts[i].count      = outputDesc->ProfileCounts[i]->Count;
+        }
+    }
+
     /* Copy output options descriptor */
     out.options.warnings                = outputDesc->Options->Warnings;
     out.options.optimize                = outputDesc->Options->Optimize;
     out.options.preprocessOnly          = outputDesc->Options->PreprocessOnly;
     out.options.validateOnly            = outputDesc->Options->ValidateOnly;
+    out.options.diagnosticsMode         = outputDesc->Options->DiagnosticsMode;
     out.options.allowExtensions         = outputDesc->Options->AllowExtensions;
     out.options.explicitBinding         = outputDesc->Options->ExplicitBinding;
     out.options.preserveComments        = outputDesc->Options->PreserveComments;
@@ -960,8 +1317,22 @@ bool XscCompiler::CompileShader(ShaderInput^ inputDesc, ShaderOutput^ outputDesc
     out.options.unrollArrayInitializers = outputDesc->Options->UnrollArrayInitializers;
     out.options.rowMajorAlignment       = outputDesc->Options->RowMajorAlignment;
     out.options.obfuscate               = outputDesc->Options->Obfuscate;
+    out.options.extractPreshaders       = outputDesc->Options->ExtractPreshaders;
+    out.options.constantTableThreshold  = outputDesc->Options->ConstantTableThreshold;
+    out.options.fastMath                = static_cast<unsigned int>(outputDesc->Options->FastMath);
+    out.options.pushConstantBudget      = outputDesc->Options->PushConstantBudget;
+    out.options.uniformStorageBufferSize = outputDesc->Options->UniformStorageBufferSize;
+    out.options.packVaryings            = outputDesc->Options->PackVaryings;
+    out.options.positionOnly            = outputDesc->Options->PositionOnly;
+    out.options.flatVaryings            = outputDesc->Options->FlatVaryings;
+    out.options.vectorize               = outputDesc->Options->Vectorize;
+    out.options.scalarReplacement       = outputDesc->Options->ScalarReplacement;
+    out.options.optimizeLoops           = outputDesc->Options->OptimizeLoops;
+    out.options.profileCounters         = outputDesc->Options->ProfileCounters;
+    out.options.parallelParsing         = outputDesc->Options->ParallelParsing;
     out.options.showAST                 = outputDesc->Options->ShowAST;
     out.options.showTimes               = outputDesc->Options->ShowTimes;
+    out.options.showMemory              = outputDesc->Options->ShowMemory;
 
     /* Copy output formatting descriptor */
     out.formatting.indent               = ToStdString(outputDesc->Formatting->Indent);
@@ -1055,6 +1426,76 @@ bool XscCompiler::CompileShader(ShaderInput^ inputDesc, ShaderOutput^ outputDesc
                 src.numThreads.y,
                 src.numThreads.z
             );
+
+            /* Copy packed varyings reflection */
+            dst->PackedInputs   = ToManagedList(src.packedInputs);
+            dst->PackedOutputs  = ToManagedList(src.packedOutputs);
+
+            /* Copy preshaders reflection */
+            dst->PreshaderBuffer = gcnew String(src.preshaderBuffer.c_str());
+
+            dst->Preshaders = gcnew Collections::Generic::List<PreshaderExpression^>();
+            for (const auto& s : src.preshaders)
+            {
+                auto expr = gcnew PreshaderExpression();
+                {
+                    expr->Ident = gcnew String(s.ident.c_str());
+                    expr->Type  = gcnew String(s.type.c_str());
+
+                    for (const auto& instr : s.instructions)
+                    {
+                        auto instruction = gcnew PreshaderInstruction();
+                        {
+                            instruction->Opcode         = static_cast<PreshaderOpcode>(instr.opcode);
+                            instruction->Value          = gcnew String(instr.value.c_str());
+                            instruction->NumOperands    = instr.numOperands;
+                            instruction->Type           = gcnew String(instr.type.c_str());
+                        }
+                        expr->Instructions->Add(instruction);
+                    }
+                }
+                dst->Preshaders->Add(expr);
+            }
+
+            /* Copy constant tables reflection */
+            dst->ConstantTableBuffer = gcnew String(src.constantTableBuffer.c_str());
+
+            dst->ConstantTables = gcnew Collections::Generic::List<ConstantTable^>();
+            for (const auto& s : src.constantTables)
+            {
+                auto table = gcnew ConstantTable();
+                {
+                    table->Ident    = gcnew String(s.ident.c_str());
+                    table->Type     = gcnew String(s.type.c_str());
+                    table->Size     = s.size;
+                    table->Offset   = s.offset;
+                    table->Stride   = s.stride;
+                }
+                dst->ConstantTables->Add(table);
+            }
+
+            dst->ConstantTableData = gcnew array<System::Byte>(static_cast<int>(src.constantTableData.size()));
+            for (std::size_t i = 0; i < src.constantTableData.size(); ++i)
+                dst->ConstantTableData[static_cast<int>(i)] = static_cast<System::Byte>(src.constantTableData[i]);
+
+            /* Copy profiling counters reflection */
+            dst->ProfileCounterBuffer = gcnew BindingSlot(
+                gcnew String(src.profileCounterBuffer.ident.c_str()),
+                src.profileCounterBuffer.location
+            );
+
+            dst->ProfileCounters = gcnew Collections::Generic::List<ProfileCounter^>();
+            for (const auto& s : src.profileCounters)
+            {
+                auto counter = gcnew ProfileCounter();
+                {
+                    counter->Index      = s.index;
+                    counter->Type       = static_cast<ProfileCounterType>(s.type);
+                    counter->Function   = gcnew String(s.function.c_str());
+                    counter->Location   = gcnew String(s.location.c_str());
+                }
+                dst->ProfileCounters->Add(counter);
+            }
         }
     }
 
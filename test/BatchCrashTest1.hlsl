@@ -0,0 +1,17 @@
+// Batch Crash Test 1
+// 18/10/2026
+
+// Deeply nested brackets exhaust the stack of the recursive-descent parser.
+// In a batch with crash-isolated worker processes (--isolate), only this job fails,
+// the crashed worker process is restarted, and the remaining jobs are still compiled.
+
+#define P1(x) ((((((((((x))))))))))
+#define P2(x) P1(P1(P1(P1(P1(P1(P1(P1(P1(P1(x))))))))))
+#define P3(x) P2(P2(P2(P2(P2(P2(P2(P2(P2(P2(x))))))))))
+#define P4(x) P3(P3(P3(P3(P3(P3(P3(P3(P3(P3(x))))))))))
+#define P5(x) P4(P4(P4(P4(P4(P4(P4(P4(P4(P4(x))))))))))
+
+float4 PS() : SV_Target
+{
+	return P5(1);
+}
@@ -0,0 +1,74 @@
+// Batch Test 1
+// 18/10/2026
+
+cbuffer Scene : register(b0)
+{
+	float4x4	wvpMatrix;
+	float4		lightDir;
+};
+
+Texture2D		colorMap	: register(t0);
+SamplerState	linearSmp	: register(s0);
+
+RWTexture2D<float4>	blurTex	: register(u0);
+
+struct VOut
+{
+	float4 position : SV_Position;
+	float3 normal	: NORMAL;
+	float2 texCoord	: TEXCOORD;
+};
+
+VOut VS(float3 position : POSITION, float3 normal : NORMAL, float2 texCoord : TEXCOORD)
+{
+	VOut outp;
+	outp.position	= mul(wvpMatrix, float4(position, 1));
+	outp.normal		= normal;
+	outp.texCoord	= texCoord;
+	return outp;
+}
+
+float4 PS(VOut inp) : SV_Target
+{
+	float3 n = normalize(inp.normal);
+	float ndotl = saturate(dot(n, -lightDir.xyz));
+	return colorMap.Sample(linearSmp, inp.texCoord) * (0.2 + 0.8 * ndotl);
+}
+
+#ifdef UNROLL_BLUR
+
+// Fully unrolled blur kernel, which makes this shader variant the most expensive job to compile
+#define BLUR_TAP(I)		sum += colorMap.SampleLevel(linearSmp, uv + dir * (I), 0) * exp(-(I) * (I) * 0.0001);
+#define BLUR_TAP4(I)	BLUR_TAP(I) BLUR_TAP(I + 1) BLUR_TAP(I + 2) BLUR_TAP(I + 3)
+#define BLUR_TAP16(I)	BLUR_TAP4(I) BLUR_TAP4(I + 4) BLUR_TAP4(I + 8) BLUR_TAP4(I + 12)
+#define BLUR_TAP64(I)	BLUR_TAP16(I) BLUR_TAP16(I + 16) BLUR_TAP16(I + 32) BLUR_TAP16(I + 48)
+#define BLUR_TAP256(I)	BLUR_TAP64(I) BLUR_TAP64(I + 64) BLUR_TAP64(I + 128) BLUR_TAP64(I + 192)
+
+float4 SampleBlur(float2 uv, float2 dir)
+{
+	float4 sum = 0;
+	BLUR_TAP256(-128)
+	BLUR_TAP256(128)
+	return sum;
+}
+
+#else
+
+float4 SampleBlur(float2 uv, float2 dir)
+{
+	float4 sum = 0;
+	for (int i = -128; i < 384; ++i)
+		sum += colorMap.SampleLevel(linearSmp, uv + dir * i, 0) * exp(-i * i * 0.0001);
+	return sum;
+}
+
+#endif
+
+[numthreads(8, 8, 1)]
+void CS(uint3 id : SV_DispatchThreadID)
+{
+	float2 uv = float2(id.xy) / 1024.0;
+	float4 h = SampleBlur(uv, float2(1.0 / 1024.0, 0));
+	float4 v = SampleBlur(uv, float2(0, 1.0 / 1024.0));
+	blurTex[id.xy] = (h + v) * 0.5;
+}
@@ -0,0 +1,22 @@
+
+// Constant Folding Test 1 (vectors, matrices, and intrinsics)
+// 18/10/2026
+
+static const float3 c0 = float3(1, 2, 3);
+static const float3 c1 = normalize(float3(0, 1, 1));
+
+float4 VS(float4 pos : POSITION) : SV_Position
+{
+    float3 a = float3(1, 2, 3) * 2.0;
+    float d = dot(c0, c1);
+    float3 b = cross(float3(1, 0, 0), float3(0, 1, 0));
+    float3 c = lerp((float3)0, float3(2, 4, 6), 0.5);
+    float e = saturate(1.5) + min(2, 3) + max(1.0, 4) + clamp(5, 0, 2);
+    float f = sin(0.0) + cos(0.0);
+    float2 g = float3(1, 2, 3).zy;
+    float2x2 h = mul(float2x2(1, 2, 3, 4), float2x2(1, 0, 0, 1));
+    float3 i = float3(g, d) * c0.x;
+    float j = 100000000.0 + 1.0 - 100000000.0;
+    float3 k = float3(1e8, 1, 0.1) + float3(1, 1e-8, 0.2);
+    return pos + float4(a + b + c + float3(e, f, i.x) + float3(h[1], 1) + k * j, 1);
+}
@@ -0,0 +1,23 @@
+// Constant Table Test 1
+// 18/10/2026
+
+// Large constant array, which is moved into a constant buffer
+static const float4 g_palette[8] =
+{
+	float4(1, 0, 0, 1),
+	float4(0, 1, 0, 1),
+	float4(0, 0, 1, 1),
+	float4(1, 1, 0, 1),
+	float4(1, 0, 1, 1),
+	float4(0, 1, 1, 1),
+	float4(1, 1, 1, 1),
+	float4(0, 0, 0, 1),
+};
+
+// Small constant array, which stays in the shader
+static const float g_weights[2] = { 0.25, 0.75 };
+
+float4 PS(nointerpolation uint index : INDEX, float blend : BLEND) : SV_Target
+{
+	return g_palette[index % 8] * lerp(g_weights[0], g_weights[1], blend);
+}
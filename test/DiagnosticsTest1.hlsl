@@ -0,0 +1,33 @@
+// Diagnostics Test 1
+// 18/10/2026
+
+cbuffer Settings : register(b0)
+{
+	float4 tint;
+	float  scale
+};
+
+float4 Brighten(float4 c)
+{
+	return c * scale +;
+}
+
+float Luminance(float2 v)
+{
+	return v.x;
+}
+
+float Luminance(float3 v)
+{
+	return dot(v, float3(0.3, 0.59, 0.11));
+}
+
+float4 PS(float4 color : COLOR) : SV_Target
+{
+	float4 c = Brighten(color)
+	c.rgb *= undeclaredFactor;
+	c.a *= Luminance(1.0);
+	c.a += Brighten(color, 2.0).a;
+	c.a -= tint(c);
+	return c * tint;
+}
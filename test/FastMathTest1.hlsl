@@ -0,0 +1,39 @@
+// Fast Math Test 1
+// 18/10/2026
+
+cbuffer Material : register(b0)
+{
+	float	shininess;
+	float	exposure;
+	float4	albedo;
+};
+
+float4 PS(float3 normal : NORMAL, float3 viewDir : VIEWDIR, float3 lightDir : LIGHTDIR) : SV_Target
+{
+	// normalize(x) -> x * inversesqrt(dot(x, x)), but only if 'x' can be evaluated several times
+	float3	n		= normalize(normal);
+	float3	v		= normalize(viewDir);
+	float3	h		= normalize(v + lightDir);
+
+	// pow(x, n) -> x * ... * x, pow(x, 0.5) -> sqrt(x), but pow with non-constant exponent is kept
+	float	ndoth	= saturate(dot(n, h));
+	float	spec	= pow(ndoth, shininess);
+	float	f		= 1.0 - ndoth;
+	float	fresnel	= pow(f, 4.0);
+	float	rim		= pow(ndoth, 0.5);
+
+	// log(x) -> log2(x) * ln(2)
+	float	scale	= exp2(exposure) * log(1.0 + spec);
+
+	// Redundant saturations are removed, if the argument is already in the range [0, 1]
+	float	s0		= clamp(saturate(spec), 0.0, 1.0);
+	float	s1		= saturate(clamp(fresnel, 0, 1));
+	float	s2		= saturate(saturate(spec) * saturate(rim));
+	float	s3		= saturate(1.0 - lerp(0.5, frac(spec), smoothstep(0.0, 1.0, rim)));
+
+	// Saturations of unknown ranges and scalar-to-vector clamps are kept
+	float	s4		= saturate(ndoth * saturate(rim));
+	float3	s5		= clamp(saturate(rim), float3(0, 0, 0), float3(1, 1, 1));
+
+	return saturate(albedo * (spec * scale + fresnel + rim)) * s0 * s1 * s2 * s3 * s4 * s5.x;
+}
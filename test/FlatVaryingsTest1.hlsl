@@ -0,0 +1,33 @@
+// Flat Varyings Test 1
+// 18/10/2026
+
+cbuffer Object : register(b0)
+{
+	float4x4	wvpMatrix;
+	float4		objectColor;
+	uint		objectID;
+};
+
+struct VOut
+{
+	float4	position	: SV_Position;
+	float2	texCoord	: TEXCOORD;
+	float4	color		: COLOR;
+	uint	id			: OBJECTID;
+};
+
+// COLOR and OBJECTID do not depend on per-vertex inputs, so they are declared with 'flat' interpolation
+VOut VS(float3 position : POSITION, float2 texCoord : TEXCOORD)
+{
+	VOut o;
+	o.position	= mul(wvpMatrix, float4(position, 1));
+	o.texCoord	= texCoord;
+	o.color		= objectColor * 0.5;
+	o.id		= objectID;
+	return o;
+}
+
+float4 PS(VOut i) : SV_Target
+{
+	return float4(i.texCoord, 0, 1) * i.color + (float)i.id;
+}
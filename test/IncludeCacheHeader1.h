@@ -0,0 +1,12 @@
+// Include Cache Header 1
+// 18/10/2026
+
+// Expansion depends on the 'USE_SRGB' macro, so it is memoized once per macro value
+float4 ApplyGamma(float4 c)
+{
+	#if USE_SRGB
+	return float4(pow(abs(c.rgb), 1.0 / 2.2), c.a);
+	#else
+	return c;
+	#endif
+}
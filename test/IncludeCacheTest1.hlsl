@@ -0,0 +1,21 @@
+// Include Cache Test 1
+// 18/10/2026
+
+// Compile several entry points of this file with "--include-cache",
+// so the expansion of the include file is replayed from the memo.
+
+#ifndef USE_SRGB
+#define USE_SRGB 1
+#endif
+
+#include "IncludeCacheHeader1.h"
+
+float4 VS(float4 position : POSITION) : SV_Position
+{
+	return position;
+}
+
+float4 PS(float4 color : COLOR) : SV_Target
+{
+	return ApplyGamma(color);
+}
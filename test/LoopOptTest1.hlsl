@@ -0,0 +1,28 @@
+// Loop Optimization Test 1
+// 18/10/2026
+
+cbuffer Settings : register(b0)
+{
+	float4	weights[16];
+	float	scale;
+	float	bias;
+	int		stride;
+};
+
+Texture2D		tex : register(t0);
+SamplerState	smpl : register(s0);
+
+float4 PS(float2 texCoord : TEXCOORD) : SV_Target
+{
+	float4 sum = 0;
+
+	for (int i = 0; i < 8; ++i)
+	{
+		// "scale * 2.0 + bias" is loop invariant, and "i * stride" is reduced to an addition
+		float	factor	= scale * 2.0 + bias;
+		int		offset	= i * stride;
+		sum += tex.Sample(smpl, texCoord + float2(offset, 0) * 0.001) * weights[i] * factor;
+	}
+
+	return sum;
+}
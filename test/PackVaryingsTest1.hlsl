@@ -0,0 +1,32 @@
+// Pack Varyings Test 1
+// 18/10/2026
+
+// Vertex shader writes all varyings, but the pixel shader only reads TEXCOORD1 and COLOR,
+// so the pixel shader must be packed with the slots of the vertex shader.
+
+struct VOut
+{
+	float4 position	: SV_Position;
+	float2 uv0		: TEXCOORD0;
+	float2 uv1		: TEXCOORD1;
+	float3 normal	: NORMAL;
+	float  depth	: DEPTH;
+	float4 color	: COLOR;
+};
+
+VOut VS(float4 pos : POSITION, float2 t0 : TEXCOORD0, float2 t1 : TEXCOORD1, float3 n : NORMAL, float4 c : COLOR)
+{
+	VOut o;
+	o.position	= pos;
+	o.uv0		= t0;
+	o.uv1		= t1;
+	o.normal	= n;
+	o.depth		= pos.z;
+	o.color		= c;
+	return o;
+}
+
+float4 PS(float4 position : SV_Position, float2 uv1 : TEXCOORD1, float4 color : COLOR) : SV_Target
+{
+	return float4(uv1, 0, 1) * color;
+}
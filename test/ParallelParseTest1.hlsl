@@ -0,0 +1,66 @@
+// Parallel Parse Test 1
+// 18/10/2026
+
+// This file must have enough global declarations to be split into several chunks (at least 2048 tokens each),
+// and the output must be the same with and without "--parallel-parse".
+
+struct Light
+{
+	float3	direction;
+	float3	color;
+	float	intensity;
+};
+
+#define DECL_SHADE_FUNC(NAME, SCALE)											\
+	float3 NAME(Light light, float3 normal, float3 albedo)					\
+	{																		\
+		float ndotl = saturate(dot(normal, -light.direction));				\
+		float3 diffuse = albedo * light.color * (ndotl * light.intensity);	\
+		float3 ambient = albedo * float3(0.1, 0.1, 0.1) * SCALE;			\
+		if (ndotl > 0.5)													\
+			return diffuse * SCALE + ambient;								\
+		else																\
+			return lerp(ambient, diffuse, ndotl * 2.0);						\
+	}
+
+#define DECL_SHADE_FUNCS(N)				\
+	DECL_SHADE_FUNC(Shade##N##A, 1.0)	\
+	DECL_SHADE_FUNC(Shade##N##B, 1.5)	\
+	DECL_SHADE_FUNC(Shade##N##C, 2.0)	\
+	DECL_SHADE_FUNC(Shade##N##D, 2.5)
+
+DECL_SHADE_FUNCS(0)
+DECL_SHADE_FUNCS(1)
+DECL_SHADE_FUNCS(2)
+DECL_SHADE_FUNCS(3)
+DECL_SHADE_FUNCS(4)
+DECL_SHADE_FUNCS(5)
+
+// Type name that is registered in a later chunk
+struct Material
+{
+	float3	albedo;
+	float	roughness;
+};
+
+typedef Material MaterialAlias;
+
+DECL_SHADE_FUNCS(6)
+DECL_SHADE_FUNCS(7)
+DECL_SHADE_FUNCS(8)
+DECL_SHADE_FUNCS(9)
+DECL_SHADE_FUNCS(10)
+DECL_SHADE_FUNCS(11)
+
+cbuffer Scene : register(b0)
+{
+	Light			mainLight;
+	MaterialAlias	material;
+};
+
+float4 PS(float3 normal : NORMAL) : SV_Target
+{
+	float3 n = normalize(normal);
+	float3 c = Shade0A(mainLight, n, material.albedo) + Shade11D(mainLight, n, material.albedo);
+	return float4(c * (1.0 - material.roughness), 1.0);
+}
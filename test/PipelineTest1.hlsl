@@ -0,0 +1,40 @@
+// Pipeline Test 1
+// 18/10/2026
+
+// Constant buffer that is used by both stages, so it is merged into one binding for both stages
+cbuffer Scene : register(b0)
+{
+	float4x4	vpMatrix;
+	float4		lightDir;
+};
+
+// Constant buffer and texture that are only used by a single stage
+cbuffer Object : register(b1)
+{
+	float4x4	worldMatrix;
+};
+
+Texture2D		colorMap : register(t0);
+SamplerState	linearSampler : register(s0);
+
+struct VOut
+{
+	float4 position	: SV_Position;
+	float3 normal	: NORMAL;
+	float2 texCoord	: TEXCOORD;
+};
+
+VOut VS(float3 position : POSITION, float3 normal : NORMAL, float2 texCoord : TEXCOORD)
+{
+	VOut o;
+	o.position	= mul(vpMatrix, mul(worldMatrix, float4(position, 1)));
+	o.normal	= mul((float3x3)worldMatrix, normal);
+	o.texCoord	= texCoord;
+	return o;
+}
+
+float4 PS(VOut i) : SV_Target
+{
+	float ndotl = saturate(dot(normalize(i.normal), -lightDir.xyz));
+	return colorMap.Sample(linearSampler, i.texCoord) * ndotl;
+}
@@ -0,0 +1,32 @@
+// Position Only Test 1
+// 18/10/2026
+
+cbuffer Matrices : register(b0)
+{
+	float4x4 wvpMatrix;
+	float4x4 worldMatrix;
+};
+
+struct VIn
+{
+	float3 position	: POSITION;
+	float3 normal	: NORMAL;
+	float2 texCoord	: TEXCOORD;
+};
+
+struct VOut
+{
+	float4 position	: SV_Position;
+	float3 normal	: NORMAL;
+	float2 texCoord	: TEXCOORD;
+};
+
+// Only the position output (and the inputs it depends on) remain in the position-only variant
+VOut VS(VIn i)
+{
+	VOut o;
+	o.position	= mul(wvpMatrix, float4(i.position, 1));
+	o.normal	= normalize(mul((float3x3)worldMatrix, i.normal));
+	o.texCoord	= i.texCoord;
+	return o;
+}
@@ -0,0 +1,22 @@
+// Preshader Test 1
+// 18/10/2026
+
+cbuffer Light : register(b0)
+{
+	float3	lightDir;
+	float	intensity;
+	float	exposure;
+	float4	tint;
+};
+
+float4 PS(float3 normal : NORMAL) : SV_Target
+{
+	// Uniform-only expressions, which are moved into the preshader constant buffer
+	float3	l		= normalize(lightDir);
+	float	scale	= pow(2.0, exposure) * intensity;
+
+	// Per-pixel expression, which stays in the shader
+	float	ndotl	= saturate(dot(normalize(normal), l));
+
+	return tint * (ndotl * scale);
+}
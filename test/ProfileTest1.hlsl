@@ -0,0 +1,45 @@
+// Profile Test 1
+// 18/10/2026
+
+cbuffer Settings : register(b0)
+{
+	float4	weights[4];
+	int		mode;
+	float	threshold;
+};
+
+float4 Tonemap(float4 c)
+{
+	return c / (c + 1.0);
+}
+
+float4 PS(float4 color : COLOR) : SV_Target
+{
+	float4 result = 0;
+
+	// Execution counts of this branch are used to move the hot 'else' branch first
+	if (color.a < threshold)
+		result = color * 0.5;
+	else
+		result = Tonemap(color);
+
+	// Execution counts of these cases are used to order them by frequency
+	switch (mode)
+	{
+		case 0:
+			result *= 2.0;
+			break;
+		case 1:
+			result += 0.1;
+			break;
+		default:
+			result = 1.0 - result;
+			break;
+	}
+
+	// Hot loop with a small constant number of iterations, which is unrolled
+	for (int i = 0; i < 4; ++i)
+		result += weights[i] * 0.25;
+
+	return result;
+}
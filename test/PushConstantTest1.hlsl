@@ -0,0 +1,33 @@
+// Push Constant Test 1
+// 18/10/2026
+
+// Small per-draw buffer, which fits into the push constant block
+cbuffer PerDraw : register(b0)
+{
+	float4x4	wvpMatrix;
+	float4		color;
+};
+
+// Large per-scene buffer, which stays a uniform buffer
+cbuffer PerScene : register(b1)
+{
+	float4		lightDirs[16];
+	float4		lightColors[16];
+};
+
+// Read-only structured buffer with uniform indices, which is declared as uniform buffer
+StructuredBuffer<float4> palette : register(t0);
+
+struct VOut
+{
+	float4 position	: SV_Position;
+	float4 color	: COLOR;
+};
+
+VOut VS(float3 position : POSITION, float3 normal : NORMAL)
+{
+	VOut o;
+	o.position	= mul(wvpMatrix, float4(position, 1));
+	o.color		= color * saturate(dot(normal, lightDirs[0].xyz)) * lightColors[0] + palette[0];
+	return o;
+}
@@ -0,0 +1,35 @@
+// Resource Access Test 1
+// 18/10/2026
+
+cbuffer Settings : register(b0)
+{
+	uint	mode;
+	float	scale;
+};
+
+// Read-only resources
+StructuredBuffer<float4>	inputData	: register(t0);
+Buffer<float>				weights		: register(t1);
+
+// Written under uniform control flow only
+RWTexture2D<float4>			outputTex	: register(u0);
+
+// Accessed with atomic operations in divergent control flow
+RWBuffer<uint>				counters	: register(u1);
+
+[numthreads(8, 8, 1)]
+void CS(uint3 id : SV_DispatchThreadID)
+{
+	float4 value = inputData[id.x] * weights[id.y];
+
+	// Uniform condition: only depends on constant buffer fields
+	if (mode != 0)
+		outputTex[id.xy] = value * scale;
+
+	// Divergent condition: depends on thread ID and loaded data
+	if (value.x > 0.5 || id.x == 0)
+	{
+		uint prev;
+		InterlockedAdd(counters[0], 1, prev);
+	}
+}
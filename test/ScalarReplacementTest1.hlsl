@@ -0,0 +1,29 @@
+// Scalar Replacement Test 1
+// 18/10/2026
+
+struct Surface
+{
+	float3	albedo;
+	float	roughness;
+};
+
+float4 PS(float3 color : COLOR, float2 texCoord : TEXCOORD) : SV_Target
+{
+	// Local array with constant indices only, which is replaced by temporaries
+	float weights[3];
+	weights[0] = 0.25;
+	weights[1] = 0.5;
+	weights[2] = 0.25;
+
+	// Local structure, which is replaced by temporaries
+	Surface s;
+	s.albedo	= color;
+	s.roughness	= texCoord.x;
+
+	// Local array with dynamic index, which is kept
+	float offsets[2] = { 0.0, 1.0 };
+	int i = (int)texCoord.y;
+
+	float w = weights[0] + weights[1] * offsets[i] + weights[2];
+	return float4(s.albedo * w, s.roughness);
+}
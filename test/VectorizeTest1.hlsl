@@ -0,0 +1,26 @@
+// Vectorize Test 1
+// 18/10/2026
+
+cbuffer Settings : register(b0)
+{
+	float	scale;
+	float4	bias;
+};
+
+float4 PS(float4 color : COLOR, float2 texCoord : TEXCOORD) : SV_Target
+{
+	float4 c;
+
+	// Isomorphic scalar operations, which are merged into "c.xyz = color.xyz * scale + bias.xyz"
+	c.x = color.x * scale + bias.x;
+	c.y = color.y * scale + bias.y;
+	c.z = color.z * scale + bias.z;
+	c.w = 1.0;
+
+	// Different operations, which are kept
+	float2 t;
+	t.x = texCoord.x * 2.0;
+	t.y = texCoord.y + 1.0;
+
+	return c * t.x * t.y;
+}
@@ -7,6 +7,8 @@
 
 #include <XscC/XscC.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 
 #define PRINT_FUNC                              \
@@ -91,6 +93,333 @@ void TestCompile()
         puts("*** COMPILATION FAILED ***");
 }
 
+void TestConstantTables()
+{
+    PRINT_FUNC;
+
+    // Initialize structures
+    struct XscShaderInput in;
+    struct XscShaderOutput out;
+    XscInitialize(&in, &out);
+
+    const char* outputCode = NULL;
+
+    // Specify shader code with a constant array that is moved into the constant table buffer
+    in.filename     = "test.hlsl";
+    in.entryPoint   = "PS";
+    in.shaderTarget = XscETargetFragmentShader;
+    in.sourceCode   =
+    (
+        "static const float2 offsets[4] = { float2(-1, -1), float2(1, -1), float2(-1, 1), float2(1, 1) };\n"
+        "float4 PS(uint i : INDEX) : SV_Target {\n"
+        "    return float4(offsets[i & 3], 0, 1);\n"
+        "}\n"
+    );
+
+    out.filename                        = "test.PS.frag";
+    out.sourceCode                      = &outputCode;
+    out.options.constantTableThreshold  = 4;
+
+    // Compile shader and print constant tables
+    struct XscReflectionData reflect;
+
+    if (XscCompileShader(&in, &out, XSC_DEFAULT_LOG, &reflect))
+    {
+        printf("constant table buffer: %s (%u bytes)\n", reflect.constantTableBuffer, (unsigned)reflect.constantTableDataSize);
+        for (size_t i = 0; i < reflect.constantTablesCount; ++i)
+        {
+            const struct XscConstantTable* table = &(reflect.constantTables[i]);
+            printf("  %s %s[%u] (offset = %u, stride = %u)\n", table->type, table->ident, table->size, table->offset, table->stride);
+        }
+    }
+    else
+        puts("*** COMPILATION FAILED ***");
+}
+
+void TestPreshaders()
+{
+    PRINT_FUNC;
+
+    // Initialize structures
+    struct XscShaderInput in;
+    struct XscShaderOutput out;
+    XscInitialize(&in, &out);
+
+    const char* outputCode = NULL;
+
+    // Specify shader code with a uniform-only expression
+    in.filename     = "test.hlsl";
+    in.entryPoint   = "PS";
+    in.shaderTarget = XscETargetFragmentShader;
+    in.sourceCode   =
+    (
+        "cbuffer Settings {\n"
+        "    float3 lightDir;\n"
+        "    float gamma;\n"
+        "};\n"
+        "float4 PS(float3 normal : NORMAL) : SV_Target {\n"
+        "    return dot(normal, normalize(lightDir)) * (1.0 / gamma);\n"
+        "}\n"
+    );
+
+    out.filename                    = "test.PS.frag";
+    out.sourceCode                  = &outputCode;
+    out.options.extractPreshaders   = true;
+
+    // Compile shader and print preshader programs
+    struct XscReflectionData reflect;
+
+    if (XscCompileShader(&in, &out, XSC_DEFAULT_LOG, &reflect))
+    {
+        printf("preshader buffer: %s\n", reflect.preshaderBuffer);
+        for (size_t i = 0; i < reflect.preshadersCount; ++i)
+        {
+            const struct XscPreshaderExpression* expr = &(reflect.preshaders[i]);
+            printf("  %s %s:", expr->type, expr->ident);
+            for (size_t j = 0; j < expr->instructionsCount; ++j)
+                printf(" %s", expr->instructions[j].value);
+            puts("");
+        }
+    }
+    else
+        puts("*** COMPILATION FAILED ***");
+}
+
+void TestPackedVaryings()
+{
+    PRINT_FUNC;
+
+    // Initialize structures
+    struct XscShaderInput in;
+    struct XscShaderOutput out;
+    XscInitialize(&in, &out);
+
+    const char* outputCode = NULL;
+
+    // Specify shader code with a vertex and fragment shader, whose varyings are packed into slots
+    in.filename     = "test.hlsl";
+    in.entryPoint   = "VS";
+    in.shaderTarget = XscETargetVertexShader;
+    in.sourceCode   =
+    (
+        "struct V2F {\n"
+        "    float4 pos : SV_Position;\n"
+        "    float2 tc : TEXCOORD0;\n"
+        "    float fog : FOG;\n"
+        "    float3 normal : NORMAL;\n"
+        "};\n"
+        "V2F VS(float4 pos : POSITION, float3 normal : NORMAL, float2 tc : TEXCOORD) {\n"
+        "    V2F o;\n"
+        "    o.pos = pos;\n"
+        "    o.tc = tc;\n"
+        "    o.fog = pos.z;\n"
+        "    o.normal = normal;\n"
+        "    return o;\n"
+        "}\n"
+        "float4 PS(V2F i) : SV_Target {\n"
+        "    return float4(i.normal * i.fog, i.tc.x);\n"
+        "}\n"
+    );
+
+    out.filename                = "test.VS.vert";
+    out.sourceCode              = &outputCode;
+    out.options.packVaryings    = true;
+
+    // Compile vertex shader and print its packed outputs
+    struct XscReflectionData reflect;
+
+    if (!XscCompileShader(&in, &out, XSC_DEFAULT_LOG, &reflect))
+    {
+        puts("*** COMPILATION FAILED ***");
+        return;
+    }
+
+    for (size_t i = 0; i < reflect.packedOutputsCount; ++i)
+    {
+        const struct XscPackedVarying* varying = &(reflect.packedOutputs[i]);
+        printf("  out %s -> %s (slot = %d, component = %u, count = %u)\n", varying->semantic, varying->slotIdent, varying->slot, varying->firstComponent, varying->numComponents);
+    }
+
+    // Compile fragment shader with the packing map of the vertex shader (the reflection is only valid until the next compilation, which copies the map first)
+    in.entryPoint               = "PS";
+    in.shaderTarget             = XscETargetFragmentShader;
+    out.filename                = "test.PS.frag";
+    out.packedInputLayout       = reflect.packedOutputs;
+    out.packedInputLayoutCount  = reflect.packedOutputsCount;
+
+    if (!XscCompileShader(&in, &out, XSC_DEFAULT_LOG, &reflect))
+    {
+        puts("*** COMPILATION FAILED ***");
+        return;
+    }
+
+    for (size_t i = 0; i < reflect.packedInputsCount; ++i)
+    {
+        const struct XscPackedVarying* varying = &(reflect.packedInputs[i]);
+        printf("  in  %s -> %s (slot = %d, component = %u, count = %u)\n", varying->semantic, varying->slotIdent, varying->slot, varying->firstComponent, varying->numComponents);
+    }
+}
+
+void TestProfileCounters()
+{
+    PRINT_FUNC;
+
+    // Initialize structures
+    struct XscShaderInput in;
+    struct XscShaderOutput out;
+    XscInitialize(&in, &out);
+
+    const char* outputCode = NULL;
+
+    // Specify shader code with a branch and a loop
+    in.filename     = "test.hlsl";
+    in.entryPoint   = "PS";
+    in.shaderTarget = XscETargetFragmentShader;
+    in.sourceCode   =
+    (
+        "float4 PS(float4 color : COLOR, int n : COUNT) : SV_Target {\n"
+        "    if (color.a < 0.5)\n"
+        "        discard;\n"
+        "    for (int i = 0; i < n; ++i)\n"
+        "        color *= 0.5;\n"
+        "    return color;\n"
+        "}\n"
+    );
+
+    out.filename                = "test.PS.frag";
+    out.sourceCode              = &outputCode;
+    out.shaderVersion           = XscEOutputGLSL430;
+    out.options.profileCounters = true;
+
+    // Compile shader and print the counter to location map
+    struct XscReflectionData reflect;
+
+    if (XscCompileShader(&in, &out, XSC_DEFAULT_LOG, &reflect))
+    {
+        printf("profile counter buffer: %s\n", reflect.profileCounterBuffer.ident);
+        for (size_t i = 0; i < reflect.profileCountersCount; ++i)
+        {
+            const struct XscProfileCounter* counter = &(reflect.profileCounters[i]);
+            printf("  counter[%u] (type = %d) -> %s in %s\n", counter->index, (int)counter->type, counter->location, counter->function);
+        }
+    }
+    else
+        puts("*** COMPILATION FAILED ***");
+}
+
+// Pending task of the custom task scheduler
+struct PendingTask
+{
+    size_t          group;
+    XSC_PFN_TASK    task;
+    void*           taskData;
+};
+
+// Custom task scheduler, which defers all tasks until their group is waited for and counts the callbacks
+struct CustomTaskScheduler
+{
+    struct PendingTask  tasks[256];
+    size_t              numTasks;
+    size_t              numSubmits;
+    size_t              numWaits;
+};
+
+static void CustomSubmitTask(void* userData, size_t group, XSC_PFN_TASK task, void* taskData)
+{
+    struct CustomTaskScheduler* scheduler = (struct CustomTaskScheduler*)userData;
+
+    scheduler->numSubmits++;
+
+    if (scheduler->numTasks < sizeof(scheduler->tasks)/sizeof(scheduler->tasks[0]))
+    {
+        struct PendingTask* pending = &(scheduler->tasks[scheduler->numTasks++]);
+        pending->group      = group;
+        pending->task       = task;
+        pending->taskData   = taskData;
+    }
+    else
+        task(taskData);
+}
+
+static void CustomWaitTaskGroup(void* userData, size_t group)
+{
+    struct CustomTaskScheduler* scheduler = (struct CustomTaskScheduler*)userData;
+
+    scheduler->numWaits++;
+
+    // Execute all pending tasks of this group (tasks may submit further tasks)
+    for (size_t i = 0; i < scheduler->numTasks;)
+    {
+        if (scheduler->tasks[i].group == group)
+        {
+            struct PendingTask pending = scheduler->tasks[i];
+            scheduler->tasks[i] = scheduler->tasks[--scheduler->numTasks];
+            pending.task(pending.taskData);
+            i = 0;
+        }
+        else
+            ++i;
+    }
+}
+
+static unsigned CustomTaskConcurrency(void* userData)
+{
+    // Report concurrency, so the compiler splits its work into tasks
+    return 2;
+}
+
+void TestTaskScheduler()
+{
+    PRINT_FUNC;
+
+    // Initialize structures
+    struct XscShaderInput in;
+    struct XscShaderOutput out;
+    XscInitialize(&in, &out);
+
+    const char* outputCode = NULL;
+
+    // Generate shader code that is large enough to be parsed in parallel chunks
+    const int numFuncs = 500;
+    size_t sourceSize = 0;
+    char* sourceCode = (char*)malloc(numFuncs * 64 + 256);
+
+    for (int i = 0; i < numFuncs; ++i)
+        sourceSize += sprintf(sourceCode + sourceSize, "float Func%d(float x) { return x * %d.0 + 1.0; }\n", i, i);
+
+    sprintf(sourceCode + sourceSize, "float4 PS(float x : X) : SV_Target { return Func%d(x); }\n", numFuncs - 1);
+
+    in.filename     = "test.hlsl";
+    in.entryPoint   = "PS";
+    in.shaderTarget = XscETargetFragmentShader;
+    in.sourceCode   = sourceCode;
+
+    // Use custom task scheduler for parallel parsing
+    struct CustomTaskScheduler scheduler;
+    memset(&scheduler, 0, sizeof(scheduler));
+
+    in.taskScheduler.submitTaskPfn      = CustomSubmitTask;
+    in.taskScheduler.waitTaskGroupPfn   = CustomWaitTaskGroup;
+    in.taskScheduler.concurrencyPfn     = CustomTaskConcurrency;
+    in.taskScheduler.userData           = &scheduler;
+
+    out.filename                = "test.PS.frag";
+    out.sourceCode              = &outputCode;
+    out.options.parallelParsing = true;
+
+    // Compile shader and print number of scheduler callbacks
+    if (XscCompileShader(&in, &out, XSC_DEFAULT_LOG, NULL))
+    {
+        printf("custom task scheduler: %u task(s) submitted, %u wait(s), %u task(s) left\n", (unsigned)scheduler.numSubmits, (unsigned)scheduler.numWaits, (unsigned)scheduler.numTasks);
+        if (scheduler.numSubmits == 0)
+            puts("*** CUSTOM TASK SCHEDULER NOT USED ***");
+    }
+    else
+        puts("*** COMPILATION FAILED ***");
+
+    free(sourceCode);
+}
+
 int main()
 {
     puts("XscTest1");
@@ -98,6 +427,11 @@ int main()
     TestGLSLExtensions();
     TestShaderTarget();
     TestCompile();
+    TestConstantTables();
+    TestPreshaders();
+    TestPackedVaryings();
+    TestProfileCounters();
+    TestTaskScheduler();
 
     return 0;
 }